@@ -0,0 +1,291 @@
+#include "Instrumentation.hpp"
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include <sstream>
+#include <algorithm>
+
+namespace owlapi {
+
+namespace {
+
+/**
+ * Counters of a single operation
+ * \details Counters are only modified by the owning thread, so relaxed loads
+ * and stores are sufficient, atomics are only used to allow concurrent
+ * snapshots
+ */
+struct Counter
+{
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> totalNs;
+    std::atomic<uint64_t> minNs;
+    std::atomic<uint64_t> maxNs;
+    std::atomic<uint64_t> histogram[Instrumentation::HISTOGRAM_BUCKETS];
+
+    Counter() { clear(); }
+
+    void clear()
+    {
+        count.store(0, std::memory_order_relaxed);
+        totalNs.store(0, std::memory_order_relaxed);
+        minNs.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        maxNs.store(0, std::memory_order_relaxed);
+        for(std::atomic<uint64_t>& bucket : histogram)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static void increment(std::atomic<uint64_t>& value, uint64_t delta)
+    {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    void addTo(Instrumentation::Statistics& statistics) const
+    {
+        statistics.count += count.load(std::memory_order_relaxed);
+        statistics.totalNs += totalNs.load(std::memory_order_relaxed);
+        statistics.minNs = std::min(statistics.minNs, minNs.load(std::memory_order_relaxed));
+        statistics.maxNs = std::max(statistics.maxNs, maxNs.load(std::memory_order_relaxed));
+        for(size_t i = 0; i < Instrumentation::HISTOGRAM_BUCKETS; ++i)
+        {
+            statistics.histogram[i] += histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void addTo(Counter& other) const
+    {
+        increment(other.count, count.load(std::memory_order_relaxed));
+        increment(other.totalNs, totalNs.load(std::memory_order_relaxed));
+        other.minNs.store(std::min(other.minNs.load(std::memory_order_relaxed), minNs.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        other.maxNs.store(std::max(other.maxNs.load(std::memory_order_relaxed), maxNs.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        for(size_t i = 0; i < Instrumentation::HISTOGRAM_BUCKETS; ++i)
+        {
+            increment(other.histogram[i], histogram[i].load(std::memory_order_relaxed));
+        }
+    }
+};
+
+struct Counters
+{
+    Counter counters[Instrumentation::END_OPERATION];
+
+    void clear()
+    {
+        for(Counter& counter : counters)
+        {
+            counter.clear();
+        }
+    }
+};
+
+/**
+ * Registry of the counters of all live threads, and the accumulated counters
+ * of terminated threads
+ */
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<Counters*> threads;
+    Counters retired;
+
+    static Registry& getInstance()
+    {
+        static Registry registry;
+        return registry;
+    }
+};
+
+struct ThreadCounters
+{
+    Counters counters;
+
+    ThreadCounters()
+    {
+        Registry& registry = Registry::getInstance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(&counters);
+    }
+
+    ~ThreadCounters()
+    {
+        Registry& registry = Registry::getInstance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for(size_t i = 0; i < Instrumentation::END_OPERATION; ++i)
+        {
+            counters.counters[i].addTo(registry.retired.counters[i]);
+        }
+        registry.threads.erase(std::remove(registry.threads.begin(), registry.threads.end(), &counters),
+                registry.threads.end());
+    }
+
+    static Counters& get()
+    {
+        static thread_local ThreadCounters threadCounters;
+        return threadCounters.counters;
+    }
+};
+
+size_t getBucket(uint64_t latencyNs)
+{
+    uint64_t latencyUs = latencyNs / 1000;
+    size_t bucket = 0;
+    while(latencyUs && bucket < Instrumentation::HISTOGRAM_BUCKETS - 1)
+    {
+        latencyUs >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+} // end anonymous namespace
+
+bool Instrumentation::isEnabled()
+{
+#ifdef OWLAPI_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Instrumentation::record(Operation operation, uint64_t latencyNs)
+{
+    Counter& counter = ThreadCounters::get().counters[operation];
+    Counter::increment(counter.count, 1);
+    Counter::increment(counter.totalNs, latencyNs);
+    if(latencyNs < counter.minNs.load(std::memory_order_relaxed))
+    {
+        counter.minNs.store(latencyNs, std::memory_order_relaxed);
+    }
+    if(latencyNs > counter.maxNs.load(std::memory_order_relaxed))
+    {
+        counter.maxNs.store(latencyNs, std::memory_order_relaxed);
+    }
+    Counter::increment(counter.histogram[getBucket(latencyNs)], 1);
+}
+
+void Instrumentation::count(Operation operation)
+{
+    Counter::increment(ThreadCounters::get().counters[operation].count, 1);
+}
+
+Instrumentation::StatisticsList Instrumentation::snapshot()
+{
+    StatisticsList list;
+    Registry& registry = Registry::getInstance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for(size_t i = 0; i < END_OPERATION; ++i)
+    {
+        Statistics statistics;
+        statistics.operation = static_cast<Operation>(i);
+        statistics.count = 0;
+        statistics.totalNs = 0;
+        statistics.minNs = std::numeric_limits<uint64_t>::max();
+        statistics.maxNs = 0;
+        statistics.histogram.resize(HISTOGRAM_BUCKETS, 0);
+
+        registry.retired.counters[i].addTo(statistics);
+        for(const Counters* counters : registry.threads)
+        {
+            counters->counters[i].addTo(statistics);
+        }
+
+        if(statistics.count)
+        {
+            if(statistics.minNs > statistics.maxNs)
+            {
+                // only counted, but never timed
+                statistics.minNs = 0;
+            }
+            list.push_back(statistics);
+        }
+    }
+    return list;
+}
+
+void Instrumentation::reset()
+{
+    Registry& registry = Registry::getInstance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.retired.clear();
+    for(Counters* counters : registry.threads)
+    {
+        counters->clear();
+    }
+}
+
+void Instrumentation::toJSON(std::ostream& out)
+{
+    StatisticsList list = snapshot();
+    out << "{";
+    for(StatisticsList::const_iterator cit = list.begin(); cit != list.end(); ++cit)
+    {
+        const Statistics& statistics = *cit;
+        if(cit != list.begin())
+        {
+            out << ",";
+        }
+        out << "\n  \"" << getName(statistics.operation) << "\": {"
+            << "\"count\": " << statistics.count
+            << ", \"total_ns\": " << statistics.totalNs
+            << ", \"mean_ns\": " << static_cast<uint64_t>(statistics.getMeanNs())
+            << ", \"min_ns\": " << statistics.minNs
+            << ", \"max_ns\": " << statistics.maxNs
+            << ", \"histogram_us\": [";
+        for(size_t i = 0; i < statistics.histogram.size(); ++i)
+        {
+            out << (i ? ", " : "") << statistics.histogram[i];
+        }
+        out << "]}";
+    }
+    out << (list.empty() ? "}" : "\n}");
+}
+
+std::string Instrumentation::toJSON()
+{
+    std::stringstream ss;
+    toJSON(ss);
+    return ss.str();
+}
+
+const char* Instrumentation::getName(Operation operation)
+{
+    switch(operation)
+    {
+        case KB_CLASSIFY: return "kb_classify";
+        case KB_REALIZE: return "kb_realize";
+        case KB_CONSISTENCY_CHECK: return "kb_consistency_check";
+        case KB_ACTOR_QUERY: return "kb_actor_query";
+        case KB_ENTAILMENT_QUERY: return "kb_entailment_query";
+        case KB_RETRACT: return "kb_retract";
+        case KB_POPULATE: return "kb_populate";
+        case QUERY_CACHE_HIT: return "query_cache_hit";
+        case QUERY_CACHE_MISS: return "query_cache_miss";
+        case READER_OPEN: return "reader_open";
+        case READER_LOAD_IMPORTS: return "reader_load_imports";
+        case READER_LOAD_DECLARATIONS: return "reader_load_declarations";
+        case READER_LOAD_AXIOMS: return "reader_load_axioms";
+        case READER_LOAD_PROPERTIES: return "reader_load_properties";
+        case READER_LOAD_RESTRICTIONS: return "reader_load_restrictions";
+        case READER_LOAD_ANONYMOUS_LISTS: return "reader_load_anonymous_lists";
+        case READER_LOAD_DATATYPE_RESTRICTIONS: return "reader_load_datatype_restrictions";
+        case READER_LOAD_OBJECT_RESTRICTIONS: return "reader_load_object_restrictions";
+        case READER_LOAD_DATA_PROPERTIES: return "reader_load_data_properties";
+        case READER_LOAD_OBJECT_PROPERTIES: return "reader_load_object_properties";
+        case READER_LOAD_ANNOTATION_PROPERTIES: return "reader_load_annotation_properties";
+        case IO_LOAD: return "io_load";
+        case IO_RESOLVE_IMPORT: return "io_resolve_import";
+        case IO_LOAD_IMPORT: return "io_load_import";
+        case IO_RELOAD: return "io_reload";
+        case IO_JOURNAL_COMMIT: return "io_journal_commit";
+        case IO_JOURNAL_REPLAY: return "io_journal_replay";
+        case IO_JOURNAL_COMPACT: return "io_journal_compact";
+        default:
+            break;
+    }
+    return "unknown";
+}
+
+} // end namespace owlapi
@@ -0,0 +1,165 @@
+#ifndef OWLAPI_INSTRUMENTATION_HPP
+#define OWLAPI_INSTRUMENTATION_HPP
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <chrono>
+#include <stdint.h>
+
+namespace owlapi {
+
+/**
+ * \class Instrumentation
+ * \brief Call counts and latency histograms of reasoner round-trips, query
+ * cache lookups and ontology loading
+ * \details Collection is opt-in: it requires the library to be built with
+ * OWLAPI_INSTRUMENTATION defined (cmake option OWLAPI_INSTRUMENTATION),
+ * otherwise the instrumentation macros compile to nothing and snapshots are
+ * empty.
+ * Each thread accumulates into its own counters, so that recording does not
+ * require any synchronization. A snapshot sums the counters of all threads,
+ * including threads which have already terminated.
+ */
+class Instrumentation
+{
+public:
+    enum Operation {
+        /// FaCT++ classifyKB
+        KB_CLASSIFY = 0,
+        /// FaCT++ realiseKB
+        KB_REALIZE,
+        KB_CONSISTENCY_CHECK,
+        /// Queries retrieving entities through an Actor, e.g. subclasses or
+        /// instances
+        KB_ACTOR_QUERY,
+        /// Boolean queries, e.g. subsumption or instance checks
+        KB_ENTAILMENT_QUERY,
+        KB_RETRACT,
+        /// OWLOntology::attachKnowledgeBase of a structural ontology
+        KB_POPULATE,
+        QUERY_CACHE_HIT,
+        QUERY_CACHE_MISS,
+        READER_OPEN,
+        READER_LOAD_IMPORTS,
+        READER_LOAD_DECLARATIONS,
+        READER_LOAD_AXIOMS,
+        READER_LOAD_PROPERTIES,
+        READER_LOAD_RESTRICTIONS,
+        READER_LOAD_ANONYMOUS_LISTS,
+        READER_LOAD_DATATYPE_RESTRICTIONS,
+        READER_LOAD_OBJECT_RESTRICTIONS,
+        READER_LOAD_DATA_PROPERTIES,
+        READER_LOAD_OBJECT_PROPERTIES,
+        READER_LOAD_ANNOTATION_PROPERTIES,
+        /// OWLOntologyIO::load including all imports
+        IO_LOAD,
+        /// Retrieval and opening of an imported ontology
+        IO_RESOLVE_IMPORT,
+        /// Loading declarations and axioms of an imported ontology
+        IO_LOAD_IMPORT,
+        /// OWLOntologyIO::reload of a single document
+        IO_RELOAD,
+        /// ChangeJournal::commit of a group of changes
+        IO_JOURNAL_COMMIT,
+        /// ChangeJournal::replay
+        IO_JOURNAL_REPLAY,
+        /// ChangeJournal::compact, including writing the snapshot
+        IO_JOURNAL_COMPACT,
+        END_OPERATION
+    };
+
+    /// Number of histogram buckets: bucket 0 counts latencies below 1 us,
+    /// bucket i latencies in [2^(i-1), 2^i) us, the last bucket all larger
+    /// latencies
+    static const size_t HISTOGRAM_BUCKETS = 32;
+
+    struct Statistics
+    {
+        Operation operation;
+        uint64_t count;
+        /// Total, minimum and maximum latency in nanoseconds, zero for
+        /// operations which are only counted
+        uint64_t totalNs;
+        uint64_t minNs;
+        uint64_t maxNs;
+        std::vector<uint64_t> histogram;
+
+        double getMeanNs() const { return count ? static_cast<double>(totalNs) / count : 0.0; }
+    };
+
+    typedef std::vector<Statistics> StatisticsList;
+
+    /**
+     * \class ScopedTimer
+     * \brief Records the latency of the enclosing scope
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(Operation operation)
+            : mOperation(operation)
+            , mStart(std::chrono::steady_clock::now())
+        {}
+
+        ~ScopedTimer()
+        {
+            record(mOperation, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart).count());
+        }
+
+    private:
+        Operation mOperation;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    /**
+     * Check whether the library has been built with instrumentation
+     */
+    static bool isEnabled();
+
+    /**
+     * Record a single call with the given latency
+     */
+    static void record(Operation operation, uint64_t latencyNs);
+
+    /**
+     * Record a single call without latency
+     */
+    static void count(Operation operation);
+
+    /**
+     * Get the accumulated statistics of all threads
+     * \return statistics of all operations which have been called at least
+     * once
+     */
+    static StatisticsList snapshot();
+
+    /**
+     * Reset the statistics of all threads
+     */
+    static void reset();
+
+    /**
+     * Write a snapshot as JSON object, which maps the operation name to its
+     * statistics
+     */
+    static void toJSON(std::ostream& out);
+
+    static std::string toJSON();
+
+    static const char* getName(Operation operation);
+};
+
+} // end namespace owlapi
+
+#ifdef OWLAPI_INSTRUMENTATION
+#define OWLAPI_INSTRUMENT_SCOPE(operation) \
+    ::owlapi::Instrumentation::ScopedTimer owlapiInstrumentationTimer(::owlapi::Instrumentation::operation)
+#define OWLAPI_INSTRUMENT_COUNT(operation) \
+    ::owlapi::Instrumentation::count(::owlapi::Instrumentation::operation)
+#else
+#define OWLAPI_INSTRUMENT_SCOPE(operation)
+#define OWLAPI_INSTRUMENT_COUNT(operation)
+#endif
+
+#endif // OWLAPI_INSTRUMENTATION_HPP
@@ -1,13 +1,16 @@
 #include "KnowledgeBase.hpp"
 
+#include <algorithm>
 #include <base-logging/Logging.hpp>
 
 #include <factpp/Kernel.h>
 #include <factpp/tOntologyPrinterLISP.h>
 
+#include "Instrumentation.hpp"
 #include "Vocabulary.hpp"
 #include "vocabularies/OWL.hpp"
 #include "model/OWLFacetRestriction.hpp"
+#include "model/OWLDataPropertyAssertionAxiom.hpp"
 
 using namespace owlapi::reasoner::factpp;
 using namespace owlapi::model;
@@ -58,83 +61,85 @@ IRIList KnowledgeBase::getResult(const Actor& actor, const IRI& filter) const
 
 TExpressionManager* KnowledgeBase::getExpressionManager()
 {
-    return mKernel->getExpressionManager();
+    return kernel()->getExpressionManager();
 }
 
 const TExpressionManager* KnowledgeBase::getExpressionManager() const
 {
-    return mKernel->getExpressionManager();
+    return kernel()->getExpressionManager();
 }
 
 ClassExpression KnowledgeBase::getClass(const IRI& klass) const
 {
-    IRIClassExpressionMap::const_iterator cit = mClasses.find(klass);
-    if(cit == mClasses.end())
+    const ClassExpression* expression = mClasses.find(klass);
+    if(!expression)
     {
         throw std::invalid_argument("KnowledgeBase::getClass: Class '" + klass.toString() + "' does not exist");
     }
 
-    return cit->second;
+    return *expression;
 }
 
 ClassExpression KnowledgeBase::getClassLazy(const IRI& klass)
 {
-    try {
-        return getClass(klass);
-    } catch(const std::invalid_argument& e)
+    const ClassExpression* registered = mClasses.find(klass);
+    if(registered)
     {
-        TDLConceptExpression* f_class = getExpressionManager()->Concept(klass.toString());
-        ClassExpression expression(f_class);
-        mClasses[klass] = expression;
-        return expression;
+        return *registered;
     }
+
+    // Register only once the expression exists, so that a failure does
+    // not leave a null expression behind
+    ClassExpression expression(getExpressionManager()->Concept(klass.toString()));
+    *mClasses.insert(klass).first = expression;
+    return expression;
 }
 
 InstanceExpression KnowledgeBase::getInstance(const IRI& instance) const
 {
-    IRIInstanceExpressionMap::const_iterator cit = mInstances.find(instance);
-    if(cit == mInstances.end())
+    const InstanceExpression* expression = mInstances.find(instance);
+    if(!expression)
     {
         throw std::invalid_argument("KnowledgeBase::getInstance: Instance '" + instance.toString() + "' does not exist");
     }
 
-    return cit->second;
+    return *expression;
 }
 
 InstanceExpression KnowledgeBase::getInstanceLazy(const IRI& instance)
 {
-    try {
-        return getInstance(instance);
-    } catch(const std::invalid_argument& e)
+    const InstanceExpression* registered = mInstances.find(instance);
+    if(registered)
     {
-        TDLIndividualExpression* f_individual = getExpressionManager()->Individual(instance.toString());
-        InstanceExpression expression(f_individual);
-        mInstances[instance] = expression;
-        return expression;
+        return *registered;
     }
+
+    InstanceExpression expression(getExpressionManager()->Individual(instance.toString()));
+    *mInstances.insert(instance).first = expression;
+    return expression;
 }
 
 ObjectPropertyExpression KnowledgeBase::getObjectProperty(const IRI& property) const
 {
-    IRIObjectPropertyExpressionMap::const_iterator cit = mObjectProperties.find(property);
-    if(cit == mObjectProperties.end())
+    const ObjectPropertyExpression* expression = mObjectProperties.find(property);
+    if(!expression)
     {
         throw std::invalid_argument("KnowledgeBase::getObjectProperty: ObjectProperty '" + property.toString() + "' does not exist");
     }
-    return cit->second;
+    return *expression;
 }
 
 ObjectPropertyExpression KnowledgeBase::getObjectPropertyLazy(const IRI& property)
 {
-    try {
-        return getObjectProperty(property);
-    } catch(const std::invalid_argument& e)
+    const ObjectPropertyExpression* registered = mObjectProperties.find(property);
+    if(registered)
     {
-        TDLObjectRoleExpression* f_property = getExpressionManager()->ObjectRole(property.toString());
-        ObjectPropertyExpression expression(f_property);
-        mObjectProperties[property] = expression;
-        return expression;
+        return *registered;
     }
+
+    ObjectPropertyExpression expression(getExpressionManager()->ObjectRole(property.toString()));
+    *mObjectProperties.insert(property).first = expression;
+    return expression;
 }
 
 IRIList KnowledgeBase::getObjectPropertyDomain(const IRI& property, bool direct) const
@@ -142,9 +147,10 @@ IRIList KnowledgeBase::getObjectPropertyDomain(const IRI& property, bool direct)
     ObjectPropertyExpression e_property = getObjectProperty(property);
     IRIList classes;
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needConcepts();
-    mKernel->getORoleDomain( e_property.get(), direct, actor);
+    kernel()->getORoleDomain( e_property.get(), direct, actor);
 
     return getResult(actor);
 }
@@ -154,38 +160,43 @@ IRIList KnowledgeBase::getObjectPropertyRange(const IRI& property, bool direct)
     ObjectPropertyExpression e_property = getObjectProperty(property);
     IRIList classes;
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needConcepts();
-    mKernel->getRoleRange( e_property.get(), direct, actor);
+    kernel()->getRoleRange( e_property.get(), direct, actor);
 
     return getResult(actor);
 }
 
 DataPropertyExpression KnowledgeBase::getDataProperty(const IRI& property) const
 {
-    IRIDataPropertyExpressionMap::const_iterator cit = mDataProperties.find(property);
-    if(cit == mDataProperties.end())
+    const DataPropertyExpression* expression = mDataProperties.find(property);
+    if(!expression)
     {
         throw std::invalid_argument("KnowledgeBase::getDataProperty: DataProperty '" + property.toString() + "' does not exist");
     }
-    return cit->second;
+    return *expression;
 }
 
 DataPropertyExpression KnowledgeBase::getDataPropertyLazy(const IRI& property)
 {
-    try {
-        return getDataProperty(property);
-    } catch(const std::invalid_argument& e)
+    const DataPropertyExpression* registered = mDataProperties.find(property);
+    if(registered)
     {
-        TDLDataRoleExpression* f_property = getExpressionManager()->DataRole(property.toString());
-        DataPropertyExpression expression(f_property);
-        mDataProperties[property] = expression;
-        return expression;
+        return *registered;
     }
+
+    DataPropertyExpression expression(getExpressionManager()->DataRole(property.toString()));
+    *mDataProperties.insert(property).first = expression;
+    return expression;
 }
 
 KnowledgeBase::KnowledgeBase()
     : mKernel(new ReasoningKernel())
+    , mTaxonomyAdopted(false)
+    , mGeneration(0)
+    , mTaxonomySnapshotGeneration(0)
+    , mAncestorsGeneration(0)
 {
     mKernel->setVerboseOutput(false);
     mKernel->newKB();
@@ -236,43 +247,163 @@ KnowledgeBase::KnowledgeBase()
 
 KnowledgeBase::~KnowledgeBase()
 {
+    std::shared_future<void> task;
+    {
+        std::lock_guard<std::mutex> lock(mReasoningMutex);
+        task = mReasoningTask;
+    }
+    if(task.valid())
+    {
+        // includes the callback
+        task.wait();
+    }
     delete mKernel;
 }
 
+ReasoningKernel* KnowledgeBase::kernel() const
+{
+    waitForReasoning();
+    return mKernel;
+}
+
+void KnowledgeBase::waitForReasoning() const
+{
+    std::shared_future<uint64_t> reasoning;
+    {
+        std::lock_guard<std::mutex> lock(mReasoningMutex);
+        reasoning = mReasoning;
+    }
+    if(reasoning.valid())
+    {
+        reasoning.wait();
+    }
+}
+
+bool KnowledgeBase::isReasoning() const
+{
+    std::shared_future<uint64_t> reasoning;
+    {
+        std::lock_guard<std::mutex> lock(mReasoningMutex);
+        reasoning = mReasoning;
+    }
+    return reasoning.valid() &&
+        reasoning.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+Axiom KnowledgeBase::told(TDLAxiom* axiom)
+{
+    if(mTaxonomyAdopted)
+    {
+        // the adopted taxonomy does not reflect the new axiom
+        mTaxonomy.reset();
+        mTaxonomyAdopted = false;
+    }
+    ++mGeneration;
+    return Axiom(axiom);
+}
+
+std::shared_future<uint64_t> KnowledgeBase::classifyAsync(const std::function<void(uint64_t)>& callback)
+{
+    return reasonAsync(false, callback);
+}
+
+std::shared_future<uint64_t> KnowledgeBase::realizeAsync(const std::function<void(uint64_t)>& callback)
+{
+    return reasonAsync(true, callback);
+}
+
+std::shared_future<uint64_t> KnowledgeBase::reasonAsync(bool realize, const std::function<void(uint64_t)>& callback)
+{
+    std::shared_future<void> previousTask;
+    {
+        std::lock_guard<std::mutex> lock(mReasoningMutex);
+        previousTask = mReasoningTask;
+    }
+    if(previousTask.valid())
+    {
+        previousTask.wait();
+    }
+
+    // Caches are only accessed from the calling thread, so invalidate
+    // them here; any further use of the kernel blocks until the
+    // background reasoning has been completed
+    clearCaches();
+    uint64_t generation = mGeneration;
+
+    shared_ptr< std::promise<uint64_t> > result = make_shared< std::promise<uint64_t> >();
+    std::shared_future<uint64_t> reasoning = result->get_future().share();
+    std::lock_guard<std::mutex> lock(mReasoningMutex);
+    mReasoning = reasoning;
+    mReasoningTask = std::async(std::launch::async, [this, realize, generation, callback, result]()
+            {
+                try {
+                    if(realize)
+                    {
+                        OWLAPI_INSTRUMENT_SCOPE(KB_REALIZE);
+                        mKernel->realiseKB();
+                    } else {
+                        OWLAPI_INSTRUMENT_SCOPE(KB_CLASSIFY);
+                        mKernel->classifyKB();
+                    }
+                    publishTaxonomy(createTaxonomy(mKernel), generation);
+                } catch(...)
+                {
+                    result->set_exception(std::current_exception());
+                    return;
+                }
+                // Release the kernel before calling back, so that the
+                // callback can query the knowledge base
+                result->set_value(generation);
+                if(callback)
+                {
+                    callback(generation);
+                }
+            }).share();
+    return reasoning;
+}
+
 void KnowledgeBase::setVerbose()
 {
-    mKernel->setVerboseOutput(true);
+    kernel()->setVerboseOutput(true);
 }
 
 void KnowledgeBase::refresh()
 {
-    mKernel->realiseKB();
+    OWLAPI_INSTRUMENT_SCOPE(KB_REALIZE);
+    kernel()->realiseKB();
+    clearCaches();
 }
 
 bool KnowledgeBase::isConsistent()
 {
-    return mKernel->isKBConsistent();
+    OWLAPI_INSTRUMENT_SCOPE(KB_CONSISTENCY_CHECK);
+    return kernel()->isKBConsistent();
 }
 
 void KnowledgeBase::classify()
 {
-    mKernel->classifyKB();
+    OWLAPI_INSTRUMENT_SCOPE(KB_CLASSIFY);
+    kernel()->classifyKB();
+    clearCaches();
 }
 
 void KnowledgeBase::realize()
 {
-    mKernel->realiseKB();
+    OWLAPI_INSTRUMENT_SCOPE(KB_REALIZE);
+    kernel()->realiseKB();
+    clearCaches();
 }
 
 bool KnowledgeBase::isRealized()
 {
-    return mKernel->isKBRealised();
+    return kernel()->isKBRealised();
 }
 
 bool KnowledgeBase::isClassSatisfiable(const IRI& klass)
 {
     ClassExpression e_klass = getClass(klass);
-    return mKernel->isSatisfiable(e_klass.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isSatisfiable(e_klass.get());
 }
 
 
@@ -289,13 +420,13 @@ DataPropertyExpression KnowledgeBase::dataProperty(const IRI& property)
 Axiom KnowledgeBase::transitiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setTransitive(e_property.get()) );
+    return told( kernel()->setTransitive(e_property.get()) );
 }
 
 bool KnowledgeBase::isTransitiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectProperty(property);
-    return mKernel->isTransitive(e_property.get());
+    return kernel()->isTransitive(e_property.get());
 }
 
 Axiom KnowledgeBase::functionalProperty(const IRI& property, PropertyType type)
@@ -305,12 +436,12 @@ Axiom KnowledgeBase::functionalProperty(const IRI& property, PropertyType type)
         case OBJECT:
         {
             ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-            return Axiom( mKernel->setOFunctional(e_property.get()) );
+            return told( kernel()->setOFunctional(e_property.get()) );
         }
         case DATA:
         {
             DataPropertyExpression e_property = getDataPropertyLazy(property);
-            return Axiom( mKernel->setDFunctional(e_property.get()) );
+            return told( kernel()->setDFunctional(e_property.get()) );
         }
         default:
             throw std::invalid_argument("KnowledgeBase::functionalProperty: Functional property can only be created for object or data property");
@@ -321,7 +452,7 @@ bool KnowledgeBase::isFunctionalProperty(const IRI& property)
 {
     try {
         ObjectPropertyExpression e_property = getObjectProperty(property);
-        return mKernel->isFunctional(e_property.get());
+        return kernel()->isFunctional(e_property.get());
     } catch(const std::invalid_argument& e)
     {
         // Not a known object property
@@ -333,7 +464,7 @@ bool KnowledgeBase::isFunctionalProperty(const IRI& property)
 
     try {
         DataPropertyExpression e_property = getDataProperty(property);
-        return mKernel->isFunctional(e_property.get());
+        return kernel()->isFunctional(e_property.get());
     } catch(const std::invalid_argument& e)
     {
         // Not a known object property
@@ -350,61 +481,61 @@ bool KnowledgeBase::isFunctionalProperty(const IRI& property)
 Axiom KnowledgeBase::inverseFunctionalProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setInverseFunctional(e_property.get()) );
+    return told( kernel()->setInverseFunctional(e_property.get()) );
 }
 
 bool KnowledgeBase::isInverseFunctionalProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectProperty(property);
-    return mKernel->isInverseFunctional(e_property.get());
+    return kernel()->isInverseFunctional(e_property.get());
 }
 
 Axiom KnowledgeBase::reflexiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setReflexive(e_property.get()) );
+    return told( kernel()->setReflexive(e_property.get()) );
 }
 
 bool KnowledgeBase::isReflexiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectProperty(property);
-    return mKernel->isReflexive(e_property.get());
+    return kernel()->isReflexive(e_property.get());
 }
 
 Axiom KnowledgeBase::irreflexiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setIrreflexive(e_property.get()) );
+    return told( kernel()->setIrreflexive(e_property.get()) );
 }
 
 bool KnowledgeBase::isIrreflexiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectProperty(property);
-    return mKernel->isIrreflexive(e_property.get());
+    return kernel()->isIrreflexive(e_property.get());
 }
 
 Axiom KnowledgeBase::symmetricProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setSymmetric(e_property.get()) );
+    return told( kernel()->setSymmetric(e_property.get()) );
 }
 
 bool KnowledgeBase::isSymmetricProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectProperty(property);
-    return mKernel->isSymmetric(e_property.get());
+    return kernel()->isSymmetric(e_property.get());
 }
 
 Axiom KnowledgeBase::asymmetricProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setAsymmetric(e_property.get()) );
+    return told( kernel()->setAsymmetric(e_property.get()) );
 }
 
 bool KnowledgeBase::isAsymmetricProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectProperty(property);
-    return mKernel->isAsymmetric(e_property.get());
+    return kernel()->isAsymmetric(e_property.get());
 }
 
 Axiom KnowledgeBase::equalClasses(const IRIList& klasses)
@@ -415,7 +546,7 @@ Axiom KnowledgeBase::equalClasses(const IRIList& klasses)
         ClassExpression e_class = getClassLazy(iri);
         getExpressionManager()->addArg(e_class.get());
     }
-    return Axiom(mKernel->equalConcepts());
+    return told(kernel()->equalConcepts());
 }
 
 Axiom KnowledgeBase::equalObjectProperties(const IRIList& properties)
@@ -426,7 +557,7 @@ Axiom KnowledgeBase::equalObjectProperties(const IRIList& properties)
         ObjectPropertyExpression e_property = getObjectPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->equalORoles());
+    return told(kernel()->equalORoles());
 }
 
 Axiom KnowledgeBase::equalDataProperties(const IRIList& properties)
@@ -437,7 +568,7 @@ Axiom KnowledgeBase::equalDataProperties(const IRIList& properties)
         DataPropertyExpression e_property = getDataPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->equalORoles());
+    return told(kernel()->equalORoles());
 }
 
 Axiom KnowledgeBase::subClassOf(const IRI& subclass, const IRI& parentClass)
@@ -449,13 +580,13 @@ Axiom KnowledgeBase::subClassOf(const IRI& subclass, const IRI& parentClass)
 Axiom KnowledgeBase::subClassOf(const ClassExpression& subclass, const IRI& parentClass)
 {
     ClassExpression e_parentClass = getClassLazy(parentClass);
-    return Axiom( mKernel->impliesConcepts(subclass.get(), e_parentClass.get()) );
+    return told( kernel()->impliesConcepts(subclass.get(), e_parentClass.get()) );
 }
 
 Axiom KnowledgeBase::subClassOf(const IRI& subclass, const ClassExpression& parentClass)
 {
     ClassExpression e_subclass = getClassLazy(subclass);
-    return Axiom( mKernel->impliesConcepts(e_subclass.get(), parentClass.get()) );
+    return told( kernel()->impliesConcepts(e_subclass.get(), parentClass.get()) );
 }
 
 Axiom KnowledgeBase::subPropertyOf(const IRI& subProperty, const IRI& parentProperty)
@@ -484,13 +615,13 @@ Axiom KnowledgeBase::subObjectPropertyOf(const IRI& subProperty, const ObjectPro
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(subProperty);
     //TDLAxiom* impliesORoles ( TORoleComplexExpr* R, TORoleExpr* S )
-    return Axiom( mKernel->impliesORoles(e_property.get(), parentProperty.get()));
+    return told( kernel()->impliesORoles(e_property.get(), parentProperty.get()));
 }
 
 Axiom KnowledgeBase::subDataPropertyOf(const IRI& subProperty, const DataPropertyExpression& parentProperty)
 {
     DataPropertyExpression e_property = getDataPropertyLazy(subProperty);
-    return Axiom( mKernel->impliesDRoles(e_property.get(), parentProperty.get()) );
+    return told( kernel()->impliesDRoles(e_property.get(), parentProperty.get()) );
 }
 
 Axiom KnowledgeBase::equals(const IRI& klass, const IRI& otherKlass)
@@ -507,7 +638,7 @@ Axiom KnowledgeBase::equals(const reasoner::factpp::ClassExpression& klass,
     getExpressionManager()->addArg(klass.get());
     getExpressionManager()->addArg(otherklass.get());
 
-    return Axiom( mKernel->equalConcepts() );
+    return told( kernel()->equalConcepts() );
 
 }
 
@@ -580,7 +711,7 @@ Axiom KnowledgeBase::alias(const IRI& alias, const ClassExpression& expression)
     getExpressionManager()->newArgList();
     getExpressionManager()->addArg(e_aliasClass.get());
     getExpressionManager()->addArg(expression.get());
-    return Axiom( mKernel->equalConcepts() );
+    return told( kernel()->equalConcepts() );
 }
 
 Axiom KnowledgeBase::alias(const IRI& aliasName, const IRI& iri, EntityType type)
@@ -597,7 +728,11 @@ Axiom KnowledgeBase::alias(const IRI& aliasName, const IRI& iri, EntityType type
             getExpressionManager()->newArgList();
             getExpressionManager()->addArg(e_aliasInstance.get());
             getExpressionManager()->addArg(e_instance.get());
-            return Axiom( mKernel->processSame() );
+            Axiom axiom = told( kernel()->processSame() );
+
+            mSameAsAxioms[axiom.get()] = std::pair<IRI, IRI>(aliasName, iri);
+            mSameAsIndex.merge(aliasName, iri);
+            return axiom;
         }
         case CLASS:
         {
@@ -637,12 +772,10 @@ Axiom KnowledgeBase::disjoint(const IRIList& klassesOrInstances, KnowledgeBase::
 
     if(type == CLASS)
     {
-        TDLAxiom* axiom = mKernel->disjointConcepts();
-        return Axiom(axiom);
+        return told( kernel()->disjointConcepts() );
     } else if(type == INSTANCE)
     {
-        TDLAxiom* axiom = mKernel->processDifferent();
-        return Axiom(axiom);
+        return told( kernel()->processDifferent() );
     }
 
     throw std::runtime_error("owlapi::KnowledgeBase::disjoint requires either list of classes or instances");
@@ -656,7 +789,7 @@ Axiom KnowledgeBase::disjointObjectProperties(const IRIList& properties)
         ObjectPropertyExpression e_property = getObjectPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->disjointORoles());
+    return told(kernel()->disjointORoles());
 }
 
 Axiom KnowledgeBase::disjointDataProperties(const IRIList& properties)
@@ -667,7 +800,7 @@ Axiom KnowledgeBase::disjointDataProperties(const IRIList& properties)
         DataPropertyExpression e_property = getDataPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->disjointORoles());
+    return told(kernel()->disjointORoles());
 }
 
 Axiom KnowledgeBase::disjointUnion(const IRI& klass, const IRIList& disjointClasses)
@@ -680,8 +813,7 @@ Axiom KnowledgeBase::disjointUnion(const IRI& klass, const IRIList& disjointClas
     }
 
     ClassExpression e_class = getClass(klass);
-    TDLAxiom* axiom = mKernel->disjointUnion(e_class.get());
-    return Axiom(axiom);
+    return told( kernel()->disjointUnion(e_class.get()) );
 }
 
 Axiom KnowledgeBase::instanceOf(const IRI& individual, const IRI& klass)
@@ -693,7 +825,7 @@ Axiom KnowledgeBase::instanceOf(const IRI& individual, const IRI& klass)
 Axiom KnowledgeBase::instanceOf(const IRI& individual, const ClassExpression& e_class)
 {
     InstanceExpression e_instance = getInstanceLazy(individual);
-    return Axiom( mKernel->instanceOf(e_instance.get(), e_class.get()) );
+    return told( kernel()->instanceOf(e_instance.get(), e_class.get()) );
 }
 
 Axiom KnowledgeBase::relatedTo(const IRI& instance, const IRI& relationProperty, const IRI& otherInstance, bool isTrue)
@@ -705,9 +837,9 @@ Axiom KnowledgeBase::relatedTo(const IRI& instance, const IRI& relationProperty,
 
     if(isTrue)
     {
-        return Axiom( mKernel->relatedTo(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
+        return told( kernel()->relatedTo(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
     } else {
-        return Axiom( mKernel->relatedToNot(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
+        return told( kernel()->relatedToNot(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
     }
 }
 
@@ -720,14 +852,14 @@ Axiom KnowledgeBase::domainOf(const IRI& property, const IRI& domain, PropertyTy
             ObjectPropertyExpression e_role = getObjectPropertyLazy(property);
             ClassExpression e_domain = getClassLazy(domain);
 
-            return Axiom( mKernel->setODomain(e_role.get(), e_domain.get()) );
+            return told( kernel()->setODomain(e_role.get(), e_domain.get()) );
         }
         case DATA:
         {
             DataPropertyExpression e_role = getDataPropertyLazy(property);
             ClassExpression e_domain = getClassLazy(domain);
 
-            return Axiom( mKernel->setDDomain(e_role.get(), e_domain.get()) );
+            return told( kernel()->setDDomain(e_role.get(), e_domain.get()) );
         }
         default:
         {
@@ -740,20 +872,20 @@ Axiom KnowledgeBase::objectRangeOf(const IRI& property, const IRI& range)
 {
     ObjectPropertyExpression e_role = getObjectProperty(property);
     ClassExpression e_range = getClassLazy(range);
-    return Axiom( mKernel->setORange(e_role.get(), e_range.get()) );
+    return told( kernel()->setORange(e_role.get(), e_range.get()) );
 }
 
 Axiom KnowledgeBase::objectRangeOf(const IRI& property, const ClassExpression& expression)
 {
     ObjectPropertyExpression e_role = getObjectProperty(property);
-    return Axiom( mKernel->setORange(e_role.get(), expression.get()) );
+    return told( kernel()->setORange(e_role.get(), expression.get()) );
 }
 
 reasoner::factpp::Axiom KnowledgeBase::dataRangeOf(const IRI& property,
         reasoner::factpp::DataRange& range)
 {
     DataPropertyExpression e_role = getDataProperty(property);
-    return Axiom( mKernel->setDRange(e_role.get(), range.get()) );
+    return told( kernel()->setDRange(e_role.get(), range.get()) );
 }
 
 Axiom KnowledgeBase::valueOf(const IRI& individual, const IRI& property, const DataValue& dataValue)
@@ -778,8 +910,7 @@ Axiom KnowledgeBase::valueOf(const IRI& individual, const IRI& property, const D
         }
     }
 
-    TDLAxiom* tdlAxiom = mKernel->valueOf( getInstance(individual).get(), getDataProperty(property).get(), dataValue.get());
-    Axiom axiom(tdlAxiom);
+    Axiom axiom = told( kernel()->valueOf( getInstance(individual).get(), getDataProperty(property).get(), dataValue.get()) );
     mValueOfAxioms[key].push_back(axiom);
 
     return axiom;
@@ -791,36 +922,131 @@ Axiom KnowledgeBase::valueOf(const IRI& individual, const IRI& property, const o
     return valueOf(individual, property, value);
 }
 
+Axiom::List KnowledgeBase::assertBatch(const owlapi::model::ABoxBatch& batch)
+{
+    typedef owlapi::model::ABoxBatch::Id Id;
+    const IRIList& iris = batch.getIRIs();
+
+    // Expressions by batch id, resolved on first use
+    std::vector<InstanceExpression> instances(iris.size());
+    std::vector<ClassExpression> classes(iris.size());
+    std::vector<ObjectPropertyExpression> objectProperties(iris.size());
+    std::vector<DataPropertyExpression> dataProperties(iris.size());
+    // 0: unknown, 1: functional, 2: not functional
+    std::vector<uint8_t> functional(iris.size(), 0);
+
+    std::function<InstanceExpression(Id)> instance = [&](Id id)
+    {
+        if(!instances[id].get())
+        {
+            instances[id] = getInstanceLazy(iris[id]);
+        }
+        return instances[id];
+    };
+
+    Axiom::List axioms;
+    axioms.reserve(batch.size());
+
+    const owlapi::model::ABoxBatch::IdList& individuals = batch.getTypeIndividuals();
+    const owlapi::model::ABoxBatch::IdList& klasses = batch.getTypeClasses();
+    for(size_t i = 0; i < individuals.size(); ++i)
+    {
+        Id klass = klasses[i];
+        if(!classes[klass].get())
+        {
+            classes[klass] = getClass(iris[klass]);
+        }
+        axioms.push_back( told(kernel()->instanceOf(instance(individuals[i]).get(), classes[klass].get())) );
+    }
+
+    const owlapi::model::ABoxBatch::IdList& subjects = batch.getRelationSubjects();
+    const owlapi::model::ABoxBatch::IdList& relations = batch.getRelationProperties();
+    const owlapi::model::ABoxBatch::IdList& objects = batch.getRelationObjects();
+    for(size_t i = 0; i < subjects.size(); ++i)
+    {
+        Id relation = relations[i];
+        if(!objectProperties[relation].get())
+        {
+            objectProperties[relation] = getObjectProperty(iris[relation]);
+        }
+        axioms.push_back( told(kernel()->relatedTo(instance(subjects[i]).get(),
+                        objectProperties[relation].get(),
+                        instance(objects[i]).get())) );
+    }
+
+    const owlapi::model::ABoxBatch::IdList& valueSubjects = batch.getValueSubjects();
+    const owlapi::model::ABoxBatch::IdList& properties = batch.getValueProperties();
+    const owlapi::model::OWLLiteral::PtrList& values = batch.getValues();
+    for(size_t i = 0; i < valueSubjects.size(); ++i)
+    {
+        Id property = properties[i];
+        if(!functional[property])
+        {
+            dataProperties[property] = getDataProperty(iris[property]);
+            functional[property] = isFunctionalProperty(iris[property]) ? 1 : 2;
+        }
+
+        if(functional[property] == 1)
+        {
+            // retracts the previous value
+            axioms.push_back( valueOf(iris[valueSubjects[i]], iris[property], values[i]) );
+            continue;
+        }
+
+        Axiom axiom = told( kernel()->valueOf(instance(valueSubjects[i]).get(),
+                    dataProperties[property].get(),
+                    dataValue(values[i]).get()) );
+        mValueOfAxioms[ std::make_pair(iris[valueSubjects[i]], iris[property]) ].push_back(axiom);
+        axioms.push_back(axiom);
+    }
+    return axioms;
+}
+
 DataTypeName KnowledgeBase::dataType(const IRI& dataType)
 {
-    IRIDataTypeMap::const_iterator cit = mDataTypes.find(dataType);
-    if(cit != mDataTypes.end())
+    const DataTypeName* registered = mDataTypes.find(dataType);
+    if(registered)
     {
-        return cit->second;
+        return *registered;
     }
 
     // Guess reasoner datatype
-    DataTypeName dataTypeName(getExpressionManager()->DataType(dataType.toString()));
-    mDataTypes[dataType] = dataTypeName;
-    return dataTypeName;
+    DataTypeName expression(getExpressionManager()->DataType(dataType.toString()));
+    *mDataTypes.insert(dataType).first = expression;
+    return expression;
 }
 
 DataValue KnowledgeBase::dataValue(const std::string& value, const std::string& dataType)
 {
-    IRIDataTypeMap::const_iterator cit = mDataTypes.find(dataType);
-    if(cit == mDataTypes.end())
+    const DataTypeName* dataTypeName = mDataTypes.find(dataType);
+    if(!dataTypeName)
     {
         throw std::invalid_argument("owlapi::KnowledgeBase::dataValue: dataType '" + dataType + "' is unknown");
     }
 
-    DataTypeName dataTypeName = cit->second;
-    const TDLDataValue* dataValue = getExpressionManager()->DataValue(value, dataTypeName.get());
+    const TDLDataValue* dataValue = getExpressionManager()->DataValue(value, dataTypeName->get());
     return DataValue(dataValue);
 }
 
 DataValue KnowledgeBase::dataValue(const owlapi::model::OWLLiteral::Ptr& literal)
 {
-    return dataValue(literal->getValue(), literal->getType());
+    owlapi::model::LiteralDatatype::Id datatype = literal->getDatatypeId();
+    if(datatype >= mDataTypesById.size() || !mDataTypesById[datatype].get())
+    {
+        const DataTypeName* dataTypeName = mDataTypes.find(literal->getType());
+        if(!dataTypeName)
+        {
+            throw std::invalid_argument("owlapi::KnowledgeBase::dataValue: dataType '" + literal->getType() + "' is unknown");
+        }
+        if(datatype >= mDataTypesById.size())
+        {
+            mDataTypesById.resize(datatype + 1);
+        }
+        mDataTypesById[datatype] = *dataTypeName;
+    }
+
+    const TDLDataValue* dataValue = getExpressionManager()->DataValue(literal->getValue(), mDataTypesById[datatype].get());
+    return DataValue(dataValue);
 }
 
 Axiom KnowledgeBase::inverseOf(const IRI& base, const IRI& inverse)
@@ -828,7 +1054,7 @@ Axiom KnowledgeBase::inverseOf(const IRI& base, const IRI& inverse)
     ObjectPropertyExpression e_role = getObjectPropertyLazy(base);
     ObjectPropertyExpression e_inverse = getObjectPropertyLazy(inverse);
 
-    return Axiom( mKernel->setInverseRoles(e_role.get(), e_inverse.get()) );
+    return told( kernel()->setInverseRoles(e_role.get(), e_inverse.get()) );
 }
 
 ClassExpression KnowledgeBase::objectOneOf(const IRI& id,
@@ -936,7 +1162,7 @@ reasoner::factpp::DataRange KnowledgeBase::dataOneOf(const owlapi::model::OWLLit
     getExpressionManager()->newArgList();
     for(const owlapi::model::OWLLiteral::Ptr& literal : literals)
     {
-        DataValue dValue = dataValue(literal->getValue(), literal->getType());
+        DataValue dValue = dataValue(literal);
         getExpressionManager()->addArg(dValue.get());
     }
     return reasoner::factpp::DataRange( getExpressionManager()->DataOneOf() );
@@ -955,7 +1181,7 @@ reasoner::factpp::DataRange KnowledgeBase::dataTypeRestriction(const owlapi::mod
     for(const OWLFacetRestriction& fr : restriction->getFacetRestrictions())
     {
         const OWLLiteral::Ptr& literal = fr.getFacetValue();
-        DataValue dValue = dataValue(literal->getValue(), literal->getType());
+        DataValue dValue = dataValue(literal);
         const TDLFacetExpression* facetExpression;
 
         switch(fr.getFacet().getFacetType())
@@ -992,10 +1218,9 @@ reasoner::factpp::ClassExpression KnowledgeBase::classExpression(
         const IRI& expressionId
 )
 {
-    IRIClassExpressionMap::const_iterator it = mClasses.find(expressionId);
-    if(it != mClasses.end())
+    if(const ClassExpression* expression = mClasses.find(expressionId))
     {
-        return it->second;
+        return *expression;
     }
 
     throw std::invalid_argument("owlapi::KnowledgeBase::classExpression: failed"
@@ -1296,6 +1521,17 @@ ClassExpression KnowledgeBase::objectPropertyRestriction(
 
 bool KnowledgeBase::isSubClassOf(const IRI& subclass, const IRI& parentClass)
 {
+    Taxonomy::Ptr taxonomy = getHierarchy();
+    if(taxonomy && taxonomy->hasNode(subclass) && taxonomy->hasNode(parentClass))
+    {
+        if(subclass == parentClass)
+        {
+            return true;
+        }
+        IRIList ancestors = getTaxonomyRelatives(*taxonomy, subclass, false, true);
+        return std::find(ancestors.begin(), ancestors.end(), parentClass) != ancestors.end();
+    }
+
     try {
         ClassExpression e_class = getClass(subclass);
         return isSubClassOf( e_class, parentClass );
@@ -1312,7 +1548,8 @@ bool KnowledgeBase::isSubClassOf(const IRI& subclass, const IRI& parentClass)
 bool KnowledgeBase::isSubClassOf(const ClassExpression& subclass, const IRI& parentClass)
 {
     ClassExpression e_class = getClass(parentClass);
-    return mKernel->isSubsumedBy(subclass.get(), e_class.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isSubsumedBy(subclass.get(), e_class.get());
 }
 
 
@@ -1321,7 +1558,8 @@ bool KnowledgeBase::isEquivalentClass(const IRI& klass0, const IRI& klass1)
     ClassExpression e_class0 = getClass(klass0);
     ClassExpression e_class1 = getClass(klass1);
 
-    return mKernel->isEquivalent( e_class0.get(), e_class1.get() );
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isEquivalent( e_class0.get(), e_class1.get() );
 }
 
 bool KnowledgeBase::isDisjointClass(const IRI& klass0, const IRI& klass1)
@@ -1329,14 +1567,16 @@ bool KnowledgeBase::isDisjointClass(const IRI& klass0, const IRI& klass1)
     ClassExpression e_class0 = getClass(klass0);
     ClassExpression e_class1 = getClass(klass1);
 
-    return mKernel->isDisjoint( e_class0.get(), e_class1.get() );
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isDisjoint( e_class0.get(), e_class1.get() );
 }
 
 bool KnowledgeBase::isInstanceOf(const IRI& instance, const IRI& klass)
 {
     InstanceExpression e_instance = getInstance(instance);
     ClassExpression e_class = getClass(klass);
-    return mKernel->isInstance(e_instance.get(), e_class.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isInstance(e_instance.get(), e_class.get());
 }
 
 bool KnowledgeBase::isRelatedTo(const IRI& instance, const IRI& relationProperty, const IRI& otherInstance)
@@ -1345,52 +1585,91 @@ bool KnowledgeBase::isRelatedTo(const IRI& instance, const IRI& relationProperty
     InstanceExpression e_otherInstance = getInstance(otherInstance);
 
     ObjectPropertyExpression e_relation = getObjectProperty(relationProperty);
-    return mKernel->isRelated(e_instance.get(), e_relation.get(), e_otherInstance.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isRelated(e_instance.get(), e_relation.get(), e_otherInstance.get());
 }
 
 bool KnowledgeBase::isSameInstance(const IRI& instance, const IRI& otherInstance) const
 {
     InstanceExpression e_instance = getInstance(instance);
     InstanceExpression e_otherInstance = getInstance(otherInstance);
-    return mKernel->isSameIndividuals(e_instance.get(), e_otherInstance.get());
+    if(mSameAsIndex.isSame(instance, otherInstance))
+    {
+        return true;
+    }
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isSameIndividuals(e_instance.get(), e_otherInstance.get());
 }
 
 bool KnowledgeBase::isDatatype(const IRI& name) const
 {
-    return mDataTypes.find(name) != mDataTypes.end();
+    return mDataTypes.count(name);
 }
 
 IRIList KnowledgeBase::allClasses(bool excludeBottomClass) const
 {
-    IRIList klasses;
-    IRIClassExpressionMap::const_iterator cit = mClasses.begin();
-    for(; cit != mClasses.end(); ++cit)
-    {
-        klasses.push_back(cit->first);
-    }
+    IRIList klasses = mClasses.getIRIs();
+    std::sort(klasses.begin(), klasses.end());
     return klasses;
 }
 
 IRIList KnowledgeBase::allSubClassesOf(const IRI& klass, bool direct)
 {
+    Taxonomy::Ptr taxonomy = getHierarchy();
+    if(taxonomy && taxonomy->hasNode(klass))
+    {
+        return getTaxonomyRelatives(*taxonomy, klass, direct, false);
+    }
+
     ClassExpression e_class = getClass(klass);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needConcepts();
-    mKernel->getSubConcepts(e_class.get(), direct, actor);
+    kernel()->getSubConcepts(e_class.get(), direct, actor);
     // vocabulary::OWL::Nothing() is bottom concept, which is represented as "BOTTOM" in Factpp
     return getResult(actor, IRI("BOTTOM"));
 }
 
 IRIList KnowledgeBase::allAncestorsOf(const IRI& klass, bool direct)
 {
-    ClassExpression e_class = getClass(klass);
+    Taxonomy::Ptr taxonomy = getHierarchy();
+    if(taxonomy && taxonomy->hasNode(klass))
+    {
+        // answer from the adopted taxonomy, or from the last snapshot while
+        // background reasoning is running, without the kernel queries for
+        // equivalent and punned classes, which would require the kernel to
+        // be classified; equivalent ancestors are separate nodes of the
+        // taxonomy
+        return getTaxonomyRelatives(*taxonomy, klass, direct, true);
+    }
 
-    Actor actor;
-    actor.needConcepts();
-    mKernel->getSupConcepts(e_class.get(), direct, actor);
+    if(!direct)
+    {
+        if(mAncestorsGeneration != mGeneration)
+        {
+            // axioms have been told or retracted since caching
+            mAncestors.clear();
+            mAncestorsGeneration = mGeneration;
+        }
+
+        std::map<IRI, IRIList>::const_iterator cit = mAncestors.find(klass);
+        if(cit != mAncestors.end())
+        {
+            return cit->second;
+        }
+    }
+
+    IRIList directClassAncestors;
+    {
+        ClassExpression e_class = getClass(klass);
 
-    IRIList directClassAncestors = getResult(actor);
+        OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
+        Actor actor;
+        actor.needConcepts();
+        kernel()->getSupConcepts(e_class.get(), direct, actor);
+        directClassAncestors = getResult(actor);
+    }
     IRIList punningBasedAncestors;
     try {
         punningBasedAncestors = typesOf(klass);
@@ -1407,16 +1686,22 @@ IRIList KnowledgeBase::allAncestorsOf(const IRI& klass, bool direct)
 
     }
     ancestors.insert(punningBasedAncestors.begin(), punningBasedAncestors.end());
-    return IRIList(ancestors.begin(), ancestors.end());
+    IRIList allAncestors(ancestors.begin(), ancestors.end());
+    if(!direct)
+    {
+        mAncestors[klass] = allAncestors;
+    }
+    return allAncestors;
 }
 
 IRIList KnowledgeBase::allEquivalentClasses(const IRI& klass)
 {
     ClassExpression e_class = getClass(klass);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needConcepts();
-    mKernel->getEquivalentConcepts(e_class.get(), actor);
+    kernel()->getEquivalentConcepts(e_class.get(), actor);
     return getResult(actor);
 }
 
@@ -1424,21 +1709,18 @@ IRIList KnowledgeBase::allDisjointClasses(const IRI& klass)
 {
     ClassExpression e_class = getClass(klass);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needConcepts();
-    mKernel->getDisjointConcepts(e_class.get(), actor);
+    kernel()->getDisjointConcepts(e_class.get(), actor);
 
     return getResult(actor);
 }
 
 IRIList KnowledgeBase::allInstances() const
 {
-    IRIList instances;
-    IRIInstanceExpressionMap::const_iterator cit = mInstances.begin();
-    for(; cit != mInstances.end(); ++cit)
-    {
-        instances.push_back(cit->first);
-    }
+    IRIList instances = mInstances.getIRIs();
+    std::sort(instances.begin(), instances.end());
     return instances;
 }
 
@@ -1447,9 +1729,10 @@ IRIList KnowledgeBase::allInstancesOf(const IRI& klass, bool direct)
     ClassExpression e_class = getClass(klass);
     IRIList instances;
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needIndividuals();
-    mKernel->getInstances(e_class.get(), actor);
+    kernel()->getInstances(e_class.get(), actor);
 
     Actor::Array1D result;
     actor.getFoundData(result);
@@ -1468,6 +1751,36 @@ IRIList KnowledgeBase::allInstancesOf(const IRI& klass, bool direct)
     return instances;
 }
 
+const std::vector<const TNamedEntry*>& KnowledgeBase::getInstanceSet(const IRI& klass)
+{
+    if(!kernel()->isKBRealised())
+    {
+        // updates are pending, so cached sets might be outdated
+        mInstanceSets.clear();
+    }
+
+    std::map<IRI, std::vector<const TNamedEntry*> >::const_iterator cit = mInstanceSets.find(klass);
+    if(cit != mInstanceSets.end())
+    {
+        return cit->second;
+    }
+
+    ClassExpression e_class = getClass(klass);
+
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
+    Actor actor;
+    actor.needIndividuals();
+    kernel()->getInstances(e_class.get(), actor);
+
+    Actor::Array1D result;
+    actor.getFoundData(result);
+
+    std::vector<const TNamedEntry*>& instances = mInstanceSets[klass];
+    instances.assign(result.begin(), result.end());
+    std::sort(instances.begin(), instances.end());
+    return instances;
+}
+
 IRIList KnowledgeBase::allRelatedInstances(const IRI& individual, const IRI& relationProperty, const IRI& klass)
 {
     IRIList individuals;
@@ -1475,18 +1788,24 @@ IRIList KnowledgeBase::allRelatedInstances(const IRI& individual, const IRI& rel
         InstanceExpression e_instance = getInstance(individual);
         ObjectPropertyExpression e_relation = getObjectProperty(relationProperty);
 
+        // Retrieve the instance set before the role fillers, so that
+        // pending updates are detected
+        const std::vector<const TNamedEntry*>* instanceSet = NULL;
+        if(!klass.empty())
+        {
+            instanceSet = &getInstanceSet(klass);
+        }
+
         ReasoningKernel::IndividualSet relatedIndividuals;
-        mKernel->getRoleFillers(e_instance.get(), e_relation.get(), relatedIndividuals);
+        kernel()->getRoleFillers(e_instance.get(), e_relation.get(), relatedIndividuals);
 
         ReasoningKernel::IndividualSet::const_iterator cit = relatedIndividuals.begin();
         for(; cit != relatedIndividuals.end(); ++cit)
         {
             const TNamedEntry* entry = *cit;
-            IRI iri( entry->getName() );
-
-            if( klass.empty() || isInstanceOf(iri, klass) )
+            if( !instanceSet || std::binary_search(instanceSet->begin(), instanceSet->end(), entry) )
             {
-                individuals.push_back(iri);
+                individuals.push_back( IRI(entry->getName()) );
             }
         }
     } catch(const std::exception& e)
@@ -1513,20 +1832,24 @@ IRIList KnowledgeBase::allInverseRelatedInstances(const IRI& individual, const I
     try {
         InstanceExpression e_instance = getInstance(individual);
         ObjectPropertyExpression e_relation = getObjectProperty(relationProperty);
-        TDLObjectRoleExpression* f_inverse = mKernel->getExpressionManager()->Inverse(e_relation.get());
+        TDLObjectRoleExpression* f_inverse = kernel()->getExpressionManager()->Inverse(e_relation.get());
+
+        const std::vector<const TNamedEntry*>* instanceSet = NULL;
+        if(!klass.empty())
+        {
+            instanceSet = &getInstanceSet(klass);
+        }
 
         ReasoningKernel::IndividualSet relatedIndividuals;
-        mKernel->getRoleFillers(e_instance.get(), f_inverse, relatedIndividuals);
+        kernel()->getRoleFillers(e_instance.get(), f_inverse, relatedIndividuals);
 
         ReasoningKernel::IndividualSet::const_iterator cit = relatedIndividuals.begin();
         for(; cit != relatedIndividuals.end(); ++cit)
         {
             const TNamedEntry* entry = *cit;
-            IRI iri( entry->getName() );
-
-            if( klass.empty() || isInstanceOf(iri, klass) )
+            if( !instanceSet || std::binary_search(instanceSet->begin(), instanceSet->end(), entry) )
             {
-                individuals.push_back(iri);
+                individuals.push_back( IRI(entry->getName()) );
             }
         }
     } catch(const std::exception& e)
@@ -1540,16 +1863,15 @@ IRIList KnowledgeBase::allInverseRelatedInstances(const IRI& individual, const I
 IRIList KnowledgeBase::allObjectProperties() const
 {
     IRIList properties;
-    IRIObjectPropertyExpressionMap::const_iterator cit = mObjectProperties.begin();
-    for(; cit != mObjectProperties.end(); ++cit)
+    for(const IRI& iri : mObjectProperties.getIRIs())
     {
-        const owlapi::model::IRI& iri = cit->first;
         if(iri == vocabulary::OWL::topObjectProperty() || iri == vocabulary::OWL::bottomObjectProperty())
         {
             continue;
         }
         properties.push_back(iri);
     }
+    std::sort(properties.begin(), properties.end());
     return properties;
 }
 
@@ -1558,9 +1880,10 @@ IRIList KnowledgeBase::allAncestorObjectProperties(const IRI& property, bool dir
 {
     ObjectPropertyExpression e_role = getObjectProperty(property);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needObjectRoles();
-    mKernel->getSupRoles(e_role.get(), direct, actor);
+    kernel()->getSupRoles(e_role.get(), direct, actor);
 
     IRIList directAncestors = getResult(actor);
     IRISet ancestors(directAncestors.begin(), directAncestors.end());
@@ -1578,9 +1901,10 @@ IRIList KnowledgeBase::allSubObjectProperties(const IRI& propertyRelation, bool
 {
     ObjectPropertyExpression e_relation = getObjectProperty(propertyRelation);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needObjectRoles();
-    mKernel->getSubRoles(e_relation.get(), direct, actor);
+    kernel()->getSubRoles(e_relation.get(), direct, actor);
 
     return getResult(actor);
 }
@@ -1590,9 +1914,10 @@ IRIList KnowledgeBase::allEquivalentObjectProperties(const IRI& propertyRelation
     ObjectPropertyExpression e_relation = getObjectProperty(propertyRelation);
     IRIList relations;
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needObjectRoles();
-    mKernel->getEquivalentRoles(e_relation.get(), actor);
+    kernel()->getEquivalentRoles(e_relation.get(), actor);
     return getResult(actor);
 }
 
@@ -1615,14 +1940,16 @@ bool KnowledgeBase::isSubObjectProperty(const IRI& relationProperty, const IRI&
 {
     ObjectPropertyExpression e_child = getObjectProperty(relationProperty);
     ObjectPropertyExpression e_parent = getObjectProperty(parentRelationProperty);
-    return mKernel->isSubRoles(e_child.get(), e_parent.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isSubRoles(e_child.get(), e_parent.get());
 }
 
 bool KnowledgeBase::isSubDataProperty(const IRI& relationProperty, const IRI& parentRelationProperty)
 {
     DataPropertyExpression e_child = getDataProperty(relationProperty);
     DataPropertyExpression e_parent = getDataProperty(parentRelationProperty);
-    return mKernel->isSubRoles(e_child.get(), e_parent.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isSubRoles(e_child.get(), e_parent.get());
 }
 
 bool KnowledgeBase::isDisjointProperties(const IRI& relationProperty0, const IRI& relationProperty1)
@@ -1644,29 +1971,30 @@ bool KnowledgeBase::isDisjointObjectProperties(const IRI& relationProperty0, con
 {
     ObjectPropertyExpression e_child = getObjectProperty(relationProperty0);
     ObjectPropertyExpression e_parent = getObjectProperty(relationProperty1);
-    return mKernel->isDisjointRoles(e_child.get(), e_parent.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isDisjointRoles(e_child.get(), e_parent.get());
 }
 
 bool KnowledgeBase::isDisjointDataProperties(const IRI& relationProperty0, const IRI& relationProperty1)
 {
     DataPropertyExpression e_child = getDataProperty(relationProperty0);
     DataPropertyExpression e_parent = getDataProperty(relationProperty1);
-    return mKernel->isDisjointRoles(e_child.get(), e_parent.get());
+    OWLAPI_INSTRUMENT_SCOPE(KB_ENTAILMENT_QUERY);
+    return kernel()->isDisjointRoles(e_child.get(), e_parent.get());
 }
 
 IRIList KnowledgeBase::allDataProperties() const
 {
     IRIList properties;
-    IRIDataPropertyExpressionMap::const_iterator cit = mDataProperties.begin();
-    for(; cit != mDataProperties.end(); ++cit)
+    for(const IRI& iri : mDataProperties.getIRIs())
     {
-        const owlapi::model::IRI& iri = cit->first;
         if(iri == vocabulary::OWL::topDataProperty() || iri == vocabulary::OWL::bottomDataProperty())
         {
             continue;
         }
-        properties.push_back(cit->first);
+        properties.push_back(iri);
     }
+    std::sort(properties.begin(), properties.end());
     return properties;
 }
 
@@ -1674,9 +2002,10 @@ IRIList KnowledgeBase::allAncestorDataProperties(const IRI& property, bool direc
 {
     DataPropertyExpression e_role = getDataProperty(property);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needDataRoles();
-    mKernel->getSupRoles(e_role.get(), direct, actor);
+    kernel()->getSupRoles(e_role.get(), direct, actor);
 
     IRIList directAncestors = getResult(actor);
     IRISet ancestors(directAncestors.begin(), directAncestors.end());
@@ -1695,9 +2024,10 @@ IRIList KnowledgeBase::allSubDataProperties(const IRI& propertyRelation, bool di
     DataPropertyExpression e_relation = getDataProperty(propertyRelation);
     IRIList relations;
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needDataRoles();
-    mKernel->getSubRoles(e_relation.get(), direct, actor);
+    kernel()->getSubRoles(e_relation.get(), direct, actor);
 
     return getResult(actor);
 }
@@ -1707,9 +2037,10 @@ IRIList KnowledgeBase::allEquivalentDataProperties(const IRI& propertyRelation)
     DataPropertyExpression e_relation = getDataProperty(propertyRelation);
     IRIList relations;
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needDataRoles();
-    mKernel->getEquivalentRoles(e_relation.get(), actor);
+    kernel()->getEquivalentRoles(e_relation.get(), actor);
 
     return getResult(actor);
 }
@@ -1733,9 +2064,10 @@ IRIList KnowledgeBase::getDataPropertyDomain(const IRI& property, bool direct) c
 {
     DataPropertyExpression e_property = getDataProperty(property);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needConcepts();
-    mKernel->getDRoleDomain( e_property.get(), direct, actor);
+    kernel()->getDRoleDomain( e_property.get(), direct, actor);
 
     return getResult(actor);
 }
@@ -1744,9 +2076,10 @@ IRIList KnowledgeBase::typesOf(const IRI& instance, bool direct) const
 {
     InstanceExpression e_instance = getInstance(instance);
 
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needConcepts();
-    mKernel->getTypes(e_instance.get(), direct, actor);
+    kernel()->getTypes(e_instance.get(), direct, actor);
 
     return getResult(actor);
 }
@@ -1760,75 +2093,282 @@ IRI KnowledgeBase::typeOf(const IRI& instance) const
 
 IRIList KnowledgeBase::getSameAs(const IRI& aliasOrInstance)
 {
-    InstanceExpression e_instance = getInstance(aliasOrInstance);
+    if(!mSameAsResolved.count(aliasOrInstance))
+    {
+        resolveSameAs(aliasOrInstance);
+    }
+    return mSameAsIndex.getSameAs(aliasOrInstance);
+}
 
+void KnowledgeBase::resolveSameAs(const IRI& instance)
+{
+    InstanceExpression e_instance = getInstance(instance);
+
+    OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
     Actor actor;
     actor.needIndividuals();
-    mKernel->getSameAs(e_instance.get(), actor);
+    kernel()->getSameAs(e_instance.get(), actor);
 
+    // The reasoner returns the complete equivalence class, so all
+    // members are resolved with this single query
     IRIList alias = getResult(actor);
-
-    if(alias.empty())
+    IRIList::const_iterator cit = alias.begin();
+    for(; cit != alias.end(); ++cit)
     {
-        IRIList list;
-        list.push_back(aliasOrInstance);
-        return list;
-    } else {
-        return alias;
+        mSameAsIndex.merge(instance, *cit);
+        mSameAsResolved.insert(*cit);
     }
+    mSameAsResolved.insert(instance);
 }
 
-IRIList KnowledgeBase::uniqueList(const IRIList& individuals)
+void KnowledgeBase::clearCaches()
 {
-    IRIList base = individuals;
-    IRIList unique = individuals;
-    IRIList blacklist;
+    mSameAsResolved.clear();
+    mInstanceSets.clear();
+    mTaxonomy.reset();
+    mTaxonomyAdopted = false;
+    mAncestors.clear();
+    ++mGeneration;
+}
+
+Taxonomy::Ptr KnowledgeBase::getTaxonomy()
+{
+    if(mTaxonomyAdopted)
+    {
+        return mTaxonomy;
+    }
 
-    IRIList::const_iterator bit = base.begin();
+    if(!kernel()->isKBClassified())
+    {
+        classify();
+    }
 
-    for(; bit != base.end(); ++bit)
+    if(!mTaxonomy)
     {
-        IRI individual = *bit;
-        if( blacklist.end() != std::find(blacklist.begin(), blacklist.end(), individual) )
+        TaxonomySnapshot snapshot = getTaxonomySnapshot();
+        if(snapshot.taxonomy && !snapshot.stale)
         {
-            LOG_DEBUG_S << "In blacklist: " << individual;
-            continue;
+            // created by background reasoning
+            mTaxonomy = snapshot.taxonomy;
+        } else {
+            mTaxonomy = createTaxonomy(kernel());
+            publishTaxonomy(mTaxonomy, mGeneration);
         }
+    }
+    return mTaxonomy;
+}
 
-        IRIList::iterator uit = unique.begin();
-        for(; uit != unique.end();)
+Taxonomy::Ptr KnowledgeBase::createTaxonomy(ReasoningKernel* kernel) const
+{
+    IRIList klasses = allClasses();
+    std::vector< std::pair<IRI, IRI> > directSubClasses;
+    for(const IRI& klass : klasses)
+    {
+        ClassExpression e_class = getClass(klass);
+
+        OWLAPI_INSTRUMENT_SCOPE(KB_ACTOR_QUERY);
+        Actor actor;
+        actor.needConcepts();
+        kernel->getSubConcepts(e_class.get(), true, actor);
+        IRIList subclasses = getResult(actor, IRI("BOTTOM"));
+        for(const IRI& subclass : subclasses)
         {
-            IRI otherIndividual = *uit;
-            if(individual != otherIndividual && isSameInstance(individual, otherIndividual) )
+            directSubClasses.push_back( std::make_pair(klass, subclass) );
+        }
+    }
+    return make_shared<Taxonomy>(klasses, directSubClasses);
+}
+
+Taxonomy::Ptr KnowledgeBase::getHierarchy() const
+{
+    if(mTaxonomyAdopted)
+    {
+        return mTaxonomy;
+    }
+    if(isReasoning())
+    {
+        return getTaxonomySnapshot().taxonomy;
+    }
+    return Taxonomy::Ptr();
+}
+
+void KnowledgeBase::publishTaxonomy(const Taxonomy::Ptr& taxonomy, uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mTaxonomySnapshotMutex);
+    mTaxonomySnapshot = taxonomy;
+    mTaxonomySnapshotGeneration = generation;
+}
+
+KnowledgeBase::TaxonomySnapshot KnowledgeBase::getTaxonomySnapshot() const
+{
+    TaxonomySnapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mTaxonomySnapshotMutex);
+        snapshot.taxonomy = mTaxonomySnapshot;
+        snapshot.generation = mTaxonomySnapshotGeneration;
+    }
+    snapshot.stale = !snapshot.taxonomy || snapshot.generation != mGeneration;
+    return snapshot;
+}
+
+void KnowledgeBase::setTaxonomy(const Taxonomy::Ptr& taxonomy)
+{
+    if(!taxonomy)
+    {
+        throw std::invalid_argument("owlapi::KnowledgeBase::setTaxonomy: taxonomy is not set");
+    }
+
+    waitForReasoning();
+    mTaxonomy = taxonomy;
+    mTaxonomyAdopted = true;
+    mAncestors.clear();
+    publishTaxonomy(mTaxonomy, mGeneration);
+}
+
+IRIList KnowledgeBase::getTaxonomyRelatives(const Taxonomy& taxonomy, const IRI& klass, bool direct, bool ancestors)
+{
+    // The taxonomy is shared with snapshots, so avoid its traversal
+    // functions, which are not thread-safe
+    std::vector<Taxonomy::NodeId> pending(1, taxonomy.getId(klass));
+    std::unordered_set<Taxonomy::NodeId> visited(pending.begin(), pending.end());
+    IRIList relatives;
+    while(!pending.empty())
+    {
+        Taxonomy::NodeId node = pending.back();
+        pending.pop_back();
+        Taxonomy::Range range = ancestors ? taxonomy.getParents(node) : taxonomy.getChildren(node);
+        for(Taxonomy::NodeId relative : range)
+        {
+            if(visited.insert(relative).second)
             {
-                LOG_DEBUG_S << "Remove " << *uit << " since its an alias";
-                unique.erase(uit);
-                blacklist.push_back(otherIndividual);
-            } else {
-                ++uit;
+                relatives.push_back(taxonomy.getIRI(relative));
+                if(!direct)
+                {
+                    pending.push_back(relative);
+                }
             }
         }
     }
+    return relatives;
+}
+
+void KnowledgeBase::resetSameAs()
+{
+    mSameAsIndex.clear();
+    mSameAsResolved.clear();
+
+    std::map<const TDLAxiom*, std::pair<IRI, IRI> >::const_iterator cit = mSameAsAxioms.begin();
+    for(; cit != mSameAsAxioms.end(); ++cit)
+    {
+        mSameAsIndex.merge(cit->second.first, cit->second.second);
+    }
+}
+
+IRIList KnowledgeBase::uniqueList(const IRIList& individuals)
+{
+    IRIList unique;
+    std::unordered_set<IRI> representatives;
+
+    IRIList::const_iterator cit = individuals.begin();
+    for(; cit != individuals.end(); ++cit)
+    {
+        const IRI& individual = *cit;
+        if(!mSameAsResolved.count(individual))
+        {
+            resolveSameAs(individual);
+        }
+
+        if( representatives.insert( mSameAsIndex.getRepresentative(individual) ).second )
+        {
+            unique.push_back(individual);
+        } else {
+            LOG_DEBUG_S << "Remove " << individual << " since its an alias";
+        }
+    }
 
     return unique;
 }
 
 void KnowledgeBase::retract(const Axiom& a)
 {
-    mKernel->retract(const_cast<TDLAxiom*>(a.get()));
+    OWLAPI_INSTRUMENT_SCOPE(KB_RETRACT);
+    kernel()->retract(const_cast<TDLAxiom*>(a.get()));
+
+    // Sameness cannot be split in the index, so rebuild it from the told
+    // axioms if a sameness axiom has been retracted
+    if(mSameAsAxioms.erase(a.get()) > 0)
+    {
+        resetSameAs();
+    }
+    clearCaches();
 }
 
 void KnowledgeBase::retractRelated(const owlapi::model::OWLAxiom::Ptr& a)
 {
-    ReferencedAxiomsMap::iterator it = mReferencedAxiomsMap.find(a);
-    if(it != mReferencedAxiomsMap.end())
+    retractRelated(owlapi::model::OWLAxiom::PtrList(1, a));
+}
+
+void KnowledgeBase::retractRelated(const owlapi::model::OWLAxiom::PtrList& axioms)
+{
+    reasoner::factpp::Axiom::List kbAxioms;
+    for(const owlapi::model::OWLAxiom::Ptr& axiom : axioms)
     {
-        reasoner::factpp::Axiom::List& axioms = it->second;
-        reasoner::factpp::Axiom::List::iterator ait = axioms.begin();
-        for(; ait != axioms.end(); ++ait)
+        ReferencedAxiomsMap::iterator it = mReferencedAxiomsMap.find(axiom);
+        if(it == mReferencedAxiomsMap.end())
+        {
+            continue;
+        }
+
+        if(axiom->getAxiomType() == owlapi::model::OWLAxiom::DataPropertyAssertion)
         {
-            retract(*ait);
+            forgetValueOf(axiom, it->second);
         }
+        kbAxioms.insert(kbAxioms.end(), it->second.begin(), it->second.end());
+        mReferencedAxiomsMap.erase(it);
+    }
+
+    if(kbAxioms.empty())
+    {
+        return;
+    }
+
+    OWLAPI_INSTRUMENT_SCOPE(KB_RETRACT);
+    bool sameAsRetracted = false;
+    for(const reasoner::factpp::Axiom& kbAxiom : kbAxioms)
+    {
+        kernel()->retract(const_cast<TDLAxiom*>(kbAxiom.get()));
+        sameAsRetracted |= mSameAsAxioms.erase(kbAxiom.get()) > 0;
+    }
+    if(sameAsRetracted)
+    {
+        resetSameAs();
+    }
+    clearCaches();
+}
+
+void KnowledgeBase::forgetValueOf(const owlapi::model::OWLAxiom::Ptr& axiom, const reasoner::factpp::Axiom::List& kbAxioms)
+{
+    owlapi::model::OWLDataPropertyAssertionAxiom::Ptr assertion =
+        dynamic_pointer_cast<owlapi::model::OWLDataPropertyAssertionAxiom>(axiom);
+    std::pair<IRI, IRI> key(assertion->getSubject()->getReferenceID(),
+            dynamic_pointer_cast<owlapi::model::OWLDataProperty>(assertion->getProperty())->getIRI());
+    DataValueMap::iterator it = mValueOfAxioms.find(key);
+    if(it == mValueOfAxioms.end())
+    {
+        return;
+    }
+
+    Axiom::List& values = it->second;
+    for(const Axiom& kbAxiom : kbAxioms)
+    {
+        values.erase(std::remove_if(values.begin(), values.end(), [&kbAxiom](const Axiom& value)
+                    {
+                        return value.get() == kbAxiom.get();
+                    }), values.end());
+    }
+    if(values.empty())
+    {
+        mValueOfAxioms.erase(it);
     }
 }
 
@@ -1837,6 +2377,11 @@ void KnowledgeBase::addReference(const owlapi::model::OWLAxiom::Ptr& modelAxiom,
     mReferencedAxiomsMap[modelAxiom].push_back(kbAxiom);
 }
 
+void KnowledgeBase::removeReference(const owlapi::model::OWLAxiom::Ptr& modelAxiom)
+{
+    mReferencedAxiomsMap.erase(modelAxiom);
+}
+
 bool KnowledgeBase::assertAndAddRelation(const IRI& instance, const IRI& relation, const IRI& otherInstance)
 {
     if( isRelatedTo(instance, relation, otherInstance) )
@@ -1862,7 +2407,7 @@ bool KnowledgeBase::assertAndAddRelation(const IRI& instance, const IRI& relatio
 DataValue KnowledgeBase::getDataValue(const IRI& instance, const IRI& dataProperty)
 {
     // Iterate over all axioms and filter the relevant one
-    const AxiomVec& axioms = mKernel->getOntology().getAxioms();
+    const AxiomVec& axioms = kernel()->getOntology().getAxioms();
     for(TDLAxiom* axiom : axioms)
     {
         TDLAxiomValueOf* valueAxiom = dynamic_cast<TDLAxiomValueOf*>(axiom);
@@ -1880,6 +2425,43 @@ DataValue KnowledgeBase::getDataValue(const IRI& instance, const IRI& dataProper
 
 }
 
+owlapi::model::MemoryUsage KnowledgeBase::getMemoryUsage() const
+{
+    using namespace owlapi::model;
+
+    MemoryUsage usage;
+    usage.add("instances", mInstances.size(), mInstances.getMemoryUsage());
+    usage.add("classes", mClasses.size(), mClasses.getMemoryUsage());
+    usage.add("object_properties", mObjectProperties.size(), mObjectProperties.getMemoryUsage());
+    usage.add("data_properties", mDataProperties.size(), mDataProperties.getMemoryUsage());
+    usage.add("data_types", mDataTypes.size() + mDataTypesById.size(),
+            mDataTypes.getMemoryUsage() + memory::heapBytes(mDataTypesById));
+    usage.add("data_ranges", mDataRanges.size(), memory::heapBytes(mDataRanges));
+    usage.add("value_of_axioms", mValueOfAxioms.size(), memory::heapBytes(mValueOfAxioms));
+    usage.add("referenced_axioms", mReferencedAxiomsMap.size(), memory::heapBytes(mReferencedAxiomsMap));
+    usage.add("same_as", mSameAsIndex.size(), mSameAsIndex.getMemoryUsage()
+            + memory::heapBytes(mSameAsResolved) + memory::heapBytes(mSameAsAxioms));
+    usage.add("instance_sets", mInstanceSets.size(), memory::heapBytes(mInstanceSets));
+    usage.add("ancestors", mAncestors.size(), memory::heapBytes(mAncestors));
+
+    // mTaxonomy is owned by the calling thread like all other members,
+    // while the snapshot is published by background reasoning
+    uint64_t taxonomyBytes = 0;
+    uint64_t taxonomySize = 0;
+    if(mTaxonomy)
+    {
+        taxonomyBytes += mTaxonomy->getMemoryUsage();
+        taxonomySize = mTaxonomy->size();
+    }
+    Taxonomy::Ptr snapshot = getTaxonomySnapshot().taxonomy;
+    if(snapshot && snapshot != mTaxonomy)
+    {
+        taxonomyBytes += snapshot->getMemoryUsage();
+    }
+    usage.add("taxonomy", taxonomySize, taxonomyBytes);
+    return usage;
+}
+
 std::string KnowledgeBase::toString(representation::Type representation) const
 {
     switch(representation)
@@ -1889,7 +2471,7 @@ std::string KnowledgeBase::toString(representation::Type representation) const
             std::stringstream ss;
             TLISPOntologyPrinter printer(ss);
 
-            TOntology& ontology = mKernel->getOntology();
+            TOntology& ontology = kernel()->getOntology();
             printer.visitOntology(ontology);
 
             return ss.str();
@@ -1908,7 +2490,7 @@ std::string KnowledgeBase::toString(representation::Type representation) const
 ExplorationNode KnowledgeBase::getExplorationNode(const IRI& klass)
 {
     ClassExpression e_klass = getClass(klass);
-    ExplorationNode e( mKernel->buildCompletionTree(e_klass.get()));
+    ExplorationNode e( kernel()->buildCompletionTree(e_klass.get()));
     return e;
 }
 
@@ -1919,7 +2501,7 @@ owlapi::model::IRISet KnowledgeBase::getRelatedObjectProperties(const IRI& insta
     bool isDataProperty = false;
 
     std::vector<const TNamedEntry*> names;
-    mKernel->getRelatedRoles(e_instance.get(), names, isDataProperty, needInverse);
+    kernel()->getRelatedRoles(e_instance.get(), names, isDataProperty, needInverse);
     for(const TNamedEntry* entry : names)
     {
         relatedProperties.insert( owlapi::model::IRI( entry->getName() ) );
@@ -1934,7 +2516,7 @@ reasoner::factpp::ObjectPropertyExpressionList KnowledgeBase::getRelatedObjectPr
     bool onlyDeterministicInfo = false;
     bool needIncoming = false;
 
-    mKernel->getObjectRoles(e_node.get(), result, onlyDeterministicInfo, needIncoming);
+    kernel()->getObjectRoles(e_node.get(), result, onlyDeterministicInfo, needIncoming);
 
     ObjectPropertyExpressionList relatedObjectProperties;
     ReasoningKernel::TCGRoleSet::const_iterator cit = result.begin();
@@ -1953,12 +2535,12 @@ owlapi::model::IRISet KnowledgeBase::getRelatedDataProperties(const IRI& instanc
 {
     owlapi::model::IRISet dataProperties;
 
-    for(const DataValueMap::value_type v : mValueOfAxioms)
+    // entries are ordered by instance, so only the range of the instance
+    // needs to be visited
+    DataValueMap::const_iterator cit = mValueOfAxioms.lower_bound( std::make_pair(instance, IRI()) );
+    for(; cit != mValueOfAxioms.end() && cit->first.first == instance; ++cit)
     {
-        if(v.first.first == instance)
-        {
-            dataProperties.insert(v.first.second);
-        }
+        dataProperties.insert(cit->first.second);
     }
     return dataProperties;
 
@@ -1968,7 +2550,7 @@ owlapi::model::IRISet KnowledgeBase::getRelatedDataProperties(const IRI& instanc
     //InstanceExpression e_instance = getInstance(instance);
     //bool isDataProperty = true;
     //std::vector<const TNamedEntry*> names;
-    //mKernel->getRelatedRoles(e_instance.get(), names, isDataProperty, needInverse);
+    //kernel()->getRelatedRoles(e_instance.get(), names, isDataProperty, needInverse);
 
     //for(const TNamedEntry* entry : names)
     //{
@@ -1982,7 +2564,7 @@ DataPropertyExpressionList KnowledgeBase::getRelatedDataPropertiesByKlass(const
     ReasoningKernel::TCGRoleSet result;
     bool onlyDeterministicInfo = false;
 
-    mKernel->getDataRoles(e_node.get(), result, onlyDeterministicInfo);
+    kernel()->getDataRoles(e_node.get(), result, onlyDeterministicInfo);
 
     DataPropertyExpressionList relatedDataProperties;
     ReasoningKernel::TCGRoleSet::const_iterator cit = result.begin();
@@ -1997,15 +2579,16 @@ DataPropertyExpressionList KnowledgeBase::getRelatedDataPropertiesByKlass(const
 
 void KnowledgeBase::cleanup()
 {
-    ReferencedAxiomsMap::iterator it = mReferencedAxiomsMap.begin();
-    for(; it != mReferencedAxiomsMap.end(); ++it)
+    owlapi::model::OWLAxiom::PtrList axioms;
+    ReferencedAxiomsMap::const_iterator cit = mReferencedAxiomsMap.begin();
+    for(; cit != mReferencedAxiomsMap.end(); ++cit)
     {
-        //owlapi::model::OWLAxiom::Ptr& axiom = it->first;
-        if(it->first->isMarkedForRetraction())
+        if(cit->first->isMarkedForRetraction())
         {
-            retractRelated(it->first);
+            axioms.push_back(cit->first);
         }
     }
+    retractRelated(axioms);
 
     // Cleanup cache as well
     mInstances.clear();
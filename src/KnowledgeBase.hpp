@@ -3,13 +3,23 @@
 
 #include <string.h>
 #include <map>
+#include <unordered_set>
 #include <vector>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <functional>
 #include <base-logging/Logging.hpp>
 #include <factpp/Actor.h>
 #include "OWLApi.hpp"
 #include "reasoner/factpp/Types.hpp"
+#include "reasoner/factpp/EntityRegistry.hpp"
 #include "model/OWLDataRange.hpp"
 #include "model/OWLObjectOneOf.hpp"
+#include "model/SameAsIndex.hpp"
+#include "model/Taxonomy.hpp"
+#include "model/ABoxBatch.hpp"
+#include "model/MemoryUsage.hpp"
 
 namespace owlapi {
 
@@ -27,11 +37,11 @@ typedef owlapi::model::IRI IRI;
 typedef owlapi::model::IRIList IRIList;
 typedef owlapi::model::IRISet IRISet;
 
-typedef std::map<IRI, reasoner::factpp::ClassExpression > IRIClassExpressionMap;
-typedef std::map<IRI, reasoner::factpp::InstanceExpression > IRIInstanceExpressionMap;
-typedef std::map<IRI, reasoner::factpp::ObjectPropertyExpression > IRIObjectPropertyExpressionMap;
-typedef std::map<IRI, reasoner::factpp::DataPropertyExpression > IRIDataPropertyExpressionMap;
-typedef std::map<IRI, reasoner::factpp::DataTypeName > IRIDataTypeMap;
+typedef reasoner::factpp::EntityRegistry<reasoner::factpp::ClassExpression> ClassExpressionRegistry;
+typedef reasoner::factpp::EntityRegistry<reasoner::factpp::InstanceExpression> InstanceExpressionRegistry;
+typedef reasoner::factpp::EntityRegistry<reasoner::factpp::ObjectPropertyExpression> ObjectPropertyExpressionRegistry;
+typedef reasoner::factpp::EntityRegistry<reasoner::factpp::DataPropertyExpression> DataPropertyExpressionRegistry;
+typedef reasoner::factpp::EntityRegistry<reasoner::factpp::DataTypeName> DataTypeRegistry;
 typedef std::map< std::pair<IRI, IRI>, reasoner::factpp::Axiom::List> DataValueMap;
 typedef std::map<owlapi::model::OWLDataRange::Ptr, reasoner::factpp::DataRange> DataRangeMap;
 
@@ -50,16 +60,132 @@ class KnowledgeBase
 {
     ReasoningKernel* mKernel;
 
-    IRIInstanceExpressionMap mInstances;
-    IRIClassExpressionMap mClasses;
-    IRIObjectPropertyExpressionMap mObjectProperties;
-    IRIDataPropertyExpressionMap mDataProperties;
-    IRIDataTypeMap mDataTypes;
+    InstanceExpressionRegistry mInstances;
+    ClassExpressionRegistry mClasses;
+    ObjectPropertyExpressionRegistry mObjectProperties;
+    DataPropertyExpressionRegistry mDataProperties;
+    DataTypeRegistry mDataTypes;
+    /// Reasoner datatypes indexed by interned literal datatype id, \see
+    /// owlapi::model::LiteralDatatype
+    std::vector<reasoner::factpp::DataTypeName> mDataTypesById;
     DataRangeMap mDataRanges;
 
     DataValueMap mValueOfAxioms;
     ReferencedAxiomsMap mReferencedAxiomsMap;
 
+    /// Equivalence classes of individuals (told and inferred)
+    owlapi::model::SameAsIndex mSameAsIndex;
+    /// Individuals whose equivalence class has been completed from the
+    /// reasoner since the last refresh
+    std::unordered_set<IRI> mSameAsResolved;
+    /// Told sameness axioms, required to rebuild the index after a retraction
+    std::map<const TDLAxiom*, std::pair<IRI, IRI> > mSameAsAxioms;
+
+    /// Sorted instance sets of classes, valid until the next update of the
+    /// knowledge base
+    std::map<IRI, std::vector<const TNamedEntry*> > mInstanceSets;
+
+    /**
+     * Get the (cached) sorted set of all instances of a given class
+     * \throw std::invalid_argument if the class is not known
+     */
+    const std::vector<const TNamedEntry*>& getInstanceSet(const IRI& klass);
+
+    /**
+     * Complete the equivalence class of the given individual from the
+     * reasoner
+     */
+    void resolveSameAs(const IRI& instance);
+
+    /**
+     * Drop all inferred sameness information and rebuild the index from the
+     * told sameness axioms
+     */
+    void resetSameAs();
+
+    /// Snapshot of the class hierarchy, created on demand after classification
+    owlapi::model::Taxonomy::Ptr mTaxonomy;
+    /// True if mTaxonomy has been computed externally, \see setTaxonomy
+    bool mTaxonomyAdopted;
+
+    /**
+     * Retrieve the descendants or ancestors of a class from the given
+     * taxonomy
+     */
+    static IRIList getTaxonomyRelatives(const owlapi::model::Taxonomy& taxonomy, const IRI& klass, bool direct, bool ancestors);
+
+    /**
+     * Get the taxonomy which answers class hierarchy queries without
+     * accessing the kernel, i.e. the adopted taxonomy, or the last snapshot
+     * while background reasoning is running
+     * \return taxonomy, or a null pointer if the kernel has to be queried
+     */
+    owlapi::model::Taxonomy::Ptr getHierarchy() const;
+
+    /// Incremented whenever reasoning results are invalidated
+    std::atomic<uint64_t> mGeneration;
+    /// Result of the pending background reasoning, which is available
+    /// before the callback is called, \see classifyAsync
+    std::shared_future<uint64_t> mReasoning;
+    /// Background task including the callback
+    std::shared_future<void> mReasoningTask;
+    /// Guards mReasoning and mReasoningTask, which are accessed from the
+    /// callback as well
+    mutable std::mutex mReasoningMutex;
+    /// Last completed snapshot of the class hierarchy, which might be
+    /// accessed while background reasoning is running
+    owlapi::model::Taxonomy::Ptr mTaxonomySnapshot;
+    uint64_t mTaxonomySnapshotGeneration;
+    mutable std::mutex mTaxonomySnapshotMutex;
+
+    /**
+     * Access the reasoning kernel, after waiting for pending background
+     * reasoning
+     */
+    ReasoningKernel* kernel() const;
+
+    /**
+     * Wait until pending background reasoning has been completed
+     */
+    void waitForReasoning() const;
+
+    /**
+     * Wrap an axiom which has been added to the kernel, and invalidate the
+     * current snapshot as well as an adopted taxonomy
+     */
+    reasoner::factpp::Axiom told(TDLAxiom* axiom);
+
+    /**
+     * Start background reasoning, \see classifyAsync
+     */
+    std::shared_future<uint64_t> reasonAsync(bool realize, const std::function<void(uint64_t)>& callback);
+
+    /**
+     * Create the taxonomy from the given (classified) kernel
+     */
+    owlapi::model::Taxonomy::Ptr createTaxonomy(ReasoningKernel* kernel) const;
+
+    /**
+     * Publish the taxonomy as latest snapshot
+     */
+    void publishTaxonomy(const owlapi::model::Taxonomy::Ptr& taxonomy, uint64_t generation);
+
+    /// Cached (non-direct) ancestors of classes
+    std::map<IRI, IRIList> mAncestors;
+    /// Generation of the cached ancestors, \see mGeneration
+    uint64_t mAncestorsGeneration;
+
+    /**
+     * Clear all cached reasoning results
+     */
+    void clearCaches();
+
+    /**
+     * Remove the given knowledge base axioms of a data property assertion
+     * from the registry of values
+     */
+    void forgetValueOf(const owlapi::model::OWLAxiom::Ptr& axiom, const reasoner::factpp::Axiom::List& kbAxioms);
+
     bool hasClass(const IRI& klass) const { return mClasses.count(klass); }
 
     bool hasInstance(const IRI& instance) const { return mInstances.count(instance); }
@@ -78,7 +204,9 @@ public:
     KnowledgeBase();
     ~KnowledgeBase();
 
-    ReasoningKernel* getReasoningKernel() { return mKernel; }
+    ReasoningKernel* getReasoningKernel() { return kernel(); }
+
+    typedef owlapi::model::TaxonomySnapshot TaxonomySnapshot;
 
     TExpressionManager* getExpressionManager();
 
@@ -102,10 +230,83 @@ public:
 
     void realize();
 
+    /**
+     * Classify the knowledge base on a background thread
+     * \details While the classification is running, getTaxonomySnapshot and
+     * the class hierarchy queries isSubClassOf, allSubClassesOf and
+     * allAncestorsOf are answered from the last snapshot without blocking;
+     * the ancestors then do not include equivalent and punned classes. All
+     * other operations accessing the reasoner block until the
+     * classification has been completed. If background reasoning is already
+     * running, this call waits for it to complete first. The knowledge base
+     * must outlive the background reasoning.
+     * \param callback Optional callback, which is called from the background
+     * thread with the generation of the new snapshot once the reasoning has
+     * been completed, so that it can query the knowledge base; it must not
+     * start background reasoning itself
+     * \return future providing the generation of the new snapshot
+     */
+    std::shared_future<uint64_t> classifyAsync(const std::function<void(uint64_t)>& callback = std::function<void(uint64_t)>());
+
+    /**
+     * Realize the knowledge base on a background thread
+     * \see classifyAsync
+     */
+    std::shared_future<uint64_t> realizeAsync(const std::function<void(uint64_t)>& callback = std::function<void(uint64_t)>());
+
+    /**
+     * Check whether background reasoning is running
+     */
+    bool isReasoning() const;
+
+    /**
+     * Get the generation of the knowledge base, which is incremented whenever
+     * reasoning results are invalidated, i.e. on adding axioms,
+     * classification, realization and retraction
+     */
+    uint64_t getGeneration() const { return mGeneration; }
+
+    /**
+     * Get the estimated memory of the expression registries and indexes of
+     * this knowledge base
+     * \details The memory allocated by the reasoning kernel itself is not
+     * included. Takes the lock of the taxonomy snapshot, which might be
+     * published by background reasoning at the same time.
+     */
+    owlapi::model::MemoryUsage getMemoryUsage() const;
+
     bool isRealized();
 
     bool isClassSatisfiable(const IRI& klass);
 
+    /**
+     * Get the snapshot of the class hierarchy
+     * \details The snapshot is created once after classification (which is
+     * triggered if necessary) and remains valid until the next
+     * refresh/classify/realize/retract
+     * \return taxonomy of all known classes
+     */
+    owlapi::model::Taxonomy::Ptr getTaxonomy();
+
+    /**
+     * Get the last completed snapshot of the class hierarchy without
+     * blocking, i.e. while background reasoning is running the previous
+     * snapshot is returned
+     * \details This function can be called from any thread, but the
+     * traversal functions of a taxonomy must not be used concurrently
+     */
+    TaxonomySnapshot getTaxonomySnapshot() const;
+
+    /**
+     * Use an externally computed class hierarchy, e.g. the merged result of
+     * classifying independent modules in parallel
+     * \details The taxonomy answers getTaxonomy and the subclass and ancestor
+     * queries without classifying this knowledge base. It is dropped when
+     * axioms are added, and on the next refresh/classify/realize/retract
+     * \see owlapi::model::ParallelClassifier
+     */
+    void setTaxonomy(const owlapi::model::Taxonomy::Ptr& taxonomy);
+
     // ROLES (PROPERTIES)
     /**
      * Make an object property known
@@ -410,11 +611,20 @@ public:
 
     reasoner::factpp::Axiom valueOf(const IRI& individual, const IRI& property, const owlapi::model::OWLLiteral::Ptr& literal);
 
+    /**
+     * Assert all class assertions, relations and values of a batch
+     * \details The expression of each entity is resolved once per batch,
+     * and the functionality of each data property is checked once per batch.
+     * Classes and properties have to be known
+     * \return axioms in the order of the batch's types, relations and values
+     */
+    reasoner::factpp::Axiom::List assertBatch(const owlapi::model::ABoxBatch& batch);
+
     /**
      * Get all known datatypes
      * \return Mapping of IRI to datatypes
      */
-    std::map<IRI, reasoner::factpp::DataTypeName> dataTypes() const { return mDataTypes; }
+    std::map<IRI, reasoner::factpp::DataTypeName> dataTypes() const { return mDataTypes.toMap(); }
 
     /**
      * Define the associated datatype (or retrieve the existing)
@@ -773,6 +983,7 @@ public:
      * \param relationProperty the relation property
      * \param klass Klass type the relation should map to
      * \return list of instances that are related to instance via the relationProperty
+     * \details The klass filter is applied by lookup in the cached instance set of klass
      */
     IRIList allRelatedInstances(const IRI& instance, const IRI& relationProperty, const IRI& klass = IRI());
 
@@ -892,6 +1103,8 @@ public:
      * Resolve an alias / instance name
      * \param instanceOrAlias  IRI to find an alias for a given instance
      * \return Resolved aliases or a list containing only the instance name if there is no alias
+     * \details Answered from the sameAs index, the reasoner is only queried
+     * once per equivalence class and refresh
      */
     IRIList getSameAs(const IRI& instanceOrAlias);
 
@@ -914,6 +1127,22 @@ public:
      */
     void retractRelated(const owlapi::model::OWLAxiom::Ptr& a);
 
+    /**
+     * Remove all axioms which are related to/referenced by the given axioms
+     * \details In contrast to calling retractRelated for each axiom, derived
+     * state such as the sameAs index and the query caches is updated only
+     * once
+     * \param axioms Axioms to retract related ones for
+     */
+    void retractRelated(const owlapi::model::OWLAxiom::PtrList& axioms);
+
+    /**
+     * Remove the reference between a frontend axiom and its knowledge base
+     * axioms without retracting them, e.g., when the knowledge base axioms
+     * have already been replaced
+     */
+    void removeReference(const owlapi::model::OWLAxiom::Ptr& modelAxiom);
+
     /**
      * Add a reference between the frontend axiom and the knowledge base axiom
      */
@@ -19,12 +19,14 @@ namespace owlapi
 #ifdef USE_BOOST_SHARED_PTR
     using ::boost::shared_ptr;
     using ::boost::make_shared;
+    using ::boost::allocate_shared;
     using ::boost::dynamic_pointer_cast;
     using ::boost::static_pointer_cast;
     using ::boost::function1;
 #else
     using ::std::shared_ptr;
     using ::std::make_shared;
+    using ::std::allocate_shared;
     using ::std::dynamic_pointer_cast;
     using ::std::static_pointer_cast;
     template <class T, class U>
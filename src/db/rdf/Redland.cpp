@@ -7,11 +7,16 @@
 namespace owlapi {
 namespace db {
 
+const uint64_t Redland::NUMBER_OF_INDEXES;
+const uint64_t Redland::NODE_ENCODING_OVERHEAD;
+const uint64_t Redland::INDEX_ENTRY_OVERHEAD;
+
 Redland::Redland(const std::string& filename,
         const std::string& baseUri)
     : FileBackend(filename, baseUri)
-    , mpReader(new io::RedlandReader())
+    , mpReader(NULL)
 {
+    mpReader = new io::RedlandReader();
     mpReader->read(filename);
 }
 
@@ -20,6 +25,66 @@ Redland::~Redland()
     delete mpReader;
 }
 
+uint64_t Redland::getEncodedBytes(librdf_node* node)
+{
+    size_t length = 0;
+    switch( librdf_node_get_type(node) )
+    {
+        case LIBRDF_NODE_TYPE_RESOURCE:
+            librdf_uri_as_counted_string(librdf_node_get_uri(node), &length);
+            break;
+        case LIBRDF_NODE_TYPE_LITERAL:
+        {
+            librdf_node_get_literal_value_as_counted_string(node, &length);
+            const char* language = librdf_node_get_literal_value_language(node);
+            if(language)
+            {
+                length += strlen(language);
+            }
+            librdf_uri* datatype = librdf_node_get_literal_value_datatype_uri(node);
+            if(datatype)
+            {
+                size_t datatypeLength = 0;
+                librdf_uri_as_counted_string(datatype, &datatypeLength);
+                length += datatypeLength;
+            }
+            break;
+        }
+        case LIBRDF_NODE_TYPE_BLANK:
+            length = strlen((const char*) librdf_node_get_blank_identifier(node));
+            break;
+        default:
+            break;
+    }
+    return NODE_ENCODING_OVERHEAD + length;
+}
+
+owlapi::model::MemoryUsage Redland::getMemoryUsage() const
+{
+    // The hashes storage keeps each statement in every index, encoded as key
+    // of two nodes and value of the third node
+    uint64_t statements = 0;
+    uint64_t bytes = 0;
+    librdf_stream* stream = librdf_model_as_stream(mpReader->getModel());
+    if(stream)
+    {
+        for(; !librdf_stream_end(stream); librdf_stream_next(stream))
+        {
+            librdf_statement* statement = librdf_stream_get_object(stream);
+            uint64_t encodedBytes = getEncodedBytes(librdf_statement_get_subject(statement))
+                + getEncodedBytes(librdf_statement_get_predicate(statement))
+                + getEncodedBytes(librdf_statement_get_object(statement));
+            bytes += NUMBER_OF_INDEXES * (encodedBytes + INDEX_ENTRY_OVERHEAD);
+            ++statements;
+        }
+        librdf_free_stream(stream);
+    }
+
+    owlapi::model::MemoryUsage usage;
+    usage.add("storage", statements, bytes);
+    return usage;
+}
+
 std::vector<std::string> Redland::getSupportedQueryFormats() const
 {
     std::vector<std::string> formats;
@@ -2,6 +2,8 @@
 #define OWLAPI_DB_REDLAND_HPP
 
 #include "../FileBackend.hpp"
+#include "../../model/MemoryUsage.hpp"
+#include <redland.h>
 
 namespace owlapi {
 namespace io {
@@ -27,7 +29,28 @@ public:
 
     std::vector<std::string> getSupportedQueryFormats() const;
 
+    /**
+     * Get the number of statements of the storage and their estimated
+     * memory in the indexes of the storage
+     * \details Walks all statements; the nodes which librdf shares between
+     * statements, e.g. the interned URIs of the world, are not accounted for
+     */
+    owlapi::model::MemoryUsage getMemoryUsage() const;
+
 private:
+    /// Indexes of the hashes storage, i.e. sp2o, po2s and so2p
+    static const uint64_t NUMBER_OF_INDEXES = 3;
+    /// Bytes of the type and length fields of an encoded node
+    static const uint64_t NODE_ENCODING_OVERHEAD = 5;
+    /// Bytes of the key and value nodes of an entry of a memory hash
+    static const uint64_t INDEX_ENTRY_OVERHEAD = 8 * sizeof(void*);
+
+    /**
+     * Get the bytes of a node as encoded in the keys and values of the
+     * storage
+     */
+    static uint64_t getEncodedBytes(librdf_node* node);
+
     io::RedlandReader* mpReader;
 };
 
@@ -0,0 +1,1083 @@
+#include "ChangeJournal.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <boost/filesystem.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <base-logging/Logging.hpp>
+
+#include "../Instrumentation.hpp"
+#include "../model/OWLOntologyTell.hpp"
+#include "../model/OWLAxiomStructureVisitor.hpp"
+#include "../model/OWLAxiomVisitor.hpp"
+#include "../model/OWLDisjointObjectPropertiesAxiom.hpp"
+#include "../model/OWLDisjointDataPropertiesAxiom.hpp"
+#include "../model/OWLEquivalentDataPropertiesAxiom.hpp"
+#include "../model/OWLDataPropertyRangeAxiom.hpp"
+
+using namespace owlapi::model;
+
+namespace owlapi {
+namespace io {
+
+namespace {
+
+/// File header, the trailing digit is the format version
+const std::string JOURNAL_MAGIC = "OWLJRNL1";
+
+/// SNAPSHOT_REQUIRED marks an axiom which cannot be journaled, so that the
+/// journal cannot be replayed without the next snapshot
+enum ChangeOperation { REMOVE = 0, ADD = 1, SNAPSHOT_REQUIRED = 2 };
+
+enum OperandFlags { ANONYMOUS_SUBJECT = 1, ANONYMOUS_OBJECT = 2 };
+
+/**
+ * \brief An added axiom in terms of the IRIs and the literal it refers to,
+ * i.e. sufficient to redo it with OWLOntologyTell
+ */
+struct AddRecord
+{
+    uint8_t axiomType;
+    uint8_t entityType;
+    uint8_t flags;
+    IRIList iris;
+    bool hasLiteral;
+    std::string value;
+    std::string type;
+
+    AddRecord()
+        : axiomType(OWLAxiom::UNKOWN)
+        , entityType(OWLEntity::UNKNOWN)
+        , flags(0)
+        , hasLiteral(false)
+    {}
+};
+
+struct Crc32Table
+{
+    uint32_t values[256];
+
+    Crc32Table()
+    {
+        for(uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+            for(size_t k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            values[i] = c;
+        }
+    }
+};
+
+uint32_t crc32(const std::string& data)
+{
+    // initialization of a local static is thread-safe
+    static const Crc32Table table;
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for(unsigned char c : data)
+    {
+        crc = table.values[(crc ^ c) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void putUInt8(std::string& buffer, uint8_t value)
+{
+    buffer.push_back(static_cast<char>(value));
+}
+
+/// Little endian, independent of the host
+void putUInt32(std::string& buffer, uint32_t value)
+{
+    for(size_t i = 0; i < 4; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (8*i)) & 0xFF));
+    }
+}
+
+void putString(std::string& buffer, const std::string& value)
+{
+    putUInt32(buffer, value.size());
+    buffer.append(value);
+}
+
+/**
+ * \brief Sequential decoding of a buffer, where all getters return false
+ * if the buffer is exhausted
+ */
+class Decoder
+{
+public:
+    Decoder(const std::string& data, size_t pos = 0)
+        : mData(data)
+        , mPos(pos)
+    {}
+
+    bool getUInt8(uint8_t& value)
+    {
+        if(mPos + 1 > mData.size())
+        {
+            return false;
+        }
+        value = static_cast<uint8_t>(mData[mPos++]);
+        return true;
+    }
+
+    bool getUInt32(uint32_t& value)
+    {
+        if(mPos + 4 > mData.size())
+        {
+            return false;
+        }
+        value = 0;
+        for(size_t i = 0; i < 4; ++i)
+        {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(mData[mPos++])) << (8*i);
+        }
+        return true;
+    }
+
+    bool getString(std::string& value)
+    {
+        uint32_t size;
+        if(!getUInt32(size) || mPos + size > mData.size())
+        {
+            return false;
+        }
+        value = mData.substr(mPos, size);
+        mPos += size;
+        return true;
+    }
+
+    size_t getPosition() const { return mPos; }
+
+    void skip(size_t size) { mPos += size; }
+
+private:
+    const std::string& mData;
+    size_t mPos;
+};
+
+/**
+ * Read the complete records of a journal
+ * \param payloads the payload of each complete record
+ * \return size of the valid part of the file, 0 if the file does not exist
+ * or is empty
+ * \throw std::runtime_error if the file is not a journal
+ */
+size_t readRecords(const std::string& path, std::vector<std::string>& payloads)
+{
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+    {
+        return 0;
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::string data = ss.str();
+    if(data.empty())
+    {
+        return 0;
+    }
+
+    if(data.compare(0, JOURNAL_MAGIC.size(), JOURNAL_MAGIC) != 0)
+    {
+        throw std::runtime_error("owlapi::io::ChangeJournal: '" + path + "' is not a change journal");
+    }
+
+    Decoder decoder(data, JOURNAL_MAGIC.size());
+    size_t validSize = decoder.getPosition();
+    while(validSize < data.size())
+    {
+        uint32_t size;
+        uint32_t checksum;
+        if(!decoder.getUInt32(size) || !decoder.getUInt32(checksum)
+                || decoder.getPosition() + size > data.size())
+        {
+            LOG_WARN_S << "owlapi::io::ChangeJournal: '" << path << "' ends with an incomplete record"
+                " at byte " << validSize;
+            break;
+        }
+
+        std::string payload = data.substr(decoder.getPosition(), size);
+        if(crc32(payload) != checksum)
+        {
+            LOG_WARN_S << "owlapi::io::ChangeJournal: '" << path << "' has a corrupt record"
+                " at byte " << validSize;
+            break;
+        }
+        payloads.push_back(payload);
+        decoder.skip(size);
+        validSize = decoder.getPosition();
+    }
+    return validSize;
+}
+
+bool getIRI(const OWLObject::Ptr& object, IRI& iri)
+{
+    OWLClass::Ptr klass = dynamic_pointer_cast<OWLClass>(object);
+    if(klass)
+    {
+        iri = klass->getIRI();
+        return true;
+    }
+    OWLProperty::Ptr property = dynamic_pointer_cast<OWLProperty>(object);
+    if(property)
+    {
+        iri = property->getIRI();
+        return true;
+    }
+    return false;
+}
+
+template<typename T>
+bool getIRIs(const std::vector< shared_ptr<T> >& objects, IRIList& iris)
+{
+    for(const shared_ptr<T>& object : objects)
+    {
+        IRI iri;
+        if(!getIRI(object, iri))
+        {
+            return false;
+        }
+        iris.push_back(iri);
+    }
+    return true;
+}
+
+/**
+ * Get the property IRI of an axiom about a single property
+ */
+template<typename A>
+bool getPropertyIRI(const OWLAxiom::Ptr& axiom, IRIList& iris)
+{
+    IRI iri;
+    if(!getIRI(dynamic_pointer_cast<A>(axiom)->getProperty(), iri))
+    {
+        return false;
+    }
+    iris.push_back(iri);
+    return true;
+}
+
+/**
+ * Add an individual to the record
+ * \return false for unsupported individuals
+ */
+bool addIndividual(const OWLObject::Ptr& object, AddRecord& record, uint8_t anonymousFlag)
+{
+    OWLNamedIndividual::Ptr named = dynamic_pointer_cast<OWLNamedIndividual>(object);
+    if(named)
+    {
+        record.iris.push_back(named->getIRI());
+        return true;
+    }
+    OWLAnonymousIndividual::Ptr anonymous = dynamic_pointer_cast<OWLAnonymousIndividual>(object);
+    if(anonymous)
+    {
+        record.iris.push_back(anonymous->getReferenceID());
+        record.flags |= anonymousFlag;
+        return true;
+    }
+    return false;
+}
+
+void setLiteral(const OWLLiteral::Ptr& literal, AddRecord& record)
+{
+    record.hasLiteral = true;
+    record.value = literal->getValue();
+    record.type = literal->getType();
+}
+
+/**
+ * Encode an added axiom
+ * \return false if the axiom cannot be redone through OWLOntologyTell
+ */
+bool encode(const OWLAxiom::Ptr& axiom, AddRecord& record)
+{
+    record.axiomType = axiom->getAxiomType();
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+        {
+            OWLEntity::Ptr entity = dynamic_pointer_cast<OWLDeclarationAxiom>(axiom)->getEntity();
+            record.entityType = entity->getEntityType();
+            record.iris.push_back(entity->getIRI());
+            return true;
+        }
+        case OWLAxiom::SubClassOf:
+        {
+            OWLSubClassOfAxiom::Ptr subClassAxiom = dynamic_pointer_cast<OWLSubClassOfAxiom>(axiom);
+            return getIRIs<OWLClassExpression>({ subClassAxiom->getSubClass(), subClassAxiom->getSuperClass() }, record.iris);
+        }
+        case OWLAxiom::EquivalentClasses:
+            return getIRIs(dynamic_pointer_cast<OWLEquivalentClassesAxiom>(axiom)->getEquivalentClasses(), record.iris);
+        case OWLAxiom::DisjointClasses:
+            return getIRIs(dynamic_pointer_cast<OWLDisjointClassesAxiom>(axiom)->getClassExpressions(), record.iris);
+        case OWLAxiom::DisjointUnion:
+        {
+            shared_ptr<OWLDisjointUnionAxiom> disjointUnion = dynamic_pointer_cast<OWLDisjointUnionAxiom>(axiom);
+            record.iris.push_back(disjointUnion->getOWLClass()->getIRI());
+            return getIRIs(disjointUnion->getClassExpressions(), record.iris);
+        }
+        case OWLAxiom::EquivalentObjectProperties:
+            return getIRIs(dynamic_pointer_cast<OWLEquivalentObjectPropertiesAxiom>(axiom)->getProperties(), record.iris);
+        case OWLAxiom::DisjointObjectProperties:
+            return getIRIs(dynamic_pointer_cast<OWLDisjointObjectPropertiesAxiom>(axiom)->getProperties(), record.iris);
+        case OWLAxiom::EquivalentDataProperties:
+            return getIRIs(dynamic_pointer_cast<OWLEquivalentDataPropertiesAxiom>(axiom)->getProperties(), record.iris);
+        case OWLAxiom::DisjointDataProperties:
+            return getIRIs(dynamic_pointer_cast<OWLDisjointDataPropertiesAxiom>(axiom)->getProperties(), record.iris);
+        case OWLAxiom::SubObjectPropertyOf:
+        case OWLAxiom::SubDataPropertyOf:
+        {
+            OWLSubPropertyAxiom::Ptr subPropertyAxiom = dynamic_pointer_cast<OWLSubPropertyAxiom>(axiom);
+            return getIRIs<OWLPropertyExpression>({ subPropertyAxiom->getSubProperty(), subPropertyAxiom->getSuperProperty() }, record.iris);
+        }
+        case OWLAxiom::ObjectPropertyDomain:
+        {
+            OWLObjectPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLObjectPropertyDomainAxiom>(axiom);
+            return getIRIs<OWLObject>({ domainAxiom->getProperty(), domainAxiom->getDomain() }, record.iris);
+        }
+        case OWLAxiom::ObjectPropertyRange:
+        {
+            OWLObjectPropertyRangeAxiom::Ptr rangeAxiom = dynamic_pointer_cast<OWLObjectPropertyRangeAxiom>(axiom);
+            return getIRIs<OWLObject>({ rangeAxiom->getProperty(), rangeAxiom->getRange() }, record.iris);
+        }
+        case OWLAxiom::DataPropertyDomain:
+        {
+            OWLDataPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLDataPropertyDomainAxiom>(axiom);
+            return getIRIs<OWLObject>({ domainAxiom->getProperty(), domainAxiom->getDomain() }, record.iris);
+        }
+        case OWLAxiom::DataPropertyRange:
+        {
+            OWLDataPropertyRangeAxiom::Ptr rangeAxiom = dynamic_pointer_cast<OWLDataPropertyRangeAxiom>(axiom);
+            // only named datatypes, ranges such as oneOf are anonymous
+            OWLDataRange::Ptr range = rangeAxiom->getRange();
+            OWLDataType::Ptr datatype = dynamic_pointer_cast<OWLDataType>(range);
+            IRI property;
+            if(!datatype || range->getDataRangeType() != OWLDataRange::DATATYPE
+                    || !getIRI(rangeAxiom->getProperty(), property))
+            {
+                return false;
+            }
+            record.iris.push_back(property);
+            record.iris.push_back(datatype->getIRI());
+            return true;
+        }
+        case OWLAxiom::InverseObjectProperties:
+        {
+            shared_ptr<OWLInverseObjectPropertiesAxiom> inverseAxiom = dynamic_pointer_cast<OWLInverseObjectPropertiesAxiom>(axiom);
+            return getIRIs<OWLObjectPropertyExpression>({ inverseAxiom->getFirstProperty(), inverseAxiom->getSecondProperty() }, record.iris);
+        }
+        case OWLAxiom::FunctionalObjectProperty:
+            return getPropertyIRI<OWLFunctionalObjectPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::InverseFunctionalObjectProperty:
+            return getPropertyIRI<OWLInverseFunctionalObjectPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::ReflexiveObjectProperty:
+            return getPropertyIRI<OWLReflexiveObjectPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::IrreflexiveObjectProperty:
+            return getPropertyIRI<OWLIrreflexiveObjectPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::SymmetricObjectProperty:
+            return getPropertyIRI<OWLSymmetricObjectPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::AsymmetricObjectProperty:
+            return getPropertyIRI<OWLAsymmetricObjectPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::TransitiveObjectProperty:
+            return getPropertyIRI<OWLTransitiveObjectPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::FunctionalDataProperty:
+            return getPropertyIRI<OWLFunctionalDataPropertyAxiom>(axiom, record.iris);
+        case OWLAxiom::ClassAssertion:
+        {
+            OWLClassAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLClassAssertionAxiom>(axiom);
+            // instanceOf only supports named individuals
+            OWLNamedIndividual::Ptr individual = dynamic_pointer_cast<OWLNamedIndividual>(assertion->getIndividual());
+            if(!individual)
+            {
+                return false;
+            }
+            record.iris.push_back(individual->getIRI());
+            return getIRIs<OWLClassExpression>({ assertion->getClassExpression() }, record.iris);
+        }
+        case OWLAxiom::ObjectPropertyAssertion:
+        {
+            OWLObjectPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLObjectPropertyAssertionAxiom>(axiom);
+            IRI property;
+            return addIndividual(assertion->getSubject(), record, ANONYMOUS_SUBJECT)
+                && getIRI(assertion->getProperty(), property)
+                && (record.iris.push_back(property), true)
+                && addIndividual(assertion->getObject(), record, ANONYMOUS_OBJECT);
+        }
+        case OWLAxiom::DataPropertyAssertion:
+        {
+            OWLDataPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLDataPropertyAssertionAxiom>(axiom);
+            OWLLiteral::Ptr literal = dynamic_pointer_cast<OWLLiteral>(assertion->getObject());
+            IRI property;
+            if(!literal || !addIndividual(assertion->getSubject(), record, ANONYMOUS_SUBJECT)
+                    || !getIRI(assertion->getProperty(), property))
+            {
+                return false;
+            }
+            record.iris.push_back(property);
+            setLiteral(literal, record);
+            return true;
+        }
+        case OWLAxiom::AnnotationAssertion:
+        {
+            OWLAnnotationAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom);
+            OWLAnnotationSubject::Ptr subject = assertion->getSubject();
+            if(subject->getObjectType() == OWLObject::IRIType)
+            {
+                record.iris.push_back(*dynamic_pointer_cast<IRI>(subject));
+            } else if(!addIndividual(subject, record, ANONYMOUS_SUBJECT))
+            {
+                return false;
+            }
+            record.iris.push_back(assertion->getProperty()->getIRI());
+
+            OWLAnnotationValue::Ptr value = assertion->annotationValue();
+            switch(value->getObjectType())
+            {
+                case OWLObject::IRIType:
+                    record.iris.push_back(*dynamic_pointer_cast<IRI>(value));
+                    return true;
+                case OWLObject::Literal:
+                    setLiteral(dynamic_pointer_cast<OWLLiteral>(value), record);
+                    return true;
+                default:
+                    return addIndividual(value, record, ANONYMOUS_OBJECT);
+            }
+        }
+        default:
+            return false;
+    }
+}
+
+void encode(const AddRecord& record, std::string& buffer)
+{
+    putUInt8(buffer, ADD);
+    putUInt8(buffer, record.axiomType);
+    putUInt8(buffer, record.entityType);
+    putUInt8(buffer, record.flags);
+    putUInt32(buffer, record.iris.size());
+    for(const IRI& iri : record.iris)
+    {
+        putString(buffer, iri.toString());
+    }
+    putUInt8(buffer, record.hasLiteral);
+    if(record.hasLiteral)
+    {
+        putString(buffer, record.value);
+        putString(buffer, record.type);
+    }
+}
+
+bool decode(Decoder& decoder, AddRecord& record)
+{
+    uint32_t numberOfIRIs;
+    if(!decoder.getUInt8(record.axiomType) || !decoder.getUInt8(record.entityType)
+            || !decoder.getUInt8(record.flags) || !decoder.getUInt32(numberOfIRIs))
+    {
+        return false;
+    }
+    for(uint32_t i = 0; i < numberOfIRIs; ++i)
+    {
+        std::string iri;
+        if(!decoder.getString(iri))
+        {
+            return false;
+        }
+        record.iris.push_back(IRI(iri));
+    }
+    uint8_t hasLiteral;
+    if(!decoder.getUInt8(hasLiteral))
+    {
+        return false;
+    }
+    record.hasLiteral = hasLiteral;
+    return !hasLiteral || (decoder.getString(record.value) && decoder.getString(record.type));
+}
+
+/**
+ * Check if the complete records contain an axiom which has not been journaled
+ * \throw std::runtime_error for a malformed record
+ */
+bool requiresSnapshot(const std::vector<std::string>& payloads, const std::string& path)
+{
+    for(const std::string& payload : payloads)
+    {
+        Decoder decoder(payload);
+        uint32_t numberOfChanges;
+        bool valid = decoder.getUInt32(numberOfChanges);
+        for(uint32_t i = 0; valid && i < numberOfChanges; ++i)
+        {
+            uint8_t operation;
+            std::string key;
+            AddRecord record;
+            valid = decoder.getUInt8(operation);
+            if(!valid)
+            {
+                break;
+            }
+            switch(operation)
+            {
+                case ADD:
+                    valid = decode(decoder, record);
+                    break;
+                case SNAPSHOT_REQUIRED:
+                    return true;
+                default:
+                    valid = decoder.getString(key);
+                    break;
+            }
+        }
+        if(!valid)
+        {
+            throw std::runtime_error("owlapi::io::ChangeJournal: malformed record in '" + path + "'");
+        }
+    }
+    return false;
+}
+
+/**
+ * Force a file or directory to disk
+ * \throw std::runtime_error on failure
+ */
+void syncPath(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        throw std::runtime_error("owlapi::io::ChangeJournal: failed to open '" + path + "' -- "
+                + std::string(strerror(errno)));
+    }
+    int result = ::fsync(fd);
+    std::string error = strerror(errno);
+    ::close(fd);
+    if(result != 0)
+    {
+        throw std::runtime_error("owlapi::io::ChangeJournal: failed to sync '" + path + "' -- " + error);
+    }
+}
+
+OWLIndividual::Ptr individual(OWLOntologyTell& tell, const IRI& iri, bool anonymous)
+{
+    if(anonymous)
+    {
+        return tell.anonymousIndividual(iri);
+    }
+    return tell.namedIndividual(iri);
+}
+
+/**
+ * Redo an added axiom
+ */
+void apply(const AddRecord& record, OWLOntologyTell& tell)
+{
+    const IRIList& iris = record.iris;
+    if(iris.empty())
+    {
+        throw std::runtime_error("owlapi::io::ChangeJournal: record without operands");
+    }
+
+    switch(record.axiomType)
+    {
+        case OWLAxiom::Declaration:
+            switch(record.entityType)
+            {
+                case OWLEntity::CLASS: tell.klass(iris[0]); break;
+                case OWLEntity::NAMED_INDIVIDUAL: tell.namedIndividual(iris[0]); break;
+                case OWLEntity::OBJECT_PROPERTY: tell.objectProperty(iris[0]); break;
+                case OWLEntity::DATA_PROPERTY: tell.dataProperty(iris[0]); break;
+                case OWLEntity::ANNOTATION_PROPERTY: tell.annotationProperty(iris[0]); break;
+                case OWLEntity::DATATYPE: tell.datatype(iris[0]); break;
+                default: break;
+            }
+            break;
+        case OWLAxiom::SubClassOf:
+            tell.subClassOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::EquivalentClasses:
+            for(const IRI& iri : iris)
+            {
+                tell.klass(iri);
+            }
+            tell.equalClasses(iris);
+            break;
+        case OWLAxiom::DisjointClasses:
+            tell.disjointClasses(iris);
+            break;
+        case OWLAxiom::DisjointUnion:
+            tell.disjointUnion(iris[0], IRIList(iris.begin() + 1, iris.end()));
+            break;
+        case OWLAxiom::EquivalentObjectProperties:
+            tell.equalObjectProperties(iris);
+            break;
+        case OWLAxiom::DisjointObjectProperties:
+            tell.disjointObjectProperties(iris);
+            break;
+        case OWLAxiom::EquivalentDataProperties:
+            tell.equalDataProperties(iris);
+            break;
+        case OWLAxiom::DisjointDataProperties:
+            tell.disjointDataProperties(iris);
+            break;
+        case OWLAxiom::SubObjectPropertyOf:
+        case OWLAxiom::SubDataPropertyOf:
+            tell.subPropertyOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::ObjectPropertyDomain:
+            tell.objectPropertyDomainOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::ObjectPropertyRange:
+            tell.objectPropertyRangeOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::DataPropertyDomain:
+            tell.dataPropertyDomainOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::DataPropertyRange:
+            tell.dataPropertyRangeOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::InverseObjectProperties:
+            tell.inverseOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::FunctionalObjectProperty:
+            tell.functionalObjectProperty(iris[0]);
+            break;
+        case OWLAxiom::InverseFunctionalObjectProperty:
+            tell.inverseFunctionalProperty(iris[0]);
+            break;
+        case OWLAxiom::ReflexiveObjectProperty:
+            tell.reflexiveProperty(iris[0]);
+            break;
+        case OWLAxiom::IrreflexiveObjectProperty:
+            tell.irreflexiveProperty(iris[0]);
+            break;
+        case OWLAxiom::SymmetricObjectProperty:
+            tell.symmetricProperty(iris[0]);
+            break;
+        case OWLAxiom::AsymmetricObjectProperty:
+            tell.asymmetricProperty(iris[0]);
+            break;
+        case OWLAxiom::TransitiveObjectProperty:
+            tell.transitiveProperty(iris[0]);
+            break;
+        case OWLAxiom::FunctionalDataProperty:
+            tell.functionalDataProperty(iris[0]);
+            break;
+        case OWLAxiom::ClassAssertion:
+            tell.instanceOf(iris[0], iris[1]);
+            break;
+        case OWLAxiom::ObjectPropertyAssertion:
+            individual(tell, iris[0], record.flags & ANONYMOUS_SUBJECT);
+            individual(tell, iris[2], record.flags & ANONYMOUS_OBJECT);
+            tell.relatedTo(iris[0], iris[1], iris[2]);
+            break;
+        case OWLAxiom::DataPropertyAssertion:
+            individual(tell, iris[0], record.flags & ANONYMOUS_SUBJECT);
+            tell.valueOf(iris[0], iris[1], OWLLiteral::create(record.value, record.type));
+            break;
+        case OWLAxiom::AnnotationAssertion:
+        {
+            OWLAnnotationSubject::Ptr subject;
+            if(record.flags & ANONYMOUS_SUBJECT)
+            {
+                subject = tell.anonymousIndividual(iris[0]);
+            } else {
+                subject = make_shared<IRI>(iris[0]);
+            }
+
+            OWLAnnotationValue::Ptr value;
+            if(record.hasLiteral)
+            {
+                value = OWLLiteral::create(record.value, record.type);
+            } else if(record.flags & ANONYMOUS_OBJECT)
+            {
+                value = tell.anonymousIndividual(iris[2]);
+            } else {
+                value = make_shared<IRI>(iris[2]);
+            }
+            tell.annotationOf(subject, iris[1], value);
+            break;
+        }
+        default:
+            throw std::runtime_error("owlapi::io::ChangeJournal: record with unsupported axiom type '"
+                    + OWLAxiom::AxiomTypeTxt[static_cast<OWLAxiom::AxiomType>(record.axiomType)] + "'");
+    }
+}
+
+} // end anonymous namespace
+
+ChangeJournal::ChangeJournal(const std::string& path, const Options& options)
+    : mPath(path)
+    , mOptions(options)
+    , mFd(-1)
+    , mNumberOfPendingChanges(0)
+    , mNumberOfCommittedChanges(0)
+    , mUnsyncedCommits(0)
+    , mSnapshotRequired(false)
+{
+    std::vector<std::string> payloads;
+    size_t validSize = readRecords(path, payloads);
+    for(const std::string& payload : payloads)
+    {
+        Decoder decoder(payload);
+        uint32_t numberOfChanges = 0;
+        decoder.getUInt32(numberOfChanges);
+        mNumberOfCommittedChanges += numberOfChanges;
+    }
+    mSnapshotRequired = requiresSnapshot(payloads, path);
+    open(validSize);
+}
+
+ChangeJournal::~ChangeJournal()
+{
+    try {
+        detach();
+        sync();
+    } catch(const std::exception& e)
+    {
+        LOG_WARN_S << "owlapi::io::ChangeJournal: failed to close '" << mPath << "' -- " << e.what();
+    }
+    close();
+}
+
+void ChangeJournal::attach(const OWLOntology::Ptr& ontology)
+{
+    detach();
+    mpOntology = ontology;
+    mpOntology->setAxiomChangeCallback([this](const OWLAxiom::Ptr& axiom, bool added)
+            {
+                append(axiom, added);
+            });
+}
+
+void ChangeJournal::detach()
+{
+    if(mpOntology)
+    {
+        mpOntology->setAxiomChangeCallback(OWLOntology::AxiomChangeCallback());
+        mpOntology.reset();
+    }
+    commit();
+}
+
+bool ChangeJournal::append(const OWLAxiom::Ptr& axiom, bool added)
+{
+    if(added)
+    {
+        AddRecord record;
+        if(!encode(axiom, record))
+        {
+            LOG_WARN_S << "owlapi::io::ChangeJournal: cannot journal axiom '" << axiom->toString()
+                << "' -- it will be persisted by the next snapshot";
+            // the marker is committed like any other change, so that the
+            // need for a snapshot survives a restart
+            putUInt8(mPending, SNAPSHOT_REQUIRED);
+            putString(mPending, OWLAxiomStructureVisitor::getKey(axiom));
+            mSnapshotRequired = true;
+            if(++mNumberOfPendingChanges >= mOptions.groupSize)
+            {
+                commit();
+            }
+            return false;
+        }
+        encode(record, mPending);
+    } else {
+        putUInt8(mPending, REMOVE);
+        putString(mPending, OWLAxiomStructureVisitor::getKey(axiom));
+    }
+
+    if(++mNumberOfPendingChanges >= mOptions.groupSize)
+    {
+        commit();
+    }
+    return true;
+}
+
+void ChangeJournal::commit()
+{
+    if(mNumberOfPendingChanges == 0)
+    {
+        return;
+    }
+    OWLAPI_INSTRUMENT_SCOPE(IO_JOURNAL_COMMIT);
+
+    std::string payload;
+    payload.reserve(4 + mPending.size());
+    putUInt32(payload, mNumberOfPendingChanges);
+    payload.append(mPending);
+
+    // a single write per group, so that a group is either complete or
+    // detected as incomplete on reading
+    std::string record;
+    record.reserve(8 + payload.size());
+    putUInt32(record, payload.size());
+    putUInt32(record, crc32(payload));
+    record.append(payload);
+    write(record);
+
+    mNumberOfCommittedChanges += mNumberOfPendingChanges;
+    mNumberOfPendingChanges = 0;
+    mPending.clear();
+
+    if(mOptions.syncInterval && ++mUnsyncedCommits >= mOptions.syncInterval)
+    {
+        sync();
+    }
+}
+
+void ChangeJournal::sync()
+{
+    commit();
+    if(mFd >= 0 && mUnsyncedCommits)
+    {
+        if(::fsync(mFd) != 0)
+        {
+            throw std::runtime_error("owlapi::io::ChangeJournal::sync: failed to sync '" + mPath + "' -- "
+                    + std::string(strerror(errno)));
+        }
+    }
+    mUnsyncedCommits = 0;
+}
+
+void ChangeJournal::compact(const std::string& snapshotPath, Format format)
+{
+    if(!mpOntology)
+    {
+        throw std::runtime_error("owlapi::io::ChangeJournal::compact: no ontology attached");
+    }
+    OWLAPI_INSTRUMENT_SCOPE(IO_JOURNAL_COMPACT);
+
+    sync();
+    if(format == UNKNOWN)
+    {
+        format = OWLOntologyIO::guessFormat(snapshotPath);
+    }
+
+    std::string tmpPath = snapshotPath + ".tmp";
+    OWLOntologyIO::write(tmpPath, mpOntology, format);
+    // The snapshot has to be on disk before it replaces the previous one,
+    // and the rename before the journal is truncated
+    syncPath(tmpPath);
+    if(std::rename(tmpPath.c_str(), snapshotPath.c_str()) != 0)
+    {
+        throw std::runtime_error("owlapi::io::ChangeJournal::compact: failed to rename '" + tmpPath
+                + "' to '" + snapshotPath + "' -- " + std::string(strerror(errno)));
+    }
+    std::string directory = boost::filesystem::path(snapshotPath).parent_path().string();
+    syncPath(directory.empty() ? "." : directory);
+
+    // A crash before the truncation only leads to records being replayed
+    // onto a snapshot which contains them already
+    close();
+    open(0);
+    mNumberOfCommittedChanges = 0;
+    mSnapshotRequired = false;
+    LOG_INFO_S << "owlapi::io::ChangeJournal: compacted '" << mPath << "' into snapshot '" << snapshotPath << "'";
+}
+
+void ChangeJournal::open(size_t validSize)
+{
+    mFd = ::open(mPath.c_str(), O_WRONLY | O_CREAT, 0644);
+    if(mFd < 0)
+    {
+        throw std::runtime_error("owlapi::io::ChangeJournal: failed to open '" + mPath + "' -- "
+                + std::string(strerror(errno)));
+    }
+    if(::ftruncate(mFd, validSize) != 0 || ::lseek(mFd, validSize, SEEK_SET) < 0)
+    {
+        std::string error = strerror(errno);
+        close();
+        throw std::runtime_error("owlapi::io::ChangeJournal: failed to truncate '" + mPath + "' -- " + error);
+    }
+
+    if(validSize == 0)
+    {
+        write(JOURNAL_MAGIC);
+        ++mUnsyncedCommits;
+        sync();
+    }
+}
+
+void ChangeJournal::close()
+{
+    if(mFd >= 0)
+    {
+        ::close(mFd);
+        mFd = -1;
+    }
+}
+
+void ChangeJournal::write(const std::string& data)
+{
+    size_t written = 0;
+    while(written < data.size())
+    {
+        ssize_t result = ::write(mFd, data.data() + written, data.size() - written);
+        if(result < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error("owlapi::io::ChangeJournal: failed to write '" + mPath + "' -- "
+                    + std::string(strerror(errno)));
+        }
+        written += result;
+    }
+}
+
+size_t ChangeJournal::replay(const std::string& path, const OWLOntology::Ptr& ontology)
+{
+    OWLAPI_INSTRUMENT_SCOPE(IO_JOURNAL_REPLAY);
+
+    std::vector<std::string> payloads;
+    readRecords(path, payloads);
+
+    OWLOntologyTell tell(ontology);
+    // Axioms by structural key, which is built with the first removal and
+    // kept up to date while replaying
+    std::unordered_multimap<std::string, OWLAxiom::Ptr> axiomsByKey;
+    bool indexed = false;
+
+    OWLAxiom::PtrList removals;
+    auto flushRemovals = [&ontology, &removals]()
+        {
+            if(!removals.empty())
+            {
+                ontology->removeAxioms(removals);
+                removals.clear();
+            }
+        };
+
+    // The index refers to this scope, so the previous callback, e.g. of an
+    // attached journal, has to be restored in any case
+    struct CallbackGuard
+    {
+        const OWLOntology::Ptr& ontology;
+        OWLOntology::AxiomChangeCallback callback;
+        ~CallbackGuard() { ontology->setAxiomChangeCallback(callback); }
+    } guard = { ontology, ontology->getAxiomChangeCallback() };
+
+    size_t replayed = 0;
+    for(const std::string& payload : payloads)
+    {
+        Decoder decoder(payload);
+        uint32_t numberOfChanges;
+        if(!decoder.getUInt32(numberOfChanges))
+        {
+            throw std::runtime_error("owlapi::io::ChangeJournal::replay: malformed record in '" + path + "'");
+        }
+
+        for(uint32_t i = 0; i < numberOfChanges; ++i)
+        {
+            uint8_t operation;
+            if(!decoder.getUInt8(operation))
+            {
+                throw std::runtime_error("owlapi::io::ChangeJournal::replay: malformed record in '" + path + "'");
+            }
+
+            if(operation == REMOVE)
+            {
+                std::string key;
+                if(!decoder.getString(key))
+                {
+                    throw std::runtime_error("owlapi::io::ChangeJournal::replay: malformed record in '" + path + "'");
+                }
+
+                if(!indexed)
+                {
+                    for(const OWLAxiom::Ptr& axiom : ontology->getAxioms())
+                    {
+                        axiomsByKey.insert(std::make_pair(OWLAxiomStructureVisitor::getKey(axiom), axiom));
+                    }
+                    const OWLOntology::AxiomChangeCallback& previous = guard.callback;
+                    ontology->setAxiomChangeCallback([&axiomsByKey, &previous](const OWLAxiom::Ptr& axiom, bool added)
+                            {
+                                if(previous)
+                                {
+                                    previous(axiom, added);
+                                }
+                                std::string axiomKey = OWLAxiomStructureVisitor::getKey(axiom);
+                                if(added)
+                                {
+                                    axiomsByKey.insert(std::make_pair(axiomKey, axiom));
+                                    return;
+                                }
+                                auto range = axiomsByKey.equal_range(axiomKey);
+                                for(auto it = range.first; it != range.second; ++it)
+                                {
+                                    if(it->second == axiom)
+                                    {
+                                        axiomsByKey.erase(it);
+                                        break;
+                                    }
+                                }
+                            });
+                    indexed = true;
+                }
+
+                std::unordered_multimap<std::string, OWLAxiom::Ptr>::iterator it = axiomsByKey.find(key);
+                if(it == axiomsByKey.end())
+                {
+                    // already removed, e.g. when replaying onto a newer snapshot
+                    LOG_DEBUG_S << "owlapi::io::ChangeJournal::replay: no axiom '" << key << "' to remove";
+                } else {
+                    removals.push_back(it->second);
+                    axiomsByKey.erase(it);
+                }
+            } else if(operation == SNAPSHOT_REQUIRED)
+            {
+                std::string key;
+                if(!decoder.getString(key))
+                {
+                    throw std::runtime_error("owlapi::io::ChangeJournal::replay: malformed record in '" + path + "'");
+                }
+                LOG_WARN_S << "owlapi::io::ChangeJournal::replay: axiom '" << key << "' has not been journaled"
+                    " -- it is missing unless the snapshot contains it";
+                continue;
+            } else if(operation == ADD)
+            {
+                AddRecord record;
+                if(!decode(decoder, record))
+                {
+                    throw std::runtime_error("owlapi::io::ChangeJournal::replay: malformed record in '" + path + "'");
+                }
+                // preserve the order of removals and additions
+                flushRemovals();
+                apply(record, tell);
+            } else {
+                throw std::runtime_error("owlapi::io::ChangeJournal::replay: unknown operation in '" + path + "'");
+            }
+            ++replayed;
+        }
+        flushRemovals();
+    }
+
+    LOG_INFO_S << "owlapi::io::ChangeJournal::replay: replayed " << replayed << " changes from '" << path << "'";
+    return replayed;
+}
+
+OWLOntology::Ptr ChangeJournal::recover(const std::string& snapshotPath, const std::string& journalPath)
+{
+    OWLOntology::Ptr ontology;
+    if(std::ifstream(snapshotPath).good())
+    {
+        ontology = OWLOntologyIO::fromFile(snapshotPath);
+    } else {
+        ontology = make_shared<OWLOntology>();
+    }
+
+    replay(journalPath, ontology);
+    ontology->refresh();
+    return ontology;
+}
+
+} // end namespace io
+} // end namespace owlapi
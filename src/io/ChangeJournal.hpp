@@ -0,0 +1,177 @@
+#ifndef OWLAPI_IO_CHANGE_JOURNAL_HPP
+#define OWLAPI_IO_CHANGE_JOURNAL_HPP
+
+#include <string>
+#include "OWLOntologyIO.hpp"
+
+namespace owlapi {
+namespace io {
+
+/**
+ * \class ChangeJournal
+ * \brief Append-only binary journal of the axioms which are added to and
+ * removed from an ontology
+ * \details Once attached to an ontology, every axiom change -- whether it
+ * results from OWLOntologyTell, OWLOntology::applyChanges or a reload -- is
+ * buffered and written as part of a group: a group is a single checksummed
+ * record, so that a crash leaves either the complete group or none of it.
+ * The journal is synced to disk every n-th group commit. By default every
+ * change is committed and synced immediately, i.e. it is durable once the
+ * modification of the ontology returns; larger groups trade this for
+ * throughput and require an explicit commit after a batch of changes.
+ *
+ * Persisting a running ontology then only requires a snapshot from time to
+ * time, \see compact, while recovery loads the last snapshot and replays the
+ * journal tail, \see recover. Replaying is idempotent, i.e. replaying
+ * records which are already part of the snapshot is harmless.
+ *
+ * Axioms are journaled if they only refer to named entities, individuals,
+ * named datatypes and literals. Other axioms, e.g. with complex class
+ * expressions, are only persisted by the next snapshot: the journal records
+ * a marker for them, so that the need for a snapshot is known after a
+ * restart as well, \see isSnapshotRequired
+ *
+ * \verbatim
+    ChangeJournal::Options options;
+    options.syncInterval = 10;
+    OWLOntology::Ptr ontology = ChangeJournal::recover("world.owl", "world.journal");
+    ChangeJournal journal("world.journal", options);
+    journal.attach(ontology);
+    ...
+    journal.compact("world.owl");
+ \endverbatim
+ */
+class ChangeJournal
+{
+public:
+    typedef shared_ptr<ChangeJournal> Ptr;
+
+    struct Options
+    {
+        /// Number of buffered changes after which a group is committed
+        /// automatically; pending changes of a larger group are lost on a
+        /// crash unless they are committed explicitly
+        size_t groupSize;
+        /// Number of group commits after which the journal is synced to
+        /// disk, 0 to leave syncing to the operating system
+        size_t syncInterval;
+
+        Options()
+            : groupSize(1)
+            , syncInterval(1)
+        {}
+    };
+
+    /**
+     * Open the journal for appending, or create it
+     * \details An incomplete trailing record, e.g. from a crash during a
+     * commit, is truncated
+     * \throw std::runtime_error if the file cannot be opened or is not a
+     * journal
+     */
+    ChangeJournal(const std::string& path, const Options& options = Options());
+
+    /**
+     * Commit pending changes, detach and close the journal
+     */
+    ~ChangeJournal();
+
+    /**
+     * Record all subsequent axiom changes of the given ontology
+     * \details Replaces an existing callback of the ontology,
+     * \see OWLOntology::setAxiomChangeCallback
+     */
+    void attach(const owlapi::model::OWLOntology::Ptr& ontology);
+
+    /**
+     * Commit pending changes and stop recording
+     */
+    void detach();
+
+    /**
+     * Buffer a single change and commit the group if it is full
+     * \return false if the axiom cannot be journaled
+     */
+    bool append(const owlapi::model::OWLAxiom::Ptr& axiom, bool added);
+
+    /**
+     * Write all buffered changes as a single record
+     */
+    void commit();
+
+    /**
+     * Commit and force all written records to disk
+     */
+    void sync();
+
+    /**
+     * Write a snapshot of the attached ontology and truncate the journal
+     * \details The snapshot is written to a temporary file first, synced and
+     * renamed, so that the previous snapshot stays valid until the new one is
+     * complete. The journal is truncated only after the rename has been synced
+     * \param format Format of the snapshot, guessed from the path by default
+     * \throw std::runtime_error if no ontology is attached
+     */
+    void compact(const std::string& snapshotPath, Format format = UNKNOWN);
+
+    /**
+     * Check if changes have been skipped, which can only be persisted by a
+     * snapshot, including the changes in the journal of a previous run
+     */
+    bool isSnapshotRequired() const { return mSnapshotRequired; }
+
+    /**
+     * Get the number of changes which have been committed since the journal
+     * was last truncated
+     */
+    size_t getNumberOfCommittedChanges() const { return mNumberOfCommittedChanges; }
+
+    /**
+     * Get the number of buffered changes
+     */
+    size_t getNumberOfPendingChanges() const { return mNumberOfPendingChanges; }
+
+    const std::string& getPath() const { return mPath; }
+
+    /**
+     * Replay all complete records of a journal onto the ontology
+     * \details Each record is replayed through OWLOntologyTell, removals
+     * are applied by structural equality of the axioms. The knowledge base
+     * is not refreshed
+     * \return number of replayed changes
+     */
+    static size_t replay(const std::string& path, const owlapi::model::OWLOntology::Ptr& ontology);
+
+    /**
+     * Load the snapshot, if it exists, and replay the journal, if it exists
+     * \return recovered ontology
+     */
+    static owlapi::model::OWLOntology::Ptr recover(const std::string& snapshotPath, const std::string& journalPath);
+
+private:
+    /**
+     * Open the file for appending and truncate it to the given size, i.e.
+     * after the last complete record
+     */
+    void open(size_t validSize);
+    void close();
+    void write(const std::string& data);
+
+    std::string mPath;
+    Options mOptions;
+    int mFd;
+
+    owlapi::model::OWLOntology::Ptr mpOntology;
+
+    /// Encoded changes of the pending group
+    std::string mPending;
+    size_t mNumberOfPendingChanges;
+    size_t mNumberOfCommittedChanges;
+    /// Number of commits since the last sync
+    size_t mUnsyncedCommits;
+    bool mSnapshotRequired;
+};
+
+} // end namespace io
+} // end namespace owlapi
+#endif // OWLAPI_IO_CHANGE_JOURNAL_HPP
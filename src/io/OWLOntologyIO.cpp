@@ -7,12 +7,57 @@
 #include <boost/filesystem.hpp>
 
 #include <owlapi/Vocabulary.hpp>
+#include "../Instrumentation.hpp"
+#include "../model/OWLOntologyTell.hpp"
+#include "../model/OWLAxiomSignatureVisitor.hpp"
+#include "../model/OWLAxiomStructureVisitor.hpp"
 
 using namespace owlapi::model;
 
 namespace owlapi {
 namespace io {
 
+namespace {
+
+bool isBuiltin(const IRI& iri)
+{
+    const std::string& iriString = iri.toString();
+    for(const IRI& prefix : { vocabulary::OWL::IRIPrefix(), vocabulary::RDF::IRIPrefix(),
+            vocabulary::RDFS::IRIPrefix(), vocabulary::XSD::IRIPrefix() })
+    {
+        const std::string& prefixString = prefix.toString();
+        if(iriString.compare(0, prefixString.size(), prefixString) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check whether an axiom is subject to the delta computation of a reload:
+ * declarations and axioms about the builtin vocabulary only, which the
+ * reader states for every document, are not
+ */
+bool isReloadable(const OWLAxiom::Ptr& axiom)
+{
+    if(axiom->getAxiomType() == OWLAxiom::Declaration)
+    {
+        return false;
+    }
+
+    for(const IRI& iri : OWLAxiomSignatureVisitor::getSignature(axiom))
+    {
+        if(!isBuiltin(iri))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // end anonymous namespace
+
 std::map<Format, std::string> FormatTxt =
 {
     { RDFXML, "rdfxml" },
@@ -59,10 +104,11 @@ void OWLOntologyIO::write(const std::string& filename, const owlapi::model::OWLO
     }
 }
 
-owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(const owlapi::model::IRI& ontologyIRI)
+owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(const owlapi::model::IRI& ontologyIRI,
+        owlapi::model::OWLOntology::Mode mode)
 {
     using namespace owlapi::model;
-    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(mode);
     load(ontology, ontologyIRI, false);
     return ontology;
 }
@@ -79,6 +125,7 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
         )
 {
     using namespace owlapi::model;
+    OWLAPI_INSTRUMENT_SCOPE(IO_LOAD);
 
     OWLOntologyReader reader;
     if(ontology->getAbsolutePath().empty())
@@ -112,7 +159,7 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
     if(!isEmptyTopOntology)
     {
         // load from the file set for the ontology
-        ontology = reader.open(ontology->getAbsolutePath());
+        ontology = reader.open(ontology->getAbsolutePath(), ontology->getMode());
         reader.loadImports(ontology, true /*directImport*/);
     }
 
@@ -156,14 +203,21 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
 
         LOG_DEBUG_S << "Processing: " << iri;
 
-        std::string filename = retrieve(iri);
+        OWLOntologyReader* importReader;
+        OWLOntology::Ptr importedOntology;
+        {
+            OWLAPI_INSTRUMENT_SCOPE(IO_RESOLVE_IMPORT);
+            std::string filename = retrieve(iri);
 
-        OWLOntologyReader* importReader = new OWLOntologyReader();
-        OWLOntology::Ptr importedOntology = importReader->open(filename);
-        importedOntology->setIRI(iri);
+            importReader = new OWLOntologyReader();
+            // only used to identify the imports, so that no reasoner is
+            // required
+            importedOntology = importReader->open(filename, OWLOntology::STRUCTURAL);
+            importedOntology->setIRI(iri);
 
-        // load the individual ontology to identity direct imports
-        importReader->loadImports(importedOntology, true /*directImport*/);
+            // load the individual ontology to identity direct imports
+            importReader->loadImports(importedOntology, true /*directImport*/);
+        }
         iri = importedOntology->getIRI();
 
         IRIList directImports = importedOntology->getDirectImportsDocuments();
@@ -220,8 +274,11 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
             << "' into ontology " << ontology->getIRI();
 
         // Load the full ontology
-        importReader->loadDeclarations(ontology, false);
-        importReader->loadAxioms(ontology);
+        {
+            OWLAPI_INSTRUMENT_SCOPE(IO_LOAD_IMPORT);
+            importReader->loadDeclarations(ontology, false);
+            importReader->loadAxioms(ontology);
+        }
         delete importReader;
 
         // Remove iri from list of dependencies
@@ -256,10 +313,208 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
     return ontology;
 }
 
-owlapi::model::OWLOntology::Ptr OWLOntologyIO::fromFile(const std::string& filename)
+OWLOntologyDelta OWLOntologyIO::reload(owlapi::model::OWLOntology::Ptr& ontology,
+        const owlapi::model::IRI& document)
+{
+    OWLAPI_INSTRUMENT_SCOPE(IO_RELOAD);
+
+    bool isTopDocument = document.empty() || document == ontology->getIRI();
+    std::string path;
+    if(isTopDocument)
+    {
+        path = ontology->getAbsolutePath();
+        if(path.empty())
+        {
+            throw std::invalid_argument("owlapi::io::OWLOntologyIO::reload: ontology '"
+                    + ontology->getIRI().toString() + "' has not been loaded from a file");
+        }
+    } else {
+        path = retrieve(document);
+    }
+
+    // Parse the document into a scratch ontology which knows the vocabulary
+    // of the ontology, so that the reader interprets the document as during
+    // the initial load -- the comparison is structural, so that no reasoner
+    // is required
+    OWLOntology::Ptr scratch = make_shared<OWLOntology>(OWLOntology::STRUCTURAL);
+    scratch->setJournaling(true);
+    scratch->setIRI(isTopDocument ? ontology->getIRI() : document);
+    {
+        OWLOntologyTell tell(scratch, IRI("urn:owlapi:reload"));
+        for(const IRI& iri : ontology->mRDFProperties)
+        {
+            tell.rdfProperty(iri);
+        }
+        for(const std::pair<const IRI, OWLClass::Ptr>& entry : ontology->mClasses)
+        {
+            tell.klass(entry.first);
+        }
+        for(const std::pair<const IRI, OWLObjectProperty::Ptr>& entry : ontology->mObjectProperties)
+        {
+            tell.objectProperty(entry.first);
+        }
+        for(const std::pair<const IRI, OWLDataProperty::Ptr>& entry : ontology->mDataProperties)
+        {
+            tell.dataProperty(entry.first);
+        }
+        for(const std::pair<const IRI, OWLAnnotationProperty::Ptr>& entry : ontology->mAnnotationProperties)
+        {
+            tell.annotationProperty(entry.first);
+        }
+        for(const std::pair<const IRI, OWLDataType::Ptr>& entry : ontology->mDataTypes)
+        {
+            tell.datatype(entry.first);
+        }
+        for(const std::pair<const IRI, OWLNamedIndividual::Ptr>& entry : ontology->mNamedIndividuals)
+        {
+            tell.namedIndividual(entry.first);
+        }
+    }
+
+    OWLOntologyReader reader;
+    reader.open(path);
+    reader.loadImports(scratch, true /*directImport*/);
+    reader.loadDeclarations(scratch, isTopDocument);
+    reader.loadAxioms(scratch);
+    const IRI& origin = reader.getOrigin();
+
+    // Axioms of the ontology which originate from this document by
+    // structural key
+    std::map<std::string, OWLAxiom::PtrList> current;
+    for(const OWLAxiom::Ptr& axiom : ontology->getAxioms())
+    {
+        if(axiom->getOrigin() == origin && isReloadable(axiom))
+        {
+            current[OWLAxiomStructureVisitor::getKey(axiom)].push_back(axiom);
+        }
+    }
+
+    // A tell call of the document has to be replayed if it stated any new
+    // axiom -- all other axioms it stated are replaced then
+    OWLOntologyDelta delta;
+    std::set<const TellJournal::Entry*> replay;
+    // Calls which state no axiom, but create anonymous class expressions,
+    // data ranges or lists under ids which are unique to this read
+    std::set<const TellJournal::Entry*> anonymous;
+    for(const TellJournal::Entry& entry : scratch->mJournal.getEntries())
+    {
+        if(entry.origin != origin)
+        {
+            continue;
+        }
+
+        if(entry.axioms.empty())
+        {
+            anonymous.insert(&entry);
+            continue;
+        }
+
+        bool hasNewAxiom = false;
+        OWLAxiom::PtrList matched;
+        for(const OWLAxiom::Ptr& axiom : entry.axioms)
+        {
+            if(!isReloadable(axiom))
+            {
+                continue;
+            }
+
+            std::map<std::string, OWLAxiom::PtrList>::iterator it = current.find(OWLAxiomStructureVisitor::getKey(axiom));
+            if(it == current.end() || it->second.empty())
+            {
+                hasNewAxiom = true;
+            } else {
+                matched.push_back(it->second.back());
+                it->second.pop_back();
+            }
+        }
+
+        if(hasNewAxiom)
+        {
+            replay.insert(&entry);
+            delta.removed.insert(delta.removed.end(), matched.begin(), matched.end());
+        }
+    }
+
+    for(const std::pair<const std::string, OWLAxiom::PtrList>& entry : current)
+    {
+        delta.removed.insert(delta.removed.end(), entry.second.begin(), entry.second.end());
+    }
+
+    // Replayed calls might refer to anonymous expressions of this read,
+    // which are replayed with them in their original order, i.e. before
+    // the calls which refer to them
+    if(!replay.empty())
+    {
+        replay.insert(anonymous.begin(), anonymous.end());
+    }
+
+    LOG_INFO_S << "Reloading '" << path << "': removing " << delta.removed.size()
+        << " axioms, replaying " << replay.size() << " statements";
+
+    if(!delta.removed.empty())
+    {
+        ontology->removeAxioms(delta.removed);
+
+        // Drop the statements, which are now fully removed, from the journal
+        // so that a replay of the journal does not revive them
+        std::set<OWLAxiom::Ptr> removed(delta.removed.begin(), delta.removed.end());
+        ontology->mJournal.erase([&origin, &removed](const TellJournal::Entry& entry)
+                {
+                    if(entry.origin != origin)
+                    {
+                        return false;
+                    }
+                    bool hasRemovedAxiom = false;
+                    for(const shared_ptr<OWLAxiom>& axiom : entry.axioms)
+                    {
+                        if(removed.count(axiom))
+                        {
+                            hasRemovedAxiom = true;
+                        } else if(isReloadable(axiom))
+                        {
+                            return false;
+                        }
+                    }
+                    return hasRemovedAxiom;
+                });
+    }
+
+    // Collect the added axioms, independent of the journal of the ontology
+    struct CallbackGuard
+    {
+        const OWLOntology::Ptr& ontology;
+        OWLOntology::AxiomChangeCallback callback;
+        ~CallbackGuard() { ontology->setAxiomChangeCallback(callback); }
+    } guard = { ontology, ontology->getAxiomChangeCallback() };
+    ontology->setAxiomChangeCallback([&delta, &guard](const OWLAxiom::Ptr& axiom, bool added)
+            {
+                if(added)
+                {
+                    delta.added.push_back(axiom);
+                }
+                if(guard.callback)
+                {
+                    guard.callback(axiom, added);
+                }
+            });
+
+    scratch->mJournal.replay(ontology, [&replay](const TellJournal::Entry& entry)
+            {
+                return replay.count(&entry) != 0;
+            });
+
+    if(!delta.empty())
+    {
+        ontology->mQueryCache.clear();
+    }
+    return delta;
+}
+
+owlapi::model::OWLOntology::Ptr OWLOntologyIO::fromFile(const std::string& filename,
+        owlapi::model::OWLOntology::Mode mode)
 {
     OWLOntologyReader reader;
-    owlapi::model::OWLOntology::Ptr ontology = reader.open(filename);
+    owlapi::model::OWLOntology::Ptr ontology = reader.open(filename, mode);
     std::string absolutePath = boost::filesystem::canonical(filename).string();
     ontology->setAbsolutePath(absolutePath);
 
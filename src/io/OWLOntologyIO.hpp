@@ -37,6 +37,20 @@ enum Format { UNKNOWN = 0,
 extern std::map<Format, std::string> FormatTxt;
 extern std::map<Format, std::string> FormatSuffixes;
 
+/**
+ * \class OWLOntologyDelta
+ * \brief Axioms which have been added to and removed from an ontology by a
+ * reload
+ * \see OWLOntologyIO::reload
+ */
+struct OWLOntologyDelta
+{
+    owlapi::model::OWLAxiom::PtrList added;
+    owlapi::model::OWLAxiom::PtrList removed;
+
+    bool empty() const { return added.empty() && removed.empty(); }
+};
+
 /**
  * \class OWLOntologyIO
  * \brief Loading a single ontology
@@ -65,9 +79,12 @@ public:
     /**
      * Load an ontology from file
      * \param filename File to load from
+     * \param mode Use OWLOntology::STRUCTURAL to load the model only, e.g.
+     * to list or convert an ontology without the cost of a reasoner
      * \return OWLOntology::Ptr
      */
-    static owlapi::model::OWLOntology::Ptr fromFile(const std::string& filename);
+    static owlapi::model::OWLOntology::Ptr fromFile(const std::string& filename,
+            owlapi::model::OWLOntology::Mode mode = owlapi::model::OWLOntology::REASONING);
 
     /**
      * Load an ontology by a given iri -- imported ontologies will be loaded as
@@ -78,9 +95,11 @@ public:
      * Retrieval will only work after installation of the owlapi package, which
      * installs a pkg-config file that allows to identify the 'sharedir' variable.
      * Ontologies will be stored in a subfolder 'ontologies'
+     * \param mode Mode of the ontology, \see fromFile
      * \return Pointer to the OWLOntology instance
      */
-    static owlapi::model::OWLOntology::Ptr load(const owlapi::model::IRI& ontologyIRI);
+    static owlapi::model::OWLOntology::Ptr load(const owlapi::model::IRI& ontologyIRI,
+            owlapi::model::OWLOntology::Mode mode = owlapi::model::OWLOntology::REASONING);
 
     /**
      * Load an new ontology, which is only defined through its imported documents
@@ -110,6 +129,26 @@ public:
             const owlapi::model::IRI& ontologyIRI = "",
             bool isEmptyTopOntology = false);
 
+    /**
+     * \brief Reload a single (changed) document of an already loaded ontology
+     * \details Only the given document is parsed again. Its axioms are compared
+     * structurally with the axioms of the ontology, which originate from this
+     * document (\see OWLAxiom::getOrigin), and only the difference is applied,
+     * i.e. the knowledge base is updated incrementally.
+     * Declarations are not part of the comparison, so entities which are no
+     * longer declared by the document remain in the ontology. Axioms which
+     * refer to blank nodes of the document are only matched, if the blank
+     * nodes have the same id after reparsing.
+     * \param ontology Ontology to update
+     * \param document IRI of the document to reload, the top level document
+     * if empty; an imported document is located via retrieve
+     * \return the applied delta
+     * \throw std::invalid_argument if the top level document shall be reloaded
+     * but the ontology has not been loaded from a file
+     */
+    static OWLOntologyDelta reload(owlapi::model::OWLOntology::Ptr& ontology,
+            const owlapi::model::IRI& document = owlapi::model::IRI());
+
     /**
      * Retrieve the Ontology document and provide path to the document
      * \param iri IRI of the ontology, which shall be retrieved
@@ -11,6 +11,7 @@
 #include "../db/rdf/Redland.hpp"
 #include "../db/rdf/Sparql.hpp"
 #include "../Vocabulary.hpp"
+#include "../Instrumentation.hpp"
 #include "changes/AddEquivalentClasses.hpp"
 #include "changes/AddSubClassOfAnonymous.hpp"
 #include "OWLOntologyIO.hpp"
@@ -44,9 +45,10 @@ OWLOntologyReader::OWLOntologyReader()
     : mSparqlInterface(0)
 {}
 
-OWLOntology::Ptr OWLOntologyReader::open(const std::string& filename)
+OWLOntology::Ptr OWLOntologyReader::open(const std::string& filename, OWLOntology::Mode mode)
 {
-    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLAPI_INSTRUMENT_SCOPE(READER_OPEN);
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(mode);
     // check first if file is empty
     std::ifstream file(filename);
     if(file.peek() == std::ifstream::traits_type::eof())
@@ -59,6 +61,7 @@ OWLOntology::Ptr OWLOntologyReader::open(const std::string& filename)
     mSparqlInterface = new db::Redland(filename);
 
     mAbsolutePath = boost::filesystem::absolute(filename).string();
+    mOrigin = IRI();
     ontology->setAbsolutePath(mAbsolutePath);
     return ontology;
 }
@@ -76,6 +79,16 @@ OWLOntologyReader::~OWLOntologyReader()
     delete mSparqlInterface;
 }
 
+owlapi::model::MemoryUsage OWLOntologyReader::getMemoryUsage() const
+{
+    owlapi::model::MemoryUsage usage;
+    if(const db::Redland* redland = dynamic_cast<const db::Redland*>(mSparqlInterface))
+    {
+        usage.add("redland", redland->getMemoryUsage());
+    }
+    return usage;
+}
+
 db::query::Results OWLOntologyReader::findAll(const db::query::Variable& subject, const db::query::Variable& predicate, const db::query::Variable& object) const
 {
     db::query::Results results = mSparqlInterface->findAll(subject, predicate, object);
@@ -91,6 +104,7 @@ void OWLOntologyReader::load(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadImports(OWLOntology::Ptr& ontology, bool directImport)
 {
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_IMPORTS);
     Results results = findAll(Subject(), vocabulary::RDF::type(), vocabulary::OWL::Ontology());
     ResultsIterator it(results);
     while(it.next())
@@ -102,9 +116,14 @@ void OWLOntologyReader::loadImports(OWLOntology::Ptr& ontology, bool directImpor
         {
             ontology->setIRI(subject);
         }
+        mOrigin = subject;
+    }
+    if(mOrigin.empty())
+    {
+        mOrigin = ontology->getIRI();
     }
 
-    OWLOntologyTell tell(ontology);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     tell.initializeDefaultClasses();
@@ -129,6 +148,7 @@ void OWLOntologyReader::loadImports(OWLOntology::Ptr& ontology, bool directImpor
 
 void OWLOntologyReader::loadDeclarations(OWLOntology::Ptr& ontology, bool directImport)
 {
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_DECLARATIONS);
     Results results = findAll(Subject(), vocabulary::RDF::type(), vocabulary::OWL::Ontology());
     ResultsIterator it(results);
     while(it.next())
@@ -140,9 +160,14 @@ void OWLOntologyReader::loadDeclarations(OWLOntology::Ptr& ontology, bool direct
         {
             ontology->setIRI(subject);
         }
+        mOrigin = subject;
+    }
+    if(mOrigin.empty())
+    {
+        mOrigin = ontology->getIRI();
     }
 
-    OWLOntologyTell tell(ontology);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     tell.initializeDefaultClasses();
@@ -291,10 +316,11 @@ void OWLOntologyReader::loadDeclarations(OWLOntology::Ptr& ontology, bool direct
 
 void OWLOntologyReader::loadAxioms(OWLOntology::Ptr& ontology)
 {
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_AXIOMS);
     LOG_DEBUG_S << "Loading axioms from path: " << mAbsolutePath << " ontology:"
         " iri: " << ontology->getIRI();
 
-    OWLOntologyTell tell(ontology);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     {
@@ -483,9 +509,10 @@ void OWLOntologyReader::loadAxioms(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadProperties(OWLOntology::Ptr& ontology)
 {
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_PROPERTIES);
     LOG_DEBUG_S << "Loading properties from path: " << mAbsolutePath;
 
-    OWLOntologyTell tell(ontology);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     // Properties
@@ -636,7 +663,8 @@ void OWLOntologyReader::loadProperties(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadRestrictions(OWLOntology::Ptr& ontology)
 {
-    OWLOntologyTell tell(ontology);
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_RESTRICTIONS);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     // Example: Cardinality Restrictions
@@ -701,8 +729,9 @@ void OWLOntologyReader::loadRestrictions(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadAnonymousLists(OWLOntology::Ptr& ontology)
 {
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_ANONYMOUS_LISTS);
     OWLOntologyAsk ask(ontology);
-    OWLOntologyTell tell(ontology);
+    OWLOntologyTell tell(ontology, mOrigin);
 
     {
         Results results = findAll(Subject(), vocabulary::RDF::type(), vocabulary::RDF::List());
@@ -756,8 +785,9 @@ void OWLOntologyReader::loadAnonymousLists(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadDataTypeRestrictions(OWLOntology::Ptr& ontology)
 {
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_DATATYPE_RESTRICTIONS);
     OWLOntologyAsk ask(ontology);
-    OWLOntologyTell tell(ontology);
+    OWLOntologyTell tell(ontology, mOrigin);
 
     {
         // genid11 http://www.w3.org/2002/07/owl#withRestrictions genid10
@@ -1084,8 +1114,9 @@ void OWLOntologyReader::loadDataTypeRestrictions(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadObjectRestrictions(OWLOntology::Ptr& ontology)
 {
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_OBJECT_RESTRICTIONS);
     OWLOntologyAsk ask(ontology);
-    OWLOntologyTell tell(ontology);
+    OWLOntologyTell tell(ontology, mOrigin);
 
     // cardinalities
     {
@@ -1416,7 +1447,8 @@ owlapi::model::IRIList OWLOntologyReader::getList(const owlapi::model::IRI& anon
 
 void OWLOntologyReader::loadDataProperties(OWLOntology::Ptr& ontology)
 {
-    OWLOntologyTell tell(ontology);
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_DATA_PROPERTIES);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     using namespace db::query;
@@ -1490,7 +1522,7 @@ void OWLOntologyReader::loadDataProperties(OWLOntology::Ptr& ontology)
                 {
                     // check if range type is known
                     OWLDataType dataType = ask.getDataType(relation, value);
-                    literal = OWLLiteral::create(object.toString(), dataType);
+                    literal = OWLLiteral::create(value, dataType);
                 }
                 if(!ask.isOWLIndividual(subject))
                 {
@@ -1513,7 +1545,8 @@ void OWLOntologyReader::loadDataProperties(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadObjectProperties(OWLOntology::Ptr& ontology)
 {
-    OWLOntologyTell tell(ontology);
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_OBJECT_PROPERTIES);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     using namespace db::query;
@@ -1578,7 +1611,8 @@ void OWLOntologyReader::loadObjectProperties(OWLOntology::Ptr& ontology)
 
 void OWLOntologyReader::loadAnnotationProperties(OWLOntology::Ptr& ontology)
 {
-    OWLOntologyTell tell(ontology);
+    OWLAPI_INSTRUMENT_SCOPE(READER_LOAD_ANNOTATION_PROPERTIES);
+    OWLOntologyTell tell(ontology, mOrigin);
     OWLOntologyAsk ask(ontology);
 
     using namespace db::query;
@@ -45,6 +45,10 @@ class OWLOntologyReader
     /// The currently opened path
     std::string mAbsolutePath;
 
+    /// The iri of the currently opened document, which is used as origin of
+    /// all axioms loaded from it
+    owlapi::model::IRI mOrigin;
+
 protected:
 
     db::query::Results findAll(const db::query::Variable& subject, const db::query::Variable& predicate, const db::query::Variable& object) const;
@@ -66,8 +70,10 @@ protected:
 public:
     /**
      * Open file to load ontology in an incremental way
+     * \param mode Mode of the ontology to create, \see OWLOntology::Mode
      */
-    owlapi::model::OWLOntology::Ptr open(const std::string& filename);
+    owlapi::model::OWLOntology::Ptr open(const std::string& filename,
+            owlapi::model::OWLOntology::Mode mode = owlapi::model::OWLOntology::REASONING);
 
     /**
      * Only identify the imports
@@ -104,6 +110,21 @@ public:
      * \return path
      */
     const std::string& getAbsolutePath() const { return mAbsolutePath; }
+
+    /**
+     * Retrieve the origin of the axioms loaded by this reader, i.e. the iri
+     * of the ontology document
+     * \return origin, which is empty until imports or declarations have been
+     * loaded
+     */
+    const owlapi::model::IRI& getOrigin() const { return mOrigin; }
+
+    /**
+     * Get the estimated memory of the underlying triple store, i.e. of the
+     * redland storage as subsystem redland
+     * \return memory usage, which is empty if no file has been opened
+     */
+    owlapi::model::MemoryUsage getMemoryUsage() const;
 };
 
 } // end namespace io
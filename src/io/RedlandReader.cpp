@@ -1,7 +1,10 @@
 #include "RedlandReader.hpp"
 #include "OWLOntologyIO.hpp"
 #include <raptor2.h>
+#include <atomic>
 #include <cstdlib>
+#include <mutex>
+#include <vector>
 
 namespace owlapi {
 namespace io {
@@ -43,8 +46,7 @@ void rasqalLogFunction(void* user_data,
 
 unsigned char* blankNodeHandler(void *user_data, unsigned char* user_bnodeid)
 {
-  //raptor_world *world = (raptor_world*)user_data;
-  int id;
+  uint64_t id;
   unsigned char *buffer;
 
   if(user_bnodeid)
@@ -60,19 +62,89 @@ unsigned char* blankNodeHandler(void *user_data, unsigned char* user_bnodeid)
   return buffer;
 }
 
-int RedlandReader::msBlankNodeId = 0;
+namespace {
+
+/**
+ * Process-wide pool of opened, idle librdf worlds
+ * \details A world is used by a single reader at a time. Worlds are created
+ * while holding the lock, since their creation initializes global state of
+ * the underlying libraries
+ */
+class WorldPool
+{
+public:
+    /// Maximum number of idle worlds which are kept
+    static const size_t MAX_IDLE_WORLDS = 16;
+
+    ~WorldPool()
+    {
+        for(librdf_world* world : mWorlds)
+        {
+            librdf_free_world(world);
+        }
+    }
+
+    librdf_world* acquire()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(!mWorlds.empty())
+        {
+            librdf_world* world = mWorlds.back();
+            mWorlds.pop_back();
+            return world;
+        }
+
+        librdf_world* world = librdf_new_world();
+        librdf_world_open(world);
+        librdf_world_set_logger(world, NULL, &rdfLogFunction);
+
+        rasqal_world* rasqalWorld = librdf_world_get_rasqal(world);
+        rasqal_world_set_warning_level(rasqalWorld, 10);
+        rasqal_world_set_log_handler(rasqalWorld, NULL, &rasqalLogFunction);
+        return world;
+    }
+
+    void release(librdf_world* world)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if(mWorlds.size() < MAX_IDLE_WORLDS)
+            {
+                mWorlds.push_back(world);
+                return;
+            }
+        }
+        librdf_free_world(world);
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWorlds.size();
+    }
+
+private:
+    mutable std::mutex mMutex;
+    std::vector<librdf_world*> mWorlds;
+};
+
+WorldPool& worldPool()
+{
+    static WorldPool pool;
+    return pool;
+}
+
+} // end anonymous namespace
 
 ParsingFailed::ParsingFailed(const std::string& message)
     : std::runtime_error(message)
 {}
 
 RedlandReader::RedlandReader()
-    : mpWorld(librdf_new_world())
+    : mpWorld(worldPool().acquire())
     , mpStorage(0)
     , mpModel(0)
 {
-    librdf_world_open(mpWorld);
-
     // see http://librdf.org/docs/api/redland-storage-module-hashes.html
     mpStorage = librdf_new_storage(mpWorld, "hashes", NULL,
             "hash-type='memory'");
@@ -81,9 +153,43 @@ RedlandReader::RedlandReader()
 
 RedlandReader::~RedlandReader()
 {
+    for(const std::pair<const std::string, librdf_parser*>& parser : mParsers)
+    {
+        librdf_free_parser(parser.second);
+    }
     librdf_free_model(mpModel);
     librdf_free_storage(mpStorage);
-    librdf_free_world(mpWorld);
+    worldPool().release(mpWorld);
+}
+
+uint64_t RedlandReader::consumeBlankNodeId()
+{
+    // Ids start at genid1 and are shared by all readers: the anonymous
+    // nodes of all documents of an ontology are stored in the same
+    // ontology, so ids which are scoped per reader would merge them
+    static std::atomic<uint64_t> blankNodeId(0);
+    return ++blankNodeId;
+}
+
+size_t RedlandReader::getNumberOfPooledWorlds()
+{
+    return worldPool().size();
+}
+
+librdf_parser* RedlandReader::getParser(const std::string& name) const
+{
+    std::map<std::string, librdf_parser*>::const_iterator cit = mParsers.find(name);
+    if(cit != mParsers.end())
+    {
+        return cit->second;
+    }
+
+    librdf_parser* parser = librdf_new_parser(mpWorld, name.c_str(), NULL, NULL);
+    if(parser)
+    {
+        mParsers[name] = parser;
+    }
+    return parser;
 }
 
 std::vector<std::string> RedlandReader::getSupportedFormats() const
@@ -135,24 +241,13 @@ void RedlandReader::read(const std::string& filename) const
 
 void RedlandReader::read(const std::string& filename, const std::string& format) const
 {
-    unsigned char* uri_string = raptor_uri_filename_to_uri_string(filename.c_str());
-    librdf_uri* base_uri = librdf_new_uri(mpWorld, uri_string);
     raptor_world* raptorWorld = librdf_world_get_raptor(mpWorld);
-    raptor_world_set_generate_bnodeid_handler(raptorWorld, NULL, blankNodeHandler);
-
-    librdf_world_set_logger(mpWorld,
-            NULL,
-            &rdfLogFunction);
-
-    rasqal_world* rasqalWorld = librdf_world_get_rasqal(mpWorld);
-    rasqal_world_set_warning_level(rasqalWorld, 10);
-    rasqal_world_set_log_handler(rasqalWorld,
-            NULL,
-            &rasqalLogFunction);
-
-
-
+    // the world might have been used by another reader before
+    raptor_world_set_generate_bnodeid_handler(raptorWorld,
+            const_cast<void*>(static_cast<const void*>(this)),
+            blankNodeHandler);
 
+    unsigned char* uri_string = raptor_uri_filename_to_uri_string(filename.c_str());
     std::string parserName = format;
     if(format.empty())
     {
@@ -163,28 +258,25 @@ void RedlandReader::read(const std::string& filename, const std::string& format)
         LOG_DEBUG_S << "Using format: " << format;
     }
 
-    librdf_parser* p = librdf_new_parser(mpWorld, parserName.c_str(), NULL, NULL);
+    librdf_parser* p = getParser(parserName);
     if(!p)
     {
+        raptor_free_memory(uri_string);
         throw ParsingFailed("owlapi::io::RedlandReader::read: reading '"
                 + filename + "' failed. Parser for format '" + mFormat + "'"
                 " could not be created");
     }
 
-    if(librdf_parser_parse_into_model(p, base_uri, NULL, mpModel) != 0)
+    librdf_uri* base_uri = librdf_new_uri(mpWorld, uri_string);
+    raptor_free_memory(uri_string);
+    int result = librdf_parser_parse_into_model(p, base_uri, NULL, mpModel);
+    librdf_free_uri(base_uri);
+    if(result != 0)
     {
         throw ParsingFailed("owlapi::io::RedlandReader::read: reading '"
                 + filename + "' failed for format: " + mFormat);
     }
-
-    //raptor_iostream* iostr = raptor_new_iostream_to_file_handle(raptorWorld, stdout);
-    //librdf_model_write(mpModel, iostr);
-    //raptor_free_iostream(iostr);
-
-    librdf_free_parser(p);
-    librdf_free_uri(base_uri);
 }
 
-
 } // end namespace io
 } // end namespace owlapi
@@ -2,6 +2,8 @@
 #define OWLAPI_IO_REDLAND_READER_HPP
 
 #include <stdexcept>
+#include <stdint.h>
+#include <map>
 #include "OWLReader.hpp"
 #include <redland.h>
 
@@ -14,6 +16,20 @@ public:
     ParsingFailed(const std::string& message = "");
 };
 
+/**
+ * \class RedlandReader
+ * \brief Reads RDF documents into an in-memory Redland model
+ * \details A single reader must not be used from multiple threads at the
+ * same time, but independent readers can be used concurrently:
+ *  - each reader uses a librdf world of its own; since opening a world
+ *    registers all parsers, serializers and storages, the worlds of
+ *    destroyed readers are kept in a process-wide pool and reused
+ *  - parsers are created once per reader and format, and reused for
+ *    subsequent reads
+ *  - blank node ids are generated from a process-wide counter, so that the
+ *    blank nodes of documents which are imported into the same ontology
+ *    by different readers do not collide
+ */
 class RedlandReader : public OWLReader
 {
 public:
@@ -34,14 +50,30 @@ public:
     librdf_world* getWorld() { return mpWorld; }
     librdf_model* getModel() { return mpModel; }
 
-    static int consumeBlankNodeId() { return ++msBlankNodeId; }
+    /**
+     * Generate the next blank node id, which is unique within the process
+     */
+    static uint64_t consumeBlankNodeId();
+
+    /**
+     * Get the number of idle worlds, which are kept for reuse by the next
+     * readers
+     */
+    static size_t getNumberOfPooledWorlds();
 
 private:
     librdf_world* mpWorld;
     librdf_storage *mpStorage;
     librdf_model* mpModel;
 
-    static int msBlankNodeId;
+    /// Parsers by name
+    mutable std::map<std::string, librdf_parser*> mParsers;
+
+    /**
+     * Get or create the parser with the given name
+     * \return parser, or NULL if it cannot be created
+     */
+    librdf_parser* getParser(const std::string& name) const;
 };
 
 } // end namespace io
@@ -0,0 +1,186 @@
+#include "ABoxBatch.hpp"
+#include <stdexcept>
+#include <boost/lexical_cast.hpp>
+
+namespace owlapi {
+namespace model {
+
+namespace {
+
+void checkLength(size_t expected, size_t actual, const std::string& function)
+{
+    if(expected != actual)
+    {
+        throw std::invalid_argument("owlapi::model::ABoxBatch::" + function + ": columns differ in length ("
+                + boost::lexical_cast<std::string>(expected) + " vs. "
+                + boost::lexical_cast<std::string>(actual) + ")");
+    }
+}
+
+} // end anonymous namespace
+
+ABoxBatch::Id ABoxBatch::intern(const IRI& iri)
+{
+    std::pair<std::unordered_map<IRI, Id>::iterator, bool> result = mIds.insert(std::make_pair(iri, mIRIs.size()));
+    if(result.second)
+    {
+        mIRIs.push_back(iri);
+    }
+    return result.first->second;
+}
+
+const IRI& ABoxBatch::getIRI(Id id) const
+{
+    if(id >= mIRIs.size())
+    {
+        throw std::out_of_range("owlapi::model::ABoxBatch::getIRI: unknown id "
+                + boost::lexical_cast<std::string>(id));
+    }
+    return mIRIs[id];
+}
+
+void ABoxBatch::validate(Id id) const
+{
+    if(id >= mIRIs.size())
+    {
+        throw std::invalid_argument("owlapi::model::ABoxBatch: id "
+                + boost::lexical_cast<std::string>(id) + " has not been interned");
+    }
+}
+
+void ABoxBatch::reserve(size_t numberOfTypes, size_t numberOfRelations, size_t numberOfValues)
+{
+    mTypeIndividuals.reserve(numberOfTypes);
+    mTypeClasses.reserve(numberOfTypes);
+
+    mRelationSubjects.reserve(numberOfRelations);
+    mRelationProperties.reserve(numberOfRelations);
+    mRelationObjects.reserve(numberOfRelations);
+
+    mValueSubjects.reserve(numberOfValues);
+    mValueProperties.reserve(numberOfValues);
+    mValues.reserve(numberOfValues);
+}
+
+void ABoxBatch::addType(Id individual, Id klass)
+{
+    validate(individual);
+    validate(klass);
+    mTypeIndividuals.push_back(individual);
+    mTypeClasses.push_back(klass);
+}
+
+void ABoxBatch::addType(const IRI& individual, const IRI& klass)
+{
+    addType(intern(individual), intern(klass));
+}
+
+void ABoxBatch::addRelation(Id subject, Id property, Id object)
+{
+    validate(subject);
+    validate(property);
+    validate(object);
+    mRelationSubjects.push_back(subject);
+    mRelationProperties.push_back(property);
+    mRelationObjects.push_back(object);
+}
+
+void ABoxBatch::addRelation(const IRI& subject, const IRI& property, const IRI& object)
+{
+    addRelation(intern(subject), intern(property), intern(object));
+}
+
+void ABoxBatch::addValue(Id subject, Id property, const OWLLiteral::Ptr& value)
+{
+    validate(subject);
+    validate(property);
+    if(!value)
+    {
+        throw std::invalid_argument("owlapi::model::ABoxBatch::addValue: value is not set");
+    }
+    mValueSubjects.push_back(subject);
+    mValueProperties.push_back(property);
+    mValues.push_back(value);
+}
+
+void ABoxBatch::addValue(const IRI& subject, const IRI& property, const OWLLiteral::Ptr& value)
+{
+    addValue(intern(subject), intern(property), value);
+}
+
+void ABoxBatch::addTypes(const IdList& individuals, const IdList& klasses)
+{
+    checkLength(individuals.size(), klasses.size(), "addTypes");
+    for(size_t i = 0; i < individuals.size(); ++i)
+    {
+        addType(individuals[i], klasses[i]);
+    }
+}
+
+void ABoxBatch::addRelations(const IdList& subjects, const IdList& properties, const IdList& objects)
+{
+    checkLength(subjects.size(), properties.size(), "addRelations");
+    checkLength(subjects.size(), objects.size(), "addRelations");
+    for(size_t i = 0; i < subjects.size(); ++i)
+    {
+        addRelation(subjects[i], properties[i], objects[i]);
+    }
+}
+
+void ABoxBatch::addValues(const IdList& subjects, const IdList& properties, const OWLLiteral::PtrList& values)
+{
+    checkLength(subjects.size(), properties.size(), "addValues");
+    checkLength(subjects.size(), values.size(), "addValues");
+    for(size_t i = 0; i < subjects.size(); ++i)
+    {
+        addValue(subjects[i], properties[i], values[i]);
+    }
+}
+
+void ABoxBatch::addValues(const IdList& subjects, Id property, const std::vector<double>& values)
+{
+    checkLength(subjects.size(), values.size(), "addValues");
+    for(size_t i = 0; i < subjects.size(); ++i)
+    {
+        addValue(subjects[i], property, OWLLiteral::doubleValue(values[i]));
+    }
+}
+
+void ABoxBatch::addValues(const IdList& subjects, Id property, const std::vector<int32_t>& values)
+{
+    checkLength(subjects.size(), values.size(), "addValues");
+    for(size_t i = 0; i < subjects.size(); ++i)
+    {
+        addValue(subjects[i], property, OWLLiteral::integer(values[i]));
+    }
+}
+
+void ABoxBatch::addValues(const IdList& subjects, Id property, const std::vector<std::string>& values, const IRI& datatype)
+{
+    checkLength(subjects.size(), values.size(), "addValues");
+    std::string type = datatype.toString();
+    for(size_t i = 0; i < subjects.size(); ++i)
+    {
+        addValue(subjects[i], property, OWLLiteral::create(values[i], type));
+    }
+}
+
+void ABoxBatch::clear()
+{
+    mIds.clear();
+    mIRIs.clear();
+
+    mTypeIndividuals.clear();
+    mTypeClasses.clear();
+
+    mRelationSubjects.clear();
+    mRelationProperties.clear();
+    mRelationObjects.clear();
+
+    mValueSubjects.clear();
+    mValueProperties.clear();
+    mValues.clear();
+}
+
+} // end namespace model
+} // end namespace owlapi
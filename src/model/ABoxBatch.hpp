@@ -0,0 +1,167 @@
+#ifndef OWLAPI_MODEL_ABOX_BATCH_HPP
+#define OWLAPI_MODEL_ABOX_BATCH_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "IRI.hpp"
+#include "OWLLiteral.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class ABoxBatch
+ * \brief Columnar batch of class assertions, object property assertions and
+ * data property assertions
+ * \details Entities are referred to by ids, which are assigned by interning
+ * their IRI in the batch's dictionary. Each kind of assertion is stored as a
+ * set of columns of equal length, e.g. relations as subject, property and
+ * object columns, so that a batch can be filled directly from columnar data
+ * such as logged observations.
+ *
+\verbatim
+    ABoxBatch::Ptr batch = make_shared<ABoxBatch>();
+    ABoxBatch::Id temperature = batch->intern(temperatureProperty);
+    for(const Observation& observation : observations)
+    {
+        batch->addValue(batch->intern(observation.sensor), temperature,
+            OWLLiteral::doubleValue(observation.value));
+    }
+    OWLOntologyTell(ontology).assertBatch(batch);
+\endverbatim
+ * \see OWLOntologyTell::assertBatch
+ */
+class ABoxBatch
+{
+public:
+    typedef shared_ptr<ABoxBatch> Ptr;
+    typedef uint32_t Id;
+    typedef std::vector<Id> IdList;
+
+    /**
+     * Get the id of an IRI, and assign a new id if the IRI is not yet part
+     * of the dictionary
+     */
+    Id intern(const IRI& iri);
+
+    /**
+     * Get the dictionary of this batch, i.e. the IRI of each id
+     */
+    const IRIList& getIRIs() const { return mIRIs; }
+
+    /**
+     * Get the IRI of an id
+     * \throw std::out_of_range if the id is not known
+     */
+    const IRI& getIRI(Id id) const;
+
+    /**
+     * Reserve memory for the given number of assertions
+     */
+    void reserve(size_t numberOfTypes, size_t numberOfRelations, size_t numberOfValues);
+
+    /**
+     * Add a class assertion
+     */
+    void addType(Id individual, Id klass);
+    void addType(const IRI& individual, const IRI& klass);
+
+    /**
+     * Add an object property assertion
+     */
+    void addRelation(Id subject, Id property, Id object);
+    void addRelation(const IRI& subject, const IRI& property, const IRI& object);
+
+    /**
+     * Add a data property assertion
+     */
+    void addValue(Id subject, Id property, const OWLLiteral::Ptr& value);
+    void addValue(const IRI& subject, const IRI& property, const OWLLiteral::Ptr& value);
+
+    /**
+     * Add class assertions from columns
+     * \throw std::invalid_argument if the columns differ in length
+     */
+    void addTypes(const IdList& individuals, const IdList& klasses);
+
+    /**
+     * Add object property assertions from columns
+     * \throw std::invalid_argument if the columns differ in length
+     */
+    void addRelations(const IdList& subjects, const IdList& properties, const IdList& objects);
+
+    /**
+     * Add data property assertions from columns
+     * \throw std::invalid_argument if the columns differ in length
+     */
+    void addValues(const IdList& subjects, const IdList& properties, const OWLLiteral::PtrList& values);
+
+    /**
+     * Add xsd:double values of a single data property
+     * \throw std::invalid_argument if the columns differ in length
+     */
+    void addValues(const IdList& subjects, Id property, const std::vector<double>& values);
+
+    /**
+     * Add xsd:integer values of a single data property
+     * \throw std::invalid_argument if the columns differ in length
+     */
+    void addValues(const IdList& subjects, Id property, const std::vector<int32_t>& values);
+
+    /**
+     * Add values of a single data property, which are given in their
+     * lexical form
+     * \param datatype IRI of the datatype of all values
+     * \throw std::invalid_argument if the columns differ in length
+     */
+    void addValues(const IdList& subjects, Id property, const std::vector<std::string>& values, const IRI& datatype);
+
+    const IdList& getTypeIndividuals() const { return mTypeIndividuals; }
+    const IdList& getTypeClasses() const { return mTypeClasses; }
+
+    const IdList& getRelationSubjects() const { return mRelationSubjects; }
+    const IdList& getRelationProperties() const { return mRelationProperties; }
+    const IdList& getRelationObjects() const { return mRelationObjects; }
+
+    const IdList& getValueSubjects() const { return mValueSubjects; }
+    const IdList& getValueProperties() const { return mValueProperties; }
+    const OWLLiteral::PtrList& getValues() const { return mValues; }
+
+    size_t getNumberOfTypes() const { return mTypeIndividuals.size(); }
+    size_t getNumberOfRelations() const { return mRelationSubjects.size(); }
+    size_t getNumberOfValues() const { return mValueSubjects.size(); }
+
+    /**
+     * Get the total number of assertions
+     */
+    size_t size() const { return getNumberOfTypes() + getNumberOfRelations() + getNumberOfValues(); }
+
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Remove all assertions and the dictionary
+     */
+    void clear();
+
+private:
+    void validate(Id id) const;
+
+    std::unordered_map<IRI, Id> mIds;
+    IRIList mIRIs;
+
+    IdList mTypeIndividuals;
+    IdList mTypeClasses;
+
+    IdList mRelationSubjects;
+    IdList mRelationProperties;
+    IdList mRelationObjects;
+
+    IdList mValueSubjects;
+    IdList mValueProperties;
+    OWLLiteral::PtrList mValues;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_ABOX_BATCH_HPP
@@ -0,0 +1,18 @@
+#include "AddAxiom.hpp"
+#include "OWLOntologyChangeVisitor.hpp"
+
+namespace owlapi {
+namespace model {
+
+AddAxiom::AddAxiom(const OWLOntology::Ptr& ontology, const OWLAxiom::Ptr& axiom)
+    : OWLAxiomChange(ontology, axiom)
+{
+}
+
+ChangeApplied AddAxiom::accept(const OWLOntologyChangeVisitor::Ptr& visitor)
+{
+    return visitor->visit(*this);
+}
+
+} // end namespace model
+} // end namespace owlapi
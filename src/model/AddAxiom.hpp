@@ -0,0 +1,22 @@
+#ifndef OWLAPI_MODEL_ADD_AXIOM_HPP
+#define OWLAPI_MODEL_ADD_AXIOM_HPP
+
+#include "OWLAxiomChange.hpp"
+
+namespace owlapi {
+namespace model {
+
+class AddAxiom : public OWLAxiomChange
+{
+public:
+    AddAxiom(const OWLOntology::Ptr& ontology, const OWLAxiom::Ptr& e);
+
+    bool isAddAxiom() const { return true; }
+    bool isRemoveAxiom() const { return false; }
+
+    ChangeApplied accept(const OWLOntologyChangeVisitor::Ptr& visitor);
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_ADD_AXIOM_HPP
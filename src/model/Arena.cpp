@@ -0,0 +1,144 @@
+#include "Arena.hpp"
+#include <new>
+#include <cstdlib>
+#include <stdint.h>
+
+namespace owlapi {
+namespace model {
+
+const size_t Arena::DEFAULT_BLOCK_SIZE;
+const size_t Arena::MIN_ALIGNMENT;
+
+Arena::Arena(size_t blockSize)
+    : mBlockSize(blockSize)
+    , mCurrent(NULL)
+    , mEnd(NULL)
+    , mFreeLists(blockSize/4/MIN_ALIGNMENT, NULL)
+    , mAllocatedBytes(0)
+    , mReservedBytes(0)
+    , mFreeBytes(0)
+{}
+
+Arena::~Arena()
+{
+    for(char* block : mBlocks)
+    {
+        free(block);
+    }
+}
+
+char* Arena::allocateBlock(size_t size)
+{
+    char* block = static_cast<char*>( malloc(size) );
+    if(!block)
+    {
+        throw std::bad_alloc();
+    }
+    mBlocks.push_back(block);
+    mReservedBytes += size;
+    return block;
+}
+
+size_t Arena::getSizeClass(size_t size, size_t alignment) const
+{
+    if(alignment > MIN_ALIGNMENT || size == 0)
+    {
+        return mFreeLists.size();
+    }
+    size_t sizeClass = (size - 1)/MIN_ALIGNMENT;
+    return sizeClass < mFreeLists.size() ? sizeClass : mFreeLists.size();
+}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    size_t sizeClass = getSizeClass(size, alignment);
+    if(sizeClass < mFreeLists.size())
+    {
+        // reusable memory is always a multiple of the minimum alignment
+        size = (sizeClass + 1)*MIN_ALIGNMENT;
+        alignment = MIN_ALIGNMENT;
+
+        FreeChunk* chunk = mFreeLists[sizeClass];
+        if(chunk)
+        {
+            mFreeLists[sizeClass] = chunk->next;
+            mFreeBytes -= size;
+            mAllocatedBytes += size;
+            return chunk;
+        }
+    }
+
+    uintptr_t current = reinterpret_cast<uintptr_t>(mCurrent);
+    uintptr_t aligned = (current + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    if(!mCurrent || aligned + size > reinterpret_cast<uintptr_t>(mEnd))
+    {
+        // Oversized requests get a dedicated block, so that the remainder of
+        // the current block is not wasted
+        size_t required = size + alignment;
+        if(required > mBlockSize/4)
+        {
+            char* block = allocateBlock(required);
+            uintptr_t start = reinterpret_cast<uintptr_t>(block);
+            mAllocatedBytes += size;
+            return reinterpret_cast<void*>( (start + alignment - 1) & ~(uintptr_t) (alignment - 1) );
+        }
+
+        mCurrent = allocateBlock(mBlockSize);
+        mEnd = mCurrent + mBlockSize;
+        current = reinterpret_cast<uintptr_t>(mCurrent);
+        aligned = (current + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    }
+
+    mCurrent = reinterpret_cast<char*>(aligned + size);
+    mAllocatedBytes += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void Arena::deallocate(void* memory, size_t size, size_t alignment)
+{
+    if(!memory)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t sizeClass = getSizeClass(size, alignment);
+    if(sizeClass < mFreeLists.size())
+    {
+        size = (sizeClass + 1)*MIN_ALIGNMENT;
+        FreeChunk* chunk = static_cast<FreeChunk*>(memory);
+        chunk->next = mFreeLists[sizeClass];
+        mFreeLists[sizeClass] = chunk;
+        mFreeBytes += size;
+    }
+    mAllocatedBytes -= size;
+}
+
+size_t Arena::getAllocatedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAllocatedBytes;
+}
+
+size_t Arena::getFreeBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mFreeBytes;
+}
+
+size_t Arena::getReservedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mReservedBytes;
+}
+
+size_t Arena::getNumberOfBlocks() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mBlocks.size();
+}
+
+} // end namespace model
+} // end namespace owlapi
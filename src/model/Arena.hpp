@@ -0,0 +1,167 @@
+#ifndef OWLAPI_MODEL_ARENA_HPP
+#define OWLAPI_MODEL_ARENA_HPP
+
+#include <vector>
+#include <cstddef>
+#include <mutex>
+#include "../SharedPtr.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class Arena
+ * \brief Block allocator for model objects of a single ontology
+ * \details Memory is taken from large blocks, which are only returned to the
+ * system as a whole when the arena is destroyed. Released memory is kept in
+ * free lists per size class of MIN_ALIGNMENT bytes and reused by later
+ * allocations of the same size class, so that an ontology which replaces
+ * its objects does not grow the arena. Oversized allocations, i.e. above a
+ * quarter of the block size, and allocations with a stricter alignment than
+ * MIN_ALIGNMENT are not reused.
+ *
+ * Allocation, release and the statistics are thread-safe, so that objects
+ * can be released from any thread.
+ * \see OWLOntology::enableArena
+ */
+class Arena
+{
+public:
+    typedef shared_ptr<Arena> Ptr;
+
+    static const size_t DEFAULT_BLOCK_SIZE = 64*1024;
+    /// Granularity of the size classes, and alignment of reused memory
+    static const size_t MIN_ALIGNMENT = alignof(void*);
+
+    /**
+     * Constructor
+     * \param blockSize Size of the memory blocks to allocate from
+     */
+    explicit Arena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    ~Arena();
+
+    /**
+     * Allocate memory
+     * \param size Number of bytes
+     * \param alignment Required alignment (power of 2)
+     * \return pointer to the allocated memory
+     * \throw std::bad_alloc if the memory could not be allocated
+     */
+    void* allocate(size_t size, size_t alignment);
+
+    /**
+     * Release memory, which has been allocated with the same size and
+     * alignment, for reuse
+     */
+    void deallocate(void* memory, size_t size, size_t alignment);
+
+    /**
+     * Get the block size of this arena
+     */
+    size_t getBlockSize() const { return mBlockSize; }
+
+    /**
+     * Get the number of bytes which are currently handed out
+     */
+    size_t getAllocatedBytes() const;
+
+    /**
+     * Get the number of bytes which have been released and are available
+     * for reuse
+     */
+    size_t getFreeBytes() const;
+
+    /**
+     * Get the number of bytes which have been reserved from the system
+     */
+    size_t getReservedBytes() const;
+
+    /**
+     * Get the number of allocated blocks
+     */
+    size_t getNumberOfBlocks() const;
+
+private:
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    char* allocateBlock(size_t size);
+
+    /**
+     * Get the size class of an allocation
+     * \return index into mFreeLists, or mFreeLists.size() if the memory
+     * is not reused
+     */
+    size_t getSizeClass(size_t size, size_t alignment) const;
+
+    struct FreeChunk
+    {
+        FreeChunk* next;
+    };
+
+    size_t mBlockSize;
+    std::vector<char*> mBlocks;
+    char* mCurrent;
+    char* mEnd;
+    /// Released chunks by size class, where class i holds chunks of
+    /// (i + 1)*MIN_ALIGNMENT bytes
+    std::vector<FreeChunk*> mFreeLists;
+    size_t mAllocatedBytes;
+    size_t mReservedBytes;
+    size_t mFreeBytes;
+    mutable std::mutex mMutex;
+};
+
+/**
+ * \class ArenaAllocator
+ * \brief Allocator to create objects in an arena, e.g. via allocate_shared
+ * \details The allocator keeps the arena alive, so that objects can safely
+ * outlive the ontology that created them
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    ArenaAllocator(const Arena::Ptr& arena)
+        : mpArena(arena)
+    {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : mpArena(other.getArena())
+    {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>( mpArena->allocate(n*sizeof(T), alignof(T)) );
+    }
+
+    void deallocate(T* memory, size_t n)
+    {
+        mpArena->deallocate(memory, n*sizeof(T), alignof(T));
+    }
+
+    const Arena::Ptr& getArena() const { return mpArena; }
+
+private:
+    Arena::Ptr mpArena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+    return a.getArena() == b.getArena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+    return !(a == b);
+}
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_ARENA_HPP
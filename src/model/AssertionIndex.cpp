@@ -0,0 +1,276 @@
+#include "AssertionIndex.hpp"
+#include "MemoryUsage.hpp"
+#include <algorithm>
+
+namespace owlapi {
+namespace model {
+
+const AssertionIndex::Id AssertionIndex::INVALID_ID;
+
+AssertionIndex::AssertionIndex()
+    : mNumberOfRelations(0)
+    , mNumberOfValues(0)
+{}
+
+void AssertionIndex::clear()
+{
+    mIndividualIds.clear();
+    mIndividuals.clear();
+    mPropertyIds.clear();
+    mProperties.clear();
+    mOutgoing.clear();
+    mIncoming.clear();
+    mValues.clear();
+    mNumberOfRelations = 0;
+    mNumberOfValues = 0;
+}
+
+AssertionIndex::Id AssertionIndex::getOrCreateIndividualId(const IRI& individual)
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mIndividualIds.find(individual);
+    if(cit != mIndividualIds.end())
+    {
+        return cit->second;
+    }
+
+    Id id = mIndividuals.size();
+    mIndividualIds[individual] = id;
+    mIndividuals.push_back(individual);
+    mOutgoing.push_back(EdgeList());
+    mIncoming.push_back(EdgeList());
+    mValues.push_back(ValueList());
+    return id;
+}
+
+AssertionIndex::Id AssertionIndex::getOrCreatePropertyId(const IRI& property)
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mPropertyIds.find(property);
+    if(cit != mPropertyIds.end())
+    {
+        return cit->second;
+    }
+
+    Id id = mProperties.size();
+    mPropertyIds[property] = id;
+    mProperties.push_back(property);
+    return id;
+}
+
+AssertionIndex::Id AssertionIndex::getIndividualId(const IRI& individual) const
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mIndividualIds.find(individual);
+    return cit == mIndividualIds.end() ? INVALID_ID : cit->second;
+}
+
+AssertionIndex::Id AssertionIndex::getPropertyId(const IRI& property) const
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mPropertyIds.find(property);
+    return cit == mPropertyIds.end() ? INVALID_ID : cit->second;
+}
+
+std::pair<AssertionIndex::EdgeList::const_iterator, AssertionIndex::EdgeList::const_iterator>
+AssertionIndex::getRange(const EdgeList& edges, Id property)
+{
+    Edge first = { property, 0 };
+    Edge last = { property, INVALID_ID };
+    return std::make_pair(std::lower_bound(edges.begin(), edges.end(), first),
+            std::upper_bound(edges.begin(), edges.end(), last));
+}
+
+void AssertionIndex::insert(EdgeList& edges, const Edge& edge)
+{
+    edges.insert(std::upper_bound(edges.begin(), edges.end(), edge), edge);
+}
+
+bool AssertionIndex::erase(EdgeList& edges, const Edge& edge)
+{
+    EdgeList::iterator it = std::lower_bound(edges.begin(), edges.end(), edge);
+    if(it == edges.end() || !(*it == edge))
+    {
+        return false;
+    }
+    edges.erase(it);
+    return true;
+}
+
+void AssertionIndex::addRelation(const IRI& subject, const IRI& property, const IRI& object)
+{
+    Id subjectId = getOrCreateIndividualId(subject);
+    Id objectId = getOrCreateIndividualId(object);
+    Id propertyId = getOrCreatePropertyId(property);
+
+    Edge outgoing = { propertyId, objectId };
+    insert(mOutgoing[subjectId], outgoing);
+    Edge incoming = { propertyId, subjectId };
+    insert(mIncoming[objectId], incoming);
+    ++mNumberOfRelations;
+}
+
+bool AssertionIndex::removeRelation(const IRI& subject, const IRI& property, const IRI& object)
+{
+    Id subjectId = getIndividualId(subject);
+    Id objectId = getIndividualId(object);
+    Id propertyId = getPropertyId(property);
+    if(subjectId == INVALID_ID || objectId == INVALID_ID || propertyId == INVALID_ID)
+    {
+        return false;
+    }
+
+    Edge outgoing = { propertyId, objectId };
+    if(!erase(mOutgoing[subjectId], outgoing))
+    {
+        return false;
+    }
+    Edge incoming = { propertyId, subjectId };
+    erase(mIncoming[objectId], incoming);
+    --mNumberOfRelations;
+    return true;
+}
+
+void AssertionIndex::addValue(const IRI& subject, const IRI& property, const OWLLiteral::Ptr& value)
+{
+    Id subjectId = getOrCreateIndividualId(subject);
+    Id propertyId = getOrCreatePropertyId(property);
+
+    ValueList& values = mValues[subjectId];
+    ValueList::iterator it = std::upper_bound(values.begin(), values.end(), propertyId,
+            [](Id id, const ValueList::value_type& entry) { return id < entry.first; });
+    values.insert(it, std::make_pair(propertyId, value));
+    ++mNumberOfValues;
+}
+
+bool AssertionIndex::removeValue(const IRI& subject, const IRI& property, const OWLLiteral::Ptr& value)
+{
+    Id subjectId = getIndividualId(subject);
+    Id propertyId = getPropertyId(property);
+    if(subjectId == INVALID_ID || propertyId == INVALID_ID)
+    {
+        return false;
+    }
+
+    ValueList& values = mValues[subjectId];
+    ValueList::iterator it = std::find(values.begin(), values.end(), std::make_pair(propertyId, value));
+    if(it == values.end())
+    {
+        return false;
+    }
+    values.erase(it);
+    --mNumberOfValues;
+    return true;
+}
+
+bool AssertionIndex::isRelatedTo(const IRI& subject, const IRI& property, const IRI& object) const
+{
+    Id subjectId = getIndividualId(subject);
+    Id objectId = getIndividualId(object);
+    Id propertyId = getPropertyId(property);
+    if(subjectId == INVALID_ID || objectId == INVALID_ID || propertyId == INVALID_ID)
+    {
+        return false;
+    }
+
+    Edge edge = { propertyId, objectId };
+    return std::binary_search(mOutgoing[subjectId].begin(), mOutgoing[subjectId].end(), edge);
+}
+
+IRIList AssertionIndex::getIndividuals(const std::vector<EdgeList>& adjacency, const IRI& individual, const IRI& property) const
+{
+    IRIList individuals;
+    Id individualId = getIndividualId(individual);
+    Id propertyId = getPropertyId(property);
+    if(individualId == INVALID_ID || propertyId == INVALID_ID)
+    {
+        return individuals;
+    }
+
+    std::pair<EdgeList::const_iterator, EdgeList::const_iterator> range = getRange(adjacency[individualId], propertyId);
+    for(EdgeList::const_iterator cit = range.first; cit != range.second; ++cit)
+    {
+        // skip duplicate assertions, which are adjacent
+        if(cit == range.first || !(*cit == *(cit - 1)))
+        {
+            individuals.push_back(mIndividuals[cit->individual]);
+        }
+    }
+    return individuals;
+}
+
+IRIList AssertionIndex::getRelatedIndividuals(const IRI& subject, const IRI& property) const
+{
+    return getIndividuals(mOutgoing, subject, property);
+}
+
+IRIList AssertionIndex::getInverseRelatedIndividuals(const IRI& object, const IRI& property) const
+{
+    return getIndividuals(mIncoming, object, property);
+}
+
+IRISet AssertionIndex::getObjectProperties(const IRI& individual, bool incoming) const
+{
+    IRISet properties;
+    Id individualId = getIndividualId(individual);
+    if(individualId == INVALID_ID)
+    {
+        return properties;
+    }
+
+    for(const Edge& edge : mOutgoing[individualId])
+    {
+        properties.insert(mProperties[edge.property]);
+    }
+    if(incoming)
+    {
+        for(const Edge& edge : mIncoming[individualId])
+        {
+            properties.insert(mProperties[edge.property]);
+        }
+    }
+    return properties;
+}
+
+IRISet AssertionIndex::getDataProperties(const IRI& individual) const
+{
+    IRISet properties;
+    Id individualId = getIndividualId(individual);
+    if(individualId == INVALID_ID)
+    {
+        return properties;
+    }
+
+    for(const ValueList::value_type& value : mValues[individualId])
+    {
+        properties.insert(mProperties[value.first]);
+    }
+    return properties;
+}
+
+OWLLiteral::PtrList AssertionIndex::getValues(const IRI& individual, const IRI& property) const
+{
+    OWLLiteral::PtrList literals;
+    Id individualId = getIndividualId(individual);
+    Id propertyId = getPropertyId(property);
+    if(individualId == INVALID_ID || propertyId == INVALID_ID)
+    {
+        return literals;
+    }
+
+    const ValueList& values = mValues[individualId];
+    ValueList::const_iterator cit = std::lower_bound(values.begin(), values.end(), propertyId,
+            [](const ValueList::value_type& entry, Id id) { return entry.first < id; });
+    for(; cit != values.end() && cit->first == propertyId; ++cit)
+    {
+        literals.push_back(cit->second);
+    }
+    return literals;
+}
+
+uint64_t AssertionIndex::getMemoryUsage() const
+{
+    return memory::heapBytes(mIndividualIds) + memory::heapBytes(mIndividuals)
+        + memory::heapBytes(mPropertyIds) + memory::heapBytes(mProperties)
+        + memory::heapBytes(mOutgoing) + memory::heapBytes(mIncoming)
+        + memory::heapBytes(mValues);
+}
+
+} // end namespace model
+} // end namespace owlapi
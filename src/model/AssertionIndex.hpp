@@ -0,0 +1,168 @@
+#ifndef OWLAPI_MODEL_ASSERTION_INDEX_HPP
+#define OWLAPI_MODEL_ASSERTION_INDEX_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "IRI.hpp"
+#include "OWLLiteral.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class AssertionIndex
+ * \brief Adjacency index over the told object and data property assertions
+ * of individuals
+ * \details Individuals and properties are mapped to dense ids. Each
+ * individual has an array of outgoing and an array of incoming edges, which
+ * are kept sorted by (property, individual), so that the relations of an
+ * individual via a property form a contiguous range which is found by
+ * binary search. Data property values are stored per individual sorted by
+ * property.
+ *
+ * The index contains asserted facts only, i.e. no inferred relations, and
+ * it keeps one edge per assertion, so that removing one of two identical
+ * assertions keeps the relation.
+ */
+class AssertionIndex
+{
+public:
+    typedef uint32_t Id;
+
+    AssertionIndex();
+
+    /**
+     * Clear the index
+     */
+    void clear();
+
+    /**
+     * Add an object property assertion
+     */
+    void addRelation(const IRI& subject, const IRI& property, const IRI& object);
+
+    /**
+     * Remove an object property assertion
+     * \return true if the assertion has been removed, false if it is not
+     * part of the index
+     */
+    bool removeRelation(const IRI& subject, const IRI& property, const IRI& object);
+
+    /**
+     * Add a data property assertion
+     */
+    void addValue(const IRI& subject, const IRI& property, const OWLLiteral::Ptr& value);
+
+    /**
+     * Remove a data property assertion
+     * \return true if the assertion has been removed, false if it is not
+     * part of the index
+     */
+    bool removeValue(const IRI& subject, const IRI& property, const OWLLiteral::Ptr& value);
+
+    /**
+     * Test if the relation has been asserted
+     */
+    bool isRelatedTo(const IRI& subject, const IRI& property, const IRI& object) const;
+
+    /**
+     * Get all individuals the subject is related to via the property
+     */
+    IRIList getRelatedIndividuals(const IRI& subject, const IRI& property) const;
+
+    /**
+     * Get all individuals which are related to the object via the property
+     */
+    IRIList getInverseRelatedIndividuals(const IRI& object, const IRI& property) const;
+
+    /**
+     * Get the object properties of all asserted relations of an individual
+     * \param incoming If true, the properties of relations where the
+     * individual is the object are included
+     */
+    IRISet getObjectProperties(const IRI& individual, bool incoming = false) const;
+
+    /**
+     * Get the data properties of all asserted values of an individual
+     */
+    IRISet getDataProperties(const IRI& individual) const;
+
+    /**
+     * Get the asserted values of an individual for a data property
+     */
+    OWLLiteral::PtrList getValues(const IRI& individual, const IRI& property) const;
+
+    /**
+     * Get the number of asserted relations
+     */
+    size_t getNumberOfRelations() const { return mNumberOfRelations; }
+
+    /**
+     * Get the number of asserted values
+     */
+    size_t getNumberOfValues() const { return mNumberOfValues; }
+
+    /**
+     * Get the estimated heap memory of the index
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    /// Relation to another individual via a property, or a value of a
+    /// property
+    struct Edge
+    {
+        Id property;
+        Id individual;
+
+        bool operator<(const Edge& other) const
+        {
+            return property < other.property ||
+                (property == other.property && individual < other.individual);
+        }
+
+        bool operator==(const Edge& other) const
+        {
+            return property == other.property && individual == other.individual;
+        }
+    };
+
+    typedef std::vector<Edge> EdgeList;
+    typedef std::vector< std::pair<Id, OWLLiteral::Ptr> > ValueList;
+
+    static const Id INVALID_ID = 0xFFFFFFFF;
+
+    Id getOrCreateIndividualId(const IRI& individual);
+    Id getOrCreatePropertyId(const IRI& property);
+
+    Id getIndividualId(const IRI& individual) const;
+    Id getPropertyId(const IRI& property) const;
+
+    /**
+     * Get the range of edges via the given property
+     */
+    static std::pair<EdgeList::const_iterator, EdgeList::const_iterator> getRange(const EdgeList& edges, Id property);
+
+    static void insert(EdgeList& edges, const Edge& edge);
+    static bool erase(EdgeList& edges, const Edge& edge);
+
+    IRIList getIndividuals(const std::vector<EdgeList>& adjacency, const IRI& individual, const IRI& property) const;
+
+    std::unordered_map<IRI, Id> mIndividualIds;
+    IRIList mIndividuals;
+    std::unordered_map<IRI, Id> mPropertyIds;
+    IRIList mProperties;
+
+    std::vector<EdgeList> mOutgoing;
+    std::vector<EdgeList> mIncoming;
+    std::vector<ValueList> mValues;
+
+    size_t mNumberOfRelations;
+    size_t mNumberOfValues;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_ASSERTION_INDEX_HPP
@@ -0,0 +1,527 @@
+#include "DataRangeValidator.hpp"
+#include <stdint.h>
+#include <limits>
+#include <regex>
+#include <stdexcept>
+#include <unordered_set>
+#include <base-logging/Logging.hpp>
+#include "../Vocabulary.hpp"
+#include "LiteralValue.hpp"
+#include "OWLDataOneOf.hpp"
+#include "OWLDataTypeRestriction.hpp"
+
+namespace owlapi {
+namespace model {
+
+namespace {
+
+/**
+ * Parse the complete string as number
+ * \return true upon success, false otherwise
+ */
+bool parseNumber(const std::string& value, double& number)
+{
+    return LiteralValue::parse(value.data(), value.data() + value.size(), number);
+}
+
+/**
+ * Parse the complete string as xsd:dateTime
+ * \param number microseconds since the epoch, which are represented exactly
+ * by a double for all years up to 2255
+ * \return true upon success, false otherwise
+ */
+bool parseDateTime(const std::string& value, double& number)
+{
+    int64_t dateTime;
+    if(LiteralValue::parseDateTime(value.data(), value.data() + value.size(), dateTime))
+    {
+        number = static_cast<double>(dateTime);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Parse the complete string as integer
+ * \return true upon success, false otherwise
+ */
+bool parseInteger(const std::string& value, long long& number)
+{
+    int64_t integer;
+    if(LiteralValue::parse(value.data(), value.data() + value.size(), integer))
+    {
+        number = integer;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Validate the lexical form of (numeric and boolean) datatypes, all other
+ * datatypes accept any value
+ */
+class DatatypeValidator : public DataRangeValidator
+{
+public:
+    enum Kind { ANY, BOOLEAN, INTEGER, NON_NEGATIVE_INTEGER, NUMERIC };
+
+    DatatypeValidator(const OWLDataType& dataType)
+        : mKind(ANY)
+    {
+        if(dataType.getIRI() == vocabulary::XSD::nonNegativeInteger())
+        {
+            mKind = NON_NEGATIVE_INTEGER;
+        } else if(dataType.isInteger())
+        {
+            mKind = INTEGER;
+        } else if(dataType.isDouble() || dataType.isFloat())
+        {
+            mKind = NUMERIC;
+        } else if(dataType.isBoolean())
+        {
+            mKind = BOOLEAN;
+        }
+    }
+
+    bool isNumeric() const { return mKind == INTEGER || mKind == NON_NEGATIVE_INTEGER || mKind == NUMERIC; }
+
+    bool isValid(const std::string& value) const override
+    {
+        switch(mKind)
+        {
+            case ANY:
+                return true;
+            case BOOLEAN:
+                return value == "true" || value == "false" || value == "1" || value == "0";
+            case INTEGER:
+            case NON_NEGATIVE_INTEGER:
+            {
+                long long number;
+                return parseInteger(value, number) && (mKind == INTEGER || number >= 0);
+            }
+            case NUMERIC:
+            {
+                double number;
+                return parseNumber(value, number);
+            }
+        }
+        return true;
+    }
+
+    void validate(const std::vector<std::string>& values, std::vector<bool>& valid) const override
+    {
+        if(mKind != ANY)
+        {
+            DataRangeValidator::validate(values, valid);
+        }
+    }
+
+private:
+    Kind mKind;
+};
+
+/**
+ * Validate against the hashed values of an OWLDataOneOf
+ */
+class OneOfValidator : public DataRangeValidator
+{
+public:
+    OneOfValidator(const OWLDataOneOf& oneOf)
+    {
+        for(const OWLLiteral::Ptr& literal : oneOf.getLiterals())
+        {
+            mValues.insert(literal->getValue());
+        }
+    }
+
+    bool isValid(const std::string& value) const override
+    {
+        return mValues.count(value);
+    }
+
+private:
+    std::unordered_set<std::string> mValues;
+};
+
+/**
+ * Validate against the facets of an OWLDataTypeRestriction
+ * \details Bounds are either numbers or xsd:dateTime values, which are
+ * compared as microseconds since the epoch
+ */
+class FacetValidator : public DataRangeValidator
+{
+public:
+    FacetValidator(const OWLDataTypeRestriction& restriction)
+        : mDatatype(restriction.getDataType())
+        , mHasBounds(false)
+        , mDateTimeBounds(false)
+        , mMin(-std::numeric_limits<double>::infinity())
+        , mMinExclusive(false)
+        , mMax(std::numeric_limits<double>::infinity())
+        , mMaxExclusive(false)
+        , mMinLength(0)
+        , mMaxLength(std::numeric_limits<size_t>::max())
+    {
+        for(const OWLFacetRestriction& facetRestriction : restriction.getFacetRestrictions())
+        {
+            OWLFacet::FacetType type = facetRestriction.getFacet().getFacetType();
+            std::string facetValue = facetRestriction.getFacetValue()->getValue();
+            switch(type)
+            {
+                case OWLFacet::LENGTH:
+                    mMinLength = mMaxLength = getFacetNumber(facetValue);
+                    break;
+                case OWLFacet::MIN_LENGTH:
+                    mMinLength = getFacetNumber(facetValue);
+                    break;
+                case OWLFacet::MAX_LENGTH:
+                    mMaxLength = getFacetNumber(facetValue);
+                    break;
+                case OWLFacet::PATTERN:
+                    mPatterns.push_back(std::regex(facetValue));
+                    break;
+                case OWLFacet::MIN_INCLUSIVE:
+                case OWLFacet::MIN_EXCLUSIVE:
+                    if(setBound(facetValue, mMin))
+                    {
+                        mMinExclusive = type == OWLFacet::MIN_EXCLUSIVE;
+                    }
+                    break;
+                case OWLFacet::MAX_INCLUSIVE:
+                case OWLFacet::MAX_EXCLUSIVE:
+                    if(setBound(facetValue, mMax))
+                    {
+                        mMaxExclusive = type == OWLFacet::MAX_EXCLUSIVE;
+                    }
+                    break;
+                default:
+                    LOG_WARN_S << "Checking compliance of type: " << type
+                        << " is currently no supported";
+                    break;
+            }
+        }
+    }
+
+    bool isValid(const std::string& value) const override
+    {
+        if(!isValidLexically(value))
+        {
+            return false;
+        }
+
+        if(mHasBounds)
+        {
+            double number;
+            return parseBound(value, number) && isInBounds(number);
+        }
+        return true;
+    }
+
+    void validate(const std::vector<std::string>& values, std::vector<bool>& valid) const override
+    {
+        if(valid.size() != values.size())
+        {
+            valid.assign(values.size(), true);
+        }
+
+        if(!mHasBounds)
+        {
+            for(size_t i = 0; i < values.size(); ++i)
+            {
+                if(valid[i] && !isValidLexically(values[i]))
+                {
+                    valid[i] = false;
+                }
+            }
+            return;
+        }
+
+        // Parse all values first, so that the bounds can be checked in a
+        // tight (vectorizable) loop
+        std::vector<double> numbers(values.size());
+        std::vector<uint8_t> flags(values.size());
+        for(size_t i = 0; i < values.size(); ++i)
+        {
+            flags[i] = valid[i] && isValidLexically(values[i]) && parseBound(values[i], numbers[i]);
+        }
+
+        const double min = mMin;
+        const double max = mMax;
+        const uint8_t minInclusive = !mMinExclusive;
+        const uint8_t maxInclusive = !mMaxExclusive;
+        for(size_t i = 0; i < numbers.size(); ++i)
+        {
+            const double number = numbers[i];
+            uint8_t aboveMin = (number > min) | (minInclusive & (number == min));
+            uint8_t belowMax = (number < max) | (maxInclusive & (number == max));
+            flags[i] &= aboveMin & belowMax;
+        }
+
+        for(size_t i = 0; i < flags.size(); ++i)
+        {
+            valid[i] = flags[i];
+        }
+    }
+
+private:
+    static double getFacetNumber(const std::string& facetValue)
+    {
+        double number;
+        if(!parseNumber(facetValue, number))
+        {
+            throw std::invalid_argument("owlapi::model::DataRangeValidator: facet value '"
+                    + facetValue + "' is not a number");
+        }
+        return number;
+    }
+
+    /**
+     * Set a bound from a facet value, the first bound decides whether
+     * bounds are numbers or dateTime values
+     * \return false if the facet value is neither, or does not match the
+     * kind of the other bound, so that the facet is ignored
+     */
+    bool setBound(const std::string& facetValue, double& bound)
+    {
+        double number;
+        bool dateTime = false;
+        if(!parseNumber(facetValue, number))
+        {
+            if(!parseDateTime(facetValue, number))
+            {
+                LOG_WARN_S << "Bound '" << facetValue << "' is neither a number nor a dateTime"
+                    << " -- facet is ignored";
+                return false;
+            }
+            dateTime = true;
+        }
+
+        if(mHasBounds && dateTime != mDateTimeBounds)
+        {
+            LOG_WARN_S << "Bound '" << facetValue << "' does not match the kind of the other bound"
+                << " -- facet is ignored";
+            return false;
+        }
+        mHasBounds = true;
+        mDateTimeBounds = dateTime;
+        bound = number;
+        return true;
+    }
+
+    bool parseBound(const std::string& value, double& number) const
+    {
+        return mDateTimeBounds ? parseDateTime(value, number) : parseNumber(value, number);
+    }
+
+    bool isValidLexically(const std::string& value) const
+    {
+        if(value.size() < mMinLength || value.size() > mMaxLength)
+        {
+            return false;
+        }
+        for(const std::regex& pattern : mPatterns)
+        {
+            if(!std::regex_match(value, pattern))
+            {
+                return false;
+            }
+        }
+        return mDatatype.isValid(value);
+    }
+
+    bool isInBounds(double number) const
+    {
+        bool aboveMin = mMinExclusive ? number > mMin : number >= mMin;
+        bool belowMax = mMaxExclusive ? number < mMax : number <= mMax;
+        return aboveMin && belowMax;
+    }
+
+    DatatypeValidator mDatatype;
+    bool mHasBounds;
+    bool mDateTimeBounds;
+    double mMin;
+    bool mMinExclusive;
+    double mMax;
+    bool mMaxExclusive;
+    size_t mMinLength;
+    size_t mMaxLength;
+    std::vector<std::regex> mPatterns;
+};
+
+class AllOfValidator : public DataRangeValidator
+{
+public:
+    AllOfValidator(const DataRangeValidator::PtrList& validators)
+        : mValidators(validators)
+    {}
+
+    bool isValid(const std::string& value) const override
+    {
+        for(const DataRangeValidator::Ptr& validator : mValidators)
+        {
+            if(!validator->isValid(value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void validate(const std::vector<std::string>& values, std::vector<bool>& valid) const override
+    {
+        if(valid.size() != values.size())
+        {
+            valid.assign(values.size(), true);
+        }
+        for(const DataRangeValidator::Ptr& validator : mValidators)
+        {
+            validator->validate(values, valid);
+        }
+    }
+
+private:
+    DataRangeValidator::PtrList mValidators;
+};
+
+class AnyOfValidator : public DataRangeValidator
+{
+public:
+    AnyOfValidator(const DataRangeValidator::PtrList& validators)
+        : mValidators(validators)
+    {}
+
+    bool isValid(const std::string& value) const override
+    {
+        for(const DataRangeValidator::Ptr& validator : mValidators)
+        {
+            if(validator->isValid(value))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void validate(const std::vector<std::string>& values, std::vector<bool>& valid) const override
+    {
+        if(valid.size() != values.size())
+        {
+            valid.assign(values.size(), true);
+        }
+
+        std::vector<bool> anyValid(values.size(), false);
+        std::vector<bool> validatorValid;
+        for(const DataRangeValidator::Ptr& validator : mValidators)
+        {
+            validatorValid = valid;
+            validator->validate(values, validatorValid);
+            for(size_t i = 0; i < values.size(); ++i)
+            {
+                if(validatorValid[i])
+                {
+                    anyValid[i] = true;
+                }
+            }
+        }
+        valid.swap(anyValid);
+    }
+
+private:
+    DataRangeValidator::PtrList mValidators;
+};
+
+} // end anonymous namespace
+
+std::vector<bool> DataRangeValidator::validate(const std::vector<std::string>& values) const
+{
+    std::vector<bool> valid(values.size(), true);
+    validate(values, valid);
+    return valid;
+}
+
+void DataRangeValidator::validate(const std::vector<std::string>& values, std::vector<bool>& valid) const
+{
+    if(valid.size() != values.size())
+    {
+        valid.assign(values.size(), true);
+    }
+
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        if(valid[i] && !isValid(values[i]))
+        {
+            valid[i] = false;
+        }
+    }
+}
+
+DataRangeValidator::Ptr DataRangeValidator::compile(const OWLDataRange::Ptr& range)
+{
+    switch(range->getDataRangeType())
+    {
+        case OWLDataRange::DATATYPE:
+        {
+            OWLDataType::Ptr dataType = dynamic_pointer_cast<OWLDataType>(range);
+            if(dataType)
+            {
+                return make_shared<DatatypeValidator>(*dataType);
+            }
+            break;
+        }
+        case OWLDataRange::DATA_ONE_OF:
+        {
+            OWLDataOneOf::Ptr oneOf = dynamic_pointer_cast<OWLDataOneOf>(range);
+            if(oneOf)
+            {
+                return make_shared<OneOfValidator>(*oneOf);
+            }
+            break;
+        }
+        case OWLDataRange::DATATYPE_RESTRICTION:
+        {
+            OWLDataTypeRestriction::Ptr restriction = dynamic_pointer_cast<OWLDataTypeRestriction>(range);
+            if(restriction)
+            {
+                return make_shared<FacetValidator>(*restriction);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    throw std::invalid_argument("owlapi::model::DataRangeValidator::compile: data range '"
+            + OWLDataRange::TypeTxt[range->getDataRangeType()] + "' is not supported");
+}
+
+DataRangeValidator::Ptr DataRangeValidator::compile(const OWLDataRange::PtrList& ranges)
+{
+    if(ranges.empty())
+    {
+        // unrestricted
+        return allOf(PtrList());
+    } else if(ranges.size() == 1)
+    {
+        return compile(ranges.front());
+    }
+
+    PtrList validators;
+    for(const OWLDataRange::Ptr& range : ranges)
+    {
+        validators.push_back( compile(range) );
+    }
+    return anyOf(validators);
+}
+
+DataRangeValidator::Ptr DataRangeValidator::anyOf(const PtrList& validators)
+{
+    return make_shared<AnyOfValidator>(validators);
+}
+
+DataRangeValidator::Ptr DataRangeValidator::allOf(const PtrList& validators)
+{
+    return make_shared<AllOfValidator>(validators);
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,78 @@
+#ifndef OWLAPI_MODEL_DATA_RANGE_VALIDATOR_HPP
+#define OWLAPI_MODEL_DATA_RANGE_VALIDATOR_HPP
+
+#include <string>
+#include <vector>
+#include "OWLDataRange.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class DataRangeValidator
+ * \brief Compiled form of a data range to validate literal values
+ * \details Compilation pre-parses numeric facet values, hashes the values of
+ * an OWLDataOneOf and precompiles patterns, so that checking a value does not
+ * need to inspect the data range again. Use validate to check a whole
+ * column of values in one call.
+ * \verbatim
+   DataRangeValidator::Ptr validator = DataRangeValidator::compile(ranges);
+   std::vector<bool> valid = validator->validate(values);
+   \endverbatim
+ */
+class DataRangeValidator
+{
+public:
+    typedef shared_ptr<DataRangeValidator> Ptr;
+    typedef std::vector<Ptr> PtrList;
+
+    virtual ~DataRangeValidator() = default;
+
+    /**
+     * Check if a value lies in the data range
+     * \param value Lexical form of the value
+     */
+    virtual bool isValid(const std::string& value) const = 0;
+
+    /**
+     * Check a list of values
+     * \param values Lexical forms of the values
+     * \return flag per value, true if the value lies in the data range
+     */
+    std::vector<bool> validate(const std::vector<std::string>& values) const;
+
+    /**
+     * Check a list of values
+     * \param values Lexical forms of the values
+     * \param valid Flag per value, which is set to false for a value outside
+     * of the data range (flags which are already false remain false)
+     */
+    virtual void validate(const std::vector<std::string>& values, std::vector<bool>& valid) const;
+
+    /**
+     * Compile a data range
+     * \throw std::invalid_argument if the type of data range is not supported
+     */
+    static Ptr compile(const OWLDataRange::Ptr& range);
+
+    /**
+     * Compile the data ranges of a data property, a value is valid if it lies
+     * in any of the data ranges (or if there is no data range)
+     * \throw std::invalid_argument if the type of a data range is not supported
+     */
+    static Ptr compile(const OWLDataRange::PtrList& ranges);
+
+    /**
+     * Create a validator which accepts values that are accepted by any of the given validators
+     */
+    static Ptr anyOf(const PtrList& validators);
+
+    /**
+     * Create a validator which accepts values that are accepted by all of the given validators
+     */
+    static Ptr allOf(const PtrList& validators);
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_DATA_RANGE_VALIDATOR_HPP
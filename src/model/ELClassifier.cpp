@@ -0,0 +1,1396 @@
+#include "ELClassifier.hpp"
+#include "MemoryUsage.hpp"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+#include <base-logging/Logging.hpp>
+#include "OWL2ELProfile.hpp"
+#include "OWLOntologyAsk.hpp"
+#include "OWLAnnotation.hpp"
+#include "OWLClass.hpp"
+#include "OWLProperty.hpp"
+#include "OWLLiteral.hpp"
+#include "OWLDataType.hpp"
+#include "OWLDataOneOf.hpp"
+#include "OWLDataHasValue.hpp"
+#include "OWLObjectIntersectionOf.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLQuantifiedDataRestriction.hpp"
+#include "OWLDeclarationAxiom.hpp"
+#include "OWLSubClassOfAxiom.hpp"
+#include "OWLEquivalentClassesAxiom.hpp"
+#include "OWLDisjointClassesAxiom.hpp"
+#include "OWLObjectPropertyDomainAxiom.hpp"
+#include "OWLDataPropertyDomainAxiom.hpp"
+#include "OWLDataPropertyRangeAxiom.hpp"
+#include "OWLTransitiveObjectPropertyAxiom.hpp"
+#include "../KnowledgeBase.hpp"
+#include "../vocabularies/OWL.hpp"
+#include "../vocabularies/RDF.hpp"
+#include "../vocabularies/RDFS.hpp"
+#include "../vocabularies/XSD.hpp"
+
+namespace owlapi {
+namespace model {
+
+namespace {
+
+typedef uint32_t ConceptId;
+typedef uint32_t RoleId;
+
+const ConceptId TOP = 0;
+const ConceptId BOTTOM = 1;
+
+/**
+ * Normalized form of the class and property axioms
+ */
+struct NormalizedTBox
+{
+    typedef std::vector< std::pair<ConceptId, ConceptId> > ConceptPairs;
+    typedef std::vector< std::pair<RoleId, ConceptId> > RoleConceptPairs;
+
+    /// IRIs of named classes, empty for fresh concepts
+    IRIList names;
+    /// A -> B for A ⊑ B
+    std::vector< std::vector<ConceptId> > toldSubsumers;
+    /// A -> (B, C) for A ⊓ B ⊑ C
+    std::vector<ConceptPairs> conjunctions;
+    /// A -> (r, B) for A ⊑ ∃r.B
+    std::vector<RoleConceptPairs> existentials;
+    /// B -> (r, A) for ∃r.B ⊑ A
+    std::vector<RoleConceptPairs> negativeExistentials;
+    /// Sorted super roles of each role, including the role itself
+    std::vector< std::vector<RoleId> > superRoles;
+    /// Transitive super roles of each role
+    std::vector< std::vector<RoleId> > transitiveSuperRoles;
+
+    size_t size() const { return names.size(); }
+
+    bool isSubRoleOf(RoleId role, RoleId superRole) const
+    {
+        const std::vector<RoleId>& roles = superRoles[role];
+        return std::binary_search(roles.begin(), roles.end(), superRole);
+    }
+};
+
+/**
+ * Get the smallest datatype of the EL datatype map whose value space
+ * contains the value space of the given datatype
+ * \return empty IRI for datatypes which are only contained in rdfs:Literal
+ */
+IRI getSuperDatatype(const IRI& datatype)
+{
+    static const std::unordered_map<IRI, IRI> superDatatypes = {
+        { vocabulary::XSD::nonNegativeInteger(), vocabulary::XSD::integer() },
+        { vocabulary::XSD::integer(), vocabulary::XSD::decimal() },
+        { vocabulary::XSD::decimal(), vocabulary::OWL::rational() },
+        { vocabulary::OWL::rational(), vocabulary::OWL::real() },
+        { vocabulary::XSD::NCName(), vocabulary::XSD::Name() },
+        { vocabulary::XSD::Name(), vocabulary::XSD::token() },
+        { vocabulary::XSD::NMTOKEN(), vocabulary::XSD::token() },
+        { vocabulary::XSD::token(), vocabulary::XSD::normalizedString() },
+        { vocabulary::XSD::normalizedString(), vocabulary::XSD::string() },
+        { vocabulary::XSD::string(), vocabulary::RDF::PlainLiteral() },
+        { vocabulary::XSD::dateTimeStamp(), vocabulary::XSD::dateTime() }
+    };
+    std::unordered_map<IRI, IRI>::const_iterator cit = superDatatypes.find(datatype);
+    return cit == superDatatypes.end() ? IRI() : cit->second;
+}
+
+/**
+ * Get the datatypes of the EL datatype map whose value spaces are pairwise
+ * disjoint and together contain all values
+ */
+bool isRootDatatype(const IRI& datatype)
+{
+    return getSuperDatatype(datatype).empty() && datatype != vocabulary::RDFS::Literal();
+}
+
+/**
+ * Replace tabs and line breaks by spaces (whiteSpace facet 'replace') and
+ * optionally collapse sequences of spaces (whiteSpace facet 'collapse')
+ */
+std::string normalizeWhiteSpace(const std::string& lexicalForm, bool collapse)
+{
+    std::string value;
+    for(char c : lexicalForm)
+    {
+        if(c == '\t' || c == '\n' || c == '\r')
+        {
+            c = ' ';
+        }
+        if(collapse && c == ' ' && (value.empty() || value.back() == ' '))
+        {
+            continue;
+        }
+        value.push_back(c);
+    }
+    if(collapse && !value.empty() && value.back() == ' ')
+    {
+        value.pop_back();
+    }
+    return value;
+}
+
+/**
+ * Decode the code points of an UTF-8 string
+ * \return false if the string is not valid UTF-8
+ */
+bool decodeUTF8(const std::string& value, std::vector<uint32_t>& codePoints)
+{
+    for(size_t i = 0; i < value.size();)
+    {
+        unsigned char c = value[i];
+        size_t length = c < 0x80 ? 1 : (c >> 5) == 0x06 ? 2 : (c >> 4) == 0x0E ? 3 : (c >> 3) == 0x1E ? 4 : 0;
+        if(length == 0 || i + length > value.size())
+        {
+            return false;
+        }
+        uint32_t codePoint = length == 1 ? c : c & (0xFF >> (length + 1));
+        for(size_t j = 1; j < length; ++j)
+        {
+            unsigned char next = value[i + j];
+            if((next >> 6) != 0x02)
+            {
+                return false;
+            }
+            codePoint = (codePoint << 6) | (next & 0x3F);
+        }
+        codePoints.push_back(codePoint);
+        i += length;
+    }
+    return true;
+}
+
+bool isDigit(uint32_t c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * \see https://www.w3.org/TR/xml/#NT-NameStartChar
+ */
+bool isNameStartChar(uint32_t c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_' || c == ':'
+        || (c >= 0xC0 && c <= 0xD6) || (c >= 0xD8 && c <= 0xF6) || (c >= 0xF8 && c <= 0x2FF)
+        || (c >= 0x370 && c <= 0x37D) || (c >= 0x37F && c <= 0x1FFF) || (c >= 0x200C && c <= 0x200D)
+        || (c >= 0x2070 && c <= 0x218F) || (c >= 0x2C00 && c <= 0x2FEF) || (c >= 0x3001 && c <= 0xD7FF)
+        || (c >= 0xF900 && c <= 0xFDCF) || (c >= 0xFDF0 && c <= 0xFFFD) || (c >= 0x10000 && c <= 0xEFFFF);
+}
+
+/**
+ * \see https://www.w3.org/TR/xml/#NT-NameChar
+ */
+bool isNameChar(uint32_t c)
+{
+    return isNameStartChar(c) || c == '-' || c == '.' || isDigit(c) || c == 0xB7
+        || (c >= 0x300 && c <= 0x36F) || (c >= 0x203F && c <= 0x2040);
+}
+
+/**
+ * Get the most specific string datatypes which contain a string value
+ * \return false if the value is not a valid string
+ */
+bool getStringDatatypes(const std::string& value, IRIList& datatypes)
+{
+    std::vector<uint32_t> codePoints;
+    if(!decodeUTF8(value, codePoints))
+    {
+        return false;
+    }
+
+    if(value.find_first_of("\t\n\r") != std::string::npos)
+    {
+        datatypes.push_back(vocabulary::XSD::string());
+        return true;
+    } else if(normalizeWhiteSpace(value, true) != value)
+    {
+        datatypes.push_back(vocabulary::XSD::normalizedString());
+        return true;
+    }
+
+    bool nmtoken = !codePoints.empty() && std::all_of(codePoints.begin(), codePoints.end(), isNameChar);
+    bool name = nmtoken && isNameStartChar(codePoints.front());
+    if(name)
+    {
+        datatypes.push_back(value.find(':') == std::string::npos ? vocabulary::XSD::NCName() : vocabulary::XSD::Name());
+    }
+    if(nmtoken)
+    {
+        datatypes.push_back(vocabulary::XSD::NMTOKEN());
+    } else {
+        datatypes.push_back(vocabulary::XSD::token());
+    }
+    return true;
+}
+
+/**
+ * Get the canonical form of a decimal or integer lexical form, i.e.
+ * without leading and trailing zeros and without the sign of zero
+ * \return false if the lexical form is invalid
+ */
+bool canonicalizeDecimal(const std::string& lexicalForm, bool integral, std::string& canonical)
+{
+    std::string value = normalizeWhiteSpace(lexicalForm, true);
+    size_t pos = 0;
+    bool negative = false;
+    if(pos < value.size() && (value[pos] == '+' || value[pos] == '-'))
+    {
+        negative = value[pos++] == '-';
+    }
+
+    std::string integer;
+    std::string fraction;
+    size_t digits = 0;
+    for(; pos < value.size() && isDigit(value[pos]); ++pos, ++digits)
+    {
+        if(!integer.empty() || value[pos] != '0')
+        {
+            integer.push_back(value[pos]);
+        }
+    }
+    if(pos < value.size() && value[pos] == '.' && !integral)
+    {
+        for(++pos; pos < value.size() && isDigit(value[pos]); ++pos, ++digits)
+        {
+            fraction.push_back(value[pos]);
+        }
+        fraction.erase(fraction.find_last_not_of('0') + 1);
+    }
+    if(digits == 0 || pos != value.size())
+    {
+        return false;
+    }
+
+    canonical = integer.empty() ? "0" : integer;
+    if(!fraction.empty())
+    {
+        canonical += "." + fraction;
+    }
+    if(negative && canonical != "0")
+    {
+        canonical = "-" + canonical;
+    }
+    return true;
+}
+
+/**
+ * Identify the value of a literal and get the most specific datatypes of
+ * the EL datatype map which contain the value, so that literals with
+ * different lexical forms of the same value are identified by the same key
+ * \return false if the literal is invalid or its value cannot be compared
+ * exactly
+ */
+bool getLiteralValue(const OWLLiteral& literal, std::string& key, IRIList& datatypes)
+{
+    std::string lexicalForm = literal.getValue();
+    if(literal.isPlainLiteral())
+    {
+        key = "string:" + lexicalForm;
+        return getStringDatatypes(lexicalForm, datatypes);
+    }
+
+    IRI type(literal.getType());
+    if(type == vocabulary::XSD::decimal()
+            || type == vocabulary::XSD::integer()
+            || type == vocabulary::XSD::nonNegativeInteger())
+    {
+        std::string canonical;
+        if(!canonicalizeDecimal(lexicalForm, type != vocabulary::XSD::decimal(), canonical))
+        {
+            return false;
+        }
+        key = "number:" + canonical;
+        if(canonical.find('.') != std::string::npos)
+        {
+            datatypes.push_back(vocabulary::XSD::decimal());
+        } else if(canonical[0] == '-')
+        {
+            if(type == vocabulary::XSD::nonNegativeInteger())
+            {
+                return false;
+            }
+            datatypes.push_back(vocabulary::XSD::integer());
+        } else {
+            datatypes.push_back(vocabulary::XSD::nonNegativeInteger());
+        }
+        return true;
+    }
+
+    static const std::unordered_map<IRI, bool> stringTypes = {
+        { vocabulary::XSD::string(), false },
+        { vocabulary::XSD::normalizedString(), false },
+        { vocabulary::XSD::token(), true },
+        { vocabulary::XSD::Name(), true },
+        { vocabulary::XSD::NCName(), true },
+        { vocabulary::XSD::NMTOKEN(), true }
+    };
+    std::unordered_map<IRI, bool>::const_iterator cit = stringTypes.find(type);
+    if(cit != stringTypes.end())
+    {
+        std::string value = type == vocabulary::XSD::string() ? lexicalForm : normalizeWhiteSpace(lexicalForm, cit->second);
+        key = "string:" + value;
+        if(!getStringDatatypes(value, datatypes))
+        {
+            return false;
+        }
+        // the value has to lie in the datatype of the literal
+        for(const IRI& datatype : datatypes)
+        {
+            for(IRI superDatatype = datatype; !superDatatype.empty(); superDatatype = getSuperDatatype(superDatatype))
+            {
+                if(superDatatype == type)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    } else if(type == vocabulary::XSD::anyURI())
+    {
+        key = "anyURI:" + normalizeWhiteSpace(lexicalForm, true);
+        datatypes.push_back(type);
+        return true;
+    } else if(type == vocabulary::XSD::hexBinary())
+    {
+        std::string value = normalizeWhiteSpace(lexicalForm, true);
+        for(char& c : value)
+        {
+            if(!isDigit(c) && !((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))
+            {
+                return false;
+            }
+            c = toupper(c);
+        }
+        if(value.size() % 2 != 0)
+        {
+            return false;
+        }
+        key = "hexBinary:" + value;
+        datatypes.push_back(type);
+        return true;
+    }
+    // the values of the remaining datatypes, e.g. of xsd:dateTime with
+    // different time zones, are not identified
+    return false;
+}
+
+/**
+ * Translates the axioms of an ontology into a NormalizedTBox
+ */
+class Normalizer
+{
+public:
+    Normalizer(NormalizedTBox& tbox, const RDFSClosure& rdfs)
+        : mTBox(tbox)
+        , mRDFS(rdfs)
+    {
+        named(vocabulary::OWL::Thing());
+        named(vocabulary::OWL::Nothing());
+    }
+
+    const std::string& getUnsupportedReason() const { return mUnsupportedReason; }
+
+    ConceptId named(const IRI& iri)
+    {
+        std::unordered_map<IRI, ConceptId>::const_iterator cit = mNamed.find(iri);
+        if(cit != mNamed.end())
+        {
+            return cit->second;
+        }
+        ConceptId id = fresh();
+        mTBox.names[id] = iri;
+        mNamed[iri] = id;
+        return id;
+    }
+
+    /**
+     * Add an axiom
+     * \return false if the axiom is not supported
+     */
+    bool addAxiom(const OWLAxiom::Ptr& axiom)
+    {
+        std::string reason = OWL2ELProfile::checkAxiom(axiom);
+        if(!reason.empty())
+        {
+            return unsupported(reason);
+        }
+
+        switch(axiom->getAxiomType())
+        {
+            case OWLAxiom::SubClassOf:
+            {
+                OWLSubClassOfAxiom::Ptr subClassAxiom = dynamic_pointer_cast<OWLSubClassOfAxiom>(axiom);
+                subsumes(concept(subClassAxiom->getSubClass()), concept(subClassAxiom->getSuperClass()));
+                break;
+            }
+            case OWLAxiom::EquivalentClasses:
+            {
+                std::vector<ConceptId> ids = concepts(dynamic_pointer_cast<OWLEquivalentClassesAxiom>(axiom)->getEquivalentClasses());
+                for(size_t i = 1; i < ids.size(); ++i)
+                {
+                    subsumes(ids[i-1], ids[i]);
+                    subsumes(ids[i], ids[i-1]);
+                }
+                break;
+            }
+            case OWLAxiom::DisjointClasses:
+            {
+                std::vector<ConceptId> ids = concepts(dynamic_pointer_cast<OWLDisjointClassesAxiom>(axiom)->getClassExpressions());
+                for(size_t i = 0; i < ids.size(); ++i)
+                {
+                    for(size_t j = i + 1; j < ids.size(); ++j)
+                    {
+                        subsumes(conjunction(ids[i], ids[j]), BOTTOM);
+                    }
+                }
+                break;
+            }
+            case OWLAxiom::ObjectPropertyDomain:
+            {
+                // ∃r.⊤ ⊑ C
+                OWLObjectPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLObjectPropertyDomainAxiom>(axiom);
+                RoleId r = role(domainAxiom->getProperty(), false);
+                mTBox.negativeExistentials[TOP].push_back(std::make_pair(r, concept(domainAxiom->getDomain())));
+                break;
+            }
+            case OWLAxiom::DataPropertyDomain:
+            {
+                OWLDataPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLDataPropertyDomainAxiom>(axiom);
+                RoleId r = role(domainAxiom->getProperty(), true);
+                mTBox.negativeExistentials[TOP].push_back(std::make_pair(r, concept(domainAxiom->getDomain())));
+                break;
+            }
+            case OWLAxiom::DataPropertyRange:
+            {
+                // values outside of the range would be inconsistent, which
+                // is not taken into account by the completion rules
+                OWLDataType::Ptr type = dynamic_pointer_cast<OWLDataType>(dynamic_pointer_cast<OWLDataPropertyRangeAxiom>(axiom)->getRange());
+                if(!type || type->getIRI() != vocabulary::RDFS::Literal())
+                {
+                    return unsupported("DataPropertyRange axioms are only supported for rdfs:Literal");
+                }
+                break;
+            }
+            case OWLAxiom::TransitiveObjectProperty:
+                mTransitiveRoles.insert(role(dynamic_pointer_cast<OWLTransitiveObjectPropertyAxiom>(axiom)->getProperty(), false));
+                break;
+            case OWLAxiom::ObjectPropertyRange:
+            case OWLAxiom::ReflexiveObjectProperty:
+            case OWLAxiom::FunctionalDataProperty:
+            case OWLAxiom::SubPropertyChainOf:
+                return unsupported(OWLAxiom::AxiomTypeTxt[axiom->getAxiomType()] + " axioms are not supported");
+            default:
+                // property hierarchies are taken from the RDFS closure, all
+                // other axioms do not affect the classification
+                break;
+        }
+        return mUnsupportedReason.empty();
+    }
+
+    /**
+     * Compute the role hierarchy
+     */
+    void finish()
+    {
+        // super roles might be new, so the number of roles grows while
+        // iterating
+        for(RoleId r = 0; r < mRoles.size(); ++r)
+        {
+            std::vector<RoleId> superRoles(1, r);
+            const IRISet& ancestors = mRDFS.getAncestors(mDataRoles[r] ? RDFSClosure::DATA_PROPERTY : RDFSClosure::OBJECT_PROPERTY, mRoles[r]);
+            for(const IRI& ancestor : ancestors)
+            {
+                superRoles.push_back(role(ancestor, mDataRoles[r]));
+            }
+            std::sort(superRoles.begin(), superRoles.end());
+            mTBox.superRoles.push_back(superRoles);
+        }
+
+        for(const std::vector<RoleId>& superRoles : mTBox.superRoles)
+        {
+            std::vector<RoleId> transitiveSuperRoles;
+            for(RoleId superRole : superRoles)
+            {
+                if(mTransitiveRoles.count(superRole))
+                {
+                    transitiveSuperRoles.push_back(superRole);
+                }
+            }
+            mTBox.transitiveSuperRoles.push_back(transitiveSuperRoles);
+        }
+    }
+
+private:
+    bool unsupported(const std::string& reason)
+    {
+        if(mUnsupportedReason.empty())
+        {
+            mUnsupportedReason = reason;
+        }
+        return false;
+    }
+
+    ConceptId fresh()
+    {
+        ConceptId id = mTBox.names.size();
+        mTBox.names.push_back(IRI());
+        mTBox.toldSubsumers.push_back(std::vector<ConceptId>());
+        mTBox.conjunctions.push_back(NormalizedTBox::ConceptPairs());
+        mTBox.existentials.push_back(NormalizedTBox::RoleConceptPairs());
+        mTBox.negativeExistentials.push_back(NormalizedTBox::RoleConceptPairs());
+        return id;
+    }
+
+    /**
+     * Get the fresh concept for a complex expression, which is identified by
+     * its structure
+     * \return true if the concept has been created, i.e. needs to be defined
+     */
+    bool complex(const std::string& key, ConceptId& id)
+    {
+        std::unordered_map<std::string, ConceptId>::const_iterator cit = mComplex.find(key);
+        if(cit != mComplex.end())
+        {
+            id = cit->second;
+            return false;
+        }
+        id = fresh();
+        mComplex[key] = id;
+        return true;
+    }
+
+    void subsumes(ConceptId subclass, ConceptId superclass)
+    {
+        if(subclass != superclass)
+        {
+            mTBox.toldSubsumers[subclass].push_back(superclass);
+        }
+    }
+
+    RoleId role(const IRI& iri, bool dataRole)
+    {
+        std::unordered_map<IRI, RoleId>::const_iterator cit = mRoleIds.find(iri);
+        if(cit != mRoleIds.end())
+        {
+            return cit->second;
+        }
+        RoleId id = mRoles.size();
+        mRoles.push_back(iri);
+        mDataRoles.push_back(dataRole);
+        mRoleIds[iri] = id;
+        return id;
+    }
+
+    RoleId role(const OWLPropertyExpression::Ptr& property, bool dataRole)
+    {
+        OWLProperty::Ptr namedProperty = dynamic_pointer_cast<OWLProperty>(property);
+        if(!namedProperty)
+        {
+            unsupported("anonymous property expressions are not supported");
+            return role(IRI(), dataRole);
+        }
+        return role(namedProperty->getIRI(), dataRole);
+    }
+
+    /**
+     * Get the concept which is equivalent to C1 ⊓ C2
+     */
+    ConceptId conjunction(ConceptId c1, ConceptId c2)
+    {
+        if(c1 == c2 || c2 == TOP)
+        {
+            return c1;
+        } else if(c1 == TOP)
+        {
+            return c2;
+        }
+
+        ConceptId id;
+        if(complex("and:" + std::to_string(std::min(c1, c2)) + "," + std::to_string(std::max(c1, c2)), id))
+        {
+            subsumes(id, c1);
+            subsumes(id, c2);
+            mTBox.conjunctions[c1].push_back(std::make_pair(c2, id));
+            mTBox.conjunctions[c2].push_back(std::make_pair(c1, id));
+        }
+        return id;
+    }
+
+    /**
+     * Get the concept which is equivalent to ∃r.F
+     */
+    ConceptId existential(RoleId r, ConceptId filler)
+    {
+        ConceptId id;
+        if(complex("some:" + std::to_string(r) + "," + std::to_string(filler), id))
+        {
+            mTBox.existentials[id].push_back(std::make_pair(r, filler));
+            mTBox.negativeExistentials[filler].push_back(std::make_pair(r, id));
+        }
+        return id;
+    }
+
+    /**
+     * Get the concept of a literal, which is shared by all literals of the
+     * same value and subsumed by the datatypes containing the value
+     */
+    ConceptId literal(const OWLLiteral::Ptr& literal)
+    {
+        std::string key;
+        IRIList datatypes;
+        if(!getLiteralValue(*literal, key, datatypes))
+        {
+            unsupported("literal '" + literal->toString() + "' is not supported");
+            return TOP;
+        }
+
+        ConceptId id;
+        if(complex("literal:" + key, id))
+        {
+            for(const IRI& type : datatypes)
+            {
+                subsumes(id, datatype(type));
+            }
+        }
+        return id;
+    }
+
+    /**
+     * Get the concept of a datatype of the EL datatype map, which is
+     * subsumed by the datatypes containing its value space and disjoint
+     * with the datatypes of other kinds of values
+     */
+    ConceptId datatype(const IRI& iri)
+    {
+        if(iri == vocabulary::RDFS::Literal())
+        {
+            return TOP;
+        } else if(!OWL2ELProfile::isDatatypeAllowed(iri))
+        {
+            unsupported("datatype '" + iri.toString() + "' is not supported");
+            return TOP;
+        }
+
+        ConceptId id;
+        if(complex("datatype:" + iri.toString(), id))
+        {
+            IRI superDatatype = getSuperDatatype(iri);
+            if(!superDatatype.empty())
+            {
+                subsumes(id, datatype(superDatatype));
+            } else if(isRootDatatype(iri))
+            {
+                for(ConceptId root : mRootDatatypes)
+                {
+                    subsumes(conjunction(root, id), BOTTOM);
+                }
+                mRootDatatypes.push_back(id);
+            }
+        }
+        return id;
+    }
+
+    /**
+     * Get the concept of a data range, only named datatypes and single
+     * literals can be represented exactly
+     */
+    ConceptId dataRange(const OWLDataRange::Ptr& range)
+    {
+        if(range->getDataRangeType() == OWLDataRange::DATATYPE)
+        {
+            if(OWLDataType::Ptr type = dynamic_pointer_cast<OWLDataType>(range))
+            {
+                return datatype(type->getIRI());
+            }
+        } else if(OWLDataOneOf::Ptr oneOf = dynamic_pointer_cast<OWLDataOneOf>(range))
+        {
+            if(oneOf->getLiterals().size() == 1)
+            {
+                return literal(oneOf->getLiterals().front());
+            }
+        }
+        unsupported(OWLDataRange::TypeTxt[range->getDataRangeType()] + " is not supported");
+        return TOP;
+    }
+
+    std::vector<ConceptId> concepts(const OWLClassExpression::PtrList& expressions)
+    {
+        std::vector<ConceptId> ids;
+        for(const OWLClassExpression::Ptr& expression : expressions)
+        {
+            ids.push_back(concept(expression));
+        }
+        return ids;
+    }
+
+    ConceptId concept(const OWLClassExpression::Ptr& expression)
+    {
+        switch(expression->getClassExpressionType())
+        {
+            case OWLClassExpression::OWL_CLASS:
+                return named(dynamic_pointer_cast<OWLClass>(expression)->getIRI());
+            case OWLClassExpression::OBJECT_INTERSECTION_OF:
+            {
+                std::vector<ConceptId> operands = concepts(dynamic_pointer_cast<OWLObjectIntersectionOf>(expression)->getOperands());
+                std::sort(operands.begin(), operands.end());
+                ConceptId id = TOP;
+                for(ConceptId operand : operands)
+                {
+                    id = conjunction(id, operand);
+                }
+                return id;
+            }
+            case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+            {
+                RoleId r = role(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty(), false);
+                return existential(r, concept(dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(expression)->getFiller()));
+            }
+            case OWLClassExpression::DATA_SOME_VALUES_FROM:
+            {
+                RoleId r = role(dynamic_pointer_cast<OWLDataRestriction>(expression)->getProperty(), true);
+                return existential(r, dataRange(dynamic_pointer_cast<OWLQuantifiedDataRestriction>(expression)->getFiller()));
+            }
+            case OWLClassExpression::DATA_HAS_VALUE:
+            {
+                RoleId r = role(dynamic_pointer_cast<OWLDataRestriction>(expression)->getProperty(), true);
+                return existential(r, literal(dynamic_pointer_cast<OWLDataHasValue>(expression)->getFiller()));
+            }
+            default:
+                unsupported(OWLClassExpression::TypeTxt[expression->getClassExpressionType()] + " is not supported");
+                return TOP;
+        }
+    }
+
+    NormalizedTBox& mTBox;
+    const RDFSClosure& mRDFS;
+
+    std::unordered_map<IRI, ConceptId> mNamed;
+    std::unordered_map<std::string, ConceptId> mComplex;
+    /// Datatypes with pairwise disjoint value spaces
+    std::vector<ConceptId> mRootDatatypes;
+
+    std::unordered_map<IRI, RoleId> mRoleIds;
+    IRIList mRoles;
+    std::vector<bool> mDataRoles;
+    std::unordered_set<RoleId> mTransitiveRoles;
+
+    std::string mUnsupportedReason;
+};
+
+/**
+ * Concurrent saturation of a NormalizedTBox
+ * \details Each concept that is either named or occurs as filler of an
+ * existential restriction has a context, which collects its subsumers and
+ * the links from and to other contexts. Conclusions are queued at the
+ * context they belong to, and a context with pending conclusions is queued
+ * for processing, so that only one thread at a time modifies a context.
+ */
+class Saturation
+{
+public:
+    Saturation(const NormalizedTBox& tbox)
+        : mTBox(tbox)
+        , mPending(0)
+        , mFailed(false)
+    {
+        for(size_t i = 0; i < tbox.size(); ++i)
+        {
+            mContexts.push_back(std::unique_ptr<Context>(new Context()));
+        }
+    }
+
+    void run(size_t numberOfThreads)
+    {
+        for(ConceptId c = 0; c < mTBox.size(); ++c)
+        {
+            if(!mTBox.names[c].empty())
+            {
+                activate(c);
+            }
+        }
+
+        std::vector<std::thread> threads;
+        for(size_t i = 1; i < numberOfThreads; ++i)
+        {
+            threads.push_back(std::thread(&Saturation::work, this));
+        }
+        work();
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        if(mError)
+        {
+            std::rethrow_exception(mError);
+        }
+    }
+
+    const std::unordered_set<ConceptId>& getSubsumers(ConceptId c) const { return mContexts[c]->subsumers; }
+
+private:
+    struct Item
+    {
+        enum Type { SUBSUMER, BACKWARD_LINK, FORWARD_LINK };
+
+        Type type;
+        RoleId role;
+        ConceptId concept;
+
+        Item(Type type = SUBSUMER, RoleId role = 0, ConceptId concept = 0)
+            : type(type)
+            , role(role)
+            , concept(concept)
+        {}
+
+        uint64_t getLinkKey() const { return (static_cast<uint64_t>(role) << 32) | concept; }
+    };
+
+    struct Context
+    {
+        std::mutex mutex;
+        std::deque<Item> todo;
+        /// Whether the context is queued or being processed
+        std::atomic<bool> active;
+        std::atomic<bool> initialized;
+
+        std::unordered_set<ConceptId> subsumers;
+        /// (r, P) for P ⊑ ∃r.C
+        std::vector< std::pair<RoleId, ConceptId> > backwardLinks;
+        /// (r, E) for C ⊑ ∃r.E, if r has a transitive super role
+        std::vector< std::pair<RoleId, ConceptId> > forwardLinks;
+        std::unordered_set<uint64_t> backwardLinkKeys;
+        std::unordered_set<uint64_t> forwardLinkKeys;
+
+        Context()
+            : active(false)
+            , initialized(false)
+        {}
+    };
+
+    void activate(ConceptId c)
+    {
+        if(!mContexts[c]->initialized.exchange(true))
+        {
+            push(c, Item(Item::SUBSUMER, 0, c));
+            push(c, Item(Item::SUBSUMER, 0, TOP));
+        }
+    }
+
+    void push(ConceptId c, const Item& item)
+    {
+        // count first, so that the number of pending items cannot drop to
+        // zero before this item is processed
+        ++mPending;
+
+        Context& context = *mContexts[c];
+        {
+            std::lock_guard<std::mutex> lock(context.mutex);
+            context.todo.push_back(item);
+        }
+
+        if(!context.active.exchange(true))
+        {
+            {
+                std::lock_guard<std::mutex> lock(mQueueMutex);
+                mQueue.push_back(c);
+            }
+            mCondition.notify_one();
+        }
+    }
+
+    void work()
+    {
+        try {
+            while(true)
+            {
+                ConceptId c;
+                {
+                    std::unique_lock<std::mutex> lock(mQueueMutex);
+                    mCondition.wait(lock, [this]()
+                            {
+                                return !mQueue.empty() || mPending == 0 || mFailed;
+                            });
+                    if(mQueue.empty() || mFailed)
+                    {
+                        return;
+                    }
+                    c = mQueue.front();
+                    mQueue.pop_front();
+                }
+                process(c);
+            }
+        } catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            if(!mError)
+            {
+                mError = std::current_exception();
+            }
+            mFailed = true;
+            mCondition.notify_all();
+        }
+    }
+
+    void process(ConceptId c)
+    {
+        Context& context = *mContexts[c];
+        while(true)
+        {
+            Item item;
+            {
+                std::lock_guard<std::mutex> lock(context.mutex);
+                if(context.todo.empty())
+                {
+                    context.active = false;
+                    return;
+                }
+                item = context.todo.front();
+                context.todo.pop_front();
+            }
+
+            switch(item.type)
+            {
+                case Item::SUBSUMER:
+                    addSubsumer(c, context, item.concept);
+                    break;
+                case Item::BACKWARD_LINK:
+                    addBackwardLink(context, item);
+                    break;
+                case Item::FORWARD_LINK:
+                    addForwardLink(context, item);
+                    break;
+            }
+
+            if(--mPending == 0)
+            {
+                std::lock_guard<std::mutex> lock(mQueueMutex);
+                mCondition.notify_all();
+            }
+        }
+    }
+
+    /**
+     * Propagate the subsumer A of C along the backward links, i.e. apply
+     * ∃r.A ⊑ B to all P ⊑ ∃r.C
+     */
+    void propagate(ConceptId a, RoleId r, ConceptId p)
+    {
+        if(a == BOTTOM)
+        {
+            push(p, Item(Item::SUBSUMER, 0, BOTTOM));
+            return;
+        }
+
+        for(const std::pair<RoleId, ConceptId>& negativeExistential : mTBox.negativeExistentials[a])
+        {
+            if(mTBox.isSubRoleOf(r, negativeExistential.first))
+            {
+                push(p, Item(Item::SUBSUMER, 0, negativeExistential.second));
+            }
+        }
+    }
+
+    void addSubsumer(ConceptId c, Context& context, ConceptId a)
+    {
+        if(!context.subsumers.insert(a).second)
+        {
+            return;
+        }
+
+        // A ⊑ B
+        for(ConceptId b : mTBox.toldSubsumers[a])
+        {
+            push(c, Item(Item::SUBSUMER, 0, b));
+        }
+
+        // A ⊓ B ⊑ D
+        for(const std::pair<ConceptId, ConceptId>& conjunction : mTBox.conjunctions[a])
+        {
+            if(context.subsumers.count(conjunction.first))
+            {
+                push(c, Item(Item::SUBSUMER, 0, conjunction.second));
+            }
+        }
+
+        // A ⊑ ∃r.F
+        for(const std::pair<RoleId, ConceptId>& existential : mTBox.existentials[a])
+        {
+            activate(existential.second);
+            push(existential.second, Item(Item::BACKWARD_LINK, existential.first, c));
+            if(!mTBox.transitiveSuperRoles[existential.first].empty())
+            {
+                push(c, Item(Item::FORWARD_LINK, existential.first, existential.second));
+            }
+        }
+
+        for(const std::pair<RoleId, ConceptId>& link : context.backwardLinks)
+        {
+            propagate(a, link.first, link.second);
+        }
+    }
+
+    void addBackwardLink(Context& context, const Item& item)
+    {
+        if(!context.backwardLinkKeys.insert(item.getLinkKey()).second)
+        {
+            return;
+        }
+        context.backwardLinks.push_back(std::make_pair(item.role, item.concept));
+
+        for(ConceptId a : context.subsumers)
+        {
+            if(a == BOTTOM || !mTBox.negativeExistentials[a].empty())
+            {
+                propagate(a, item.role, item.concept);
+            }
+        }
+
+        // P ⊑ ∃r.C and C ⊑ ∃s.E, with r, s ⊑ t and t transitive: P ⊑ ∃t.E
+        for(RoleId t : mTBox.transitiveSuperRoles[item.role])
+        {
+            for(const std::pair<RoleId, ConceptId>& link : context.forwardLinks)
+            {
+                if(mTBox.isSubRoleOf(link.first, t))
+                {
+                    push(link.second, Item(Item::BACKWARD_LINK, t, item.concept));
+                }
+            }
+        }
+    }
+
+    void addForwardLink(Context& context, const Item& item)
+    {
+        if(!context.forwardLinkKeys.insert(item.getLinkKey()).second)
+        {
+            return;
+        }
+        context.forwardLinks.push_back(std::make_pair(item.role, item.concept));
+
+        for(RoleId t : mTBox.transitiveSuperRoles[item.role])
+        {
+            for(const std::pair<RoleId, ConceptId>& link : context.backwardLinks)
+            {
+                if(mTBox.isSubRoleOf(link.first, t))
+                {
+                    push(item.concept, Item(Item::BACKWARD_LINK, t, link.second));
+                }
+            }
+        }
+    }
+
+    const NormalizedTBox& mTBox;
+    std::vector< std::unique_ptr<Context> > mContexts;
+
+    std::mutex mQueueMutex;
+    std::condition_variable mCondition;
+    std::deque<ConceptId> mQueue;
+    /// Number of items which have been pushed but not yet processed
+    std::atomic<size_t> mPending;
+    bool mFailed;
+    std::exception_ptr mError;
+};
+
+bool normalize(const OWLOntology::Ptr& ontology, NormalizedTBox& tbox)
+{
+    Normalizer normalizer(tbox, ontology->getRDFSClosure());
+    for(const std::pair<const OWLAxiom::AxiomType, OWLAxiom::PtrList>& typedAxioms : ontology->getAxiomMap())
+    {
+        for(const OWLAxiom::Ptr& axiom : typedAxioms.second)
+        {
+            if(!normalizer.addAxiom(axiom))
+            {
+                LOG_DEBUG_S << "owlapi::model::ELClassifier: ontology is not supported -- "
+                    << normalizer.getUnsupportedReason();
+                return false;
+            }
+        }
+    }
+
+    for(const IRI& klass : OWLOntologyAsk(ontology).withQueryMode(OWLOntologyAsk::TOLD).allClasses())
+    {
+        normalizer.named(klass);
+    }
+    normalizer.finish();
+    return true;
+}
+
+} // end anonymous namespace
+
+ELClassification::ELClassification(const Taxonomy::Ptr& taxonomy,
+        const std::unordered_map<IRI, IRIList>& equivalentClasses,
+        const IRISet& unsatisfiableClasses)
+    : mpTaxonomy(taxonomy)
+    , mEquivalentClasses(equivalentClasses)
+    , mUnsatisfiableClasses(unsatisfiableClasses)
+{}
+
+Taxonomy::NodeId ELClassification::getId(const IRI& klass) const
+{
+    if(!mpTaxonomy->hasNode(klass))
+    {
+        throw std::invalid_argument("owlapi::model::ELClassification: unknown class '"
+                + klass.toString() + "'");
+    }
+    return mpTaxonomy->getId(klass);
+}
+
+bool ELClassification::isSubClassOf(const IRI& subclass, const IRI& superclass) const
+{
+    getId(superclass);
+    if(subclass == superclass || superclass == vocabulary::OWL::Thing()
+            || isUnsatisfiable(subclass))
+    {
+        return true;
+    }
+
+    // equivalent classes share their ancestors, but are not related
+    // themselves
+    IRIList ancestors = getRelatives(subclass, false, true);
+    IRIList equivalentClasses = getEquivalentClasses(subclass);
+    ancestors.insert(ancestors.end(), equivalentClasses.begin(), equivalentClasses.end());
+    return std::find(ancestors.begin(), ancestors.end(), superclass) != ancestors.end();
+}
+
+IRIList ELClassification::getRelatives(const IRI& klass, bool direct, bool ancestors) const
+{
+    std::vector<Taxonomy::NodeId> pending(1, getId(klass));
+    std::unordered_set<Taxonomy::NodeId> visited(pending.begin(), pending.end());
+    IRIList relatives;
+    while(!pending.empty())
+    {
+        Taxonomy::NodeId node = pending.back();
+        pending.pop_back();
+        Taxonomy::Range range = ancestors ? mpTaxonomy->getParents(node) : mpTaxonomy->getChildren(node);
+        for(Taxonomy::NodeId relative : range)
+        {
+            if(visited.insert(relative).second)
+            {
+                relatives.push_back(mpTaxonomy->getIRI(relative));
+                if(!direct)
+                {
+                    pending.push_back(relative);
+                }
+            }
+        }
+    }
+    return relatives;
+}
+
+IRIList ELClassification::getEquivalentClasses(const IRI& klass) const
+{
+    getId(klass);
+    std::unordered_map<IRI, IRIList>::const_iterator cit = mEquivalentClasses.find(klass);
+    if(cit == mEquivalentClasses.end())
+    {
+        return IRIList(1, klass);
+    }
+    return cit->second;
+}
+
+ELClassifier::ELClassifier(const OWLOntology::Ptr& ontology, size_t numberOfThreads)
+    : mpOntology(ontology)
+    , mNumberOfThreads(numberOfThreads)
+{
+    if(!mpOntology)
+    {
+        throw std::invalid_argument("owlapi::model::ELClassifier: ontology is not set");
+    }
+
+    if(mNumberOfThreads == 0)
+    {
+        mNumberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+bool ELClassifier::isRelevant(const OWLAxiom::Ptr& axiom)
+{
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+        {
+            // new classes and properties extend the taxonomy or the role
+            // hierarchy
+            OWLEntity::EntityType type = dynamic_pointer_cast<OWLDeclarationAxiom>(axiom)->getEntity()->getEntityType();
+            return type == OWLEntity::CLASS
+                || type == OWLEntity::OBJECT_PROPERTY
+                || type == OWLEntity::DATA_PROPERTY;
+        }
+        case OWLAxiom::ClassAssertion:
+        case OWLAxiom::SameIndividual:
+        case OWLAxiom::DifferentIndividuals:
+        case OWLAxiom::ObjectPropertyAssertion:
+        case OWLAxiom::NegativeObjectPropertyAssertion:
+        case OWLAxiom::DataPropertyAssertion:
+        case OWLAxiom::NegativeDataPropertyAssertion:
+        case OWLAxiom::SubAnnotationPropertyOf:
+        case OWLAxiom::AnnotationPropertyDomain:
+        case OWLAxiom::AnnotationPropertyRange:
+        case OWLAxiom::AnnotationAssertion:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool ELClassifier::isSupported() const
+{
+    NormalizedTBox tbox;
+    return normalize(mpOntology, tbox);
+}
+
+ELClassification::Ptr ELClassifier::saturate() const
+{
+    NormalizedTBox tbox;
+    if(!normalize(mpOntology, tbox))
+    {
+        return ELClassification::Ptr();
+    }
+
+    Saturation saturation(tbox);
+    saturation.run(mNumberOfThreads);
+
+    // Direct superclasses of the named classes: a named subsumer is direct if
+    // it does not strictly subsume another named subsumer
+    std::vector<ConceptId> namedConcepts;
+    for(ConceptId c = 0; c < tbox.size(); ++c)
+    {
+        if(!tbox.names[c].empty())
+        {
+            namedConcepts.push_back(c);
+        }
+    }
+
+    std::vector< std::vector<ConceptId> > directSubsumers(namedConcepts.size());
+    std::vector< std::vector<ConceptId> > equivalents(namedConcepts.size());
+    std::atomic<size_t> next(0);
+    std::function<void()> worker = [&]()
+    {
+        for(size_t i = next++; i < namedConcepts.size(); i = next++)
+        {
+            ConceptId c = namedConcepts[i];
+            const std::unordered_set<ConceptId>& subsumers = saturation.getSubsumers(c);
+            if(c == BOTTOM || subsumers.count(BOTTOM))
+            {
+                continue;
+            }
+
+            std::vector<ConceptId> candidates;
+            for(ConceptId subsumer : subsumers)
+            {
+                if(subsumer == c || tbox.names[subsumer].empty())
+                {
+                    continue;
+                }
+
+                if(saturation.getSubsumers(subsumer).count(c))
+                {
+                    equivalents[i].push_back(subsumer);
+                } else {
+                    candidates.push_back(subsumer);
+                }
+            }
+
+            for(ConceptId candidate : candidates)
+            {
+                bool direct = true;
+                for(ConceptId other : candidates)
+                {
+                    const std::unordered_set<ConceptId>& otherSubsumers = saturation.getSubsumers(other);
+                    if(other != candidate && otherSubsumers.count(candidate)
+                            && !saturation.getSubsumers(candidate).count(other))
+                    {
+                        direct = false;
+                        break;
+                    }
+                }
+                if(direct)
+                {
+                    directSubsumers[i].push_back(candidate);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < mNumberOfThreads; ++i)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    IRIList klasses;
+    std::vector< std::pair<IRI, IRI> > directSubClasses;
+    std::unordered_map<IRI, IRIList> equivalentClasses;
+    IRISet unsatisfiableClasses;
+    for(size_t i = 0; i < namedConcepts.size(); ++i)
+    {
+        ConceptId c = namedConcepts[i];
+        const IRI& klass = tbox.names[c];
+        klasses.push_back(klass);
+
+        if(c != BOTTOM && saturation.getSubsumers(c).count(BOTTOM))
+        {
+            unsatisfiableClasses.insert(klass);
+        }
+
+        for(ConceptId parent : directSubsumers[i])
+        {
+            directSubClasses.push_back( std::make_pair(tbox.names[parent], klass) );
+        }
+
+        if(!equivalents[i].empty())
+        {
+            IRIList& members = equivalentClasses[klass];
+            members.push_back(klass);
+            for(ConceptId equivalent : equivalents[i])
+            {
+                members.push_back(tbox.names[equivalent]);
+            }
+        }
+    }
+
+    LOG_DEBUG_S << "owlapi::model::ELClassifier::saturate: classified " << klasses.size()
+        << " classes using " << tbox.size() - klasses.size() << " auxiliary concepts and "
+        << mNumberOfThreads << " threads";
+
+    Taxonomy::Ptr taxonomy = make_shared<Taxonomy>(klasses, directSubClasses);
+    return make_shared<ELClassification>(taxonomy, equivalentClasses, unsatisfiableClasses);
+}
+
+Taxonomy::Ptr ELClassifier::classify()
+{
+    ELClassification::Ptr classification = saturate();
+    if(!classification)
+    {
+        throw std::runtime_error("owlapi::model::ELClassifier::classify: ontology is"
+                " not in the supported EL fragment");
+    }
+
+    if(mpOntology->hasKnowledgeBase())
+    {
+        mpOntology->kb()->setTaxonomy(classification->getTaxonomy());
+    }
+    return classification->getTaxonomy();
+}
+
+uint64_t ELClassification::getMemoryUsage() const
+{
+    return mpTaxonomy->getMemoryUsage() + memory::heapBytes(mEquivalentClasses)
+        + memory::heapBytes(mUnsatisfiableClasses);
+}
+
+} // end namespace model
+} // end namespace owlapi
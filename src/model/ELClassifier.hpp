@@ -0,0 +1,153 @@
+#ifndef OWLAPI_MODEL_EL_CLASSIFIER_HPP
+#define OWLAPI_MODEL_EL_CLASSIFIER_HPP
+
+#include <unordered_map>
+#include "OWLOntology.hpp"
+#include "Taxonomy.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class ELClassification
+ * \brief Class hierarchy as computed by the ELClassifier
+ * \details The taxonomy relates every satisfiable class to its direct
+ * superclasses, where equivalent classes share their parents and children.
+ * Unsatisfiable classes are not related to any other class.
+ */
+class ELClassification
+{
+public:
+    typedef shared_ptr<ELClassification> Ptr;
+
+    ELClassification(const Taxonomy::Ptr& taxonomy,
+            const std::unordered_map<IRI, IRIList>& equivalentClasses,
+            const IRISet& unsatisfiableClasses);
+
+    const Taxonomy::Ptr& getTaxonomy() const { return mpTaxonomy; }
+
+    /**
+     * Check if the class is known to the classification
+     */
+    bool hasClass(const IRI& klass) const { return mpTaxonomy->hasNode(klass); }
+
+    /**
+     * Test if subclass is subsumed by superclass
+     * \throw std::invalid_argument if a class is unknown
+     */
+    bool isSubClassOf(const IRI& subclass, const IRI& superclass) const;
+
+    /**
+     * Get the sub- or superclasses of a class
+     * \param ancestors true for the superclasses, false for the subclasses
+     * \throw std::invalid_argument if the class is unknown
+     */
+    IRIList getRelatives(const IRI& klass, bool direct, bool ancestors) const;
+
+    /**
+     * Get the equivalent classes of a class, including the class itself
+     * \throw std::invalid_argument if the class is unknown
+     */
+    IRIList getEquivalentClasses(const IRI& klass) const;
+
+    bool isUnsatisfiable(const IRI& klass) const { return mUnsatisfiableClasses.count(klass); }
+
+    /**
+     * Get the estimated heap memory of the classification
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    Taxonomy::NodeId getId(const IRI& klass) const;
+
+    Taxonomy::Ptr mpTaxonomy;
+    /// Members of the non-trivial equivalence classes
+    std::unordered_map<IRI, IRIList> mEquivalentClasses;
+    IRISet mUnsatisfiableClasses;
+};
+
+/**
+ * \class ELClassifier
+ * \brief Consequence-based classifier for ontologies in the OWL 2 EL profile
+ * \details The classifier normalizes the class axioms into the forms
+ * A ⊑ B, A1 ⊓ A2 ⊑ B, A ⊑ ∃r.B and ∃r.A ⊑ B, introducing fresh classes for
+ * complex subexpressions, and saturates the subsumers of all classes with
+ * the completion rules of EL (in the style of ELK). Each class has a
+ * context of its own, whose pending conclusions are processed by at most one
+ * thread at a time, so that the saturation scales with the number of
+ * threads. The direct superclasses are finally computed from the subsumers
+ * of all named classes.
+ *
+ * Supported are intersections, existential restrictions (of object and data
+ * properties), property hierarchies, transitive object properties,
+ * disjoint classes and property domains. Data ranges are limited to the
+ * datatypes of the EL datatype map, which are related by the inclusion of
+ * their value spaces, and to single literals, which are identified by their
+ * value and subsumed by the datatypes containing it. Ontologies using
+ * nominals, hasSelf restrictions, object property ranges, data property
+ * ranges other than rdfs:Literal, reflexive object properties, functional
+ * data properties, literals whose values cannot be compared exactly (e.g.
+ * xsd:dateTime) or any construct outside the profile (\see OWL2ELProfile)
+ * are not supported; for these the tableau reasoner has to be used instead.
+ * Assertions are not taken into account.
+ *
+ * OWLOntologyAsk selects this classifier automatically to answer the class
+ * hierarchy queries of supported ontologies.
+ *
+\verbatim
+    ELClassifier classifier(ontology);
+    if(classifier.isSupported())
+    {
+        classifier.classify();
+    }
+\endverbatim
+ */
+class ELClassifier
+{
+public:
+    /**
+     * \param ontology Ontology to classify
+     * \param numberOfThreads Number of threads, 0 to use the number of
+     * hardware threads
+     * \throw std::invalid_argument if the ontology is not set
+     */
+    ELClassifier(const OWLOntology::Ptr& ontology, size_t numberOfThreads = 0);
+
+    size_t getNumberOfThreads() const { return mNumberOfThreads; }
+
+    /**
+     * Check if an axiom change of the given type can affect the
+     * classification
+     */
+    static bool isRelevant(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Check whether the ontology lies in the fragment supported by this
+     * classifier
+     */
+    bool isSupported() const;
+
+    /**
+     * Compute the class hierarchy
+     * \return classification, or a null pointer if the ontology is not
+     * supported
+     */
+    ELClassification::Ptr saturate() const;
+
+    /**
+     * Classify the ontology and set the taxonomy as taxonomy of the
+     * ontology's knowledge base, if it has one
+     * \return taxonomy
+     * \throw std::runtime_error if the ontology is not supported
+     */
+    Taxonomy::Ptr classify();
+
+private:
+    OWLOntology::Ptr mpOntology;
+    size_t mNumberOfThreads;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_EL_CLASSIFIER_HPP
@@ -85,6 +85,21 @@ bool IRI::isAbsolute() const
     return true;
 }
 
+uint64_t IRI::getMemoryUsage() const
+{
+    // Short strings are stored inline
+    uint64_t bytes = 0;
+    if(mPrefix.capacity() > 15)
+    {
+        bytes += mPrefix.capacity() + 1;
+    }
+    if(mRemainder.capacity() > 15)
+    {
+        bytes += mRemainder.capacity() + 1;
+    }
+    return bytes;
+}
+
 std::string IRI::getScheme() const
 {
     size_t pos = mPrefix.find(":");
@@ -230,6 +245,42 @@ bool IRI::operator==(const IRI& other) const
     return mPrefix == other.mPrefix && mRemainder == other.mRemainder;
 }
 
+size_t IRI::getStringHash() const
+{
+    // FNV-1a over prefix and remainder
+    uint64_t hash = 14695981039346656037ULL;
+    for(const std::string* part : { &mPrefix, &mRemainder })
+    {
+        for(unsigned char c : *part)
+        {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool IRI::hasSameString(const IRI& other) const
+{
+    if(mPrefix.size() == other.mPrefix.size())
+    {
+        return mRemainder == other.mRemainder && mPrefix == other.mPrefix;
+    }
+    if(mPrefix.size() + mRemainder.size() != other.mPrefix.size() + other.mRemainder.size())
+    {
+        return false;
+    }
+
+    // Compare the segments of differently split IRIs, where the shorter
+    // prefix is a prefix of the longer one
+    const IRI& a = mPrefix.size() < other.mPrefix.size() ? *this : other;
+    const IRI& b = mPrefix.size() < other.mPrefix.size() ? other : *this;
+    size_t split = b.mPrefix.size() - a.mPrefix.size();
+    return b.mPrefix.compare(0, a.mPrefix.size(), a.mPrefix) == 0
+        && b.mPrefix.compare(a.mPrefix.size(), split, a.mRemainder, 0, split) == 0
+        && a.mRemainder.compare(split, std::string::npos, b.mRemainder) == 0;
+}
+
 std::ostream& operator<<(std::ostream& os, const owlapi::model::IRI& iri)
 {
     os << iri.toString();
@@ -2,6 +2,7 @@
 #define OWLAPI_MODEL_IRI_HPP
 
 #include <stdexcept>
+#include <stdint.h>
 #include <vector>
 #include <set>
 #include <functional>
@@ -95,6 +96,12 @@ public:
      */
     std::string toString() const { return mPrefix + mRemainder; }
 
+    /**
+     * Get the heap memory owned by this IRI, i.e. by prefix and remainder
+     * \return bytes, excluding sizeof(IRI)
+     */
+    uint64_t getMemoryUsage() const;
+
     /**
      * To string
      */
@@ -143,6 +150,21 @@ public:
 
     bool operator<(const IRI& other) const { return toString() < other.toString(); }
 
+    /**
+     * Get the hash of the string representation without concatenating
+     * prefix and remainder
+     * \details IRIs with the same string representation have the same
+     * hash, independent of their split into prefix and remainder
+     */
+    size_t getStringHash() const;
+
+    /**
+     * Check whether the string representations are equal without
+     * concatenating prefix and remainder, i.e. the equivalence which is
+     * implied by operator<
+     */
+    bool hasSameString(const IRI& other) const;
+
     template<class Archive>
     void serialize(Archive& ar, const unsigned int version)
     {
@@ -0,0 +1,676 @@
+#include "LiteralValue.hpp"
+#include <owlapi/Vocabulary.hpp>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <cstdlib>
+
+namespace owlapi {
+namespace model {
+
+namespace {
+
+/**
+ * Registry of the datatype ids
+ * \details The known datatypes are registered on construction and never
+ * change afterwards, so that they are looked up without locking. Only
+ * custom datatypes, which are rare, are guarded by the mutex.
+ */
+class DatatypeRegistry
+{
+public:
+    DatatypeRegistry()
+    {
+        using namespace owlapi::vocabulary;
+        // Order has to match LiteralDatatype::Known
+        addKnown("");
+        addKnown(RDF::PlainLiteral().toString());
+        addKnown(XSD::string().toString());
+        addKnown(XSD::boolean().toString());
+        addKnown(XSD::decimal().toString());
+        addKnown(XSD::integer().toString());
+        addKnown(XSD::nonNegativeInteger().toString());
+        addKnown(XSD::nonPositiveInteger().toString());
+        addKnown(XSD::positiveInteger().toString());
+        addKnown(XSD::negativeInteger().toString());
+        addKnown(XSD::resolve("long").toString());
+        addKnown(XSD::resolve("int").toString());
+        addKnown(XSD::resolve("short").toString());
+        addKnown(XSD::byte().toString());
+        addKnown(XSD::unsignedLong().toString());
+        addKnown(XSD::unsignedInt().toString());
+        addKnown(XSD::unsignedShort().toString());
+        addKnown(XSD::unsignedByte().toString());
+        addKnown(XSD::resolve("double").toString());
+        addKnown(XSD::resolve("float").toString());
+        addKnown(XSD::dateTime().toString());
+        addKnown(XSD::dateTimeStamp().toString());
+    }
+
+    LiteralDatatype::Id intern(const std::string& iri)
+    {
+        LiteralDatatype::Id id;
+        if(findKnown(iri, id))
+        {
+            return id;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::unordered_map<std::string, LiteralDatatype::Id>::const_iterator cit = mCustomIds.find(iri);
+        if(cit != mCustomIds.end())
+        {
+            return cit->second;
+        }
+        id = LiteralDatatype::END_KNOWN + mCustomIRIs.size();
+        // deque: references to the stored IRIs remain valid
+        mCustomIRIs.push_back(iri);
+        mCustomIds[iri] = id;
+        return id;
+    }
+
+    bool find(const std::string& iri, LiteralDatatype::Id& id)
+    {
+        if(findKnown(iri, id))
+        {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::unordered_map<std::string, LiteralDatatype::Id>::const_iterator cit = mCustomIds.find(iri);
+        if(cit != mCustomIds.end())
+        {
+            id = cit->second;
+            return true;
+        }
+        return false;
+    }
+
+    const std::string& getIRI(LiteralDatatype::Id id)
+    {
+        if(id < LiteralDatatype::END_KNOWN)
+        {
+            return mKnownIRIs[id];
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(id - LiteralDatatype::END_KNOWN < mCustomIRIs.size())
+        {
+            return mCustomIRIs[id - LiteralDatatype::END_KNOWN];
+        }
+        throw std::invalid_argument("owlapi::model::LiteralDatatype::getIRI: unknown datatype id");
+    }
+
+private:
+    void addKnown(const std::string& iri)
+    {
+        mKnownIds[iri] = mKnownIRIs.size();
+        mKnownIRIs.push_back(iri);
+    }
+
+    bool findKnown(const std::string& iri, LiteralDatatype::Id& id) const
+    {
+        std::unordered_map<std::string, LiteralDatatype::Id>::const_iterator cit = mKnownIds.find(iri);
+        if(cit != mKnownIds.end())
+        {
+            id = cit->second;
+            return true;
+        }
+        return false;
+    }
+
+    /// Immutable after construction
+    std::vector<std::string> mKnownIRIs;
+    std::unordered_map<std::string, LiteralDatatype::Id> mKnownIds;
+
+    std::mutex mMutex;
+    std::deque<std::string> mCustomIRIs;
+    std::unordered_map<std::string, LiteralDatatype::Id> mCustomIds;
+};
+
+DatatypeRegistry& registry()
+{
+    static DatatypeRegistry registry;
+    return registry;
+}
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool matches(const char* first, const char* last, const char* text)
+{
+    return static_cast<size_t>(last - first) == strlen(text) && std::equal(first, last, text);
+}
+
+/**
+ * Parse an unsigned decimal number of exactly the given number of digits
+ */
+bool parseFixedDigits(const char*& it, const char* last, size_t digits, int& value)
+{
+    if(static_cast<size_t>(last - it) < digits)
+    {
+        return false;
+    }
+    value = 0;
+    for(size_t i = 0; i < digits; ++i, ++it)
+    {
+        if(!isDigit(*it))
+        {
+            return false;
+        }
+        value = value*10 + (*it - '0');
+    }
+    return true;
+}
+
+/**
+ * Parse the magnitude of an integer
+ * \return false if there are no digits, non-digit characters or an overflow
+ */
+bool parseMagnitude(const char* first, const char* last, uint64_t& value)
+{
+    if(first == last)
+    {
+        return false;
+    }
+    const uint64_t max = std::numeric_limits<uint64_t>::max();
+    value = 0;
+    for(; first != last; ++first)
+    {
+        if(!isDigit(*first))
+        {
+            return false;
+        }
+        uint64_t digit = *first - '0';
+        if(value > (max - digit)/10)
+        {
+            return false;
+        }
+        value = value*10 + digit;
+    }
+    return true;
+}
+
+/**
+ * Days since 1970-01-01 of a date in the proleptic gregorian calendar
+ */
+int64_t daysFromCivil(int64_t year, int month, int day)
+{
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153*(month + (month > 2 ? -3 : 9)) + 2)/5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra/4 - yearOfEra/100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+} // end anonymous namespace
+
+LiteralDatatype::Id LiteralDatatype::intern(const std::string& iri)
+{
+    return registry().intern(iri);
+}
+
+bool LiteralDatatype::find(const std::string& iri, Id& id)
+{
+    return registry().find(iri, id);
+}
+
+const std::string& LiteralDatatype::getIRI(Id id)
+{
+    return registry().getIRI(id);
+}
+
+LiteralValue::LiteralValue()
+    : mKind(STRING)
+{
+    mValue.i = 0;
+}
+
+LiteralValue LiteralValue::fromInt64(int64_t value)
+{
+    LiteralValue literalValue;
+    literalValue.mKind = INT64;
+    literalValue.mValue.i = value;
+    return literalValue;
+}
+
+LiteralValue LiteralValue::fromUInt64(uint64_t value)
+{
+    LiteralValue literalValue;
+    literalValue.mKind = UINT64;
+    literalValue.mValue.u = value;
+    return literalValue;
+}
+
+LiteralValue LiteralValue::fromDouble(double value)
+{
+    LiteralValue literalValue;
+    literalValue.mKind = DOUBLE;
+    literalValue.mValue.d = value;
+    return literalValue;
+}
+
+LiteralValue LiteralValue::fromBoolean(bool value)
+{
+    LiteralValue literalValue;
+    literalValue.mKind = BOOLEAN;
+    literalValue.mValue.b = value;
+    return literalValue;
+}
+
+LiteralValue LiteralValue::fromDateTime(int64_t value)
+{
+    LiteralValue literalValue;
+    literalValue.mKind = DATE_TIME;
+    literalValue.mValue.i = value;
+    return literalValue;
+}
+
+LiteralValue::Kind LiteralValue::getKind(LiteralDatatype::Id datatype)
+{
+    switch(datatype)
+    {
+        case LiteralDatatype::INTEGER:
+        case LiteralDatatype::NON_POSITIVE_INTEGER:
+        case LiteralDatatype::NEGATIVE_INTEGER:
+        case LiteralDatatype::LONG:
+        case LiteralDatatype::INT:
+        case LiteralDatatype::SHORT:
+        case LiteralDatatype::BYTE:
+            return INT64;
+        case LiteralDatatype::NON_NEGATIVE_INTEGER:
+        case LiteralDatatype::POSITIVE_INTEGER:
+        case LiteralDatatype::UNSIGNED_LONG:
+        case LiteralDatatype::UNSIGNED_INT:
+        case LiteralDatatype::UNSIGNED_SHORT:
+        case LiteralDatatype::UNSIGNED_BYTE:
+            return UINT64;
+        case LiteralDatatype::DECIMAL:
+        case LiteralDatatype::DOUBLE:
+        case LiteralDatatype::FLOAT:
+            return DOUBLE;
+        case LiteralDatatype::BOOLEAN:
+            return BOOLEAN;
+        case LiteralDatatype::DATE_TIME:
+        case LiteralDatatype::DATE_TIME_STAMP:
+            return DATE_TIME;
+        default:
+            return STRING;
+    }
+}
+
+LiteralValue LiteralValue::parse(const std::string& lexicalForm, LiteralDatatype::Id datatype)
+{
+    const char* first = lexicalForm.data();
+    const char* last = first + lexicalForm.size();
+    switch(getKind(datatype))
+    {
+        case INT64:
+        {
+            int64_t value;
+            if(parse(first, last, value))
+            {
+                return fromInt64(value);
+            }
+            break;
+        }
+        case UINT64:
+        {
+            uint64_t value;
+            if(parse(first, last, value))
+            {
+                return fromUInt64(value);
+            }
+            break;
+        }
+        case DOUBLE:
+        {
+            double value;
+            if(parse(first, last, value))
+            {
+                return fromDouble(value);
+            }
+            break;
+        }
+        case BOOLEAN:
+        {
+            bool value;
+            if(parseBoolean(first, last, value))
+            {
+                return fromBoolean(value);
+            }
+            break;
+        }
+        case DATE_TIME:
+        {
+            int64_t value;
+            if(parseDateTime(first, last, value))
+            {
+                return fromDateTime(value);
+            }
+            break;
+        }
+        case STRING:
+            break;
+    }
+    return LiteralValue();
+}
+
+bool LiteralValue::get(int32_t& value) const
+{
+    int64_t v;
+    if(get(v) && v >= std::numeric_limits<int32_t>::min() && v <= std::numeric_limits<int32_t>::max())
+    {
+        value = static_cast<int32_t>(v);
+        return true;
+    }
+    return false;
+}
+
+bool LiteralValue::get(uint32_t& value) const
+{
+    uint64_t v;
+    if(get(v) && v <= std::numeric_limits<uint32_t>::max())
+    {
+        value = static_cast<uint32_t>(v);
+        return true;
+    }
+    return false;
+}
+
+bool LiteralValue::get(int64_t& value) const
+{
+    if(mKind == INT64)
+    {
+        value = mValue.i;
+        return true;
+    } else if(mKind == UINT64 && mValue.u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+    {
+        value = static_cast<int64_t>(mValue.u);
+        return true;
+    }
+    return false;
+}
+
+bool LiteralValue::get(uint64_t& value) const
+{
+    if(mKind == UINT64)
+    {
+        value = mValue.u;
+        return true;
+    } else if(mKind == INT64 && mValue.i >= 0)
+    {
+        value = static_cast<uint64_t>(mValue.i);
+        return true;
+    }
+    return false;
+}
+
+bool LiteralValue::get(double& value) const
+{
+    switch(mKind)
+    {
+        case INT64:
+            value = static_cast<double>(mValue.i);
+            return true;
+        case UINT64:
+            value = static_cast<double>(mValue.u);
+            return true;
+        case DOUBLE:
+            value = mValue.d;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool LiteralValue::parse(const char* first, const char* last, int32_t& value)
+{
+    int64_t v;
+    if(parse(first, last, v) && v >= std::numeric_limits<int32_t>::min() && v <= std::numeric_limits<int32_t>::max())
+    {
+        value = static_cast<int32_t>(v);
+        return true;
+    }
+    return false;
+}
+
+bool LiteralValue::parse(const char* first, const char* last, uint32_t& value)
+{
+    uint64_t v;
+    if(parse(first, last, v) && v <= std::numeric_limits<uint32_t>::max())
+    {
+        value = static_cast<uint32_t>(v);
+        return true;
+    }
+    return false;
+}
+
+bool LiteralValue::parse(const char* first, const char* last, int64_t& value)
+{
+    bool negative = false;
+    if(first != last && (*first == '-' || *first == '+'))
+    {
+        negative = *first == '-';
+        ++first;
+    }
+
+    uint64_t magnitude;
+    if(!parseMagnitude(first, last, magnitude))
+    {
+        return false;
+    }
+
+    const uint64_t max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if(negative)
+    {
+        if(magnitude > max + 1)
+        {
+            return false;
+        }
+        // avoid overflow when negating the magnitude of the minimum
+        value = magnitude == max + 1 ? std::numeric_limits<int64_t>::min() : -static_cast<int64_t>(magnitude);
+    } else {
+        if(magnitude > max)
+        {
+            return false;
+        }
+        value = static_cast<int64_t>(magnitude);
+    }
+    return true;
+}
+
+bool LiteralValue::parse(const char* first, const char* last, uint64_t& value)
+{
+    if(first != last && *first == '+')
+    {
+        ++first;
+    } else if(last - first > 1 && *first == '-')
+    {
+        // '-0' is a valid lexical form of an unsigned value
+        for(const char* it = first + 1; it != last; ++it)
+        {
+            if(*it != '0')
+            {
+                return false;
+            }
+        }
+        value = 0;
+        return true;
+    }
+    return parseMagnitude(first, last, value);
+}
+
+bool LiteralValue::parse(const char* first, const char* last, double& value)
+{
+    if(matches(first, last, "INF") || matches(first, last, "+INF"))
+    {
+        value = std::numeric_limits<double>::infinity();
+        return true;
+    } else if(matches(first, last, "-INF"))
+    {
+        value = -std::numeric_limits<double>::infinity();
+        return true;
+    } else if(matches(first, last, "NaN"))
+    {
+        value = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+
+    // Restrict to the xsd lexical space, strtod would also accept
+    // hexadecimal values and spelled out special values
+    bool hasDigit = false;
+    for(const char* it = first; it != last; ++it)
+    {
+        if(isDigit(*it))
+        {
+            hasDigit = true;
+        } else if(*it != '.' && *it != '-' && *it != '+' && *it != 'e' && *it != 'E')
+        {
+            return false;
+        }
+    }
+    if(!hasDigit)
+    {
+        return false;
+    }
+
+    // strtod requires a null terminated string, so copy short values to the
+    // stack
+    char buffer[64];
+    const size_t length = last - first;
+    if(length < sizeof(buffer))
+    {
+        std::copy(first, last, buffer);
+        buffer[length] = '\0';
+        char* end = NULL;
+        value = strtod(buffer, &end);
+        return end == buffer + length;
+    }
+
+    const std::string lexical(first, last);
+    char* end = NULL;
+    value = strtod(lexical.c_str(), &end);
+    return end == lexical.c_str() + length;
+}
+
+bool LiteralValue::parseBoolean(const char* first, const char* last, bool& value)
+{
+    const size_t length = last - first;
+    if(length == 1 && (*first == '1' || *first == '0'))
+    {
+        value = *first == '1';
+        return true;
+    } else if(matches(first, last, "true"))
+    {
+        value = true;
+        return true;
+    } else if(matches(first, last, "false"))
+    {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+bool LiteralValue::parseDateTime(const char* first, const char* last, int64_t& value)
+{
+    const char* it = first;
+    bool negativeYear = false;
+    if(it != last && *it == '-')
+    {
+        negativeYear = true;
+        ++it;
+    }
+
+    // year: at least four digits
+    const char* yearStart = it;
+    while(it != last && isDigit(*it))
+    {
+        ++it;
+    }
+    uint64_t yearMagnitude;
+    if(it - yearStart < 4 || !parseMagnitude(yearStart, it, yearMagnitude) || yearMagnitude > 1000000000)
+    {
+        return false;
+    }
+    int64_t year = negativeYear ? -static_cast<int64_t>(yearMagnitude) : static_cast<int64_t>(yearMagnitude);
+
+    int month, day, hour, minute, second;
+    if(it == last || *it++ != '-' || !parseFixedDigits(it, last, 2, month)
+            || it == last || *it++ != '-' || !parseFixedDigits(it, last, 2, day)
+            || it == last || *it++ != 'T' || !parseFixedDigits(it, last, 2, hour)
+            || it == last || *it++ != ':' || !parseFixedDigits(it, last, 2, minute)
+            || it == last || *it++ != ':' || !parseFixedDigits(it, last, 2, second))
+    {
+        return false;
+    }
+
+    if(month < 1 || month > 12 || day < 1 || day > 31
+            || minute > 59 || second > 59)
+    {
+        return false;
+    }
+    // 24:00:00 is permitted as end of day
+    if(hour > 24 || (hour == 24 && (minute != 0 || second != 0)))
+    {
+        return false;
+    }
+
+    int64_t microseconds = 0;
+    if(it != last && *it == '.')
+    {
+        ++it;
+        const char* fractionStart = it;
+        int64_t scale = 100000;
+        while(it != last && isDigit(*it))
+        {
+            microseconds += (*it - '0')*scale;
+            scale /= 10;
+            ++it;
+        }
+        if(it == fractionStart)
+        {
+            return false;
+        }
+    }
+
+    int64_t offsetMinutes = 0;
+    if(it != last)
+    {
+        if(*it == 'Z')
+        {
+            ++it;
+        } else if(*it == '+' || *it == '-')
+        {
+            int sign = *it == '-' ? -1 : 1;
+            ++it;
+            int offsetHours, offsetMins;
+            if(!parseFixedDigits(it, last, 2, offsetHours)
+                    || it == last || *it++ != ':'
+                    || !parseFixedDigits(it, last, 2, offsetMins)
+                    || offsetHours > 14 || offsetMins > 59)
+            {
+                return false;
+            }
+            offsetMinutes = sign*(offsetHours*60 + offsetMins);
+        }
+    }
+    if(it != last)
+    {
+        return false;
+    }
+
+    int64_t seconds = daysFromCivil(year, month, day)*86400
+        + hour*3600 + minute*60 + second
+        - offsetMinutes*60;
+    value = seconds*1000000 + microseconds;
+    return true;
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,161 @@
+#ifndef OWLAPI_MODEL_LITERAL_VALUE_HPP
+#define OWLAPI_MODEL_LITERAL_VALUE_HPP
+
+#include <string>
+#include <stdint.h>
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class LiteralDatatype
+ * \brief Interning of datatype IRIs of literals
+ * \details Each datatype IRI is mapped to a small integer id, so that
+ * datatypes can be stored and compared without handling strings. The well
+ * known datatypes have fixed ids, all others are assigned on first use.
+ * Interning is thread-safe, ids remain valid for the lifetime of the process.
+ */
+class LiteralDatatype
+{
+public:
+    typedef uint32_t Id;
+
+    enum Known { UNTYPED = 0,
+        PLAIN_LITERAL,
+        STRING,
+        BOOLEAN,
+        DECIMAL,
+        INTEGER,
+        NON_NEGATIVE_INTEGER,
+        NON_POSITIVE_INTEGER,
+        POSITIVE_INTEGER,
+        NEGATIVE_INTEGER,
+        LONG,
+        INT,
+        SHORT,
+        BYTE,
+        UNSIGNED_LONG,
+        UNSIGNED_INT,
+        UNSIGNED_SHORT,
+        UNSIGNED_BYTE,
+        DOUBLE,
+        FLOAT,
+        DATE_TIME,
+        DATE_TIME_STAMP,
+        END_KNOWN
+    };
+
+    /**
+     * Get the id of a datatype, registering the datatype if it is not yet known
+     * \param iri full datatype IRI, an empty string maps to UNTYPED
+     */
+    static Id intern(const std::string& iri);
+
+    /**
+     * Get the id of a datatype without registering it
+     * \return true if the datatype is known, false otherwise
+     */
+    static bool find(const std::string& iri, Id& id);
+
+    /**
+     * Get the datatype IRI of an id
+     * \throw std::invalid_argument if the id is unknown
+     */
+    static const std::string& getIRI(Id id);
+};
+
+/**
+ * \class LiteralValue
+ * \brief Unboxed value of a literal
+ * \details Tagged union which holds the parsed value of a literal, so that
+ * numeric, boolean and dateTime values can be accessed without parsing the
+ * lexical form again. Values which do not fall in one of these categories,
+ * including values which do not comply with their datatype, are of kind
+ * STRING, i.e. only the lexical form is available.
+ *
+ * The parse functions follow the conventions of std::from_chars: they operate
+ * on the range [first, last), do not allocate, do not throw and only succeed
+ * if the full range has been consumed.
+ */
+class LiteralValue
+{
+public:
+    enum Kind { STRING = 0, INT64, UINT64, DOUBLE, BOOLEAN, DATE_TIME };
+
+    LiteralValue();
+
+    static LiteralValue fromInt64(int64_t value);
+    static LiteralValue fromUInt64(uint64_t value);
+    static LiteralValue fromDouble(double value);
+    static LiteralValue fromBoolean(bool value);
+    /**
+     * \param value microseconds since 1970-01-01T00:00:00Z
+     */
+    static LiteralValue fromDateTime(int64_t value);
+
+    /**
+     * Parse a lexical form according to its datatype
+     * \return the parsed value, or a value of kind STRING if the datatype has
+     * no unboxed representation or the lexical form is not valid
+     */
+    static LiteralValue parse(const std::string& lexicalForm, LiteralDatatype::Id datatype);
+
+    /**
+     * Get the kind of value a datatype maps to
+     */
+    static Kind getKind(LiteralDatatype::Id datatype);
+
+    Kind getKind() const { return mKind; }
+
+    bool isNumeric() const { return mKind == INT64 || mKind == UINT64 || mKind == DOUBLE; }
+
+    /// Raw accessors, only valid for the corresponding kind
+    int64_t asInt64() const { return mValue.i; }
+    uint64_t asUInt64() const { return mValue.u; }
+    double asDouble() const { return mValue.d; }
+    bool asBoolean() const { return mValue.b; }
+    int64_t asDateTime() const { return mValue.i; }
+
+    /**
+     * Convert a numeric value to the target type
+     * \return true if the value is numeric and fits the target type, false
+     * otherwise; integral targets accept integral values only
+     */
+    bool get(int32_t& value) const;
+    bool get(uint32_t& value) const;
+    bool get(int64_t& value) const;
+    bool get(uint64_t& value) const;
+    bool get(double& value) const;
+
+    static bool parse(const char* first, const char* last, int32_t& value);
+    static bool parse(const char* first, const char* last, uint32_t& value);
+    static bool parse(const char* first, const char* last, int64_t& value);
+    static bool parse(const char* first, const char* last, uint64_t& value);
+    static bool parse(const char* first, const char* last, double& value);
+    /**
+     * Parse an xsd:boolean, i.e. 'true', 'false', '1' or '0'
+     */
+    static bool parseBoolean(const char* first, const char* last, bool& value);
+    /**
+     * Parse an xsd:dateTime, e.g. 2018-03-01T12:00:00.5+01:00
+     * \param value microseconds since 1970-01-01T00:00:00Z, values without
+     * timezone are interpreted as UTC
+     */
+    static bool parseDateTime(const char* first, const char* last, int64_t& value);
+
+private:
+    union Value
+    {
+        int64_t i;
+        uint64_t u;
+        double d;
+        bool b;
+    };
+
+    Kind mKind;
+    Value mValue;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_LITERAL_VALUE_HPP
@@ -0,0 +1,126 @@
+#include "MemoryUsage.hpp"
+#include <sstream>
+#include <malloc.h>
+
+namespace owlapi {
+namespace model {
+
+void MemoryUsage::add(const std::string& structure, uint64_t count, uint64_t bytes)
+{
+    Entry entry;
+    entry.structure = structure;
+    entry.count = count;
+    entry.bytes = bytes;
+    mEntries.push_back(entry);
+}
+
+void MemoryUsage::add(const std::string& subsystem, const MemoryUsage& usage)
+{
+    for(const Entry& entry : usage.mEntries)
+    {
+        add(subsystem + "." + entry.structure, entry.count, entry.bytes);
+    }
+}
+
+namespace {
+
+bool isPartOf(const std::string& structure, const std::string& subsystem)
+{
+    if(structure.compare(0, subsystem.size(), subsystem) != 0)
+    {
+        return false;
+    }
+    return structure.size() == subsystem.size() || structure[subsystem.size()] == '.';
+}
+
+} // end anonymous namespace
+
+uint64_t MemoryUsage::getBytes(const std::string& structure) const
+{
+    uint64_t bytes = 0;
+    for(const Entry& entry : mEntries)
+    {
+        if(isPartOf(entry.structure, structure))
+        {
+            bytes += entry.bytes;
+        }
+    }
+    return bytes;
+}
+
+uint64_t MemoryUsage::getCount(const std::string& structure) const
+{
+    uint64_t count = 0;
+    for(const Entry& entry : mEntries)
+    {
+        if(isPartOf(entry.structure, structure))
+        {
+            count += entry.count;
+        }
+    }
+    return count;
+}
+
+uint64_t MemoryUsage::getTotalBytes() const
+{
+    uint64_t bytes = 0;
+    for(const Entry& entry : mEntries)
+    {
+        bytes += entry.bytes;
+    }
+    return bytes;
+}
+
+uint64_t MemoryUsage::getHeapBytes()
+{
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2,33)
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    struct mallinfo info = mallinfo();
+    // the fields are int and wrap above 2 GB
+    return static_cast<unsigned int>(info.uordblks) + static_cast<unsigned int>(info.hblkhd);
+#endif
+#else
+    return 0;
+#endif
+}
+
+void MemoryUsage::toJSON(std::ostream& out) const
+{
+    out << "{"
+        << "\n  \"total_bytes\": " << getTotalBytes() << ","
+        << "\n  \"heap_in_use_bytes\": " << getHeapBytes() << ","
+        << "\n  \"structures\": {";
+    for(EntryList::const_iterator cit = mEntries.begin(); cit != mEntries.end(); ++cit)
+    {
+        if(cit != mEntries.begin())
+        {
+            out << ",";
+        }
+        out << "\n    \"" << cit->structure << "\": {"
+            << "\"count\": " << cit->count
+            << ", \"bytes\": " << cit->bytes << "}";
+    }
+    out << (mEntries.empty() ? "}" : "\n  }") << "\n}";
+}
+
+std::string MemoryUsage::toJSON() const
+{
+    std::stringstream ss;
+    toJSON(ss);
+    return ss.str();
+}
+
+namespace memory {
+
+uint64_t heapBytes(const std::string& s)
+{
+    // Short strings are stored inline
+    return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+} // end namespace memory
+} // end namespace model
+} // end namespace owlapi
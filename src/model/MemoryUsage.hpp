@@ -0,0 +1,214 @@
+#ifndef OWLAPI_MODEL_MEMORY_USAGE_HPP
+#define OWLAPI_MODEL_MEMORY_USAGE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <tuple>
+#include <ostream>
+#include "../SharedPtr.hpp"
+#include "IRI.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class MemoryUsage
+ * \brief Estimated memory of the data structures of an ontology, its
+ * knowledge base and the caches built on top of them
+ * \details Each entry reports the number of elements and the bytes of a
+ * single structure, e.g. an entity map or an axiom index. The bytes are
+ * estimated by walking the containers: the node and bucket overhead of the
+ * standard library is added to the heap memory owned by the elements, e.g.
+ * strings and nested containers. Objects which are shared via pointers are
+ * accounted for by the structure which owns them, and memory which is
+ * allocated by the reasoner itself cannot be estimated; the difference
+ * to the heap of the process, \see getHeapBytes, gives an upper bound for
+ * it.
+ *
+ * An estimate takes time linear in the number of elements and does not
+ * modify the structures, so that it can be sampled periodically. As any
+ * other query of an ontology, it must not run concurrently with changes of
+ * the ontology; the only lock which is taken guards the taxonomy snapshot of
+ * background reasoning, \see KnowledgeBase::getMemoryUsage
+ *
+\verbatim
+    MemoryUsage usage = ontology->getMemoryUsage();
+    std::cout << usage.getBytes("index") << " bytes in axiom indexes" << std::endl;
+\endverbatim
+ */
+class MemoryUsage
+{
+public:
+    struct Entry
+    {
+        /// Name of the structure, where the dot separates subsystems, e.g.
+        /// kb.classes
+        std::string structure;
+        /// Number of elements, or 0 for a structure which does not consist
+        /// of countable elements, e.g. a closure
+        uint64_t count;
+        uint64_t bytes;
+    };
+
+    typedef std::vector<Entry> EntryList;
+
+    /// Bytes of the control block of a shared object created by
+    /// make_shared, i.e. the vtable pointer and both reference counts
+    static const uint64_t SHARED_OBJECT_OVERHEAD = sizeof(void*) + 2 * sizeof(int);
+
+    void add(const std::string& structure, uint64_t count, uint64_t bytes);
+
+    /**
+     * Add all entries of another estimate as entries of a subsystem
+     */
+    void add(const std::string& subsystem, const MemoryUsage& usage);
+
+    const EntryList& getEntries() const { return mEntries; }
+
+    /**
+     * Get the bytes of a structure, or of all structures of a subsystem
+     */
+    uint64_t getBytes(const std::string& structure) const;
+
+    /**
+     * Get the number of elements of a structure, or of all structures of a
+     * subsystem
+     */
+    uint64_t getCount(const std::string& structure) const;
+
+    uint64_t getTotalBytes() const;
+
+    /**
+     * Get the heap memory of the process which is currently in use
+     * \return bytes in use, or 0 if the allocator does not provide this
+     * information
+     */
+    static uint64_t getHeapBytes();
+
+    /**
+     * Write the estimate as JSON object with the total bytes, the heap
+     * bytes of the process and all structures
+     */
+    void toJSON(std::ostream& out) const;
+
+    std::string toJSON() const;
+
+private:
+    EntryList mEntries;
+};
+
+/**
+ * Estimators of the heap memory owned by a value, i.e. excluding the size
+ * of the value itself
+ * \details The overloads are declared first, so that they are found for the
+ * elements of nested containers
+ */
+namespace memory {
+
+/// Bytes of a tree node besides the value
+const uint64_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+/// Bytes of a hash table node besides the value, including the cached hash
+const uint64_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+template<typename T>
+uint64_t heapBytes(const T&) { return 0; }
+
+uint64_t heapBytes(const std::string& s);
+
+inline uint64_t heapBytes(const IRI& iri) { return iri.getMemoryUsage(); }
+
+template<typename A, typename B>
+uint64_t heapBytes(const std::pair<A, B>& pair);
+
+template<typename A, typename B, typename C>
+uint64_t heapBytes(const std::tuple<A, B, C>& tuple);
+
+template<typename T, typename Allocator>
+uint64_t heapBytes(const std::vector<T, Allocator>& vector);
+
+template<typename K, typename Compare, typename Allocator>
+uint64_t heapBytes(const std::set<K, Compare, Allocator>& set);
+
+template<typename K, typename V, typename Compare, typename Allocator>
+uint64_t heapBytes(const std::map<K, V, Compare, Allocator>& map);
+
+template<typename K, typename Hash, typename Equal, typename Allocator>
+uint64_t heapBytes(const std::unordered_set<K, Hash, Equal, Allocator>& set);
+
+template<typename K, typename V, typename Hash, typename Equal, typename Allocator>
+uint64_t heapBytes(const std::unordered_map<K, V, Hash, Equal, Allocator>& map);
+
+template<typename Iterator>
+uint64_t heapBytesOfElements(Iterator begin, Iterator end)
+{
+    uint64_t bytes = 0;
+    for(Iterator it = begin; it != end; ++it)
+    {
+        bytes += heapBytes(*it);
+    }
+    return bytes;
+}
+
+template<typename A, typename B>
+uint64_t heapBytes(const std::pair<A, B>& pair)
+{
+    return heapBytes(pair.first) + heapBytes(pair.second);
+}
+
+template<typename A, typename B, typename C>
+uint64_t heapBytes(const std::tuple<A, B, C>& tuple)
+{
+    return heapBytes(std::get<0>(tuple)) + heapBytes(std::get<1>(tuple)) + heapBytes(std::get<2>(tuple));
+}
+
+template<typename T, typename Allocator>
+uint64_t heapBytes(const std::vector<T, Allocator>& vector)
+{
+    return vector.capacity() * sizeof(T) + heapBytesOfElements(vector.begin(), vector.end());
+}
+
+template<typename K, typename Compare, typename Allocator>
+uint64_t heapBytes(const std::set<K, Compare, Allocator>& set)
+{
+    return set.size() * (TREE_NODE_OVERHEAD + sizeof(K)) + heapBytesOfElements(set.begin(), set.end());
+}
+
+template<typename K, typename V, typename Compare, typename Allocator>
+uint64_t heapBytes(const std::map<K, V, Compare, Allocator>& map)
+{
+    return map.size() * (TREE_NODE_OVERHEAD + sizeof(std::pair<const K, V>))
+        + heapBytesOfElements(map.begin(), map.end());
+}
+
+template<typename K, typename Hash, typename Equal, typename Allocator>
+uint64_t heapBytes(const std::unordered_set<K, Hash, Equal, Allocator>& set)
+{
+    return set.size() * (HASH_NODE_OVERHEAD + sizeof(K)) + set.bucket_count() * sizeof(void*)
+        + heapBytesOfElements(set.begin(), set.end());
+}
+
+template<typename K, typename V, typename Hash, typename Equal, typename Allocator>
+uint64_t heapBytes(const std::unordered_map<K, V, Hash, Equal, Allocator>& map)
+{
+    return map.size() * (HASH_NODE_OVERHEAD + sizeof(std::pair<const K, V>)) + map.bucket_count() * sizeof(void*)
+        + heapBytesOfElements(map.begin(), map.end());
+}
+
+/**
+ * Bytes of the objects of an entity map, which are owned by the map
+ */
+template<typename K, typename T, typename Compare, typename Allocator>
+uint64_t objectBytes(const std::map<K, shared_ptr<T>, Compare, Allocator>& map)
+{
+    return map.size() * (sizeof(T) + MemoryUsage::SHARED_OBJECT_OVERHEAD);
+}
+
+} // end namespace memory
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_MEMORY_USAGE_HPP
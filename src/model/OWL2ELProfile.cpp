@@ -0,0 +1,251 @@
+#include "OWL2ELProfile.hpp"
+#include "OWLAnnotation.hpp"
+#include "OWLInverseObjectProperty.hpp"
+#include "OWLObjectIntersectionOf.hpp"
+#include "OWLObjectOneOf.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLQuantifiedDataRestriction.hpp"
+#include "OWLDataOneOf.hpp"
+#include "OWLDataType.hpp"
+#include "OWLDataTypeRestriction.hpp"
+#include "OWLSubClassOfAxiom.hpp"
+#include "OWLEquivalentClassesAxiom.hpp"
+#include "OWLDisjointClassesAxiom.hpp"
+#include "OWLSubObjectPropertyOfAxiom.hpp"
+#include "OWLEquivalentObjectPropertiesAxiom.hpp"
+#include "OWLObjectPropertyDomainAxiom.hpp"
+#include "OWLObjectPropertyRangeAxiom.hpp"
+#include "OWLReflexiveObjectPropertyAxiom.hpp"
+#include "OWLTransitiveObjectPropertyAxiom.hpp"
+#include "OWLDataPropertyDomainAxiom.hpp"
+#include "OWLDataPropertyRangeAxiom.hpp"
+#include "OWLClassAssertionAxiom.hpp"
+#include "OWLObjectPropertyAssertionAxiom.hpp"
+#include "../vocabularies/OWL.hpp"
+#include "../vocabularies/RDF.hpp"
+#include "../vocabularies/RDFS.hpp"
+#include "../vocabularies/XSD.hpp"
+
+namespace owlapi {
+namespace model {
+
+OWL2ELProfile::Violations OWL2ELProfile::getViolations(const OWLOntology::Ptr& ontology)
+{
+    Violations violations;
+    for(const std::pair<const OWLAxiom::AxiomType, OWLAxiom::PtrList>& typedAxioms : ontology->getAxiomMap())
+    {
+        for(const OWLAxiom::Ptr& axiom : typedAxioms.second)
+        {
+            std::string reason = checkAxiom(axiom);
+            if(!reason.empty())
+            {
+                violations.push_back(Violation(axiom, reason));
+            }
+        }
+    }
+    return violations;
+}
+
+bool OWL2ELProfile::isInProfile(const OWLOntology::Ptr& ontology)
+{
+    for(const std::pair<const OWLAxiom::AxiomType, OWLAxiom::PtrList>& typedAxioms : ontology->getAxiomMap())
+    {
+        for(const OWLAxiom::Ptr& axiom : typedAxioms.second)
+        {
+            if(!checkAxiom(axiom).empty())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string OWL2ELProfile::checkAxiom(const OWLAxiom::Ptr& axiom)
+{
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::SubClassOf:
+        {
+            OWLSubClassOfAxiom::Ptr subClassAxiom = dynamic_pointer_cast<OWLSubClassOfAxiom>(axiom);
+            std::string reason = checkClassExpression(subClassAxiom->getSubClass());
+            return reason.empty() ? checkClassExpression(subClassAxiom->getSuperClass()) : reason;
+        }
+        case OWLAxiom::EquivalentClasses:
+            return checkClassExpressions(dynamic_pointer_cast<OWLEquivalentClassesAxiom>(axiom)->getEquivalentClasses());
+        case OWLAxiom::DisjointClasses:
+            return checkClassExpressions(dynamic_pointer_cast<OWLDisjointClassesAxiom>(axiom)->getClassExpressions());
+        case OWLAxiom::SubObjectPropertyOf:
+        {
+            OWLSubObjectPropertyOfAxiom::Ptr subPropertyAxiom = dynamic_pointer_cast<OWLSubObjectPropertyOfAxiom>(axiom);
+            std::string reason = checkObjectProperty(subPropertyAxiom->getSubProperty());
+            return reason.empty() ? checkObjectProperty(subPropertyAxiom->getSuperProperty()) : reason;
+        }
+        case OWLAxiom::EquivalentObjectProperties:
+            for(const OWLObjectPropertyExpression::Ptr& property :
+                    dynamic_pointer_cast<OWLEquivalentObjectPropertiesAxiom>(axiom)->getProperties())
+            {
+                std::string reason = checkObjectProperty(property);
+                if(!reason.empty())
+                {
+                    return reason;
+                }
+            }
+            return "";
+        case OWLAxiom::ObjectPropertyDomain:
+        {
+            OWLObjectPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLObjectPropertyDomainAxiom>(axiom);
+            std::string reason = checkObjectProperty(domainAxiom->getProperty());
+            return reason.empty() ? checkClassExpression(domainAxiom->getDomain()) : reason;
+        }
+        case OWLAxiom::ObjectPropertyRange:
+        {
+            OWLObjectPropertyRangeAxiom::Ptr rangeAxiom = dynamic_pointer_cast<OWLObjectPropertyRangeAxiom>(axiom);
+            std::string reason = checkObjectProperty(rangeAxiom->getProperty());
+            return reason.empty() ? checkClassExpression(rangeAxiom->getRange()) : reason;
+        }
+        case OWLAxiom::ReflexiveObjectProperty:
+            return checkObjectProperty(dynamic_pointer_cast<OWLReflexiveObjectPropertyAxiom>(axiom)->getProperty());
+        case OWLAxiom::TransitiveObjectProperty:
+            return checkObjectProperty(dynamic_pointer_cast<OWLTransitiveObjectPropertyAxiom>(axiom)->getProperty());
+        case OWLAxiom::DataPropertyDomain:
+            return checkClassExpression(dynamic_pointer_cast<OWLDataPropertyDomainAxiom>(axiom)->getDomain());
+        case OWLAxiom::DataPropertyRange:
+            return checkDataRange(dynamic_pointer_cast<OWLDataPropertyRangeAxiom>(axiom)->getRange());
+        case OWLAxiom::ClassAssertion:
+            return checkClassExpression(dynamic_pointer_cast<OWLClassAssertionAxiom>(axiom)->getClassExpression());
+        case OWLAxiom::ObjectPropertyAssertion:
+            return checkObjectProperty(dynamic_pointer_cast<OWLObjectPropertyAssertionAxiom>(axiom)->getProperty());
+        case OWLAxiom::DisjointUnion:
+        case OWLAxiom::DisjointObjectProperties:
+        case OWLAxiom::DisjointDataProperties:
+        case OWLAxiom::InverseObjectProperties:
+        case OWLAxiom::FunctionalObjectProperty:
+        case OWLAxiom::InverseFunctionalObjectProperty:
+        case OWLAxiom::IrreflexiveObjectProperty:
+        case OWLAxiom::SymmetricObjectProperty:
+        case OWLAxiom::AsymmetricObjectProperty:
+            return OWLAxiom::AxiomTypeTxt[axiom->getAxiomType()] + " axioms are not allowed";
+        default:
+            return "";
+    }
+}
+
+std::string OWL2ELProfile::checkClassExpression(const OWLClassExpression::Ptr& expression)
+{
+    switch(expression->getClassExpressionType())
+    {
+        case OWLClassExpression::OWL_CLASS:
+            return "";
+        case OWLClassExpression::OBJECT_INTERSECTION_OF:
+            return checkClassExpressions(dynamic_pointer_cast<OWLObjectIntersectionOf>(expression)->getOperands());
+        case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+        {
+            OWLQuantifiedObjectRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(expression);
+            std::string reason = checkObjectProperty(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty());
+            return reason.empty() ? checkClassExpression(restriction->getFiller()) : reason;
+        }
+        case OWLClassExpression::OBJECT_HAS_VALUE:
+        case OWLClassExpression::OBJECT_HAS_SELF:
+            return checkObjectProperty(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty());
+        case OWLClassExpression::OBJECT_ONE_OF:
+            if(dynamic_pointer_cast<OWLObjectOneOf>(expression)->getNamedIndividuals().size() != 1)
+            {
+                return "ObjectOneOf is only allowed with a single individual";
+            }
+            return "";
+        case OWLClassExpression::DATA_SOME_VALUES_FROM:
+            return checkDataRange(dynamic_pointer_cast<OWLQuantifiedDataRestriction>(expression)->getFiller());
+        case OWLClassExpression::DATA_HAS_VALUE:
+            return "";
+        default:
+            return OWLClassExpression::TypeTxt[expression->getClassExpressionType()] + " is not allowed";
+    }
+}
+
+std::string OWL2ELProfile::checkDataRange(const OWLDataRange::Ptr& range)
+{
+    if(OWLDataOneOf::Ptr oneOf = dynamic_pointer_cast<OWLDataOneOf>(range))
+    {
+        if(oneOf->getLiterals().size() != 1)
+        {
+            return "DataOneOf is only allowed with a single literal";
+        }
+        return "";
+    }
+
+    if(dynamic_pointer_cast<OWLDataTypeRestriction>(range))
+    {
+        return "DatatypeRestriction is not allowed";
+    }
+
+    switch(range->getDataRangeType())
+    {
+        case OWLDataRange::DATATYPE:
+        {
+            OWLDataType::Ptr datatype = dynamic_pointer_cast<OWLDataType>(range);
+            if(datatype && !isDatatypeAllowed(datatype->getIRI()))
+            {
+                return "Datatype '" + datatype->getIRI().toString() + "' is not allowed";
+            }
+            return "";
+        }
+        case OWLDataRange::DATA_UNION_OF:
+            return "DataUnionOf is not allowed";
+        case OWLDataRange::DATA_COMPLEMENT_OF:
+            return "DataComplementOf is not allowed";
+        default:
+            return "";
+    }
+}
+
+bool OWL2ELProfile::isDatatypeAllowed(const IRI& datatype)
+{
+    static const IRISet datatypes = {
+        vocabulary::RDF::PlainLiteral(),
+        vocabulary::RDF::XMLLiteral(),
+        vocabulary::RDFS::Literal(),
+        vocabulary::OWL::real(),
+        vocabulary::OWL::rational(),
+        vocabulary::XSD::decimal(),
+        vocabulary::XSD::integer(),
+        vocabulary::XSD::nonNegativeInteger(),
+        vocabulary::XSD::string(),
+        vocabulary::XSD::normalizedString(),
+        vocabulary::XSD::token(),
+        vocabulary::XSD::Name(),
+        vocabulary::XSD::NCName(),
+        vocabulary::XSD::NMTOKEN(),
+        vocabulary::XSD::hexBinary(),
+        vocabulary::XSD::base64Binary(),
+        vocabulary::XSD::anyURI(),
+        vocabulary::XSD::dateTime(),
+        vocabulary::XSD::dateTimeStamp()
+    };
+    return datatypes.count(datatype);
+}
+
+std::string OWL2ELProfile::checkObjectProperty(const OWLPropertyExpression::Ptr& property)
+{
+    if(dynamic_pointer_cast<OWLInverseObjectProperty>(property))
+    {
+        return "ObjectInverseOf is not allowed";
+    }
+    return "";
+}
+
+std::string OWL2ELProfile::checkClassExpressions(const OWLClassExpression::PtrList& expressions)
+{
+    for(const OWLClassExpression::Ptr& expression : expressions)
+    {
+        std::string reason = checkClassExpression(expression);
+        if(!reason.empty())
+        {
+            return reason;
+        }
+    }
+    return "";
+}
+
+} // end namespace model
+} // end namespace owlapi
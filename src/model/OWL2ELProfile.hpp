@@ -0,0 +1,89 @@
+#ifndef OWLAPI_MODEL_OWL2_EL_PROFILE_HPP
+#define OWLAPI_MODEL_OWL2_EL_PROFILE_HPP
+
+#include <string>
+#include <vector>
+#include "OWLOntology.hpp"
+#include "OWLDataRange.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class OWL2ELProfile
+ * \brief Checks whether the axioms of an ontology are within the OWL 2 EL
+ * profile
+ * \details OWL 2 EL permits intersections, existential restrictions,
+ * hasValue and hasSelf restrictions and singleton enumerations, but neither
+ * unions, complements, universal or cardinality restrictions, nor inverse
+ * properties. Property axioms are limited to sub/equivalent properties,
+ * domains, ranges and reflexive and transitive object properties. Datatypes
+ * are limited to the EL datatype map.
+ *
+ * \see https://www.w3.org/TR/owl2-profiles/#OWL_2_EL
+ */
+class OWL2ELProfile
+{
+public:
+    /**
+     * An axiom which is not within the profile
+     */
+    struct Violation
+    {
+        OWLAxiom::Ptr axiom;
+        std::string reason;
+
+        Violation(const OWLAxiom::Ptr& axiom, const std::string& reason)
+            : axiom(axiom)
+            , reason(reason)
+        {}
+    };
+
+    typedef std::vector<Violation> Violations;
+
+    /**
+     * Get all axioms of the ontology which are not within the profile
+     */
+    static Violations getViolations(const OWLOntology::Ptr& ontology);
+
+    /**
+     * Check whether all axioms of the ontology are within the profile
+     */
+    static bool isInProfile(const OWLOntology::Ptr& ontology);
+
+    /**
+     * Check a single axiom
+     * \return reason why the axiom is not within the profile, or an empty
+     * string if it is
+     */
+    static std::string checkAxiom(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Check a class expression and all of its nested expressions
+     * \return reason why the expression is not within the profile, or an
+     * empty string if it is
+     */
+    static std::string checkClassExpression(const OWLClassExpression::Ptr& expression);
+
+    /**
+     * Check a data range
+     * \return reason why the data range is not within the profile, or an
+     * empty string if it is
+     */
+    static std::string checkDataRange(const OWLDataRange::Ptr& range);
+
+    /**
+     * Check if a datatype is part of the OWL 2 EL datatype map, which
+     * excludes e.g. xsd:double, xsd:float and xsd:boolean
+     * \see https://www.w3.org/TR/owl2-profiles/#Entities
+     */
+    static bool isDatatypeAllowed(const IRI& datatype);
+
+private:
+    static std::string checkObjectProperty(const OWLPropertyExpression::Ptr& property);
+    static std::string checkClassExpressions(const OWLClassExpression::PtrList& expressions);
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_OWL2_EL_PROFILE_HPP
@@ -23,6 +23,7 @@ class OWLAnnotationAssertionAxiom : public OWLAnnotationAxiom, public HasSubject
 {
 public:
     typedef shared_ptr<OWLAnnotationAssertionAxiom> Ptr;
+    typedef std::vector<Ptr> PtrList;
 
     OWLAnnotationAssertionAxiom(const OWLAnnotationSubject::Ptr& subject,
             OWLAnnotationProperty::Ptr property,
@@ -1,5 +1,8 @@
 #include "OWLAxiom.hpp"
 #include "../OWLApi.hpp"
+#include "OWLDisjointObjectPropertiesAxiom.hpp"
+#include "OWLDisjointDataPropertiesAxiom.hpp"
+#include "OWLEquivalentDataPropertiesAxiom.hpp"
 
 #define VISIT_CASE_STATEMENT(X,Y) \
         case X: \
@@ -13,6 +16,10 @@
             break; \
         }
 
+#define SIZE_CASE_STATEMENT(X,Y) \
+        case X: \
+            return sizeof(Y);
+
 namespace owlapi {
 namespace model {
 
@@ -130,6 +137,52 @@ void OWLAxiom::accept(OWLAxiomVisitor* visitor) const
     }
 }
 
+size_t OWLAxiom::getObjectSize() const
+{
+    switch(getAxiomType())
+    {
+        SIZE_CASE_STATEMENT(Declaration, OWLDeclarationAxiom);
+
+        SIZE_CASE_STATEMENT(SubClassOf, OWLSubClassOfAxiom);
+        SIZE_CASE_STATEMENT(EquivalentClasses, OWLEquivalentClassesAxiom);
+        SIZE_CASE_STATEMENT(DisjointClasses, OWLDisjointClassesAxiom);
+        SIZE_CASE_STATEMENT(DisjointUnion, OWLDisjointUnionAxiom);
+
+        SIZE_CASE_STATEMENT(EquivalentObjectProperties, OWLEquivalentObjectPropertiesAxiom);
+        SIZE_CASE_STATEMENT(DisjointObjectProperties, OWLDisjointObjectPropertiesAxiom);
+        SIZE_CASE_STATEMENT(SubObjectPropertyOf, OWLSubObjectPropertyOfAxiom);
+        SIZE_CASE_STATEMENT(ObjectPropertyDomain, OWLObjectPropertyDomainAxiom);
+        SIZE_CASE_STATEMENT(ObjectPropertyRange, OWLObjectPropertyRangeAxiom);
+        SIZE_CASE_STATEMENT(InverseObjectProperties, OWLInverseObjectPropertiesAxiom);
+        SIZE_CASE_STATEMENT(FunctionalObjectProperty, OWLFunctionalObjectPropertyAxiom);
+        SIZE_CASE_STATEMENT(InverseFunctionalObjectProperty, OWLInverseFunctionalObjectPropertyAxiom);
+        SIZE_CASE_STATEMENT(ReflexiveObjectProperty, OWLReflexiveObjectPropertyAxiom);
+        SIZE_CASE_STATEMENT(IrreflexiveObjectProperty, OWLIrreflexiveObjectPropertyAxiom);
+        SIZE_CASE_STATEMENT(SymmetricObjectProperty, OWLSymmetricObjectPropertyAxiom);
+        SIZE_CASE_STATEMENT(AsymmetricObjectProperty, OWLAsymmetricObjectPropertyAxiom);
+        SIZE_CASE_STATEMENT(TransitiveObjectProperty, OWLTransitiveObjectPropertyAxiom);
+
+        SIZE_CASE_STATEMENT(SubDataPropertyOf, OWLSubDataPropertyOfAxiom);
+        SIZE_CASE_STATEMENT(DisjointDataProperties, OWLDisjointDataPropertiesAxiom);
+        SIZE_CASE_STATEMENT(EquivalentDataProperties, OWLEquivalentDataPropertiesAxiom);
+        SIZE_CASE_STATEMENT(FunctionalDataProperty, OWLFunctionalDataPropertyAxiom);
+        SIZE_CASE_STATEMENT(DataPropertyDomain, OWLDataPropertyDomainAxiom);
+        SIZE_CASE_STATEMENT(DataPropertyRange, OWLDataPropertyRangeAxiom);
+
+        SIZE_CASE_STATEMENT(ClassAssertion, OWLClassAssertionAxiom);
+        SIZE_CASE_STATEMENT(ObjectPropertyAssertion, OWLObjectPropertyAssertionAxiom);
+        SIZE_CASE_STATEMENT(DataPropertyAssertion, OWLDataPropertyAssertionAxiom);
+
+        SIZE_CASE_STATEMENT(SubAnnotationPropertyOf, OWLSubAnnotationPropertyOfAxiom);
+        SIZE_CASE_STATEMENT(AnnotationPropertyDomain, OWLAnnotationPropertyDomainAxiom);
+        SIZE_CASE_STATEMENT(AnnotationPropertyRange, OWLAnnotationPropertyRangeAxiom);
+        SIZE_CASE_STATEMENT(AnnotationAssertion, OWLAnnotationAssertionAxiom);
+
+        default:
+            return sizeof(OWLAxiom);
+    }
+}
+
 OWLAxiom::Ptr OWLAxiom::declare(const OWLEntity::Ptr& entity)
 {
     return make_shared<OWLDeclarationAxiom>(entity);
@@ -96,6 +96,13 @@ public:
      */
     void accept(OWLAxiomVisitor* visitor) const;
 
+    /**
+     * Get the size of the object, i.e. the size of the axiom class which
+     * corresponds to the axiom type
+     * \return bytes, excluding the heap memory owned by the axiom
+     */
+    size_t getObjectSize() const;
+
     /**
      * Determines if this axiom is a logical axiom. Logical axioms are defined
      * to be axioms other than both declaration axioms (including imports
@@ -1,15 +1,579 @@
 #include "OWLAxiomAddVisitor.hpp"
+#include "../KnowledgeBase.hpp"
+#include "OWLDataOneOf.hpp"
+#include "OWLDataHasValue.hpp"
+#include "OWLDataCardinalityRestriction.hpp"
+#include "OWLObjectCardinalityRestriction.hpp"
+#include "OWLObjectHasValue.hpp"
+#include "OWLObjectOneOf.hpp"
+#include "OWLObjectIntersectionOf.hpp"
+#include "OWLObjectUnionOf.hpp"
+#include "OWLObjectComplementOf.hpp"
 
 namespace owlapi {
 namespace model {
 
-OWLAxiomAddVisitor::OWLAxiomAddVisitor(const OWLOntology::Ptr& ontology)
+namespace {
+
+/**
+ * Get the IRI of a named property expression
+ * \return false if the property is not named, e.g. an inverse property
+ */
+bool getPropertyIRI(const OWLPropertyExpression::Ptr& expression, IRI& iri)
+{
+    OWLProperty::Ptr property = dynamic_pointer_cast<OWLProperty>(expression);
+    if(!property)
+    {
+        return false;
+    }
+    iri = property->getIRI();
+    return true;
+}
+
+} // end anonymous namespace
+
+OWLAxiomAddVisitor::OWLAxiomAddVisitor(OWLOntology* ontology)
     : mpOntology(ontology)
+    , mNumberOfAssertedAxioms(0)
 {}
 
+void OWLAxiomAddVisitor::add(const OWLAxiom::Ptr& axiom)
+{
+    index(axiom);
+    if(mpOntology->hasKnowledgeBase())
+    {
+        assertOnly(axiom);
+    }
+}
+
+void OWLAxiomAddVisitor::assertOnly(const OWLAxiom::Ptr& axiom)
+{
+    mpAxiom = axiom;
+    axiom->accept(this);
+    mpAxiom.reset();
+}
+
+void OWLAxiomAddVisitor::index(const OWLAxiom::Ptr& axiom)
+{
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+        {
+            OWLEntity::Ptr entity = dynamic_pointer_cast<OWLDeclarationAxiom>(axiom)->getEntity();
+            const IRI& iri = entity->getIRI();
+            switch(entity->getEntityType())
+            {
+                case OWLEntity::CLASS:
+                    if(!mpOntology->mClasses.count(iri))
+                    {
+                        mpOntology->mClasses[iri] = mpOntology->create<OWLClass>(iri);
+                    }
+                    break;
+                case OWLEntity::NAMED_INDIVIDUAL:
+                    if(!mpOntology->mNamedIndividuals.count(iri))
+                    {
+                        mpOntology->mNamedIndividuals[iri] = mpOntology->create<OWLNamedIndividual>(iri);
+                    }
+                    break;
+                case OWLEntity::OBJECT_PROPERTY:
+                    if(!mpOntology->mObjectProperties.count(iri))
+                    {
+                        mpOntology->mObjectProperties[iri] = mpOntology->create<OWLObjectProperty>(iri);
+                    }
+                    break;
+                case OWLEntity::DATA_PROPERTY:
+                    if(!mpOntology->mDataProperties.count(iri))
+                    {
+                        mpOntology->mDataProperties[iri] = mpOntology->create<OWLDataProperty>(iri);
+                    }
+                    break;
+                case OWLEntity::ANNOTATION_PROPERTY:
+                    if(!mpOntology->mAnnotationProperties.count(iri))
+                    {
+                        mpOntology->mAnnotationProperties[iri] = mpOntology->create<OWLAnnotationProperty>(iri);
+                    }
+                    break;
+                default:
+                    break;
+            }
+            break;
+        }
+        case OWLAxiom::SubClassOf:
+        {
+            OWLSubClassOfAxiom::Ptr subClassAxiom = dynamic_pointer_cast<OWLSubClassOfAxiom>(axiom);
+            mpOntology->mSubClassAxiomBySubPosition[subClassAxiom->getSubClass()].push_back(subClassAxiom);
+            mpOntology->mSubClassAxiomBySuperPosition[subClassAxiom->getSuperClass()].push_back(subClassAxiom);
+            break;
+        }
+        case OWLAxiom::ClassAssertion:
+        {
+            OWLClassAssertionAxiom::Ptr classAssertion = dynamic_pointer_cast<OWLClassAssertionAxiom>(axiom);
+            OWLClassExpression::Ptr e_class = classAssertion->getClassExpression();
+            OWLIndividual::Ptr e_individual = classAssertion->getIndividual();
+            mpOntology->mClassAssertionAxiomsByClass[e_class].push_back(classAssertion);
+            mpOntology->mClassAssertionAxiomsByIndividual[e_individual].push_back(classAssertion);
+
+            // the individual is unregistered, when its last class assertion has been
+            // retracted
+            OWLNamedIndividual::Ptr namedIndividual = dynamic_pointer_cast<OWLNamedIndividual>(e_individual);
+            if(namedIndividual)
+            {
+                mpOntology->mNamedIndividualAxioms[namedIndividual].push_back(axiom);
+                mpOntology->mNamedIndividuals[namedIndividual->getIRI()] = namedIndividual;
+            } else {
+                OWLAnonymousIndividual::Ptr anonymousIndividual = dynamic_pointer_cast<OWLAnonymousIndividual>(e_individual);
+                mpOntology->mAnonymousIndividualAxioms[anonymousIndividual].push_back(axiom);
+                mpOntology->mAnonymousIndividuals[anonymousIndividual->getReferenceID()] = anonymousIndividual;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void OWLAxiomAddVisitor::assertToKnowledgeBase(const reasoner::factpp::Axiom& kbAxiom)
+{
+    mpOntology->kb()->addReference(mpAxiom, kbAxiom);
+    ++mNumberOfAssertedAxioms;
+}
+
+bool OWLAxiomAddVisitor::getClassIRI(const OWLClassExpression::Ptr& expression, IRI& iri)
+{
+    OWLClass::Ptr klass = dynamic_pointer_cast<OWLClass>(expression);
+    if(klass)
+    {
+        iri = klass->getIRI();
+        return true;
+    }
+
+    if(mAnonymousClassExpressionIds.empty())
+    {
+        for(const std::pair<const IRI, OWLAnonymousClassExpression::Ptr>& p : mpOntology->mAnonymousClassExpressions)
+        {
+            mAnonymousClassExpressionIds[p.second] = p.first;
+        }
+    }
+
+    std::map<OWLClassExpression::Ptr, IRI>::const_iterator cit = mAnonymousClassExpressionIds.find(expression);
+    if(cit == mAnonymousClassExpressionIds.end())
+    {
+        return false;
+    }
+    iri = cit->second;
+    if(mDefinedClassExpressions.count(iri))
+    {
+        return true;
+    }
+    return defineClassExpression(iri, expression);
+}
+
+bool OWLAxiomAddVisitor::getClassIRIs(const OWLClassExpression::PtrList& expressions, IRIList& iris)
+{
+    for(const OWLClassExpression::Ptr& expression : expressions)
+    {
+        IRI iri;
+        if(!getClassIRI(expression, iri))
+        {
+            return false;
+        }
+        iris.push_back(iri);
+    }
+    return true;
+}
+
+bool OWLAxiomAddVisitor::defineClassExpression(const IRI& id, const OWLClassExpression::Ptr& expression)
+{
+    KnowledgeBase::Ptr kb = mpOntology->kb();
+    OWLClassExpression::ClassExpressionType type = expression->getClassExpressionType();
+    switch(type)
+    {
+        case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+        case OWLClassExpression::OBJECT_ALL_VALUES_FROM:
+        case OWLClassExpression::OBJECT_MIN_CARDINALITY:
+        case OWLClassExpression::OBJECT_MAX_CARDINALITY:
+        case OWLClassExpression::OBJECT_EXACT_CARDINALITY:
+        {
+            OWLQuantifiedObjectRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(expression);
+            IRI property;
+            if(!restriction || !getPropertyIRI(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty(), property))
+            {
+                return false;
+            }
+
+            // unqualified cardinality restrictions have no filler
+            IRI filler = vocabulary::OWL::Thing();
+            if(restriction->getFiller() && !getClassIRI(restriction->getFiller(), filler))
+            {
+                return false;
+            }
+
+            OWLCardinalityRestriction::Ptr cardinality = dynamic_pointer_cast<OWLCardinalityRestriction>(expression);
+            if(type == OWLClassExpression::OBJECT_SOME_VALUES_FROM)
+            {
+                kb->objectSomeValuesFrom(id, property, filler);
+            } else if(type == OWLClassExpression::OBJECT_ALL_VALUES_FROM)
+            {
+                kb->objectAllValuesFrom(id, property, filler);
+            } else if(type == OWLClassExpression::OBJECT_MIN_CARDINALITY)
+            {
+                kb->objectMinCardinality(id, cardinality->getCardinality(), property, filler);
+            } else if(type == OWLClassExpression::OBJECT_MAX_CARDINALITY)
+            {
+                kb->objectMaxCardinality(id, cardinality->getCardinality(), property, filler);
+            } else {
+                kb->objectExactCardinality(id, cardinality->getCardinality(), property, filler);
+            }
+            break;
+        }
+        case OWLClassExpression::OBJECT_HAS_VALUE:
+        {
+            OWLObjectHasValue::Ptr hasValue = dynamic_pointer_cast<OWLObjectHasValue>(expression);
+            IRI property;
+            if(!getPropertyIRI(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty(), property))
+            {
+                return false;
+            }
+            kb->objectHasValue(id, property, hasValue->getFiller()->getReferenceID());
+            break;
+        }
+        case OWLClassExpression::DATA_SOME_VALUES_FROM:
+        case OWLClassExpression::DATA_ALL_VALUES_FROM:
+        case OWLClassExpression::DATA_MIN_CARDINALITY:
+        case OWLClassExpression::DATA_MAX_CARDINALITY:
+        case OWLClassExpression::DATA_EXACT_CARDINALITY:
+        {
+            OWLQuantifiedDataRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedDataRestriction>(expression);
+            IRI property;
+            if(!restriction || !getPropertyIRI(dynamic_pointer_cast<OWLDataRestriction>(expression)->getProperty(), property))
+            {
+                return false;
+            }
+
+            OWLCardinalityRestriction::Ptr cardinality = dynamic_pointer_cast<OWLCardinalityRestriction>(expression);
+            const OWLDataRange::Ptr& filler = restriction->getFiller();
+            if(type == OWLClassExpression::DATA_SOME_VALUES_FROM)
+            {
+                kb->dataSomeValuesFrom(id, property, filler);
+            } else if(type == OWLClassExpression::DATA_ALL_VALUES_FROM)
+            {
+                kb->dataAllValuesFrom(id, property, filler);
+            } else if(type == OWLClassExpression::DATA_MIN_CARDINALITY)
+            {
+                kb->dataMinCardinality(id, cardinality->getCardinality(), property, filler);
+            } else if(type == OWLClassExpression::DATA_MAX_CARDINALITY)
+            {
+                kb->dataMaxCardinality(id, cardinality->getCardinality(), property, filler);
+            } else {
+                kb->dataExactCardinality(id, cardinality->getCardinality(), property, filler);
+            }
+            break;
+        }
+        case OWLClassExpression::DATA_HAS_VALUE:
+        {
+            OWLDataHasValue::Ptr hasValue = dynamic_pointer_cast<OWLDataHasValue>(expression);
+            IRI property;
+            if(!getPropertyIRI(dynamic_pointer_cast<OWLDataRestriction>(expression)->getProperty(), property))
+            {
+                return false;
+            }
+            kb->dataHasValue(id, property, hasValue->getFiller());
+            break;
+        }
+        case OWLClassExpression::OBJECT_INTERSECTION_OF:
+        case OWLClassExpression::OBJECT_UNION_OF:
+        {
+            shared_ptr<OWLNaryBooleanExpression> nary = dynamic_pointer_cast<OWLNaryBooleanExpression>(expression);
+            IRIList klasses;
+            if(!getClassIRIs(nary->getOperands(), klasses))
+            {
+                return false;
+            }
+            if(type == OWLClassExpression::OBJECT_INTERSECTION_OF)
+            {
+                kb->objectIntersectionOf(id, klasses);
+            } else {
+                kb->objectUnionOf(id, klasses);
+            }
+            break;
+        }
+        case OWLClassExpression::OBJECT_COMPLEMENT_OF:
+        {
+            OWLObjectComplementOf::Ptr complementOf = dynamic_pointer_cast<OWLObjectComplementOf>(expression);
+            IRI klass;
+            if(!getClassIRI(complementOf->getOperand(), klass))
+            {
+                return false;
+            }
+            kb->objectComplementOf(id, klass);
+            break;
+        }
+        case OWLClassExpression::OBJECT_ONE_OF:
+        {
+            OWLObjectOneOf::Ptr oneOf = dynamic_pointer_cast<OWLObjectOneOf>(expression);
+            IRIList instances;
+            for(const OWLNamedIndividual::Ptr& individual : oneOf->getNamedIndividuals())
+            {
+                instances.push_back(individual->getIRI());
+            }
+            kb->objectOneOf(id, instances);
+            break;
+        }
+        default:
+            return false;
+    }
+
+    mDefinedClassExpressions.insert(id);
+    return true;
+}
 
 void OWLAxiomAddVisitor::visit(const OWLDeclarationAxiom& axiom)
 {
+    OWLEntity::Ptr entity = axiom.getEntity();
+    const IRI& iri = entity->getIRI();
+    switch(entity->getEntityType())
+    {
+        case OWLEntity::CLASS:
+            mpOntology->kb()->getClassLazy(iri);
+            break;
+        case OWLEntity::NAMED_INDIVIDUAL:
+            mpOntology->kb()->getInstanceLazy(iri);
+            break;
+        case OWLEntity::OBJECT_PROPERTY:
+            mpOntology->kb()->getObjectPropertyLazy(iri);
+            break;
+        case OWLEntity::DATA_PROPERTY:
+            mpOntology->kb()->getDataPropertyLazy(iri);
+            break;
+        default:
+            break;
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLSubClassOfAxiom& axiom)
+{
+    IRIList klasses;
+    if(getClassIRIs({ axiom.getSubClass(), axiom.getSuperClass() }, klasses))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->subClassOf(klasses[0], klasses[1]) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLEquivalentClassesAxiom& axiom)
+{
+    IRIList klasses;
+    if(getClassIRIs(axiom.getEquivalentClasses(), klasses))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->equalClasses(klasses) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLDisjointClassesAxiom& axiom)
+{
+    IRIList klasses;
+    if(getClassIRIs(axiom.getClassExpressions(), klasses))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->disjoint(klasses, KnowledgeBase::CLASS) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLDisjointUnionAxiom& axiom)
+{
+    IRIList klasses;
+    if(getClassIRIs(axiom.getClassExpressions(), klasses))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->disjointUnion(axiom.getOWLClass()->getIRI(), klasses) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLEquivalentObjectPropertiesAxiom& axiom)
+{
+    IRIList properties;
+    for(const OWLObjectPropertyExpression::Ptr& expression : axiom.getProperties())
+    {
+        IRI property;
+        if(!getPropertyIRI(expression, property))
+        {
+            return;
+        }
+        properties.push_back(property);
+    }
+    assertToKnowledgeBase( mpOntology->kb()->equalObjectProperties(properties) );
+}
+
+void OWLAxiomAddVisitor::visit(const OWLSubObjectPropertyOfAxiom& axiom)
+{
+    IRI subProperty, superProperty;
+    if(getPropertyIRI(axiom.getSubProperty(), subProperty) && getPropertyIRI(axiom.getSuperProperty(), superProperty))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->subPropertyOf(subProperty, superProperty) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLObjectPropertyDomainAxiom& axiom)
+{
+    IRI property;
+    IRIList domain;
+    if(getPropertyIRI(axiom.getProperty(), property) && getClassIRIs({ axiom.getDomain() }, domain))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->domainOf(property, domain[0], KnowledgeBase::OBJECT) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLObjectPropertyRangeAxiom& axiom)
+{
+    IRI property;
+    IRIList range;
+    if(getPropertyIRI(axiom.getProperty(), property) && getClassIRIs({ axiom.getRange() }, range))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->objectRangeOf(property, range[0]) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLInverseObjectPropertiesAxiom& axiom)
+{
+    IRI first, second;
+    if(getPropertyIRI(axiom.getFirstProperty(), first) && getPropertyIRI(axiom.getSecondProperty(), second))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->inverseOf(first, second) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLFunctionalObjectPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->functionalProperty(property, KnowledgeBase::OBJECT) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLInverseFunctionalObjectPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->inverseFunctionalProperty(property) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLReflexiveObjectPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->reflexiveProperty(property) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLIrreflexiveObjectPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->irreflexiveProperty(property) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLSymmetricObjectPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->symmetricProperty(property) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLAsymmetricObjectPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->asymmetricProperty(property) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLTransitiveObjectPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->transitiveProperty(property) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLSubDataPropertyOfAxiom& axiom)
+{
+    IRI subProperty, superProperty;
+    if(getPropertyIRI(axiom.getSubProperty(), subProperty) && getPropertyIRI(axiom.getSuperProperty(), superProperty))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->subPropertyOf(subProperty, superProperty) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLFunctionalDataPropertyAxiom& axiom)
+{
+    IRI property;
+    if(getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->functionalProperty(property, KnowledgeBase::DATA) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLDataPropertyDomainAxiom& axiom)
+{
+    IRI property;
+    IRIList domain;
+    if(getPropertyIRI(axiom.getProperty(), property) && getClassIRIs({ axiom.getDomain() }, domain))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->domainOf(property, domain[0], KnowledgeBase::DATA) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLDataPropertyRangeAxiom& axiom)
+{
+    // as for OWLOntologyTell::dataPropertyRangeOf, only enumerations are
+    // supported by the knowledge base
+    IRI property;
+    OWLDataOneOf::Ptr oneOf = dynamic_pointer_cast<OWLDataOneOf>(axiom.getRange());
+    if(oneOf && getPropertyIRI(axiom.getProperty(), property))
+    {
+        reasoner::factpp::DataRange range = mpOntology->kb()->dataOneOf(oneOf->getLiterals());
+        assertToKnowledgeBase( mpOntology->kb()->dataRangeOf(property, range) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLClassAssertionAxiom& axiom)
+{
+    IRI klass;
+    if(getClassIRI(axiom.getClassExpression(), klass))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->instanceOf(axiom.getIndividual()->getReferenceID(), klass) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLObjectPropertyAssertionAxiom& axiom)
+{
+    IRI property;
+    OWLIndividual::Ptr object = dynamic_pointer_cast<OWLIndividual>(axiom.getObject());
+    if(object && getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->relatedTo(axiom.getSubject()->getReferenceID(),
+                    property,
+                    object->getReferenceID()) );
+    }
+}
+
+void OWLAxiomAddVisitor::visit(const OWLDataPropertyAssertionAxiom& axiom)
+{
+    IRI property;
+    OWLLiteral::Ptr literal = dynamic_pointer_cast<OWLLiteral>(axiom.getObject());
+    if(literal && getPropertyIRI(axiom.getProperty(), property))
+    {
+        assertToKnowledgeBase( mpOntology->kb()->valueOf(axiom.getSubject()->getReferenceID(),
+                    property,
+                    literal) );
+    }
 }
 
 } // end namespace mmodel
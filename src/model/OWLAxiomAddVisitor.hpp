@@ -3,19 +3,92 @@
 
 #include "OWLOntology.hpp"
 #include "OWLAxiomVisitor.hpp"
+#include "../reasoner/factpp/Types.hpp"
 
 namespace owlapi {
 namespace model {
 
+/**
+ * \class OWLAxiomAddVisitor
+ * \brief Registers an axiom, which has already been added to the axioms by
+ * type, in the type specific indexes of the ontology and asserts it to the
+ * knowledge base
+ * \details Axioms are asserted to the knowledge base if they only refer to
+ * named entities and to anonymous class expressions of the ontology --
+ * analogous to OWLOntologyTell, other axioms are only part of the model.
+ * For a structural ontology, axioms are only indexed
+ * \see OWLOntology::applyChanges, OWLOntology::attachKnowledgeBase
+ */
 class OWLAxiomAddVisitor : public OWLAxiomVisitor
 {
-    OWLOntology::Ptr mpOntology;
+    OWLOntology* mpOntology;
+
+    /// The axiom currently being added
+    OWLAxiom::Ptr mpAxiom;
+
+    /// Number of axioms that have been asserted to the knowledge base
+    size_t mNumberOfAssertedAxioms;
+
+    /// Ids of the ontology's anonymous class expressions, initialized on
+    /// first use
+    std::map<OWLClassExpression::Ptr, IRI> mAnonymousClassExpressionIds;
+    /// Anonymous class expressions which have been defined in the
+    /// knowledge base by this visitor
+    IRISet mDefinedClassExpressions;
+
+    void assertToKnowledgeBase(const reasoner::factpp::Axiom& kbAxiom);
+
+    /**
+     * Register the axiom in the type specific indexes of the ontology
+     */
+    void index(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Get the IRI under which the knowledge base knows a class expression
+     * \details Anonymous class expressions are (re)defined in the
+     * knowledge base on first use
+     * \return false if the expression is neither a named class nor an
+     * anonymous class expression of the ontology which the knowledge base
+     * can represent
+     */
+    bool getClassIRI(const OWLClassExpression::Ptr& expression, IRI& iri);
+
+    /**
+     * Collect the IRIs of the given class expressions
+     * \return false if any of the expressions cannot be resolved,
+     * \see getClassIRI
+     */
+    bool getClassIRIs(const OWLClassExpression::PtrList& expressions, IRIList& iris);
+
+    /**
+     * Define an anonymous class expression in the knowledge base
+     * \return false if the expression cannot be represented
+     */
+    bool defineClassExpression(const IRI& id, const OWLClassExpression::Ptr& expression);
 
 public:
-    OWLAxiomAddVisitor(const OWLOntology::Ptr& ontology);
+    OWLAxiomAddVisitor(OWLOntology* ontology);
 
     virtual ~OWLAxiomAddVisitor() {}
 
+    /**
+     * Add the given axiom
+     */
+    void add(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Assert an axiom, which is already registered in the ontology's
+     * indexes, to the knowledge base only
+     * \see OWLOntology::attachKnowledgeBase
+     */
+    void assertOnly(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Get the number of axioms, which have been asserted to the knowledge
+     * base
+     */
+    size_t getNumberOfAssertedAxioms() const { return mNumberOfAssertedAxioms; }
+
     AXIOM_VISITOR_VISIT_DECL(OWLDeclarationAxiom);
     NO_IMPL_AXIOM_VISITOR_VISIT(OWLClassAxiom);
     NO_IMPL_AXIOM_VISITOR_VISIT(OWLObjectPropertyAxiom);
@@ -25,46 +98,48 @@ public:
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLHasKeyAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLAnnotationAxiom);
 
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLSubClassOfAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLEquivalentClassesAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLDisjointClassesAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLDisjointUnionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSubClassOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLEquivalentClassesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDisjointClassesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDisjointUnionAxiom);
 
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLEquivalentObjectPropertiesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLEquivalentObjectPropertiesAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLDisjointObjectPropertiesAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLSubObjectPropertyOfAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLObjectPropertyDomainAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLObjectPropertyRangeAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLInverseObjectPropertiesAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLFunctionalObjectPropertyAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLInverseFunctionalObjectPropertyAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLReflexiveObjectPropertyAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLIrreflexiveObjectPropertyAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLSymmetricObjectPropertyAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLAsymmetricObjectPropertyAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLTransitiveObjectPropertyAxiom);
-
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLSubDataPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSubObjectPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyRangeAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLInverseObjectPropertiesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLFunctionalObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLInverseFunctionalObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLReflexiveObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLIrreflexiveObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSymmetricObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAsymmetricObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLTransitiveObjectPropertyAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLSubDataPropertyOfAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLDisjointDataPropertiesAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLEquivalentDataPropertiesAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLFunctionalDataPropertyAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLDataPropertyDomainAxiom);
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLDataPropertyRangeAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLFunctionalDataPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyRangeAxiom);
 
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLClassAssertionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLClassAssertionAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLSameIndividualAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLDifferentIndividualsAxiom);
 
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLObjectPropertyAssertionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyAssertionAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLNegativeObjectPropertyAssertion);
 
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLDataPropertyAssertionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyAssertionAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLNegativeDataPropertyAssertion);
 
-    //NO_IMPL_AXIOM_VISITOR_VISIT(OWLSubAnnotationPropertyOfAxiom);
-    //NO_IMPL_AXIOM_VISITOR_VISIT(OWLAnnotationPropertyDomainAxiom);
-    //NO_IMPL_AXIOM_VISITOR_VISIT(OWLAnnotationPropertyRangeAxiom);
-    //NO_IMPL_AXIOM_VISITOR_VISIT(OWLAnnotationAssertionAxiom);
+    // Annotations are not part of the knowledge base, annotation assertions
+    // are indexed by OWLOntology::indexAxiom
+    virtual void visit(const OWLSubAnnotationPropertyOfAxiom&) {}
+    virtual void visit(const OWLAnnotationPropertyDomainAxiom&) {}
+    virtual void visit(const OWLAnnotationPropertyRangeAxiom&) {}
+    virtual void visit(const OWLAnnotationAssertionAxiom&) {}
     //
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLSubPropertyChainOf),
 
@@ -13,6 +13,25 @@ void OWLAxiomRetractVisitor::visit(const OWLDeclarationAxiom& axiom)
 {
 }
 
+void OWLAxiomRetractVisitor::visit(const OWLSubClassOfAxiom& axiom)
+{
+    // Subclass axioms which have not been added through the tell interface
+    // are not part of the position indexes
+    for(std::vector<OWLSubClassOfAxiom::Ptr>* axioms : { &mpOntology->mSubClassAxiomBySubPosition[axiom.getSubClass()],
+            &mpOntology->mSubClassAxiomBySuperPosition[axiom.getSuperClass()] })
+    {
+        std::vector<OWLSubClassOfAxiom::Ptr>::iterator it = std::find_if(axioms->begin(), axioms->end(),
+                [&axiom](const OWLSubClassOfAxiom::Ptr& other)
+                {
+                    return other.get() == &axiom;
+                });
+        if(it != axioms->end())
+        {
+            axioms->erase(it);
+        }
+    }
+}
+
 void OWLAxiomRetractVisitor::visit(const OWLClassAssertionAxiom& axiom)
 {
     mpOntology->removeAxiomFromMap(mpOntology->mClassAssertionAxiomsByClass[axiom.getClassExpression()],
@@ -37,8 +56,9 @@ void OWLAxiomRetractVisitor::visit(const OWLClassAssertionAxiom& axiom)
 
     }
 
+    // the knowledge base is updated by the ontology, so that retractions
+    // can be batched
     axiom.markForRetraction();
-    mpOntology->cleanup();
 }
 
 } // end namespace mmodel
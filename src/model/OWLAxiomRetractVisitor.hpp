@@ -26,7 +26,7 @@ public:
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLHasKeyAxiom);
     //NO_IMPL_AXIOM_VISITOR_VISIT(OWLAnnotationAxiom);
 
-    NO_IMPL_AXIOM_VISITOR_VISIT(OWLSubClassOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSubClassOfAxiom);
     NO_IMPL_AXIOM_VISITOR_VISIT(OWLEquivalentClassesAxiom);
     NO_IMPL_AXIOM_VISITOR_VISIT(OWLDisjointClassesAxiom);
     NO_IMPL_AXIOM_VISITOR_VISIT(OWLDisjointUnionAxiom);
@@ -0,0 +1,417 @@
+#include "OWLAxiomSignatureVisitor.hpp"
+#include "OWLAnonymousIndividual.hpp"
+#include "OWLDataTypeRestriction.hpp"
+#include "OWLInverseObjectProperty.hpp"
+#include "OWLObjectComplementOf.hpp"
+#include "OWLObjectIntersectionOf.hpp"
+#include "OWLObjectUnionOf.hpp"
+#include "OWLObjectHasValue.hpp"
+#include "OWLObjectOneOf.hpp"
+#include "OWLQuantifiedDataRestriction.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLDisjointObjectPropertiesAxiom.hpp"
+#include "OWLDisjointDataPropertiesAxiom.hpp"
+#include "OWLEquivalentDataPropertiesAxiom.hpp"
+
+namespace owlapi {
+namespace model {
+
+IRIList OWLAxiomSignatureVisitor::getSignature(const OWLAxiom::Ptr& axiom)
+{
+    OWLAxiomSignatureVisitor visitor;
+    visitor.collect(axiom);
+    return visitor.mSignature;
+}
+
+void OWLAxiomSignatureVisitor::collect(const OWLAxiom::Ptr& axiom)
+{
+    // axiom types without a visitor implementation
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::DisjointObjectProperties:
+            for(const OWLObjectPropertyExpression::Ptr& property : dynamic_pointer_cast<OWLDisjointObjectPropertiesAxiom>(axiom)->getProperties())
+            {
+                addProperty(property);
+            }
+            break;
+        case OWLAxiom::DisjointDataProperties:
+            for(const OWLDataPropertyExpression::Ptr& property : dynamic_pointer_cast<OWLDisjointDataPropertiesAxiom>(axiom)->getProperties())
+            {
+                addProperty(property);
+            }
+            break;
+        case OWLAxiom::EquivalentDataProperties:
+            for(const OWLDataPropertyExpression::Ptr& property : dynamic_pointer_cast<OWLEquivalentDataPropertiesAxiom>(axiom)->getProperties())
+            {
+                addProperty(property);
+            }
+            break;
+        default:
+            axiom->accept(this);
+            break;
+    }
+}
+
+void OWLAxiomSignatureVisitor::add(const IRI& iri)
+{
+    if(iri.empty())
+    {
+        return;
+    }
+    // signatures are small, so a linear search is sufficient
+    if(mSignature.end() == std::find(mSignature.begin(), mSignature.end(), iri))
+    {
+        mSignature.push_back(iri);
+    }
+}
+
+void OWLAxiomSignatureVisitor::addIndividual(const OWLIndividual::Ptr& individual)
+{
+    if(individual)
+    {
+        add(individual->getReferenceID());
+    }
+}
+
+void OWLAxiomSignatureVisitor::addProperty(const OWLPropertyExpression::Ptr& property)
+{
+    if(!property)
+    {
+        return;
+    }
+
+    OWLProperty::Ptr namedProperty = dynamic_pointer_cast<OWLProperty>(property);
+    if(namedProperty)
+    {
+        add(namedProperty->getIRI());
+        return;
+    }
+
+    shared_ptr<OWLInverseObjectProperty> inverseProperty = dynamic_pointer_cast<OWLInverseObjectProperty>(property);
+    if(inverseProperty)
+    {
+        addProperty(inverseProperty->getInverse());
+    }
+}
+
+void OWLAxiomSignatureVisitor::addClassExpression(const OWLClassExpression::Ptr& classExpression)
+{
+    if(!classExpression)
+    {
+        return;
+    }
+
+    if(mCollectExpressions && classExpression->getClassExpressionType() != OWLClassExpression::OWL_CLASS)
+    {
+        mClassExpressions.insert(classExpression.get());
+    }
+
+    switch(classExpression->getClassExpressionType())
+    {
+        case OWLClassExpression::OWL_CLASS:
+            add(dynamic_pointer_cast<OWLClass>(classExpression)->getIRI());
+            return;
+        case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+        case OWLClassExpression::OBJECT_ALL_VALUES_FROM:
+        case OWLClassExpression::OBJECT_EXACT_CARDINALITY:
+        case OWLClassExpression::OBJECT_MIN_CARDINALITY:
+        case OWLClassExpression::OBJECT_MAX_CARDINALITY:
+        {
+            addRestrictionProperty(classExpression);
+            OWLQuantifiedObjectRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(classExpression);
+            if(restriction)
+            {
+                addClassExpression(restriction->getFiller());
+            }
+            return;
+        }
+        case OWLClassExpression::DATA_SOME_VALUES_FROM:
+        case OWLClassExpression::DATA_ALL_VALUES_FROM:
+        case OWLClassExpression::DATA_EXACT_CARDINALITY:
+        case OWLClassExpression::DATA_MIN_CARDINALITY:
+        case OWLClassExpression::DATA_MAX_CARDINALITY:
+        {
+            addRestrictionProperty(classExpression);
+            OWLQuantifiedDataRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedDataRestriction>(classExpression);
+            if(restriction)
+            {
+                addDataRange(restriction->getFiller());
+            }
+            return;
+        }
+        case OWLClassExpression::OBJECT_HAS_VALUE:
+        {
+            addRestrictionProperty(classExpression);
+            OWLObjectHasValue::Ptr restriction = dynamic_pointer_cast<OWLObjectHasValue>(classExpression);
+            if(restriction)
+            {
+                addIndividual(restriction->getFiller());
+            }
+            return;
+        }
+        case OWLClassExpression::DATA_HAS_VALUE:
+        case OWLClassExpression::OBJECT_HAS_SELF:
+            addRestrictionProperty(classExpression);
+            return;
+        case OWLClassExpression::OBJECT_COMPLEMENT_OF:
+            addClassExpression(dynamic_pointer_cast<OWLObjectComplementOf>(classExpression)->getOperand());
+            return;
+        case OWLClassExpression::OBJECT_ONE_OF:
+        {
+            OWLObjectOneOf::Ptr oneOf = dynamic_pointer_cast<OWLObjectOneOf>(classExpression);
+            for(const OWLNamedIndividual::Ptr& individual : oneOf->getNamedIndividuals())
+            {
+                addIndividual(individual);
+            }
+            return;
+        }
+        default:
+            break;
+    }
+
+    // Union and intersection
+    shared_ptr<OWLNaryBooleanExpression> booleanExpression = dynamic_pointer_cast<OWLNaryBooleanExpression>(classExpression);
+    if(booleanExpression)
+    {
+        for(const OWLClassExpression::Ptr& operand : booleanExpression->getOperands())
+        {
+            addClassExpression(operand);
+        }
+    }
+}
+
+void OWLAxiomSignatureVisitor::addRestrictionProperty(const OWLClassExpression::Ptr& restriction)
+{
+    OWLObjectRestriction::Ptr objectRestriction = dynamic_pointer_cast<OWLObjectRestriction>(restriction);
+    if(objectRestriction)
+    {
+        addProperty(objectRestriction->getProperty());
+        return;
+    }
+
+    OWLDataRestriction::Ptr dataRestriction = dynamic_pointer_cast<OWLDataRestriction>(restriction);
+    if(dataRestriction)
+    {
+        addProperty(dataRestriction->getProperty());
+    }
+}
+
+void OWLAxiomSignatureVisitor::addDataRange(const OWLDataRange::Ptr& range)
+{
+    if(!range)
+    {
+        return;
+    }
+
+    if(mCollectExpressions)
+    {
+        mDataRanges.insert(range.get());
+    }
+
+    switch(range->getDataRangeType())
+    {
+        case OWLDataRange::DATATYPE:
+            add(dynamic_pointer_cast<OWLDataType>(range)->getIRI());
+            break;
+        case OWLDataRange::DATATYPE_RESTRICTION:
+            add(dynamic_pointer_cast<OWLDataTypeRestriction>(range)->getDataType().getIRI());
+            break;
+        default:
+            break;
+    }
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLDeclarationAxiom& axiom)
+{
+    if(axiom.getEntity())
+    {
+        add(axiom.getEntity()->getIRI());
+    }
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLClassAxiom&)
+{}
+
+void OWLAxiomSignatureVisitor::visit(const OWLObjectPropertyAxiom&)
+{}
+
+void OWLAxiomSignatureVisitor::visit(const OWLDataPropertyAxiom&)
+{}
+
+void OWLAxiomSignatureVisitor::visit(const OWLSubClassOfAxiom& axiom)
+{
+    addClassExpression(axiom.getSubClass());
+    addClassExpression(axiom.getSuperClass());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLEquivalentClassesAxiom& axiom)
+{
+    for(const OWLClassExpression::Ptr& klass : axiom.getEquivalentClasses())
+    {
+        addClassExpression(klass);
+    }
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLDisjointClassesAxiom& axiom)
+{
+    for(const OWLClassExpression::Ptr& klass : axiom.getClassExpressions())
+    {
+        addClassExpression(klass);
+    }
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLDisjointUnionAxiom& axiom)
+{
+    addClassExpression(axiom.getOWLClass());
+    for(const OWLClassExpression::Ptr& klass : axiom.getClassExpressions())
+    {
+        addClassExpression(klass);
+    }
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLEquivalentObjectPropertiesAxiom& axiom)
+{
+    for(const OWLObjectPropertyExpression::Ptr& property : axiom.getProperties())
+    {
+        addProperty(property);
+    }
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLSubObjectPropertyOfAxiom& axiom)
+{
+    addProperty(axiom.getSubProperty());
+    addProperty(axiom.getSuperProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLObjectPropertyDomainAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+    addClassExpression(axiom.getDomain());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLObjectPropertyRangeAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+    addClassExpression(axiom.getRange());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLInverseObjectPropertiesAxiom& axiom)
+{
+    addProperty(axiom.getFirstProperty());
+    addProperty(axiom.getSecondProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLFunctionalObjectPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLInverseFunctionalObjectPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLReflexiveObjectPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLIrreflexiveObjectPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLSymmetricObjectPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLAsymmetricObjectPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLTransitiveObjectPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLSubDataPropertyOfAxiom& axiom)
+{
+    addProperty(axiom.getSubProperty());
+    addProperty(axiom.getSuperProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLFunctionalDataPropertyAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLDataPropertyDomainAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+    addClassExpression(axiom.getDomain());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLDataPropertyRangeAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+    addDataRange(axiom.getRange());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLClassAssertionAxiom& axiom)
+{
+    addIndividual(axiom.getIndividual());
+    addClassExpression(axiom.getClassExpression());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLObjectPropertyAssertionAxiom& axiom)
+{
+    addIndividual(axiom.getSubject());
+    addProperty(axiom.getProperty());
+    addIndividual(dynamic_pointer_cast<OWLIndividual>(axiom.getObject()));
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLDataPropertyAssertionAxiom& axiom)
+{
+    addIndividual(axiom.getSubject());
+    addProperty(axiom.getProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLSubAnnotationPropertyOfAxiom& axiom)
+{
+    addProperty(axiom.getSubProperty());
+    addProperty(axiom.getSuperProperty());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLAnnotationPropertyDomainAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+    add(axiom.getDomain());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLAnnotationPropertyRangeAxiom& axiom)
+{
+    addProperty(axiom.getProperty());
+    add(axiom.getRange());
+}
+
+void OWLAxiomSignatureVisitor::visit(const OWLAnnotationAssertionAxiom& axiom)
+{
+    const OWLAnnotationSubject::Ptr& subject = axiom.getSubject();
+    switch(subject->getObjectType())
+    {
+        case OWLObject::IRIType:
+            add(*dynamic_pointer_cast<IRI>(subject));
+            break;
+        case OWLObject::AnonymousIndividual:
+            add(dynamic_pointer_cast<OWLAnonymousIndividual>(subject)->getReferenceID());
+            break;
+        default:
+            break;
+    }
+    addProperty(axiom.getProperty());
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,117 @@
+#ifndef OWLAPI_MODEL_OWL_AXIOM_SIGNATURE_VISITOR_HPP
+#define OWLAPI_MODEL_OWL_AXIOM_SIGNATURE_VISITOR_HPP
+
+#include <unordered_set>
+#include "OWLAxiomVisitor.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class OWLAxiomSignatureVisitor
+ * \brief Collects the IRIs of all entities an axiom refers to
+ * \details Anonymous individuals are collected by their reference id, and the
+ * subject of an annotation assertion is collected as well. Class expressions
+ * and data ranges are traversed recursively.
+ */
+class OWLAxiomSignatureVisitor : public OWLAxiomVisitor
+{
+public:
+    /**
+     * \param collectExpressions Whether to collect the traversed anonymous
+     * class expressions and data ranges as well
+     */
+    OWLAxiomSignatureVisitor(bool collectExpressions = false)
+        : mCollectExpressions(collectExpressions)
+    {}
+
+    virtual ~OWLAxiomSignatureVisitor() {}
+
+    /**
+     * Get the signature of an axiom
+     * \return list of unique IRIs
+     */
+    static IRIList getSignature(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Get the signature collected so far
+     */
+    const IRIList& getSignature() const { return mSignature; }
+
+    /**
+     * Add the signature of an axiom to the signature collected so far
+     */
+    void collect(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Get the anonymous class expressions, including nested ones, collected
+     * so far
+     */
+    const std::unordered_set<const OWLClassExpression*>& getClassExpressions() const { return mClassExpressions; }
+
+    /**
+     * Get the data ranges collected so far
+     */
+    const std::unordered_set<const OWLDataRange*>& getDataRanges() const { return mDataRanges; }
+
+    void reset()
+    {
+        mSignature.clear();
+        mClassExpressions.clear();
+        mDataRanges.clear();
+    }
+
+    AXIOM_VISITOR_VISIT_DECL(OWLDeclarationAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLClassAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLSubClassOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLEquivalentClassesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDisjointClassesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDisjointUnionAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLEquivalentObjectPropertiesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSubObjectPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyRangeAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLInverseObjectPropertiesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLFunctionalObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLInverseFunctionalObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLReflexiveObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLIrreflexiveObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSymmetricObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAsymmetricObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLTransitiveObjectPropertyAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLSubDataPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLFunctionalDataPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyRangeAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLClassAssertionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyAssertionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyAssertionAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLSubAnnotationPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAnnotationPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAnnotationPropertyRangeAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAnnotationAssertionAxiom);
+
+private:
+    void add(const IRI& iri);
+    void addIndividual(const OWLIndividual::Ptr& individual);
+    void addProperty(const OWLPropertyExpression::Ptr& property);
+    void addClassExpression(const OWLClassExpression::Ptr& classExpression);
+    void addRestrictionProperty(const OWLClassExpression::Ptr& restriction);
+    void addDataRange(const OWLDataRange::Ptr& range);
+
+    IRIList mSignature;
+    bool mCollectExpressions;
+    std::unordered_set<const OWLClassExpression*> mClassExpressions;
+    std::unordered_set<const OWLDataRange*> mDataRanges;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_OWL_AXIOM_SIGNATURE_VISITOR_HPP
@@ -0,0 +1,521 @@
+#include "OWLAxiomStructureVisitor.hpp"
+#include <algorithm>
+#include <sstream>
+#include "OWLAnonymousIndividual.hpp"
+#include "OWLCardinalityRestriction.hpp"
+#include "OWLDataHasValue.hpp"
+#include "OWLDataOneOf.hpp"
+#include "OWLDataTypeRestriction.hpp"
+#include "OWLInverseObjectProperty.hpp"
+#include "OWLObjectComplementOf.hpp"
+#include "OWLObjectIntersectionOf.hpp"
+#include "OWLObjectUnionOf.hpp"
+#include "OWLObjectHasValue.hpp"
+#include "OWLObjectOneOf.hpp"
+#include "OWLQuantifiedDataRestriction.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLDisjointObjectPropertiesAxiom.hpp"
+#include "OWLDisjointDataPropertiesAxiom.hpp"
+#include "OWLEquivalentDataPropertiesAxiom.hpp"
+
+namespace owlapi {
+namespace model {
+
+std::string OWLAxiomStructureVisitor::getKey(const OWLAxiom::Ptr& axiom)
+{
+    OWLAxiomStructureVisitor visitor;
+    std::vector<std::string> operands;
+    // axiom types without a visitor implementation
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::DisjointObjectProperties:
+            for(const OWLObjectPropertyExpression::Ptr& property : dynamic_pointer_cast<OWLDisjointObjectPropertiesAxiom>(axiom)->getProperties())
+            {
+                operands.push_back(renderProperty(property));
+            }
+            visitor.set(*axiom, operands, true);
+            break;
+        case OWLAxiom::DisjointDataProperties:
+            for(const OWLDataPropertyExpression::Ptr& property : dynamic_pointer_cast<OWLDisjointDataPropertiesAxiom>(axiom)->getProperties())
+            {
+                operands.push_back(renderProperty(property));
+            }
+            visitor.set(*axiom, operands, true);
+            break;
+        case OWLAxiom::EquivalentDataProperties:
+            for(const OWLDataPropertyExpression::Ptr& property : dynamic_pointer_cast<OWLEquivalentDataPropertiesAxiom>(axiom)->getProperties())
+            {
+                operands.push_back(renderProperty(property));
+            }
+            visitor.set(*axiom, operands, true);
+            break;
+        default:
+            axiom->accept(&visitor);
+            break;
+    }
+
+    if(visitor.mKey.empty())
+    {
+        // no structural rendering available
+        return compose(OWLAxiom::AxiomTypeTxt[axiom->getAxiomType()], { renderUnknown(axiom.get()) });
+    }
+    return visitor.mKey;
+}
+
+std::string OWLAxiomStructureVisitor::render(const IRI& iri)
+{
+    return "<" + iri.toString() + ">";
+}
+
+std::string OWLAxiomStructureVisitor::renderIndividual(const OWLIndividual::Ptr& individual)
+{
+    if(!individual)
+    {
+        return "?";
+    }
+    return render(individual->getReferenceID());
+}
+
+std::string OWLAxiomStructureVisitor::renderLiteral(const OWLLiteral::Ptr& literal)
+{
+    if(!literal)
+    {
+        return "?";
+    }
+    return "\"" + literal->toString() + "\"";
+}
+
+std::string OWLAxiomStructureVisitor::renderProperty(const OWLPropertyExpression::Ptr& property)
+{
+    if(!property)
+    {
+        return "?";
+    }
+
+    OWLProperty::Ptr namedProperty = dynamic_pointer_cast<OWLProperty>(property);
+    if(namedProperty)
+    {
+        return render(namedProperty->getIRI());
+    }
+
+    shared_ptr<OWLInverseObjectProperty> inverseProperty = dynamic_pointer_cast<OWLInverseObjectProperty>(property);
+    if(inverseProperty)
+    {
+        return compose("ObjectInverseOf", { renderProperty(inverseProperty->getInverse()) });
+    }
+    return renderUnknown(property.get());
+}
+
+std::string OWLAxiomStructureVisitor::renderRestrictionProperty(const OWLClassExpression::Ptr& restriction)
+{
+    OWLObjectRestriction::Ptr objectRestriction = dynamic_pointer_cast<OWLObjectRestriction>(restriction);
+    if(objectRestriction)
+    {
+        return renderProperty(objectRestriction->getProperty());
+    }
+
+    OWLDataRestriction::Ptr dataRestriction = dynamic_pointer_cast<OWLDataRestriction>(restriction);
+    if(dataRestriction)
+    {
+        return renderProperty(dataRestriction->getProperty());
+    }
+    return "?";
+}
+
+std::string OWLAxiomStructureVisitor::renderClassExpression(const OWLClassExpression::Ptr& classExpression)
+{
+    if(!classExpression)
+    {
+        return "?";
+    }
+
+    OWLClassExpression::ClassExpressionType type = classExpression->getClassExpressionType();
+    const std::string& name = OWLClassExpression::TypeTxt[type];
+    switch(type)
+    {
+        case OWLClassExpression::OWL_CLASS:
+            return render(dynamic_pointer_cast<OWLClass>(classExpression)->getIRI());
+        case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+        case OWLClassExpression::OBJECT_ALL_VALUES_FROM:
+        case OWLClassExpression::OBJECT_EXACT_CARDINALITY:
+        case OWLClassExpression::OBJECT_MIN_CARDINALITY:
+        case OWLClassExpression::OBJECT_MAX_CARDINALITY:
+        {
+            OWLQuantifiedObjectRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(classExpression);
+            if(!restriction)
+            {
+                break;
+            }
+            std::vector<std::string> operands;
+            OWLCardinalityRestriction::Ptr cardinality = dynamic_pointer_cast<OWLCardinalityRestriction>(classExpression);
+            if(cardinality)
+            {
+                operands.push_back(std::to_string(cardinality->getCardinality()));
+            }
+            operands.push_back(renderRestrictionProperty(classExpression));
+            operands.push_back(renderClassExpression(restriction->getFiller()));
+            return compose(name, operands);
+        }
+        case OWLClassExpression::DATA_SOME_VALUES_FROM:
+        case OWLClassExpression::DATA_ALL_VALUES_FROM:
+        case OWLClassExpression::DATA_EXACT_CARDINALITY:
+        case OWLClassExpression::DATA_MIN_CARDINALITY:
+        case OWLClassExpression::DATA_MAX_CARDINALITY:
+        {
+            OWLQuantifiedDataRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedDataRestriction>(classExpression);
+            if(!restriction)
+            {
+                break;
+            }
+            std::vector<std::string> operands;
+            OWLCardinalityRestriction::Ptr cardinality = dynamic_pointer_cast<OWLCardinalityRestriction>(classExpression);
+            if(cardinality)
+            {
+                operands.push_back(std::to_string(cardinality->getCardinality()));
+            }
+            operands.push_back(renderRestrictionProperty(classExpression));
+            operands.push_back(renderDataRange(restriction->getFiller()));
+            return compose(name, operands);
+        }
+        case OWLClassExpression::OBJECT_HAS_VALUE:
+        {
+            OWLObjectHasValue::Ptr restriction = dynamic_pointer_cast<OWLObjectHasValue>(classExpression);
+            if(!restriction)
+            {
+                break;
+            }
+            return compose(name, { renderRestrictionProperty(classExpression),
+                    renderIndividual(restriction->getFiller()) });
+        }
+        case OWLClassExpression::DATA_HAS_VALUE:
+        {
+            OWLDataHasValue::Ptr restriction = dynamic_pointer_cast<OWLDataHasValue>(classExpression);
+            if(!restriction)
+            {
+                break;
+            }
+            return compose(name, { renderRestrictionProperty(classExpression),
+                    renderLiteral(restriction->getFiller()) });
+        }
+        case OWLClassExpression::OBJECT_HAS_SELF:
+            return compose(name, { renderRestrictionProperty(classExpression) });
+        case OWLClassExpression::OBJECT_COMPLEMENT_OF:
+            return compose(name, { renderClassExpression(dynamic_pointer_cast<OWLObjectComplementOf>(classExpression)->getOperand()) });
+        case OWLClassExpression::OBJECT_ONE_OF:
+        {
+            std::vector<std::string> operands;
+            for(const OWLNamedIndividual::Ptr& individual : dynamic_pointer_cast<OWLObjectOneOf>(classExpression)->getNamedIndividuals())
+            {
+                operands.push_back(renderIndividual(individual));
+            }
+            return compose(name, operands, true);
+        }
+        default:
+            break;
+    }
+
+    // Union and intersection
+    shared_ptr<OWLNaryBooleanExpression> booleanExpression = dynamic_pointer_cast<OWLNaryBooleanExpression>(classExpression);
+    if(booleanExpression)
+    {
+        std::vector<std::string> operands;
+        for(const OWLClassExpression::Ptr& operand : booleanExpression->getOperands())
+        {
+            operands.push_back(renderClassExpression(operand));
+        }
+        return compose(name, operands, true);
+    }
+    return renderUnknown(classExpression.get());
+}
+
+std::string OWLAxiomStructureVisitor::renderDataRange(const OWLDataRange::Ptr& range)
+{
+    if(!range)
+    {
+        return "?";
+    }
+
+    switch(range->getDataRangeType())
+    {
+        case OWLDataRange::DATATYPE:
+            return render(dynamic_pointer_cast<OWLDataType>(range)->getIRI());
+        case OWLDataRange::DATATYPE_RESTRICTION:
+        {
+            OWLDataTypeRestriction::Ptr restriction = dynamic_pointer_cast<OWLDataTypeRestriction>(range);
+            std::vector<std::string> facets;
+            for(const OWLFacetRestriction& facet : restriction->getFacetRestrictions())
+            {
+                facets.push_back(render(facet.getFacet().getIRI()) + " " + renderLiteral(facet.getFacetValue()));
+            }
+            std::sort(facets.begin(), facets.end());
+            facets.insert(facets.begin(), render(restriction->getDataType().getIRI()));
+            return compose("DatatypeRestriction", facets);
+        }
+        case OWLDataRange::DATA_ONE_OF:
+        {
+            std::vector<std::string> operands;
+            for(const OWLLiteral::Ptr& literal : dynamic_pointer_cast<OWLDataOneOf>(range)->getLiterals())
+            {
+                operands.push_back(renderLiteral(literal));
+            }
+            return compose("DataOneOf", operands, true);
+        }
+        default:
+            break;
+    }
+    return renderUnknown(range.get());
+}
+
+std::string OWLAxiomStructureVisitor::renderUnknown(const void* object)
+{
+    std::stringstream ss;
+    ss << "?" << object;
+    return ss.str();
+}
+
+std::string OWLAxiomStructureVisitor::compose(const std::string& name, std::vector<std::string> operands, bool sorted)
+{
+    if(sorted)
+    {
+        std::sort(operands.begin(), operands.end());
+    }
+
+    std::string key = name + "(";
+    for(size_t i = 0; i < operands.size(); ++i)
+    {
+        if(i != 0)
+        {
+            key += " ";
+        }
+        key += operands[i];
+    }
+    return key + ")";
+}
+
+void OWLAxiomStructureVisitor::set(const OWLAxiom& axiom, const std::vector<std::string>& operands, bool sorted)
+{
+    mKey = compose(OWLAxiom::AxiomTypeTxt[axiom.getAxiomType()], operands, sorted);
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLDeclarationAxiom& axiom)
+{
+    const OWLEntity::Ptr& entity = axiom.getEntity();
+    if(entity)
+    {
+        // Declaration shares its value with UNKOWN in AxiomTypeTxt
+        mKey = compose("Declaration", { OWLEntity::TypeTxt[entity->getEntityType()], render(entity->getIRI()) });
+    }
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLClassAxiom&)
+{}
+
+void OWLAxiomStructureVisitor::visit(const OWLObjectPropertyAxiom&)
+{}
+
+void OWLAxiomStructureVisitor::visit(const OWLDataPropertyAxiom&)
+{}
+
+void OWLAxiomStructureVisitor::visit(const OWLSubClassOfAxiom& axiom)
+{
+    set(axiom, { renderClassExpression(axiom.getSubClass()),
+            renderClassExpression(axiom.getSuperClass()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLEquivalentClassesAxiom& axiom)
+{
+    std::vector<std::string> operands;
+    for(const OWLClassExpression::Ptr& klass : axiom.getEquivalentClasses())
+    {
+        operands.push_back(renderClassExpression(klass));
+    }
+    set(axiom, operands, true);
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLDisjointClassesAxiom& axiom)
+{
+    std::vector<std::string> operands;
+    for(const OWLClassExpression::Ptr& klass : axiom.getClassExpressions())
+    {
+        operands.push_back(renderClassExpression(klass));
+    }
+    set(axiom, operands, true);
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLDisjointUnionAxiom& axiom)
+{
+    std::vector<std::string> operands;
+    for(const OWLClassExpression::Ptr& klass : axiom.getClassExpressions())
+    {
+        operands.push_back(renderClassExpression(klass));
+    }
+    set(axiom, { renderClassExpression(axiom.getOWLClass()), compose("", operands, true) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLEquivalentObjectPropertiesAxiom& axiom)
+{
+    std::vector<std::string> operands;
+    for(const OWLObjectPropertyExpression::Ptr& property : axiom.getProperties())
+    {
+        operands.push_back(renderProperty(property));
+    }
+    set(axiom, operands, true);
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLSubObjectPropertyOfAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getSubProperty()),
+            renderProperty(axiom.getSuperProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLObjectPropertyDomainAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()),
+            renderClassExpression(axiom.getDomain()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLObjectPropertyRangeAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()),
+            renderClassExpression(axiom.getRange()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLInverseObjectPropertiesAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getFirstProperty()),
+            renderProperty(axiom.getSecondProperty()) }, true);
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLFunctionalObjectPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLInverseFunctionalObjectPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLReflexiveObjectPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLIrreflexiveObjectPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLSymmetricObjectPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLAsymmetricObjectPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLTransitiveObjectPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLSubDataPropertyOfAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getSubProperty()),
+            renderProperty(axiom.getSuperProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLFunctionalDataPropertyAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLDataPropertyDomainAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()),
+            renderClassExpression(axiom.getDomain()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLDataPropertyRangeAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()),
+            renderDataRange(axiom.getRange()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLClassAssertionAxiom& axiom)
+{
+    set(axiom, { renderClassExpression(axiom.getClassExpression()),
+            renderIndividual(axiom.getIndividual()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLObjectPropertyAssertionAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()),
+            renderIndividual(axiom.getSubject()),
+            renderIndividual(dynamic_pointer_cast<OWLIndividual>(axiom.getObject())) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLDataPropertyAssertionAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()),
+            renderIndividual(axiom.getSubject()),
+            renderLiteral(dynamic_pointer_cast<OWLLiteral>(axiom.getObject())) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLSubAnnotationPropertyOfAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getSubProperty()),
+            renderProperty(axiom.getSuperProperty()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLAnnotationPropertyDomainAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()), render(axiom.getDomain()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLAnnotationPropertyRangeAxiom& axiom)
+{
+    set(axiom, { renderProperty(axiom.getProperty()), render(axiom.getRange()) });
+}
+
+void OWLAxiomStructureVisitor::visit(const OWLAnnotationAssertionAxiom& axiom)
+{
+    std::string subject;
+    const OWLAnnotationSubject::Ptr& annotationSubject = axiom.getSubject();
+    switch(annotationSubject->getObjectType())
+    {
+        case OWLObject::IRIType:
+            subject = render(*dynamic_pointer_cast<IRI>(annotationSubject));
+            break;
+        case OWLObject::AnonymousIndividual:
+            subject = render(dynamic_pointer_cast<OWLAnonymousIndividual>(annotationSubject)->getReferenceID());
+            break;
+        default:
+            subject = renderUnknown(annotationSubject.get());
+            break;
+    }
+
+    std::string value;
+    const OWLAnnotationValue::Ptr& annotationValue = axiom.annotationValue();
+    switch(annotationValue->getObjectType())
+    {
+        case OWLObject::IRIType:
+            value = render(*dynamic_pointer_cast<IRI>(annotationValue));
+            break;
+        case OWLObject::Literal:
+            value = renderLiteral(dynamic_pointer_cast<OWLLiteral>(annotationValue));
+            break;
+        case OWLObject::AnonymousIndividual:
+            value = render(dynamic_pointer_cast<OWLAnonymousIndividual>(annotationValue)->getReferenceID());
+            break;
+        default:
+            value = renderUnknown(annotationValue.get());
+            break;
+    }
+    set(axiom, { renderProperty(axiom.getProperty()), subject, value });
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,95 @@
+#ifndef OWLAPI_MODEL_OWL_AXIOM_STRUCTURE_VISITOR_HPP
+#define OWLAPI_MODEL_OWL_AXIOM_STRUCTURE_VISITOR_HPP
+
+#include "OWLAxiomVisitor.hpp"
+#include "OWLLiteral.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class OWLAxiomStructureVisitor
+ * \brief Renders an axiom into a canonical key, so that structurally equal
+ * axioms of different ontology objects can be matched
+ * \details The key follows the functional syntax, where the operands of n-ary
+ * constructs are sorted. Axiom annotations are not part of the key.
+ * Expressions which cannot be rendered are keyed by their address, i.e.
+ * axioms containing them never match
+ */
+class OWLAxiomStructureVisitor : public OWLAxiomVisitor
+{
+public:
+    virtual ~OWLAxiomStructureVisitor() {}
+
+    /**
+     * Get the structural key of an axiom
+     * \return canonical key
+     */
+    static std::string getKey(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Get the key of the last visited axiom
+     */
+    const std::string& getKey() const { return mKey; }
+
+    AXIOM_VISITOR_VISIT_DECL(OWLDeclarationAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLClassAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLSubClassOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLEquivalentClassesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDisjointClassesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDisjointUnionAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLEquivalentObjectPropertiesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSubObjectPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyRangeAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLInverseObjectPropertiesAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLFunctionalObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLInverseFunctionalObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLReflexiveObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLIrreflexiveObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLSymmetricObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAsymmetricObjectPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLTransitiveObjectPropertyAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLSubDataPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLFunctionalDataPropertyAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyRangeAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLClassAssertionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLObjectPropertyAssertionAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLDataPropertyAssertionAxiom);
+
+    AXIOM_VISITOR_VISIT_DECL(OWLSubAnnotationPropertyOfAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAnnotationPropertyDomainAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAnnotationPropertyRangeAxiom);
+    AXIOM_VISITOR_VISIT_DECL(OWLAnnotationAssertionAxiom);
+
+private:
+    static std::string render(const IRI& iri);
+    static std::string renderIndividual(const OWLIndividual::Ptr& individual);
+    static std::string renderLiteral(const OWLLiteral::Ptr& literal);
+    static std::string renderProperty(const OWLPropertyExpression::Ptr& property);
+    static std::string renderRestrictionProperty(const OWLClassExpression::Ptr& restriction);
+    static std::string renderClassExpression(const OWLClassExpression::Ptr& classExpression);
+    static std::string renderDataRange(const OWLDataRange::Ptr& range);
+    static std::string renderUnknown(const void* object);
+
+    /**
+     * Render a construct from the given name and operands
+     * \param sorted If true, the operands are sorted, i.e. they form a set
+     */
+    static std::string compose(const std::string& name, std::vector<std::string> operands, bool sorted = false);
+
+    void set(const OWLAxiom& axiom, const std::vector<std::string>& operands, bool sorted = false);
+
+    std::string mKey;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_OWL_AXIOM_STRUCTURE_VISITOR_HPP
@@ -1,6 +1,8 @@
 #ifndef OWLAPI_MODEL_OWL_BOOLEAN_CLASS_EXPRESSION_HPP
 #define OWLAPI_MODEL_OWL_BOOLEAN_CLASS_EXPRESSION_HPP
 
+#include "OWLAnonymousClassExpression.hpp"
+
 namespace owlapi {
 namespace model {
 
@@ -2,6 +2,7 @@
 #include "../Vocabulary.hpp"
 #include "OWLDataOneOf.hpp"
 #include "OWLDataTypeRestriction.hpp"
+#include "DataRangeValidator.hpp"
 
 namespace owlapi {
 namespace model {
@@ -11,7 +12,8 @@ OWLDataType::OWLDataType(const IRI& iri, OWLDataRange::Type type)
     , OWLLogicalEntity(iri, OWLEntity::DATATYPE)
 {}
 
-OWLDataType OWLDataType::fromRange(const OWLDataRange::Ptr& range, const std::string& value)
+OWLDataType OWLDataType::fromRange(const OWLDataRange::Ptr& range, const std::string& value,
+        const DataRangeValidator::Ptr& validator)
 {
     switch(range->getDataRangeType())
     {
@@ -45,13 +47,12 @@ OWLDataType OWLDataType::fromRange(const OWLDataRange::Ptr& range, const std::st
             owlapi::model::OWLDataTypeRestriction::Ptr datatypeRestriction = dynamic_pointer_cast<OWLDataTypeRestriction>(range);
             if(datatypeRestriction)
             {
-                bool isCompliant = true;
-                for(const OWLFacetRestriction restriction : datatypeRestriction->getFacetRestrictions())
+                DataRangeValidator::Ptr restrictionValidator = validator;
+                if(!restrictionValidator)
                 {
-                    restriction.isCompliant(value);
+                    restrictionValidator = DataRangeValidator::compile(datatypeRestriction);
                 }
-
-                if(isCompliant)
+                if(restrictionValidator->isValid(value))
                 {
                     return datatypeRestriction->getDataType();
                 }
@@ -7,6 +7,8 @@
 namespace owlapi {
 namespace model {
 
+class DataRangeValidator;
+
 class OWLDataType : public OWLDataRange, public OWLLogicalEntity
 {
 public:
@@ -19,8 +21,12 @@ public:
      * Pick the datatype for a given value, by picking from the options defined
      * by the data range
      * \param range OWLDataRange include DATATYPE, ONE_OF, ...
+     * \param validator Compiled form of a DATATYPE_RESTRICTION range, which is
+     * compiled for this call if not given, \see
+     * OWLOntologyAsk::getDataRangeValidator
      */
-    static OWLDataType fromRange(const OWLDataRange::Ptr& range, const std::string& value = "");
+    static OWLDataType fromRange(const OWLDataRange::Ptr& range, const std::string& value = "",
+            const shared_ptr<DataRangeValidator>& validator = shared_ptr<DataRangeValidator>());
 
     // OWL2DataType getBuiltInDataType() const;
 
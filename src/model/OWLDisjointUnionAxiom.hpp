@@ -16,10 +16,20 @@ class OWLDisjointUnionAxiom : public OWLClassAxiom
 public:
     OWLDisjointUnionAxiom(OWLClass::Ptr owlClass, OWLClassExpression::PtrList classExpressions, OWLAnnotationList annotations = OWLAnnotationList())
         : OWLClassAxiom(DisjointUnion, annotations)
+        , mClass(owlClass)
+        , mClassExpressions(classExpressions)
     {}
 
     virtual ~OWLDisjointUnionAxiom() {}
 
+    const OWLClass::Ptr& getOWLClass() const { return mClass; }
+
+    const OWLClassExpression::PtrList& getClassExpressions() const { return mClassExpressions; }
+
+private:
+    OWLClass::Ptr mClass;
+    OWLClassExpression::PtrList mClassExpressions;
+
 };
 
 } // end namespace model
@@ -3,19 +3,25 @@
 #include "OWLLiteralDouble.hpp"
 #include "OWLLiteralNonNegativeInteger.hpp"
 #include <owlapi/Vocabulary.hpp>
-#include <boost/lexical_cast.hpp>
 #include <base-logging/Logging.hpp>
 
 namespace owlapi {
 namespace model {
 
 OWLLiteral::OWLLiteral()
-    : mType(vocabulary::RDF::PlainLiteral().toString())
+    : mDatatype(LiteralDatatype::PLAIN_LITERAL)
 {}
 
 OWLLiteral::OWLLiteral(const std::string& value, const std::string& type)
     : mValue(value)
-    , mType(type)
+    , mDatatype(LiteralDatatype::intern(type))
+    , mLiteralValue(LiteralValue::parse(mValue, mDatatype))
+{}
+
+OWLLiteral::OWLLiteral(const std::string& value, LiteralDatatype::Id datatype)
+    : mValue(value)
+    , mDatatype(datatype)
+    , mLiteralValue(LiteralValue::parse(mValue, mDatatype))
 {}
 
 OWLLiteral::OWLLiteral(const std::string& value)
@@ -24,13 +30,20 @@ OWLLiteral::OWLLiteral(const std::string& value)
     if(std::string::npos != pos)
     {
         mValue = value.substr(0, pos);
-        mType = value.substr(pos+2);
+        mDatatype = LiteralDatatype::intern(value.substr(pos+2));
+        mLiteralValue = LiteralValue::parse(mValue, mDatatype);
     } else {
         mValue = value;
-        mType = vocabulary::RDF::PlainLiteral().toString();
+        mDatatype = LiteralDatatype::PLAIN_LITERAL;
     }
 }
 
+void OWLLiteral::setType(const std::string& type)
+{
+    mDatatype = LiteralDatatype::intern(type);
+    mLiteralValue = LiteralValue::parse(mValue, mDatatype);
+}
+
 bool OWLLiteral::isTyped() const
 {
     return !isPlainLiteral();
@@ -38,7 +51,8 @@ bool OWLLiteral::isTyped() const
 
 bool OWLLiteral::hasType(const IRI& typeIRI) const
 {
-    return typeIRI.toString() == mType;
+    LiteralDatatype::Id datatype;
+    return LiteralDatatype::find(typeIRI.toString(), datatype) && datatype == mDatatype;
 }
 
 std::string OWLLiteral::toString() const
@@ -47,31 +61,40 @@ std::string OWLLiteral::toString() const
     {
         return mValue;
     } else {
-        return mValue + "^^" + mType;
+        return mValue + "^^" + getType();
     }
 }
 
 OWLLiteral::Ptr OWLLiteral::create(const std::string& literal)
 {
-    OWLLiteral testLiteral(literal);
-    IRI type = testLiteral.mType;
-    if(type == vocabulary::XSD::integer() || type == vocabulary::XSD::resolve("int"))
-    {
-        return OWLLiteral::Ptr(new OWLLiteralInteger(literal));
-    } else if(type == vocabulary::XSD::nonNegativeInteger())
-    {
-        return OWLLiteral::Ptr(new OWLLiteralNonNegativeInteger(literal));
-    } else if(type == vocabulary::XSD::resolve("double") )
+    size_t pos = literal.find("^^");
+    if(std::string::npos != pos)
     {
-        return OWLLiteral::Ptr(new OWLLiteralDouble(literal));
-    } else {
-        return OWLLiteral::Ptr(new OWLLiteral(literal));
+        return create(literal.substr(0, pos), literal.substr(pos+2));
     }
+    return OWLLiteral::Ptr(new OWLLiteral(literal, LiteralDatatype::PLAIN_LITERAL));
 }
 
 OWLLiteral::Ptr OWLLiteral::create(const std::string& literal, const OWLDataType& type)
 {
-    return create( literal + "^^" + type.getIRI().toString());
+    return create(literal, type.getIRI().toString());
+}
+
+OWLLiteral::Ptr OWLLiteral::create(const std::string& value, const std::string& type)
+{
+    LiteralDatatype::Id datatype = type.empty() ? static_cast<LiteralDatatype::Id>(LiteralDatatype::PLAIN_LITERAL) : LiteralDatatype::intern(type);
+    switch(datatype)
+    {
+        case LiteralDatatype::INTEGER:
+        case LiteralDatatype::INT:
+            return OWLLiteral::Ptr(new OWLLiteralInteger(value, datatype));
+        case LiteralDatatype::NON_NEGATIVE_INTEGER:
+            return OWLLiteral::Ptr(new OWLLiteralNonNegativeInteger(value, datatype));
+        case LiteralDatatype::DOUBLE:
+            return OWLLiteral::Ptr(new OWLLiteralDouble(value, datatype));
+        default:
+            return OWLLiteral::Ptr(new OWLLiteral(value, datatype));
+    }
 }
 
 OWLLiteral::Ptr OWLLiteral::integer(int32_t value)
@@ -91,32 +114,35 @@ OWLLiteral::Ptr OWLLiteral::doubleValue(double value)
 
 unsigned int OWLLiteral::getNonNegativeInteger() const
 {
-    try {
-        return boost::lexical_cast<unsigned int>(mValue);
-    } catch(const std::bad_cast& e)
+    uint32_t value;
+    if(mLiteralValue.get(value)
+            || LiteralValue::parse(mValue.data(), mValue.data() + mValue.size(), value))
     {
-        throw std::runtime_error("OWLLiteral::getNonNegativeInteger not implemented for '" + mValue + "' and given type: '" + mType + "'");
+        return value;
     }
+    throw std::runtime_error("OWLLiteral::getNonNegativeInteger not implemented for '" + mValue + "' and given type: '" + getType() + "'");
 }
 
 int OWLLiteral::getInteger() const
 {
-    try {
-        return boost::lexical_cast<int>(mValue);
-    } catch(const std::bad_cast& e)
+    int32_t value;
+    if(mLiteralValue.get(value)
+            || LiteralValue::parse(mValue.data(), mValue.data() + mValue.size(), value))
     {
-        throw std::runtime_error("OWLLiteral::getInteger not implemented for '" + mValue + "' and given type: '" + mType + "'");
+        return value;
     }
+    throw std::runtime_error("OWLLiteral::getInteger not implemented for '" + mValue + "' and given type: '" + getType() + "'");
 }
 
 double OWLLiteral::getDouble() const
 {
-    try {
-        return boost::lexical_cast<double>(mValue);
-    } catch(const std::bad_cast& e)
+    double value;
+    if(mLiteralValue.get(value)
+            || LiteralValue::parse(mValue.data(), mValue.data() + mValue.size(), value))
     {
-        throw std::runtime_error("OWLLiteral::getDouble not implemented for '" + mValue + "' and given type: '" + mType + "'");
+        return value;
     }
+    throw std::runtime_error("OWLLiteral::getDouble not implemented for '" + mValue + "' and given type: '" + getType() + "'");
 }
 
 IRIList OWLLiteral::toIRIList(const OWLLiteral::PtrList& literals)
@@ -7,6 +7,7 @@
 #include "OWLDataType.hpp"
 #include "OWLPropertyAssertionObject.hpp"
 #include "OWLAnnotationValue.hpp"
+#include "LiteralValue.hpp"
 
 namespace owlapi {
 namespace model {
@@ -24,17 +25,24 @@ namespace model {
  *  "abc". Literals of the form "abc@langTag"^^rdf:PlainLiteral where "langTag"
  *  is not empty are abbreviated in functional-style syntax documents (and other
  *  concrete syntaxes) to "abc" whenever possible
+ *
+ *  The datatype is stored as interned id and the value is parsed once on
+ *  construction, so that the typed value can be accessed via
+ *  getLiteralValue without handling strings.
  */
 class OWLLiteral : public OWLPropertyAssertionObject, public OWLAnnotationValue
 {
 protected:
     std::string mValue;
-    std::string mType;
+    LiteralDatatype::Id mDatatype;
+    LiteralValue mLiteralValue;
 
     OWLLiteral();
 
     OWLLiteral(const std::string& value, const std::string& type);
 
+    OWLLiteral(const std::string& value, LiteralDatatype::Id datatype);
+
     OWLLiteral(const std::string& value);
 
 public:
@@ -55,9 +63,21 @@ public:
       * Set the type for the literal
       * \param type as full IRI string, e.g., http://www.w3.org/2001/XMLSchema#nonNegativeInteger
       */
-    void setType(const std::string& type) { mType = type; }
+    void setType(const std::string& type);
+
+    std::string getType() const { return LiteralDatatype::getIRI(mDatatype); }
+
+    /**
+     * Get the interned id of the datatype
+     */
+    LiteralDatatype::Id getDatatypeId() const { return mDatatype; }
 
-    std::string getType() const { return mType; }
+    /**
+     * Get the unboxed value of this literal
+     * \return value, which is of kind STRING if the datatype has no unboxed
+     * representation
+     */
+    const LiteralValue& getLiteralValue() const { return mLiteralValue; }
 
     std::string getValue() const { return mValue; }
 
@@ -69,11 +89,11 @@ public:
     //
     std::string toString() const;
 
-    bool isBoolean() const { return mType == vocabulary::XSD::boolean().toString(); }
-    bool isDouble() const { return mType == vocabulary::XSD::resolve("double").toString(); }
-    bool isFloat() const { return mType == vocabulary::XSD::resolve("float").toString(); }
-    bool isInteger() const { return mType == vocabulary::XSD::integer().toString(); }
-    bool isPlainLiteral() const { return mType == vocabulary::RDF::PlainLiteral().toString() || mType.empty(); }
+    bool isBoolean() const { return mDatatype == LiteralDatatype::BOOLEAN; }
+    bool isDouble() const { return mDatatype == LiteralDatatype::DOUBLE; }
+    bool isFloat() const { return mDatatype == LiteralDatatype::FLOAT; }
+    bool isInteger() const { return mDatatype == LiteralDatatype::INTEGER; }
+    bool isPlainLiteral() const { return mDatatype == LiteralDatatype::PLAIN_LITERAL || mDatatype == LiteralDatatype::UNTYPED; }
 
     /**
      * Create a literal based on the given type information
@@ -87,6 +107,14 @@ public:
      */
     static OWLLiteral::Ptr create(const std::string& literal, const OWLDataType& type);
 
+    /**
+     * Create a literal from its lexical form and datatype
+     * \param value lexical form, without type information
+     * \param type full datatype IRI, an empty string for an untyped literal
+     * \return point to an inbuilt literal type
+     */
+    static OWLLiteral::Ptr create(const std::string& value, const std::string& type);
+
     static OWLLiteral::Ptr integer(int32_t value);
     /**
      * Create a literal typed to non negative integer and given value
@@ -1,5 +1,4 @@
 #include "OWLLiteralDouble.hpp"
-#include <boost/lexical_cast.hpp>
 #include <sstream>
 #include <owlapi/Vocabulary.hpp>
 
@@ -7,19 +6,27 @@ namespace owlapi {
 namespace model {
 
 OWLLiteralDouble::OWLLiteralDouble(double value)
-    : OWLLiteral("", vocabulary::XSD::resolve("double").toString())
+    : OWLLiteral("", LiteralDatatype::DOUBLE)
     , OWLLiteralNumeric<double>(value)
 {
     std::stringstream ss;
     ss << value;
     mValue = ss.str();
+    mLiteralValue = LiteralValue::fromDouble(value);
 }
 
 OWLLiteralDouble::OWLLiteralDouble(const std::string& value)
     : OWLLiteral(value)
     , OWLLiteralNumeric<double>(0.0)
 {
-    mNumericValue = fromString(mValue);
+    mNumericValue = fromLiteralValue(mLiteralValue, mValue);
+}
+
+OWLLiteralDouble::OWLLiteralDouble(const std::string& value, LiteralDatatype::Id datatype)
+    : OWLLiteral(value, datatype)
+    , OWLLiteralNumeric<double>(0.0)
+{
+    mNumericValue = fromLiteralValue(mLiteralValue, mValue);
 }
 
 } // end namespace model
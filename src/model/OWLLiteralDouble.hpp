@@ -14,6 +14,8 @@ public:
 
     OWLLiteralDouble(const std::string& value);
 
+    OWLLiteralDouble(const std::string& value, LiteralDatatype::Id datatype);
+
     virtual ~OWLLiteralDouble() {}
 };
 
@@ -12,19 +12,27 @@ class OWLLiteralInteger : public OWLLiteral, OWLLiteralNumeric<int>
 {
 public:
     OWLLiteralInteger(int32_t value)
-        : OWLLiteral( "", vocabulary::XSD::integer().toString())
+        : OWLLiteral("", LiteralDatatype::INTEGER)
         , OWLLiteralNumeric<int>(value)
     {
         std::stringstream ss;
         ss << value;
         mValue = ss.str();
+        mLiteralValue = LiteralValue::fromInt64(value);
     }
 
     OWLLiteralInteger(const std::string& value)
         : OWLLiteral(value)
         , OWLLiteralNumeric<int>(0)
     {
-        mNumericValue = fromString(mValue);
+        mNumericValue = fromLiteralValue(mLiteralValue, mValue);
+    }
+
+    OWLLiteralInteger(const std::string& value, LiteralDatatype::Id datatype)
+        : OWLLiteral(value, datatype)
+        , OWLLiteralNumeric<int>(0)
+    {
+        mNumericValue = fromLiteralValue(mLiteralValue, mValue);
     }
 
     virtual ~OWLLiteralInteger() {}
@@ -12,19 +12,27 @@ class OWLLiteralNonNegativeInteger : public OWLLiteral, OWLLiteralNumeric<uint32
 {
 public:
     OWLLiteralNonNegativeInteger(uint32_t value)
-        : OWLLiteral("", vocabulary::XSD::nonNegativeInteger().toString())
+        : OWLLiteral("", LiteralDatatype::NON_NEGATIVE_INTEGER)
         , OWLLiteralNumeric<uint32_t>(value)
     {
         std::stringstream ss;
         ss << value;
         mValue = ss.str();
+        mLiteralValue = LiteralValue::fromUInt64(value);
     }
 
     OWLLiteralNonNegativeInteger(const std::string& value)
         : OWLLiteral(value)
         , OWLLiteralNumeric<uint32_t>(0)
     {
-        mNumericValue = fromString(mValue);
+        mNumericValue = fromLiteralValue(mLiteralValue, mValue);
+    }
+
+    OWLLiteralNonNegativeInteger(const std::string& value, LiteralDatatype::Id datatype)
+        : OWLLiteral(value, datatype)
+        , OWLLiteralNumeric<uint32_t>(0)
+    {
+        mNumericValue = fromLiteralValue(mLiteralValue, mValue);
     }
 
     virtual ~OWLLiteralNonNegativeInteger() {}
@@ -2,8 +2,9 @@
 #define OWLAPI_MODEL_OWL_LITERAL_NUMERIC_HPP
 
 #include <string>
-#include <boost/lexical_cast.hpp>
+#include <stdexcept>
 #include <typeinfo>
+#include "LiteralValue.hpp"
 
 namespace owlapi {
 namespace model {
@@ -18,14 +19,27 @@ protected:
     T mNumericValue;
 
     value_t fromString(const std::string& stringValue) {
-        try {
-            return boost::lexical_cast< value_t >(stringValue);
-        } catch(const std::bad_cast& e)
+        value_t value;
+        if(!LiteralValue::parse(stringValue.data(), stringValue.data() + stringValue.size(), value))
         {
             throw std::runtime_error("owlapi::model::OWLLiteralNumeric::fromString:"
                     " failed to cast '" + stringValue + "' to " +
                     typeid(value_t).name());
         }
+        return value;
+    }
+
+    /**
+     * Retrieve the numeric value from an already parsed literal value, and
+     * fall back to parsing the string value
+     */
+    value_t fromLiteralValue(const LiteralValue& literalValue, const std::string& stringValue) {
+        value_t value;
+        if(literalValue.get(value))
+        {
+            return value;
+        }
+        return fromString(stringValue);
     }
 
     OWLLiteralNumeric(T value)
@@ -16,12 +16,13 @@ public:
     OWLNaryClassAxiom(OWLClassExpression::PtrList classExpressions, AxiomType type, OWLAnnotationList annotations)
         : OWLClassAxiom(type, annotations)
         , OWLNaryAxiom()
+        , mClassExpressions(classExpressions)
     {}
 
     virtual ~OWLNaryClassAxiom() {}
 
     bool contains(OWLClassExpression::Ptr ce) { throw std::runtime_error("OWLNaryClassAxiom::contains not implemented"); }
-    OWLClassExpression::PtrList getClassExpressions() { throw std::runtime_error("OWLNaryClassAxiom::getClassExpressions not implemented"); }
+    const OWLClassExpression::PtrList& getClassExpressions() const { return mClassExpressions; }
     OWLClassExpression::PtrList getClassExpressionsMinus(OWLClassExpression::PtrList classExpressions) { throw std::runtime_error("OWLNaryClassAxiom::getClassExpressionsMinus not implemented"); }
 
     std::vector<OWLAxiom::Ptr> asPairwiseAxioms() { // Compute combinations of the ClassExpressions 
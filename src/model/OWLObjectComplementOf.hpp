@@ -1,12 +1,12 @@
 #ifndef OWLAPI_MODEL_OWL_OBJECT_COMPLEMENT_OF_HPP
 #define OWLAPI_MODEL_OWL_OBJECT_COMPLEMENT_OF_HPP
 
-#include "OWLNaryBooleanExpression.hpp"
+#include "OWLBooleanClassExpression.hpp"
 
 namespace owlapi {
 namespace model {
 
-class OWLObjectComplementOf : OWLBooleanClassExpression
+class OWLObjectComplementOf : public OWLBooleanClassExpression
 {
 public:
     typedef shared_ptr<OWLObjectComplementOf> Ptr;
@@ -18,6 +18,8 @@ public:
 
     virtual ~OWLObjectComplementOf() = default;
 
+    virtual ClassExpressionType getClassExpressionType() const override { return OWLClassExpression::OBJECT_COMPLEMENT_OF; }
+
     const OWLClassExpression::Ptr& getOperand() const { return mOperand; }
 
 private:
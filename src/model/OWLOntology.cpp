@@ -1,15 +1,126 @@
 #include "OWLOntology.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
 #include "../KnowledgeBase.hpp"
+#include "../Instrumentation.hpp"
 #include "../io/OWLOntologyIO.hpp"
 #include "OWLOntologyChange.hpp"
-#include "OWLOntologyChangeFilter.hpp"
+#include "AddAxiom.hpp"
+#include "RemoveAxiom.hpp"
+#include "OWLAxiomAddVisitor.hpp"
 #include "OWLAnnotationAssertionAxiom.hpp"
+#include "OWLAxiomSignatureVisitor.hpp"
+#include "OWLAxiomStructureVisitor.hpp"
+#include "OWLOntologyTell.hpp"
+#include "OWLObjectPropertyAssertionAxiom.hpp"
+#include "OWLDataPropertyAssertionAxiom.hpp"
+#include "OWLInverseObjectProperty.hpp"
+#include "ELClassifier.hpp"
+#include "RLMaterializer.hpp"
 
 namespace owlapi {
 namespace model {
 
+namespace {
+
+/**
+ * Add a property assertion to, or remove it from the assertion index
+ */
+void updateAssertionIndex(AssertionIndex& index, const OWLAxiom::Ptr& axiom, bool add)
+{
+    OWLPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLPropertyAssertionAxiom>(axiom);
+    IRI subject = assertion->getSubject()->getReferenceID();
+    if(axiom->getAxiomType() == OWLAxiom::ObjectPropertyAssertion)
+    {
+        // the object is a literal if it was not a known individual
+        OWLIndividual::Ptr object = dynamic_pointer_cast<OWLIndividual>(assertion->getObject());
+        if(!object)
+        {
+            return;
+        }
+        IRI objectIRI = object->getReferenceID();
+
+        OWLObjectProperty::Ptr property = dynamic_pointer_cast<OWLObjectProperty>(assertion->getProperty());
+        if(!property)
+        {
+            shared_ptr<OWLInverseObjectProperty> inverse = dynamic_pointer_cast<OWLInverseObjectProperty>(assertion->getProperty());
+            if(!inverse)
+            {
+                return;
+            }
+            property = dynamic_pointer_cast<OWLObjectProperty>(inverse->getInverse());
+            if(!property)
+            {
+                return;
+            }
+            std::swap(subject, objectIRI);
+        }
+
+        if(add)
+        {
+            index.addRelation(subject, property->getIRI(), objectIRI);
+        } else {
+            index.removeRelation(subject, property->getIRI(), objectIRI);
+        }
+    } else {
+        OWLDataProperty::Ptr property = dynamic_pointer_cast<OWLDataProperty>(assertion->getProperty());
+        OWLLiteral::Ptr value = dynamic_pointer_cast<OWLLiteral>(assertion->getObject());
+        if(!property || !value)
+        {
+            return;
+        }
+
+        if(add)
+        {
+            index.addValue(subject, property->getIRI(), value);
+        } else {
+            index.removeValue(subject, property->getIRI(), value);
+        }
+    }
+}
+
+/**
+ * Create the journal operation which applies the net changes of a batch to
+ * the structurally equal axioms of another ontology
+ */
+TellJournal::Operation replayChanges(const OWLAxiom::PtrList& added, const OWLAxiom::PtrList& removed)
+{
+    return [added, removed](OWLOntologyTell& tell)
+    {
+        const OWLOntology::Ptr& ontology = tell.getOntology();
+        OWLOntologyChange::PtrList replayed;
+        for(const OWLAxiom::Ptr& axiom : removed)
+        {
+            replayed.push_back(make_shared<RemoveAxiom>(ontology, axiom));
+        }
+        for(const OWLAxiom::Ptr& axiom : added)
+        {
+            replayed.push_back(make_shared<AddAxiom>(ontology, axiom));
+        }
+        ontology->applyChanges(replayed);
+    };
+}
+
+template<typename T>
+void copyEntities(const std::map<IRI, T>& from, std::map<IRI, T>& to, const std::function<bool(const IRI&)>& includeEntity)
+{
+    for(const typename std::map<IRI, T>::value_type& entry : from)
+    {
+        if(!includeEntity || includeEntity(entry.first))
+        {
+            to.insert(to.end(), entry);
+        }
+    }
+}
+
+} // end anonymous namespace
+
 OWLOntology::OWLOntology(const KnowledgeBase::Ptr& kb)
     : mpKnowledgeBase(kb)
+    , mELClassificationValid(false)
+    , mRLMaterializerValid(false)
+    , mRefreshPending(false)
 {
     if(!mpKnowledgeBase)
     {
@@ -17,18 +128,90 @@ OWLOntology::OWLOntology(const KnowledgeBase::Ptr& kb)
     }
 }
 
+OWLOntology::OWLOntology(Mode mode)
+    : mELClassificationValid(false)
+    , mRLMaterializerValid(false)
+    , mRefreshPending(false)
+{
+    if(mode == REASONING)
+    {
+        mpKnowledgeBase = make_shared<KnowledgeBase>();
+    }
+}
+
 OWLOntology::~OWLOntology()
 {}
 
+KnowledgeBase::Ptr OWLOntology::kb()
+{
+    if(!mpKnowledgeBase)
+    {
+        throw std::runtime_error("owlapi::model::OWLOntology::kb: ontology is structural only -- "
+                "attach a knowledge base to use the reasoner");
+    }
+    return mpKnowledgeBase;
+}
+
+void OWLOntology::attachKnowledgeBase(const KnowledgeBase::Ptr& kb)
+{
+    if(mpKnowledgeBase)
+    {
+        throw std::runtime_error("owlapi::model::OWLOntology::attachKnowledgeBase: "
+                "a knowledge base is already attached");
+    }
+
+    OWLAPI_INSTRUMENT_SCOPE(KB_POPULATE);
+    mpKnowledgeBase = kb ? kb : make_shared<KnowledgeBase>();
+
+    // Register all entities first, so that the axioms can refer to them
+    // independent of their order
+    for(const std::pair<const IRI, OWLClass::Ptr>& p : mClasses)
+    {
+        mpKnowledgeBase->getClassLazy(p.first);
+    }
+    for(const std::pair<const IRI, OWLNamedIndividual::Ptr>& p : mNamedIndividuals)
+    {
+        mpKnowledgeBase->getInstanceLazy(p.first);
+    }
+    for(const std::pair<const IRI, OWLAnonymousIndividual::Ptr>& p : mAnonymousIndividuals)
+    {
+        mpKnowledgeBase->getInstanceLazy(p.first);
+    }
+    for(const std::pair<const IRI, OWLObjectProperty::Ptr>& p : mObjectProperties)
+    {
+        mpKnowledgeBase->getObjectPropertyLazy(p.first);
+    }
+    for(const std::pair<const IRI, OWLDataProperty::Ptr>& p : mDataProperties)
+    {
+        mpKnowledgeBase->getDataPropertyLazy(p.first);
+    }
+    for(const std::pair<const IRI, OWLDataType::Ptr>& p : mDataTypes)
+    {
+        if(!mpKnowledgeBase->isDatatype(p.first))
+        {
+            mpKnowledgeBase->dataType(p.first);
+        }
+    }
+
+    OWLAxiomAddVisitor visitor(this);
+    for(const AxiomMap::value_type& typedAxioms : mAxiomsByType)
+    {
+        for(const OWLAxiom::Ptr& axiom : typedAxioms.second)
+        {
+            visitor.assertOnly(axiom);
+        }
+    }
+    LOG_INFO_S << "Attached knowledge base: asserted " << visitor.getNumberOfAssertedAxioms()
+        << " axioms";
+}
+
 void OWLOntology::refresh()
 {
+    mRefreshPending = false;
     if(mpKnowledgeBase)
     {
         mpKnowledgeBase->refresh();
-        return;
     }
-
-    throw std::runtime_error("owlapi::model::OWLOntology: KnowledgeBase not initialized");
 }
 
 void OWLOntology::cleanup()
@@ -75,6 +258,12 @@ OWLDataProperty::Ptr OWLOntology::getDataProperty(const IRI& iri) const
 
 const IRI& OWLOntology::iriOfDataProperty(const OWLDataProperty::Ptr& property) const
 {
+    std::map<IRI, OWLDataProperty::Ptr>::const_iterator cit = mDataProperties.find(property->getIRI());
+    if(cit != mDataProperties.end())
+    {
+        return cit->first;
+    }
+
     for(const auto& p : mDataProperties)
     {
         if(property == p.second)
@@ -137,9 +326,116 @@ OWLAnonymousIndividual::Ptr OWLOntology::getAnonymousIndividual(const IRI& iri)
     throw std::invalid_argument("owlapi::model::OWLOntology::getAnonymousIndividual: no anonymous individual '" + iri.toString() + "' known");
 }
 
+IRI OWLOntology::getAnnotationSubjectIRI(const OWLAnnotationSubject::Ptr& subject)
+{
+    switch(subject->getObjectType())
+    {
+        case OWLObject::IRIType:
+            return *dynamic_pointer_cast<IRI>(subject);
+        case OWLObject::AnonymousIndividual:
+            return dynamic_pointer_cast<OWLAnonymousIndividual>(subject)->getReferenceID();
+        default:
+            throw std::invalid_argument("owlapi::model::OWLOntology::getAnnotationSubjectIRI:"
+                    " encountered unknown type for AnnotationSubject");
+    }
+}
+
 void OWLOntology::addAxiom(const OWLAxiom::Ptr& axiom)
 {
-    OWLAxiom::PtrList& axioms = mAxiomsByType[axiom->getAxiomType()];
+    if(!addToAxiomList(mAxiomsByType[axiom->getAxiomType()], axiom))
+    {
+        LOG_WARN_S << "Axiom: '" << axiom->toString() << "' has already been added to ontology loaded from '" << getAbsolutePath() << "'";
+        return;
+    }
+    indexAxiom(axiom);
+    if(mAxiomChangeCallback)
+    {
+        mAxiomChangeCallback(axiom, true);
+    }
+}
+
+void OWLOntology::addAxioms(const OWLAxiom::PtrList& axioms)
+{
+    // Look up the type list only when the type changes, since batches
+    // usually contain runs of axioms of the same type
+    OWLAxiom::PtrList* typedAxioms = NULL;
+    OWLAxiom::AxiomType type = OWLAxiom::UNKOWN;
+    for(const OWLAxiom::Ptr& axiom : axioms)
+    {
+        if(!typedAxioms || axiom->getAxiomType() != type)
+        {
+            type = axiom->getAxiomType();
+            typedAxioms = &mAxiomsByType[type];
+        }
+
+        if(!addToAxiomList(*typedAxioms, axiom))
+        {
+            LOG_WARN_S << "Axiom: '" << axiom->toString() << "' has already been added to ontology loaded from '" << getAbsolutePath() << "'";
+            continue;
+        }
+        indexAxiom(axiom);
+        if(mAxiomChangeCallback)
+        {
+            mAxiomChangeCallback(axiom, true);
+        }
+    }
+}
+
+void OWLOntology::clearDataRangeValidators()
+{
+    mDataRangeValidators.clear();
+    mDataRangeValidatorsByRange.clear();
+}
+
+bool OWLOntology::addToAxiomList(OWLAxiom::PtrList& list, const OWLAxiom::Ptr& axiom)
+{
+    if(!mAxiomListPositions.insert(std::make_pair(AxiomListEntry(&list, axiom.get()), list.size())).second)
+    {
+        return false;
+    }
+    list.push_back(axiom);
+    return true;
+}
+
+bool OWLOntology::removeFromAxiomList(OWLAxiom::PtrList& list, const OWLAxiom::Ptr& axiom)
+{
+    std::unordered_map<AxiomListEntry, size_t, boost::hash<AxiomListEntry> >::iterator it =
+        mAxiomListPositions.find(AxiomListEntry(&list, axiom.get()));
+    if(it == mAxiomListPositions.end())
+    {
+        return false;
+    }
+
+    size_t position = it->second;
+    mAxiomListPositions.erase(it);
+    if(position + 1 != list.size())
+    {
+        list[position] = list.back();
+        mAxiomListPositions[AxiomListEntry(&list, list[position].get())] = position;
+    }
+    list.pop_back();
+    return true;
+}
+
+void OWLOntology::indexAxiom(const OWLAxiom::Ptr& axiom)
+{
+    if(RDFSClosure::isRelevant(axiom->getAxiomType()))
+    {
+        mRDFSClosure.clear();
+    }
+
+    if(ELClassifier::isRelevant(axiom))
+    {
+        mpELClassification.reset();
+        mELClassificationValid = false;
+    }
+
+    if(RLMaterializer::isRelevant(axiom)
+            && !(mpRLMaterializer && mpRLMaterializer->enqueue(axiom, true)))
+    {
+        mpRLMaterializer.reset();
+        mRLMaterializerValid = false;
+    }
 
     switch(axiom->getAxiomType())
     {
@@ -148,18 +444,27 @@ void OWLOntology::addAxiom(const OWLAxiom::Ptr& axiom)
                 OWLAnnotationAssertionAxiom::Ptr annotationAxiom =
                     dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom);
                 mAnnotationAxioms[annotationAxiom->getProperty()].push_back(annotationAxiom);
+
+                IRI subject = getAnnotationSubjectIRI(annotationAxiom->getSubject());
+                mAnnotationAssertionsBySubjectAndProperty[ std::make_pair(subject, annotationAxiom->getProperty()->getIRI()) ].push_back(annotationAxiom);
+                mAnnotationAssertionsBySubject[subject].push_back(annotationAxiom);
             }
             break;
+        case OWLAxiom::ObjectPropertyAssertion:
+        case OWLAxiom::DataPropertyAssertion:
+            updateAssertionIndex(mAssertionIndex, axiom, true);
+            break;
+        case OWLAxiom::DataPropertyRange:
+            clearDataRangeValidators();
+            break;
         default:
             break;
 
     }
 
-    if( axioms.end() == std::find(axioms.begin(), axioms.end(), axiom) )
+    for(const IRI& iri : OWLAxiomSignatureVisitor::getSignature(axiom))
     {
-        axioms.push_back(axiom);
-    } else {
-        LOG_WARN_S << "Axiom: '" << axiom->toString() << "' has already been added to ontology loaded from '" << getAbsolutePath() << "'";
+        addToAxiomList(mAxiomsByEntity[iri], axiom);
     }
 }
 
@@ -168,6 +473,117 @@ OWLOntology::Ptr OWLOntology::fromFile(const std::string& filename)
     return io::OWLOntologyIO::fromFile(filename);
 }
 
+const RDFSClosure& OWLOntology::getRDFSClosure()
+{
+    if(!mRDFSClosure.isValid())
+    {
+        mRDFSClosure.build(mAxiomsByType);
+    }
+    return mRDFSClosure;
+}
+
+void OWLOntology::enableArena(size_t blockSize)
+{
+    mpArena = make_shared<Arena>(blockSize);
+}
+
+OWLOntology::Ptr OWLOntology::fork() const
+{
+    KnowledgeBase::Ptr kb;
+    if(mpKnowledgeBase)
+    {
+        kb = make_shared<KnowledgeBase>();
+    }
+    OWLOntology::Ptr child = createSubset(getAxioms(), std::function<bool(const IRI&)>(), kb);
+    child->setJournaling(isJournaling());
+
+    if(mpKnowledgeBase && !mRefreshPending)
+    {
+        // the child starts with the same axioms, so it can use the
+        // classification of this ontology until its first change
+        KnowledgeBase::TaxonomySnapshot snapshot = mpKnowledgeBase->getTaxonomySnapshot();
+        if(snapshot.taxonomy && !snapshot.stale)
+        {
+            kb->setTaxonomy(snapshot.taxonomy);
+        }
+    }
+    return child;
+}
+
+OWLOntology::Ptr OWLOntology::createSubset(const OWLAxiom::PtrList& axioms,
+        const std::function<bool(const IRI&)>& includeEntity,
+        const KnowledgeBase::Ptr& kb) const
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(STRUCTURAL);
+    ontology->mAbsolutePath = mAbsolutePath;
+    ontology->mIri = mIri;
+    ontology->mDirectImportsDocuments = mDirectImportsDocuments;
+    ontology->mImportsDocuments = mImportsDocuments;
+    if(mpArena)
+    {
+        ontology->enableArena(mpArena->getBlockSize());
+    }
+
+    copyEntities(mClasses, ontology->mClasses, includeEntity);
+    copyEntities(mNamedIndividuals, ontology->mNamedIndividuals, includeEntity);
+    copyEntities(mAnonymousIndividuals, ontology->mAnonymousIndividuals, includeEntity);
+    copyEntities(mObjectProperties, ontology->mObjectProperties, includeEntity);
+    copyEntities(mDataProperties, ontology->mDataProperties, includeEntity);
+    copyEntities(mAnnotationProperties, ontology->mAnnotationProperties, includeEntity);
+    copyEntities(mDataTypes, ontology->mDataTypes, includeEntity);
+    for(const IRI& iri : mRDFProperties)
+    {
+        if(!includeEntity || includeEntity(iri))
+        {
+            ontology->mRDFProperties.insert(iri);
+        }
+    }
+    // anonymous expressions are registered by id, a subset only keeps the
+    // ones its axioms refer to
+    if(!includeEntity)
+    {
+        ontology->mAnonymousClassExpressions = mAnonymousClassExpressions;
+        ontology->mAnonymousDataRanges = mAnonymousDataRanges;
+    } else {
+        OWLAxiomSignatureVisitor visitor(true);
+        for(const OWLAxiom::Ptr& axiom : axioms)
+        {
+            visitor.collect(axiom);
+        }
+
+        for(const std::pair<const IRI, OWLAnonymousClassExpression::Ptr>& entry : mAnonymousClassExpressions)
+        {
+            if(visitor.getClassExpressions().count(entry.second.get()))
+            {
+                ontology->mAnonymousClassExpressions.insert(ontology->mAnonymousClassExpressions.end(), entry);
+            }
+        }
+        for(const std::pair<const IRI, OWLDataRange::PtrList>& entry : mAnonymousDataRanges)
+        {
+            for(const OWLDataRange::Ptr& range : entry.second)
+            {
+                if(visitor.getDataRanges().count(range.get()))
+                {
+                    ontology->mAnonymousDataRanges[entry.first].push_back(range);
+                }
+            }
+        }
+    }
+
+    ontology->addAxioms(axioms);
+    OWLAxiomAddVisitor visitor(ontology.get());
+    for(const OWLAxiom::Ptr& axiom : axioms)
+    {
+        visitor.add(axiom);
+    }
+
+    if(kb)
+    {
+        ontology->attachKnowledgeBase(kb);
+    }
+    return ontology;
+}
+
 OWLAxiom::PtrList OWLOntology::getAxioms() const
 {
     OWLAxiom::PtrList axioms;
@@ -181,20 +597,120 @@ OWLAxiom::PtrList OWLOntology::getAxioms() const
 }
 
 void OWLOntology::removeAxiom(const OWLAxiom::Ptr& axiom)
+{
+    removeAxioms(OWLAxiom::PtrList(1, axiom));
+}
+
+void OWLOntology::removeAxioms(const OWLAxiom::PtrList& axioms)
+{
+    // Removals which are not part of a tell call, e.g. when reloading, are
+    // journaled on their own
+    TellJournal::Scope journalScope(mJournal, IRI());
+
+    OWLAxiom::PtrList removed;
+    removed.reserve(axioms.size());
+    for(const OWLAxiom::Ptr& axiom : axioms)
+    {
+        if(removeAxiomFromIndex(axiom))
+        {
+            removed.push_back(axiom);
+        }
+    }
+
+    if(!removed.empty() && mpKnowledgeBase)
+    {
+        mpKnowledgeBase->retractRelated(removed);
+    }
+
+    if(journalScope.isRecording() && !removed.empty())
+    {
+        journalScope.setOperation(replayChanges(OWLAxiom::PtrList(), removed));
+    }
+}
+
+bool OWLOntology::removeAxiomFromIndex(const OWLAxiom::Ptr& axiom)
 {
     // remove axiom from reverse map
-    OWLAxiom::PtrList& axioms = mAxiomsByType[axiom->getAxiomType()];
+    AxiomMap::iterator ait = mAxiomsByType.find(axiom->getAxiomType());
+    if(ait == mAxiomsByType.end() || !removeFromAxiomList(ait->second, axiom))
+    {
+        return false;
+    }
+
+    LOG_INFO_S << "Removing axiom: " << axiom->toString();
     OWLAxiomRetractVisitor visitor(this);
-    OWLAxiom::PtrList::iterator ait = std::find(axioms.begin(), axioms.end(), axiom);
-    if(ait != axioms.end())
+    axiom->accept(&visitor);
+
+    if(axiom->getAxiomType() == OWLAxiom::AnnotationAssertion)
+    {
+        OWLAnnotationAssertionAxiom::Ptr annotationAxiom =
+            dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom);
+        IRI subject = getAnnotationSubjectIRI(annotationAxiom->getSubject());
+
+        std::vector<OWLAxiom::Ptr>& propertyAxioms = mAnnotationAxioms[annotationAxiom->getProperty()];
+        propertyAxioms.erase(std::remove(propertyAxioms.begin(), propertyAxioms.end(), axiom), propertyAxioms.end());
+
+        OWLAnnotationAssertionAxiom::PtrList& subjectAndPropertyAxioms =
+            mAnnotationAssertionsBySubjectAndProperty[ std::make_pair(subject, annotationAxiom->getProperty()->getIRI()) ];
+        subjectAndPropertyAxioms.erase(std::remove(subjectAndPropertyAxioms.begin(), subjectAndPropertyAxioms.end(), annotationAxiom),
+                subjectAndPropertyAxioms.end());
+
+        OWLAnnotationAssertionAxiom::PtrList& subjectAxioms = mAnnotationAssertionsBySubject[subject];
+        subjectAxioms.erase(std::remove(subjectAxioms.begin(), subjectAxioms.end(), annotationAxiom), subjectAxioms.end());
+    }
+
+    if(axiom->getAxiomType() == OWLAxiom::DataPropertyRange)
+    {
+        clearDataRangeValidators();
+    }
+
+    if(axiom->getAxiomType() == OWLAxiom::ObjectPropertyAssertion
+            || axiom->getAxiomType() == OWLAxiom::DataPropertyAssertion)
+    {
+        updateAssertionIndex(mAssertionIndex, axiom, false);
+    } else if(RDFSClosure::isRelevant(axiom->getAxiomType()))
+    {
+        mRDFSClosure.clear();
+    }
+
+    if(ELClassifier::isRelevant(axiom))
+    {
+        mpELClassification.reset();
+        mELClassificationValid = false;
+    }
+
+    if(RLMaterializer::isRelevant(axiom)
+            && !(mpRLMaterializer && mpRLMaterializer->enqueue(axiom, false)))
     {
-        LOG_INFO_S << "Removing axiom: " << (*ait)->toString();
-        (*ait)->accept(&visitor);
+        mpRLMaterializer.reset();
+        mRLMaterializerValid = false;
     }
-    axioms.erase(ait);
+
+    for(const IRI& iri : OWLAxiomSignatureVisitor::getSignature(axiom))
+    {
+        std::unordered_map<IRI, OWLAxiom::PtrList>::iterator it = mAxiomsByEntity.find(iri);
+        if(it == mAxiomsByEntity.end())
+        {
+            continue;
+        }
+
+        // order is not relevant, so swap with the last element
+        OWLAxiom::PtrList& entityAxioms = it->second;
+        removeFromAxiomList(entityAxioms, axiom);
+        if(entityAxioms.empty())
+        {
+            mAxiomsByEntity.erase(it);
+        }
+    }
+
+    if(mAxiomChangeCallback)
+    {
+        mAxiomChangeCallback(axiom, false);
+    }
+    return true;
 }
 
-void OWLOntology::retractValueOf(const OWLIndividual::Ptr& individual, const OWLDataProperty::Ptr& property)
+OWLAxiom::Ptr OWLOntology::retractValueOf(const OWLIndividual::Ptr& individual, const OWLDataProperty::Ptr& property)
 {
     OWLNamedIndividual::Ptr namedIndividual = dynamic_pointer_cast<OWLNamedIndividual>(individual);
     std::string individualName = "anonymous";
@@ -203,31 +719,40 @@ void OWLOntology::retractValueOf(const OWLIndividual::Ptr& individual, const OWL
         individualName = namedIndividual->getIRI().toString();
     }
 
-    std::vector<OWLAxiom::Ptr>& axioms = mAxiomsByType[OWLAxiom::DataPropertyAssertion];
-    std::vector<OWLAxiom::Ptr>::iterator it = axioms.begin();
-    for(; it != axioms.end(); ++it)
+    std::unordered_map<IRI, OWLAxiom::PtrList>::const_iterator cit = mAxiomsByEntity.find(individual->getReferenceID());
+    if(cit != mAxiomsByEntity.end())
     {
-        OWLDataPropertyAssertionAxiom::Ptr axiom = dynamic_pointer_cast<OWLDataPropertyAssertionAxiom>(*it);
-        if(axiom->getSubject() == individual && axiom->getProperty() == property)
+        for(const OWLAxiom::Ptr& axiom : cit->second)
         {
-            LOG_DEBUG_S << "Retracted DataPropertyAssertionAxiom: s: '" << individualName << "'"
-                    << ", p: " << property->getIRI().toString() << "'";
-            axioms.erase(it);
-            return;
+            if(axiom->getAxiomType() != OWLAxiom::DataPropertyAssertion)
+            {
+                continue;
+            }
+
+            OWLDataPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLDataPropertyAssertionAxiom>(axiom);
+            if(assertion->getSubject() == individual && assertion->getProperty() == property)
+            {
+                LOG_DEBUG_S << "Retracted DataPropertyAssertionAxiom: s: '" << individualName << "'"
+                        << ", p: " << property->getIRI().toString() << "'";
+                // copy, since the entry is invalidated by the removal
+                OWLAxiom::Ptr removed = axiom;
+                removeAxiomFromIndex(removed);
+                return removed;
+            }
         }
     }
     LOG_DEBUG_S << "No value to be retracted";
+    return OWLAxiom::Ptr();
 }
 
 void OWLOntology::retractIndividual(const IRI& iri)
 {
-    OWLIndividual::Ptr individual = getIndividual(iri);
-    std::vector<OWLClassAssertionAxiom::Ptr>& axioms = mClassAssertionAxiomsByIndividual[individual];
-    for(OWLClassAssertionAxiom::Ptr& axiom : axioms)
-    {
-        OWLAxiomRetractVisitor v(this);
-        axiom->accept(&v);
-    }
+    // throws if the individual is not known
+    getIndividual(iri);
+
+    removeAxioms(getReferencingAxioms(iri));
+    mNamedIndividuals.erase(iri);
+    mAnonymousIndividuals.erase(iri);
 }
 
 void OWLOntology::addDirectImportsDocument(const IRI& iri)
@@ -247,17 +772,170 @@ void OWLOntology::addImportsDocument(const IRI& iri)
     }
 }
 
-OWLAxiom::PtrList OWLOntology::getReferencingAxioms(const OWLEntity::Ptr& entity, bool excludeImports)
+OWLAxiom::PtrList OWLOntology::getReferencingAxioms(const OWLEntity::Ptr& entity, bool excludeImports) const
+{
+    return getReferencingAxioms(entity->getIRI(), excludeImports);
+}
+
+OWLAxiom::PtrList OWLOntology::getReferencingAxioms(const IRI& iri, bool excludeImports) const
 {
     OWLAxiom::PtrList axioms;
+    std::unordered_map<IRI, OWLAxiom::PtrList>::const_iterator cit = mAxiomsByEntity.find(iri);
+    if(cit == mAxiomsByEntity.end())
+    {
+        return axioms;
+    }
 
+    if(!excludeImports)
+    {
+        return cit->second;
+    }
+
+    for(const OWLAxiom::Ptr& axiom : cit->second)
+    {
+        const IRI& origin = axiom->getOrigin();
+        if(origin.empty() || origin == mIri)
+        {
+            axioms.push_back(axiom);
+        }
+    }
     return axioms;
 }
 
 ChangeApplied OWLOntology::applyChange(const OWLOntologyChange::Ptr& change)
 {
-    OWLOntologyChangeFilter::Ptr filter(new OWLOntologyChangeFilter());
-    return change->accept(filter);
+    return applyChanges({ change });
+}
+
+ChangeApplied OWLOntology::applyChanges(const OWLOntologyChange::PtrList& changes)
+{
+    for(const OWLOntologyChange::Ptr& change : changes)
+    {
+        if(!change || !change->isAxiomChange() || !change->getAxiom())
+        {
+            throw std::invalid_argument("owlapi::model::OWLOntology::applyChanges: "
+                    "batch contains an unsupported change -- only axiom changes can be applied");
+        }
+        if(change->getOntology().get() != this)
+        {
+            throw std::invalid_argument("owlapi::model::OWLOntology::applyChanges: "
+                    "change of axiom '" + change->getAxiom()->toString() + "' refers to another ontology");
+        }
+    }
+
+    // Lookup of the current axiom for a change: the axiom itself if it is
+    // part of the ontology, otherwise a structurally equal axiom, which has
+    // the same type and signature, so that only the axioms of the entity
+    // with the fewest axioms need to be compared
+    std::unordered_map<const OWLAxiom*, std::string> keys;
+    auto findContained = [this, &keys](const OWLAxiom::Ptr& axiom, const std::string& key)
+        {
+            OWLAxiom::AxiomType type = axiom->getAxiomType();
+            AxiomMap::iterator typeIt = mAxiomsByType.find(type);
+            if(typeIt == mAxiomsByType.end())
+            {
+                return OWLAxiom::Ptr();
+            } else if(mAxiomListPositions.count(AxiomListEntry(&typeIt->second, axiom.get())))
+            {
+                return axiom;
+            }
+
+            const OWLAxiom::PtrList* candidates = &typeIt->second;
+            for(const IRI& iri : OWLAxiomSignatureVisitor::getSignature(axiom))
+            {
+                std::unordered_map<IRI, OWLAxiom::PtrList>::const_iterator cit = mAxiomsByEntity.find(iri);
+                if(cit == mAxiomsByEntity.end())
+                {
+                    return OWLAxiom::Ptr();
+                } else if(cit->second.size() < candidates->size())
+                {
+                    candidates = &cit->second;
+                }
+            }
+
+            for(const OWLAxiom::Ptr& candidate : *candidates)
+            {
+                if(candidate->getAxiomType() != type)
+                {
+                    continue;
+                }
+                std::unordered_map<const OWLAxiom*, std::string>::iterator kit = keys.find(candidate.get());
+                if(kit == keys.end())
+                {
+                    kit = keys.insert(std::make_pair(candidate.get(), OWLAxiomStructureVisitor::getKey(candidate))).first;
+                }
+                if(kit->second == key)
+                {
+                    return candidate;
+                }
+            }
+            return OWLAxiom::Ptr();
+        };
+
+    // Compute the net effect of the batch, i.e. whether each structurally
+    // distinct axiom is part of the ontology after all changes
+    std::vector< std::pair<std::string, OWLAxiom::Ptr> > order;
+    std::unordered_map<std::string, bool> present;
+    for(const OWLOntologyChange::Ptr& change : changes)
+    {
+        const OWLAxiom::Ptr& axiom = change->getAxiom();
+        std::string key = OWLAxiomStructureVisitor::getKey(axiom);
+        if(present.insert(std::make_pair(key, change->isAddAxiom())).second)
+        {
+            order.push_back(std::make_pair(key, axiom));
+        } else {
+            present[key] = change->isAddAxiom();
+        }
+    }
+
+    OWLAxiom::PtrList added;
+    OWLAxiom::PtrList removed;
+    for(const std::pair<std::string, OWLAxiom::Ptr>& entry : order)
+    {
+        OWLAxiom::Ptr containedAxiom = findContained(entry.second, entry.first);
+        if(present[entry.first] && !containedAxiom)
+        {
+            added.push_back(entry.second);
+        } else if(!present[entry.first] && containedAxiom)
+        {
+            removed.push_back(containedAxiom);
+        }
+    }
+
+    if(added.empty() && removed.empty())
+    {
+        return CHANGE_NO_OPERATION;
+    }
+
+    // The batch is journaled with its net effect, so that a replay applies
+    // the same changes to structurally equal axioms
+    TellJournal::Scope journalScope(mJournal, IRI());
+    if(journalScope.isRecording())
+    {
+        journalScope.setOperation(replayChanges(added, removed));
+    }
+
+    if(!removed.empty())
+    {
+        removeAxioms(removed);
+    }
+
+    if(!added.empty())
+    {
+        addAxioms(added);
+
+        OWLAxiomAddVisitor visitor(this);
+        for(const OWLAxiom::Ptr& axiom : added)
+        {
+            visitor.add(axiom);
+            mJournal.recordAxiom(axiom);
+        }
+        LOG_DEBUG_S << "Asserted " << visitor.getNumberOfAssertedAxioms()
+            << " of " << added.size() << " added axioms to the knowledge base";
+    }
+
+    mRefreshPending = mpKnowledgeBase != NULL;
+    return CHANGE_SUCCESS;
 }
 
 OWLEntity::PtrList OWLOntology::getSignature() const
@@ -270,5 +948,97 @@ OWLEntity::PtrList OWLOntology::getSignature() const
     return entities;
 }
 
+MemoryUsage OWLOntology::getMemoryUsage() const
+{
+    using namespace memory;
+
+    // Objects are owned by the arena, if enabled
+    bool objects = !mpArena;
+
+    MemoryUsage usage;
+    usage.add("entities.classes", mClasses.size(),
+            heapBytes(mClasses) + (objects ? objectBytes(mClasses) : 0));
+    usage.add("entities.anonymous_class_expressions", mAnonymousClassExpressions.size(),
+            heapBytes(mAnonymousClassExpressions) + (objects ? objectBytes(mAnonymousClassExpressions) : 0));
+    usage.add("entities.named_individuals", mNamedIndividuals.size(),
+            heapBytes(mNamedIndividuals) + (objects ? objectBytes(mNamedIndividuals) : 0));
+    usage.add("entities.anonymous_individuals", mAnonymousIndividuals.size(),
+            heapBytes(mAnonymousIndividuals) + (objects ? objectBytes(mAnonymousIndividuals) : 0));
+    usage.add("entities.rdf_properties", mRDFProperties.size(), heapBytes(mRDFProperties));
+    usage.add("entities.object_properties", mObjectProperties.size(),
+            heapBytes(mObjectProperties) + (objects ? objectBytes(mObjectProperties) : 0));
+    usage.add("entities.data_properties", mDataProperties.size(),
+            heapBytes(mDataProperties) + (objects ? objectBytes(mDataProperties) : 0));
+    usage.add("entities.annotation_properties", mAnnotationProperties.size(),
+            heapBytes(mAnnotationProperties) + (objects ? objectBytes(mAnnotationProperties) : 0));
+    usage.add("entities.anonymous_data_ranges", mAnonymousDataRanges.size(), heapBytes(mAnonymousDataRanges));
+    usage.add("entities.data_types", mDataTypes.size(),
+            heapBytes(mDataTypes) + (objects ? objectBytes(mDataTypes) : 0));
+
+    uint64_t numberOfAxioms = 0;
+    uint64_t axiomBytes = 0;
+    for(const AxiomMap::value_type& typedAxioms : mAxiomsByType)
+    {
+        numberOfAxioms += typedAxioms.second.size();
+        // axioms of the same type share their class
+        if(objects && !typedAxioms.second.empty())
+        {
+            axiomBytes += typedAxioms.second.size()
+                * (typedAxioms.second.front()->getObjectSize() + MemoryUsage::SHARED_OBJECT_OVERHEAD);
+        }
+    }
+    usage.add("axioms", numberOfAxioms, heapBytes(mAxiomsByType) + axiomBytes);
+
+    usage.add("index.class_assertions_by_class", mClassAssertionAxiomsByClass.size(),
+            heapBytes(mClassAssertionAxiomsByClass));
+    usage.add("index.class_assertions_by_individual", mClassAssertionAxiomsByIndividual.size(),
+            heapBytes(mClassAssertionAxiomsByIndividual));
+    usage.add("index.data_property_axioms", mDataPropertyAxioms.size(), heapBytes(mDataPropertyAxioms));
+    usage.add("index.object_property_axioms", mObjectPropertyAxioms.size(), heapBytes(mObjectPropertyAxioms));
+    usage.add("index.annotation_axioms", mAnnotationAxioms.size(), heapBytes(mAnnotationAxioms));
+    usage.add("index.annotation_assertions_by_subject_and_property", mAnnotationAssertionsBySubjectAndProperty.size(),
+            heapBytes(mAnnotationAssertionsBySubjectAndProperty));
+    usage.add("index.annotation_assertions_by_subject", mAnnotationAssertionsBySubject.size(),
+            heapBytes(mAnnotationAssertionsBySubject));
+    usage.add("index.named_individual_axioms", mNamedIndividualAxioms.size(), heapBytes(mNamedIndividualAxioms));
+    usage.add("index.anonymous_individual_axioms", mAnonymousIndividualAxioms.size(),
+            heapBytes(mAnonymousIndividualAxioms));
+    usage.add("index.declarations_by_entity", mDeclarationsByEntity.size(), heapBytes(mDeclarationsByEntity));
+    usage.add("index.axioms_by_entity", mAxiomsByEntity.size(), heapBytes(mAxiomsByEntity));
+    usage.add("index.axiom_list_positions", mAxiomListPositions.size(), heapBytes(mAxiomListPositions));
+    usage.add("index.assertions", mAssertionIndex.getNumberOfRelations() + mAssertionIndex.getNumberOfValues(),
+            mAssertionIndex.getMemoryUsage());
+    usage.add("index.subclass_axioms_by_sub", mSubClassAxiomBySubPosition.size(),
+            heapBytes(mSubClassAxiomBySubPosition));
+    usage.add("index.subclass_axioms_by_super", mSubClassAxiomBySuperPosition.size(),
+            heapBytes(mSubClassAxiomBySuperPosition));
+
+    usage.add("query_cache", mQueryCache.size(), mQueryCache.getMemoryUsage());
+    usage.add("rdfs_closure", 0, mRDFSClosure.getMemoryUsage());
+    if(mpELClassification)
+    {
+        usage.add("el_classification", mpELClassification->getTaxonomy()->size(),
+                mpELClassification->getMemoryUsage());
+    }
+    if(mpRLMaterializer)
+    {
+        usage.add("rl_materialization", mpRLMaterializer->getNumberOfTypes() + mpRLMaterializer->getNumberOfRelations(),
+                mpRLMaterializer->getMemoryUsage());
+    }
+    usage.add("data_range_validators", mDataRangeValidators.size() + mDataRangeValidatorsByRange.size(),
+            heapBytes(mDataRangeValidators) + heapBytes(mDataRangeValidatorsByRange));
+    usage.add("journal", mJournal.getEntries().size(), mJournal.getMemoryUsage());
+    if(mpArena)
+    {
+        usage.add("arena", mpArena->getNumberOfBlocks(), mpArena->getReservedBytes());
+    }
+
+    if(mpKnowledgeBase)
+    {
+        usage.add("kb", mpKnowledgeBase->getMemoryUsage());
+    }
+    return usage;
+}
+
 } // end namespace model
 } // end namespace owlapi
@@ -2,7 +2,9 @@
 #define OWLAPI_MODEL_OWL_ONTOLOGY_HPP
 
 #include <map>
+#include <unordered_map>
 #include <algorithm>
+#include <functional>
 #include "OWLClass.hpp"
 #include "OWLNamedIndividual.hpp"
 #include "OWLAnonymousClassExpression.hpp"
@@ -14,15 +16,23 @@
 #include "OWLClassAssertionAxiom.hpp"
 #include "OWLDeclarationAxiom.hpp"
 #include "OWLSubClassOfAxiom.hpp"
+#include "OWLAnnotationAssertionAxiom.hpp"
 #include "ChangeApplied.hpp"
 #include "OWLAxiomRetractVisitor.hpp"
 #include "QueryCache.hpp"
+#include "TellJournal.hpp"
+#include "Arena.hpp"
+#include "DataRangeValidator.hpp"
+#include "AssertionIndex.hpp"
+#include "RDFSClosure.hpp"
+#include "MemoryUsage.hpp"
 
 namespace owlapi {
 
 class KnowledgeBase;
 
 namespace io {
+    class ChangeJournal;
     class OWLOntologyIO;
     class OWLOntologyReader;
     class RedlandWriter;
@@ -33,6 +43,8 @@ namespace model {
 class OWLOntologyTell;
 class OWLOntologyAsk;
 class OWLOntologyChange;
+class ELClassification;
+class RLMaterializer;
 
 typedef std::map<OWLAxiom::AxiomType, OWLAxiom::PtrList > AxiomMap;
 
@@ -44,11 +56,15 @@ class OWLOntology
 {
     friend class OWLOntologyTell;
     friend class OWLOntologyAsk;
+    friend class io::ChangeJournal;
     friend class io::OWLOntologyIO;
     friend class io::OWLOntologyReader;
     friend class io::RedlandWriter;
     friend class OWLAxiomRetractVisitor;
     friend class OWLAxiomAddVisitor;
+    friend class SyntacticLocalityModuleExtractor;
+    friend class ParallelClassifier;
+    friend class ELClassifier;
 
 protected:
     /// Mapping of IRI to types
@@ -83,10 +99,25 @@ protected:
     std::map<OWLDataProperty::Ptr, std::vector<OWLAxiom::Ptr> > mDataPropertyAxioms;
     std::map<OWLObjectProperty::Ptr, std::vector<OWLAxiom::Ptr> > mObjectPropertyAxioms;
     std::map<OWLAnnotationProperty::Ptr, std::vector<OWLAxiom::Ptr> > mAnnotationAxioms;
+    /// Annotation assertions by (annotation subject, annotation property)
+    std::unordered_map< std::pair<IRI, IRI>, OWLAnnotationAssertionAxiom::PtrList > mAnnotationAssertionsBySubjectAndProperty;
+    /// Annotation assertions by annotation subject
+    std::unordered_map<IRI, OWLAnnotationAssertionAxiom::PtrList> mAnnotationAssertionsBySubject;
     std::map<OWLNamedIndividual::Ptr, std::vector<OWLAxiom::Ptr> > mNamedIndividualAxioms;
     /// Map of anonymous individual to all axioms the individual is involved into
     std::map<OWLAnonymousIndividual::Ptr, std::vector<OWLAxiom::Ptr> > mAnonymousIndividualAxioms;
     std::map<OWLEntity::Ptr, std::vector<OWLDeclarationAxiom::Ptr> > mDeclarationsByEntity;
+    /// Axioms by the IRIs in their signature, \see OWLAxiomSignatureVisitor
+    /// Punned entities share an entry
+    std::unordered_map<IRI, OWLAxiom::PtrList> mAxiomsByEntity;
+    /// Position of an axiom in a list of mAxiomsByType or mAxiomsByEntity,
+    /// by list and axiom, so that axioms are found and removed in constant
+    /// time; the lists are node based map values, so their addresses are
+    /// stable
+    typedef std::pair<const OWLAxiom::PtrList*, const OWLAxiom*> AxiomListEntry;
+    std::unordered_map<AxiomListEntry, size_t, boost::hash<AxiomListEntry> > mAxiomListPositions;
+    /// Told object and data property assertions by individual
+    AssertionIndex mAssertionIndex;
 
     /// Map to access subclass axiom by a given subclass
     std::map<OWLClassExpression::Ptr, std::vector<OWLSubClassOfAxiom::Ptr> > mSubClassAxiomBySubPosition;
@@ -107,7 +138,11 @@ protected:
 
     shared_ptr<KnowledgeBase> mpKnowledgeBase;
 
-    shared_ptr<KnowledgeBase> kb() { return mpKnowledgeBase; }
+    /**
+     * Get the knowledge base
+     * \throw std::runtime_error if the ontology is structural only
+     */
+    shared_ptr<KnowledgeBase> kb();
 
     template<typename LIST, typename A>
     void removeAxiomFromMap(LIST& list, const A* axiom)
@@ -128,6 +163,60 @@ protected:
 protected:
     QueryCache mQueryCache;
 
+    /// Asserted hierarchies and their closure, which is rebuilt on demand
+    /// after a change of the TBox or RBox
+    RDFSClosure mRDFSClosure;
+
+    /// Class hierarchy computed by the ELClassifier, which is recomputed on
+    /// demand after a change of the TBox or RBox
+    shared_ptr<ELClassification> mpELClassification;
+
+    /// Whether mpELClassification is up to date, where a null classification
+    /// means that the ontology is not supported by the ELClassifier
+    bool mELClassificationValid;
+
+    /// Materialized assertions computed by the RLMaterializer, which are
+    /// updated incrementally on a change of the ABox, and recomputed on
+    /// demand after any other change
+    shared_ptr<RLMaterializer> mpRLMaterializer;
+
+    /// Whether mpRLMaterializer is up to date apart from its pending
+    /// changes, where a null materializer means that the ontology is not
+    /// supported by the RLMaterializer
+    bool mRLMaterializerValid;
+
+    /// Compiled data ranges of data properties
+    std::map<IRI, DataRangeValidator::Ptr> mDataRangeValidators;
+    /// Compiled single data ranges
+    std::map<OWLDataRange::Ptr, DataRangeValidator::Ptr> mDataRangeValidatorsByRange;
+
+    /// Journal of the tell operations and changes, if enabled, \see
+    /// setJournaling
+    TellJournal mJournal;
+
+    /// Whether applied changes require a refresh of the knowledge base,
+    /// which is deferred to the next query, \see applyChanges
+    bool mRefreshPending;
+
+    /// Optional arena for model objects, \see enableArena
+    Arena::Ptr mpArena;
+
+    /// Observer of added and removed axioms, \see setAxiomChangeCallback
+    std::function<void(const OWLAxiom::Ptr&, bool)> mAxiomChangeCallback;
+
+    /**
+     * Create a model object, in the arena if arena allocation is enabled
+     */
+    template<typename T, typename... Args>
+    shared_ptr<T> create(Args&&... args) const
+    {
+        if(mpArena)
+        {
+            return allocate_shared<T>(ArenaAllocator<T>(mpArena), std::forward<Args>(args)...);
+        }
+        return make_shared<T>(std::forward<Args>(args)...);
+    }
+
     OWLClass::Ptr getClass(const IRI& iri) const;
     OWLAnonymousClassExpression::Ptr getAnonymousClassExpression(const IRI& iri) const;
 
@@ -139,22 +228,99 @@ protected:
     OWLIndividual::Ptr getIndividual(const IRI& iri) const;
     OWLAnonymousIndividual::Ptr getAnonymousIndividual(const IRI& iri) const;
 
+    /**
+     * Get the IRI to index an annotation subject by, i.e. the IRI itself or
+     * the reference id of an anonymous individual
+     * \throw std::invalid_argument if the type of subject is not supported
+     */
+    static IRI getAnnotationSubjectIRI(const OWLAnnotationSubject::Ptr& subject);
+
     void addAxiom(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Add newly created axioms in a single batch
+     * \details In contrast to addAxiom, the axioms are not checked for being
+     * part of this ontology already
+     */
+    void addAxioms(const OWLAxiom::PtrList& axioms);
+
+    /**
+     * Add an axiom, which has been added to the axioms by type, to all other
+     * indexes
+     */
+    void indexAxiom(const OWLAxiom::Ptr& axiom);
+
     void removeAxiom(const OWLAxiom::Ptr& axiom);
 
-    void retractValueOf(const OWLIndividual::Ptr& individual, const OWLDataProperty::Ptr& property);
+    /**
+     * Remove axioms and retract them from the knowledge base in a single
+     * batch
+     */
+    void removeAxioms(const OWLAxiom::PtrList& axioms);
+
+    /**
+     * Remove an axiom from all indexes of this ontology without updating the
+     * knowledge base
+     * \return true if the axiom has been removed, false if it is not part of
+     * this ontology
+     */
+    bool removeAxiomFromIndex(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Append an axiom to a list of mAxiomsByType or mAxiomsByEntity
+     * \return false if the list contains the axiom already
+     */
+    bool addToAxiomList(OWLAxiom::PtrList& list, const OWLAxiom::Ptr& axiom);
 
     /**
-     * Remove an existing individual
+     * Remove an axiom from a list of mAxiomsByType or mAxiomsByEntity by
+     * swapping it with the last element
+     * \return false if the list does not contain the axiom
+     */
+    bool removeFromAxiomList(OWLAxiom::PtrList& list, const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Drop the compiled data ranges, which is required whenever a datatype
+     * or a data range changes
+     */
+    void clearDataRangeValidators();
+
+    /**
+     * Remove the data property assertion for the given individual and property
+     * (without updating the knowledge base)
+     * \return the removed axiom, or an empty pointer if none exists
+     */
+    OWLAxiom::Ptr retractValueOf(const OWLIndividual::Ptr& individual, const OWLDataProperty::Ptr& property);
+
+    /**
+     * Remove an existing individual including all axioms referencing it
      */
     void retractIndividual(const IRI& iri);
 
     void setAbsolutePath(const std::string& path) { mAbsolutePath = path; }
 
+    /**
+     * Create an ontology which consists of the given axioms of this ontology
+     * \details The new ontology shares the entities, anonymous expressions
+     * and axioms with this ontology and builds its own indexes
+     * \param includeEntity Filter of the entities to share, all entities
+     * if not set; if set, only the anonymous expressions which the axioms
+     * refer to are shared
+     * \param kb Knowledge base to populate, or an empty pointer for a
+     * structural ontology
+     */
+    shared_ptr<OWLOntology> createSubset(const OWLAxiom::PtrList& axioms,
+            const std::function<bool(const IRI&)>& includeEntity,
+            const shared_ptr<KnowledgeBase>& kb) const;
+
 public:
     typedef shared_ptr<OWLOntology> Ptr;
     typedef std::vector< Ptr > PtrList;
 
+    /**
+     * Refresh the knowledge base, i.e. classify and realize it
+     * \details Has no effect on a structural ontology
+     */
     void refresh();
 
     /**
@@ -163,16 +329,137 @@ public:
      */
     void cleanup();
 
+    /**
+     * Whether an ontology is backed by a reasoner
+     */
+    enum Mode {
+        /// Axioms are asserted to a knowledge base, i.e. a FaCT++ reasoning
+        /// kernel, as they are added
+        REASONING,
+        /// Axioms are only indexed in the model, no knowledge base is
+        /// created, \see attachKnowledgeBase
+        STRUCTURAL
+    };
+
     /**
      * Default constructor
      * \param kb Knowledge base which can be shared across multiple instances
      */
     OWLOntology(const shared_ptr<KnowledgeBase>& kb = shared_ptr<KnowledgeBase>());
 
+    /**
+     * Construct an ontology in the given mode
+     * \details A structural ontology suits tools which only inspect or
+     * convert the model, e.g. listing or writing an ontology, since neither
+     * a reasoning kernel is allocated nor are reasoner axioms built. All
+     * queries which require reasoning throw until a knowledge base is
+     * attached
+     */
+    explicit OWLOntology(Mode mode);
+
     ~OWLOntology();
 
     static OWLOntology::Ptr fromFile(const std::string& filename);
 
+    /**
+     * Get the mode of this ontology, i.e. STRUCTURAL as long as no
+     * knowledge base is attached
+     */
+    Mode getMode() const { return mpKnowledgeBase ? REASONING : STRUCTURAL; }
+
+    /**
+     * Check if a knowledge base is attached to this ontology
+     */
+    bool hasKnowledgeBase() const { return mpKnowledgeBase != nullptr; }
+
+    /**
+     * Attach a knowledge base to a structural ontology and assert all
+     * entities and axioms of the model to it in bulk
+     * \details Afterwards the ontology behaves as if it had been created in
+     * REASONING mode. Axioms which the knowledge base cannot represent are
+     * only part of the model, as for OWLOntologyTell
+     * \param kb Knowledge base to populate, a new one by default
+     * \throw std::runtime_error if a knowledge base is already attached
+     */
+    void attachKnowledgeBase(const shared_ptr<KnowledgeBase>& kb = shared_ptr<KnowledgeBase>());
+
+    /**
+     * Fork this ontology for what-if reasoning
+     *
+     * The child can add or retract axioms and reason without affecting
+     * this ontology (and vice versa). Model objects, i.e. entities,
+     * expressions and axioms, are not modified once they are part of an
+     * ontology, so the child shares them with this ontology and only
+     * copies the indexes -- additions and removals of either ontology
+     * affect its own indexes only. The reasoning kernel cannot be shared,
+     * so the knowledge base of the child is populated from the axioms. If
+     * this ontology is classified, the child adopts its taxonomy, so that
+     * class hierarchy queries are answered without classification until the
+     * child is changed; otherwise the child is classified on its first
+     * query. Forking thus still takes time and memory linear in the size of
+     * the ontology, for copying the indexes and populating the knowledge
+     * base.
+     * Forks of the same ontology can be used in parallel as long as this
+     * ontology is not modified while forking. The journal of the child is
+     * empty and enabled if the journal of this ontology is enabled.
+     * \return the child ontology
+     */
+    OWLOntology::Ptr fork() const;
+
+    /**
+     * Enable or disable the journal of tell operations and changes, which
+     * can be replayed against another ontology
+     * \details Journaling is disabled by default, since every recorded
+     * call keeps its replay operation and its axioms; disabling it drops
+     * all entries. Changes applied directly to this ontology, e.g. by
+     * applyChanges or when reloading, are recorded as well.
+     * \see TellJournal
+     */
+    void setJournaling(bool enabled) { mJournal.setEnabled(enabled); }
+
+    bool isJournaling() const { return mJournal.isEnabled(); }
+
+    /**
+     * Get the journal of this ontology
+     */
+    const TellJournal& getJournal() const { return mJournal; }
+
+    /**
+     * Allocate all entities and axioms, which are subsequently added to this
+     * ontology, from an arena which is released with the last object
+     * \details Reduces heap fragmentation and speeds up loading and teardown
+     * of large ontologies. Objects which have been created before remain
+     * valid. Forks of this ontology use an arena as well.
+     * \param blockSize Block size of the arena
+     */
+    void enableArena(size_t blockSize = Arena::DEFAULT_BLOCK_SIZE);
+
+    /**
+     * Get the arena of this ontology
+     * \return arena, or an empty pointer if arena allocation is not enabled
+     */
+    const Arena::Ptr& getArena() const { return mpArena; }
+
+    /**
+     * Callback for an axiom which has been added to (added is true) or
+     * removed from this ontology
+     */
+    typedef std::function<void(const OWLAxiom::Ptr& axiom, bool added)> AxiomChangeCallback;
+
+    /**
+     * Set the callback which observes all axiom additions and removals,
+     * independent of whether they result from tell operations, applied
+     * changes or reloads, e.g. to journal them
+     * \param callback Callback, an empty function to remove it
+     */
+    void setAxiomChangeCallback(const AxiomChangeCallback& callback) { mAxiomChangeCallback = callback; }
+
+    /**
+     * Get the callback which observes all axiom additions and removals,
+     * \see setAxiomChangeCallback
+     */
+    const AxiomChangeCallback& getAxiomChangeCallback() const { return mAxiomChangeCallback; }
+
     /**
      * Get the absolute path this ontology has been loaded from
      */
@@ -199,15 +486,54 @@ public:
     const AxiomMap& getAxiomMap() const { return mAxiomsByType; }
     OWLAxiom::PtrList getAxioms() const;
 
-    OWLAxiom::PtrList getReferencingAxioms(const OWLEntity::Ptr& entity, bool excludeImports);
+    /**
+     * Get all axioms whose signature contains the given entity
+     * \param excludeImports If true, only axioms originating from this
+     * ontology are returned, \see OWLAxiom::getOrigin
+     */
+    OWLAxiom::PtrList getReferencingAxioms(const OWLEntity::Ptr& entity, bool excludeImports = false) const;
+
+    /**
+     * Get all axioms whose signature contains the entity with the given IRI
+     * \param excludeImports If true, only axioms originating from this
+     * ontology are returned, \see OWLAxiom::getOrigin
+     */
+    OWLAxiom::PtrList getReferencingAxioms(const IRI& iri, bool excludeImports = false) const;
 
+    /**
+     * Apply a single change
+     * \see applyChanges
+     */
     ChangeApplied applyChange(const shared_ptr<OWLOntologyChange>& change);
 
+    /**
+     * Apply a batch of axiom changes, e.g. as computed by OWLEntityRemover
+     * \details The batch is validated before any change is applied. Changes
+     * are applied with their net effect, i.e. adding and removing the same
+     * axiom cancels out, where axioms are compared structurally. Removals
+     * are retracted from the knowledge base at once, additions are asserted
+     * in a single pass, and the refresh of the knowledge base is deferred to
+     * the next query via OWLOntologyAsk, so that consecutive batches are
+     * refreshed once. The batch is recorded in the journal of this
+     * ontology, \see setJournaling
+     * \return CHANGE_SUCCESS if the ontology has been modified,
+     * CHANGE_NO_OPERATION otherwise
+     * \throw std::invalid_argument if a change is not an axiom change of this
+     * ontology
+     */
+    ChangeApplied applyChanges(const std::vector< shared_ptr<OWLOntologyChange> >& changes);
+
     /**
       * Get access to the query cache object
       */
     QueryCache& getQueryCache() { return mQueryCache; }
 
+    /**
+     * Get the asserted hierarchies and their closure, which are built on
+     * first access after a change
+     */
+    const RDFSClosure& getRDFSClosure();
+
     /**
      * \see https://www.w3.org/TR/owl2-syntax/
      *  Entities are the fundamental building blocks of OWL 2 ontologies, and
@@ -217,6 +543,17 @@ public:
      *  contain literals, such as strings or integers.
      */
     OWLEntity::PtrList getSignature() const;
+
+    /**
+     * Get the estimated memory of the entity maps, axiom indexes and caches
+     * of this ontology, and of the expression registries of its knowledge
+     * base (as subsystem kb)
+     * \details Axioms and class expressions are estimated by the size of
+     * their base class, so that the estimate is a lower bound. If arena
+     * allocation is enabled, all model objects are accounted for by the
+     * arena instead
+     */
+    MemoryUsage getMemoryUsage() const;
 };
 
 } // ane namespace model
@@ -1,15 +1,200 @@
 #include "OWLOntologyAsk.hpp"
+#include <deque>
 #include "../KnowledgeBase.hpp"
 #include "../Vocabulary.hpp"
+#include "ELClassifier.hpp"
+#include "RLMaterializer.hpp"
 #include "OWLObjectIntersectionOf.hpp"
+#include "OWLObjectPropertyAssertionAxiom.hpp"
 
 namespace owlapi {
 namespace model {
 
-OWLOntologyAsk::OWLOntologyAsk(OWLOntology::Ptr ontology)
+OWLOntologyAsk::OWLOntologyAsk(OWLOntology::Ptr ontology, QueryMode mode)
     : mpOntology(ontology)
+    , mQueryMode(mode)
 {}
 
+bool OWLOntologyAsk::isToldInstanceOf(const IRI& instance, const IRI& klass) const
+{
+    return toldTypesOf(instance).count(klass);
+}
+
+IRISet OWLOntologyAsk::toldTypesOf(const IRI& instance) const
+{
+    IRISet types;
+    for(const OWLAxiom::Ptr& axiom : mpOntology->getReferencingAxioms(instance))
+    {
+        if(axiom->getAxiomType() != OWLAxiom::ClassAssertion)
+        {
+            continue;
+        }
+
+        OWLClassAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLClassAssertionAxiom>(axiom);
+        OWLClass::Ptr type = dynamic_pointer_cast<OWLClass>(assertion->getClassExpression());
+        // the instance might be a punned class, which is referenced as type
+        if(type && assertion->getIndividual()->getReferenceID() == instance)
+        {
+            types.insert(type->getIRI());
+        }
+    }
+    return types;
+}
+
+IRISet OWLOntologyAsk::rdfsTypesOf(const IRI& instance) const
+{
+    const RDFSClosure& rdfs = closure();
+    IRISet types = toldTypesOf(instance);
+
+    // the domains and ranges of a property apply to its subproperties
+    auto addTypesOf = [&rdfs, &types](const IRI& property, RDFSClosure::Hierarchy hierarchy, bool asRange)
+    {
+        IRISet properties = rdfs.getAncestors(hierarchy, property);
+        properties.insert(property);
+        for(const IRI& p : properties)
+        {
+            const IRISet& klasses = asRange ? rdfs.getRanges(p) : rdfs.getDomains(p);
+            types.insert(klasses.begin(), klasses.end());
+        }
+    };
+
+    const AssertionIndex& index = mpOntology->mAssertionIndex;
+    for(const IRI& property : index.getObjectProperties(instance, false))
+    {
+        addTypesOf(property, RDFSClosure::OBJECT_PROPERTY, false);
+    }
+    for(const IRI& property : index.getObjectProperties(instance, true))
+    {
+        if(!index.getInverseRelatedIndividuals(instance, property).empty())
+        {
+            addTypesOf(property, RDFSClosure::OBJECT_PROPERTY, true);
+        }
+    }
+    for(const IRI& property : index.getDataProperties(instance))
+    {
+        addTypesOf(property, RDFSClosure::DATA_PROPERTY, false);
+    }
+
+    IRISet closedTypes = types;
+    for(const IRI& type : types)
+    {
+        const IRISet& ancestors = rdfs.getAncestors(RDFSClosure::CLASS, type);
+        closedTypes.insert(ancestors.begin(), ancestors.end());
+    }
+    closedTypes.insert(vocabulary::OWL::Thing());
+    return closedTypes;
+}
+
+ELClassification::Ptr OWLOntologyAsk::elClassification() const
+{
+    if(!mpOntology->mELClassificationValid)
+    {
+        mpOntology->mpELClassification = ELClassifier(mpOntology).saturate();
+        mpOntology->mELClassificationValid = true;
+    }
+    return mpOntology->mpELClassification;
+}
+
+KnowledgeBase::Ptr OWLOntologyAsk::kb() const
+{
+    if(mpOntology->mRefreshPending)
+    {
+        mpOntology->refresh();
+    }
+    return mpOntology->kb();
+}
+
+RLMaterializer::Ptr OWLOntologyAsk::rlMaterializer() const
+{
+    if(mpOntology->mRLMaterializerValid && mpOntology->mpRLMaterializer
+            && !mpOntology->mpRLMaterializer->update())
+    {
+        mpOntology->mRLMaterializerValid = false;
+    }
+
+    if(!mpOntology->mRLMaterializerValid)
+    {
+        RLMaterializer::Ptr materializer = make_shared<RLMaterializer>();
+        if(materializer->materialize(mpOntology))
+        {
+            mpOntology->mpRLMaterializer = materializer;
+        } else {
+            mpOntology->mpRLMaterializer.reset();
+        }
+        mpOntology->mRLMaterializerValid = true;
+    }
+
+    RLMaterializer::Ptr materializer = mpOntology->mpRLMaterializer;
+    if(materializer && materializer->isConsistent())
+    {
+        return materializer;
+    }
+    return RLMaterializer::Ptr();
+}
+
+IRIList OWLOntologyAsk::mostSpecific(const IRISet& klasses) const
+{
+    const RDFSClosure& rdfs = closure();
+    IRIList specific;
+    for(const IRI& klass : klasses)
+    {
+        if(klass == vocabulary::OWL::Thing() && klasses.size() > 1)
+        {
+            continue;
+        }
+
+        bool hasSubclass = false;
+        for(const IRI& other : klasses)
+        {
+            if(other != klass
+                    && rdfs.isSubsumedBy(RDFSClosure::CLASS, other, klass)
+                    && !rdfs.isSubsumedBy(RDFSClosure::CLASS, klass, other))
+            {
+                hasSubclass = true;
+                break;
+            }
+        }
+        if(!hasSubclass)
+        {
+            specific.push_back(klass);
+        }
+    }
+    return specific;
+}
+
+IRISet OWLOntologyAsk::subsumedProperties(const IRI& property) const
+{
+    IRISet properties;
+    properties.insert(property);
+    if(mQueryMode == RDFS)
+    {
+        const RDFSClosure& rdfs = closure();
+        const IRISet& objectProperties = rdfs.getDescendants(RDFSClosure::OBJECT_PROPERTY, property);
+        properties.insert(objectProperties.begin(), objectProperties.end());
+        const IRISet& dataProperties = rdfs.getDescendants(RDFSClosure::DATA_PROPERTY, property);
+        properties.insert(dataProperties.begin(), dataProperties.end());
+    }
+    return properties;
+}
+
+IRIList OWLOntologyAsk::filterByClass(const IRIList& instances, const IRI& klass) const
+{
+    if(klass.empty())
+    {
+        return instances;
+    }
+
+    IRIList filtered;
+    for(const IRI& instance : instances)
+    {
+        if(isInstanceOf(instance, klass))
+        {
+            filtered.push_back(instance);
+        }
+    }
+    return filtered;
+}
+
 
 OWLClassExpression::Ptr OWLOntologyAsk::getOWLClassExpression(const IRI& iri) const
 {
@@ -58,14 +243,9 @@ const IRI& OWLOntologyAsk::getOWLClassExpressionIRI(const OWLClassExpression::Pt
     OWLClass::Ptr aClass = dynamic_pointer_cast<OWLClass>(expression);
     if(aClass)
     {
-        std::map<IRI, OWLClass::Ptr>::const_iterator it = std::find_if(
-                mpOntology->mClasses.begin(),
-                mpOntology->mClasses.end(),
-                [&aClass](const std::pair<IRI, OWLClass::Ptr>& other)
-                {
-                    return other.second == aClass;
-                });
-
+        // lookup by iri, so that classes of a forked ontology can be
+        // resolved as well
+        std::map<IRI, OWLClass::Ptr>::const_iterator it = mpOntology->mClasses.find(aClass->getIRI());
         if(it != mpOntology->mClasses.end())
         {
             return it->first;
@@ -472,12 +652,29 @@ std::vector<OWLCardinalityRestriction::Ptr> OWLOntologyAsk::getCardinalityRestri
 
 bool OWLOntologyAsk::isSubClassOf(const IRI& iri, const IRI& superclass) const
 {
+    switch(mQueryMode)
+    {
+        case TOLD:
+            return iri == superclass || closure().getParents(RDFSClosure::CLASS, iri).count(superclass);
+        case RDFS:
+            return superclass == vocabulary::OWL::Thing()
+                || closure().isSubsumedBy(RDFSClosure::CLASS, iri, superclass);
+        default:
+            break;
+    }
+
     std::pair<bool, bool> result = mpOntology->mQueryCache.isSubClassOf(iri, superclass);
     if(result.second)
     {
         return result.first;
     } else {
-        result.first = mpOntology->kb()->isSubClassOf(iri, superclass);
+        ELClassification::Ptr classification = elClassification();
+        if(classification && classification->hasClass(iri) && classification->hasClass(superclass))
+        {
+            result.first = classification->isSubClassOf(iri, superclass);
+        } else {
+            result.first = kb()->isSubClassOf(iri, superclass);
+        }
         result.second = true;
 
         mpOntology->mQueryCache.cacheIsSubClassOf(iri, superclass,
@@ -548,64 +745,303 @@ bool OWLOntologyAsk::isRDFProperty(const IRI& iri) const
 
 IRIList OWLOntologyAsk::allInstancesOf(const IRI& classType, bool direct) const
 {
-    return mpOntology->kb()->allInstancesOf(classType, direct);
+    if(mQueryMode == INFERRED)
+    {
+        RLMaterializer::Ptr materializer;
+        if((classType == vocabulary::OWL::Thing() || isOWLClass(classType))
+                && (materializer = rlMaterializer()))
+        {
+            IRIList instances = materializer->getInstances(classType);
+            if(direct)
+            {
+                // drop the instances of a strict subclass
+                instances.erase(std::remove_if(instances.begin(), instances.end(), [this, &materializer, &classType](const IRI& instance)
+                            {
+                                for(const IRI& type : materializer->getTypes(instance))
+                                {
+                                    if(type != classType && isSubClassOf(type, classType) && !isSubClassOf(classType, type))
+                                    {
+                                        return true;
+                                    }
+                                }
+                                return false;
+                            }), instances.end());
+            }
+            return instances;
+        }
+        return kb()->allInstancesOf(classType, direct);
+    }
+
+    if(classType == vocabulary::OWL::Thing() && mQueryMode == RDFS)
+    {
+        IRIList instances = allInstances();
+        if(direct)
+        {
+            instances.erase(std::remove_if(instances.begin(), instances.end(), [this](const IRI& instance)
+                        {
+                            return allTypesOf(instance, true) != IRIList(1, vocabulary::OWL::Thing());
+                        }), instances.end());
+        }
+        return instances;
+    }
+
+    IRISet klasses;
+    klasses.insert(classType);
+    if(mQueryMode == RDFS)
+    {
+        const IRISet& descendants = closure().getDescendants(RDFSClosure::CLASS, classType);
+        klasses.insert(descendants.begin(), descendants.end());
+    }
+
+    IRISet candidates;
+    for(const IRI& klass : klasses)
+    {
+        std::map<IRI, OWLClass::Ptr>::const_iterator cit = mpOntology->mClasses.find(klass);
+        if(cit == mpOntology->mClasses.end())
+        {
+            continue;
+        }
+        std::map<OWLClassExpression::Ptr, std::vector<OWLClassAssertionAxiom::Ptr> >::const_iterator ait =
+            mpOntology->mClassAssertionAxiomsByClass.find(cit->second);
+        if(ait != mpOntology->mClassAssertionAxiomsByClass.end())
+        {
+            for(const OWLClassAssertionAxiom::Ptr& axiom : ait->second)
+            {
+                candidates.insert(axiom->getIndividual()->getReferenceID());
+            }
+        }
+    }
+
+    if(mQueryMode == RDFS)
+    {
+        // subjects and objects of relations via properties with one of the
+        // classes as domain or range
+        auto addRelated = [this, &candidates](const IRI& property, bool asRange)
+        {
+            for(const IRI& p : subsumedProperties(property))
+            {
+                std::unordered_map<IRI, OWLAxiom::PtrList>::const_iterator cit = mpOntology->mAxiomsByEntity.find(p);
+                if(cit == mpOntology->mAxiomsByEntity.end())
+                {
+                    continue;
+                }
+                for(const OWLAxiom::Ptr& axiom : cit->second)
+                {
+                    OWLPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLPropertyAssertionAxiom>(axiom);
+                    if(!assertion)
+                    {
+                        continue;
+                    }
+                    OWLProperty::Ptr assertedProperty = dynamic_pointer_cast<OWLProperty>(assertion->getProperty());
+                    if(!assertedProperty || assertedProperty->getIRI() != p)
+                    {
+                        continue;
+                    }
+
+                    if(!asRange)
+                    {
+                        candidates.insert(assertion->getSubject()->getReferenceID());
+                    } else {
+                        OWLIndividual::Ptr object = dynamic_pointer_cast<OWLIndividual>(assertion->getObject());
+                        if(object)
+                        {
+                            candidates.insert(object->getReferenceID());
+                        }
+                    }
+                }
+            }
+        };
+
+        const RDFSClosure& rdfs = closure();
+        for(const IRI& klass : klasses)
+        {
+            for(const IRI& property : rdfs.getPropertiesWithDomain(klass))
+            {
+                addRelated(property, false);
+            }
+            for(const IRI& property : rdfs.getPropertiesWithRange(klass))
+            {
+                addRelated(property, true);
+            }
+        }
+    }
+
+    IRIList instances;
+    for(const IRI& candidate : candidates)
+    {
+        if(direct && mQueryMode == RDFS)
+        {
+            IRIList types = allTypesOf(candidate, true);
+            if(std::find(types.begin(), types.end(), classType) == types.end())
+            {
+                continue;
+            }
+        }
+        instances.push_back(candidate);
+    }
+    return instances;
 }
 
 IRIList OWLOntologyAsk::allSubClassesOf(const IRI& classType, bool direct) const
 {
-    return mpOntology->kb()->allSubClassesOf(classType, direct);
+    if(mQueryMode == INFERRED)
+    {
+        ELClassification::Ptr classification = elClassification();
+        if(classification && classification->hasClass(classType))
+        {
+            return classification->getRelatives(classType, direct, false);
+        }
+        return kb()->allSubClassesOf(classType, direct);
+    }
+
+    const RDFSClosure& rdfs = closure();
+    if(mQueryMode == RDFS && classType == vocabulary::OWL::Thing())
+    {
+        // owl:Thing is implicitly the parent of all root classes
+        IRIList subclasses = allClasses();
+        subclasses.erase(std::remove_if(subclasses.begin(), subclasses.end(), [&rdfs, direct](const IRI& klass)
+                    {
+                        return klass == vocabulary::OWL::Thing()
+                            || (direct && !rdfs.getParents(RDFSClosure::CLASS, klass).empty());
+                    }), subclasses.end());
+        return subclasses;
+    }
+
+    const IRISet& subclasses = (mQueryMode == TOLD || direct)
+        ? rdfs.getChildren(RDFSClosure::CLASS, classType)
+        : rdfs.getDescendants(RDFSClosure::CLASS, classType);
+    return IRIList(subclasses.begin(), subclasses.end());
 }
 
 std::vector<IRIList> OWLOntologyAsk::allSubClassesOfWithDistance(const IRI& classType) const
 {
-    std::vector<IRIList> list;
-    IRIList allDirectSubclasses = allSubClassesOf(classType, true);
-    list.push_back(allDirectSubclasses);
+    if(mQueryMode == INFERRED)
+    {
+        return getTaxonomy()->getDescendantsWithDistance(classType);
+    }
 
-    while(!allDirectSubclasses.empty())
+    // breadth first traversal of the asserted hierarchy, with the same
+    // layout as Taxonomy::getDescendantsWithDistance
+    OWLOntologyAsk asserted = withQueryMode(RDFS);
+    std::vector<IRIList> descendants(1);
+    IRISet visited;
+    visited.insert(classType);
+    IRIList level = asserted.allSubClassesOf(classType, true);
+    while(!level.empty())
     {
-        IRIList subclasses;
-        for(const IRI& iri : allDirectSubclasses)
+        IRIList nextLevel;
+        for(const IRI& klass : level)
         {
-            IRIList directSubclasses = allSubClassesOf(iri, true);
-            subclasses.insert(subclasses.begin(), directSubclasses.begin(), directSubclasses.end());
+            if(!visited.insert(klass).second)
+            {
+                continue;
+            }
+            descendants.back().push_back(klass);
+            IRIList subclasses = asserted.allSubClassesOf(klass, true);
+            nextLevel.insert(nextLevel.end(), subclasses.begin(), subclasses.end());
         }
-        list.push_back(subclasses);
-        allDirectSubclasses = subclasses;
+        if(!descendants.back().empty())
+        {
+            descendants.push_back(IRIList());
+        }
+        level.swap(nextLevel);
     }
-    return list;
+    return descendants;
 }
 
 IRIList OWLOntologyAsk::allUnderivedSubClassesOf(const IRI& classType) const
 {
-    IRIList noChildrenSubclass;
-    IRIList subclasses = allSubClassesOf(classType, false);
-    IRIList::const_iterator cit = subclasses.begin();
-    for(; cit != subclasses.end(); ++cit)
+    if(mQueryMode == INFERRED)
+    {
+        return getTaxonomy()->getLeaves(classType);
+    }
+
+    OWLOntologyAsk asserted = withQueryMode(RDFS);
+    IRIList leaves;
+    for(const IRI& klass : asserted.allSubClassesOf(classType))
     {
-        const IRI& subclass = *cit;
-        IRIList subclassesOfSubclass = allSubClassesOf(subclass, true);
-        if(subclassesOfSubclass.empty())
+        if(asserted.allSubClassesOf(klass, true).empty())
         {
-            noChildrenSubclass.push_back(subclass);
+            leaves.push_back(klass);
         }
     }
-    return noChildrenSubclass;
+    return leaves;
+}
+
+Taxonomy::Ptr OWLOntologyAsk::getTaxonomy() const
+{
+    ELClassification::Ptr classification = elClassification();
+    if(classification)
+    {
+        return classification->getTaxonomy();
+    }
+    return kb()->getTaxonomy();
+}
+
+TaxonomySnapshot OWLOntologyAsk::getTaxonomySnapshot() const
+{
+    return mpOntology->kb()->getTaxonomySnapshot();
 }
 
 IRIList OWLOntologyAsk::allInstances() const
 {
-    return mpOntology->kb()->allInstances();
+    if(mQueryMode == INFERRED)
+    {
+        return kb()->allInstances();
+    }
+
+    IRIList instances;
+    for(const auto& p : mpOntology->mNamedIndividuals)
+    {
+        instances.push_back(p.first);
+    }
+    for(const auto& p : mpOntology->mAnonymousIndividuals)
+    {
+        instances.push_back(p.first);
+    }
+    return instances;
 }
 
 IRIList OWLOntologyAsk::allClasses(bool excludeBottomClass) const
 {
-    return mpOntology->kb()->allClasses(excludeBottomClass);
+    if(mQueryMode == INFERRED)
+    {
+        return kb()->allClasses(excludeBottomClass);
+    }
+
+    IRIList klasses;
+    for(const auto& p : mpOntology->mClasses)
+    {
+        if(!excludeBottomClass || p.first != vocabulary::OWL::Nothing())
+        {
+            klasses.push_back(p.first);
+        }
+    }
+    return klasses;
 }
 
 IRIList OWLOntologyAsk::allEquivalentClasses(const IRI& klass) const
 {
-    return mpOntology->kb()->allEquivalentClasses(klass);
+    if(mQueryMode == INFERRED)
+    {
+        ELClassification::Ptr classification = elClassification();
+        if(classification && classification->hasClass(klass))
+        {
+            return classification->getEquivalentClasses(klass);
+        }
+        return kb()->allEquivalentClasses(klass);
+    }
+
+    // as the reasoner, include the class itself
+    IRIList klasses(1, klass);
+    for(const IRI& other : allSubClassesOf(klass))
+    {
+        if(areEquivalent(klass, other))
+        {
+            klasses.push_back(other);
+        }
+    }
+    return klasses;
 }
 
 std::vector<OWLClassExpression::Ptr> OWLOntologyAsk::allEquivalentClassExpressions(const IRI& klass) const
@@ -678,7 +1114,16 @@ IRIList OWLOntologyAsk::allDataProperties() const
 IRIList OWLOntologyAsk::allDataTypes() const
 {
     IRIList list;
-    for(const auto& p : mpOntology->kb()->dataTypes())
+    if(mQueryMode != INFERRED || !mpOntology->hasKnowledgeBase())
+    {
+        for(const auto& p : mpOntology->mDataTypes)
+        {
+            list.push_back(p.first);
+        }
+        return list;
+    }
+
+    for(const auto& p : kb()->dataTypes())
     {
         list.push_back(p.first);
     }
@@ -698,32 +1143,176 @@ IRIList OWLOntologyAsk::allAnnotationProperties() const
 
 bool OWLOntologyAsk::isInstanceOf(const IRI& instance, const IRI& klass) const
 {
-    return mpOntology->kb()->isInstanceOf(instance, klass);
+    switch(mQueryMode)
+    {
+        case TOLD:
+            return isToldInstanceOf(instance, klass);
+        case RDFS:
+            return rdfsTypesOf(instance).count(klass);
+        default:
+            break;
+    }
+
+    if((klass == vocabulary::OWL::Thing() || isOWLClass(klass)) && isOWLIndividual(instance))
+    {
+        if(RLMaterializer::Ptr materializer = rlMaterializer())
+        {
+            return materializer->isInstanceOf(instance, klass);
+        }
+    }
+    return kb()->isInstanceOf(instance, klass);
 }
 
 bool OWLOntologyAsk::isRelatedTo(const IRI& instance, const IRI& relationProperty, const IRI& otherInstance) const
 {
-    return mpOntology->kb()->isRelatedTo(instance, relationProperty, otherInstance);
+    if(mQueryMode != INFERRED)
+    {
+        for(const IRI& property : subsumedProperties(relationProperty))
+        {
+            if(mpOntology->mAssertionIndex.isRelatedTo(instance, property, otherInstance))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    if(mpOntology->mObjectProperties.count(relationProperty) && isOWLIndividual(instance))
+    {
+        if(RLMaterializer::Ptr materializer = rlMaterializer())
+        {
+            return materializer->isRelatedTo(instance, relationProperty, otherInstance);
+        }
+    }
+    return kb()->isRelatedTo(instance, relationProperty, otherInstance);
 }
 
 IRIList OWLOntologyAsk::allTypesOf(const IRI& instance, bool direct) const
 {
-    return mpOntology->kb()->typesOf(instance, direct);
+    switch(mQueryMode)
+    {
+        case TOLD:
+        {
+            IRISet types = toldTypesOf(instance);
+            return IRIList(types.begin(), types.end());
+        }
+        case RDFS:
+        {
+            IRISet types = rdfsTypesOf(instance);
+            if(direct)
+            {
+                return mostSpecific(types);
+            }
+            return IRIList(types.begin(), types.end());
+        }
+        default:
+            break;
+    }
+
+    if(isOWLIndividual(instance))
+    {
+        if(RLMaterializer::Ptr materializer = rlMaterializer())
+        {
+            IRIList types = materializer->getTypes(instance);
+            if(direct)
+            {
+                // drop the types which have a strict subclass among the types
+                IRIList directTypes;
+                for(const IRI& type : types)
+                {
+                    bool hasSubclass = false;
+                    for(const IRI& other : types)
+                    {
+                        if(other != type && isSubClassOf(other, type) && !isSubClassOf(type, other))
+                        {
+                            hasSubclass = true;
+                            break;
+                        }
+                    }
+                    if(!hasSubclass)
+                    {
+                        directTypes.push_back(type);
+                    }
+                }
+                return directTypes;
+            }
+            return types;
+        }
+    }
+    return kb()->typesOf(instance, direct);
 }
 
 IRI OWLOntologyAsk::typeOf(const IRI& instance) const
 {
-    return mpOntology->kb()->typeOf(instance);
+    if(mQueryMode != INFERRED)
+    {
+        IRIList types = allTypesOf(instance, true);
+        if(types.empty())
+        {
+            throw std::invalid_argument("owlapi::model::OWLOntologyAsk::typeOf: "
+                    "instance " + instance.toQuotedString() + " has no told type");
+        }
+        return types.front();
+    }
+    return kb()->typeOf(instance);
 }
 
 IRIList OWLOntologyAsk::allRelatedInstances(const IRI& instance, const IRI& relationProperty, const IRI& klass) const
 {
-    return mpOntology->kb()->allRelatedInstances(instance, relationProperty, klass);
+    if(mQueryMode != INFERRED)
+    {
+        IRIList instances;
+        for(const IRI& property : subsumedProperties(relationProperty))
+        {
+            IRIList related = mpOntology->mAssertionIndex.getRelatedIndividuals(instance, property);
+            for(const IRI& r : related)
+            {
+                if(std::find(instances.begin(), instances.end(), r) == instances.end())
+                {
+                    instances.push_back(r);
+                }
+            }
+        }
+        return filterByClass(instances, klass);
+    }
+
+    if(mpOntology->mObjectProperties.count(relationProperty) && isOWLIndividual(instance))
+    {
+        if(RLMaterializer::Ptr materializer = rlMaterializer())
+        {
+            return filterByClass(materializer->getRelatedIndividuals(instance, relationProperty), klass);
+        }
+    }
+    return kb()->allRelatedInstances(instance, relationProperty, klass);
 }
 
 IRIList OWLOntologyAsk::allInverseRelatedInstances(const IRI& instance, const IRI& relationProperty, const IRI& klass) const
 {
-    return mpOntology->kb()->allInverseRelatedInstances(instance, relationProperty, klass);
+    if(mQueryMode != INFERRED)
+    {
+        IRIList instances;
+        for(const IRI& property : subsumedProperties(relationProperty))
+        {
+            IRIList related = mpOntology->mAssertionIndex.getInverseRelatedIndividuals(instance, property);
+            for(const IRI& r : related)
+            {
+                if(std::find(instances.begin(), instances.end(), r) == instances.end())
+                {
+                    instances.push_back(r);
+                }
+            }
+        }
+        return filterByClass(instances, klass);
+    }
+
+    if(mpOntology->mObjectProperties.count(relationProperty) && isOWLIndividual(instance))
+    {
+        if(RLMaterializer::Ptr materializer = rlMaterializer())
+        {
+            return filterByClass(materializer->getInverseRelatedIndividuals(instance, relationProperty), klass);
+        }
+    }
+    return kb()->allInverseRelatedInstances(instance, relationProperty, klass);
 }
 
 
@@ -731,62 +1320,93 @@ OWLAnnotationValue::Ptr OWLOntologyAsk::getAnnotationValue(const IRI& instance,
         const IRI& annotationProperty,
         bool includeAncestors) const
 {
-    for(const auto& p : mpOntology->mAnnotationAxioms)
+    typedef std::unordered_map< std::pair<IRI, IRI>, OWLAnnotationAssertionAxiom::PtrList > AnnotationIndex;
+    const AnnotationIndex& index = mpOntology->mAnnotationAssertionsBySubjectAndProperty;
+
+    AnnotationIndex::const_iterator cit = index.find( std::make_pair(instance, annotationProperty) );
+    if(cit != index.end() && !cit->second.empty())
     {
-        const OWLAnnotationProperty::Ptr& aProperty = p.first;
-        const std::vector<OWLAxiom::Ptr>& axioms = p.second;
-        if(aProperty->getIRI() != annotationProperty)
-        {
-            continue;
-        }
+        return cit->second.front()->annotationValue();
+    }
 
-        for(const OWLAxiom::Ptr& axiom : axioms)
+    // check for parent value when punning is active: walk the told
+    // ancestors breadth first, so that the value of the nearest ancestor is
+    // used; annotations are not subject to reasoning, so the walk does not
+    // need to classify the knowledge base
+    if(includeAncestors && isOWLClass(instance))
+    {
+        const RDFSClosure& rdfs = closure();
+        std::deque<IRI> queue(1, instance);
+        IRISet visited;
+        visited.insert(instance);
+        while(!queue.empty())
         {
-            OWLAnnotationAssertionAxiom::Ptr assertionAxiom = dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom);
-            if(assertionAxiom)
+            IRI klass = queue.front();
+            queue.pop_front();
+            for(const IRI& parentClass : rdfs.getParents(RDFSClosure::CLASS, klass))
             {
-                OWLAnnotationSubject::Ptr subject = assertionAxiom->getSubject();
-                switch(subject->getObjectType())
+                if(!visited.insert(parentClass).second)
                 {
-                    case OWLObject::IRIType:
-                    {
-                        IRI target = *dynamic_pointer_cast<IRI>(subject).get();
-                        if(target == instance)
-                        {
-                            return assertionAxiom->annotationValue();
-                        }
-                        break;
-                    }
-                    case OWLObject::AnonymousIndividual:
-                        if(dynamic_pointer_cast<OWLAnonymousIndividual>(subject)->getReferenceID() == instance)
-                        {
-                            return assertionAxiom->annotationValue();
-                        }
-                        break;
-                    default:
-                        throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getAnnotationValue:"
-                                " encountered unknown type for AnnotationSubject");
+                    continue;
+                }
+                cit = index.find( std::make_pair(parentClass, annotationProperty) );
+                if(cit != index.end() && !cit->second.empty())
+                {
+                    return cit->second.front()->annotationValue();
                 }
+                queue.push_back(parentClass);
             }
         }
-        throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getAnnotationValue:"
-                " failed to extract annotation '" +
-                annotationProperty.toString() +
-                "' for " +
-                instance.toString()
-                );
+    }
 
+    std::map<IRI, OWLAnnotationProperty::Ptr>::const_iterator pit = mpOntology->mAnnotationProperties.find(annotationProperty);
+    if(pit != mpOntology->mAnnotationProperties.end())
+    {
+        std::map<OWLAnnotationProperty::Ptr, std::vector<OWLAxiom::Ptr> >::const_iterator ait =
+            mpOntology->mAnnotationAxioms.find(pit->second);
+        if(ait != mpOntology->mAnnotationAxioms.end() && !ait->second.empty())
+        {
+            throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getAnnotationValue:"
+                    " failed to extract annotation '" +
+                    annotationProperty.toString() +
+                    "' for " +
+                    instance.toString()
+                    );
+        }
     }
     return OWLAnnotationValue::Ptr();
 }
 
+OWLAnnotationAssertionAxiom::PtrList OWLOntologyAsk::getAnnotationAssertionAxioms(const IRI& subject) const
+{
+    std::unordered_map<IRI, OWLAnnotationAssertionAxiom::PtrList>::const_iterator cit =
+        mpOntology->mAnnotationAssertionsBySubject.find(subject);
+    if(cit != mpOntology->mAnnotationAssertionsBySubject.end())
+    {
+        return cit->second;
+    }
+    return OWLAnnotationAssertionAxiom::PtrList();
+}
+
 OWLLiteral::Ptr OWLOntologyAsk::getDataValue(const IRI& instance,
         const IRI& dataProperty,
         bool includeAncestors) const
 {
+    if(mQueryMode != INFERRED)
+    {
+        OWLLiteral::PtrList values = mpOntology->mAssertionIndex.getValues(instance, dataProperty);
+        if(values.empty())
+        {
+            throw std::runtime_error("owlapi::model:OWLOntologyAsk::getDataValue: "
+                    "instance " + instance.toQuotedString() + " has no told value related via "
+                    + dataProperty.toQuotedString());
+        }
+        return values.back();
+    }
+
     std::string msg;
     try {
-        reasoner::factpp::DataValue dataValue = mpOntology->kb()->getDataValue(instance, dataProperty);
+        reasoner::factpp::DataValue dataValue = kb()->getDataValue(instance, dataProperty);
 
         std::string valueRepresentation = dataValue.getValue();
         if(dataValue.getType().empty())
@@ -829,7 +1449,11 @@ OWLLiteral::Ptr OWLOntologyAsk::getDataValue(const IRI& instance,
 
 IRIList OWLOntologyAsk::getDataPropertyDomain(const IRI& dataProperty, bool direct) const
 {
-    return mpOntology->kb()->getDataPropertyDomain(dataProperty, direct);
+    if(mQueryMode != INFERRED)
+    {
+        return assertedDomain(dataProperty, RDFSClosure::DATA_PROPERTY, direct);
+    }
+    return kb()->getDataPropertyDomain(dataProperty, direct);
 }
 
 OWLDataRange::PtrList OWLOntologyAsk::getDataRange(const IRI& dataProperty) const
@@ -844,6 +1468,32 @@ OWLDataRange::PtrList OWLOntologyAsk::getDataRange(const IRI& dataProperty) cons
             " no data property '" + dataProperty.toString() + "' found");
 }
 
+DataRangeValidator::Ptr OWLOntologyAsk::getDataRangeValidator(const IRI& dataProperty) const
+{
+    std::map<IRI, DataRangeValidator::Ptr>::const_iterator cit = mpOntology->mDataRangeValidators.find(dataProperty);
+    if(cit != mpOntology->mDataRangeValidators.end())
+    {
+        return cit->second;
+    }
+
+    DataRangeValidator::Ptr validator = DataRangeValidator::compile( getDataRange(dataProperty) );
+    mpOntology->mDataRangeValidators[dataProperty] = validator;
+    return validator;
+}
+
+DataRangeValidator::Ptr OWLOntologyAsk::getDataRangeValidator(const OWLDataRange::Ptr& range) const
+{
+    std::map<OWLDataRange::Ptr, DataRangeValidator::Ptr>::const_iterator cit = mpOntology->mDataRangeValidatorsByRange.find(range);
+    if(cit != mpOntology->mDataRangeValidatorsByRange.end())
+    {
+        return cit->second;
+    }
+
+    DataRangeValidator::Ptr validator = DataRangeValidator::compile(range);
+    mpOntology->mDataRangeValidatorsByRange[range] = validator;
+    return validator;
+}
+
 OWLDataType OWLOntologyAsk::getDataType(const IRI& dataProperty, const std::string& value) const
 {
     OWLDataRange::PtrList dataRanges = getDataRange(dataProperty);
@@ -855,10 +1505,11 @@ OWLDataType OWLOntologyAsk::getDataType(const IRI& dataProperty, const std::stri
             case OWLDataRange::DATATYPE:
             case OWLDataRange::DATA_ONE_OF:
                 return OWLDataType::fromRange(range, value);
+            case OWLDataRange::DATATYPE_RESTRICTION:
+                return OWLDataType::fromRange(range, value, getDataRangeValidator(range));
             case OWLDataRange::DATA_UNION_OF:
             case OWLDataRange::DATA_COMPLEMENT_OF:
             case OWLDataRange::DATA_INTERSECTION_OF:
-            case OWLDataRange::DATATYPE_RESTRICTION:
                 throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getDataType: "
                         " data range '" + OWLDataRange::TypeTxt[rangeType] + "' for '" + dataProperty.toString() + "' is unsupported");
         }
@@ -870,21 +1521,92 @@ OWLDataType OWLOntologyAsk::getDataType(const IRI& dataProperty, const std::stri
 
 IRIList OWLOntologyAsk::getObjectPropertyDomain(const IRI& objectProperty, bool direct) const
 {
-    return mpOntology->kb()->getObjectPropertyDomain(objectProperty, direct);
+    if(mQueryMode != INFERRED)
+    {
+        return assertedDomain(objectProperty, RDFSClosure::OBJECT_PROPERTY, direct);
+    }
+    return kb()->getObjectPropertyDomain(objectProperty, direct);
+}
+
+IRIList OWLOntologyAsk::assertedDomain(const IRI& property, RDFSClosure::Hierarchy hierarchy, bool direct) const
+{
+    const RDFSClosure& rdfs = closure();
+    IRISet domains = rdfs.getDomains(property);
+    if(mQueryMode == RDFS)
+    {
+        // the domain of a superproperty applies as well
+        for(const IRI& superproperty : rdfs.getAncestors(hierarchy, property))
+        {
+            const IRISet& inherited = rdfs.getDomains(superproperty);
+            domains.insert(inherited.begin(), inherited.end());
+        }
+
+        if(!direct)
+        {
+            IRISet closedDomains = domains;
+            for(const IRI& domain : domains)
+            {
+                const IRISet& ancestors = rdfs.getAncestors(RDFSClosure::CLASS, domain);
+                closedDomains.insert(ancestors.begin(), ancestors.end());
+            }
+            closedDomains.insert(vocabulary::OWL::Thing());
+            return IRIList(closedDomains.begin(), closedDomains.end());
+        }
+        return mostSpecific(domains);
+    }
+    return IRIList(domains.begin(), domains.end());
 }
 
 IRIList OWLOntologyAsk::ancestors(const IRI& iri, bool direct) const
 {
+    if(mQueryMode != INFERRED)
+    {
+        RDFSClosure::Hierarchy hierarchy;
+        if(isOWLClass(iri))
+        {
+            hierarchy = RDFSClosure::CLASS;
+        } else if(isObjectProperty(iri))
+        {
+            hierarchy = RDFSClosure::OBJECT_PROPERTY;
+        } else if(isDataProperty(iri))
+        {
+            hierarchy = RDFSClosure::DATA_PROPERTY;
+        } else {
+            throw std::invalid_argument("owlapi::model::OWLOntology::ancestors: '"
+                    + iri.toString() + "' is not a known class, object or data property");
+        }
+
+        const RDFSClosure& rdfs = closure();
+        if(mQueryMode == TOLD || direct)
+        {
+            const IRISet& parents = rdfs.getParents(hierarchy, iri);
+            return IRIList(parents.begin(), parents.end());
+        }
+
+        IRISet ancestors = rdfs.getAncestors(hierarchy, iri);
+        if(hierarchy == RDFSClosure::CLASS && iri != vocabulary::OWL::Thing())
+        {
+            ancestors.insert(vocabulary::OWL::Thing());
+        }
+        return IRIList(ancestors.begin(), ancestors.end());
+    }
+
     if(isOWLClass(iri))
     {
-        return mpOntology->kb()->allAncestorsOf(iri, direct);
+        // the reasoner adds the types of punned individuals
+        ELClassification::Ptr classification = elClassification();
+        if(classification && classification->hasClass(iri) && !isOWLIndividual(iri))
+        {
+            return classification->getRelatives(iri, direct, true);
+        }
+        return kb()->allAncestorsOf(iri, direct);
     } else if(isObjectProperty(iri))
     {
-        return mpOntology->kb()->allAncestorObjectProperties(iri, direct);
+        return kb()->allAncestorObjectProperties(iri, direct);
 
     } else if(isDataProperty(iri))
     {
-        return mpOntology->kb()->allAncestorDataProperties(iri, direct);
+        return kb()->allAncestorDataProperties(iri, direct);
     } else {
         throw std::invalid_argument("owlapi::model::OWLOntology::ancestors: '"
                 + iri.toString() + "' is not a known class, object or data property");
@@ -893,18 +1615,37 @@ IRIList OWLOntologyAsk::ancestors(const IRI& iri, bool direct) const
 
 bool OWLOntologyAsk::areEquivalent(const IRI& klassA, const IRI& klassB) const
 {
-    return mpOntology->kb()->isEquivalentClass(klassA, klassB);
+    if(mQueryMode != INFERRED)
+    {
+        return isSubClassOf(klassA, klassB) && isSubClassOf(klassB, klassA);
+    }
+
+    ELClassification::Ptr classification = elClassification();
+    if(classification && classification->hasClass(klassA) && classification->hasClass(klassB))
+    {
+        return classification->isSubClassOf(klassA, klassB) && classification->isSubClassOf(klassB, klassA);
+    }
+    return kb()->isEquivalentClass(klassA, klassB);
 }
 
 bool OWLOntologyAsk::isDatatype(const IRI& iri) const
 {
-    return mpOntology->kb()->isDatatype(iri);
+    if(mQueryMode != INFERRED || !mpOntology->hasKnowledgeBase())
+    {
+        return mpOntology->mDataTypes.count(iri);
+    }
+    return kb()->isDatatype(iri);
 }
 
 bool OWLOntologyAsk::isObjectProperty(const IRI& property) const
 {
+    if(mQueryMode != INFERRED || !mpOntology->hasKnowledgeBase())
+    {
+        return mpOntology->mObjectProperties.count(property);
+    }
+
     try {
-        mpOntology->kb()->getObjectProperty(property);
+        kb()->getObjectProperty(property);
         return true;
     } catch(const std::exception& e)
     {
@@ -914,8 +1655,13 @@ bool OWLOntologyAsk::isObjectProperty(const IRI& property) const
 
 bool OWLOntologyAsk::isDataProperty(const IRI& property) const
 {
+    if(mQueryMode != INFERRED || !mpOntology->hasKnowledgeBase())
+    {
+        return mpOntology->mDataProperties.count(property);
+    }
+
     try {
-        mpOntology->kb()->getDataProperty(property);
+        kb()->getDataProperty(property);
         return true;
     } catch(const std::exception& e)
     {
@@ -931,7 +1677,7 @@ bool OWLOntologyAsk::isAnnotationProperty(const IRI& property) const
 IRIList OWLOntologyAsk::getObjectPropertiesForDomain(const IRI& domain) const
 {
     IRIList validProperties;
-    IRIList objectProperties = mpOntology->kb()->allObjectProperties();
+    IRIList objectProperties = mQueryMode == INFERRED ? kb()->allObjectProperties() : allObjectProperties();
     IRIList::const_iterator cit = objectProperties.begin();
     for(; cit != objectProperties.end(); ++cit)
     {
@@ -948,7 +1694,7 @@ IRIList OWLOntologyAsk::getObjectPropertiesForDomain(const IRI& domain) const
 IRIList OWLOntologyAsk::getDataPropertiesForDomain(const IRI& domain) const
 {
     IRIList validProperties;
-    IRIList dataProperties = mpOntology->kb()->allDataProperties();
+    IRIList dataProperties = mQueryMode == INFERRED ? kb()->allDataProperties() : allDataProperties();
     IRIList::const_iterator cit = dataProperties.begin();
     for(; cit != dataProperties.end(); ++cit)
     {
@@ -965,12 +1711,34 @@ IRIList OWLOntologyAsk::getDataPropertiesForDomain(const IRI& domain) const
 
 IRISet OWLOntologyAsk::getRelatedObjectProperties(const IRI& instance, bool needInverse) const
 {
-    return mpOntology->kb()->getRelatedObjectProperties(instance, needInverse);
+    if(mQueryMode != INFERRED)
+    {
+        IRISet properties = mpOntology->mAssertionIndex.getObjectProperties(instance, needInverse);
+        return mQueryMode == RDFS ? withAncestors(properties, RDFSClosure::OBJECT_PROPERTY) : properties;
+    }
+    return kb()->getRelatedObjectProperties(instance, needInverse);
 }
 
 IRISet OWLOntologyAsk::getRelatedDataProperties(const IRI& instance) const
 {
-    return mpOntology->kb()->getRelatedDataProperties(instance);
+    if(mQueryMode != INFERRED)
+    {
+        IRISet properties = mpOntology->mAssertionIndex.getDataProperties(instance);
+        return mQueryMode == RDFS ? withAncestors(properties, RDFSClosure::DATA_PROPERTY) : properties;
+    }
+    return kb()->getRelatedDataProperties(instance);
+}
+
+IRISet OWLOntologyAsk::withAncestors(const IRISet& iris, RDFSClosure::Hierarchy hierarchy) const
+{
+    const RDFSClosure& rdfs = closure();
+    IRISet closed = iris;
+    for(const IRI& iri : iris)
+    {
+        const IRISet& ancestors = rdfs.getAncestors(hierarchy, iri);
+        closed.insert(ancestors.begin(), ancestors.end());
+    }
+    return closed;
 }
 
 bool OWLOntologyAsk::isSubClassOfIntersection(const IRI& klass, const IRIList& intersection) const
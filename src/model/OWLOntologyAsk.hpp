@@ -5,6 +5,8 @@
 #include "OWLCardinalityRestriction.hpp"
 #include "OWLLiteral.hpp"
 #include "OWLDataProperty.hpp"
+#include "Taxonomy.hpp"
+#include "DataRangeValidator.hpp"
 
 namespace owlapi {
 namespace model {
@@ -14,12 +16,124 @@ namespace model {
  */
 class OWLOntologyAsk
 {
+public:
+    /// Reasoning level which answers hierarchy, type and relation queries
+    /// \details The TOLD and RDFS levels never access the reasoner, and can
+    /// thus be used for structural ontologies as well. The reasoner remains
+    /// required for the taxonomy, i.e. getTaxonomy, getTaxonomySnapshot,
+    /// and for data values via punning
+    enum QueryMode {
+        /// Query the reasoner, i.e. include all (DL) inferred facts
+        /// \details The class hierarchy of ontologies which are supported
+        /// by the ELClassifier is computed by this classifier instead, and
+        /// the types and relations of individuals of ontologies which are
+        /// supported by the RLMaterializer are materialized by it
+        INFERRED,
+        /// Answer from the asserted axioms only: the hierarchies consist of
+        /// the asserted subclass, subproperty and equivalence axioms
+        /// between named entities without transitive closure, i.e. there
+        /// is no difference between direct and indirect queries,
+        /// individuals have their asserted types
+        /// and relations only, klass filters use the asserted types of an
+        /// individual, and data values are not inherited via punning
+        TOLD,
+        /// As TOLD, but with the transitive closure of the asserted
+        /// hierarchies, and the types which follow from the domains and
+        /// ranges of the asserted relations (including those of
+        /// superproperties); relations via a subproperty count as relations
+        /// via the property
+        RDFS
+    };
+
+private:
     OWLOntology::Ptr mpOntology;
+    QueryMode mQueryMode;
+
+    /**
+     * Check whether the instance has been asserted to be of the given class
+     */
+    bool isToldInstanceOf(const IRI& instance, const IRI& klass) const;
+
+    /**
+     * Get the asserted (named) types of an instance
+     */
+    IRISet toldTypesOf(const IRI& instance) const;
+
+    /**
+     * Get the types of an instance according to the RDFS level, including
+     * owl:Thing
+     */
+    IRISet rdfsTypesOf(const IRI& instance) const;
+
+    /**
+     * Get the class hierarchy as computed by the ELClassifier
+     * \return classification, or a null pointer if the ontology is not
+     * supported by the classifier
+     */
+    shared_ptr<ELClassification> elClassification() const;
+
+    /**
+     * Get the materialized assertions as computed by the RLMaterializer,
+     * after applying pending changes of the ABox
+     * \return materializer, or a null pointer if the ontology is not
+     * supported by the materializer or inconsistent
+     */
+    shared_ptr<RLMaterializer> rlMaterializer() const;
+
+    /**
+     * Get the asserted hierarchies and their closure of the ontology
+     */
+    const RDFSClosure& closure() const { return mpOntology->getRDFSClosure(); }
+
+    /**
+     * Get the knowledge base, after the refresh which has been deferred by
+     * applied changes, \see OWLOntology::applyChanges
+     */
+    shared_ptr<KnowledgeBase> kb() const;
+
+    /**
+     * Get the most specific classes of a set of classes according to the
+     * asserted hierarchy
+     */
+    IRIList mostSpecific(const IRISet& klasses) const;
+
+    /**
+     * Extend a set of entities by their ancestors in the asserted hierarchy
+     */
+    IRISet withAncestors(const IRISet& iris, RDFSClosure::Hierarchy hierarchy) const;
+
+    /**
+     * Get the asserted domain of a property for the TOLD and RDFS level
+     */
+    IRIList assertedDomain(const IRI& property, RDFSClosure::Hierarchy hierarchy, bool direct) const;
+
+    /**
+     * Get the given property and, at the RDFS level, all its subproperties
+     */
+    IRISet subsumedProperties(const IRI& property) const;
+
+    /**
+     * Filter a list of instances by class, unless klass is empty
+     */
+    IRIList filterByClass(const IRIList& instances, const IRI& klass) const;
 
 public:
     typedef shared_ptr<OWLOntologyAsk> Ptr;
 
-    OWLOntologyAsk(OWLOntology::Ptr ontology);
+    OWLOntologyAsk(OWLOntology::Ptr ontology, QueryMode mode = INFERRED);
+
+    void setQueryMode(QueryMode mode) { mQueryMode = mode; }
+
+    QueryMode getQueryMode() const { return mQueryMode; }
+
+    /**
+     * Get a copy of this instance which answers with the given mode, e.g.,
+     * to select the reasoning level of a single call
+     * \verbatim
+        IRIList subclasses = ask.withQueryMode(OWLOntologyAsk::RDFS).allSubClassesOf(klass);
+     \endverbatim
+     */
+    OWLOntologyAsk withQueryMode(QueryMode mode) const { return OWLOntologyAsk(mpOntology, mode); }
 
     /**
      * Get the OWLClass instance by IRI
@@ -254,7 +368,9 @@ public:
 
     /**
      * Retrieve all subclasses of a given klass
-     * \return hierachical list of all subclasses with increasing link distance
+     * \return hierachical list of all subclasses with increasing link
+     * distance, each subclass is listed once with its shortest distance
+     * \details Traverses the asserted hierarchy unless the mode is INFERRED
      */
     std::vector<IRIList> allSubClassesOfWithDistance(const IRI& klass) const;
 
@@ -262,9 +378,26 @@ public:
      * Retrieve all underived subclasses, i.e. the leaves in the inheritance
      * tree
      * \return the list of underived subclassed of a particular class type
+     * \details Traverses the asserted hierarchy unless the mode is INFERRED
      */
     IRIList allUnderivedSubClassesOf(const IRI& classType) const;
 
+    /**
+     * Get the snapshot of the class hierarchy for traversals
+     * \details Always uses the reasoner, or the ELClassifier if it supports
+     * the ontology, independent of the query mode
+     * \see KnowledgeBase::getTaxonomy
+     */
+    Taxonomy::Ptr getTaxonomy() const;
+
+    /**
+     * Get the last completed snapshot of the class hierarchy without waiting
+     * for background reasoning
+     * \details Always uses the reasoner, independent of the query mode
+     * \see KnowledgeBase::getTaxonomySnapshot
+     */
+    TaxonomySnapshot getTaxonomySnapshot() const;
+
     /**
      * Retrieve all known instance of the given class type
      */
@@ -371,6 +504,21 @@ public:
      */
     OWLDataRange::PtrList getDataRange(const IRI& dataProperty) const;
 
+    /**
+     * Get the compiled data range for the given data property, in order to
+     * validate values
+     * \throw std::invalid_argument if data property is not known, or a data
+     * range is not supported
+     */
+    DataRangeValidator::Ptr getDataRangeValidator(const IRI& dataProperty) const;
+
+    /**
+     * Get the compiled form of a single data range, which is cached until a
+     * datatype or data range of the ontology changes
+     * \throw std::invalid_argument if the data range is not supported
+     */
+    DataRangeValidator::Ptr getDataRangeValidator(const OWLDataRange::Ptr& range) const;
+
     /**
      * Get the data type for the given data property and a particular value
      * based on the available data ranges (if available)
@@ -392,12 +540,20 @@ public:
      * \param instance Name of the instance to get the annotation property for
      * \param annotationProperty Name of the annotationProperty to check the relation for
      * \param includeAncestors When using punning allow to retrieve associated
-     * property from a parent class
+     * property from the nearest told superclass
      * \return data value
      */
     OWLAnnotationValue::Ptr getAnnotationValue(const IRI& instance, const IRI& annotationProperty,
             bool includeAncestors = true) const;
 
+    /**
+     * Retrieve all annotation assertions of a subject
+     * \param subject IRI of the subject, or reference id of an anonymous
+     * individual
+     * \return list of annotation assertions, which is empty if there is none
+     */
+    OWLAnnotationAssertionAxiom::PtrList getAnnotationAssertionAxioms(const IRI& subject) const;
+
     /**
      * Retrieve the list of ancestors of a given klass, object or data property
      * \param iri Name of klass, object or data property
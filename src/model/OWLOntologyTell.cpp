@@ -30,11 +30,42 @@
 #include "OWLObjectComplementOf.hpp"
 #include "OWLObjectHasValue.hpp"
 
+#include <algorithm>
+#include <unordered_map>
 #include <base-logging/Logging.hpp>
 
+/// Record the outermost tell call in the ontology's journal, if journaling is
+/// enabled, so that it can be replayed against another ontology
+#define OWLAPI_TELL_JOURNAL(call) \
+    TellJournal::Scope journalScope(mpOntology->mJournal, mOrigin); \
+    if(journalScope.isRecording()) \
+    { \
+        journalScope.setOperation([=](OWLOntologyTell& tell) { tell.call; }); \
+    }
+
 namespace owlapi {
 namespace model {
 
+namespace {
+
+/**
+ * Find an entity of a given kind in the ontology's registry of such entities
+ * \throw std::invalid_argument if the entity is not known
+ */
+template<typename T>
+shared_ptr<T> findEntity(const std::map<IRI, shared_ptr<T> >& entities, const IRI& iri, const std::string& kind)
+{
+    typename std::map<IRI, shared_ptr<T> >::const_iterator cit = entities.find(iri);
+    if(cit == entities.end())
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntologyTell::assertBatch: '"
+                + iri.toString() + "' is not a known " + kind);
+    }
+    return cit->second;
+}
+
+} // end anonymous namespace
+
 OWLOntologyTell::OWLOntologyTell(OWLOntology::Ptr ontology, const IRI& origin)
     : mpOntology(ontology)
     , mAsk(ontology)
@@ -48,6 +79,7 @@ OWLOntologyTell::OWLOntologyTell(OWLOntology::Ptr ontology, const IRI& origin)
 
 void OWLOntologyTell::initializeDefaultClasses()
 {
+    OWLAPI_TELL_JOURNAL(initializeDefaultClasses());
     klass(vocabulary::OWL::Class());
     klass(vocabulary::OWL::DeprecatedClass());
     klass(vocabulary::OWL::Thing());
@@ -187,28 +219,40 @@ void OWLOntologyTell::initializeDefaultClasses()
 
 OWLClass::Ptr OWLOntologyTell::klass(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(klass(iri));
     LOG_DEBUG_S << "Retrieve class: " << iri;
     std::map<IRI, OWLClass::Ptr>::const_iterator it = mpOntology->mClasses.find(iri);
     if(it != mpOntology->mClasses.end())
     {
         return it->second;
     } else {
-        OWLClass::Ptr klass = make_shared<OWLClass>(iri);
+        OWLClass::Ptr klass = mpOntology->create<OWLClass>(iri);
         mpOntology->mClasses[iri] = klass;
 
         // Update kb
-        mpOntology->kb()->getClassLazy(iri);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.getClassLazy(iri); });
 
         OWLEntity::Ptr entity = OWLEntity::klass(iri);
-        OWLAxiom::Ptr axiom = make_shared<OWLDeclarationAxiom>(entity);
+        OWLAxiom::Ptr axiom = mpOntology->create<OWLDeclarationAxiom>(entity);
         addAxiom(axiom);
 
         return klass;
     }
 }
 
+OWLClassExpression::Ptr OWLOntologyTell::localize(const OWLClassExpression::Ptr& expression)
+{
+    OWLClass::Ptr aClass = dynamic_pointer_cast<OWLClass>(expression);
+    if(aClass)
+    {
+        return klass(aClass->getIRI());
+    }
+    return expression;
+}
+
 OWLAnonymousClassExpression::Ptr OWLOntologyTell::anonymousClass(const IRI& iri, const OWLAnonymousClassExpression::Ptr expression)
 {
+    OWLAPI_TELL_JOURNAL(anonymousClass(iri, expression));
     std::map<IRI, OWLAnonymousClassExpression::Ptr>::iterator it = mpOntology->mAnonymousClassExpressions.find(iri);
     if(expression)
     {
@@ -219,7 +263,7 @@ OWLAnonymousClassExpression::Ptr OWLOntologyTell::anonymousClass(const IRI& iri,
         {
             return it->second;
         }
-        OWLAnonymousClassExpression::Ptr aClass = make_shared<OWLAnonymousClassExpression>();
+        OWLAnonymousClassExpression::Ptr aClass = mpOntology->create<OWLAnonymousClassExpression>();
         mpOntology->mAnonymousClassExpressions[iri] = aClass;
         return aClass;
     }
@@ -227,35 +271,37 @@ OWLAnonymousClassExpression::Ptr OWLOntologyTell::anonymousClass(const IRI& iri,
 
 OWLAnonymousIndividual::Ptr OWLOntologyTell::anonymousIndividual(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(anonymousIndividual(iri));
     std::map<IRI, OWLAnonymousIndividual::Ptr>::const_iterator it = mpOntology->mAnonymousIndividuals.find(iri);
     if(it != mpOntology->mAnonymousIndividuals.end())
     {
         return it->second;
     } else {
         NodeID node(iri.toString(), true);
-        OWLAnonymousIndividual::Ptr individual = make_shared<OWLAnonymousIndividual>(node);
+        OWLAnonymousIndividual::Ptr individual = mpOntology->create<OWLAnonymousIndividual>(node);
         mpOntology->mAnonymousIndividuals[iri] = individual;
 
-        mpOntology->kb()->getInstanceLazy(iri);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.getInstanceLazy(iri); });
         return individual;
     }
 }
 
 OWLNamedIndividual::Ptr OWLOntologyTell::namedIndividual(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(namedIndividual(iri));
     std::map<IRI, OWLNamedIndividual::Ptr>::const_iterator it = mpOntology->mNamedIndividuals.find(iri);
     if(it != mpOntology->mNamedIndividuals.end())
     {
         return it->second;
     } else {
-        OWLNamedIndividual::Ptr individual = make_shared<OWLNamedIndividual>(iri);
+        OWLNamedIndividual::Ptr individual = mpOntology->create<OWLNamedIndividual>(iri);
         mpOntology->mNamedIndividuals[iri] = individual;
 
         //Update kb
-        mpOntology->kb()->getInstanceLazy(iri);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.getInstanceLazy(iri); });
 
         OWLEntity::Ptr entity = OWLEntity::namedIndividual(iri);
-        OWLAxiom::Ptr axiom = OWLAxiom::declare(entity);
+        OWLAxiom::Ptr axiom = mpOntology->create<OWLDeclarationAxiom>(entity);
         addAxiom(axiom);
 
         return individual;
@@ -264,35 +310,39 @@ OWLNamedIndividual::Ptr OWLOntologyTell::namedIndividual(const IRI& iri)
 
 void OWLOntologyTell::directlyImports(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(directlyImports(iri));
     mpOntology->addDirectImportsDocument(iri);
 }
 
 
 void OWLOntologyTell::imports(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(imports(iri));
     mpOntology->addImportsDocument(iri);
 }
 
 void OWLOntologyTell::rdfProperty(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(rdfProperty(iri));
     mpOntology->mRDFProperties.insert(iri);
 }
 
 OWLObjectProperty::Ptr OWLOntologyTell::objectProperty(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(objectProperty(iri));
     std::map<IRI, OWLObjectProperty::Ptr>::const_iterator it = mpOntology->mObjectProperties.find(iri);
     if(it != mpOntology->mObjectProperties.end())
     {
         return it->second;
     } else {
-        OWLObjectProperty::Ptr property = make_shared<OWLObjectProperty>(iri);
+        OWLObjectProperty::Ptr property = mpOntology->create<OWLObjectProperty>(iri);
         mpOntology->mObjectProperties[iri] = property;
 
         //Update kb
-        mpOntology->kb()->getObjectPropertyLazy(iri);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.getObjectPropertyLazy(iri); });
 
         OWLEntity::Ptr entity = OWLEntity::objectProperty(iri);
-        addAxiom( OWLAxiom::declare(entity) );
+        addAxiom( mpOntology->create<OWLDeclarationAxiom>(entity) );
 
         return property;
     }
@@ -300,25 +350,27 @@ OWLObjectProperty::Ptr OWLOntologyTell::objectProperty(const IRI& iri)
 
 OWLDataProperty::Ptr OWLOntologyTell::dataProperty(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(dataProperty(iri));
     std::map<IRI, OWLDataProperty::Ptr>::const_iterator it = mpOntology->mDataProperties.find(iri);
     if(it != mpOntology->mDataProperties.end())
     {
         return it->second;
     } else {
         //Update kb
-        mpOntology->kb()->getDataPropertyLazy(iri);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.getDataPropertyLazy(iri); });
 
         OWLEntity::Ptr entity = OWLEntity::dataProperty(iri);
         OWLDataProperty::Ptr property = ptr_cast<OWLDataProperty, OWLEntity>(entity);
         mpOntology->mDataProperties[iri] = property;
 
-        addAxiom( OWLAxiom::declare(entity) );
+        addAxiom( mpOntology->create<OWLDeclarationAxiom>(entity) );
         return property;
     }
 }
 
 OWLAnnotationProperty::Ptr OWLOntologyTell::annotationProperty(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(annotationProperty(iri));
     std::map<IRI, OWLAnnotationProperty::Ptr>::const_iterator it = mpOntology->mAnnotationProperties.find(iri);
     if(it != mpOntology->mAnnotationProperties.end())
     {
@@ -326,7 +378,7 @@ OWLAnnotationProperty::Ptr OWLOntologyTell::annotationProperty(const IRI& iri)
     } else {
 
         OWLEntity::Ptr entity = OWLEntity::annotationProperty(iri);
-        addAxiom( OWLAxiom::declare(entity) );
+        addAxiom( mpOntology->create<OWLDeclarationAxiom>(entity) );
 
         OWLAnnotationProperty::Ptr property = ptr_cast<OWLAnnotationProperty, OWLEntity>(entity, true);
         mpOntology->mAnnotationProperties[iri] = property;
@@ -339,6 +391,7 @@ OWLAnnotationProperty::Ptr OWLOntologyTell::annotationProperty(const IRI& iri)
 
 void OWLOntologyTell::removeAnnotationProperty(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(removeAnnotationProperty(iri));
     OWLAnnotationProperty::Ptr property = mpOntology->mAnnotationProperties[iri];
     mpOntology->mAnnotationProperties.erase(iri);
 
@@ -355,27 +408,36 @@ void OWLOntologyTell::removeAnnotationProperty(const IRI& iri)
             });
     if(ait != axioms.end())
     {
-        axioms.erase(ait);
+        // copy, since the entry is overwritten by the removal
+        OWLAxiom::Ptr axiom = *ait;
+        mpOntology->removeFromAxiomList(axioms, axiom);
     }
 }
 
 OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const IRI& subclass, const OWLClassExpression::Ptr& superclass)
 {
+    OWLAPI_TELL_JOURNAL(subClassOf(subclass, tell.localize(superclass)));
     OWLClass::Ptr e_subclass = klass(subclass);
     return subClassOf(e_subclass, superclass);
 }
 
 OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const IRI& subclass, const IRI& superclass)
 {
+    OWLAPI_TELL_JOURNAL(subClassOf(subclass, superclass));
     // All classes inherit from top concept, i.e. owl:Thing
     OWLClass::Ptr e_subclass = klass(subclass);
     if(mAsk.isOWLAnonymousClassExpression(superclass))
     {
         OWLAnonymousClassExpression::Ptr e_superclass = mAsk.getOWLAnonymousClassExpression(superclass);
 
-        mpOntology->kb()->subClassOf(subclass, superclass);
+        reasoner::factpp::Axiom kbAxiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+            {
+                return kb.subClassOf(subclass, superclass);
+            });
 
-        return subClassOf(e_subclass, dynamic_pointer_cast<OWLClassExpression>(e_superclass));
+        OWLSubClassOfAxiom::Ptr axiom = subClassOf(e_subclass, dynamic_pointer_cast<OWLClassExpression>(e_superclass));
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.addReference(axiom, kbAxiom); });
+        return axiom;
 
     } else {
         OWLClass::Ptr e_superclass = klass(superclass);
@@ -385,15 +447,23 @@ OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const IRI& subclass, const I
 
 OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const OWLClass::Ptr& subclass, const OWLClass::Ptr& superclass)
 {
-    mpOntology->kb()->subClassOf(subclass->getIRI(), superclass->getIRI());
-    return subClassOf(ptr_cast<OWLClassExpression,OWLClass>(subclass),
+    OWLAPI_TELL_JOURNAL(subClassOf(tell.klass(subclass->getIRI()), tell.klass(superclass->getIRI())));
+    reasoner::factpp::Axiom kbAxiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.subClassOf(subclass->getIRI(), superclass->getIRI());
+        });
+    OWLSubClassOfAxiom::Ptr axiom = subClassOf(ptr_cast<OWLClassExpression,OWLClass>(subclass),
             ptr_cast<OWLClassExpression, OWLClass>(superclass));
+    // allow to retract the axiom, e.g. when the axiom is removed by a reload
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.addReference(axiom, kbAxiom); });
+    return axiom;
 }
 
 
 OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const OWLClassExpression::Ptr& subclassExpression, const OWLClassExpression::Ptr& superclassExpression)
 {
-    OWLSubClassOfAxiom::Ptr axiom = make_shared<OWLSubClassOfAxiom>(subclassExpression, superclassExpression);
+    OWLAPI_TELL_JOURNAL(subClassOf(tell.localize(subclassExpression), tell.localize(superclassExpression)));
+    OWLSubClassOfAxiom::Ptr axiom = mpOntology->create<OWLSubClassOfAxiom>(subclassExpression, superclassExpression);
     mpOntology->mSubClassAxiomBySubPosition[subclassExpression].push_back(axiom);
     mpOntology->mSubClassAxiomBySuperPosition[superclassExpression].push_back(axiom);
 
@@ -415,105 +485,132 @@ OWLCardinalityRestriction::Ptr OWLOntologyTell::objectCardinalityRestriction(
 
 OWLAxiom::Ptr OWLOntologyTell::addAxiom(const OWLAxiom::Ptr& axiom)
 {
+    OWLAPI_TELL_JOURNAL(addAxiom(axiom));
     axiom->setOrigin(mOrigin);
     mpOntology->addAxiom(axiom);
+    mpOntology->mJournal.recordAxiom(axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::addAxiom(const OWLAxiom::Ptr& axiom, const reasoner::factpp::Axiom& kbAxiom)
 {
-    mpOntology->kb()->addReference(axiom, kbAxiom);
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.addReference(axiom, kbAxiom); });
     addAxiom(axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::equalClasses(const IRIList& klasses)
 {
+    OWLAPI_TELL_JOURNAL(equalClasses(klasses));
     OWLClassExpression::PtrList pKlasses;
     for(const IRI& classType : klasses)
     {
         OWLClassExpression::Ptr pKlass = mAsk.getOWLClassExpression(classType);
         pKlasses.push_back(pKlass);
     }
-    OWLEquivalentClassesAxiom::Ptr axiom = make_shared<OWLEquivalentClassesAxiom>(pKlasses);
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->equalClasses(klasses);
+    OWLEquivalentClassesAxiom::Ptr axiom = mpOntology->create<OWLEquivalentClassesAxiom>(pKlasses);
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb) { return kb.equalClasses(klasses); });
     addAxiom(axiom, kb_axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::equalObjectProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->equalObjectProperties(properties);
+    OWLAPI_TELL_JOURNAL(equalObjectProperties(properties));
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.equalObjectProperties(properties);
+        });
     OWLObjectPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
         OWLObjectPropertyExpression::Ptr pProperty = objectProperty(p);
         pProperties.push_back(pProperty);
     }
-    OWLEquivalentObjectPropertiesAxiom::Ptr axiom = make_shared<OWLEquivalentObjectPropertiesAxiom>(pProperties);
+    OWLEquivalentObjectPropertiesAxiom::Ptr axiom = mpOntology->create<OWLEquivalentObjectPropertiesAxiom>(pProperties);
     addAxiom(axiom, kb_axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::equalDataProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->equalDataProperties(properties);
+    OWLAPI_TELL_JOURNAL(equalDataProperties(properties));
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.equalDataProperties(properties);
+        });
     OWLDataPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
         OWLDataPropertyExpression::Ptr pProperty = dataProperty(p);
         pProperties.push_back(pProperty);
     }
-    OWLEquivalentDataPropertiesAxiom::Ptr axiom = make_shared<OWLEquivalentDataPropertiesAxiom>(pProperties);
+    OWLEquivalentDataPropertiesAxiom::Ptr axiom = mpOntology->create<OWLEquivalentDataPropertiesAxiom>(pProperties);
     addAxiom(axiom, kb_axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointObjectProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjointObjectProperties(properties);
+    OWLAPI_TELL_JOURNAL(disjointObjectProperties(properties));
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.disjointObjectProperties(properties);
+        });
     OWLObjectPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
         OWLObjectPropertyExpression::Ptr pProperty = objectProperty(p);
         pProperties.push_back(pProperty);
     }
-    OWLDisjointObjectPropertiesAxiom::Ptr axiom = make_shared<OWLDisjointObjectPropertiesAxiom>(pProperties);
+    OWLDisjointObjectPropertiesAxiom::Ptr axiom = mpOntology->create<OWLDisjointObjectPropertiesAxiom>(pProperties);
     addAxiom(axiom, kb_axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointDataProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjointDataProperties(properties);
+    OWLAPI_TELL_JOURNAL(disjointDataProperties(properties));
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.disjointDataProperties(properties);
+        });
     OWLDataPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
         OWLDataPropertyExpression::Ptr pProperty = dataProperty(p);
         pProperties.push_back(pProperty);
     }
-    OWLDisjointDataPropertiesAxiom::Ptr axiom = make_shared<OWLDisjointDataPropertiesAxiom>(pProperties);
+    OWLDisjointDataPropertiesAxiom::Ptr axiom = mpOntology->create<OWLDisjointDataPropertiesAxiom>(pProperties);
     addAxiom(axiom, kb_axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointClasses(const IRIList& klasses)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjoint(klasses, KnowledgeBase::CLASS);
+    OWLAPI_TELL_JOURNAL(disjointClasses(klasses));
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.disjoint(klasses, KnowledgeBase::CLASS);
+        });
     OWLClassExpression::PtrList pKlasses;
     for(const IRI& classType : klasses)
     {
         OWLClassExpression::Ptr pKlass = klass(classType);
         pKlasses.push_back(pKlass);
     }
-    OWLDisjointClassesAxiom::Ptr axiom = make_shared<OWLDisjointClassesAxiom>(pKlasses);
+    OWLDisjointClassesAxiom::Ptr axiom = mpOntology->create<OWLDisjointClassesAxiom>(pKlasses);
     addAxiom(axiom, kb_axiom);
     return axiom;
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointUnion(const IRI& unionClass, const IRIList& disjointKlasses)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjointUnion(unionClass, disjointKlasses);
+    OWLAPI_TELL_JOURNAL(disjointUnion(unionClass, disjointKlasses));
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.disjointUnion(unionClass, disjointKlasses);
+        });
     OWLClassExpression::PtrList pKlasses;
     for(const IRI& classType : disjointKlasses)
     {
@@ -521,7 +618,7 @@ OWLAxiom::Ptr OWLOntologyTell::disjointUnion(const IRI& unionClass, const IRILis
         pKlasses.push_back(pKlass);
     }
 
-    OWLDisjointUnionAxiom::Ptr axiom = make_shared<OWLDisjointUnionAxiom>(klass(unionClass), pKlasses);
+    OWLDisjointUnionAxiom::Ptr axiom = mpOntology->create<OWLDisjointUnionAxiom>(klass(unionClass), pKlasses);
     addAxiom(axiom, kb_axiom);
     return axiom;
 }
@@ -529,13 +626,17 @@ OWLAxiom::Ptr OWLOntologyTell::disjointUnion(const IRI& unionClass, const IRILis
 
 OWLClassAssertionAxiom::Ptr OWLOntologyTell::instanceOf(const IRI& instance, const IRI& classType)
 {
+    OWLAPI_TELL_JOURNAL(instanceOf(instance, classType));
     // Update reasoner kb
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->instanceOf(instance, classType);
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.instanceOf(instance, classType);
+        });
 
     // ClassAssertion
     OWLNamedIndividual::Ptr e_individual = namedIndividual(instance);
     OWLClassExpression::Ptr e_class = klass(classType);
-    OWLClassAssertionAxiom::Ptr axiom = make_shared<OWLClassAssertionAxiom>(e_individual, e_class);
+    OWLClassAssertionAxiom::Ptr axiom = mpOntology->create<OWLClassAssertionAxiom>(e_individual, e_class);
 
     // Register
     mpOntology->mClassAssertionAxiomsByClass[e_class].push_back(axiom);
@@ -551,61 +652,73 @@ OWLClassAssertionAxiom::Ptr OWLOntologyTell::instanceOf(const IRI& instance, con
 
 OWLAxiom::Ptr OWLOntologyTell::inverseFunctionalProperty(const IRI& property)
 {
-    mpOntology->kb()->inverseFunctionalProperty(property);
+    OWLAPI_TELL_JOURNAL(inverseFunctionalProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.inverseFunctionalProperty(property); });
     return addUnaryObjectPropertyAxiom<OWLInverseFunctionalObjectPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::reflexiveProperty(const IRI& property)
 {
-    mpOntology->kb()->reflexiveProperty(property);
+    OWLAPI_TELL_JOURNAL(reflexiveProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.reflexiveProperty(property); });
     return addUnaryObjectPropertyAxiom<OWLReflexiveObjectPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::irreflexiveProperty(const IRI& property)
 {
-    mpOntology->kb()->irreflexiveProperty(property);
+    OWLAPI_TELL_JOURNAL(irreflexiveProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.irreflexiveProperty(property); });
     return addUnaryObjectPropertyAxiom<OWLIrreflexiveObjectPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::symmetricProperty(const IRI& property)
 {
-    mpOntology->kb()->symmetricProperty(property);
+    OWLAPI_TELL_JOURNAL(symmetricProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.symmetricProperty(property); });
     return addUnaryObjectPropertyAxiom<OWLSymmetricObjectPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::asymmetricProperty(const IRI& property)
 {
-    mpOntology->kb()->asymmetricProperty(property);
+    OWLAPI_TELL_JOURNAL(asymmetricProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.asymmetricProperty(property); });
     return addUnaryObjectPropertyAxiom<OWLAsymmetricObjectPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::transitiveProperty(const IRI& property)
 {
-    mpOntology->kb()->transitiveProperty(property);
+    OWLAPI_TELL_JOURNAL(transitiveProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.transitiveProperty(property); });
     return addUnaryObjectPropertyAxiom<OWLTransitiveObjectPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::functionalObjectProperty(const IRI& property)
 {
-    mpOntology->kb()->functionalProperty(property, KnowledgeBase::OBJECT);
+    OWLAPI_TELL_JOURNAL(functionalObjectProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.functionalProperty(property, KnowledgeBase::OBJECT); });
     return addUnaryObjectPropertyAxiom<OWLFunctionalObjectPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::functionalDataProperty(const IRI& property)
 {
-    mpOntology->kb()->functionalProperty(property, KnowledgeBase::DATA);
+    OWLAPI_TELL_JOURNAL(functionalDataProperty(property));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.functionalProperty(property, KnowledgeBase::DATA); });
     return addUnaryDataPropertyAxiom<OWLFunctionalDataPropertyAxiom>(property);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::relatedTo(const IRI& subject, const IRI& relation, const IRI& object)
 {
+    OWLAPI_TELL_JOURNAL(relatedTo(subject, relation, object));
     bool isAnnotationProperty = mAsk.isAnnotationProperty(relation);
     if(isAnnotationProperty)
     {
         return annotationOf(subject, relation, object);
     }
 
-    mpOntology->kb()->relatedTo(subject, relation, object);
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.relatedTo(subject, relation, object);
+        });
 
     LOG_DEBUG_S << "Add relation: " << std::endl
         << "    s: " << subject << std::endl
@@ -639,19 +752,19 @@ OWLAxiom::Ptr OWLOntologyTell::relatedTo(const IRI& subject, const IRI& relation
 
     if(mAsk.isObjectProperty(relation))
     {
-        OWLObjectPropertyAssertionAxiom::Ptr axiom = make_shared<OWLObjectPropertyAssertionAxiom>(
+        OWLObjectPropertyAssertionAxiom::Ptr axiom = mpOntology->create<OWLObjectPropertyAssertionAxiom>(
                     individual,
                     mpOntology->getObjectProperty(relation),
                     assertionObject);
-        return addAxiom(axiom);
+        return addAxiom(axiom, kb_axiom);
 
     } else if(mAsk.isDataProperty(relation))
     {
-        OWLDataPropertyAssertionAxiom::Ptr axiom = make_shared<OWLDataPropertyAssertionAxiom>(
+        OWLDataPropertyAssertionAxiom::Ptr axiom = mpOntology->create<OWLDataPropertyAssertionAxiom>(
                     individual,
                     mpOntology->getDataProperty(relation),
                     dynamic_pointer_cast<OWLLiteral>(assertionObject) );
-        return addAxiom(axiom);
+        return addAxiom(axiom, kb_axiom);
     } else {
         throw std::runtime_error("owlapi::model::OWLOntologyTell::relatedTo: "
                 "'" + relation.toString() + "' is not a known relation/property");
@@ -660,6 +773,7 @@ OWLAxiom::Ptr OWLOntologyTell::relatedTo(const IRI& subject, const IRI& relation
 
 OWLSubPropertyAxiom::Ptr OWLOntologyTell::subPropertyOf(const IRI& subProperty, const IRI& parentProperty)
 {
+    OWLAPI_TELL_JOURNAL(subPropertyOf(subProperty, parentProperty));
 
     OWLSubPropertyAxiom::Ptr axiom;
     if(mAsk.isObjectProperty(parentProperty))
@@ -669,9 +783,9 @@ OWLSubPropertyAxiom::Ptr OWLOntologyTell::subPropertyOf(const IRI& subProperty,
         OWLObjectProperty::Ptr subOProperty = mpOntology->getObjectProperty(subProperty);
         OWLObjectProperty::Ptr superOProperty = mpOntology->getObjectProperty(parentProperty);
 
-        axiom = make_shared<OWLSubObjectPropertyOfAxiom>(subOProperty, superOProperty);
+        axiom = mpOntology->create<OWLSubObjectPropertyOfAxiom>(subOProperty, superOProperty);
 
-        mpOntology->kb()->subPropertyOf(subProperty, parentProperty);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.subPropertyOf(subProperty, parentProperty); });
     } else if(mAsk.isDataProperty(parentProperty))
     {
         dataProperty(subProperty);
@@ -679,9 +793,9 @@ OWLSubPropertyAxiom::Ptr OWLOntologyTell::subPropertyOf(const IRI& subProperty,
         OWLDataProperty::Ptr subDProperty = mpOntology->getDataProperty(subProperty);
         OWLDataProperty::Ptr superDProperty = mpOntology->getDataProperty(parentProperty);
 
-        axiom = make_shared<OWLSubDataPropertyOfAxiom>(subDProperty, superDProperty);
+        axiom = mpOntology->create<OWLSubDataPropertyOfAxiom>(subDProperty, superDProperty);
 
-        mpOntology->kb()->subPropertyOf(subProperty, parentProperty);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.subPropertyOf(subProperty, parentProperty); });
 
     } else if(mAsk.isAnnotationProperty(parentProperty))
     {
@@ -701,7 +815,7 @@ OWLSubPropertyAxiom::Ptr OWLOntologyTell::subPropertyOf(const IRI& subProperty,
             superAProperty = annotationProperty(parentProperty);
         }
 
-        axiom = make_shared<OWLSubAnnotationPropertyOfAxiom>(subAProperty, superAProperty);
+        axiom = mpOntology->create<OWLSubAnnotationPropertyOfAxiom>(subAProperty, superAProperty);
     } else {
         throw std::runtime_error("OWLOntologyTell::subPropertyOf: could not identify property type for " +
                 parentProperty.toString());
@@ -713,30 +827,33 @@ OWLSubPropertyAxiom::Ptr OWLOntologyTell::subPropertyOf(const IRI& subProperty,
 
 OWLAxiom::Ptr OWLOntologyTell::dataPropertyDomainOf(const IRI& property, const IRI& classType)
 {
-    mpOntology->kb()->domainOf(property, classType, KnowledgeBase::DATA);
+    OWLAPI_TELL_JOURNAL(dataPropertyDomainOf(property, classType));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.domainOf(property, classType, KnowledgeBase::DATA); });
 
     OWLDataProperty::Ptr dataProperty = mpOntology->getDataProperty(property);
     OWLClassExpression::Ptr domain = mpOntology->getClass(classType);
 
     OWLDataPropertyExpression::Ptr e_dataProperty = ptr_cast<OWLDataPropertyExpression, OWLDataProperty>(dataProperty);
-    OWLDataPropertyDomainAxiom::Ptr axiom = make_shared<OWLDataPropertyDomainAxiom>(e_dataProperty, domain);
+    OWLDataPropertyDomainAxiom::Ptr axiom = mpOntology->create<OWLDataPropertyDomainAxiom>(e_dataProperty, domain);
     return addAxiom(axiom);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::dataPropertyDomainOf(const IRI& property, const OWLClassExpression::Ptr& domain)
 {
+    OWLAPI_TELL_JOURNAL(dataPropertyDomainOf(property, tell.localize(domain)));
     // TODO: implement ClassExpression support
     //mpOntology->kb()->domainOf(property, classType, KnowledgeBase::DATA);
 
     OWLDataProperty::Ptr dataProperty = mpOntology->getDataProperty(property);
 
     OWLDataPropertyExpression::Ptr e_dataProperty = ptr_cast<OWLDataPropertyExpression, OWLDataProperty>(dataProperty);
-    OWLDataPropertyDomainAxiom::Ptr axiom = make_shared<OWLDataPropertyDomainAxiom>(e_dataProperty, domain);
+    OWLDataPropertyDomainAxiom::Ptr axiom = mpOntology->create<OWLDataPropertyDomainAxiom>(e_dataProperty, domain);
     return addAxiom(axiom);
 }
 
 OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id, const OWLDataRestriction::Ptr& r)
 {
+    OWLAPI_TELL_JOURNAL(dataPropertyRestriction(id, r));
     std::map<IRI, OWLAnonymousClassExpression::Ptr>::const_iterator cit =
         mpOntology->mAnonymousClassExpressions.find(id);
 
@@ -778,7 +895,7 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
                 throw std::invalid_argument("owlapi::model::OWLOntologyTell::dataPropertyRestriction:"
                         "failed to extract data type restriction filler for some values from");
             }
-            mpOntology->kb()->dataSomeValuesFrom(id, dataPropertyIRI, filler);
+            tellKnowledgeBase([&](KnowledgeBase& kb) { kb.dataSomeValuesFrom(id, dataPropertyIRI, filler); });
             break;
         }
         case OWLClassExpression::DATA_ALL_VALUES_FROM:
@@ -791,7 +908,7 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
                 throw std::invalid_argument("owlapi::model::OWLOntologyTell::dataPropertyRestriction:"
                         "failed to extract data type restriction filler for all values from");
             }
-            mpOntology->kb()->dataAllValuesFrom(id, dataPropertyIRI, filler);
+            tellKnowledgeBase([&](KnowledgeBase& kb) { kb.dataAllValuesFrom(id, dataPropertyIRI, filler); });
             break;
         }
         case OWLClassExpression::DATA_HAS_VALUE:
@@ -799,7 +916,7 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
             OWLDataHasValue::Ptr hasValue = dynamic_pointer_cast<OWLDataHasValue>(r);
 
             OWLLiteral::Ptr filler = hasValue->getFiller();
-            mpOntology->kb()->dataHasValue(id, dataPropertyIRI, filler);
+            tellKnowledgeBase([&](KnowledgeBase& kb) { kb.dataHasValue(id, dataPropertyIRI, filler); });
             break;
         }
         case OWLClassExpression::DATA_MIN_CARDINALITY:
@@ -807,10 +924,10 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
             OWLDataMinCardinality::Ptr minCardinality = dynamic_pointer_cast<OWLDataMinCardinality>(r);
 
             OWLDataRange::Ptr filler = minCardinality->getFiller();
-            mpOntology->kb()->dataMinCardinality(id,
-                    minCardinality->getCardinality(),
-                    dataPropertyIRI,
-                    filler);
+            tellKnowledgeBase([&](KnowledgeBase& kb)
+                {
+                    kb.dataMinCardinality(id, minCardinality->getCardinality(), dataPropertyIRI, filler);
+                });
             break;
         }
         case OWLClassExpression::DATA_MAX_CARDINALITY:
@@ -818,10 +935,10 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
             OWLDataMaxCardinality::Ptr maxCardinality = dynamic_pointer_cast<OWLDataMaxCardinality>(r);
 
             OWLDataRange::Ptr filler = maxCardinality->getFiller();
-            mpOntology->kb()->dataMaxCardinality(id,
-                    maxCardinality->getCardinality(),
-                    dataPropertyIRI,
-                    filler);
+            tellKnowledgeBase([&](KnowledgeBase& kb)
+                {
+                    kb.dataMaxCardinality(id, maxCardinality->getCardinality(), dataPropertyIRI, filler);
+                });
             break;
         }
         case OWLClassExpression::DATA_EXACT_CARDINALITY:
@@ -829,10 +946,10 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
             OWLDataExactCardinality::Ptr exactCardinality = dynamic_pointer_cast<OWLDataExactCardinality>(r);
 
             OWLDataRange::Ptr filler = exactCardinality->getFiller();
-            mpOntology->kb()->dataExactCardinality(id,
-                    exactCardinality->getCardinality(),
-                    dataPropertyIRI,
-                    filler);
+            tellKnowledgeBase([&](KnowledgeBase& kb)
+                {
+                    kb.dataExactCardinality(id, exactCardinality->getCardinality(), dataPropertyIRI, filler);
+                });
             break;
         }
         default:
@@ -845,10 +962,13 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
 
 OWLAxiom::Ptr OWLOntologyTell::dataPropertyRangeOf(const IRI& property, const IRI& classType)
 {
+    OWLAPI_TELL_JOURNAL(dataPropertyRangeOf(property, classType));
     // cannot use the following since that is not implemented in the reasoner
     // mpOntology->kb()->rangeOf(relation, classType, KnowledgeBase::OBJECT);
 
     OWLDataProperty::Ptr dataProperty = mpOntology->getDataProperty(property);
+    // ranges are added to the property even if no axiom is added
+    mpOntology->clearDataRangeValidators();
 
     std::map<IRI, OWLDataRange::PtrList>::const_iterator cit = mpOntology->mAnonymousDataRanges.find(classType);
     if(cit != mpOntology->mAnonymousDataRanges.end())
@@ -860,19 +980,22 @@ OWLAxiom::Ptr OWLOntologyTell::dataPropertyRangeOf(const IRI& property, const IR
             if(range->getDataRangeType() == OWLDataRange::DATA_ONE_OF)
             {
                 OWLDataOneOf::Ptr oneOf = dynamic_pointer_cast<OWLDataOneOf>(range);
-                reasoner::factpp::DataRange range = mpOntology->kb()->dataOneOf(oneOf->getLiterals());
-                mpOntology->kb()->dataRangeOf(property, range);
-                return addAxiom( make_shared<OWLDataPropertyRangeAxiom>(
+                tellKnowledgeBase([&](KnowledgeBase& kb)
+                    {
+                        reasoner::factpp::DataRange range = kb.dataOneOf(oneOf->getLiterals());
+                        kb.dataRangeOf(property, range);
+                    });
+                return addAxiom( mpOntology->create<OWLDataPropertyRangeAxiom>(
                             dataProperty,
                             oneOf) );
             }
         }
         return OWLAxiom::Ptr();
     } else{
-        OWLDataRange::Ptr range = make_shared<OWLDataType>(classType);
+        OWLDataRange::Ptr range = mpOntology->create<OWLDataType>(classType);
         dataProperty->addRange(range);
         OWLDataPropertyExpression::Ptr e_dataProperty = dynamic_pointer_cast<OWLDataPropertyExpression>(dataProperty);
-        OWLDataPropertyRangeAxiom::Ptr axiom = make_shared<OWLDataPropertyRangeAxiom>(e_dataProperty, range);
+        OWLDataPropertyRangeAxiom::Ptr axiom = mpOntology->create<OWLDataPropertyRangeAxiom>(e_dataProperty, range);
         return addAxiom(axiom);
     }
 }
@@ -882,14 +1005,15 @@ OWLClassExpression::Ptr OWLOntologyTell::objectOneOf(
         const owlapi::model::IRIList& instances
 )
 {
+    OWLAPI_TELL_JOURNAL(objectOneOf(id, instances));
     OWLNamedIndividual::PtrList individuals;
     for(const IRI& instance : instances)
     {
         individuals.push_back( namedIndividual(instance) );
     }
 
-    OWLObjectOneOf::Ptr ce = make_shared<OWLObjectOneOf>(individuals);
-    mpOntology->kb()->objectOneOf(id, instances);
+    OWLObjectOneOf::Ptr ce = mpOntology->create<OWLObjectOneOf>(individuals);
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectOneOf(id, instances); });
     mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(ce);
     return dynamic_pointer_cast<OWLClassExpression>(ce);
 }
@@ -899,15 +1023,16 @@ OWLClassExpression::Ptr OWLOntologyTell::objectIntersectionOf(
         const owlapi::model::IRIList& klasses
 )
 {
+    OWLAPI_TELL_JOURNAL(objectIntersectionOf(id, klasses));
     OWLClassExpression::PtrList classExpressions;
     for(const IRI& iri : klasses)
     {
         classExpressions.push_back(mAsk.getOWLClassExpression(iri));
     }
     OWLObjectIntersectionOf::Ptr intersection =
-        make_shared<OWLObjectIntersectionOf>(classExpressions);
+        mpOntology->create<OWLObjectIntersectionOf>(classExpressions);
 
-    mpOntology->kb()->objectIntersectionOf(id, klasses);
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectIntersectionOf(id, klasses); });
 
     mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(intersection);
     return dynamic_pointer_cast<OWLClassExpression>(intersection);
@@ -918,15 +1043,16 @@ OWLClassExpression::Ptr OWLOntologyTell::objectUnionOf(
         const owlapi::model::IRIList& klasses
 )
 {
+    OWLAPI_TELL_JOURNAL(objectUnionOf(id, klasses));
     OWLClassExpression::PtrList classExpressions;
     for(const IRI& iri : klasses)
     {
         classExpressions.push_back(mAsk.getOWLClassExpression(iri));
     }
     OWLObjectUnionOf::Ptr unionOf =
-        make_shared<OWLObjectUnionOf>(classExpressions);
+        mpOntology->create<OWLObjectUnionOf>(classExpressions);
 
-    mpOntology->kb()->objectUnionOf(id, klasses);
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectUnionOf(id, klasses); });
 
     mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(unionOf);
     return dynamic_pointer_cast<OWLClassExpression>(unionOf);
@@ -937,14 +1063,15 @@ OWLClassExpression::Ptr OWLOntologyTell::objectComplementOf(
         const owlapi::model::IRI& klass
 )
 {
+    OWLAPI_TELL_JOURNAL(objectComplementOf(id, klass));
     OWLClassExpression::Ptr ce = mAsk.getOWLClassExpression(klass);
     OWLObjectComplementOf::Ptr complementOf =
-        make_shared<OWLObjectComplementOf>(ce);
+        mpOntology->create<OWLObjectComplementOf>(ce);
 
-    mpOntology->kb()->objectComplementOf(id, klass);
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectComplementOf(id, klass); });
 
-    mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(ce);
-    return dynamic_pointer_cast<OWLClassExpression>(ce);
+    mpOntology->mAnonymousClassExpressions[id] = complementOf;
+    return complementOf;
 }
 
 OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
@@ -952,6 +1079,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
         const OWLObjectRestriction::Ptr& r
 )
 {
+    OWLAPI_TELL_JOURNAL(objectPropertyRestriction(id, r));
     std::map<IRI, OWLAnonymousClassExpression::Ptr>::const_iterator cit =
         mpOntology->mAnonymousClassExpressions.find(id);
 
@@ -987,7 +1115,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
             OWLObjectSomeValuesFrom::Ptr someValuesFrom = dynamic_pointer_cast<OWLObjectSomeValuesFrom>(r);
             OWLClassExpression::Ptr filler = someValuesFrom->getFiller();
             IRI fillerIRI = mAsk.getOWLClassExpressionIRI(filler);
-            mpOntology->kb()->objectSomeValuesFrom(id, objectPropertyIRI, fillerIRI);
+            tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectSomeValuesFrom(id, objectPropertyIRI, fillerIRI); });
             break;
         }
         case OWLClassExpression::OBJECT_ALL_VALUES_FROM:
@@ -995,7 +1123,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
             OWLObjectAllValuesFrom::Ptr allValuesFrom = dynamic_pointer_cast<OWLObjectAllValuesFrom>(r);
             OWLClassExpression::Ptr filler = allValuesFrom->getFiller();
             IRI fillerIRI = mAsk.getOWLClassExpressionIRI(filler);
-            mpOntology->kb()->objectAllValuesFrom(id, objectPropertyIRI, fillerIRI);
+            tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectAllValuesFrom(id, objectPropertyIRI, fillerIRI); });
             break;
         }
         case OWLClassExpression::OBJECT_HAS_VALUE:
@@ -1003,7 +1131,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
             OWLObjectHasValue::Ptr hasValue = dynamic_pointer_cast<OWLObjectHasValue>(r);
             OWLIndividual::Ptr filler = hasValue->getFiller();
             const IRI& fillerIRI = filler->getReferenceID();
-            mpOntology->kb()->objectHasValue(id, objectPropertyIRI, fillerIRI);
+            tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectHasValue(id, objectPropertyIRI, fillerIRI); });
             break;
         }
         case OWLClassExpression::OBJECT_MIN_CARDINALITY:
@@ -1020,12 +1148,10 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
                 // no qualification
             }
 
-            mpOntology->kb()->objectMinCardinality(
-                    id,
-                    minCardinality->getCardinality(),
-                    objectPropertyIRI,
-                    fillerIRI
-            );
+            tellKnowledgeBase([&](KnowledgeBase& kb)
+                {
+                    kb.objectMinCardinality(id, minCardinality->getCardinality(), objectPropertyIRI, fillerIRI);
+                });
             break;
         }
         case OWLClassExpression::OBJECT_MAX_CARDINALITY:
@@ -1042,12 +1168,10 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
                 // no qualification
             }
 
-            mpOntology->kb()->objectMaxCardinality(
-                    id,
-                    maxCardinality->getCardinality(),
-                    objectPropertyIRI,
-                    fillerIRI
-            );
+            tellKnowledgeBase([&](KnowledgeBase& kb)
+                {
+                    kb.objectMaxCardinality(id, maxCardinality->getCardinality(), objectPropertyIRI, fillerIRI);
+                });
             break;
         }
         case OWLClassExpression::OBJECT_EXACT_CARDINALITY:
@@ -1064,12 +1188,10 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
                 // no qualification
             }
 
-            mpOntology->kb()->objectExactCardinality(
-                    id,
-                    exactCardinality->getCardinality(),
-                    objectPropertyIRI,
-                    fillerIRI
-            );
+            tellKnowledgeBase([&](KnowledgeBase& kb)
+                {
+                    kb.objectExactCardinality(id, exactCardinality->getCardinality(), objectPropertyIRI, fillerIRI);
+                });
             break;
         }
             break;
@@ -1083,29 +1205,31 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
 
 OWLAxiom::Ptr OWLOntologyTell::objectPropertyDomainOf(const IRI& relation, const IRI& classType)
 {
-    mpOntology->kb()->domainOf(relation, classType, KnowledgeBase::OBJECT);
+    OWLAPI_TELL_JOURNAL(objectPropertyDomainOf(relation, classType));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.domainOf(relation, classType, KnowledgeBase::OBJECT); });
 
     OWLObjectProperty::Ptr oProperty = mpOntology->getObjectProperty(relation);
     OWLClassExpression::Ptr klass = mpOntology->getClass(classType);
 
-    OWLObjectPropertyDomainAxiom::Ptr axiom = make_shared<OWLObjectPropertyDomainAxiom>(oProperty, klass);
+    OWLObjectPropertyDomainAxiom::Ptr axiom = mpOntology->create<OWLObjectPropertyDomainAxiom>(oProperty, klass);
     return addAxiom(axiom);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::objectPropertyRangeOf(const IRI& relation, const IRI& classType)
 {
+    OWLAPI_TELL_JOURNAL(objectPropertyRangeOf(relation, classType));
     if(mAsk.isDatatype(classType))
     {
         throw std::invalid_argument("owlapi::model::OWLOntologyTell::objectPropertyRangeOf: "
                 "cannot use datarange '" + classType.toString() + "' for object property "
                 + relation.toString());
     }
-    mpOntology->kb()->objectRangeOf(relation, classType);
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.objectRangeOf(relation, classType); });
 
     OWLObjectProperty::Ptr oProperty = mpOntology->getObjectProperty(relation);
     OWLClassExpression::Ptr klass = mpOntology->getClass(classType);
 
-    OWLObjectPropertyRangeAxiom::Ptr axiom = make_shared<OWLObjectPropertyRangeAxiom>(oProperty, klass);
+    OWLObjectPropertyRangeAxiom::Ptr axiom = mpOntology->create<OWLObjectPropertyRangeAxiom>(oProperty, klass);
     return addAxiom(axiom);
 }
 
@@ -1137,26 +1261,28 @@ OWLAxiom::Ptr OWLOntologyTell::objectPropertyRangeOf(const IRI& relation, const
 OWLAxiom::Ptr OWLOntologyTell::annotationPropertyRangeOf(const IRI& property,
         const IRI& rangeIRI)
 {
+    OWLAPI_TELL_JOURNAL(annotationPropertyRangeOf(property, rangeIRI));
     // cannot use the following since that is not implemented in the reasoner
     // mpOntology->kb()->rangeOf(relation, classType, KnowledgeBase::OBJECT);
 
     OWLAnnotationProperty::Ptr annotationProperty = mpOntology->getAnnotationProperty(property);
     //annotationProperty->addRange(rangeIRI)
     OWLAnnotationPropertyRangeAxiom::Ptr axiom =
-            make_shared<OWLAnnotationPropertyRangeAxiom>(annotationProperty, rangeIRI);
+            mpOntology->create<OWLAnnotationPropertyRangeAxiom>(annotationProperty, rangeIRI);
     return addAxiom(axiom);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::inverseOf(const IRI& relation, const IRI& inverseRelation)
 {
+    OWLAPI_TELL_JOURNAL(inverseOf(relation, inverseRelation));
     if( mAsk.isObjectProperty(relation) || mAsk.isObjectProperty(inverseRelation) )
     {
-        mpOntology->kb()->inverseOf(relation, inverseRelation);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.inverseOf(relation, inverseRelation); });
 
         OWLObjectProperty::Ptr first = mpOntology->getObjectProperty(relation);
         OWLObjectProperty::Ptr second = mpOntology->getObjectProperty(inverseRelation);
 
-        OWLInverseObjectPropertiesAxiom::Ptr axiom = make_shared<OWLInverseObjectPropertiesAxiom>(first, second);
+        OWLInverseObjectPropertiesAxiom::Ptr axiom = mpOntology->create<OWLInverseObjectPropertiesAxiom>(first, second);
         return addAxiom(axiom);
     } else {
         throw std::invalid_argument("owlapi::model::OWLOntologyTell::inverseOf: '" + relation.toString() + "'"
@@ -1166,7 +1292,11 @@ OWLAxiom::Ptr OWLOntologyTell::inverseOf(const IRI& relation, const IRI& inverse
 
 OWLAxiom::Ptr OWLOntologyTell::valueOf(const IRI& instance, const IRI& dataProperty, OWLLiteral::Ptr literal)
 {
-    mpOntology->kb()->valueOf(instance, dataProperty, literal);
+    OWLAPI_TELL_JOURNAL(valueOf(instance, dataProperty, literal));
+    reasoner::factpp::Axiom kb_axiom = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.valueOf(instance, dataProperty, literal);
+        });
 
     OWLIndividual::Ptr individual;
     if(mAsk.isOWLIndividual(instance) || mAsk.isOWLAnonymousIndividual(instance))
@@ -1176,10 +1306,198 @@ OWLAxiom::Ptr OWLOntologyTell::valueOf(const IRI& instance, const IRI& dataPrope
         individual = anonymousIndividual(instance);
     }
     OWLDataProperty::Ptr property = mAsk.getOWLDataProperty(dataProperty);
-    OWLDataPropertyAssertionAxiom::Ptr axiom = make_shared<OWLDataPropertyAssertionAxiom>(individual, property, literal);
+    OWLDataPropertyAssertionAxiom::Ptr axiom = mpOntology->create<OWLDataPropertyAssertionAxiom>(individual, property, literal);
 
-    mpOntology->retractValueOf(individual, property);
-    return addAxiom(axiom);
+    // the knowledge base replaces values of functional properties by itself
+    OWLAxiom::Ptr previous = mpOntology->retractValueOf(individual, property);
+    if(previous)
+    {
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.removeReference(previous); });
+    }
+    return addAxiom(axiom, kb_axiom);
+}
+
+OWLAxiom::PtrList OWLOntologyTell::assertBatch(const ABoxBatch::Ptr& batch)
+{
+    OWLAPI_TELL_JOURNAL(assertBatch(batch));
+    if(!batch)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntologyTell::assertBatch: batch is not set");
+    }
+
+    typedef ABoxBatch::Id Id;
+    const IRIList& iris = batch->getIRIs();
+    const ABoxBatch::IdList& typeIndividuals = batch->getTypeIndividuals();
+    const ABoxBatch::IdList& typeClasses = batch->getTypeClasses();
+    const ABoxBatch::IdList& relationSubjects = batch->getRelationSubjects();
+    const ABoxBatch::IdList& relationProperties = batch->getRelationProperties();
+    const ABoxBatch::IdList& relationObjects = batch->getRelationObjects();
+    const ABoxBatch::IdList& valueSubjects = batch->getValueSubjects();
+    const ABoxBatch::IdList& valueProperties = batch->getValueProperties();
+    const OWLLiteral::PtrList& values = batch->getValues();
+
+    // Resolve classes and properties once and before changing the ontology
+    std::vector<OWLClass::Ptr> classes(iris.size());
+    for(Id id : typeClasses)
+    {
+        if(!classes[id])
+        {
+            classes[id] = findEntity(mpOntology->mClasses, iris[id], "class");
+        }
+    }
+    std::vector<OWLObjectProperty::Ptr> objectProperties(iris.size());
+    for(Id id : relationProperties)
+    {
+        if(!objectProperties[id])
+        {
+            objectProperties[id] = findEntity(mpOntology->mObjectProperties, iris[id], "object property");
+        }
+    }
+    std::vector<OWLDataProperty::Ptr> dataProperties(iris.size());
+    for(Id id : valueProperties)
+    {
+        if(!dataProperties[id])
+        {
+            dataProperties[id] = findEntity(mpOntology->mDataProperties, iris[id], "data property");
+        }
+    }
+
+    // Resolve individuals once, declaring unknown ones
+    std::vector<OWLNamedIndividual::Ptr> namedIndividuals(iris.size());
+    std::vector<OWLIndividual::Ptr> individuals(iris.size());
+    std::vector<bool> declared(iris.size(), false);
+    std::function<const OWLNamedIndividual::Ptr&(Id)> namedIndividualById = [&](Id id) -> const OWLNamedIndividual::Ptr&
+    {
+        if(!namedIndividuals[id])
+        {
+            declared[id] = !mpOntology->mNamedIndividuals.count(iris[id]) && !mpOntology->mAnonymousIndividuals.count(iris[id]);
+            namedIndividuals[id] = namedIndividual(iris[id]);
+        }
+        return namedIndividuals[id];
+    };
+    std::function<const OWLIndividual::Ptr&(Id)> individualById = [&](Id id) -> const OWLIndividual::Ptr&
+    {
+        if(!individuals[id])
+        {
+            std::map<IRI, OWLAnonymousIndividual::Ptr>::const_iterator cit = mpOntology->mAnonymousIndividuals.find(iris[id]);
+            if(cit != mpOntology->mAnonymousIndividuals.end() && !mpOntology->mNamedIndividuals.count(iris[id]))
+            {
+                individuals[id] = cit->second;
+            } else {
+                individuals[id] = namedIndividualById(id);
+            }
+        }
+        return individuals[id];
+    };
+
+    for(Id id : typeIndividuals)
+    {
+        namedIndividualById(id);
+    }
+    for(size_t i = 0; i < relationSubjects.size(); ++i)
+    {
+        individualById(relationSubjects[i]);
+        individualById(relationObjects[i]);
+    }
+    for(Id id : valueSubjects)
+    {
+        individualById(id);
+    }
+
+    // a structural ontology has no knowledge base axioms to reference
+    reasoner::factpp::Axiom::List kbAxioms = tellKnowledgeBase([&](KnowledgeBase& kb)
+        {
+            return kb.assertBatch(*batch);
+        });
+    kbAxioms.resize(batch->size());
+    reasoner::factpp::Axiom::List::const_iterator kbAxiom = kbAxioms.begin();
+
+    OWLAxiom::PtrList axioms;
+    axioms.reserve(batch->size());
+
+    std::vector<OWLClassAssertionAxiom::Ptr> classAssertions;
+    classAssertions.reserve(typeIndividuals.size());
+    for(size_t i = 0; i < typeIndividuals.size(); ++i, ++kbAxiom)
+    {
+        const OWLNamedIndividual::Ptr& individual = namedIndividuals[typeIndividuals[i]];
+        OWLClassAssertionAxiom::Ptr axiom = mpOntology->create<OWLClassAssertionAxiom>(individual, classes[typeClasses[i]]);
+        mpOntology->mClassAssertionAxiomsByIndividual[individual].push_back(axiom);
+        mpOntology->mNamedIndividualAxioms[individual].push_back(axiom);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.addReference(axiom, *kbAxiom); });
+        classAssertions.push_back(axiom);
+        axioms.push_back(axiom);
+    }
+
+    // Register the class assertions by class in class order, so that the
+    // index entry of each class is looked up once
+    std::vector<size_t> order(typeClasses.size());
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&typeClasses](size_t a, size_t b)
+            {
+                return typeClasses[a] < typeClasses[b];
+            });
+    std::vector<OWLClassAssertionAxiom::Ptr>* classAxioms = NULL;
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        if(i == 0 || typeClasses[order[i]] != typeClasses[order[i-1]])
+        {
+            classAxioms = &mpOntology->mClassAssertionAxiomsByClass[ classes[typeClasses[order[i]]] ];
+        }
+        classAxioms->push_back(classAssertions[order[i]]);
+    }
+
+    for(size_t i = 0; i < relationSubjects.size(); ++i, ++kbAxiom)
+    {
+        OWLObjectPropertyAssertionAxiom::Ptr axiom = mpOntology->create<OWLObjectPropertyAssertionAxiom>(
+                individuals[relationSubjects[i]],
+                objectProperties[relationProperties[i]],
+                individuals[relationObjects[i]]);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.addReference(axiom, *kbAxiom); });
+        axioms.push_back(axiom);
+    }
+
+    // As for valueOf, an individual keeps only the last value of a data
+    // property
+    std::unordered_map<uint64_t, size_t> lastValues;
+    for(size_t i = 0; i < valueSubjects.size(); ++i)
+    {
+        lastValues[ (static_cast<uint64_t>(valueSubjects[i]) << 32) | valueProperties[i] ] = i;
+    }
+    for(size_t i = 0; i < valueSubjects.size(); ++i, ++kbAxiom)
+    {
+        if(lastValues[ (static_cast<uint64_t>(valueSubjects[i]) << 32) | valueProperties[i] ] != i)
+        {
+            continue;
+        }
+
+        const OWLIndividual::Ptr& individual = individuals[valueSubjects[i]];
+        const OWLDataProperty::Ptr& property = dataProperties[valueProperties[i]];
+        if(!declared[valueSubjects[i]])
+        {
+            OWLAxiom::Ptr previous = mpOntology->retractValueOf(individual, property);
+            if(previous)
+            {
+                tellKnowledgeBase([&](KnowledgeBase& kb) { kb.removeReference(previous); });
+            }
+        }
+
+        OWLDataPropertyAssertionAxiom::Ptr axiom = mpOntology->create<OWLDataPropertyAssertionAxiom>(individual, property, values[i]);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.addReference(axiom, *kbAxiom); });
+        axioms.push_back(axiom);
+    }
+
+    for(const OWLAxiom::Ptr& axiom : axioms)
+    {
+        axiom->setOrigin(mOrigin);
+        mpOntology->mJournal.recordAxiom(axiom);
+    }
+    mpOntology->addAxioms(axioms);
+
+    LOG_DEBUG_S << "owlapi::model::OWLOntologyTell::assertBatch: added " << axioms.size() << " axioms";
+    return axioms;
 }
 
 
@@ -1187,7 +1505,8 @@ OWLAxiom::Ptr OWLOntologyTell::annotationOf(const IRI& subject,
         const IRI& relation,
         const IRI& object)
 {
-        OWLAnnotationSubject::Ptr annotationSubject = make_shared<IRI>(subject);
+    OWLAPI_TELL_JOURNAL(annotationOf(subject, relation, object));
+        OWLAnnotationSubject::Ptr annotationSubject = mpOntology->create<IRI>(subject);
         // Setting of AnnotationAssertions
         std::string value = object.toString();
         if(value.empty())
@@ -1206,7 +1525,7 @@ OWLAxiom::Ptr OWLOntologyTell::annotationOf(const IRI& subject,
         if(IRI::isValid(value))
         {
             try {
-                shared_ptr<IRI> annotationObjectIRI = make_shared<IRI>(value);
+                shared_ptr<IRI> annotationObjectIRI = mpOntology->create<IRI>(value);
                 annotationObjectIRI->toURI();
                 return annotationOf(annotationSubject, relation, annotationObjectIRI);
             } catch(const std::invalid_argument& e)
@@ -1230,8 +1549,9 @@ OWLAxiom::Ptr OWLOntologyTell::annotationOf(const OWLAnnotationSubject::Ptr& sub
         const IRI& annotationProperty,
         const OWLAnnotationValue::Ptr& annotationValue)
 {
+    OWLAPI_TELL_JOURNAL(annotationOf(subject, annotationProperty, annotationValue));
     OWLAnnotationProperty::Ptr property = mAsk.getOWLAnnotationProperty(annotationProperty);
-    OWLAnnotationAssertionAxiom::Ptr axiom = make_shared<OWLAnnotationAssertionAxiom>(subject, property, annotationValue);
+    OWLAnnotationAssertionAxiom::Ptr axiom = mpOntology->create<OWLAnnotationAssertionAxiom>(subject, property, annotationValue);
     return addAxiom(axiom);
 }
 
@@ -1262,12 +1582,14 @@ OWLAxiom::Ptr OWLOntologyTell::annotationOf(const OWLAnnotationSubject::Ptr& sub
 
 void OWLOntologyTell::ontology(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(ontology(iri));
     // allowing punning
     instanceOf(iri, vocabulary::OWL::Ontology());
 }
 
 OWLDataType::Ptr OWLOntologyTell::datatype(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(datatype(iri));
     // http://www.w3.org/TR/owl-ref/#rdf-datatype
     //
     // but also
@@ -1294,27 +1616,33 @@ OWLDataType::Ptr OWLOntologyTell::datatype(const IRI& iri)
     {
         return cit->second;
     } else {
-        OWLDataType::Ptr dataType = make_shared<OWLDataType>(iri);
-        mpOntology->kb()->dataType(iri);
+        OWLDataType::Ptr dataType = mpOntology->create<OWLDataType>(iri);
+        tellKnowledgeBase([&](KnowledgeBase& kb) { kb.dataType(iri); });
         mpOntology->mDataTypes[iri] = dataType;
+        mpOntology->clearDataRangeValidators();
         return dataType;
     }
 }
 
 void OWLOntologyTell::dataOneOf(const IRI& id, const OWLDataOneOf::Ptr& dataOneOf)
 {
-    mpOntology->kb()->dataOneOf(dataOneOf);
+    OWLAPI_TELL_JOURNAL(dataOneOf(id, dataOneOf));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.dataOneOf(dataOneOf); });
     mpOntology->mAnonymousDataRanges[id].push_back(dataOneOf);
+    mpOntology->clearDataRangeValidators();
 }
 
 void OWLOntologyTell::dataTypeRestriction(const IRI& id, const OWLDataTypeRestriction::Ptr& restriction)
 {
-    reasoner::factpp::DataRange range = mpOntology->kb()->dataTypeRestriction(restriction);
+    OWLAPI_TELL_JOURNAL(dataTypeRestriction(id, restriction));
+    tellKnowledgeBase([&](KnowledgeBase& kb) { kb.dataTypeRestriction(restriction); });
     mpOntology->mAnonymousDataRanges[id].push_back(restriction);
+    mpOntology->clearDataRangeValidators();
 }
 
 void OWLOntologyTell::removeIndividual(const IRI& iri)
 {
+    OWLAPI_TELL_JOURNAL(removeIndividual(iri));
     mpOntology->retractIndividual(iri);
 }
 
@@ -2,6 +2,7 @@
 #define OWLAPI_MODEL_OWL_ONTOLOGY_TELL_HPP
 
 #include <stdexcept>
+#include <utility>
 #include "OWLOntology.hpp"
 #include "OWLLiteral.hpp"
 #include "OWLObjectCardinalityRestriction.hpp"
@@ -11,6 +12,7 @@
 #include "OWLDataTypeRestriction.hpp"
 #include "OWLDataRestriction.hpp"
 #include "OWLDataOneOf.hpp"
+#include "ABoxBatch.hpp"
 
 namespace owlapi {
 namespace reasoner {
@@ -38,6 +40,29 @@ class OWLOntologyTell
      */
     OWLAxiom::Ptr addAxiom(const OWLAxiom::Ptr& axiom, const owlapi::reasoner::factpp::Axiom& kbAxiom);
 
+    /**
+     * Map a class expression, which might originate from another ontology,
+     * to the corresponding class expression of this ontology
+     * \see OWLOntology::fork
+     */
+    OWLClassExpression::Ptr localize(const OWLClassExpression::Ptr& expression);
+
+    /**
+     * Apply an operation to the knowledge base, if the ontology has one
+     * \return result of the operation, or a default constructed result for
+     * a structural ontology
+     */
+    template<typename Operation>
+    auto tellKnowledgeBase(const Operation& operation) -> decltype(operation(std::declval<KnowledgeBase&>()))
+    {
+        typedef decltype(operation(std::declval<KnowledgeBase&>())) Result;
+        if(!mpOntology->hasKnowledgeBase())
+        {
+            return Result();
+        }
+        return operation(*mpOntology->kb());
+    }
+
 public:
     typedef shared_ptr<OWLOntologyTell> Ptr;
 
@@ -51,6 +76,11 @@ public:
      */
     OWLOntologyTell(OWLOntology::Ptr ontology, const IRI& origin = IRI());
 
+    /**
+     * Get the ontology which is populated by this object
+     */
+    const OWLOntology::Ptr& getOntology() const { return mpOntology; }
+
     /**
      * Get the origin of the data provided by this OWLOntologyTell object
      * \return IRI to describe the origin
@@ -234,6 +264,27 @@ public:
      */
     OWLAxiom::Ptr valueOf(const IRI& instance, const IRI& dataProperty, OWLLiteral::Ptr literal);
 
+    /**
+     * Add all assertions of a batch
+     * \details Equivalent to calling instanceOf, relatedTo and valueOf for
+     * each assertion, but entities are resolved once per batch, the axioms
+     * are indexed in bulk and the knowledge base is updated with a single
+     * call. Individuals which are not known are declared as named
+     * individuals, while classes have to be declared upfront just as
+     * properties.
+     * The batch is recorded in the journal and must not be modified
+     * afterwards.
+     * \param batch Batch of class assertions, relations and values
+     * As with valueOf, only the last value of an individual and data
+     * property in the batch is kept as axiom.
+     * \return the added axioms in the order of the batch's types, relations
+     * and values
+     * \throw std::invalid_argument if an entity is not a known class or
+     * property of the required kind, which is checked before the ontology is
+     * changed
+     */
+    OWLAxiom::PtrList assertBatch(const ABoxBatch::Ptr& batch);
+
     OWLAxiom::Ptr annotationOf(const IRI& subject,
             const IRI& annotationProperty,
             const IRI& object);
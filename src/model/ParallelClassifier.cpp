@@ -0,0 +1,302 @@
+#include "ParallelClassifier.hpp"
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <base-logging/Logging.hpp>
+#include "SyntacticLocalityModuleExtractor.hpp"
+#include "OWLAxiomSignatureVisitor.hpp"
+#include "../KnowledgeBase.hpp"
+#include "../vocabularies/OWL.hpp"
+
+namespace owlapi {
+namespace model {
+
+namespace {
+
+/**
+ * Union-find structure over entities
+ */
+class DisjointSets
+{
+public:
+    size_t add(const IRI& iri)
+    {
+        std::pair<std::unordered_map<IRI, size_t>::iterator, bool> result = mIds.insert(std::make_pair(iri, mParents.size()));
+        if(result.second)
+        {
+            mParents.push_back(mParents.size());
+            mIRIs.push_back(iri);
+        }
+        return result.first->second;
+    }
+
+    size_t find(size_t id)
+    {
+        while(mParents[id] != id)
+        {
+            // path halving
+            mParents[id] = mParents[mParents[id]];
+            id = mParents[id];
+        }
+        return id;
+    }
+
+    void unite(size_t a, size_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if(a != b)
+        {
+            mParents[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    size_t size() const { return mParents.size(); }
+
+    const IRI& getIRI(size_t id) const { return mIRIs[id]; }
+
+private:
+    std::unordered_map<IRI, size_t> mIds;
+    std::vector<size_t> mParents;
+    IRIList mIRIs;
+};
+
+bool isTopOrBottomClass(const IRI& iri)
+{
+    return iri == vocabulary::OWL::Thing() || iri == vocabulary::OWL::Nothing();
+}
+
+/**
+ * Check whether the axiom can affect the class hierarchy, i.e. whether it is
+ * a class or property axiom
+ */
+bool isTerminological(const OWLAxiom::Ptr& axiom)
+{
+    OWLAxiom::AxiomType type = axiom->getAxiomType();
+    return (type >= OWLAxiom::SubClassOf && type <= OWLAxiom::DataPropertyRange)
+        || type == OWLAxiom::SubPropertyChainOf
+        || type == OWLAxiom::HasKey;
+}
+
+} // end anonymous namespace
+
+ParallelClassifier::ParallelClassifier(const OWLOntology::Ptr& ontology, size_t numberOfThreads)
+    : mpOntology(ontology)
+    , mNumberOfThreads(numberOfThreads)
+{
+    if(!mpOntology)
+    {
+        throw std::invalid_argument("owlapi::model::ParallelClassifier: ontology is not set");
+    }
+
+    if(mNumberOfThreads == 0)
+    {
+        mNumberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+std::vector<ParallelClassifier::Component> ParallelClassifier::computeComponents() const
+{
+    DisjointSets sets;
+    IRIList klasses = mpOntology->kb()->allClasses();
+    for(const IRI& klass : klasses)
+    {
+        if(!isTopOrBottomClass(klass))
+        {
+            sets.add(klass);
+        }
+    }
+
+    // entity of each axiom, to count the axioms of a component
+    std::vector<size_t> axiomEntities;
+    for(const OWLAxiom::Ptr& axiom : mpOntology->getAxioms())
+    {
+        if(!isTerminological(axiom))
+        {
+            continue;
+        }
+
+        IRIList signature = OWLAxiomSignatureVisitor::getSignature(axiom);
+        bool empty = true;
+        size_t first = 0;
+        for(const IRI& iri : signature)
+        {
+            // top and bottom would connect all components
+            if(isTopOrBottomClass(iri))
+            {
+                continue;
+            }
+
+            size_t id = sets.add(iri);
+            if(empty)
+            {
+                first = id;
+                empty = false;
+            } else {
+                sets.unite(first, id);
+            }
+        }
+
+        if(!empty)
+        {
+            axiomEntities.push_back(first);
+        }
+    }
+
+    std::unordered_set<IRI> classes(klasses.begin(), klasses.end());
+    std::unordered_map<size_t, Component> components;
+    for(size_t id = 0; id < sets.size(); ++id)
+    {
+        Component& component = components[sets.find(id)];
+        const IRI& iri = sets.getIRI(id);
+        component.signature.push_back(iri);
+        if(classes.count(iri))
+        {
+            component.klasses.push_back(iri);
+        }
+    }
+
+    for(size_t id : axiomEntities)
+    {
+        ++components[sets.find(id)].numberOfAxioms;
+    }
+
+    std::vector<Component> result;
+    for(std::pair<const size_t, Component>& entry : components)
+    {
+        if(!entry.second.klasses.empty())
+        {
+            result.push_back(std::move(entry.second));
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Component& a, const Component& b)
+            {
+                return a.numberOfAxioms > b.numberOfAxioms;
+            });
+    return result;
+}
+
+std::vector<IRIList> ParallelClassifier::getComponents() const
+{
+    std::vector<IRIList> signatures;
+    for(const Component& component : computeComponents())
+    {
+        signatures.push_back(component.signature);
+    }
+    return signatures;
+}
+
+Taxonomy::Ptr ParallelClassifier::classify()
+{
+    std::vector<Component> components = computeComponents();
+
+    // Group the components into a few work items per thread, so that
+    // classifying many small components does not require a knowledge base
+    // each. Components are sorted by decreasing size, so greedily assigning
+    // them to the smallest work item balances the load
+    size_t numberOfWorkItems = std::min(components.size(), 4*mNumberOfThreads);
+    std::vector<Component> workItems(numberOfWorkItems);
+    for(const Component& component : components)
+    {
+        Component& workItem = *std::min_element(workItems.begin(), workItems.end(),
+                [](const Component& a, const Component& b)
+                {
+                    return a.numberOfAxioms < b.numberOfAxioms;
+                });
+        workItem.signature.insert(workItem.signature.end(), component.signature.begin(), component.signature.end());
+        workItem.klasses.insert(workItem.klasses.end(), component.klasses.begin(), component.klasses.end());
+        workItem.numberOfAxioms += component.numberOfAxioms + 1;
+    }
+
+    // Extraction only reads the ontology, so all modules are extracted
+    // concurrently upfront; each module uses a knowledge base of its own
+    SyntacticLocalityModuleExtractor extractor(mpOntology, SyntacticLocalityModuleExtractor::BOT);
+    extractor.setIgnoreAssertions(true);
+    std::vector<IRIList> signatures;
+    for(const Component& workItem : workItems)
+    {
+        signatures.push_back(workItem.signature);
+    }
+    OWLOntology::PtrList modules = extractor.extractAsOntologies(signatures, mNumberOfThreads);
+
+    std::vector<Taxonomy::Ptr> taxonomies(modules.size());
+    std::vector<std::exception_ptr> errors(modules.size());
+    std::atomic<size_t> next(0);
+    std::function<void()> worker = [&]()
+    {
+        for(size_t i = next++; i < modules.size(); i = next++)
+        {
+            try {
+                taxonomies[i] = modules[i]->kb()->getTaxonomy();
+            } catch(...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    size_t numberOfThreads = std::min(mNumberOfThreads, modules.size());
+    LOG_DEBUG_S << "owlapi::model::ParallelClassifier::classify: classifying " << components.size()
+        << " components in " << modules.size() << " modules using " << numberOfThreads << " threads";
+
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < numberOfThreads; ++i)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(const std::exception_ptr& error : errors)
+    {
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // The module of a component provides the direct superclasses of the
+    // classes of the component
+    std::vector< std::pair<IRI, IRI> > directSubClasses;
+    std::unordered_set<IRI> attached;
+    for(size_t i = 0; i < workItems.size(); ++i)
+    {
+        const Taxonomy::Ptr& taxonomy = taxonomies[i];
+        for(const IRI& klass : workItems[i].klasses)
+        {
+            if(!taxonomy->hasNode(klass))
+            {
+                continue;
+            }
+
+            for(Taxonomy::NodeId parent : taxonomy->getParents(taxonomy->getId(klass)))
+            {
+                directSubClasses.push_back( std::make_pair(taxonomy->getIRI(parent), klass) );
+                attached.insert(klass);
+            }
+        }
+    }
+
+    IRIList klasses = mpOntology->kb()->allClasses();
+    for(const IRI& klass : klasses)
+    {
+        if(!attached.count(klass) && !isTopOrBottomClass(klass))
+        {
+            directSubClasses.push_back( std::make_pair(vocabulary::OWL::Thing(), klass) );
+        }
+    }
+
+    Taxonomy::Ptr taxonomy = make_shared<Taxonomy>(klasses, directSubClasses);
+    mpOntology->kb()->setTaxonomy(taxonomy);
+    return taxonomy;
+}
+
+} // end namespace model
+} // end namespace owlapi
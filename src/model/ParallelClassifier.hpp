@@ -0,0 +1,82 @@
+#ifndef OWLAPI_MODEL_PARALLEL_CLASSIFIER_HPP
+#define OWLAPI_MODEL_PARALLEL_CLASSIFIER_HPP
+
+#include "OWLOntology.hpp"
+#include "Taxonomy.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class ParallelClassifier
+ * \brief Classifies the independent modules of an ontology concurrently
+ * \details The ontology is decomposed into connected components of its
+ * signature, i.e. two entities belong to the same component if they
+ * (transitively) share a class or property axiom. The components are
+ * grouped into balanced work items, and for each work item the bottom
+ * module of its signature is classified with a separate knowledge base on a
+ * thread pool.
+ *
+ * Since a bottom module preserves all subsumers of the classes in its
+ * signature, the direct superclasses of every class are taken from the
+ * module of its own component, and the partial taxonomies merge into the
+ * taxonomy of the whole ontology. The merged taxonomy is set as taxonomy of
+ * the ontology's knowledge base (\see KnowledgeBase::setTaxonomy), so that it
+ * answers the subclass and ancestor queries of OWLOntologyAsk.
+ *
+ * Assertions are not taken into account, i.e. the ontology is assumed to be
+ * consistent and to use no nominals.
+ *
+\verbatim
+    ParallelClassifier classifier(ontology);
+    classifier.classify();
+    OWLOntologyAsk(ontology).allSubClassesOf(klass);
+\endverbatim
+ */
+class ParallelClassifier
+{
+public:
+    /**
+     * \param ontology Ontology to classify
+     * \param numberOfThreads Maximum number of threads, 0 to use the number of
+     * hardware threads
+     * \throw std::invalid_argument if the ontology is not set
+     */
+    ParallelClassifier(const OWLOntology::Ptr& ontology, size_t numberOfThreads = 0);
+
+    size_t getNumberOfThreads() const { return mNumberOfThreads; }
+
+    /**
+     * Decompose the signature of the ontology into independent components
+     * \return components containing at least one class, sorted by
+     * decreasing number of axioms
+     */
+    std::vector<IRIList> getComponents() const;
+
+    /**
+     * Classify the modules of all components in parallel and set the merged
+     * taxonomy as taxonomy of the ontology's knowledge base
+     * \return merged taxonomy
+     * \throw the first exception of a failed module classification
+     */
+    Taxonomy::Ptr classify();
+
+private:
+    struct Component
+    {
+        IRIList signature;
+        IRIList klasses;
+        size_t numberOfAxioms;
+
+        Component() : numberOfAxioms(0) {}
+    };
+
+    std::vector<Component> computeComponents() const;
+
+    OWLOntology::Ptr mpOntology;
+    size_t mNumberOfThreads;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_PARALLEL_CLASSIFIER_HPP
@@ -1,4 +1,6 @@
 #include "QueryCache.hpp"
+#include "MemoryUsage.hpp"
+#include "../Instrumentation.hpp"
 
 namespace owlapi {
 namespace model {
@@ -16,9 +18,11 @@ std::pair<bool,bool> QueryCache::isSubClassOf(const IRI& iri, const IRI& otherIr
     std::unordered_map< std::pair<IRI, IRI>, bool>::const_iterator cit = mSubClassing.find( std::pair<IRI,IRI>(iri, otherIri) );
     if(cit != mSubClassing.end())
     {
+        OWLAPI_INSTRUMENT_COUNT(QUERY_CACHE_HIT);
         result.first = cit->second;
         result.second = true;
     } else {
+        OWLAPI_INSTRUMENT_COUNT(QUERY_CACHE_MISS);
         result.second = false;
     }
     return result;
@@ -32,9 +36,11 @@ std::pair<OWLCardinalityRestriction::PtrList, bool> QueryCache::getCardinalityRe
     mCardinalityRestrictions.find( std::pair<IRI,IRI>(iri, objectProperty) );
     if(cit != mCardinalityRestrictions.end())
     {
+        OWLAPI_INSTRUMENT_COUNT(QUERY_CACHE_HIT);
         result.first = cit->second;
         result.second = true;
     } else {
+        OWLAPI_INSTRUMENT_COUNT(QUERY_CACHE_MISS);
         result.second = false;
     }
     return result;
@@ -59,9 +65,11 @@ std::pair<OWLCardinalityRestriction::PtrList, bool> QueryCache::getCardinalityRe
 
     if(cit != mCardinalityRestrictionsOps.end())
     {
+        OWLAPI_INSTRUMENT_COUNT(QUERY_CACHE_HIT);
         result.first = cit->second;
         result.second = true;
     } else {
+        OWLAPI_INSTRUMENT_COUNT(QUERY_CACHE_MISS);
         result.second = false;
     }
     return result;
@@ -82,5 +90,16 @@ void QueryCache::cacheIsSubClassOf(const IRI& iri, const IRI& otherIri, bool isS
     mSubClassing.emplace( std::pair<IRI, IRI>(iri, otherIri), isSubclass);
 }
 
+size_t QueryCache::size() const
+{
+    return mCardinalityRestrictions.size() + mCardinalityRestrictionsOps.size() + mSubClassing.size();
+}
+
+uint64_t QueryCache::getMemoryUsage() const
+{
+    return memory::heapBytes(mCardinalityRestrictions) + memory::heapBytes(mCardinalityRestrictionsOps)
+        + memory::heapBytes(mSubClassing);
+}
+
 } // end namespace model
 } // end namespace owlapi
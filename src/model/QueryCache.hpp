@@ -74,6 +74,17 @@ public:
      */
     void cacheIsSubClassOf(const IRI& iri, const IRI& otherIri, bool isSubclass);
 
+    /**
+     * Get the number of cached results
+     */
+    size_t size() const;
+
+    /**
+     * Get the estimated heap memory of the cache
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
 private:
     std::unordered_map< std::pair<IRI, IRI>, OWLCardinalityRestriction::PtrList> mCardinalityRestrictions;
 
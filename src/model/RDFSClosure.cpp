@@ -0,0 +1,320 @@
+#include "RDFSClosure.hpp"
+#include "MemoryUsage.hpp"
+#include "OWLAnnotation.hpp"
+#include "OWLClass.hpp"
+#include "OWLProperty.hpp"
+#include "OWLSubClassOfAxiom.hpp"
+#include "OWLEquivalentClassesAxiom.hpp"
+#include "OWLSubObjectPropertyOfAxiom.hpp"
+#include "OWLSubDataPropertyOfAxiom.hpp"
+#include "OWLEquivalentObjectPropertiesAxiom.hpp"
+#include "OWLEquivalentDataPropertiesAxiom.hpp"
+#include "OWLObjectPropertyDomainAxiom.hpp"
+#include "OWLObjectPropertyRangeAxiom.hpp"
+#include "OWLDataPropertyDomainAxiom.hpp"
+
+namespace owlapi {
+namespace model {
+
+namespace {
+
+/**
+ * Get the IRI of a named class, or an empty IRI for an anonymous class
+ * expression
+ */
+IRI namedClass(const OWLClassExpression::Ptr& expression)
+{
+    OWLClass::Ptr klass = dynamic_pointer_cast<OWLClass>(expression);
+    return klass ? klass->getIRI() : IRI();
+}
+
+/**
+ * Get the IRI of a named property, or an empty IRI for a property expression
+ */
+IRI namedProperty(const OWLPropertyExpression::Ptr& expression)
+{
+    OWLProperty::Ptr property = dynamic_pointer_cast<OWLProperty>(expression);
+    return property ? property->getIRI() : IRI();
+}
+
+/**
+ * Add edges in both directions between all named members, so that they
+ * become mutual ancestors
+ */
+template<typename PtrList, typename Graph, typename NameFn>
+void addEquivalence(const PtrList& members, Graph& graph, NameFn name)
+{
+    IRIList named;
+    for(const typename PtrList::value_type& member : members)
+    {
+        IRI iri = name(member);
+        if(!iri.empty())
+        {
+            named.push_back(iri);
+        }
+    }
+
+    for(size_t i = 1; i < named.size(); ++i)
+    {
+        graph.addEdge(named[i-1], named[i]);
+        graph.addEdge(named[i], named[i-1]);
+    }
+}
+
+} // end anonymous namespace
+
+RDFSClosure::RDFSClosure()
+    : mValid(false)
+{}
+
+bool RDFSClosure::isRelevant(OWLAxiom::AxiomType type)
+{
+    switch(type)
+    {
+        case OWLAxiom::SubClassOf:
+        case OWLAxiom::EquivalentClasses:
+        case OWLAxiom::SubObjectPropertyOf:
+        case OWLAxiom::EquivalentObjectProperties:
+        case OWLAxiom::ObjectPropertyDomain:
+        case OWLAxiom::ObjectPropertyRange:
+        case OWLAxiom::SubDataPropertyOf:
+        case OWLAxiom::EquivalentDataProperties:
+        case OWLAxiom::DataPropertyDomain:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void RDFSClosure::Graph::clear()
+{
+    parents.clear();
+    children.clear();
+    ancestors.clear();
+    descendants.clear();
+}
+
+void RDFSClosure::Graph::addEdge(const IRI& child, const IRI& parent)
+{
+    if(child == parent)
+    {
+        return;
+    }
+    parents[child].insert(parent);
+    children[parent].insert(child);
+}
+
+void RDFSClosure::clear()
+{
+    // the closure is cleared whenever it becomes invalid, so that there is
+    // nothing to do for subsequent changes
+    if(!mValid)
+    {
+        return;
+    }
+
+    for(Graph& graph : mGraphs)
+    {
+        graph.clear();
+    }
+    mDomains.clear();
+    mRanges.clear();
+    mPropertiesByDomain.clear();
+    mPropertiesByRange.clear();
+    mValid = false;
+}
+
+void RDFSClosure::build(const std::map<OWLAxiom::AxiomType, OWLAxiom::PtrList>& axiomsByType)
+{
+    clear();
+
+    for(const std::pair<const OWLAxiom::AxiomType, OWLAxiom::PtrList>& typedAxioms : axiomsByType)
+    {
+        if(!isRelevant(typedAxioms.first))
+        {
+            continue;
+        }
+
+        for(const OWLAxiom::Ptr& axiom : typedAxioms.second)
+        {
+            switch(typedAxioms.first)
+            {
+                case OWLAxiom::SubClassOf:
+                {
+                    OWLSubClassOfAxiom::Ptr subClassAxiom = dynamic_pointer_cast<OWLSubClassOfAxiom>(axiom);
+                    IRI subclass = namedClass(subClassAxiom->getSubClass());
+                    IRI superclass = namedClass(subClassAxiom->getSuperClass());
+                    if(!subclass.empty() && !superclass.empty())
+                    {
+                        mGraphs[CLASS].addEdge(subclass, superclass);
+                    }
+                    break;
+                }
+                case OWLAxiom::EquivalentClasses:
+                    addEquivalence(dynamic_pointer_cast<OWLEquivalentClassesAxiom>(axiom)->getEquivalentClasses(),
+                            mGraphs[CLASS], namedClass);
+                    break;
+                case OWLAxiom::SubObjectPropertyOf:
+                case OWLAxiom::SubDataPropertyOf:
+                {
+                    OWLSubPropertyAxiom::Ptr subPropertyAxiom = dynamic_pointer_cast<OWLSubPropertyAxiom>(axiom);
+                    IRI subproperty = namedProperty(subPropertyAxiom->getSubProperty());
+                    IRI superproperty = namedProperty(subPropertyAxiom->getSuperProperty());
+                    if(!subproperty.empty() && !superproperty.empty())
+                    {
+                        Hierarchy hierarchy = typedAxioms.first == OWLAxiom::SubObjectPropertyOf ? OBJECT_PROPERTY : DATA_PROPERTY;
+                        mGraphs[hierarchy].addEdge(subproperty, superproperty);
+                    }
+                    break;
+                }
+                case OWLAxiom::EquivalentObjectProperties:
+                    addEquivalence(dynamic_pointer_cast<OWLEquivalentObjectPropertiesAxiom>(axiom)->getProperties(),
+                            mGraphs[OBJECT_PROPERTY], namedProperty);
+                    break;
+                case OWLAxiom::EquivalentDataProperties:
+                    addEquivalence(dynamic_pointer_cast<OWLEquivalentDataPropertiesAxiom>(axiom)->getProperties(),
+                            mGraphs[DATA_PROPERTY], namedProperty);
+                    break;
+                case OWLAxiom::ObjectPropertyDomain:
+                {
+                    OWLObjectPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLObjectPropertyDomainAxiom>(axiom);
+                    IRI property = namedProperty(domainAxiom->getProperty());
+                    IRI domain = namedClass(domainAxiom->getDomain());
+                    if(!property.empty() && !domain.empty())
+                    {
+                        mDomains[property].insert(domain);
+                        mPropertiesByDomain[domain].insert(property);
+                    }
+                    break;
+                }
+                case OWLAxiom::DataPropertyDomain:
+                {
+                    OWLDataPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLDataPropertyDomainAxiom>(axiom);
+                    IRI property = namedProperty(domainAxiom->getProperty());
+                    IRI domain = namedClass(domainAxiom->getDomain());
+                    if(!property.empty() && !domain.empty())
+                    {
+                        mDomains[property].insert(domain);
+                        mPropertiesByDomain[domain].insert(property);
+                    }
+                    break;
+                }
+                case OWLAxiom::ObjectPropertyRange:
+                {
+                    OWLObjectPropertyRangeAxiom::Ptr rangeAxiom = dynamic_pointer_cast<OWLObjectPropertyRangeAxiom>(axiom);
+                    IRI property = namedProperty(rangeAxiom->getProperty());
+                    IRI range = namedClass(rangeAxiom->getRange());
+                    if(!property.empty() && !range.empty())
+                    {
+                        mRanges[property].insert(range);
+                        mPropertiesByRange[range].insert(property);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+    mValid = true;
+}
+
+const IRISet& RDFSClosure::find(const Edges& edges, const IRI& iri)
+{
+    static const IRISet empty;
+    Edges::const_iterator cit = edges.find(iri);
+    if(cit == edges.end())
+    {
+        return empty;
+    }
+    return cit->second;
+}
+
+const IRISet& RDFSClosure::close(const Edges& edges, Edges& cache, const IRI& iri)
+{
+    Edges::const_iterator cit = cache.find(iri);
+    if(cit != cache.end())
+    {
+        return cit->second;
+    }
+
+    IRISet closure;
+    IRIList queue(1, iri);
+    while(!queue.empty())
+    {
+        IRI current = queue.back();
+        queue.pop_back();
+        for(const IRI& next : find(edges, current))
+        {
+            if(closure.insert(next).second)
+            {
+                queue.push_back(next);
+            }
+        }
+    }
+    // a cycle, i.e. an equivalence, leads back to the entity itself
+    closure.erase(iri);
+    return cache[iri] = closure;
+}
+
+const IRISet& RDFSClosure::getParents(Hierarchy hierarchy, const IRI& iri) const
+{
+    return find(getGraph(hierarchy).parents, iri);
+}
+
+const IRISet& RDFSClosure::getChildren(Hierarchy hierarchy, const IRI& iri) const
+{
+    return find(getGraph(hierarchy).children, iri);
+}
+
+const IRISet& RDFSClosure::getAncestors(Hierarchy hierarchy, const IRI& iri) const
+{
+    const Graph& graph = getGraph(hierarchy);
+    return close(graph.parents, graph.ancestors, iri);
+}
+
+const IRISet& RDFSClosure::getDescendants(Hierarchy hierarchy, const IRI& iri) const
+{
+    const Graph& graph = getGraph(hierarchy);
+    return close(graph.children, graph.descendants, iri);
+}
+
+bool RDFSClosure::isSubsumedBy(Hierarchy hierarchy, const IRI& iri, const IRI& other) const
+{
+    return iri == other || getAncestors(hierarchy, iri).count(other);
+}
+
+const IRISet& RDFSClosure::getDomains(const IRI& property) const
+{
+    return find(mDomains, property);
+}
+
+const IRISet& RDFSClosure::getRanges(const IRI& property) const
+{
+    return find(mRanges, property);
+}
+
+const IRISet& RDFSClosure::getPropertiesWithDomain(const IRI& klass) const
+{
+    return find(mPropertiesByDomain, klass);
+}
+
+const IRISet& RDFSClosure::getPropertiesWithRange(const IRI& klass) const
+{
+    return find(mPropertiesByRange, klass);
+}
+
+uint64_t RDFSClosure::getMemoryUsage() const
+{
+    uint64_t bytes = 0;
+    for(const Graph& graph : mGraphs)
+    {
+        bytes += memory::heapBytes(graph.parents) + memory::heapBytes(graph.children)
+            + memory::heapBytes(graph.ancestors) + memory::heapBytes(graph.descendants);
+    }
+    return bytes + memory::heapBytes(mDomains) + memory::heapBytes(mRanges)
+        + memory::heapBytes(mPropertiesByDomain) + memory::heapBytes(mPropertiesByRange);
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,147 @@
+#ifndef OWLAPI_MODEL_RDFS_CLOSURE_HPP
+#define OWLAPI_MODEL_RDFS_CLOSURE_HPP
+
+#include <map>
+#include <unordered_map>
+#include "IRI.hpp"
+#include "OWLAxiom.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class RDFSClosure
+ * \brief Asserted class and property hierarchies of an ontology together
+ * with their transitive closure and the named domains and ranges of
+ * properties
+ * \details The asserted edges are extracted from SubClassOf,
+ * EquivalentClasses, SubObjectPropertyOf, SubDataPropertyOf, equivalent
+ * property and domain/range axioms, as far as these relate named entities.
+ * The transitive closure of an entity is computed on first request and
+ * cached until the closure is cleared.
+ *
+ * The closure provides the answers of OWLOntologyAsk::TOLD and
+ * OWLOntologyAsk::RDFS queries, and thus never accesses the reasoner.
+ */
+class RDFSClosure
+{
+public:
+    enum Hierarchy { CLASS, OBJECT_PROPERTY, DATA_PROPERTY };
+
+    RDFSClosure();
+
+    /**
+     * Check if an axiom of the given type affects the closure
+     */
+    static bool isRelevant(OWLAxiom::AxiomType type);
+
+    /**
+     * Clear the closure, so that it has to be built again
+     */
+    void clear();
+
+    /**
+     * Check if the closure has been built, and has not been cleared since
+     */
+    bool isValid() const { return mValid; }
+
+    /**
+     * Build the closure from the axioms of an ontology
+     */
+    void build(const std::map<OWLAxiom::AxiomType, OWLAxiom::PtrList>& axiomsByType);
+
+    /**
+     * Get the asserted direct parents of an entity
+     */
+    const IRISet& getParents(Hierarchy hierarchy, const IRI& iri) const;
+
+    /**
+     * Get the asserted direct children of an entity
+     */
+    const IRISet& getChildren(Hierarchy hierarchy, const IRI& iri) const;
+
+    /**
+     * Get all (transitive) parents of an entity, excluding the entity
+     * itself
+     */
+    const IRISet& getAncestors(Hierarchy hierarchy, const IRI& iri) const;
+
+    /**
+     * Get all (transitive) children of an entity, excluding the entity
+     * itself
+     */
+    const IRISet& getDescendants(Hierarchy hierarchy, const IRI& iri) const;
+
+    /**
+     * Test if an entity is subsumed by another, i.e. if both are the same or
+     * other is an ancestor of iri
+     */
+    bool isSubsumedBy(Hierarchy hierarchy, const IRI& iri, const IRI& other) const;
+
+    /**
+     * Get the named classes which are asserted as domain of the (object or
+     * data) property
+     */
+    const IRISet& getDomains(const IRI& property) const;
+
+    /**
+     * Get the named classes which are asserted as range of the object
+     * property
+     */
+    const IRISet& getRanges(const IRI& property) const;
+
+    /**
+     * Get the (object or data) properties which have the class asserted as
+     * domain
+     */
+    const IRISet& getPropertiesWithDomain(const IRI& klass) const;
+
+    /**
+     * Get the object properties which have the class asserted as range
+     */
+    const IRISet& getPropertiesWithRange(const IRI& klass) const;
+
+    /**
+     * Get the estimated heap memory of the closure, including the cached transitive closures
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    typedef std::unordered_map<IRI, IRISet> Edges;
+
+    struct Graph
+    {
+        Edges parents;
+        Edges children;
+        /// Cached transitive closures
+        mutable Edges ancestors;
+        mutable Edges descendants;
+
+        void clear();
+        void addEdge(const IRI& child, const IRI& parent);
+    };
+
+    static const IRISet& find(const Edges& edges, const IRI& iri);
+
+    /**
+     * Get the transitive closure of the given edges starting from iri,
+     * and cache it
+     */
+    static const IRISet& close(const Edges& edges, Edges& cache, const IRI& iri);
+
+    const Graph& getGraph(Hierarchy hierarchy) const { return mGraphs[hierarchy]; }
+
+    Graph mGraphs[3];
+
+    Edges mDomains;
+    Edges mRanges;
+    Edges mPropertiesByDomain;
+    Edges mPropertiesByRange;
+
+    bool mValid;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_RDFS_CLOSURE_HPP
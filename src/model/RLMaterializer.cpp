@@ -0,0 +1,1684 @@
+#include "RLMaterializer.hpp"
+#include "MemoryUsage.hpp"
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <base-logging/Logging.hpp>
+#include "OWLAnnotation.hpp"
+#include "OWLLiteral.hpp"
+#include "OWLInverseObjectProperty.hpp"
+#include "OWLObjectIntersectionOf.hpp"
+#include "OWLObjectUnionOf.hpp"
+#include "OWLObjectComplementOf.hpp"
+#include "OWLObjectOneOf.hpp"
+#include "OWLObjectHasValue.hpp"
+#include "OWLDataHasValue.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLCardinalityRestriction.hpp"
+#include "OWLQualifiedRestriction.hpp"
+#include "OWLDeclarationAxiom.hpp"
+#include "OWLClassAssertionAxiom.hpp"
+#include "OWLObjectPropertyAssertionAxiom.hpp"
+#include "OWLDataPropertyAssertionAxiom.hpp"
+#include "OWLSubClassOfAxiom.hpp"
+#include "OWLEquivalentClassesAxiom.hpp"
+#include "OWLDisjointClassesAxiom.hpp"
+#include "OWLSubPropertyAxiom.hpp"
+#include "OWLEquivalentObjectPropertiesAxiom.hpp"
+#include "OWLEquivalentDataPropertiesAxiom.hpp"
+#include "OWLDisjointObjectPropertiesAxiom.hpp"
+#include "OWLDisjointDataPropertiesAxiom.hpp"
+#include "OWLInverseObjectPropertiesAxiom.hpp"
+#include "OWLObjectPropertyDomainAxiom.hpp"
+#include "OWLObjectPropertyRangeAxiom.hpp"
+#include "OWLDataPropertyDomainAxiom.hpp"
+#include "OWLFunctionalObjectPropertyAxiom.hpp"
+#include "OWLInverseFunctionalObjectPropertyAxiom.hpp"
+#include "OWLFunctionalDataPropertyAxiom.hpp"
+#include "OWLSymmetricObjectPropertyAxiom.hpp"
+#include "OWLAsymmetricObjectPropertyAxiom.hpp"
+#include "OWLIrreflexiveObjectPropertyAxiom.hpp"
+#include "OWLTransitiveObjectPropertyAxiom.hpp"
+#include "../vocabularies/OWL.hpp"
+
+namespace owlapi {
+namespace model {
+
+const RLMaterializer::Id RLMaterializer::INVALID_ID;
+const RLMaterializer::Id RLMaterializer::THING;
+const RLMaterializer::Id RLMaterializer::NOTHING;
+
+namespace {
+
+/// Minimum number of facts per round to evaluate them in parallel
+const size_t PARALLEL_THRESHOLD = 4096;
+/// Number of facts a thread takes at once
+const size_t BLOCK_SIZE = 256;
+
+template<typename T>
+std::string join(const std::vector<T>& ids)
+{
+    std::string s;
+    for(const T& id : ids)
+    {
+        s += std::to_string(id) + ",";
+    }
+    return s;
+}
+
+} // end anonymous namespace
+
+RLMaterializer::RLMaterializer(size_t numberOfThreads)
+    : mNumberOfThreads(numberOfThreads)
+{
+    if(mNumberOfThreads == 0)
+    {
+        mNumberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    clear();
+}
+
+void RLMaterializer::clear()
+{
+    mUnsupportedReason.clear();
+    mConsistent = true;
+    mHasEquality = false;
+
+    mClassIds.clear();
+    mClasses.clear();
+    mClassRules.clear();
+    mComplexClasses.clear();
+    mInstances.clear();
+
+    mPropertyIds.clear();
+    mProperties.clear();
+    mPropertyRules.clear();
+    mInverseProperties.clear();
+    mToldSuperProperties.clear();
+
+    mIndividualIds.clear();
+    mLiteralIds.clear();
+    mNodes.clear();
+    mTypes.clear();
+    mOutgoing.clear();
+    mIncoming.clear();
+    mRepresentatives.clear();
+    mNext.clear();
+
+    mNumberOfTypes = 0;
+    mNumberOfRelations = 0;
+    mAssertedFacts.clear();
+    mPendingChanges.clear();
+
+    getOrCreateClassId(vocabulary::OWL::Thing());
+    getOrCreateClassId(vocabulary::OWL::Nothing());
+}
+
+bool RLMaterializer::isRelevant(const OWLAxiom::Ptr& axiom)
+{
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+            // individuals are instances of owl:Thing, while classes and
+            // properties without axioms do not lead to any fact
+            return dynamic_pointer_cast<OWLDeclarationAxiom>(axiom)->getEntity()->getEntityType()
+                == OWLEntity::NAMED_INDIVIDUAL;
+        case OWLAxiom::SubAnnotationPropertyOf:
+        case OWLAxiom::AnnotationPropertyDomain:
+        case OWLAxiom::AnnotationPropertyRange:
+        case OWLAxiom::AnnotationAssertion:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool RLMaterializer::materialize(const OWLOntology::Ptr& ontology)
+{
+    clear();
+    for(const std::pair<const OWLAxiom::AxiomType, OWLAxiom::PtrList>& typedAxioms : ontology->getAxiomMap())
+    {
+        for(const OWLAxiom::Ptr& axiom : typedAxioms.second)
+        {
+            if(!addAxiom(axiom))
+            {
+                LOG_DEBUG_S << "owlapi::model::RLMaterializer::materialize: ontology is not supported: "
+                    << mUnsupportedReason;
+                return false;
+            }
+        }
+    }
+    finishRules();
+
+    std::vector<Fact> conclusions;
+    conclusions.reserve(mAssertedFacts.size());
+    for(const std::pair<const Fact, size_t>& asserted : mAssertedFacts)
+    {
+        conclusions.push_back(asserted.first);
+    }
+    saturate(conclusions);
+
+    LOG_DEBUG_S << "owlapi::model::RLMaterializer::materialize: derived " << mNumberOfTypes
+        << " types and " << mNumberOfRelations << " relations of " << mNodes.size()
+        << " individuals from " << mAssertedFacts.size() << " asserted facts using "
+        << mNumberOfThreads << " threads";
+    return true;
+}
+
+bool RLMaterializer::enqueue(const OWLAxiom::Ptr& axiom, bool added)
+{
+    if(!isRelevant(axiom))
+    {
+        return true;
+    }
+
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+        case OWLAxiom::ObjectPropertyAssertion:
+        case OWLAxiom::DataPropertyAssertion:
+            break;
+        case OWLAxiom::ClassAssertion:
+            // anonymous classes need to be compiled into rules
+            if(dynamic_pointer_cast<OWLClassAssertionAxiom>(axiom)->getClassExpression()->getClassExpressionType()
+                    != OWLClassExpression::OWL_CLASS)
+            {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    mPendingChanges.push_back(std::make_pair(axiom, added));
+    return true;
+}
+
+bool RLMaterializer::update()
+{
+    if(mPendingChanges.empty())
+    {
+        return true;
+    }
+
+    // net effect of the changes on the number of assertions of each fact
+    std::unordered_map<Fact, long, FactHash> changes;
+    for(const std::pair<OWLAxiom::Ptr, bool>& change : mPendingChanges)
+    {
+        std::vector<Fact> facts;
+        if(!getAssertedFacts(change.first, false, facts))
+        {
+            return false;
+        }
+        for(const Fact& fact : facts)
+        {
+            changes[fact] += change.second ? 1 : -1;
+        }
+    }
+    mPendingChanges.clear();
+
+    std::vector<Fact> added;
+    std::vector<Fact> removed;
+    for(const std::pair<const Fact, long>& change : changes)
+    {
+        if(change.second == 0)
+        {
+            continue;
+        }
+
+        std::unordered_map<Fact, size_t, FactHash>::iterator it = mAssertedFacts.find(change.first);
+        long before = it == mAssertedFacts.end() ? 0 : it->second;
+        long after = std::max(0L, before + change.second);
+        if(after == 0)
+        {
+            if(it != mAssertedFacts.end())
+            {
+                mAssertedFacts.erase(it);
+            }
+        } else {
+            mAssertedFacts[change.first] = after;
+        }
+
+        if(before == 0 && after > 0)
+        {
+            added.push_back(change.first);
+        } else if(before > 0 && after == 0)
+        {
+            removed.push_back(change.first);
+        }
+    }
+
+    LOG_DEBUG_S << "owlapi::model::RLMaterializer::update: adding " << added.size()
+        << " and removing " << removed.size() << " asserted facts";
+
+    if(!removed.empty())
+    {
+        // merged individuals cannot be split again, and an inconsistent
+        // materialization is incomplete
+        if(mHasEquality || !mConsistent)
+        {
+            return false;
+        }
+        retract(removed);
+    }
+
+    if(!added.empty())
+    {
+        saturate(added);
+    }
+
+    return true;
+}
+
+RLMaterializer::Id RLMaterializer::createClass()
+{
+    Id id = mClasses.size();
+    mClasses.push_back(IRI());
+    mClassRules.push_back(ClassRules());
+    mInstances.push_back(IdList());
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::createProperty(const IRI& property, bool dataProperty)
+{
+    Id id = mProperties.size();
+    mProperties.push_back(property);
+    mPropertyRules.push_back(PropertyRules());
+    mPropertyRules.back().dataProperty = dataProperty;
+    mToldSuperProperties.push_back(IdList());
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::createNode(const IRI& iri)
+{
+    Id id = mNodes.size();
+    mNodes.push_back(iri);
+    mTypes.push_back(IdList());
+    mOutgoing.push_back(EdgeList());
+    mIncoming.push_back(EdgeList());
+    mRepresentatives.push_back(id);
+    mNext.push_back(id);
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::getOrCreateClassId(const IRI& klass)
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mClassIds.find(klass);
+    if(cit != mClassIds.end())
+    {
+        return cit->second;
+    }
+
+    Id id = createClass();
+    mClasses[id] = klass;
+    mClassIds[klass] = id;
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::getOrCreatePropertyId(const IRI& property, bool dataProperty)
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mPropertyIds.find(property);
+    if(cit != mPropertyIds.end())
+    {
+        return cit->second;
+    }
+
+    Id id = createProperty(property, dataProperty);
+    mPropertyIds[property] = id;
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::getOrCreateIndividualId(const IRI& individual)
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mIndividualIds.find(individual);
+    if(cit != mIndividualIds.end())
+    {
+        return cit->second;
+    }
+
+    Id id = createNode(individual);
+    mIndividualIds[individual] = id;
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::getOrCreateLiteralId(const OWLLiteral::Ptr& literal)
+{
+    std::string key = literal->toString();
+    std::unordered_map<std::string, Id>::const_iterator cit = mLiteralIds.find(key);
+    if(cit != mLiteralIds.end())
+    {
+        return cit->second;
+    }
+
+    Id id = createNode(IRI());
+    mLiteralIds[key] = id;
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::getClassId(const IRI& klass) const
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mClassIds.find(klass);
+    return cit == mClassIds.end() ? INVALID_ID : cit->second;
+}
+
+RLMaterializer::Id RLMaterializer::getPropertyId(const IRI& property) const
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mPropertyIds.find(property);
+    return cit == mPropertyIds.end() ? INVALID_ID : cit->second;
+}
+
+RLMaterializer::Id RLMaterializer::getIndividualId(const IRI& individual) const
+{
+    std::unordered_map<IRI, Id>::const_iterator cit = mIndividualIds.find(individual);
+    return cit == mIndividualIds.end() ? INVALID_ID : cit->second;
+}
+
+bool RLMaterializer::unsupported(const std::string& reason)
+{
+    if(mUnsupportedReason.empty())
+    {
+        mUnsupportedReason = reason;
+    }
+    return false;
+}
+
+RLMaterializer::Id RLMaterializer::inverse(Id property)
+{
+    std::unordered_map<Id, Id>::const_iterator cit = mInverseProperties.find(property);
+    if(cit != mInverseProperties.end())
+    {
+        return cit->second;
+    }
+
+    // the inverse is an unnamed property which is related to the property
+    // by the inverse rules
+    Id id = createProperty(IRI(), false);
+    mPropertyRules[property].inverseProperties.push_back(id);
+    mPropertyRules[id].inverseProperties.push_back(property);
+    mInverseProperties[property] = id;
+    mInverseProperties[id] = property;
+    return id;
+}
+
+RLMaterializer::Id RLMaterializer::property(const OWLPropertyExpression::Ptr& property, bool dataProperty)
+{
+    if(OWLProperty::Ptr namedProperty = dynamic_pointer_cast<OWLProperty>(property))
+    {
+        return getOrCreatePropertyId(namedProperty->getIRI(), dataProperty);
+    }
+
+    shared_ptr<OWLInverseObjectProperty> inverseProperty = dynamic_pointer_cast<OWLInverseObjectProperty>(property);
+    OWLProperty::Ptr namedProperty = inverseProperty ? dynamic_pointer_cast<OWLProperty>(inverseProperty->getInverse()) : OWLProperty::Ptr();
+    if(!namedProperty)
+    {
+        unsupported("nested property expressions are not supported");
+        return THING;
+    }
+    return inverse(getOrCreatePropertyId(namedProperty->getIRI(), false));
+}
+
+RLMaterializer::Id RLMaterializer::individual(const OWLIndividual::Ptr& individual)
+{
+    return getOrCreateIndividualId(individual->getReferenceID());
+}
+
+bool RLMaterializer::complex(const std::string& key, Id& klass)
+{
+    std::unordered_map<std::string, Id>::const_iterator cit = mComplexClasses.find(key);
+    if(cit != mComplexClasses.end())
+    {
+        klass = cit->second;
+        return false;
+    }
+    klass = createClass();
+    mComplexClasses[key] = klass;
+    return true;
+}
+
+RLMaterializer::IdList RLMaterializer::subClasses(const OWLClassExpression::PtrList& expressions)
+{
+    IdList ids;
+    for(const OWLClassExpression::Ptr& expression : expressions)
+    {
+        ids.push_back(subClass(expression));
+    }
+    return ids;
+}
+
+RLMaterializer::Id RLMaterializer::subClass(const OWLClassExpression::Ptr& expression)
+{
+    Id id;
+    switch(expression->getClassExpressionType())
+    {
+        case OWLClassExpression::OWL_CLASS:
+            return getOrCreateClassId(dynamic_pointer_cast<OWLClass>(expression)->getIRI());
+        case OWLClassExpression::OBJECT_INTERSECTION_OF:
+        {
+            IdList operands = subClasses(dynamic_pointer_cast<OWLObjectIntersectionOf>(expression)->getOperands());
+            std::sort(operands.begin(), operands.end());
+            operands.erase(std::unique(operands.begin(), operands.end()), operands.end());
+            if(operands.size() == 1)
+            {
+                return operands.front();
+            }
+
+            if(complex("and:" + join(operands), id))
+            {
+                for(Id operand : operands)
+                {
+                    mClassRules[operand].conjunctions.push_back(Conjunction{operands, id});
+                }
+            }
+            return id;
+        }
+        case OWLClassExpression::OBJECT_UNION_OF:
+        {
+            IdList operands = subClasses(dynamic_pointer_cast<OWLObjectUnionOf>(expression)->getOperands());
+            std::sort(operands.begin(), operands.end());
+            if(complex("or:" + join(operands), id))
+            {
+                for(Id operand : operands)
+                {
+                    mClassRules[operand].superClasses.push_back(id);
+                }
+            }
+            return id;
+        }
+        case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+        {
+            Id p = property(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty(), false);
+            Id filler = subClass(dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(expression)->getFiller());
+            if(complex("some:" + std::to_string(p) + "," + std::to_string(filler), id))
+            {
+                mClassRules[filler].someValuesFrom.push_back(std::make_pair(p, id));
+                mPropertyRules[p].someValuesFrom.push_back(std::make_pair(filler, id));
+            }
+            return id;
+        }
+        case OWLClassExpression::OBJECT_HAS_VALUE:
+        case OWLClassExpression::DATA_HAS_VALUE:
+        {
+            Id p;
+            Id value;
+            if(OWLObjectHasValue::Ptr hasValue = dynamic_pointer_cast<OWLObjectHasValue>(expression))
+            {
+                p = property(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty(), false);
+                value = individual(hasValue->getFiller());
+            } else {
+                OWLDataHasValue::Ptr dataHasValue = dynamic_pointer_cast<OWLDataHasValue>(expression);
+                p = property(dynamic_pointer_cast<OWLDataRestriction>(expression)->getProperty(), true);
+                value = getOrCreateLiteralId(dataHasValue->getFiller());
+            }
+
+            if(complex("value:" + std::to_string(p) + "," + std::to_string(value), id))
+            {
+                mPropertyRules[p].hasValue.push_back(std::make_pair(value, id));
+            }
+            return id;
+        }
+        case OWLClassExpression::OBJECT_ONE_OF:
+        {
+            IdList individuals;
+            for(const OWLNamedIndividual::Ptr& member : dynamic_pointer_cast<OWLObjectOneOf>(expression)->getNamedIndividuals())
+            {
+                individuals.push_back(individual(member));
+            }
+            std::sort(individuals.begin(), individuals.end());
+            if(complex("oneOf:" + join(individuals), id))
+            {
+                // the members are instances independent of any assertion
+                for(Id member : individuals)
+                {
+                    ++mAssertedFacts[Fact::type(member, id)];
+                }
+            }
+            return id;
+        }
+        default:
+            unsupported(OWLClassExpression::TypeTxt[expression->getClassExpressionType()] + " is not supported as subclass");
+            return THING;
+    }
+}
+
+RLMaterializer::Id RLMaterializer::superClass(const OWLClassExpression::Ptr& expression)
+{
+    if(expression->getClassExpressionType() == OWLClassExpression::OWL_CLASS)
+    {
+        return getOrCreateClassId(dynamic_pointer_cast<OWLClass>(expression)->getIRI());
+    }
+
+    Id id = createClass();
+    subsumes(id, expression);
+    return id;
+}
+
+void RLMaterializer::subsumes(Id klass, const OWLClassExpression::Ptr& expression)
+{
+    switch(expression->getClassExpressionType())
+    {
+        case OWLClassExpression::OWL_CLASS:
+        {
+            Id superclass = getOrCreateClassId(dynamic_pointer_cast<OWLClass>(expression)->getIRI());
+            if(superclass != klass)
+            {
+                mClassRules[klass].superClasses.push_back(superclass);
+            }
+            break;
+        }
+        case OWLClassExpression::OBJECT_INTERSECTION_OF:
+            for(const OWLClassExpression::Ptr& operand : dynamic_pointer_cast<OWLObjectIntersectionOf>(expression)->getOperands())
+            {
+                subsumes(klass, operand);
+            }
+            break;
+        case OWLClassExpression::OBJECT_COMPLEMENT_OF:
+            disjoint(klass, subClass(dynamic_pointer_cast<OWLObjectComplementOf>(expression)->getOperand()));
+            break;
+        case OWLClassExpression::OBJECT_ALL_VALUES_FROM:
+        {
+            Id p = property(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty(), false);
+            allValuesFrom(klass, p, superClass(dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(expression)->getFiller()));
+            break;
+        }
+        case OWLClassExpression::OBJECT_HAS_VALUE:
+        {
+            OWLObjectHasValue::Ptr hasValue = dynamic_pointer_cast<OWLObjectHasValue>(expression);
+            Id p = property(dynamic_pointer_cast<OWLObjectRestriction>(expression)->getProperty(), false);
+            mClassRules[klass].hasValue.push_back(std::make_pair(p, individual(hasValue->getFiller())));
+            break;
+        }
+        case OWLClassExpression::DATA_HAS_VALUE:
+        {
+            OWLDataHasValue::Ptr hasValue = dynamic_pointer_cast<OWLDataHasValue>(expression);
+            Id p = property(dynamic_pointer_cast<OWLDataRestriction>(expression)->getProperty(), true);
+            mClassRules[klass].hasValue.push_back(std::make_pair(p, getOrCreateLiteralId(hasValue->getFiller())));
+            break;
+        }
+        case OWLClassExpression::OBJECT_MAX_CARDINALITY:
+        {
+            OWLCardinalityRestriction::Ptr restriction = dynamic_pointer_cast<OWLCardinalityRestriction>(expression);
+            Id p = property(restriction->getProperty(), false);
+            OWLQualifiedRestriction::Ptr qualified = dynamic_pointer_cast<OWLQualifiedRestriction>(expression);
+            Id filler = qualified && qualified->isQualified() ? getOrCreateClassId(qualified->getQualification()) : THING;
+
+            if(restriction->getCardinality() == 0)
+            {
+                // A ⊑ ∀p.¬F
+                Id complement = NOTHING;
+                if(filler != THING)
+                {
+                    complement = createClass();
+                    disjoint(complement, filler);
+                }
+                allValuesFrom(klass, p, complement);
+            } else if(restriction->getCardinality() == 1)
+            {
+                maxCardinality(klass, p, filler);
+            } else {
+                unsupported("max cardinalities greater than 1 are not supported");
+            }
+            break;
+        }
+        default:
+            unsupported(OWLClassExpression::TypeTxt[expression->getClassExpressionType()] + " is not supported as superclass");
+            break;
+    }
+}
+
+void RLMaterializer::disjoint(Id klass, Id otherClass)
+{
+    if(klass == otherClass)
+    {
+        mClassRules[klass].superClasses.push_back(NOTHING);
+        return;
+    }
+    mClassRules[klass].disjointClasses.push_back(otherClass);
+    mClassRules[otherClass].disjointClasses.push_back(klass);
+}
+
+void RLMaterializer::allValuesFrom(Id klass, Id property, Id filler)
+{
+    mClassRules[klass].allValuesFrom.push_back(std::make_pair(property, filler));
+    mPropertyRules[property].allValuesFrom.push_back(std::make_pair(klass, filler));
+}
+
+void RLMaterializer::maxCardinality(Id klass, Id property, Id filler)
+{
+    mClassRules[klass].maxCardinality.push_back(std::make_pair(property, filler));
+    mClassRules[filler].maxCardinalityFiller.push_back(std::make_pair(property, klass));
+    mPropertyRules[property].maxCardinality.push_back(std::make_pair(klass, filler));
+}
+
+bool RLMaterializer::addAxiom(const OWLAxiom::Ptr& axiom)
+{
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+        case OWLAxiom::ClassAssertion:
+        case OWLAxiom::ObjectPropertyAssertion:
+        case OWLAxiom::DataPropertyAssertion:
+        {
+            std::vector<Fact> facts;
+            if(!getAssertedFacts(axiom, true, facts))
+            {
+                return unsupported(OWLAxiom::AxiomTypeTxt[axiom->getAxiomType()] + " axiom is not supported");
+            }
+            for(const Fact& fact : facts)
+            {
+                ++mAssertedFacts[fact];
+            }
+            break;
+        }
+        case OWLAxiom::SubClassOf:
+        {
+            OWLSubClassOfAxiom::Ptr subClassAxiom = dynamic_pointer_cast<OWLSubClassOfAxiom>(axiom);
+            subsumes(subClass(subClassAxiom->getSubClass()), subClassAxiom->getSuperClass());
+            break;
+        }
+        case OWLAxiom::EquivalentClasses:
+        {
+            const OWLClassExpression::PtrList& expressions = dynamic_pointer_cast<OWLEquivalentClassesAxiom>(axiom)->getEquivalentClasses();
+            IdList ids = subClasses(expressions);
+            for(size_t i = 0; i < ids.size(); ++i)
+            {
+                for(size_t j = 0; j < expressions.size(); ++j)
+                {
+                    if(i != j)
+                    {
+                        subsumes(ids[i], expressions[j]);
+                    }
+                }
+            }
+            break;
+        }
+        case OWLAxiom::DisjointClasses:
+        {
+            IdList ids = subClasses(dynamic_pointer_cast<OWLDisjointClassesAxiom>(axiom)->getClassExpressions());
+            for(size_t i = 0; i < ids.size(); ++i)
+            {
+                for(size_t j = i + 1; j < ids.size(); ++j)
+                {
+                    disjoint(ids[i], ids[j]);
+                }
+            }
+            break;
+        }
+        case OWLAxiom::SubObjectPropertyOf:
+        case OWLAxiom::SubDataPropertyOf:
+        {
+            bool dataProperty = axiom->getAxiomType() == OWLAxiom::SubDataPropertyOf;
+            OWLSubPropertyAxiom::Ptr subPropertyAxiom = dynamic_pointer_cast<OWLSubPropertyAxiom>(axiom);
+            Id subProperty = property(subPropertyAxiom->getSubProperty(), dataProperty);
+            Id superProperty = property(subPropertyAxiom->getSuperProperty(), dataProperty);
+            mToldSuperProperties[subProperty].push_back(superProperty);
+            break;
+        }
+        case OWLAxiom::EquivalentObjectProperties:
+        case OWLAxiom::EquivalentDataProperties:
+        {
+            IdList ids;
+            if(axiom->getAxiomType() == OWLAxiom::EquivalentObjectProperties)
+            {
+                for(const OWLObjectPropertyExpression::Ptr& p : dynamic_pointer_cast<OWLEquivalentObjectPropertiesAxiom>(axiom)->getProperties())
+                {
+                    ids.push_back(property(p, false));
+                }
+            } else {
+                for(const OWLDataPropertyExpression::Ptr& p : dynamic_pointer_cast<OWLEquivalentDataPropertiesAxiom>(axiom)->getProperties())
+                {
+                    ids.push_back(property(p, true));
+                }
+            }
+
+            for(Id p : ids)
+            {
+                for(Id q : ids)
+                {
+                    if(p != q)
+                    {
+                        mToldSuperProperties[p].push_back(q);
+                    }
+                }
+            }
+            break;
+        }
+        case OWLAxiom::DisjointObjectProperties:
+        case OWLAxiom::DisjointDataProperties:
+        {
+            IdList ids;
+            if(axiom->getAxiomType() == OWLAxiom::DisjointObjectProperties)
+            {
+                for(const OWLObjectPropertyExpression::Ptr& p : dynamic_pointer_cast<OWLDisjointObjectPropertiesAxiom>(axiom)->getProperties())
+                {
+                    ids.push_back(property(p, false));
+                }
+            } else {
+                for(const OWLDataPropertyExpression::Ptr& p : dynamic_pointer_cast<OWLDisjointDataPropertiesAxiom>(axiom)->getProperties())
+                {
+                    ids.push_back(property(p, true));
+                }
+            }
+
+            for(size_t i = 0; i < ids.size(); ++i)
+            {
+                for(size_t j = i + 1; j < ids.size(); ++j)
+                {
+                    mPropertyRules[ids[i]].disjointProperties.push_back(ids[j]);
+                    mPropertyRules[ids[j]].disjointProperties.push_back(ids[i]);
+                }
+            }
+            break;
+        }
+        case OWLAxiom::InverseObjectProperties:
+        {
+            shared_ptr<OWLInverseObjectPropertiesAxiom> inverseAxiom = dynamic_pointer_cast<OWLInverseObjectPropertiesAxiom>(axiom);
+            Id p = property(inverseAxiom->getFirstProperty(), false);
+            Id q = property(inverseAxiom->getSecondProperty(), false);
+            mPropertyRules[p].inverseProperties.push_back(q);
+            mPropertyRules[q].inverseProperties.push_back(p);
+            break;
+        }
+        case OWLAxiom::ObjectPropertyDomain:
+        {
+            OWLObjectPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLObjectPropertyDomainAxiom>(axiom);
+            Id p = property(domainAxiom->getProperty(), false);
+            Id domain = superClass(domainAxiom->getDomain());
+            mPropertyRules[p].domains.push_back(domain);
+            break;
+        }
+        case OWLAxiom::ObjectPropertyRange:
+        {
+            OWLObjectPropertyRangeAxiom::Ptr rangeAxiom = dynamic_pointer_cast<OWLObjectPropertyRangeAxiom>(axiom);
+            Id p = property(rangeAxiom->getProperty(), false);
+            Id range = superClass(rangeAxiom->getRange());
+            mPropertyRules[p].ranges.push_back(range);
+            break;
+        }
+        case OWLAxiom::DataPropertyDomain:
+        {
+            OWLDataPropertyDomainAxiom::Ptr domainAxiom = dynamic_pointer_cast<OWLDataPropertyDomainAxiom>(axiom);
+            Id p = property(domainAxiom->getProperty(), true);
+            Id domain = superClass(domainAxiom->getDomain());
+            mPropertyRules[p].domains.push_back(domain);
+            break;
+        }
+        case OWLAxiom::FunctionalObjectProperty:
+            maxCardinality(THING, property(dynamic_pointer_cast<OWLFunctionalObjectPropertyAxiom>(axiom)->getProperty(), false), THING);
+            break;
+        case OWLAxiom::InverseFunctionalObjectProperty:
+        {
+            Id p = property(dynamic_pointer_cast<OWLInverseFunctionalObjectPropertyAxiom>(axiom)->getProperty(), false);
+            maxCardinality(THING, inverse(p), THING);
+            break;
+        }
+        case OWLAxiom::FunctionalDataProperty:
+            maxCardinality(THING, property(dynamic_pointer_cast<OWLFunctionalDataPropertyAxiom>(axiom)->getProperty(), true), THING);
+            break;
+        case OWLAxiom::SymmetricObjectProperty:
+        {
+            Id p = property(dynamic_pointer_cast<OWLSymmetricObjectPropertyAxiom>(axiom)->getProperty(), false);
+            mPropertyRules[p].inverseProperties.push_back(p);
+            break;
+        }
+        case OWLAxiom::AsymmetricObjectProperty:
+            mPropertyRules[property(dynamic_pointer_cast<OWLAsymmetricObjectPropertyAxiom>(axiom)->getProperty(), false)].asymmetric = true;
+            break;
+        case OWLAxiom::IrreflexiveObjectProperty:
+            mPropertyRules[property(dynamic_pointer_cast<OWLIrreflexiveObjectPropertyAxiom>(axiom)->getProperty(), false)].irreflexive = true;
+            break;
+        case OWLAxiom::TransitiveObjectProperty:
+            mPropertyRules[property(dynamic_pointer_cast<OWLTransitiveObjectPropertyAxiom>(axiom)->getProperty(), false)].transitive = true;
+            break;
+        case OWLAxiom::DataPropertyRange:
+            // literals are not typed, and the values of data properties are
+            // validated when they are asserted
+        case OWLAxiom::SubAnnotationPropertyOf:
+        case OWLAxiom::AnnotationPropertyDomain:
+        case OWLAxiom::AnnotationPropertyRange:
+        case OWLAxiom::AnnotationAssertion:
+            break;
+        default:
+            return unsupported(OWLAxiom::AxiomTypeTxt[axiom->getAxiomType()] + " axioms are not supported");
+    }
+    return mUnsupportedReason.empty();
+}
+
+bool RLMaterializer::getAssertedFacts(const OWLAxiom::Ptr& axiom, bool compile, std::vector<Fact>& facts)
+{
+    switch(axiom->getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+        {
+            OWLEntity::Ptr entity = dynamic_pointer_cast<OWLDeclarationAxiom>(axiom)->getEntity();
+            if(entity->getEntityType() == OWLEntity::NAMED_INDIVIDUAL)
+            {
+                facts.push_back(Fact::type(getOrCreateIndividualId(entity->getIRI()), THING));
+            }
+            return true;
+        }
+        case OWLAxiom::ClassAssertion:
+        {
+            OWLClassAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLClassAssertionAxiom>(axiom);
+            const OWLClassExpression::Ptr& expression = assertion->getClassExpression();
+            if(!compile && expression->getClassExpressionType() != OWLClassExpression::OWL_CLASS)
+            {
+                return false;
+            }
+            facts.push_back(Fact::type(individual(assertion->getIndividual()), superClass(expression)));
+            return true;
+        }
+        case OWLAxiom::ObjectPropertyAssertion:
+        {
+            OWLPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLPropertyAssertionAxiom>(axiom);
+            // the object is a literal if it was not a known individual
+            OWLIndividual::Ptr object = dynamic_pointer_cast<OWLIndividual>(assertion->getObject());
+            if(object)
+            {
+                Id p = property(assertion->getProperty(), false);
+                facts.push_back(Fact::relation(individual(assertion->getSubject()), p, individual(object)));
+            }
+            return mUnsupportedReason.empty();
+        }
+        case OWLAxiom::DataPropertyAssertion:
+        {
+            OWLPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLPropertyAssertionAxiom>(axiom);
+            OWLLiteral::Ptr value = dynamic_pointer_cast<OWLLiteral>(assertion->getObject());
+            if(value)
+            {
+                Id p = property(assertion->getProperty(), true);
+                facts.push_back(Fact::relation(individual(assertion->getSubject()), p, getOrCreateLiteralId(value)));
+            }
+            return mUnsupportedReason.empty();
+        }
+        default:
+            return false;
+    }
+}
+
+void RLMaterializer::finishRules()
+{
+    // strict superproperties, including those of cyclic hierarchies
+    for(Id p = 0; p < mProperties.size(); ++p)
+    {
+        IdList& superProperties = mPropertyRules[p].superProperties;
+        IdList pending = mToldSuperProperties[p];
+        while(!pending.empty())
+        {
+            Id q = pending.back();
+            pending.pop_back();
+            if(q == p || std::find(superProperties.begin(), superProperties.end(), q) != superProperties.end())
+            {
+                continue;
+            }
+            superProperties.push_back(q);
+            pending.insert(pending.end(), mToldSuperProperties[q].begin(), mToldSuperProperties[q].end());
+        }
+    }
+}
+
+bool RLMaterializer::hasType(Id node, Id klass) const
+{
+    const IdList& types = mTypes[node];
+    return std::binary_search(types.begin(), types.end(), klass);
+}
+
+bool RLMaterializer::hasRelation(Id subject, Id property, Id object) const
+{
+    const EdgeList& edges = mOutgoing[subject];
+    return std::binary_search(edges.begin(), edges.end(), Edge{property, object});
+}
+
+bool RLMaterializer::contains(const Fact& fact) const
+{
+    switch(fact.kind)
+    {
+        case Fact::TYPE:
+            return hasType(fact.subject, fact.object);
+        case Fact::RELATION:
+            return hasRelation(fact.subject, fact.property, fact.object);
+        default:
+            return false;
+    }
+}
+
+std::pair<RLMaterializer::EdgeList::const_iterator, RLMaterializer::EdgeList::const_iterator>
+RLMaterializer::getRelations(Id node, Id property) const
+{
+    const EdgeList& edges = mOutgoing[node];
+    return std::make_pair(std::lower_bound(edges.begin(), edges.end(), Edge{property, 0}),
+            std::upper_bound(edges.begin(), edges.end(), Edge{property, INVALID_ID}));
+}
+
+void RLMaterializer::sameFillers(Id node, Id property, Id filler, Id individual, std::vector<Fact>& conclusions) const
+{
+    std::pair<EdgeList::const_iterator, EdgeList::const_iterator> range = getRelations(node, property);
+    for(EdgeList::const_iterator it = range.first; it != range.second; ++it)
+    {
+        if(it->node != individual && holds(it->node, filler))
+        {
+            conclusions.push_back(Fact::same(individual, it->node));
+        }
+    }
+}
+
+void RLMaterializer::evaluate(const Fact& fact, std::vector<Fact>& conclusions) const
+{
+    typedef std::pair<EdgeList::const_iterator, EdgeList::const_iterator> Range;
+
+    if(fact.kind == Fact::TYPE)
+    {
+        Id x = fact.subject;
+        Id klass = fact.object;
+        if(klass == NOTHING)
+        {
+            conclusions.push_back(Fact::clash(x));
+            return;
+        }
+        if(!hasType(x, THING))
+        {
+            conclusions.push_back(Fact::type(x, THING));
+        }
+
+        const ClassRules& rules = mClassRules[klass];
+        for(Id superclass : rules.superClasses)
+        {
+            conclusions.push_back(Fact::type(x, superclass));
+        }
+
+        for(const Conjunction& conjunction : rules.conjunctions)
+        {
+            bool holds = true;
+            for(Id operand : conjunction.operands)
+            {
+                if(operand != klass && !hasType(x, operand))
+                {
+                    holds = false;
+                    break;
+                }
+            }
+            if(holds)
+            {
+                conclusions.push_back(Fact::type(x, conjunction.result));
+            }
+        }
+
+        if(!rules.someValuesFrom.empty() || !rules.maxCardinalityFiller.empty())
+        {
+            for(const Edge& incoming : mIncoming[x])
+            {
+                // ∃p.A ⊑ B
+                for(const std::pair<Id, Id>& rule : rules.someValuesFrom)
+                {
+                    if(incoming.property == rule.first)
+                    {
+                        conclusions.push_back(Fact::type(incoming.node, rule.second));
+                    }
+                }
+                // B ⊑ ≤1 p.A
+                for(const std::pair<Id, Id>& rule : rules.maxCardinalityFiller)
+                {
+                    if(incoming.property == rule.first && holds(incoming.node, rule.second))
+                    {
+                        sameFillers(incoming.node, rule.first, klass, x, conclusions);
+                    }
+                }
+            }
+        }
+
+        for(const std::pair<Id, Id>& rule : rules.allValuesFrom)
+        {
+            Range range = getRelations(x, rule.first);
+            for(EdgeList::const_iterator it = range.first; it != range.second; ++it)
+            {
+                conclusions.push_back(Fact::type(it->node, rule.second));
+            }
+        }
+
+        for(const std::pair<Id, Id>& rule : rules.hasValue)
+        {
+            conclusions.push_back(Fact::relation(x, rule.first, representative(rule.second)));
+        }
+
+        for(const std::pair<Id, Id>& rule : rules.maxCardinality)
+        {
+            Id first = INVALID_ID;
+            Range range = getRelations(x, rule.first);
+            for(EdgeList::const_iterator it = range.first; it != range.second; ++it)
+            {
+                if(holds(it->node, rule.second))
+                {
+                    if(first == INVALID_ID)
+                    {
+                        first = it->node;
+                    } else {
+                        conclusions.push_back(Fact::same(first, it->node));
+                    }
+                }
+            }
+        }
+
+        for(Id disjointClass : rules.disjointClasses)
+        {
+            if(hasType(x, disjointClass))
+            {
+                conclusions.push_back(Fact::clash(x));
+            }
+        }
+    } else if(fact.kind == Fact::RELATION)
+    {
+        Id x = fact.subject;
+        Id p = fact.property;
+        Id y = fact.object;
+        const PropertyRules& rules = mPropertyRules[p];
+
+        if(!hasType(x, THING))
+        {
+            conclusions.push_back(Fact::type(x, THING));
+        }
+        if(!rules.dataProperty && !hasType(y, THING))
+        {
+            conclusions.push_back(Fact::type(y, THING));
+        }
+
+        for(Id superProperty : rules.superProperties)
+        {
+            conclusions.push_back(Fact::relation(x, superProperty, y));
+        }
+        for(Id inverseProperty : rules.inverseProperties)
+        {
+            conclusions.push_back(Fact::relation(y, inverseProperty, x));
+        }
+
+        if(rules.transitive)
+        {
+            Range range = getRelations(y, p);
+            for(EdgeList::const_iterator it = range.first; it != range.second; ++it)
+            {
+                conclusions.push_back(Fact::relation(x, p, it->node));
+            }
+            for(const Edge& incoming : mIncoming[x])
+            {
+                if(incoming.property == p)
+                {
+                    conclusions.push_back(Fact::relation(incoming.node, p, y));
+                }
+            }
+        }
+
+        for(Id domain : rules.domains)
+        {
+            conclusions.push_back(Fact::type(x, domain));
+        }
+        for(Id range : rules.ranges)
+        {
+            conclusions.push_back(Fact::type(y, range));
+        }
+
+        for(const std::pair<Id, Id>& rule : rules.someValuesFrom)
+        {
+            if(holds(y, rule.first))
+            {
+                conclusions.push_back(Fact::type(x, rule.second));
+            }
+        }
+        for(const std::pair<Id, Id>& rule : rules.hasValue)
+        {
+            if(representative(rule.first) == y)
+            {
+                conclusions.push_back(Fact::type(x, rule.second));
+            }
+        }
+        for(const std::pair<Id, Id>& rule : rules.allValuesFrom)
+        {
+            if(holds(x, rule.first))
+            {
+                conclusions.push_back(Fact::type(y, rule.second));
+            }
+        }
+        for(const std::pair<Id, Id>& rule : rules.maxCardinality)
+        {
+            if(holds(x, rule.first) && holds(y, rule.second))
+            {
+                sameFillers(x, p, rule.second, y, conclusions);
+            }
+        }
+
+        if((rules.irreflexive && x == y) || (rules.asymmetric && hasRelation(y, p, x)))
+        {
+            conclusions.push_back(Fact::clash(x));
+        }
+        for(Id disjointProperty : rules.disjointProperties)
+        {
+            if(hasRelation(x, disjointProperty, y))
+            {
+                conclusions.push_back(Fact::clash(x));
+            }
+        }
+    }
+}
+
+void RLMaterializer::evaluate(const std::vector<Fact>& facts, std::vector<Fact>& conclusions) const
+{
+    if(mNumberOfThreads <= 1 || facts.size() < PARALLEL_THRESHOLD)
+    {
+        for(const Fact& fact : facts)
+        {
+            evaluate(fact, conclusions);
+        }
+        return;
+    }
+
+    // the facts are only read while evaluating, so that the threads can
+    // share them without synchronization
+    std::vector< std::vector<Fact> > results(mNumberOfThreads);
+    std::atomic<size_t> next(0);
+    std::function<void(size_t)> worker = [&](size_t thread)
+    {
+        for(size_t begin = next.fetch_add(BLOCK_SIZE); begin < facts.size(); begin = next.fetch_add(BLOCK_SIZE))
+        {
+            size_t end = std::min(begin + BLOCK_SIZE, facts.size());
+            for(size_t i = begin; i < end; ++i)
+            {
+                evaluate(facts[i], results[thread]);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < mNumberOfThreads; ++i)
+    {
+        threads.push_back(std::thread(worker, i));
+    }
+    worker(0);
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(const std::vector<Fact>& result : results)
+    {
+        conclusions.insert(conclusions.end(), result.begin(), result.end());
+    }
+}
+
+void RLMaterializer::clash(Id node, const std::string& reason)
+{
+    if(mConsistent)
+    {
+        LOG_DEBUG_S << "owlapi::model::RLMaterializer: ontology is inconsistent: " << reason
+            << " for " << (isLiteral(node) ? std::string("literal") : mNodes[node].toString());
+    }
+    mConsistent = false;
+}
+
+void RLMaterializer::merge(Id node, Id otherNode, std::vector<Fact>& conclusions)
+{
+    Id a = representative(node);
+    Id b = representative(otherNode);
+    if(a == b)
+    {
+        return;
+    }
+    if(isLiteral(a) || isLiteral(b))
+    {
+        clash(a, "different values of a functional data property");
+        return;
+    }
+
+    // move the facts of the individual with fewer facts
+    size_t sizeA = mTypes[a].size() + mOutgoing[a].size() + mIncoming[a].size();
+    size_t sizeB = mTypes[b].size() + mOutgoing[b].size() + mIncoming[b].size();
+    Id representative = sizeA >= sizeB ? a : b;
+    Id merged = representative == a ? b : a;
+
+    for(Id klass : mTypes[merged])
+    {
+        conclusions.push_back(Fact::type(representative, klass));
+        IdList& instances = mInstances[klass];
+        IdList::iterator it = std::find(instances.begin(), instances.end(), merged);
+        *it = instances.back();
+        instances.pop_back();
+    }
+    mNumberOfTypes -= mTypes[merged].size();
+
+    for(const Edge& edge : mOutgoing[merged])
+    {
+        conclusions.push_back(Fact::relation(representative, edge.property, edge.node));
+        if(edge.node != merged)
+        {
+            EdgeList& incoming = mIncoming[edge.node];
+            EdgeList::iterator it = std::find(incoming.begin(), incoming.end(), Edge{edge.property, merged});
+            *it = incoming.back();
+            incoming.pop_back();
+        }
+    }
+    mNumberOfRelations -= mOutgoing[merged].size();
+
+    for(const Edge& edge : mIncoming[merged])
+    {
+        if(edge.node == merged)
+        {
+            continue;
+        }
+        conclusions.push_back(Fact::relation(edge.node, edge.property, representative));
+        EdgeList& outgoing = mOutgoing[edge.node];
+        outgoing.erase(std::lower_bound(outgoing.begin(), outgoing.end(), Edge{edge.property, merged}));
+        --mNumberOfRelations;
+    }
+
+    IdList().swap(mTypes[merged]);
+    EdgeList().swap(mOutgoing[merged]);
+    EdgeList().swap(mIncoming[merged]);
+
+    Id member = merged;
+    do
+    {
+        mRepresentatives[member] = representative;
+        member = mNext[member];
+    } while(member != merged);
+    std::swap(mNext[merged], mNext[representative]);
+    mHasEquality = true;
+}
+
+void RLMaterializer::insert(std::vector<Fact>& conclusions, std::vector<Fact>& delta)
+{
+    // merging moves facts, so it has to precede adding them
+    size_t numberOfConclusions = conclusions.size();
+    for(size_t i = 0; i < numberOfConclusions; ++i)
+    {
+        Fact fact = conclusions[i];
+        if(fact.kind == Fact::SAME)
+        {
+            merge(fact.subject, fact.object, conclusions);
+        } else if(fact.kind == Fact::CLASH)
+        {
+            clash(fact.subject, "contradicting facts");
+        }
+    }
+
+    for(Fact& fact : conclusions)
+    {
+        fact.subject = representative(fact.subject);
+        if(fact.kind == Fact::RELATION)
+        {
+            fact.object = representative(fact.object);
+        }
+    }
+    conclusions.erase(std::remove_if(conclusions.begin(), conclusions.end(), [](const Fact& fact)
+                {
+                    return fact.kind != Fact::TYPE && fact.kind != Fact::RELATION;
+                }), conclusions.end());
+    std::sort(conclusions.begin(), conclusions.end());
+    conclusions.erase(std::unique(conclusions.begin(), conclusions.end()), conclusions.end());
+
+    // the conclusions are grouped by individual and sorted like its types
+    // and relations, so that the new ones are merged into them at once
+    std::vector<Fact>::const_iterator begin = conclusions.begin();
+    while(begin != conclusions.end())
+    {
+        std::vector<Fact>::const_iterator end = begin;
+        while(end != conclusions.end() && end->kind == begin->kind && end->subject == begin->subject)
+        {
+            ++end;
+        }
+
+        Id x = begin->subject;
+        if(begin->kind == Fact::TYPE)
+        {
+            IdList& types = mTypes[x];
+            size_t size = types.size();
+            for(std::vector<Fact>::const_iterator it = begin; it != end; ++it)
+            {
+                if(!std::binary_search(types.begin(), types.begin() + size, it->object))
+                {
+                    types.push_back(it->object);
+                    mInstances[it->object].push_back(x);
+                    delta.push_back(*it);
+                }
+            }
+            std::inplace_merge(types.begin(), types.begin() + size, types.end());
+            mNumberOfTypes += types.size() - size;
+        } else {
+            EdgeList& edges = mOutgoing[x];
+            size_t size = edges.size();
+            for(std::vector<Fact>::const_iterator it = begin; it != end; ++it)
+            {
+                Edge edge{it->property, it->object};
+                if(!std::binary_search(edges.begin(), edges.begin() + size, edge))
+                {
+                    edges.push_back(edge);
+                    mIncoming[it->object].push_back(Edge{it->property, x});
+                    delta.push_back(*it);
+                }
+            }
+            std::inplace_merge(edges.begin(), edges.begin() + size, edges.end());
+            mNumberOfRelations += edges.size() - size;
+        }
+        begin = end;
+    }
+}
+
+void RLMaterializer::erase(std::vector<Fact>& facts)
+{
+    std::sort(facts.begin(), facts.end());
+
+    std::unordered_map<Id, IdList> removedInstances;
+    std::unordered_map<Id, EdgeList> removedIncoming;
+    std::vector<Fact>::const_iterator begin = facts.begin();
+    while(begin != facts.end())
+    {
+        std::vector<Fact>::const_iterator end = begin;
+        while(end != facts.end() && end->kind == begin->kind && end->subject == begin->subject)
+        {
+            ++end;
+        }
+
+        Id x = begin->subject;
+        if(begin->kind == Fact::TYPE)
+        {
+            IdList removed;
+            for(std::vector<Fact>::const_iterator it = begin; it != end; ++it)
+            {
+                removed.push_back(it->object);
+                removedInstances[it->object].push_back(x);
+            }
+            IdList& types = mTypes[x];
+            types.erase(std::remove_if(types.begin(), types.end(), [&removed](Id klass)
+                        {
+                            return std::binary_search(removed.begin(), removed.end(), klass);
+                        }), types.end());
+            mNumberOfTypes -= removed.size();
+        } else {
+            EdgeList removed;
+            for(std::vector<Fact>::const_iterator it = begin; it != end; ++it)
+            {
+                removed.push_back(Edge{it->property, it->object});
+                removedIncoming[it->object].push_back(Edge{it->property, x});
+            }
+            EdgeList& edges = mOutgoing[x];
+            edges.erase(std::remove_if(edges.begin(), edges.end(), [&removed](const Edge& edge)
+                        {
+                            return std::binary_search(removed.begin(), removed.end(), edge);
+                        }), edges.end());
+            mNumberOfRelations -= removed.size();
+        }
+        begin = end;
+    }
+
+    for(std::pair<const Id, IdList>& removed : removedInstances)
+    {
+        IdList& nodes = removed.second;
+        std::sort(nodes.begin(), nodes.end());
+        IdList& instances = mInstances[removed.first];
+        instances.erase(std::remove_if(instances.begin(), instances.end(), [&nodes](Id node)
+                    {
+                        return std::binary_search(nodes.begin(), nodes.end(), node);
+                    }), instances.end());
+    }
+
+    for(std::pair<const Id, EdgeList>& removed : removedIncoming)
+    {
+        EdgeList& edges = removed.second;
+        std::sort(edges.begin(), edges.end());
+        EdgeList& incoming = mIncoming[removed.first];
+        incoming.erase(std::remove_if(incoming.begin(), incoming.end(), [&edges](const Edge& edge)
+                    {
+                        return std::binary_search(edges.begin(), edges.end(), edge);
+                    }), incoming.end());
+    }
+}
+
+void RLMaterializer::saturate(std::vector<Fact>& conclusions)
+{
+    std::vector<Fact> delta;
+    while(mConsistent)
+    {
+        delta.clear();
+        insert(conclusions, delta);
+        if(delta.empty())
+        {
+            break;
+        }
+
+        conclusions.clear();
+        evaluate(delta, conclusions);
+    }
+}
+
+void RLMaterializer::retract(const std::vector<Fact>& facts)
+{
+    // overdelete all facts which might depend on a removed fact
+    std::unordered_set<Fact, FactHash> deleted;
+    std::vector<Fact> delta;
+    for(const Fact& fact : facts)
+    {
+        if(contains(fact) && deleted.insert(fact).second)
+        {
+            delta.push_back(fact);
+        }
+    }
+
+    std::vector<Fact> conclusions;
+    while(!delta.empty())
+    {
+        conclusions.clear();
+        evaluate(delta, conclusions);
+        delta.clear();
+        for(const Fact& conclusion : conclusions)
+        {
+            if(contains(conclusion) && deleted.insert(conclusion).second)
+            {
+                delta.push_back(conclusion);
+            }
+        }
+    }
+
+    std::vector<Fact> erased(deleted.begin(), deleted.end());
+    erase(erased);
+
+    // rederive: each rule has a premise which shares an individual with its
+    // conclusion, so that reapplying the rules to the remaining facts of the
+    // affected individuals restores the facts with an alternative derivation
+    IdList affected;
+    for(const Fact& fact : erased)
+    {
+        affected.push_back(fact.subject);
+        if(fact.kind == Fact::RELATION)
+        {
+            affected.push_back(fact.object);
+        }
+    }
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+
+    std::vector<Fact> remaining;
+    for(Id x : affected)
+    {
+        for(Id klass : mTypes[x])
+        {
+            remaining.push_back(Fact::type(x, klass));
+        }
+        for(const Edge& edge : mOutgoing[x])
+        {
+            remaining.push_back(Fact::relation(x, edge.property, edge.node));
+        }
+        for(const Edge& edge : mIncoming[x])
+        {
+            remaining.push_back(Fact::relation(edge.node, edge.property, x));
+        }
+    }
+
+    conclusions.clear();
+    evaluate(remaining, conclusions);
+    for(const Fact& fact : erased)
+    {
+        if(mAssertedFacts.count(fact))
+        {
+            conclusions.push_back(fact);
+        }
+    }
+
+    LOG_DEBUG_S << "owlapi::model::RLMaterializer::retract: overdeleted " << erased.size()
+        << " facts of " << affected.size() << " individuals";
+    saturate(conclusions);
+}
+
+IRIList RLMaterializer::getMembers(Id node) const
+{
+    IRIList members;
+    Id member = node;
+    do
+    {
+        members.push_back(mNodes[member]);
+        member = mNext[member];
+    } while(member != node);
+    return members;
+}
+
+IRIList RLMaterializer::getTypes(const IRI& individual) const
+{
+    IRIList types;
+    Id x = getIndividualId(individual);
+    if(x == INVALID_ID)
+    {
+        return types;
+    }
+
+    for(Id klass : mTypes[representative(x)])
+    {
+        if(!mClasses[klass].empty())
+        {
+            types.push_back(mClasses[klass]);
+        }
+    }
+    return types;
+}
+
+IRIList RLMaterializer::getInstances(const IRI& klass) const
+{
+    IRIList instances;
+    Id c = getClassId(klass);
+    if(c == INVALID_ID)
+    {
+        return instances;
+    }
+
+    for(Id x : mInstances[c])
+    {
+        if(!isLiteral(x))
+        {
+            IRIList members = getMembers(x);
+            instances.insert(instances.end(), members.begin(), members.end());
+        }
+    }
+    return instances;
+}
+
+bool RLMaterializer::isInstanceOf(const IRI& individual, const IRI& klass) const
+{
+    Id x = getIndividualId(individual);
+    Id c = getClassId(klass);
+    return x != INVALID_ID && c != INVALID_ID && hasType(representative(x), c);
+}
+
+IRIList RLMaterializer::getRelatedIndividuals(const IRI& individual, const IRI& property) const
+{
+    IRIList individuals;
+    Id x = getIndividualId(individual);
+    Id p = getPropertyId(property);
+    if(x == INVALID_ID || p == INVALID_ID || mPropertyRules[p].dataProperty)
+    {
+        return individuals;
+    }
+
+    std::pair<EdgeList::const_iterator, EdgeList::const_iterator> range = getRelations(representative(x), p);
+    for(EdgeList::const_iterator it = range.first; it != range.second; ++it)
+    {
+        IRIList members = getMembers(it->node);
+        individuals.insert(individuals.end(), members.begin(), members.end());
+    }
+    return individuals;
+}
+
+IRIList RLMaterializer::getInverseRelatedIndividuals(const IRI& individual, const IRI& property) const
+{
+    IRIList individuals;
+    Id x = getIndividualId(individual);
+    Id p = getPropertyId(property);
+    if(x == INVALID_ID || p == INVALID_ID || mPropertyRules[p].dataProperty)
+    {
+        return individuals;
+    }
+
+    for(const Edge& incoming : mIncoming[representative(x)])
+    {
+        if(incoming.property == p)
+        {
+            IRIList members = getMembers(incoming.node);
+            individuals.insert(individuals.end(), members.begin(), members.end());
+        }
+    }
+    return individuals;
+}
+
+bool RLMaterializer::isRelatedTo(const IRI& individual, const IRI& property, const IRI& otherIndividual) const
+{
+    Id x = getIndividualId(individual);
+    Id p = getPropertyId(property);
+    Id y = getIndividualId(otherIndividual);
+    return x != INVALID_ID && p != INVALID_ID && y != INVALID_ID
+        && hasRelation(representative(x), p, representative(y));
+}
+
+IRIList RLMaterializer::getSameIndividuals(const IRI& individual) const
+{
+    Id x = getIndividualId(individual);
+    if(x == INVALID_ID)
+    {
+        return IRIList(1, individual);
+    }
+    return getMembers(x);
+}
+
+uint64_t RLMaterializer::getMemoryUsage() const
+{
+    uint64_t bytes = memory::heapBytes(mUnsupportedReason)
+        + memory::heapBytes(mClassIds) + memory::heapBytes(mClasses)
+        + memory::heapBytes(mComplexClasses) + memory::heapBytes(mPropertyIds)
+        + memory::heapBytes(mProperties) + memory::heapBytes(mInverseProperties)
+        + memory::heapBytes(mToldSuperProperties) + memory::heapBytes(mIndividualIds)
+        + memory::heapBytes(mLiteralIds) + memory::heapBytes(mNodes)
+        + memory::heapBytes(mTypes) + memory::heapBytes(mOutgoing)
+        + memory::heapBytes(mIncoming) + memory::heapBytes(mInstances)
+        + memory::heapBytes(mRepresentatives) + memory::heapBytes(mNext)
+        + memory::heapBytes(mAssertedFacts) + memory::heapBytes(mPendingChanges);
+
+    bytes += mClassRules.capacity() * sizeof(ClassRules);
+    for(const ClassRules& rules : mClassRules)
+    {
+        bytes += memory::heapBytes(rules.superClasses)
+            + rules.conjunctions.capacity() * sizeof(Conjunction)
+            + memory::heapBytes(rules.someValuesFrom) + memory::heapBytes(rules.allValuesFrom)
+            + memory::heapBytes(rules.hasValue) + memory::heapBytes(rules.maxCardinality)
+            + memory::heapBytes(rules.maxCardinalityFiller) + memory::heapBytes(rules.disjointClasses);
+        for(const Conjunction& conjunction : rules.conjunctions)
+        {
+            bytes += memory::heapBytes(conjunction.operands);
+        }
+    }
+
+    bytes += mPropertyRules.capacity() * sizeof(PropertyRules);
+    for(const PropertyRules& rules : mPropertyRules)
+    {
+        bytes += memory::heapBytes(rules.superProperties) + memory::heapBytes(rules.inverseProperties)
+            + memory::heapBytes(rules.disjointProperties) + memory::heapBytes(rules.domains)
+            + memory::heapBytes(rules.ranges) + memory::heapBytes(rules.someValuesFrom)
+            + memory::heapBytes(rules.hasValue) + memory::heapBytes(rules.allValuesFrom)
+            + memory::heapBytes(rules.maxCardinality);
+    }
+    return bytes;
+}
+
+} // end namespace model
+} // end namespace owlapi
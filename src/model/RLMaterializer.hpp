@@ -0,0 +1,431 @@
+#ifndef OWLAPI_MODEL_RL_MATERIALIZER_HPP
+#define OWLAPI_MODEL_RL_MATERIALIZER_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "OWLOntology.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class RLMaterializer
+ * \brief Forward-chaining materialization of the ABox of an ontology with
+ * the rules of OWL 2 RL
+ * \details The class and property axioms are compiled into rules, which are
+ * applied to the asserted types and relations of all individuals until
+ * no new fact can be derived. Evaluation is semi-naive and proceeds in
+ * rounds: the facts derived in one round are joined against all known facts
+ * in the next, where each round is evaluated by several threads.
+ *
+ * Individuals, classes and properties are mapped to dense ids. Each
+ * individual has a sorted array of types and a sorted array of outgoing
+ * relations, and each class an array of instances, so that type and
+ * relation queries are answered without the reasoner.
+ *
+ * Changes of assertions are queued, \see enqueue, and applied
+ * incrementally on the next update: additions are propagated from the new
+ * facts only, removals by deleting all facts which depend on a removed fact
+ * and rederiving those which have an alternative derivation (DRed). Any
+ * other change requires a new materialization.
+ *
+ * Supported are, on the subclass side, intersections, unions, existential
+ * restrictions, hasValue restrictions and enumerations of individuals, and,
+ * on the superclass side, intersections, complements, universal
+ * restrictions, hasValue restrictions and max cardinalities of 0 and 1.
+ * Property axioms are limited to hierarchies, domains and ranges, inverse,
+ * symmetric, transitive, functional, inverse functional, irreflexive and
+ * asymmetric properties, and disjoint properties. Individuals which follow
+ * to be the same are merged, literals are compared by their lexical form.
+ * Ontologies with other axioms are not supported.
+ *
+ * OWLOntologyAsk selects this materialization automatically to answer the
+ * type and relation queries of supported ontologies.
+ *
+ * \see https://www.w3.org/TR/owl2-profiles/#OWL_2_RL
+ */
+class RLMaterializer
+{
+public:
+    typedef shared_ptr<RLMaterializer> Ptr;
+    typedef uint32_t Id;
+
+    /**
+     * \param numberOfThreads Number of threads, 0 to use the number of
+     * hardware threads
+     */
+    RLMaterializer(size_t numberOfThreads = 0);
+
+    size_t getNumberOfThreads() const { return mNumberOfThreads; }
+
+    /**
+     * Check if a change of the axiom can affect the materialization
+     */
+    static bool isRelevant(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Compile the axioms of the ontology and materialize all of its
+     * assertions
+     * \return false if the ontology is not supported,
+     * \see getUnsupportedReason
+     */
+    bool materialize(const OWLOntology::Ptr& ontology);
+
+    /**
+     * Get the reason why the last materialization failed
+     */
+    const std::string& getUnsupportedReason() const { return mUnsupportedReason; }
+
+    /**
+     * Queue the addition or removal of an axiom, which is applied with the
+     * next update
+     * \return false if the change cannot be applied incrementally, so that a
+     * new materialization is required
+     */
+    bool enqueue(const OWLAxiom::Ptr& axiom, bool added);
+
+    /**
+     * Check if there are changes which have not been applied yet
+     */
+    bool hasPendingChanges() const { return !mPendingChanges.empty(); }
+
+    /**
+     * Apply all queued changes
+     * \return false if the changes cannot be applied incrementally, so that
+     * a new materialization is required
+     */
+    bool update();
+
+    /**
+     * Check whether no contradiction has been derived, e.g. an instance of
+     * two disjoint classes
+     */
+    bool isConsistent() const { return mConsistent; }
+
+    /**
+     * Get all types of an individual, including owl:Thing
+     */
+    IRIList getTypes(const IRI& individual) const;
+
+    /**
+     * Get all instances of a class
+     */
+    IRIList getInstances(const IRI& klass) const;
+
+    bool isInstanceOf(const IRI& individual, const IRI& klass) const;
+
+    /**
+     * Get all individuals the individual is related to via the property
+     */
+    IRIList getRelatedIndividuals(const IRI& individual, const IRI& property) const;
+
+    /**
+     * Get all individuals which are related to the individual via the
+     * property
+     */
+    IRIList getInverseRelatedIndividuals(const IRI& individual, const IRI& property) const;
+
+    bool isRelatedTo(const IRI& individual, const IRI& property, const IRI& otherIndividual) const;
+
+    /**
+     * Get the individuals which have been merged with the individual, due
+     * to functional properties or max cardinalities
+     * \return list of individuals, including the individual itself
+     */
+    IRIList getSameIndividuals(const IRI& individual) const;
+
+    /**
+     * Get the number of (inferred and asserted) types of all individuals
+     */
+    size_t getNumberOfTypes() const { return mNumberOfTypes; }
+
+    /**
+     * Get the number of (inferred and asserted) relations of all
+     * individuals
+     */
+    size_t getNumberOfRelations() const { return mNumberOfRelations; }
+
+    /**
+     * Get the estimated heap memory of the rules and of the materialized facts
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    /// Type of an individual, relation between two individuals (or an
+    /// individual and a literal), sameness of two individuals or
+    /// contradiction
+    struct Fact
+    {
+        enum Kind { SAME, CLASH, TYPE, RELATION };
+
+        uint32_t kind;
+        Id subject;
+        Id property;
+        Id object;
+
+        static Fact type(Id individual, Id klass) { return Fact{TYPE, individual, 0, klass}; }
+        static Fact relation(Id subject, Id property, Id object) { return Fact{RELATION, subject, property, object}; }
+        static Fact same(Id individual, Id otherIndividual) { return Fact{SAME, individual, 0, otherIndividual}; }
+        static Fact clash(Id individual) { return Fact{CLASH, individual, 0, 0}; }
+
+        bool operator<(const Fact& other) const
+        {
+            if(kind != other.kind) return kind < other.kind;
+            if(subject != other.subject) return subject < other.subject;
+            if(property != other.property) return property < other.property;
+            return object < other.object;
+        }
+
+        bool operator==(const Fact& other) const
+        {
+            return kind == other.kind && subject == other.subject
+                && property == other.property && object == other.object;
+        }
+    };
+
+    struct FactHash
+    {
+        size_t operator()(const Fact& fact) const
+        {
+            uint64_t h = (uint64_t(fact.subject) << 32) ^ (uint64_t(fact.object) << 2) ^ fact.kind;
+            return std::hash<uint64_t>()(h * 0x9E3779B97F4A7C15ULL + fact.property);
+        }
+    };
+
+    /// Relation to another individual (or literal) via a property
+    struct Edge
+    {
+        Id property;
+        Id node;
+
+        bool operator<(const Edge& other) const
+        {
+            return property < other.property ||
+                (property == other.property && node < other.node);
+        }
+
+        bool operator==(const Edge& other) const
+        {
+            return property == other.property && node == other.node;
+        }
+    };
+
+    typedef std::vector<Id> IdList;
+    typedef std::vector<Edge> EdgeList;
+    typedef std::vector< std::pair<Id, Id> > IdPairs;
+
+    /// C1 ⊓ ... ⊓ Cn ⊑ D
+    struct Conjunction
+    {
+        IdList operands;
+        Id result;
+    };
+
+    /// Rules which are triggered by a type
+    struct ClassRules
+    {
+        /// A ⊑ B
+        IdList superClasses;
+        /// A ⊓ ... ⊑ B
+        std::vector<Conjunction> conjunctions;
+        /// (p, B) for ∃p.A ⊑ B
+        IdPairs someValuesFrom;
+        /// (p, B) for A ⊑ ∀p.B
+        IdPairs allValuesFrom;
+        /// (p, a) for A ⊑ ∃p.{a}
+        IdPairs hasValue;
+        /// (p, F) for A ⊑ ≤1 p.F
+        IdPairs maxCardinality;
+        /// (p, B) for B ⊑ ≤1 p.A
+        IdPairs maxCardinalityFiller;
+        /// A ⊓ B ⊑ ⊥
+        IdList disjointClasses;
+    };
+
+    /// Rules which are triggered by a relation
+    struct PropertyRules
+    {
+        bool dataProperty;
+        bool transitive;
+        bool irreflexive;
+        bool asymmetric;
+        /// Strict superproperties
+        IdList superProperties;
+        IdList inverseProperties;
+        IdList disjointProperties;
+        IdList domains;
+        IdList ranges;
+        /// (A, B) for ∃p.A ⊑ B
+        IdPairs someValuesFrom;
+        /// (a, B) for ∃p.{a} ⊑ B
+        IdPairs hasValue;
+        /// (A, B) for A ⊑ ∀p.B
+        IdPairs allValuesFrom;
+        /// (A, F) for A ⊑ ≤1 p.F
+        IdPairs maxCardinality;
+
+        PropertyRules()
+            : dataProperty(false)
+            , transitive(false)
+            , irreflexive(false)
+            , asymmetric(false)
+        {}
+    };
+
+    static const Id INVALID_ID = 0xFFFFFFFF;
+    static const Id THING = 0;
+    static const Id NOTHING = 1;
+
+    void clear();
+
+    Id getOrCreateClassId(const IRI& klass);
+    Id getOrCreatePropertyId(const IRI& property, bool dataProperty);
+    Id getOrCreateIndividualId(const IRI& individual);
+    Id getOrCreateLiteralId(const OWLLiteral::Ptr& literal);
+    Id createClass();
+    Id createProperty(const IRI& property, bool dataProperty);
+    Id createNode(const IRI& iri);
+
+    Id getClassId(const IRI& klass) const;
+    Id getPropertyId(const IRI& property) const;
+    Id getIndividualId(const IRI& individual) const;
+
+    /**
+     * Add an axiom to the rules or to the asserted facts
+     * \return false if the axiom is not supported
+     */
+    bool addAxiom(const OWLAxiom::Ptr& axiom);
+
+    /**
+     * Get the asserted facts of an assertion or declaration
+     * \param compile If true, class assertions of anonymous classes are
+     * compiled into rules
+     * \return false if the axiom is not supported
+     */
+    bool getAssertedFacts(const OWLAxiom::Ptr& axiom, bool compile, std::vector<Fact>& facts);
+
+    bool unsupported(const std::string& reason);
+
+    Id property(const OWLPropertyExpression::Ptr& property, bool dataProperty);
+    Id inverse(Id property);
+    Id individual(const OWLIndividual::Ptr& individual);
+    IdList subClasses(const OWLClassExpression::PtrList& expressions);
+    /// Class which holds for all instances of the expression as subclass
+    Id subClass(const OWLClassExpression::Ptr& expression);
+    /// Class whose instances are instances of the expression as superclass
+    Id superClass(const OWLClassExpression::Ptr& expression);
+    /// Add A ⊑ C for the superclass expression C
+    void subsumes(Id klass, const OWLClassExpression::Ptr& expression);
+    /// Get or create the class of a subclass expression by its structure
+    bool complex(const std::string& key, Id& klass);
+    void disjoint(Id klass, Id otherClass);
+    void allValuesFrom(Id klass, Id property, Id filler);
+    void maxCardinality(Id klass, Id property, Id filler);
+    void finishRules();
+
+    Id representative(Id node) const { return mRepresentatives[node]; }
+    bool isLiteral(Id node) const { return mNodes[node].empty(); }
+    bool hasType(Id node, Id klass) const;
+    /// Check the type, where every node is considered to be an owl:Thing
+    bool holds(Id node, Id klass) const { return klass == THING || hasType(node, klass); }
+    bool hasRelation(Id subject, Id property, Id object) const;
+    bool contains(const Fact& fact) const;
+    std::pair<EdgeList::const_iterator, EdgeList::const_iterator> getRelations(Id node, Id property) const;
+
+    /**
+     * Derive that all fillers of the property which are instances of the
+     * filler class are the same as the given one
+     */
+    void sameFillers(Id node, Id property, Id filler, Id individual, std::vector<Fact>& conclusions) const;
+
+    /**
+     * Apply the rules to a single fact
+     */
+    void evaluate(const Fact& fact, std::vector<Fact>& conclusions) const;
+
+    /**
+     * Apply the rules to facts, using multiple threads for large sets
+     */
+    void evaluate(const std::vector<Fact>& facts, std::vector<Fact>& conclusions) const;
+
+    /**
+     * Add conclusions which are not known yet
+     * \param delta Receives the added facts
+     */
+    void insert(std::vector<Fact>& conclusions, std::vector<Fact>& delta);
+
+    /**
+     * Remove known facts
+     */
+    void erase(std::vector<Fact>& facts);
+
+    /**
+     * Merge two individuals and move the facts of the merged one to the
+     * representative
+     */
+    void merge(Id node, Id otherNode, std::vector<Fact>& conclusions);
+
+    void clash(Id node, const std::string& reason);
+
+    /**
+     * Add conclusions and derive all consequences
+     */
+    void saturate(std::vector<Fact>& conclusions);
+
+    /**
+     * Remove facts and all consequences which cannot be rederived
+     */
+    void retract(const std::vector<Fact>& facts);
+
+    IRIList getMembers(Id node) const;
+
+    size_t mNumberOfThreads;
+
+    std::string mUnsupportedReason;
+    bool mConsistent;
+    bool mHasEquality;
+
+    std::unordered_map<IRI, Id> mClassIds;
+    /// Names of classes, empty for auxiliary classes
+    IRIList mClasses;
+    std::vector<ClassRules> mClassRules;
+    std::unordered_map<std::string, Id> mComplexClasses;
+
+    std::unordered_map<IRI, Id> mPropertyIds;
+    /// Names of properties, empty for inverse properties
+    IRIList mProperties;
+    std::vector<PropertyRules> mPropertyRules;
+    std::unordered_map<Id, Id> mInverseProperties;
+    std::vector<IdList> mToldSuperProperties;
+
+    std::unordered_map<IRI, Id> mIndividualIds;
+    std::unordered_map<std::string, Id> mLiteralIds;
+    /// Names of individuals, empty for literals
+    IRIList mNodes;
+    /// Sorted types of each individual
+    std::vector<IdList> mTypes;
+    /// Sorted relations of each individual
+    std::vector<EdgeList> mOutgoing;
+    /// Inverse relations of each individual
+    std::vector<EdgeList> mIncoming;
+    /// Instances of each class
+    std::vector<IdList> mInstances;
+    /// Representative of the merged individuals
+    std::vector<Id> mRepresentatives;
+    /// Circular list linking the merged individuals
+    std::vector<Id> mNext;
+
+    size_t mNumberOfTypes;
+    size_t mNumberOfRelations;
+
+    /// Number of assertions of each asserted fact
+    std::unordered_map<Fact, size_t, FactHash> mAssertedFacts;
+    std::vector< std::pair<OWLAxiom::Ptr, bool> > mPendingChanges;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_RL_MATERIALIZER_HPP
@@ -10,6 +10,7 @@ class RemoveAxiom : public OWLAxiomChange
 {
 public:
     RemoveAxiom(const OWLOntology::Ptr& ontology, const OWLAxiom::Ptr& e);
+    bool isAddAxiom() const { return false; }
     bool isRemoveAxiom() const { return true; }
 
     ChangeApplied accept(const OWLOntologyChangeVisitor::Ptr& visitor);
@@ -0,0 +1,124 @@
+#include "SameAsIndex.hpp"
+#include "MemoryUsage.hpp"
+
+namespace owlapi {
+namespace model {
+
+void SameAsIndex::clear()
+{
+    mIds.clear();
+    mIRIs.clear();
+    mParents.clear();
+    mRanks.clear();
+    mNext.clear();
+}
+
+size_t SameAsIndex::getOrCreateId(const IRI& individual)
+{
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIds.find(individual);
+    if(cit != mIds.end())
+    {
+        return cit->second;
+    }
+
+    size_t id = mIRIs.size();
+    mIds[individual] = id;
+    mIRIs.push_back(individual);
+    mParents.push_back(id);
+    mRanks.push_back(0);
+    mNext.push_back(id);
+    return id;
+}
+
+size_t SameAsIndex::find(size_t id) const
+{
+    size_t root = id;
+    while(mParents[root] != root)
+    {
+        root = mParents[root];
+    }
+
+    while(mParents[id] != root)
+    {
+        size_t parent = mParents[id];
+        mParents[id] = root;
+        id = parent;
+    }
+    return root;
+}
+
+void SameAsIndex::merge(const IRI& individual, const IRI& otherIndividual)
+{
+    size_t root = find( getOrCreateId(individual) );
+    size_t otherRoot = find( getOrCreateId(otherIndividual) );
+    if(root == otherRoot)
+    {
+        return;
+    }
+
+    if(mRanks[root] < mRanks[otherRoot])
+    {
+        std::swap(root, otherRoot);
+    }
+    mParents[otherRoot] = root;
+    if(mRanks[root] == mRanks[otherRoot])
+    {
+        ++mRanks[root];
+    }
+    // splice both circular member lists
+    std::swap(mNext[root], mNext[otherRoot]);
+}
+
+bool SameAsIndex::isSame(const IRI& individual, const IRI& otherIndividual) const
+{
+    if(individual == otherIndividual)
+    {
+        return true;
+    }
+
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIds.find(individual);
+    std::unordered_map<IRI, size_t>::const_iterator oit = mIds.find(otherIndividual);
+    if(cit == mIds.end() || oit == mIds.end())
+    {
+        return false;
+    }
+    return find(cit->second) == find(oit->second);
+}
+
+const IRI& SameAsIndex::getRepresentative(const IRI& individual) const
+{
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIds.find(individual);
+    if(cit == mIds.end())
+    {
+        return individual;
+    }
+    return mIRIs[ find(cit->second) ];
+}
+
+IRIList SameAsIndex::getSameAs(const IRI& individual) const
+{
+    IRIList members;
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIds.find(individual);
+    if(cit == mIds.end())
+    {
+        members.push_back(individual);
+        return members;
+    }
+
+    size_t id = cit->second;
+    do
+    {
+        members.push_back(mIRIs[id]);
+        id = mNext[id];
+    } while(id != cit->second);
+    return members;
+}
+
+uint64_t SameAsIndex::getMemoryUsage() const
+{
+    return memory::heapBytes(mIds) + memory::heapBytes(mIRIs) + memory::heapBytes(mParents)
+        + memory::heapBytes(mRanks) + memory::heapBytes(mNext);
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,85 @@
+#ifndef OWLAPI_MODEL_SAME_AS_INDEX_HPP
+#define OWLAPI_MODEL_SAME_AS_INDEX_HPP
+
+#include <unordered_map>
+#include <vector>
+#include "IRI.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class SameAsIndex
+ * \brief Disjoint-set (union-find) index over individuals which are known to
+ * refer to the same
+ * \details Merging and lookup are nearly constant time (path compression and
+ * union by rank), enumeration of an equivalence class is linear in its size.
+ * Since entries cannot be split again, the index has to be cleared and
+ * rebuilt when a sameness statement is removed.
+ */
+class SameAsIndex
+{
+public:
+    /**
+     * Clear the index
+     */
+    void clear();
+
+    /**
+     * Register that two individuals refer to the same
+     */
+    void merge(const IRI& individual, const IRI& otherIndividual);
+
+    /**
+     * Test if two individuals are known to refer to the same
+     * \return true if both are in the same equivalence class, false otherwise
+     * (including when one of them is unknown to the index)
+     */
+    bool isSame(const IRI& individual, const IRI& otherIndividual) const;
+
+    /**
+     * Get the representative of the equivalence class of an individual
+     * \return representative, or the individual itself if it is unknown to
+     * the index
+     */
+    const IRI& getRepresentative(const IRI& individual) const;
+
+    /**
+     * Get all members of the equivalence class of an individual
+     * \return list of members, including the individual itself
+     */
+    IRIList getSameAs(const IRI& individual) const;
+
+    /**
+     * Check if the individual is known to the index
+     */
+    bool contains(const IRI& individual) const { return mIds.count(individual); }
+
+    /**
+     * Get the number of individuals in the index
+     */
+    size_t size() const { return mIRIs.size(); }
+
+    /**
+     * Get the estimated heap memory of the index
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    size_t getOrCreateId(const IRI& individual);
+
+    size_t find(size_t id) const;
+
+    std::unordered_map<IRI, size_t> mIds;
+    IRIList mIRIs;
+    /// Parent of each entry, updated by path compression
+    mutable std::vector<size_t> mParents;
+    std::vector<size_t> mRanks;
+    /// Circular list linking all members of an equivalence class
+    std::vector<size_t> mNext;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_SAME_AS_INDEX_HPP
@@ -0,0 +1,629 @@
+#include "SyntacticLocalityModuleExtractor.hpp"
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include "OWLOntologyTell.hpp"
+#include "OWLAxiomVisitor.hpp"
+#include "OWLAxiomSignatureVisitor.hpp"
+#include "OWLCardinalityRestriction.hpp"
+#include "OWLInverseObjectProperty.hpp"
+#include "OWLNaryBooleanExpression.hpp"
+#include "OWLObjectComplementOf.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLDisjointObjectPropertiesAxiom.hpp"
+#include "OWLDisjointDataPropertiesAxiom.hpp"
+#include "OWLEquivalentDataPropertiesAxiom.hpp"
+#include "../KnowledgeBase.hpp"
+#include "../vocabularies/OWL.hpp"
+
+namespace owlapi {
+namespace model {
+
+namespace {
+
+/**
+ * Evaluates the syntactic locality of axioms, i.e. whether an axiom is a
+ * tautology once all entities outside the signature are replaced by bottom
+ * (BOT) or top (TOP)
+ */
+class LocalityEvaluator : public OWLAxiomVisitor
+{
+public:
+    LocalityEvaluator(const SyntacticLocalityModuleExtractor::Signature& signature,
+            SyntacticLocalityModuleExtractor::ModuleType type)
+        : mSignature(signature)
+        , mBottom(type == SyntacticLocalityModuleExtractor::BOT)
+        , mLocal(false)
+    {}
+
+    virtual ~LocalityEvaluator() {}
+
+    bool isLocal(const OWLAxiom::Ptr& axiom)
+    {
+        // unsupported axioms are non-local
+        mLocal = false;
+        switch(axiom->getAxiomType())
+        {
+            case OWLAxiom::DisjointObjectProperties:
+            {
+                OWLObjectPropertyExpression::PtrList properties = dynamic_pointer_cast<OWLDisjointObjectPropertiesAxiom>(axiom)->getProperties();
+                return mBottom && countInSignature(properties) <= 1;
+            }
+            case OWLAxiom::DisjointDataProperties:
+            {
+                OWLDataPropertyExpression::PtrList properties = dynamic_pointer_cast<OWLDisjointDataPropertiesAxiom>(axiom)->getProperties();
+                return mBottom && countInSignature(properties) <= 1;
+            }
+            case OWLAxiom::EquivalentDataProperties:
+            {
+                OWLDataPropertyExpression::PtrList properties = dynamic_pointer_cast<OWLEquivalentDataPropertiesAxiom>(axiom)->getProperties();
+                return countInSignature(properties) == 0;
+            }
+            default:
+                axiom->accept(this);
+                return mLocal;
+        }
+    }
+
+    /**
+     * Check if the class expression is equivalent to owl:Nothing after the
+     * replacement
+     */
+    bool isBottom(const OWLClassExpression::Ptr& klass) const
+    {
+        if(!klass)
+        {
+            // unqualified restriction
+            return false;
+        }
+
+        switch(klass->getClassExpressionType())
+        {
+            case OWLClassExpression::OWL_CLASS:
+            {
+                const IRI& iri = dynamic_pointer_cast<OWLClass>(klass)->getIRI();
+                if(iri == vocabulary::OWL::Nothing())
+                {
+                    return true;
+                } else if(iri == vocabulary::OWL::Thing())
+                {
+                    return false;
+                }
+                return mBottom && !mSignature.count(iri);
+            }
+            case OWLClassExpression::OBJECT_COMPLEMENT_OF:
+                return isTop(dynamic_pointer_cast<OWLObjectComplementOf>(klass)->getOperand());
+            case OWLClassExpression::OBJECT_INTERSECTION_OF:
+                for(const OWLClassExpression::Ptr& operand : dynamic_pointer_cast<OWLNaryBooleanExpression>(klass)->getOperands())
+                {
+                    if(isBottom(operand))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            case OWLClassExpression::OBJECT_UNION_OF:
+                for(const OWLClassExpression::Ptr& operand : dynamic_pointer_cast<OWLNaryBooleanExpression>(klass)->getOperands())
+                {
+                    if(!isBottom(operand))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+                return isBottomProperty(klass) || isBottom(getFiller(klass));
+            case OWLClassExpression::OBJECT_MIN_CARDINALITY:
+            case OWLClassExpression::OBJECT_EXACT_CARDINALITY:
+                return getCardinality(klass) > 0 && (isBottomProperty(klass) || isBottom(getFiller(klass)));
+            case OWLClassExpression::OBJECT_ALL_VALUES_FROM:
+                return isTopProperty(klass) && isBottom(getFiller(klass));
+            case OWLClassExpression::OBJECT_HAS_VALUE:
+            case OWLClassExpression::OBJECT_HAS_SELF:
+            case OWLClassExpression::DATA_SOME_VALUES_FROM:
+            case OWLClassExpression::DATA_HAS_VALUE:
+                return isBottomProperty(klass);
+            case OWLClassExpression::DATA_MIN_CARDINALITY:
+            case OWLClassExpression::DATA_EXACT_CARDINALITY:
+                return getCardinality(klass) > 0 && isBottomProperty(klass);
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Check if the class expression is equivalent to owl:Thing after the
+     * replacement
+     */
+    bool isTop(const OWLClassExpression::Ptr& klass) const
+    {
+        if(!klass)
+        {
+            // unqualified restriction
+            return true;
+        }
+
+        switch(klass->getClassExpressionType())
+        {
+            case OWLClassExpression::OWL_CLASS:
+            {
+                const IRI& iri = dynamic_pointer_cast<OWLClass>(klass)->getIRI();
+                if(iri == vocabulary::OWL::Thing())
+                {
+                    return true;
+                } else if(iri == vocabulary::OWL::Nothing())
+                {
+                    return false;
+                }
+                return !mBottom && !mSignature.count(iri);
+            }
+            case OWLClassExpression::OBJECT_COMPLEMENT_OF:
+                return isBottom(dynamic_pointer_cast<OWLObjectComplementOf>(klass)->getOperand());
+            case OWLClassExpression::OBJECT_INTERSECTION_OF:
+                for(const OWLClassExpression::Ptr& operand : dynamic_pointer_cast<OWLNaryBooleanExpression>(klass)->getOperands())
+                {
+                    if(!isTop(operand))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            case OWLClassExpression::OBJECT_UNION_OF:
+                for(const OWLClassExpression::Ptr& operand : dynamic_pointer_cast<OWLNaryBooleanExpression>(klass)->getOperands())
+                {
+                    if(isTop(operand))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            case OWLClassExpression::OBJECT_ALL_VALUES_FROM:
+                return isBottomProperty(klass) || isTop(getFiller(klass));
+            case OWLClassExpression::OBJECT_MAX_CARDINALITY:
+                return isBottomProperty(klass) || isBottom(getFiller(klass));
+            case OWLClassExpression::OBJECT_SOME_VALUES_FROM:
+                return isTopProperty(klass) && isTop(getFiller(klass));
+            case OWLClassExpression::OBJECT_MIN_CARDINALITY:
+            {
+                uint32_t cardinality = getCardinality(klass);
+                return cardinality == 0 || (cardinality == 1 && isTopProperty(klass) && isTop(getFiller(klass)));
+            }
+            case OWLClassExpression::OBJECT_HAS_VALUE:
+            case OWLClassExpression::OBJECT_HAS_SELF:
+                return isTopProperty(klass);
+            case OWLClassExpression::DATA_ALL_VALUES_FROM:
+            case OWLClassExpression::DATA_MAX_CARDINALITY:
+                return isBottomProperty(klass);
+            case OWLClassExpression::DATA_MIN_CARDINALITY:
+                return getCardinality(klass) == 0;
+            default:
+                return false;
+        }
+    }
+
+    void visit(const OWLDeclarationAxiom&) { mLocal = true; }
+    void visit(const OWLClassAxiom&) { mLocal = false; }
+    void visit(const OWLObjectPropertyAxiom&) { mLocal = false; }
+    void visit(const OWLDataPropertyAxiom&) { mLocal = false; }
+
+    void visit(const OWLSubClassOfAxiom& axiom)
+    {
+        mLocal = isBottom(axiom.getSubClass()) || isTop(axiom.getSuperClass());
+    }
+
+    void visit(const OWLEquivalentClassesAxiom& axiom)
+    {
+        const OWLClassExpression::PtrList& klasses = axiom.getEquivalentClasses();
+        mLocal = std::all_of(klasses.begin(), klasses.end(), [this](const OWLClassExpression::Ptr& k) { return isBottom(k); })
+            || std::all_of(klasses.begin(), klasses.end(), [this](const OWLClassExpression::Ptr& k) { return isTop(k); });
+    }
+
+    void visit(const OWLDisjointClassesAxiom& axiom)
+    {
+        // at most one class can remain satisfiable
+        const OWLClassExpression::PtrList& klasses = axiom.getClassExpressions();
+        mLocal = std::count_if(klasses.begin(), klasses.end(), [this](const OWLClassExpression::Ptr& k) { return !isBottom(k); }) <= 1;
+    }
+
+    void visit(const OWLDisjointUnionAxiom& axiom)
+    {
+        const OWLClassExpression::PtrList& klasses = axiom.getClassExpressions();
+        size_t bottom = std::count_if(klasses.begin(), klasses.end(), [this](const OWLClassExpression::Ptr& k) { return isBottom(k); });
+        if(mBottom)
+        {
+            mLocal = isBottom(axiom.getOWLClass()) && bottom == klasses.size();
+        } else {
+            // exactly one of the disjoint classes is top
+            mLocal = isTop(axiom.getOWLClass()) && bottom + 1 == klasses.size()
+                && std::any_of(klasses.begin(), klasses.end(), [this](const OWLClassExpression::Ptr& k) { return isTop(k); });
+        }
+    }
+
+    void visit(const OWLEquivalentObjectPropertiesAxiom& axiom)
+    {
+        mLocal = countInSignature(axiom.getProperties()) == 0;
+    }
+
+    void visit(const OWLSubObjectPropertyOfAxiom& axiom)
+    {
+        mLocal = mBottom ? !contains(axiom.getSubProperty()) : !contains(axiom.getSuperProperty());
+    }
+
+    void visit(const OWLObjectPropertyDomainAxiom& axiom)
+    {
+        mLocal = isTop(axiom.getDomain()) || (mBottom && !contains(axiom.getProperty()));
+    }
+
+    void visit(const OWLObjectPropertyRangeAxiom& axiom)
+    {
+        mLocal = isTop(axiom.getRange()) || (mBottom && !contains(axiom.getProperty()));
+    }
+
+    void visit(const OWLInverseObjectPropertiesAxiom& axiom)
+    {
+        mLocal = !contains(axiom.getFirstProperty()) && !contains(axiom.getSecondProperty());
+    }
+
+    void visit(const OWLFunctionalObjectPropertyAxiom& axiom) { mLocal = mBottom && !contains(axiom.getProperty()); }
+    void visit(const OWLInverseFunctionalObjectPropertyAxiom& axiom) { mLocal = mBottom && !contains(axiom.getProperty()); }
+    void visit(const OWLReflexiveObjectPropertyAxiom& axiom) { mLocal = !mBottom && !contains(axiom.getProperty()); }
+    void visit(const OWLIrreflexiveObjectPropertyAxiom& axiom) { mLocal = mBottom && !contains(axiom.getProperty()); }
+    void visit(const OWLSymmetricObjectPropertyAxiom& axiom) { mLocal = !contains(axiom.getProperty()); }
+    void visit(const OWLAsymmetricObjectPropertyAxiom& axiom) { mLocal = mBottom && !contains(axiom.getProperty()); }
+    void visit(const OWLTransitiveObjectPropertyAxiom& axiom) { mLocal = !contains(axiom.getProperty()); }
+
+    void visit(const OWLSubDataPropertyOfAxiom& axiom)
+    {
+        mLocal = mBottom ? !contains(axiom.getSubProperty()) : !contains(axiom.getSuperProperty());
+    }
+
+    void visit(const OWLFunctionalDataPropertyAxiom& axiom) { mLocal = mBottom && !contains(axiom.getProperty()); }
+
+    void visit(const OWLDataPropertyDomainAxiom& axiom)
+    {
+        mLocal = isTop(axiom.getDomain()) || (mBottom && !contains(axiom.getProperty()));
+    }
+
+    void visit(const OWLDataPropertyRangeAxiom& axiom) { mLocal = mBottom && !contains(axiom.getProperty()); }
+
+    void visit(const OWLClassAssertionAxiom& axiom) { mLocal = isTop(axiom.getClassExpression()); }
+    void visit(const OWLObjectPropertyAssertionAxiom& axiom) { mLocal = !mBottom && !contains(axiom.getProperty()); }
+    void visit(const OWLDataPropertyAssertionAxiom& axiom) { mLocal = !mBottom && !contains(axiom.getProperty()); }
+
+    // Annotations do not affect the logical entailments
+    void visit(const OWLSubAnnotationPropertyOfAxiom&) { mLocal = true; }
+    void visit(const OWLAnnotationPropertyDomainAxiom&) { mLocal = true; }
+    void visit(const OWLAnnotationPropertyRangeAxiom&) { mLocal = true; }
+    void visit(const OWLAnnotationAssertionAxiom&) { mLocal = true; }
+
+private:
+    /**
+     * Check if the (named) property is part of the signature, unknown
+     * property expressions are considered to be part of the signature
+     */
+    bool contains(const OWLPropertyExpression::Ptr& property) const
+    {
+        OWLProperty::Ptr namedProperty = dynamic_pointer_cast<OWLProperty>(property);
+        if(namedProperty)
+        {
+            return mSignature.count(namedProperty->getIRI());
+        }
+
+        shared_ptr<OWLInverseObjectProperty> inverseProperty = dynamic_pointer_cast<OWLInverseObjectProperty>(property);
+        if(inverseProperty)
+        {
+            return contains(inverseProperty->getInverse());
+        }
+        return true;
+    }
+
+    template<typename T>
+    size_t countInSignature(const std::vector<T>& properties) const
+    {
+        return std::count_if(properties.begin(), properties.end(), [this](const T& p) { return contains(p); });
+    }
+
+    OWLPropertyExpression::Ptr getProperty(const OWLClassExpression::Ptr& restriction) const
+    {
+        OWLObjectRestriction::Ptr objectRestriction = dynamic_pointer_cast<OWLObjectRestriction>(restriction);
+        if(objectRestriction)
+        {
+            return objectRestriction->getProperty();
+        }
+
+        OWLDataRestriction::Ptr dataRestriction = dynamic_pointer_cast<OWLDataRestriction>(restriction);
+        if(dataRestriction)
+        {
+            return dataRestriction->getProperty();
+        }
+        return OWLPropertyExpression::Ptr();
+    }
+
+    /// The property of the restriction is replaced by the empty property
+    bool isBottomProperty(const OWLClassExpression::Ptr& restriction) const
+    {
+        return mBottom && !contains(getProperty(restriction));
+    }
+
+    /// The property of the restriction is replaced by the universal property
+    bool isTopProperty(const OWLClassExpression::Ptr& restriction) const
+    {
+        return !mBottom && !contains(getProperty(restriction));
+    }
+
+    OWLClassExpression::Ptr getFiller(const OWLClassExpression::Ptr& restriction) const
+    {
+        OWLQuantifiedObjectRestriction::Ptr quantified = dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(restriction);
+        if(quantified)
+        {
+            return quantified->getFiller();
+        }
+        return OWLClassExpression::Ptr();
+    }
+
+    uint32_t getCardinality(const OWLClassExpression::Ptr& restriction) const
+    {
+        OWLCardinalityRestriction::Ptr cardinalityRestriction = dynamic_pointer_cast<OWLCardinalityRestriction>(restriction);
+        if(cardinalityRestriction)
+        {
+            return cardinalityRestriction->getCardinality();
+        }
+        // unknown: assume the restriction is not trivial
+        return 1;
+    }
+
+    const SyntacticLocalityModuleExtractor::Signature& mSignature;
+    bool mBottom;
+    bool mLocal;
+};
+
+bool isTopOrBottomClass(const IRI& iri)
+{
+    return iri == vocabulary::OWL::Thing() || iri == vocabulary::OWL::Nothing();
+}
+
+bool isAssertion(const OWLAxiom::Ptr& axiom)
+{
+    return axiom->getAxiomType() >= OWLAxiom::ClassAssertion
+        && axiom->getAxiomType() <= OWLAxiom::NegativeDataPropertyAssertion;
+}
+
+/**
+ * Run the task for all indexes in [0, size) on up to numberOfThreads threads
+ * \throw the first exception of a failed task
+ */
+void parallelFor(size_t size, size_t numberOfThreads, const std::function<void(size_t)>& task)
+{
+    std::vector<std::exception_ptr> errors(size);
+    std::atomic<size_t> next(0);
+    std::function<void()> worker = [&]()
+    {
+        for(size_t i = next++; i < size; i = next++)
+        {
+            try {
+                task(i);
+            } catch(...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < std::min(numberOfThreads, size); ++i)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(const std::exception_ptr& error : errors)
+    {
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // end anonymous namespace
+
+SyntacticLocalityModuleExtractor::SyntacticLocalityModuleExtractor(const OWLOntology::Ptr& ontology, ModuleType type)
+    : mpOntology(ontology)
+    , mModuleType(type)
+    , mIgnoreAssertions(false)
+{
+    if(!mpOntology)
+    {
+        throw std::invalid_argument("owlapi::model::SyntacticLocalityModuleExtractor: ontology is not set");
+    }
+}
+
+bool SyntacticLocalityModuleExtractor::isLocal(const OWLAxiom::Ptr& axiom, const Signature& signature, ModuleType type)
+{
+    if(type == STAR)
+    {
+        throw std::invalid_argument("owlapi::model::SyntacticLocalityModuleExtractor::isLocal: "
+                "locality can only be evaluated for BOT or TOP");
+    }
+    LocalityEvaluator evaluator(signature, type);
+    return evaluator.isLocal(axiom);
+}
+
+OWLAxiom::PtrList SyntacticLocalityModuleExtractor::extract(const OWLAxiom::PtrList& axioms,
+        Signature& signature,
+        ModuleType type,
+        const std::function<OWLAxiom::PtrList(const IRI&)>& referencing) const
+{
+    LocalityEvaluator evaluator(signature, type);
+    OWLAxiom::PtrList module;
+    std::unordered_set<const OWLAxiom*> moduleAxioms;
+    IRIList pending;
+
+    std::function<void(const OWLAxiom::Ptr&)> check = [&](const OWLAxiom::Ptr& axiom)
+    {
+        if(moduleAxioms.count(axiom.get())
+                || (mIgnoreAssertions && isAssertion(axiom))
+                || evaluator.isLocal(axiom))
+        {
+            return;
+        }
+
+        moduleAxioms.insert(axiom.get());
+        module.push_back(axiom);
+        for(const IRI& iri : OWLAxiomSignatureVisitor::getSignature(axiom))
+        {
+            // top and bottom are not replaced in any case
+            if(!isTopOrBottomClass(iri) && signature.insert(iri).second)
+            {
+                pending.push_back(iri);
+            }
+        }
+    };
+
+    for(const OWLAxiom::Ptr& axiom : axioms)
+    {
+        check(axiom);
+    }
+
+    // An axiom can only become non-local if an entity of its signature
+    // has been added to the signature of the module
+    while(!pending.empty())
+    {
+        IRI iri = pending.back();
+        pending.pop_back();
+        for(const OWLAxiom::Ptr& axiom : referencing(iri))
+        {
+            check(axiom);
+        }
+    }
+    return module;
+}
+
+OWLAxiom::PtrList SyntacticLocalityModuleExtractor::extractLogicalAxioms(const IRIList& signature, Signature& moduleSignature) const
+{
+    Signature seed;
+    for(const IRI& iri : signature)
+    {
+        if(!isTopOrBottomClass(iri))
+        {
+            seed.insert(iri);
+        }
+    }
+
+    moduleSignature = seed;
+    OWLOntology::Ptr ontology = mpOntology;
+    OWLAxiom::PtrList module = extract(mpOntology->getAxioms(), moduleSignature,
+            mModuleType == STAR ? BOT : mModuleType,
+            [ontology](const IRI& iri) { return ontology->getReferencingAxioms(iri); });
+
+    if(mModuleType != STAR)
+    {
+        return module;
+    }
+
+    // Alternate top and bottom extraction on the previous module until a
+    // fixpoint is reached
+    ModuleType type = TOP;
+    size_t unchanged = 0;
+    while(unchanged < 2)
+    {
+        std::unordered_map<IRI, OWLAxiom::PtrList> index;
+        for(const OWLAxiom::Ptr& axiom : module)
+        {
+            for(const IRI& iri : OWLAxiomSignatureVisitor::getSignature(axiom))
+            {
+                index[iri].push_back(axiom);
+            }
+        }
+
+        moduleSignature = seed;
+        OWLAxiom::PtrList nestedModule = extract(module, moduleSignature, type,
+                [&index](const IRI& iri)
+                {
+                    std::unordered_map<IRI, OWLAxiom::PtrList>::const_iterator cit = index.find(iri);
+                    return cit != index.end() ? cit->second : OWLAxiom::PtrList();
+                });
+
+        unchanged = nestedModule.size() == module.size() ? unchanged + 1 : 0;
+        module.swap(nestedModule);
+        type = type == TOP ? BOT : TOP;
+    }
+    return module;
+}
+
+OWLAxiom::PtrList SyntacticLocalityModuleExtractor::extract(const IRIList& signature) const
+{
+    Signature moduleSignature;
+    return extractLogicalAxioms(signature, moduleSignature);
+}
+
+OWLOntology::Ptr SyntacticLocalityModuleExtractor::extractAsOntology(const IRIList& signature) const
+{
+    return extractAsOntologies(std::vector<IRIList>(1, signature)).front();
+}
+
+OWLOntology::PtrList SyntacticLocalityModuleExtractor::extractAsOntologies(const std::vector<IRIList>& signatures, size_t numberOfThreads) const
+{
+    if(numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<OWLAxiom::PtrList> moduleAxioms(signatures.size());
+    std::vector<Signature> moduleSignatures(signatures.size());
+    parallelFor(signatures.size(), numberOfThreads, [&](size_t i)
+            {
+                OWLAxiom::PtrList& axioms = moduleAxioms[i];
+                const Signature& moduleSignature = moduleSignatures[i];
+                axioms = extractLogicalAxioms(signatures[i], moduleSignatures[i]);
+
+                // Keep the declarations and annotations of the entities of
+                // the module
+                std::unordered_set<const OWLAxiom*> module;
+                for(const OWLAxiom::Ptr& axiom : axioms)
+                {
+                    module.insert(axiom.get());
+                }
+                for(const IRI& iri : moduleSignature)
+                {
+                    for(const OWLAxiom::Ptr& axiom : mpOntology->getReferencingAxioms(iri))
+                    {
+                        bool isEntityAxiom = axiom->getAxiomType() == OWLAxiom::Declaration
+                            || (axiom->getAxiomType() == OWLAxiom::AnnotationAssertion
+                                    && OWLOntology::getAnnotationSubjectIRI(dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom)->getSubject()) == iri);
+                        if(isEntityAxiom && module.insert(axiom.get()).second)
+                        {
+                            axioms.push_back(axiom);
+                        }
+                    }
+                }
+            });
+
+    // Knowledge bases are created sequentially, the modules populate them
+    // concurrently
+    std::vector<KnowledgeBase::Ptr> kbs;
+    for(size_t i = 0; i < signatures.size(); ++i)
+    {
+        kbs.push_back(make_shared<KnowledgeBase>());
+    }
+
+    OWLOntology::PtrList ontologies(signatures.size());
+    parallelFor(signatures.size(), numberOfThreads, [&](size_t i)
+            {
+                const Signature& moduleSignature = moduleSignatures[i];
+                ontologies[i] = mpOntology->createSubset(moduleAxioms[i],
+                        [&moduleSignature](const IRI& iri)
+                        {
+                            return moduleSignature.count(iri) != 0;
+                        }, kbs[i]);
+            });
+    return ontologies;
+}
+
+} // end namespace model
+} // end namespace owlapi
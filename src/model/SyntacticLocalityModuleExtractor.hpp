@@ -0,0 +1,129 @@
+#ifndef OWLAPI_MODEL_SYNTACTIC_LOCALITY_MODULE_EXTRACTOR_HPP
+#define OWLAPI_MODEL_SYNTACTIC_LOCALITY_MODULE_EXTRACTOR_HPP
+
+#include <unordered_set>
+#include "OWLOntology.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class SyntacticLocalityModuleExtractor
+ * \brief Extracts the module of an ontology for a given signature based on
+ * syntactic locality
+ * \details A module preserves all entailments of the ontology which are
+ * expressed over the given signature, so that queries restricted to this
+ * signature can be answered by reasoning over the (typically much smaller)
+ * module only.
+ *
+ * An axiom is local with respect to a signature if it becomes a tautology
+ * when all entities outside the signature are replaced by the bottom
+ * (BOT), or respectively the top (TOP) class and property. The module
+ * consists of all axioms which are not local with respect to the signature
+ * extended by the signature of the module itself.
+ *
+ * Axioms whose class expressions or properties cannot be evaluated are
+ * treated as non-local, i.e. the module might be larger than necessary but
+ * remains a module.
+ *
+ * \see http://owlapi.sourceforge.net/javadoc/uk/ac/manchester/cs/owlapi/modularity/SyntacticLocalityModuleExtractor.html
+\verbatim
+    SyntacticLocalityModuleExtractor extractor(ontology);
+    OWLOntology::Ptr module = extractor.extractAsOntology(signature);
+    OWLOntologyAsk(module).allSubClassesOf(klass);
+\endverbatim
+ */
+class SyntacticLocalityModuleExtractor
+{
+public:
+    enum ModuleType {
+        /// Bottom module: the smallest module for queries about
+        /// subsumers and instances of classes in the signature
+        BOT,
+        /// Top module: for queries about subclasses of classes in the
+        /// signature
+        TOP,
+        /// Nested bottom and top module, i.e. the smallest of all three
+        STAR
+    };
+
+    typedef std::unordered_set<IRI> Signature;
+
+    SyntacticLocalityModuleExtractor(const OWLOntology::Ptr& ontology, ModuleType type = BOT);
+
+    ModuleType getModuleType() const { return mModuleType; }
+
+    /**
+     * Exclude assertions from modules
+     * \details Assertions are non-local w.r.t. any signature (BOT), but do not
+     * affect the class hierarchy of a consistent ontology without nominals.
+     * Excluding them keeps modules for classification small and independent
+     * of the individuals
+     */
+    void setIgnoreAssertions(bool ignore) { mIgnoreAssertions = ignore; }
+
+    bool isIgnoringAssertions() const { return mIgnoreAssertions; }
+
+    /**
+     * Extract the module for the given signature
+     * \return logical axioms of the module, and the declaration axioms of the
+     * entities in the signature of the module
+     */
+    OWLAxiom::PtrList extract(const IRIList& signature) const;
+
+    /**
+     * Extract the module for the given signature as an ontology of its own
+     * \details The module ontology shares the entities and axioms of the
+     * module, including the declarations and annotations of its entities,
+     * with this ontology and uses its own knowledge base, which only
+     * contains the axioms of the module.
+     * \return ontology of the module
+     */
+    OWLOntology::Ptr extractAsOntology(const IRIList& signature) const;
+
+    /**
+     * Extract the modules for several signatures as ontologies of their own
+     * \details The modules are extracted and populated concurrently, while
+     * this ontology must not be modified, \see extractAsOntology
+     * \param numberOfThreads Maximum number of threads, 0 to use the number
+     * of hardware threads
+     * \return ontology of the module of each signature
+     * \throw the first exception of a failed extraction
+     */
+    OWLOntology::PtrList extractAsOntologies(const std::vector<IRIList>& signatures, size_t numberOfThreads = 1) const;
+
+    /**
+     * Test an axiom for syntactic locality
+     * \param signature signature which is not replaced by bottom or top
+     * \param type BOT or TOP locality
+     * \return true if the axiom is local w.r.t. signature
+     * \throw std::invalid_argument if the type is STAR
+     */
+    static bool isLocal(const OWLAxiom::Ptr& axiom, const Signature& signature, ModuleType type);
+
+private:
+    /**
+     * Extract the BOT or TOP module
+     * \param axioms candidate axioms
+     * \param signature signature, which is extended by the signature of the
+     * module
+     * \param referencing index of the candidate axioms by entity
+     */
+    OWLAxiom::PtrList extract(const OWLAxiom::PtrList& axioms,
+            Signature& signature,
+            ModuleType type,
+            const std::function<OWLAxiom::PtrList(const IRI&)>& referencing) const;
+
+    /**
+     * Compute the module and its signature
+     */
+    OWLAxiom::PtrList extractLogicalAxioms(const IRIList& signature, Signature& moduleSignature) const;
+
+    OWLOntology::Ptr mpOntology;
+    ModuleType mModuleType;
+    bool mIgnoreAssertions;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_SYNTACTIC_LOCALITY_MODULE_EXTRACTOR_HPP
@@ -0,0 +1,205 @@
+#include "Taxonomy.hpp"
+#include "MemoryUsage.hpp"
+#include <stdexcept>
+
+namespace owlapi {
+namespace model {
+
+Taxonomy::Taxonomy(const IRIList& klasses, const std::vector< std::pair<IRI, IRI> >& directSubClasses)
+    : mTraversal(0)
+{
+    for(const IRI& klass : klasses)
+    {
+        if(mIds.insert( std::make_pair(klass, mIRIs.size()) ).second)
+        {
+            mIRIs.push_back(klass);
+        }
+    }
+
+    std::vector< std::pair<NodeId, NodeId> > edges;
+    edges.reserve(directSubClasses.size());
+    for(const std::pair<IRI, IRI>& edge : directSubClasses)
+    {
+        NodeId ids[2];
+        const IRI* iris[2] = { &edge.first, &edge.second };
+        for(size_t i = 0; i < 2; ++i)
+        {
+            std::pair<std::unordered_map<IRI, NodeId>::iterator, bool> result =
+                mIds.insert( std::make_pair(*iris[i], mIRIs.size()) );
+            if(result.second)
+            {
+                mIRIs.push_back(*iris[i]);
+            }
+            ids[i] = result.first->second;
+        }
+        edges.push_back( std::make_pair(ids[0], ids[1]) );
+    }
+
+    // Counting sort of the edges into the compressed row arrays
+    size_t numberOfNodes = mIRIs.size();
+    mChildOffsets.assign(numberOfNodes + 1, 0);
+    mParentOffsets.assign(numberOfNodes + 1, 0);
+    for(const std::pair<NodeId, NodeId>& edge : edges)
+    {
+        ++mChildOffsets[edge.first + 1];
+        ++mParentOffsets[edge.second + 1];
+    }
+    for(size_t i = 0; i < numberOfNodes; ++i)
+    {
+        mChildOffsets[i + 1] += mChildOffsets[i];
+        mParentOffsets[i + 1] += mParentOffsets[i];
+    }
+
+    mChildren.resize(edges.size());
+    mParents.resize(edges.size());
+    std::vector<NodeId> childPosition(mChildOffsets.begin(), mChildOffsets.end() - 1);
+    std::vector<NodeId> parentPosition(mParentOffsets.begin(), mParentOffsets.end() - 1);
+    for(const std::pair<NodeId, NodeId>& edge : edges)
+    {
+        mChildren[ childPosition[edge.first]++ ] = edge.second;
+        mParents[ parentPosition[edge.second]++ ] = edge.first;
+    }
+
+    mVisited.assign(numberOfNodes, 0);
+    mQueue.reserve(numberOfNodes);
+}
+
+Taxonomy::NodeId Taxonomy::getId(const IRI& klass) const
+{
+    std::unordered_map<IRI, NodeId>::const_iterator cit = mIds.find(klass);
+    if(cit == mIds.end())
+    {
+        throw std::invalid_argument("owlapi::model::Taxonomy::getId: class '"
+                + klass.toString() + "' is not part of the taxonomy");
+    }
+    return cit->second;
+}
+
+Taxonomy::Range Taxonomy::getChildren(NodeId node) const
+{
+    const NodeId* data = mChildren.data();
+    return Range(data + mChildOffsets[node], data + mChildOffsets[node + 1]);
+}
+
+Taxonomy::Range Taxonomy::getParents(NodeId node) const
+{
+    const NodeId* data = mParents.data();
+    return Range(data + mParentOffsets[node], data + mParentOffsets[node + 1]);
+}
+
+void Taxonomy::startTraversal() const
+{
+    if(++mTraversal == 0)
+    {
+        // wrap around: reset all marks
+        mVisited.assign(mVisited.size(), 0);
+        mTraversal = 1;
+    }
+    mQueue.clear();
+}
+
+bool Taxonomy::visit(NodeId node) const
+{
+    if(mVisited[node] == mTraversal)
+    {
+        return false;
+    }
+    mVisited[node] = mTraversal;
+    return true;
+}
+
+void Taxonomy::breadthFirst(NodeId node, const Visitor& visitor) const
+{
+    startTraversal();
+    visit(node);
+    mQueue.push_back( std::make_pair(node, 0) );
+
+    // mQueue is used as FIFO, since every node is enqueued at most once
+    for(size_t head = 0; head < mQueue.size(); ++head)
+    {
+        std::pair<NodeId, size_t> current = mQueue[head];
+        for(NodeId child : getChildren(current.first))
+        {
+            if(visit(child) && visitor(child, current.second + 1))
+            {
+                mQueue.push_back( std::make_pair(child, current.second + 1) );
+            }
+        }
+    }
+}
+
+void Taxonomy::depthFirst(NodeId node, const Visitor& visitor) const
+{
+    startTraversal();
+    visit(node);
+    // mQueue is used as stack of (node, index of next child)
+    mQueue.push_back( std::make_pair(node, 0) );
+    while(!mQueue.empty())
+    {
+        std::pair<NodeId, size_t>& current = mQueue.back();
+        Range children = getChildren(current.first);
+        if(current.second == children.size())
+        {
+            mQueue.pop_back();
+            continue;
+        }
+
+        NodeId child = children.begin()[current.second++];
+        if(visit(child) && visitor(child, mQueue.size()))
+        {
+            mQueue.push_back( std::make_pair(child, 0) );
+        }
+    }
+}
+
+void Taxonomy::leaves(NodeId node, const std::function<void(NodeId node)>& visitor) const
+{
+    breadthFirst(node, [this, &visitor](NodeId descendant, size_t)
+            {
+                if(isLeaf(descendant))
+                {
+                    visitor(descendant);
+                }
+                return true;
+            });
+}
+
+std::vector<IRIList> Taxonomy::getDescendantsWithDistance(const IRI& klass) const
+{
+    std::vector<IRIList> descendants(1);
+    breadthFirst(getId(klass), [this, &descendants](NodeId descendant, size_t distance)
+            {
+                if(descendants.size() < distance)
+                {
+                    descendants.resize(distance);
+                }
+                descendants[distance - 1].push_back( getIRI(descendant) );
+                return true;
+            });
+    if(!descendants.back().empty())
+    {
+        descendants.push_back(IRIList());
+    }
+    return descendants;
+}
+
+IRIList Taxonomy::getLeaves(const IRI& klass) const
+{
+    IRIList klasses;
+    leaves(getId(klass), [this, &klasses](NodeId leaf)
+            {
+                klasses.push_back( getIRI(leaf) );
+            });
+    return klasses;
+}
+
+uint64_t Taxonomy::getMemoryUsage() const
+{
+    return memory::heapBytes(mIds) + memory::heapBytes(mIRIs)
+        + memory::heapBytes(mChildOffsets) + memory::heapBytes(mChildren)
+        + memory::heapBytes(mParentOffsets) + memory::heapBytes(mParents)
+        + memory::heapBytes(mVisited) + memory::heapBytes(mQueue);
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,186 @@
+#ifndef OWLAPI_MODEL_TAXONOMY_HPP
+#define OWLAPI_MODEL_TAXONOMY_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include <functional>
+#include "IRI.hpp"
+#include "../SharedPtr.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class Taxonomy
+ * \brief Immutable snapshot of the class hierarchy (direct subclass
+ * relations) as a directed acyclic graph
+ * \details Parents and children of all nodes are stored in compressed sparse
+ * row arrays, so that traversals do not need to query the reasoner or
+ * allocate. Traversals reuse internal scratch buffers and are therefore
+ * neither thread-safe nor reentrant, i.e. a visitor must not start another
+ * traversal on the same taxonomy.
+ */
+class Taxonomy
+{
+public:
+    typedef shared_ptr<Taxonomy> Ptr;
+    typedef uint32_t NodeId;
+
+    /**
+     * \class Range
+     * \brief Range of node ids, i.e. the children or parents of a node
+     */
+    class Range
+    {
+    public:
+        Range(const NodeId* begin, const NodeId* end)
+            : mBegin(begin)
+            , mEnd(end)
+        {}
+
+        const NodeId* begin() const { return mBegin; }
+        const NodeId* end() const { return mEnd; }
+        size_t size() const { return mEnd - mBegin; }
+        bool empty() const { return mBegin == mEnd; }
+
+    private:
+        const NodeId* mBegin;
+        const NodeId* mEnd;
+    };
+
+    /**
+     * Visitor for traversals
+     * \param node Visited node
+     * \param distance Link distance to the start node; shortest distance for
+     * breadth first traversals, depth in the search tree for depth first
+     * traversals
+     * \return false to skip the descendants of this node, true to continue
+     */
+    typedef std::function<bool(NodeId node, size_t distance)> Visitor;
+
+    /**
+     * Create the taxonomy
+     * \param klasses All classes
+     * \param directSubClasses List of (class, direct subclass) pairs, classes
+     * which are not part of klasses are added
+     */
+    Taxonomy(const IRIList& klasses, const std::vector< std::pair<IRI, IRI> >& directSubClasses);
+
+    /**
+     * Get the number of nodes
+     */
+    size_t size() const { return mIRIs.size(); }
+
+    /**
+     * Check if the class is part of the taxonomy
+     */
+    bool hasNode(const IRI& klass) const { return mIds.count(klass); }
+
+    /**
+     * Get the node id of a class
+     * \throw std::invalid_argument if the class is not part of the taxonomy
+     */
+    NodeId getId(const IRI& klass) const;
+
+    /**
+     * Get the class of a node
+     */
+    const IRI& getIRI(NodeId node) const { return mIRIs[node]; }
+
+    /**
+     * Get the direct subclasses of a node
+     */
+    Range getChildren(NodeId node) const;
+
+    /**
+     * Get the direct superclasses of a node
+     */
+    Range getParents(NodeId node) const;
+
+    /**
+     * Check if the node has no subclasses
+     */
+    bool isLeaf(NodeId node) const { return mChildOffsets[node] == mChildOffsets[node + 1]; }
+
+    /**
+     * Visit all descendants of a node (excluding the node itself) in breadth
+     * first order, i.e. with increasing distance. Each descendant is visited
+     * once with its shortest distance
+     */
+    void breadthFirst(NodeId node, const Visitor& visitor) const;
+
+    /**
+     * Visit all descendants of a node (excluding the node itself) in depth
+     * first pre-order. Each descendant is visited once
+     */
+    void depthFirst(NodeId node, const Visitor& visitor) const;
+
+    /**
+     * Visit all descendants of a node which have no subclasses
+     */
+    void leaves(NodeId node, const std::function<void(NodeId node)>& visitor) const;
+
+    /**
+     * Retrieve all descendants of a class grouped by their shortest link
+     * distance, i.e. index 0 holds the direct subclasses
+     * \return list of descendants per distance, terminated by an empty list
+     */
+    std::vector<IRIList> getDescendantsWithDistance(const IRI& klass) const;
+
+    /**
+     * Retrieve all descendants of a class which have no subclasses
+     */
+    IRIList getLeaves(const IRI& klass) const;
+
+    /**
+     * Get the estimated heap memory of the taxonomy, including the traversal buffers
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    /**
+     * Start a new traversal, i.e. reset the visited marks
+     */
+    void startTraversal() const;
+
+    /**
+     * Mark node as visited
+     * \return true if node has not been visited in this traversal before
+     */
+    bool visit(NodeId node) const;
+
+    std::unordered_map<IRI, NodeId> mIds;
+    IRIList mIRIs;
+
+    std::vector<NodeId> mChildOffsets;
+    std::vector<NodeId> mChildren;
+    std::vector<NodeId> mParentOffsets;
+    std::vector<NodeId> mParents;
+
+    /// Scratch buffers for traversals
+    mutable std::vector<uint32_t> mVisited;
+    mutable uint32_t mTraversal;
+    mutable std::vector< std::pair<NodeId, size_t> > mQueue;
+};
+
+/**
+ * \class TaxonomySnapshot
+ * \brief Class hierarchy of a completed classification
+ */
+struct TaxonomySnapshot
+{
+    /// Taxonomy, or an empty pointer if no classification has been
+    /// completed yet
+    Taxonomy::Ptr taxonomy;
+    /// Generation of the knowledge base the taxonomy has been created for
+    uint64_t generation;
+    /// True if the generation of the knowledge base has changed since,
+    /// i.e. the taxonomy might be outdated
+    bool stale;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_TAXONOMY_HPP
@@ -0,0 +1,97 @@
+#include "TellJournal.hpp"
+#include "MemoryUsage.hpp"
+#include "OWLOntologyTell.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace owlapi {
+namespace model {
+
+TellJournal::Scope::Scope(TellJournal& journal, const IRI& origin)
+    : mJournal(journal)
+    , mOrigin(origin)
+    , mRecording(journal.mEnabled && journal.mDepth == 0)
+{
+    if(mRecording)
+    {
+        mJournal.mAxioms.clear();
+    }
+    ++mJournal.mDepth;
+}
+
+TellJournal::Scope::~Scope()
+{
+    --mJournal.mDepth;
+    if(mRecording && mOperation && !std::uncaught_exception())
+    {
+        Entry entry;
+        entry.origin = mOrigin;
+        entry.operation = mOperation;
+        entry.axioms.swap(mJournal.mAxioms);
+        mJournal.mEntries.push_back(entry);
+    }
+}
+
+TellJournal::TellJournal()
+    : mDepth(0)
+    , mEnabled(false)
+{}
+
+void TellJournal::setEnabled(bool enabled)
+{
+    mEnabled = enabled;
+    if(!mEnabled)
+    {
+        EntryList().swap(mEntries);
+        mAxioms.clear();
+    }
+}
+
+void TellJournal::erase(const Filter& filter)
+{
+    mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(), filter), mEntries.end());
+}
+
+void TellJournal::replay(const OWLOntology::Ptr& ontology) const
+{
+    replay(ontology, Filter());
+}
+
+void TellJournal::replay(const OWLOntology::Ptr& ontology, const Filter& filter) const
+{
+    shared_ptr<OWLOntologyTell> tell;
+    for(const Entry& entry : mEntries)
+    {
+        if(filter && !filter(entry))
+        {
+            continue;
+        }
+
+        if(!tell || tell->getOrigin() != entry.origin)
+        {
+            tell = make_shared<OWLOntologyTell>(ontology, entry.origin);
+        }
+        entry.operation(*tell);
+    }
+}
+
+void TellJournal::recordAxiom(const shared_ptr<OWLAxiom>& axiom)
+{
+    if(mEnabled && mDepth)
+    {
+        mAxioms.push_back(axiom);
+    }
+}
+
+uint64_t TellJournal::getMemoryUsage() const
+{
+    uint64_t bytes = mEntries.capacity() * sizeof(Entry) + memory::heapBytes(mAxioms);
+    for(const Entry& entry : mEntries)
+    {
+        bytes += memory::heapBytes(entry.origin) + memory::heapBytes(entry.axioms);
+    }
+    return bytes;
+}
+
+} // end namespace model
+} // end namespace owlapi
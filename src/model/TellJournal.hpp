@@ -0,0 +1,127 @@
+#ifndef OWLAPI_MODEL_TELL_JOURNAL_HPP
+#define OWLAPI_MODEL_TELL_JOURNAL_HPP
+
+#include <vector>
+#include <functional>
+#include "IRI.hpp"
+#include "../SharedPtr.hpp"
+
+namespace owlapi {
+namespace model {
+
+class OWLOntology;
+class OWLOntologyTell;
+class OWLAxiom;
+
+/**
+ * \class TellJournal
+ * \brief Records the OWLOntologyTell calls which populated an ontology, so
+ * that they can be replayed against another ontology
+ * \details Only the outermost call is recorded, e.g. a call to subClassOf
+ * is recorded, but not the nested call to klass. A call is only recorded if
+ * it returns without an exception. Recording is disabled by default, since
+ * each entry holds the operation and the axioms of a call for the lifetime
+ * of the journal.
+ * \see OWLOntology::setJournaling
+ */
+class TellJournal
+{
+public:
+    typedef std::function<void(OWLOntologyTell&)> Operation;
+
+    struct Entry
+    {
+        /// Origin of the tell call, \see OWLOntologyTell::getOrigin
+        IRI origin;
+        Operation operation;
+        /// Axioms which have been added to the ontology by this call
+        std::vector< shared_ptr<OWLAxiom> > axioms;
+    };
+
+    typedef std::vector<Entry> EntryList;
+    typedef std::function<bool(const Entry&)> Filter;
+
+    /**
+     * \class Scope
+     * \brief Scope of a single OWLOntologyTell call
+     */
+    class Scope
+    {
+    public:
+        Scope(TellJournal& journal, const IRI& origin);
+        ~Scope();
+
+        /**
+         * Check if this call is recorded, i.e. if it is the outermost call
+         * and the journal is enabled
+         */
+        bool isRecording() const { return mRecording; }
+
+        /**
+         * Set the operation which replays this call
+         */
+        void setOperation(const Operation& operation) { mOperation = operation; }
+
+    private:
+        TellJournal& mJournal;
+        IRI mOrigin;
+        bool mRecording;
+        Operation mOperation;
+    };
+
+    TellJournal();
+
+    /**
+     * Enable or disable recording, where disabling drops all entries
+     */
+    void setEnabled(bool enabled);
+
+    bool isEnabled() const { return mEnabled; }
+
+    /**
+     * Get all recorded entries
+     */
+    const EntryList& getEntries() const { return mEntries; }
+
+    /**
+     * Remove all entries matching the filter, e.g. after the axioms they
+     * have added have been removed from the ontology
+     */
+    void erase(const Filter& filter);
+
+    /**
+     * Replay all recorded entries against the given ontology
+     */
+    void replay(const shared_ptr<OWLOntology>& ontology) const;
+
+    /**
+     * Replay the recorded entries which pass the filter against the given
+     * ontology
+     */
+    void replay(const shared_ptr<OWLOntology>& ontology, const Filter& filter) const;
+
+    /**
+     * Associate an axiom with the currently active call
+     * \see Entry::axioms
+     */
+    void recordAxiom(const shared_ptr<OWLAxiom>& axiom);
+
+    /**
+     * Get the estimated heap memory of the journal
+     * \details The axioms are owned by the ontology and not accounted for
+     * \return bytes, \see MemoryUsage
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    EntryList mEntries;
+    /// Axioms added by the currently active outermost call
+    std::vector< shared_ptr<OWLAxiom> > mAxioms;
+    /// Number of currently active tell calls
+    size_t mDepth;
+    bool mEnabled;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_TELL_JOURNAL_HPP
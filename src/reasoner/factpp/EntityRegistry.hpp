@@ -0,0 +1,211 @@
+#ifndef OWLAPI_REASONER_FACTPP_ENTITY_REGISTRY_HPP
+#define OWLAPI_REASONER_FACTPP_ENTITY_REGISTRY_HPP
+
+#include <stdint.h>
+#include <vector>
+#include <map>
+#include <utility>
+#include "../../model/IRI.hpp"
+#include "../../model/MemoryUsage.hpp"
+
+namespace owlapi {
+namespace reasoner {
+namespace factpp {
+
+/**
+ * \class EntityRegistry
+ * \brief Registry of the reasoner expressions of named entities
+ * \details Entities are assigned dense ids in the order of their
+ * registration, which index the list of IRIs and the list of expressions. The
+ * ids are found via an open addressing hash table which stores the id and
+ * the hash of each entity only, so that a lookup does neither allocate nor
+ * throw. Entities are identified by their string representation, as with
+ * IRI::operator<.
+ *
+\verbatim
+    const ClassExpression* registered = mClasses.find(klass);
+    if(!registered)
+    {
+        ClassExpression expression(getExpressionManager()->Concept(klass.toString()));
+        *mClasses.insert(klass).first = expression;
+    }
+\endverbatim
+ */
+template<typename T>
+class EntityRegistry
+{
+public:
+    typedef uint32_t Id;
+    typedef owlapi::model::IRI IRI;
+    typedef owlapi::model::IRIList IRIList;
+
+    static const Id INVALID_ID = 0xFFFFFFFF;
+
+    EntityRegistry()
+        : mMask(0)
+    {}
+
+    /**
+     * Get the id of an entity
+     * \return id, or INVALID_ID if the entity is not registered
+     */
+    Id getId(const IRI& iri) const
+    {
+        if(mSlots.empty())
+        {
+            return INVALID_ID;
+        }
+        uint32_t hash = static_cast<uint32_t>(iri.getStringHash());
+        for(size_t i = hash & mMask; ; i = (i + 1) & mMask)
+        {
+            const Slot& slot = mSlots[i];
+            if(slot.id == INVALID_ID)
+            {
+                return INVALID_ID;
+            }
+            if(slot.hash == hash && mIRIs[slot.id].hasSameString(iri))
+            {
+                return slot.id;
+            }
+        }
+    }
+
+    /**
+     * Find the expression of an entity
+     * \return expression, or NULL if the entity is not registered
+     */
+    const T* find(const IRI& iri) const
+    {
+        Id id = getId(iri);
+        return id == INVALID_ID ? NULL : &mExpressions[id];
+    }
+
+    bool count(const IRI& iri) const { return getId(iri) != INVALID_ID; }
+
+    /**
+     * Register the entity with a default constructed expression, unless it
+     * is registered already
+     * \return the expression of the entity, which remains valid until the
+     * next registration, and true if the entity has been registered by
+     * this call
+     */
+    std::pair<T*, bool> insert(const IRI& iri)
+    {
+        if(2 * (mIRIs.size() + 1) > mSlots.size())
+        {
+            rehash(mSlots.empty() ? 64 : 2 * mSlots.size());
+        }
+
+        uint32_t hash = static_cast<uint32_t>(iri.getStringHash());
+        size_t i = hash & mMask;
+        for(; mSlots[i].id != INVALID_ID; i = (i + 1) & mMask)
+        {
+            const Slot& slot = mSlots[i];
+            if(slot.hash == hash && mIRIs[slot.id].hasSameString(iri))
+            {
+                return std::pair<T*, bool>(&mExpressions[slot.id], false);
+            }
+        }
+
+        mSlots[i].id = mIRIs.size();
+        mSlots[i].hash = hash;
+        mIRIs.push_back(iri);
+        mExpressions.push_back(T());
+        return std::pair<T*, bool>(&mExpressions.back(), true);
+    }
+
+    /**
+     * Get the expression of an entity, and register the entity if needed
+     */
+    T& operator[](const IRI& iri) { return *insert(iri).first; }
+
+    const IRI& getIRI(Id id) const { return mIRIs[id]; }
+    const T& getExpression(Id id) const { return mExpressions[id]; }
+
+    /**
+     * Get the IRIs of all registered entities in the order of registration
+     */
+    const IRIList& getIRIs() const { return mIRIs; }
+
+    /**
+     * Get all registered entities ordered by their IRI
+     */
+    std::map<IRI, T> toMap() const
+    {
+        std::map<IRI, T> map;
+        for(size_t id = 0; id < mIRIs.size(); ++id)
+        {
+            map[mIRIs[id]] = mExpressions[id];
+        }
+        return map;
+    }
+
+    size_t size() const { return mIRIs.size(); }
+    bool empty() const { return mIRIs.empty(); }
+
+    void clear()
+    {
+        mSlots.clear();
+        mMask = 0;
+        mIRIs.clear();
+        mExpressions.clear();
+    }
+
+    /**
+     * Get the estimated heap memory of the registry
+     * \return bytes, \see owlapi::model::MemoryUsage
+     */
+    uint64_t getMemoryUsage() const
+    {
+        return mSlots.capacity() * sizeof(Slot) + owlapi::model::memory::heapBytes(mIRIs)
+            + mExpressions.capacity() * sizeof(T);
+    }
+
+private:
+    struct Slot
+    {
+        Id id;
+        /// Lower bits of the hash of the entity, to skip comparing the
+        /// IRIs of most colliding entities and to rehash without the IRIs
+        uint32_t hash;
+    };
+
+    /**
+     * Rebuild the hash table with the given number of slots, which is a
+     * power of two
+     */
+    void rehash(size_t numberOfSlots)
+    {
+        std::vector<Slot> slots(numberOfSlots, Slot{INVALID_ID, 0});
+        size_t mask = numberOfSlots - 1;
+        for(const Slot& slot : mSlots)
+        {
+            if(slot.id == INVALID_ID)
+            {
+                continue;
+            }
+            size_t i = slot.hash & mask;
+            while(slots[i].id != INVALID_ID)
+            {
+                i = (i + 1) & mask;
+            }
+            slots[i] = slot;
+        }
+        mSlots.swap(slots);
+        mMask = mask;
+    }
+
+    std::vector<Slot> mSlots;
+    size_t mMask;
+
+    IRIList mIRIs;
+    std::vector<T> mExpressions;
+};
+
+template<typename T>
+const typename EntityRegistry<T>::Id EntityRegistry<T>::INVALID_ID;
+
+} // end namespace factpp
+} // end namespace reasoner
+} // end namespace owlapi
+#endif // OWLAPI_REASONER_FACTPP_ENTITY_REGISTRY_HPP
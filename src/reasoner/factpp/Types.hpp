@@ -16,6 +16,7 @@ class TDLDataExpression;
 class TDLDataTypeName;
 class ReasoningKernel;
 class DlCompletionTree;
+class TNamedEntry;
 
 namespace owlapi {
 namespace reasoner {
@@ -28,7 +29,7 @@ class Axiom
 public:
     typedef std::vector<Axiom> List;
 
-    Axiom(TDLAxiom* axiom);
+    Axiom(TDLAxiom* axiom = NULL);
 
     const TDLAxiom* get() const { return mAxiom; }
     TDLAxiom* get() { return mAxiom; }
@@ -1,6 +1,9 @@
 #include <iostream>
+#include <chrono>
+#include <sys/resource.h>
 
 #include <owlapi/OWLApi.hpp>
+#include <owlapi/Instrumentation.hpp>
 #include <owlapi/io/OWLOntologyIO.hpp>
 #include <owlapi/io/OWLOntologyReader.hpp>
 
@@ -15,7 +18,12 @@ int main(int argc, char** argv)
     desc.add_options()
         ("help,h", "produce help message")
         ("canonize,c", po::value<std::string>(), "canonize a url")
-        ("list,l", "list known ontologies");
+        ("list,l", "list known ontologies")
+        ("load", po::value<std::string>(), "load an ontology file and report load time, peak memory and teardown time")
+        ("arena", "use arena allocation when loading (see --load)")
+        ("structural", "load the model only, without creating a reasoner (see --load)")
+        ("memory", "print the estimated memory per ontology structure as JSON when loading (see --load)")
+        ("stats", "print call counts and latencies as JSON when loading (see --load), requires a build with OWLAPI_INSTRUMENTATION");
 
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -45,7 +53,7 @@ int main(int argc, char** argv)
             {
                 std::string filename = dirIt->path().string();
                 owlapi::io::OWLOntologyReader reader;
-                owlapi::model::OWLOntology::Ptr ontology = reader.open(filename);
+                owlapi::model::OWLOntology::Ptr ontology = reader.open(filename, owlapi::model::OWLOntology::STRUCTURAL);
                 reader.loadImports(ontology, true);
                 std::cout << "ontology: " << ontology->getIRI() << ", file: " << filename << std::endl;
             }
@@ -53,5 +61,64 @@ int main(int argc, char** argv)
         return 0;
     }
 
+    if(vm.count("load"))
+    {
+        typedef std::chrono::steady_clock Clock;
+        std::string filename = vm["load"].as<std::string>();
+
+        Clock::time_point start = Clock::now();
+        owlapi::io::OWLOntologyReader reader;
+        owlapi::model::OWLOntology::Ptr ontology = reader.open(filename,
+                vm.count("structural") ? owlapi::model::OWLOntology::STRUCTURAL : owlapi::model::OWLOntology::REASONING);
+        if(vm.count("arena"))
+        {
+            ontology->enableArena();
+        }
+        reader.loadImports(ontology, true);
+        reader.loadDeclarations(ontology, true);
+        reader.loadAxioms(ontology);
+        Clock::time_point loaded = Clock::now();
+
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        std::cout << "ontology: " << ontology->getIRI() << std::endl;
+        std::cout << "    axioms: " << ontology->getAxioms().size() << std::endl;
+        std::cout << "    load time: " << std::chrono::duration_cast<std::chrono::milliseconds>(loaded - start).count() << " ms" << std::endl;
+        std::cout << "    peak rss: " << usage.ru_maxrss << " kB" << std::endl;
+        if(ontology->getArena())
+        {
+            std::cout << "    arena: " << ontology->getArena()->getAllocatedBytes() << " bytes allocated, "
+                << ontology->getArena()->getFreeBytes() << " bytes free, "
+                << ontology->getArena()->getReservedBytes() << " bytes reserved in "
+                << ontology->getArena()->getNumberOfBlocks() << " blocks" << std::endl;
+        }
+
+        if(vm.count("memory"))
+        {
+            owlapi::model::MemoryUsage memory = ontology->getMemoryUsage();
+            memory.add("reader", reader.getMemoryUsage());
+            memory.toJSON(std::cout);
+            std::cout << std::endl;
+        }
+
+        Clock::time_point teardownStart = Clock::now();
+        ontology.reset();
+        Clock::time_point teardownEnd = Clock::now();
+        std::cout << "    teardown time: " << std::chrono::duration_cast<std::chrono::milliseconds>(teardownEnd - teardownStart).count() << " ms" << std::endl;
+
+        if(vm.count("stats"))
+        {
+            if(!owlapi::Instrumentation::isEnabled())
+            {
+                std::cerr << "statistics are not available: owlapi has been built without OWLAPI_INSTRUMENTATION" << std::endl;
+            } else {
+                owlapi::Instrumentation::toJSON(std::cout);
+                std::cout << std::endl;
+            }
+        }
+        return 0;
+    }
+
     return 0;
 }
@@ -1,27 +1,31 @@
 #include "OWLEntityRemover.hpp"
+#include "../model/RemoveAxiom.hpp"
 
 using namespace owlapi::model;
 
 namespace owlapi {
-namespace model {
+namespace utils {
 
-void OWLEntityRemover::generateChanges(const OWLEntity::Ptr& entity)
-{
+OWLEntityRemover::OWLEntityRemover(const OWLOntology::PtrList& ontologies)
+    : mOntologies(ontologies)
+{}
 
+void OWLEntityRemover::generateChanges(const OWLEntity* entity)
+{
     OWLOntology::PtrList::const_iterator oit = mOntologies.begin();
     for(; oit != mOntologies.end(); ++oit)
     {
         const OWLOntology::Ptr& ontology = *oit;
 
         bool excludeImports = true;
-        std::vector<OWLAxiom::Ptr> axioms = ontology->getReferencingAxioms(entity, excludeImports);
-        std::vector<OWLAxiom>::const_iterator cit = axioms.begin();
+        OWLAxiom::PtrList axioms = ontology->getReferencingAxioms(entity->getIRI(), excludeImports);
+        OWLAxiom::PtrList::const_iterator cit = axioms.begin();
         for(; cit != axioms.end(); ++cit)
         {
-            mChanges.add( OWLOntologyChange::Ptr(new RemoveAxiom(ontology, ax) );
+            mChanges.push_back( make_shared<RemoveAxiom>(ontology, *cit) );
         }
     }
 }
 
-} // end namespace model
+} // end namespace utils
 } // end namespace owlapi
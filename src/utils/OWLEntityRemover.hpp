@@ -4,22 +4,26 @@
 #include "../model/OWLEntity.hpp"
 #include "../model/OWLEntityVisitor.hpp"
 #include "../model/OWLOntologyChange.hpp"
+#include "../model/OWLOntology.hpp"
 
 namespace owlapi {
 namespace utils {
 
 /**
- * \class OWLEntityRemove
+ * \class OWLEntityRemover
  * \brief A utility class which allows to collect all relevant axioms to remove an entity
- *
+ * \details The axioms are looked up from the entity index of each ontology,
+ * i.e. collecting the changes is linear in the number of referencing axioms.
+ * Axioms which have been imported are not removed.
  */
 class OWLEntityRemover : public owlapi::model::OWLEntityVisitor
 {
 public:
 
-    OWLEntityRemover(owlapi::model::OWLOntology::PtrList& ontologies);
+    OWLEntityRemover(const owlapi::model::OWLOntology::PtrList& ontologies);
 
 private:
+    owlapi::model::OWLOntology::PtrList mOntologies;
     owlapi::model::OWLOntologyChange::PtrList mChanges;
 
     void generateChanges(const owlapi::model::OWLEntity* entity);
@@ -58,15 +58,17 @@ int main(int argc, char** argv)
         exit(1);
     }
 
+    // a conversion does not require a reasoner
+    OWLOntology::Mode mode = vm.count("format") ? OWLOntology::STRUCTURAL : OWLOntology::REASONING;
     OWLOntology::Ptr ontology;
     if(vm.count("ontology_file"))
     {
         std::string filename = vm["ontology_file"].as<std::string>();
-        ontology = owlapi::io::OWLOntologyIO::fromFile(filename);
+        ontology = owlapi::io::OWLOntologyIO::fromFile(filename, mode);
     } else if(vm.count("ontology_uri"))
     {
         owlapi::model::IRI iri(vm["ontology_uri"].as<std::string>());
-        ontology = owlapi::io::OWLOntologyIO::load(iri);
+        ontology = owlapi::io::OWLOntologyIO::load(iri, mode);
     }
 
     if( !vm.count("format") )
@@ -1,5 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include <owlapi/model/OWLFacetRestriction.hpp>
+#include <owlapi/model/OWLDataTypeRestriction.hpp>
+#include <owlapi/model/OWLDataOneOf.hpp>
+#include <owlapi/model/DataRangeValidator.hpp>
 #include <owlapi/Vocabulary.hpp>
 
 using namespace owlapi::model;
@@ -36,4 +39,49 @@ BOOST_AUTO_TEST_CASE(is_compliant)
     }
 }
 
+BOOST_AUTO_TEST_CASE(data_range_validator)
+{
+    using namespace owlapi;
+
+    OWLFacetRestriction::List facetRestrictions;
+    facetRestrictions.push_back(OWLFacetRestriction(OWLFacet::getFacet(vocabulary::XSD::minInclusive()),
+                OWLLiteral::doubleValue(1.2)));
+    facetRestrictions.push_back(OWLFacetRestriction(OWLFacet::getFacet(vocabulary::XSD::maxExclusive()),
+                OWLLiteral::integer(10)));
+    OWLDataType::Ptr doubleType = make_shared<OWLDataType>(vocabulary::XSD::resolve("double"));
+    OWLDataRange::Ptr restriction = make_shared<OWLDataTypeRestriction>(doubleType, facetRestrictions);
+
+    DataRangeValidator::Ptr validator = DataRangeValidator::compile(restriction);
+    std::vector<std::string> values = { "1.1", "1.2", "5", "9.99", "10", "abc" };
+    std::vector<bool> valid = validator->validate(values);
+    std::vector<bool> expected = { false, true, true, true, false, false };
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        BOOST_REQUIRE_MESSAGE(valid[i] == expected[i], "Value " << values[i] << " validated as " << valid[i]);
+        BOOST_REQUIRE_MESSAGE(validator->isValid(values[i]) == expected[i], "Single value " << values[i]);
+    }
+    BOOST_REQUIRE_THROW(OWLDataType::fromRange(restriction, "20"), std::invalid_argument);
+
+    OWLLiteral::PtrList literals = { OWLLiteral::create("low"), OWLLiteral::create("high") };
+    OWLDataRange::Ptr oneOf = make_shared<OWLDataOneOf>(literals);
+    DataRangeValidator::Ptr unionValidator = DataRangeValidator::compile( OWLDataRange::PtrList{ restriction, oneOf } );
+    BOOST_REQUIRE(unionValidator->isValid("low"));
+    BOOST_REQUIRE(unionValidator->isValid("2"));
+    BOOST_REQUIRE(!unionValidator->isValid("medium"));
+
+    // dateTime bounds are compared as points in time
+    OWLFacetRestriction::List dateTimeRestrictions;
+    dateTimeRestrictions.push_back(OWLFacetRestriction(OWLFacet::getFacet(vocabulary::XSD::minInclusive()),
+                OWLLiteral::create("2018-01-01T00:00:00Z^^" + vocabulary::XSD::dateTime().toString())));
+    dateTimeRestrictions.push_back(OWLFacetRestriction(OWLFacet::getFacet(vocabulary::XSD::maxExclusive()),
+                OWLLiteral::create("2019-01-01T00:00:00Z^^" + vocabulary::XSD::dateTime().toString())));
+    OWLDataType::Ptr dateTimeType = make_shared<OWLDataType>(vocabulary::XSD::dateTime());
+    DataRangeValidator::Ptr dateTimeValidator = DataRangeValidator::compile(
+            make_shared<OWLDataTypeRestriction>(dateTimeType, dateTimeRestrictions));
+    BOOST_REQUIRE(dateTimeValidator->isValid("2018-06-01T12:00:00+02:00"));
+    BOOST_REQUIRE(!dateTimeValidator->isValid("2019-01-01T00:00:00Z"));
+    BOOST_REQUIRE(!dateTimeValidator->isValid("2017-12-31T23:59:59Z"));
+    BOOST_REQUIRE(!dateTimeValidator->isValid("42"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,7 +1,11 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <fstream>
+#include <thread>
 #include <owlapi/OWLApi.hpp>
 #include <owlapi/io/OWLOntologyIO.hpp>
+#include <owlapi/io/ChangeJournal.hpp>
 #include <owlapi/io/RedlandWriter.hpp>
 #include <owlapi/io/RedlandReader.hpp>
 #include "test_utils.hpp"
@@ -69,6 +73,280 @@ BOOST_AUTO_TEST_CASE(redland_reader)
     }
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_reading)
+{
+    std::string restrictions = getRootDir() + "test/data/test-restrictions.ttl";
+    std::string schema = getRootDir() + "test/data/om-schema-v0.6.owl";
+
+    int expectedSize = 0;
+    {
+        owlapi::io::RedlandReader reader;
+        reader.setFormat("turtle");
+        reader.read(restrictions);
+        expectedSize = librdf_model_size(reader.getModel());
+        BOOST_REQUIRE_MESSAGE(reader.consumeBlankNodeId() > 1, "Blank node ids have been generated");
+    }
+    BOOST_REQUIRE(RedlandReader::getNumberOfPooledWorlds() > 0);
+
+    size_t numberOfThreads = 8;
+    size_t numberOfIterations = 20;
+    std::atomic<size_t> failures(0);
+    std::vector<size_t> numberOfAxioms(numberOfThreads, 0);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < numberOfThreads; ++t)
+    {
+        threads.push_back(std::thread([&, t]()
+        {
+            try {
+                for(size_t i = 0; i < numberOfIterations; ++i)
+                {
+                    owlapi::io::RedlandReader reader;
+                    reader.setFormat("turtle");
+                    reader.read(restrictions);
+                    // blank node ids differ between readers, but the
+                    // models have to be of the same size
+                    if(librdf_model_size(reader.getModel()) != expectedSize)
+                    {
+                        ++failures;
+                    }
+                }
+                numberOfAxioms[t] = OWLOntologyIO::fromFile(schema)->getAxioms().size();
+            } catch(...)
+            {
+                ++failures;
+            }
+        }));
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    BOOST_REQUIRE_EQUAL(failures.load(), 0u);
+    for(size_t axioms : numberOfAxioms)
+    {
+        BOOST_REQUIRE_MESSAGE(axioms > 0 && axioms == numberOfAxioms.front(), "Ontologies loaded in parallel are identical");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(imported_blank_nodes)
+{
+    namespace fs = boost::filesystem;
+    fs::path directory = fs::temp_directory_path() / fs::unique_path("owlapi-test-io-%%%%-%%%%");
+    fs::create_directories(directory);
+
+    std::string prefixes =
+        "@prefix rdfs: <http://www.w3.org/2000/01/rdf-schema#> .\n"
+        "@prefix owl: <http://www.w3.org/2002/07/owl#> .\n"
+        "@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .\n"
+        "@prefix : <http://www.rock-robotics.org/test/turtle/blank-nodes#> .\n";
+
+    // Both documents start with a blank node, so that readers with
+    // separate counters would generate the same ids
+    IRI importedIRI("http://www.rock-robotics.org/test/turtle/blank-nodes-imported");
+    {
+        std::ofstream file((directory / (OWLOntologyIO::canonizeForOfflineUsage(importedIRI) + ".ttl")).string());
+        file << prefixes
+            << ":RobotB a owl:Class ; rdfs:subClassOf [ a owl:Restriction ;\n"
+               "    owl:minQualifiedCardinality \"2\"^^xsd:nonNegativeInteger ;\n"
+               "    owl:onClass :ResourceB ; owl:onProperty :has ] .\n"
+            << "<" << importedIRI.toString() << "> a owl:Ontology .\n"
+            << ":ResourceB a owl:Class .\n"
+               ":has a owl:ObjectProperty .\n";
+    }
+    std::string filename = (directory / "blank-nodes.ttl").string();
+    {
+        std::ofstream file(filename);
+        file << prefixes
+            << ":RobotA a owl:Class ; rdfs:subClassOf [ a owl:Restriction ;\n"
+               "    owl:maxQualifiedCardinality \"1\"^^xsd:nonNegativeInteger ;\n"
+               "    owl:onClass :ResourceA ; owl:onProperty :has ] .\n"
+            << "<http://www.rock-robotics.org/test/turtle/blank-nodes> a owl:Ontology ;\n"
+               "    owl:imports <" << importedIRI.toString() << "> .\n"
+            << ":ResourceA a owl:Class .\n";
+    }
+
+    const char* ontologiesPath = getenv("OWLAPI_ONTOLOGIES_PATH");
+    std::string previousOntologiesPath = ontologiesPath ? ontologiesPath : "";
+    setenv("OWLAPI_ONTOLOGIES_PATH", directory.string().c_str(), 1);
+
+    OWLOntology::Ptr ontology;
+    try {
+        ontology = OWLOntologyIO::fromFile(filename);
+    } catch(...)
+    {
+        setenv("OWLAPI_ONTOLOGIES_PATH", previousOntologiesPath.c_str(), 1);
+        fs::remove_all(directory);
+        throw;
+    }
+    setenv("OWLAPI_ONTOLOGIES_PATH", previousOntologiesPath.c_str(), 1);
+    fs::remove_all(directory);
+
+    owlapi::vocabulary::Custom vocab("http://www.rock-robotics.org/test/turtle/blank-nodes#");
+    OWLOntologyAsk ask(ontology);
+    OWLCardinalityRestriction::PtrList restrictionsA = ask.getCardinalityRestrictions(vocab.resolve("RobotA"), vocab.resolve("has"));
+    OWLCardinalityRestriction::PtrList restrictionsB = ask.getCardinalityRestrictions(vocab.resolve("RobotB"), vocab.resolve("has"));
+    BOOST_REQUIRE_MESSAGE(restrictionsA.size() == 1, "RobotA has 1 restriction, found: " << OWLCardinalityRestriction::toString(restrictionsA, 4));
+    BOOST_REQUIRE_MESSAGE(restrictionsB.size() == 1, "RobotB has 1 restriction, found: " << OWLCardinalityRestriction::toString(restrictionsB, 4));
+
+    BOOST_REQUIRE_EQUAL(restrictionsA.front()->getCardinalityRestrictionType(), OWLCardinalityRestriction::MAX);
+    BOOST_REQUIRE_EQUAL(restrictionsA.front()->getCardinality(), 1u);
+    BOOST_REQUIRE_EQUAL(restrictionsB.front()->getCardinalityRestrictionType(), OWLCardinalityRestriction::MIN);
+    BOOST_REQUIRE_EQUAL(restrictionsB.front()->getCardinality(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(reload)
+{
+    std::string filename = (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("owlapi-test-io-reload-%%%%-%%%%.ttl")).string();
+    std::string header =
+        "@prefix : <http://www.rock-robotics.org/test/turtle/reload#> .\n"
+        "@prefix rdfs: <http://www.w3.org/2000/01/rdf-schema#> .\n"
+        "@prefix owl: <http://www.w3.org/2002/07/owl#> .\n"
+        "@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .\n"
+        "<http://www.rock-robotics.org/test/turtle/reload> a owl:Ontology .\n"
+        ":has a owl:ObjectProperty .\n"
+        ":A a owl:Class ; rdfs:subClassOf :B .\n"
+        ":B a owl:Class .\n"
+        ":C a owl:Class .\n"
+        ":R a owl:Class ; rdfs:subClassOf [ a owl:Restriction ;\n"
+        "    owl:maxQualifiedCardinality \"1\"^^xsd:nonNegativeInteger ;\n"
+        "    owl:onClass :B ; owl:onProperty :has ] .\n";
+    {
+        std::ofstream file(filename);
+        file << header;
+    }
+
+    OWLOntology::Ptr ontology = OWLOntologyIO::fromFile(filename);
+    IRI a("http://www.rock-robotics.org/test/turtle/reload#A");
+    IRI b("http://www.rock-robotics.org/test/turtle/reload#B");
+    IRI c("http://www.rock-robotics.org/test/turtle/reload#C");
+    IRI d("http://www.rock-robotics.org/test/turtle/reload#D");
+    IRI r("http://www.rock-robotics.org/test/turtle/reload#R");
+    IRI has("http://www.rock-robotics.org/test/turtle/reload#has");
+    OWLOntologyAsk ask(ontology);
+    BOOST_REQUIRE(ask.isSubClassOf(a, b));
+
+    OWLOntologyDelta delta = OWLOntologyIO::reload(ontology);
+    BOOST_REQUIRE_MESSAGE(delta.empty(), "Reload of unchanged document has no effect: added "
+            << delta.added.size() << ", removed " << delta.removed.size());
+
+    {
+        std::ofstream file(filename);
+        file << header.substr(0, header.find(":A a owl:Class"));
+        file << ":A a owl:Class ; rdfs:subClassOf :C .\n"
+            ":B a owl:Class .\n"
+            ":C a owl:Class .\n"
+            ":D a owl:Class ; rdfs:subClassOf :B, [ a owl:Restriction ;\n"
+            "    owl:minQualifiedCardinality \"2\"^^xsd:nonNegativeInteger ;\n"
+            "    owl:onClass :C ; owl:onProperty :has ] .\n";
+    }
+
+    size_t numberOfAxioms = ontology->getAxioms().size();
+    delta = OWLOntologyIO::reload(ontology);
+    boost::filesystem::remove(filename);
+    // the subclass axioms of A and R have been removed
+    BOOST_REQUIRE_EQUAL(delta.removed.size(), 2u);
+    BOOST_REQUIRE(!delta.added.empty());
+    BOOST_REQUIRE_EQUAL(ontology->getAxioms().size(), numberOfAxioms + delta.added.size() - delta.removed.size());
+
+    BOOST_REQUIRE(ask.isSubClassOf(a, c));
+    BOOST_REQUIRE(!ask.isSubClassOf(a, b));
+    BOOST_REQUIRE(ask.isSubClassOf(d, b));
+
+    // the restriction of D refers to an anonymous expression of the
+    // reloaded document
+    BOOST_REQUIRE(ask.getCardinalityRestrictions(r, has).empty());
+    OWLCardinalityRestriction::PtrList restrictions = ask.getCardinalityRestrictions(d, has);
+    BOOST_REQUIRE_MESSAGE(restrictions.size() == 1, "D has 1 restriction, found: " << OWLCardinalityRestriction::toString(restrictions, 4));
+    BOOST_REQUIRE_EQUAL(restrictions.front()->getCardinalityRestrictionType(), OWLCardinalityRestriction::MIN);
+    BOOST_REQUIRE_EQUAL(restrictions.front()->getCardinality(), 2u);
+    for(const OWLAxiom::Ptr& axiom : delta.added)
+    {
+        BOOST_REQUIRE_EQUAL(axiom->getOrigin(), ontology->getIRI());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(change_journal)
+{
+    std::string journalFile = "/tmp/owlapi-test-io-journal";
+    std::string snapshotFile = "/tmp/owlapi-test-io-journal-snapshot.ttl";
+    boost::filesystem::remove(journalFile);
+    boost::filesystem::remove(snapshotFile);
+
+    IRI robot("http://www.rock-robotics.org/test/journal#Robot");
+    IRI sherpa("http://www.rock-robotics.org/test/journal#Sherpa");
+    IRI crex("http://www.rock-robotics.org/test/journal#CREX");
+    IRI has("http://www.rock-robotics.org/test/journal#has");
+    IRI mass("http://www.rock-robotics.org/test/journal#mass");
+    IRI xsdDouble = owlapi::vocabulary::XSD::resolve("double");
+
+    OWLOntology::Ptr ontology = owlapi::make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+    tell.initializeDefaultClasses();
+
+    ChangeJournal::Options options;
+    options.groupSize = 4;
+    ChangeJournal journal(journalFile, options);
+    journal.attach(ontology);
+
+    tell.klass(robot);
+    tell.objectProperty(has);
+    tell.dataProperty(mass);
+    tell.instanceOf(sherpa, robot);
+    tell.instanceOf(crex, robot);
+    tell.relatedTo(sherpa, has, crex);
+    tell.valueOf(sherpa, mass, OWLLiteral::create("160.0", xsdDouble));
+    tell.removeIndividual(crex);
+    journal.commit();
+    BOOST_REQUIRE(!journal.isSnapshotRequired());
+    BOOST_REQUIRE_EQUAL(journal.getNumberOfPendingChanges(), 0);
+
+    {
+        OWLOntology::Ptr recovered = ChangeJournal::recover(snapshotFile, journalFile);
+        OWLOntologyAsk ask(recovered);
+        BOOST_REQUIRE_EQUAL(ask.allInstancesOf(robot).size(), 1);
+        BOOST_REQUIRE_EQUAL(ask.getDataValue(sherpa, mass)->getDouble(), 160.0);
+    }
+
+    {
+        // replaying removals keeps an existing callback
+        size_t observed = 0;
+        OWLOntology::Ptr replayed = owlapi::make_shared<OWLOntology>();
+        replayed->setAxiomChangeCallback([&observed](const OWLAxiom::Ptr&, bool) { ++observed; });
+        ChangeJournal::replay(journalFile, replayed);
+        BOOST_REQUIRE(replayed->getAxiomChangeCallback());
+        BOOST_REQUIRE(observed > 0);
+        size_t observedByReplay = observed;
+        OWLOntologyTell(replayed).klass(sherpa);
+        BOOST_REQUIRE_EQUAL(observed, observedByReplay + 1);
+    }
+
+    journal.compact(snapshotFile);
+    BOOST_REQUIRE_EQUAL(journal.getNumberOfCommittedChanges(), 0);
+    BOOST_REQUIRE(boost::filesystem::exists(snapshotFile));
+
+    tell.instanceOf(crex, robot);
+    journal.sync();
+
+    OWLOntology::Ptr recovered = ChangeJournal::recover(snapshotFile, journalFile);
+    OWLOntologyAsk ask(recovered);
+    BOOST_REQUIRE_EQUAL(ask.allInstancesOf(robot).size(), 2);
+    BOOST_REQUIRE_EQUAL(ask.getDataValue(sherpa, mass)->getDouble(), 160.0);
+
+    // an axiom which cannot be journaled requires a snapshot, also after a
+    // restart
+    IRI vehicle("http://www.rock-robotics.org/test/journal#Vehicle");
+    tell.klass(vehicle);
+    tell.subClassOf(robot, tell.objectComplementOf(IRI("http://www.rock-robotics.org/test/journal#NotVehicle"), vehicle));
+    journal.sync();
+    BOOST_REQUIRE(journal.isSnapshotRequired());
+    {
+        ChangeJournal reopened(journalFile);
+        BOOST_REQUIRE(reopened.isSnapshotRequired());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(formats)
 {
     using namespace owlapi::io;
@@ -1,9 +1,12 @@
 #include <boost/test/unit_test.hpp>
 #include "test_utils.hpp"
 
+#include <algorithm>
 #include <boost/foreach.hpp>
 #include <owlapi/KnowledgeBase.hpp>
+#include <owlapi/Instrumentation.hpp>
 #include <owlapi/vocabularies/OWL.hpp>
+#include <owlapi/reasoner/factpp/EntityRegistry.hpp>
 
 #include <factpp/Kernel.h>
 #include <factpp/Actor.h>
@@ -97,6 +100,60 @@ BOOST_AUTO_TEST_CASE(class_hierarchy)
     BOOST_REQUIRE_MESSAGE( klasses.size() == 3, "Number of classes is '" << klasses.size() << "' expected 3");
 }
 
+BOOST_AUTO_TEST_CASE(taxonomy)
+{
+    KnowledgeBase kb;
+    kb.subClassOf("Derived", "Base");
+    kb.subClassOf("OtherDerived", "Base");
+    kb.subClassOf("DerivedDerived", "Derived");
+    kb.subClassOf("DerivedDerived", "OtherDerived");
+
+    Taxonomy::Ptr taxonomy = kb.getTaxonomy();
+    std::vector<IRIList> descendants = taxonomy->getDescendantsWithDistance("Base");
+    BOOST_REQUIRE_MESSAGE(descendants.size() == 3, "Descendants of Base span '" << descendants.size() << "' levels, expected 3");
+    BOOST_REQUIRE_MESSAGE(descendants[0].size() == 2, "Base has 2 direct subclasses");
+    BOOST_REQUIRE_MESSAGE(descendants[1].size() == 1, "DerivedDerived is listed once");
+    BOOST_REQUIRE(descendants[2].empty());
+
+    IRIList leaves = taxonomy->getLeaves("Base");
+    BOOST_REQUIRE_MESSAGE(leaves.size() == 1 && leaves[0] == IRI("DerivedDerived"), "DerivedDerived is the only leaf");
+
+    Taxonomy::NodeId node = taxonomy->getId("DerivedDerived");
+    BOOST_REQUIRE_MESSAGE(taxonomy->getParents(node).size() == 2, "DerivedDerived has two parents");
+
+    kb.subClassOf("Leaf", "DerivedDerived");
+    kb.classify();
+    leaves = kb.getTaxonomy()->getLeaves("Base");
+    BOOST_REQUIRE_MESSAGE(leaves.size() == 1 && leaves[0] == IRI("Leaf"), "Taxonomy is updated after classification");
+}
+
+BOOST_AUTO_TEST_CASE(related_instances_of_class)
+{
+    KnowledgeBase kb;
+    kb.setVerbose();
+    kb.subClassOf("Derived", "Base");
+    kb.instanceOf("A", "Base");
+    kb.instanceOf("B", "Derived");
+    kb.instanceOf("C", "Other");
+    kb.relatedTo("A", "has", "B");
+    kb.relatedTo("A", "has", "C");
+    kb.refresh();
+
+    IRIList related = kb.allRelatedInstances("A", "has");
+    BOOST_REQUIRE_MESSAGE(related.size() == 2, "A has '" << related.size() << "' related instances, expected 2");
+    related = kb.allRelatedInstances("A", "has", "Base");
+    BOOST_REQUIRE_MESSAGE(related.size() == 1 && related[0] == IRI("B"), "A has a single related instance of Base");
+    BOOST_REQUIRE_MESSAGE(kb.relatedInstance("A", "has", "Other") == IRI("C"), "C is related instance of type Other");
+
+    // Cached instance set has to reflect updates
+    kb.instanceOf("C", "Derived");
+    related = kb.allRelatedInstances("A", "has", "Base");
+    BOOST_REQUIRE_MESSAGE(related.size() == 2, "A has '" << related.size() << "' related instances of Base after update, expected 2");
+
+    related = kb.allInverseRelatedInstances("B", "has", "Base");
+    BOOST_REQUIRE_MESSAGE(related.size() == 1 && related[0] == IRI("A"), "B is inversely related to A");
+}
+
 BOOST_AUTO_TEST_CASE(property_hierarchy)
 {
     using namespace reasoner::factpp;
@@ -148,6 +205,34 @@ BOOST_AUTO_TEST_CASE(disjointness)
             " other base should be disjoint");
 }
 
+BOOST_AUTO_TEST_CASE(same_as)
+{
+    using namespace reasoner::factpp;
+
+    KnowledgeBase kb;
+    kb.setVerbose();
+    kb.instanceOf("A","Base");
+    kb.instanceOf("B","Base");
+    kb.instanceOf("C","Base");
+    kb.alias("A1","A", KnowledgeBase::INSTANCE);
+    Axiom a = kb.alias("A2","A1", KnowledgeBase::INSTANCE);
+    kb.refresh();
+
+    BOOST_REQUIRE_MESSAGE(kb.isSameInstance("A","A2"), "A and A2 refer to the same");
+    IRIList sameAs = kb.getSameAs("A2");
+    BOOST_REQUIRE_MESSAGE(sameAs.size() == 3, "A2 has '" << sameAs.size() << "' aliases, expected 3");
+
+    IRIList unique = kb.uniqueList({ IRI("A"), IRI("B"), IRI("A1"), IRI("C"), IRI("A2") });
+    BOOST_REQUIRE_MESSAGE(unique.size() == 3, "Unique list has '" << unique.size() << "' entries, expected 3");
+    BOOST_REQUIRE_MESSAGE(unique[0] == IRI("A"), "First occurrence is kept");
+
+    kb.retract(a);
+    kb.refresh();
+    BOOST_REQUIRE_MESSAGE(!kb.isSameInstance("A","A2"), "A and A2 differ after retraction");
+    sameAs = kb.getSameAs("A");
+    BOOST_REQUIRE_MESSAGE(sameAs.size() == 2, "A has '" << sameAs.size() << "' aliases after retraction, expected 2");
+}
+
 BOOST_AUTO_TEST_CASE(data_value)
 {
     KnowledgeBase kb;
@@ -498,4 +583,102 @@ BOOST_AUTO_TEST_CASE(object_restriction_equivalence)
     BOOST_REQUIRE_MESSAGE(!kb.isInstanceOf(item_2, item_with_components), "Not adding parent class for item_2");
 }
 
+BOOST_AUTO_TEST_CASE(async_classification)
+{
+    KnowledgeBase kb;
+    kb.subClassOf("Derived", "Base");
+
+    KnowledgeBase::TaxonomySnapshot snapshot = kb.getTaxonomySnapshot();
+    BOOST_REQUIRE_MESSAGE(!snapshot.taxonomy && snapshot.stale, "No snapshot before classification");
+
+    std::promise<bool> notified;
+    std::shared_future<uint64_t> generation = kb.classifyAsync([&kb, &notified](uint64_t g)
+            {
+                // the reasoning has been completed when calling back
+                notified.set_value(g == kb.getTaxonomySnapshot().generation && kb.isSubClassOf("Derived", "Base"));
+            });
+    BOOST_REQUIRE_MESSAGE(notified.get_future().get(), "Callback queries the classified knowledge base");
+    BOOST_REQUIRE(!kb.isReasoning());
+
+    snapshot = kb.getTaxonomySnapshot();
+    BOOST_REQUIRE_MESSAGE(snapshot.taxonomy && !snapshot.stale, "Snapshot is available after classification");
+    BOOST_REQUIRE_EQUAL(snapshot.generation, generation.get());
+    BOOST_REQUIRE(snapshot.taxonomy->getLeaves("Base") == IRIList(1, IRI("Derived")));
+
+    kb.subClassOf("DerivedDerived", "Derived");
+    BOOST_REQUIRE_MESSAGE(kb.getTaxonomySnapshot().stale, "Snapshot is stale after adding an axiom");
+    generation = kb.classifyAsync();
+    // the class is not part of the last snapshot, so the query waits for
+    // the background classification
+    BOOST_REQUIRE(kb.isSubClassOf("DerivedDerived", "Base"));
+    snapshot = kb.getTaxonomySnapshot();
+    BOOST_REQUIRE_EQUAL(snapshot.generation, generation.get());
+    BOOST_REQUIRE(snapshot.taxonomy->getLeaves("Base") == IRIList(1, IRI("DerivedDerived")));
+    BOOST_REQUIRE(kb.getTaxonomy() == snapshot.taxonomy);
+}
+
+BOOST_AUTO_TEST_CASE(instrumentation)
+{
+    Instrumentation::reset();
+
+    KnowledgeBase kb;
+    kb.subClassOf("Derived", "Base");
+    kb.instanceOf("instance", "Derived");
+    kb.classify();
+    BOOST_REQUIRE_MESSAGE(kb.isInstanceOf("instance", "Base"), "Instance of base");
+    kb.allInstancesOf("Base");
+
+    Instrumentation::StatisticsList statistics = Instrumentation::snapshot();
+    std::string json = Instrumentation::toJSON();
+    BOOST_TEST_MESSAGE("Statistics: " << json);
+    if(!Instrumentation::isEnabled())
+    {
+        BOOST_REQUIRE_MESSAGE(statistics.empty(), "No statistics without instrumentation");
+        BOOST_REQUIRE_EQUAL(json, "{}");
+        return;
+    }
+
+    std::map<Instrumentation::Operation, uint64_t> counts;
+    for(const Instrumentation::Statistics& s : statistics)
+    {
+        counts[s.operation] = s.count;
+        BOOST_REQUIRE(s.minNs <= s.maxNs);
+    }
+    BOOST_REQUIRE_EQUAL(counts[Instrumentation::KB_CLASSIFY], 1);
+    BOOST_REQUIRE(counts[Instrumentation::KB_ENTAILMENT_QUERY] >= 1);
+    BOOST_REQUIRE(counts[Instrumentation::KB_ACTOR_QUERY] >= 1);
+    BOOST_REQUIRE(json.find("\"kb_classify\"") != std::string::npos);
+
+    Instrumentation::reset();
+    BOOST_REQUIRE_MESSAGE(Instrumentation::snapshot().empty(), "Statistics are reset");
+}
+
+BOOST_AUTO_TEST_CASE(entity_registry)
+{
+    reasoner::factpp::EntityRegistry<int> registry;
+    for(int i = 0; i < 1000; ++i)
+    {
+        std::pair<int*, bool> entry = registry.insert(IRI("http://example.org/onto#e" + std::to_string(i)));
+        BOOST_REQUIRE(entry.second);
+        *entry.first = i;
+    }
+    BOOST_REQUIRE_EQUAL(registry.size(), 1000);
+    BOOST_REQUIRE_EQUAL(*registry.find(IRI("http://example.org/onto#e42")), 42);
+    BOOST_REQUIRE(!registry.find(IRI("http://example.org/onto#e1000")));
+    BOOST_REQUIRE(!registry.insert(IRI("http://example.org/onto#e999")).second);
+    // entities are identified by their string representation
+    BOOST_REQUIRE_EQUAL(*registry.find(IRI("http://example.org/", "onto#e7")), 7);
+
+    KnowledgeBase kb;
+    IRI derived("http://example.org/onto#Derived");
+    IRI base("http://example.org/onto#Base");
+    kb.subClassOf(derived, base);
+    BOOST_REQUIRE(kb.getClassLazy(IRI("http://example.org/", "onto#Derived")).get() == kb.getClass(derived).get());
+    BOOST_REQUIRE_THROW(kb.getClass(IRI("http://example.org/onto#Unknown")), std::invalid_argument);
+
+    IRIList klasses = kb.allClasses();
+    BOOST_REQUIRE(std::is_sorted(klasses.begin(), klasses.end()));
+    BOOST_REQUIRE_EQUAL(std::count(klasses.begin(), klasses.end(), derived), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
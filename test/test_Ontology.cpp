@@ -1,10 +1,25 @@
 #include <boost/test/unit_test.hpp>
 #include "test_utils.hpp"
+#include <limits>
+#include <algorithm>
 
 #include <owlapi/model/OWLOntology.hpp>
 #include <owlapi/io/OWLOntologyIO.hpp>
 #include <owlapi/model/OWLOntologyAsk.hpp>
 #include <owlapi/model/OWLOntologyTell.hpp>
+#include <owlapi/utils/OWLEntityRemover.hpp>
+#include <owlapi/model/AddAxiom.hpp>
+#include <owlapi/model/RemoveAxiom.hpp>
+#include <owlapi/model/SyntacticLocalityModuleExtractor.hpp>
+#include <owlapi/model/ParallelClassifier.hpp>
+#include <owlapi/model/OWLObjectSomeValuesFrom.hpp>
+#include <owlapi/model/OWLObjectIntersectionOf.hpp>
+#include <owlapi/model/OWL2ELProfile.hpp>
+#include <owlapi/model/ELClassifier.hpp>
+#include <owlapi/model/RLMaterializer.hpp>
+#include <owlapi/model/OWLObjectAllValuesFrom.hpp>
+#include <owlapi/model/OWLDataSomeValuesFrom.hpp>
+#include <owlapi/model/OWLDataHasValue.hpp>
 
 using namespace owlapi;
 using namespace owlapi::model;
@@ -410,6 +425,39 @@ BOOST_AUTO_TEST_CASE(annotations)
     BOOST_CHECK_MESSAGE(iri == IRI(), "Is not an IRI " << iri);
 }
 
+BOOST_AUTO_TEST_CASE(annotation_index)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI base("http://my-classes#Base");
+    IRI derived("http://my-classes#Derived");
+    IRI unit("http://my-classes#unit");
+    IRI label("http://my-classes#label");
+
+    tell.subClassOf(derived, base);
+    tell.annotationProperty(unit);
+    tell.annotationProperty(label);
+    tell.annotationOf(base, unit, IRI("http://my-units#meter"));
+    OWLAxiom::Ptr axiom = tell.annotationOf(base, label, IRI("http://my-labels#base"));
+    ontology->refresh();
+
+    BOOST_REQUIRE_MESSAGE(ask.getAnnotationValue(base, unit)->asIRI() == IRI("http://my-units#meter"), "Annotation of base");
+    BOOST_REQUIRE_MESSAGE(ask.getAnnotationValue(derived, unit)->asIRI() == IRI("http://my-units#meter"), "Annotation inherited from base");
+    BOOST_REQUIRE_THROW(ask.getAnnotationValue(derived, unit, false), std::invalid_argument);
+    BOOST_REQUIRE_MESSAGE(ask.getAnnotationAssertionAxioms(base).size() == 2, "Base has two annotations");
+    BOOST_REQUIRE_MESSAGE(ask.getAnnotationAssertionAxioms(derived).empty(), "Derived has no annotations");
+
+    // The nearest ancestor takes precedence, regardless of the order of the
+    // IRIs
+    IRI abstract("http://my-classes#Abstract");
+    tell.subClassOf(base, abstract);
+    tell.annotationOf(abstract, unit, IRI("http://my-units#kilometer"));
+    ontology->refresh();
+    BOOST_REQUIRE_MESSAGE(ask.getAnnotationValue(derived, unit)->asIRI() == IRI("http://my-units#meter"), "Annotation inherited from nearest ancestor");
+}
+
 BOOST_AUTO_TEST_CASE(data_restriction_equivalence)
 {
     OWLOntology::Ptr ontology = OWLOntology::fromFile(getRootDir() +
@@ -468,4 +516,863 @@ BOOST_AUTO_TEST_CASE(object_restriction_equivalence)
     }
 }
 
+BOOST_AUTO_TEST_CASE(arena)
+{
+    OWLClass::Ptr klassPtr;
+    {
+        OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+        ontology->enableArena(1024);
+        OWLOntologyAsk ask(ontology);
+        OWLOntologyTell tell(ontology);
+
+        IRI klass("http://my-classes#class-0");
+        IRI superKlass("http://my-classes#class-1");
+        tell.subClassOf(klass, superKlass);
+        for(size_t i = 0; i < 100; ++i)
+        {
+            tell.instanceOf(IRI("http://my-classes#class-0-instance-" + std::to_string(i)), klass);
+        }
+        ontology->refresh();
+
+        BOOST_REQUIRE_MESSAGE(ontology->getArena()->getAllocatedBytes() > 0, "Objects have been allocated from the arena");
+        BOOST_REQUIRE_MESSAGE(ontology->getArena()->getNumberOfBlocks() > 1, "Arena has grown beyond a single block");
+        BOOST_REQUIRE_MESSAGE(ask.allInstancesOf(superKlass).size() == 100, "All instances known");
+
+        OWLOntology::Ptr child = ontology->fork();
+        BOOST_REQUIRE_MESSAGE(child->getArena() && child->getArena() != ontology->getArena(), "Fork uses its own arena");
+
+        OWLOntologyChange::PtrList changes;
+        for(const OWLAxiom::Ptr& axiom : ontology->getAxioms())
+        {
+            if(axiom->getAxiomType() == OWLAxiom::ClassAssertion)
+            {
+                changes.push_back(make_shared<RemoveAxiom>(ontology, axiom));
+            }
+        }
+        child.reset();
+        ontology->applyChanges(changes);
+        changes.clear();
+
+        size_t freeBytes = ontology->getArena()->getFreeBytes();
+        BOOST_REQUIRE_MESSAGE(freeBytes > 0, "Memory of retracted axioms is released to the arena");
+        tell.instanceOf(IRI("http://my-classes#class-0-instance-0"), klass);
+        BOOST_REQUIRE_MESSAGE(ontology->getArena()->getFreeBytes() < freeBytes, "Released memory is reused");
+
+        klassPtr = ask.getOWLClass(klass);
+    }
+    BOOST_REQUIRE_MESSAGE(klassPtr->getIRI() == IRI("http://my-classes#class-0"), "Object outlives its ontology");
+}
+
+BOOST_AUTO_TEST_CASE(fork)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class-0");
+    IRI instance("http://my-classes#class-0-instance-0");
+    IRI otherInstance("http://my-classes#class-0-instance-1");
+    IRI property("http://my-classes#property-0");
+
+    tell.klass(klass);
+    tell.objectProperty(property);
+    tell.instanceOf(instance, klass);
+    tell.instanceOf(otherInstance, klass);
+    ontology->refresh();
+
+    OWLOntology::Ptr child = ontology->fork();
+    OWLOntologyAsk childAsk(child);
+    OWLOntologyTell childTell(child);
+
+    BOOST_REQUIRE_MESSAGE(childAsk.isInstanceOf(instance, klass), "Fork: instance " << instance << " of " << klass);
+    BOOST_REQUIRE_MESSAGE(child->getAxioms().front() == ontology->getAxioms().front(), "Fork: axioms are shared");
+    BOOST_REQUIRE_MESSAGE(child->getJournal().getEntries().empty(), "Fork: nothing has been journaled");
+
+    childTell.relatedTo(instance, property, otherInstance);
+    child->refresh();
+    BOOST_REQUIRE_MESSAGE(childAsk.isRelatedTo(instance, property, otherInstance), "Fork: relation has been added");
+    BOOST_REQUIRE_MESSAGE(!ask.isRelatedTo(instance, property, otherInstance), "Parent: relation has not been added");
+
+    childTell.removeIndividual(otherInstance);
+    BOOST_REQUIRE_MESSAGE(childAsk.allInstancesOf(klass).size() == 1, "Fork: one instance of " << klass);
+    BOOST_REQUIRE_MESSAGE(ask.allInstancesOf(klass).size() == 2, "Parent: two instances of " << klass);
+
+    OWLOntology::Ptr grandchild = child->fork();
+    OWLOntologyAsk grandchildAsk(grandchild);
+    BOOST_REQUIRE_MESSAGE(grandchildAsk.allInstancesOf(klass).size() == 1, "Fork of fork: one instance of " << klass);
+
+    {
+        OWLOntology::Ptr loaded = OWLOntology::fromFile(getRootDir() +
+                "/test/data/test-object-restrictions-equivalence-1.owl");
+        owlapi::vocabulary::Custom vocab("http://www.rock-robotics.org/test/turtle/restrictions#");
+
+        OWLOntologyAsk loadedAsk(loaded->fork());
+        BOOST_REQUIRE_MESSAGE(loadedAsk.isInstanceOf(vocab.resolve("RobotA"),
+                    vocab.resolve("MoveTo")), "Fork: RobotA is instance of MoveTo");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(journaling)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class-0");
+    IRI instance("http://my-classes#class-0-instance-0");
+
+    tell.instanceOf(instance, klass);
+    BOOST_REQUIRE_MESSAGE(!ontology->isJournaling(), "Journaling is disabled by default");
+    BOOST_REQUIRE(ontology->getJournal().getEntries().empty());
+
+    ontology->setJournaling(true);
+    tell.subClassOf(klass, IRI("http://my-classes#class-1"));
+    BOOST_REQUIRE_EQUAL(ontology->getJournal().getEntries().size(), 1);
+
+    // Changes which are applied to the ontology are journaled as well
+    OWLOntologyChange::PtrList changes;
+    for(const OWLAxiom::Ptr& axiom : ontology->getReferencingAxioms(instance))
+    {
+        changes.push_back(make_shared<RemoveAxiom>(ontology, axiom));
+    }
+    BOOST_REQUIRE_EQUAL(ontology->applyChanges(changes), CHANGE_SUCCESS);
+    BOOST_REQUIRE_EQUAL(ontology->getJournal().getEntries().size(), 2);
+
+    OWLOntology::Ptr child = ontology->fork();
+    BOOST_REQUIRE_MESSAGE(child->isJournaling(), "Fork journals if its parent does");
+    BOOST_REQUIRE(child->getJournal().getEntries().empty());
+
+    ontology->setJournaling(false);
+    BOOST_REQUIRE(ontology->getJournal().getEntries().empty());
+}
+
+BOOST_AUTO_TEST_CASE(literal_value)
+{
+    using namespace owlapi::vocabulary;
+
+    OWLLiteral::Ptr integer = OWLLiteral::create("-42^^" + XSD::integer().toString());
+    BOOST_REQUIRE(integer->getDatatypeId() == LiteralDatatype::INTEGER);
+    BOOST_REQUIRE(integer->getLiteralValue().getKind() == LiteralValue::INT64);
+    BOOST_REQUIRE_EQUAL(integer->getLiteralValue().asInt64(), -42);
+    BOOST_REQUIRE_EQUAL(integer->getInteger(), -42);
+    BOOST_REQUIRE_EQUAL(integer->getType(), XSD::integer().toString());
+    BOOST_REQUIRE_EQUAL(integer->toString(), "-42^^" + XSD::integer().toString());
+
+    OWLLiteral::Ptr count = OWLLiteral::create("18446744073709551615", XSD::unsignedLong().toString());
+    BOOST_REQUIRE(count->getLiteralValue().getKind() == LiteralValue::UINT64);
+    BOOST_REQUIRE_EQUAL(count->getLiteralValue().asUInt64(), 18446744073709551615ULL);
+
+    OWLLiteral::Ptr real = OWLLiteral::create("7.3", OWLDataType(XSD::resolve("double")));
+    BOOST_REQUIRE(real->isDouble());
+    BOOST_REQUIRE_CLOSE(real->getLiteralValue().asDouble(), 7.3, 0.0001);
+
+    OWLLiteral::Ptr flag = OWLLiteral::create("true^^" + XSD::boolean().toString());
+    BOOST_REQUIRE(flag->isBoolean());
+    BOOST_REQUIRE(flag->getLiteralValue().asBoolean());
+
+    OWLLiteral::Ptr time = OWLLiteral::create("1970-01-02T01:00:00.5+01:00^^" + XSD::dateTime().toString());
+    BOOST_REQUIRE(time->getLiteralValue().getKind() == LiteralValue::DATE_TIME);
+    BOOST_REQUIRE_EQUAL(time->getLiteralValue().asDateTime(), 86400500000LL);
+
+    OWLLiteral::Ptr plain = OWLLiteral::create("5");
+    BOOST_REQUIRE(plain->isPlainLiteral());
+    BOOST_REQUIRE(plain->getLiteralValue().getKind() == LiteralValue::STRING);
+    BOOST_REQUIRE_EQUAL(plain->getInteger(), 5);
+
+    OWLLiteral::Ptr invalid = OWLLiteral::create("abc", XSD::decimal().toString());
+    BOOST_REQUIRE(invalid->getLiteralValue().getKind() == LiteralValue::STRING);
+    BOOST_REQUIRE_THROW(invalid->getDouble(), std::runtime_error);
+    BOOST_REQUIRE_THROW(OWLLiteral::create("1.5", XSD::integer().toString()), std::runtime_error);
+
+    int64_t value;
+    std::string text = "9223372036854775808";
+    BOOST_REQUIRE(!LiteralValue::parse(text.data(), text.data() + text.size(), value));
+    text = "-9223372036854775808";
+    BOOST_REQUIRE(LiteralValue::parse(text.data(), text.data() + text.size(), value));
+    BOOST_REQUIRE(value == std::numeric_limits<int64_t>::min());
+
+    LiteralDatatype::Id custom = LiteralDatatype::intern("http://www.rock-robotics.org/test#custom");
+    BOOST_REQUIRE(custom >= LiteralDatatype::END_KNOWN);
+    BOOST_REQUIRE_EQUAL(LiteralDatatype::intern("http://www.rock-robotics.org/test#custom"), custom);
+}
+
+BOOST_AUTO_TEST_CASE(referencing_axioms)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    ontology->setIRI(IRI("http://my-classes"));
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+    OWLOntologyTell importTell(ontology, IRI("http://my-imports"));
+
+    IRI klass("http://my-classes#class-0");
+    IRI importedKlass("http://my-imports#class-1");
+    IRI relation("http://my-classes#knows");
+    IRI instance("http://my-classes#instance-0");
+    IRI other("http://my-classes#instance-1");
+
+    tell.klass(klass);
+    importTell.klass(importedKlass);
+    tell.objectProperty(relation);
+    tell.instanceOf(instance, klass);
+    tell.instanceOf(other, klass);
+    importTell.instanceOf(instance, importedKlass);
+    tell.relatedTo(instance, relation, other);
+    ontology->refresh();
+
+    // declaration, two class assertions and the object property assertion
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(instance).size(), 4);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(instance, true).size(), 3);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(other).size(), 3);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(relation).size(), 2);
+
+    utils::OWLEntityRemover remover(OWLOntology::PtrList(1, ontology));
+    OWLNamedIndividual individual(instance);
+    remover.visit(&individual);
+    BOOST_REQUIRE_EQUAL(remover.getChanges().size(), 3);
+
+    tell.removeIndividual(instance);
+    BOOST_REQUIRE_MESSAGE(ontology->getReferencingAxioms(instance).empty(), "No axioms referencing removed individual");
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(other).size(), 2);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(relation).size(), 1);
+    BOOST_REQUIRE_MESSAGE(ask.allInstancesOf(klass).size() == 1, "One instance remaining of klass " << klass);
+}
+
+BOOST_AUTO_TEST_CASE(module_extraction)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI robot("http://my-classes#Robot");
+    IRI agent("http://my-classes#Agent");
+    IRI gripper("http://my-classes#Gripper");
+    IRI tool("http://my-classes#Tool");
+    IRI hasPart("http://my-classes#hasPart");
+    IRI instance("http://my-classes#robot-0");
+
+    tell.subClassOf(robot, agent);
+    tell.subClassOf(gripper, tool);
+    tell.objectProperty(hasPart);
+    tell.objectPropertyDomainOf(hasPart, agent);
+    tell.instanceOf(instance, robot);
+    ontology->refresh();
+
+    SyntacticLocalityModuleExtractor extractor(ontology);
+    // subclass axiom and class assertion
+    OWLAxiom::PtrList module = extractor.extract(IRIList(1, robot));
+    BOOST_REQUIRE_MESSAGE(module.size() == 2, "Bottom module of Robot has 2 axioms, but got " << module.size());
+
+    OWLOntology::Ptr moduleOntology = extractor.extractAsOntology(IRIList(1, agent));
+    OWLOntologyAsk ask(moduleOntology);
+    BOOST_REQUIRE_MESSAGE(!ask.isOWLClass(gripper), "Module of Agent does not contain Gripper");
+    BOOST_REQUIRE_MESSAGE(!ask.isObjectProperty(hasPart), "Module of Agent does not contain hasPart");
+    BOOST_REQUIRE_MESSAGE(ask.isSubClassOf(robot, agent), "Module of Agent contains Robot as subclass");
+    BOOST_REQUIRE_MESSAGE(ask.allInstancesOf(agent).size() == 1, "Module of Agent contains the instance of Robot");
+
+    std::vector<IRIList> signatures;
+    signatures.push_back(IRIList(1, agent));
+    signatures.push_back(IRIList(1, gripper));
+    OWLOntology::PtrList modules = extractor.extractAsOntologies(signatures, 2);
+    BOOST_REQUIRE_EQUAL(modules.size(), 2);
+    BOOST_REQUIRE_MESSAGE(OWLOntologyAsk(modules[0]).isSubClassOf(robot, agent), "First module contains Robot as subclass");
+    BOOST_REQUIRE_MESSAGE(!OWLOntologyAsk(modules[0]).isOWLClass(gripper), "First module does not contain Gripper");
+    BOOST_REQUIRE_MESSAGE(OWLOntologyAsk(modules[1]).isSubClassOf(gripper, tool), "Second module contains Gripper as subclass");
+    BOOST_REQUIRE_MESSAGE(!OWLOntologyAsk(modules[1]).isOWLClass(robot), "Second module does not contain Robot");
+
+    module = SyntacticLocalityModuleExtractor(ontology, SyntacticLocalityModuleExtractor::TOP).extract(IRIList(1, tool));
+    BOOST_REQUIRE_MESSAGE(module.size() == 1, "Top module of Tool contains the subclass axiom only, but got " << module.size());
+
+    module = SyntacticLocalityModuleExtractor(ontology, SyntacticLocalityModuleExtractor::STAR).extract(IRIList(1, robot));
+    BOOST_REQUIRE_MESSAGE(module.size() == 1, "Star module of Robot contains the class assertion only, but got " << module.size());
+
+    // Modules only share the anonymous expressions which their axioms refer to
+    IRI device("http://my-classes#Device");
+    IRI toolAndDevice("http://my-classes#ToolAndDevice");
+    tell.klass(device);
+    IRIList operands = { tool, device };
+    tell.subClassOf(gripper, tell.objectIntersectionOf(toolAndDevice, operands));
+    ontology->refresh();
+    modules = extractor.extractAsOntologies(signatures);
+    BOOST_REQUIRE_THROW(OWLOntologyAsk(modules[0]).getOWLAnonymousClassExpression(toolAndDevice), std::runtime_error);
+    BOOST_REQUIRE(OWLOntologyAsk(modules[1]).getOWLAnonymousClassExpression(toolAndDevice));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_classification)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI robot("http://my-classes#Robot");
+    IRI mobileRobot("http://my-classes#MobileRobot");
+    IRI agent("http://my-classes#Agent");
+    IRI gripper("http://my-classes#Gripper");
+    IRI tool("http://my-classes#Tool");
+    IRI instance("http://my-classes#robot-0");
+
+    tell.subClassOf(robot, agent);
+    tell.subClassOf(mobileRobot, robot);
+    tell.subClassOf(gripper, tool);
+    tell.instanceOf(instance, mobileRobot);
+    ontology->refresh();
+
+    ParallelClassifier classifier(ontology, 2);
+    std::vector<IRIList> components = classifier.getComponents();
+    for(const IRIList& component : components)
+    {
+        bool hasRobot = std::find(component.begin(), component.end(), robot) != component.end();
+        bool hasAgent = std::find(component.begin(), component.end(), agent) != component.end();
+        bool hasGripper = std::find(component.begin(), component.end(), gripper) != component.end();
+        BOOST_REQUIRE_MESSAGE(hasRobot == hasAgent, "Robot and Agent are in the same component");
+        BOOST_REQUIRE_MESSAGE(!(hasRobot && hasGripper), "Robot and Gripper are in different components");
+    }
+
+    Taxonomy::Ptr taxonomy = classifier.classify();
+    OWLOntologyAsk ask(ontology);
+    BOOST_REQUIRE_MESSAGE(ask.getTaxonomy() == taxonomy, "Merged taxonomy is used by the ontology");
+
+    IRIList subclasses = ask.allSubClassesOf(agent);
+    BOOST_REQUIRE_MESSAGE(subclasses.size() == 2, "Agent has 2 subclasses, but got " << IRI::toString(subclasses));
+    BOOST_REQUIRE_MESSAGE(ask.allSubClassesOf(agent, true) == IRIList(1, robot), "Robot is the direct subclass of Agent");
+    BOOST_REQUIRE_MESSAGE(ask.allSubClassesOf(tool) == IRIList(1, gripper), "Gripper is the subclass of Tool");
+
+    IRIList ancestors = ask.ancestors(mobileRobot);
+    BOOST_REQUIRE_MESSAGE(std::find(ancestors.begin(), ancestors.end(), agent) != ancestors.end(), "Agent is an ancestor of MobileRobot");
+    BOOST_REQUIRE_MESSAGE(std::find(ancestors.begin(), ancestors.end(), tool) == ancestors.end(), "Tool is not an ancestor of MobileRobot");
+
+    for(const IRI& subclass : subclasses)
+    {
+        BOOST_REQUIRE_MESSAGE(ask.isSubClassOf(subclass, agent), "Subclass query agrees with the merged taxonomy for " << subclass);
+    }
+    BOOST_REQUIRE_MESSAGE(!ask.isSubClassOf(gripper, agent), "Gripper is not a subclass of Agent");
+
+    // adding any axiom drops the merged taxonomy
+    IRI hasPart("http://my-classes#hasPart");
+    tell.objectProperty(hasPart);
+    tell.objectPropertyDomainOf(hasPart, robot);
+    BOOST_REQUIRE_MESSAGE(ask.getTaxonomy() != taxonomy, "Merged taxonomy is dropped after adding a domain");
+
+    classifier.classify();
+    tell.subClassOf(tool, agent);
+    BOOST_REQUIRE_MESSAGE(ask.allSubClassesOf(agent).size() == 4, "Agent has 4 subclasses after update");
+}
+
+BOOST_AUTO_TEST_CASE(told_queries)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI robot("http://my-classes#Robot");
+    IRI gripper("http://my-classes#Gripper");
+    IRI hasPart("http://my-classes#hasPart");
+    IRI mass("http://my-classes#mass");
+    IRI robot0("http://my-classes#robot-0");
+    IRI gripper0("http://my-classes#gripper-0");
+
+    tell.klass(robot);
+    tell.klass(gripper);
+    tell.objectProperty(hasPart);
+    tell.dataProperty(mass);
+    tell.instanceOf(robot0, robot);
+    tell.instanceOf(gripper0, gripper);
+    tell.relatedTo(robot0, hasPart, gripper0);
+    OWLLiteral::Ptr value = OWLLiteral::create("0.5", owlapi::vocabulary::XSD::resolve("double"));
+    tell.valueOf(gripper0, mass, value);
+    ontology->refresh();
+
+    OWLOntologyAsk ask(ontology, OWLOntologyAsk::TOLD);
+    BOOST_REQUIRE(ask.getQueryMode() == OWLOntologyAsk::TOLD);
+    BOOST_REQUIRE_MESSAGE(ask.isRelatedTo(robot0, hasPart, gripper0), "Told relation robot-0 hasPart gripper-0");
+    BOOST_REQUIRE_MESSAGE(!ask.isRelatedTo(gripper0, hasPart, robot0), "No told relation gripper-0 hasPart robot-0");
+    BOOST_REQUIRE(ask.allRelatedInstances(robot0, hasPart) == IRIList(1, gripper0));
+    BOOST_REQUIRE(ask.allRelatedInstances(robot0, hasPart, gripper) == IRIList(1, gripper0));
+    BOOST_REQUIRE(ask.allRelatedInstances(robot0, hasPart, robot).empty());
+    BOOST_REQUIRE(ask.allInverseRelatedInstances(gripper0, hasPart, robot) == IRIList(1, robot0));
+    BOOST_REQUIRE(ask.getRelatedObjectProperties(robot0).count(hasPart));
+    BOOST_REQUIRE(ask.getRelatedDataProperties(gripper0).count(mass));
+    BOOST_REQUIRE(ask.getDataValue(gripper0, mass) == value);
+
+    OWLOntologyAsk inferred(ontology);
+    BOOST_REQUIRE(inferred.isRelatedTo(robot0, hasPart, gripper0));
+
+    tell.removeIndividual(gripper0);
+    BOOST_REQUIRE_MESSAGE(!ask.isRelatedTo(robot0, hasPart, gripper0), "Retracted relation is removed from the index");
+    BOOST_REQUIRE(ask.getRelatedObjectProperties(robot0).empty());
+    BOOST_REQUIRE(ask.getRelatedDataProperties(gripper0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(apply_changes)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class-0");
+    IRI relation("http://my-classes#knows");
+    IRI instance("http://my-classes#instance-0");
+    IRI other("http://my-classes#instance-1");
+
+    tell.klass(klass);
+    tell.objectProperty(relation);
+    tell.instanceOf(instance, klass);
+    tell.instanceOf(other, klass);
+    tell.relatedTo(instance, relation, other);
+    ontology->refresh();
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(instance).size(), 3);
+
+    utils::OWLEntityRemover remover(OWLOntology::PtrList(1, ontology));
+    OWLNamedIndividual individual(instance);
+    remover.visit(&individual);
+    OWLOntologyChange::PtrList changes = remover.getChanges();
+
+    BOOST_REQUIRE_EQUAL(ontology->applyChanges(changes), CHANGE_SUCCESS);
+    BOOST_REQUIRE_MESSAGE(ontology->getReferencingAxioms(instance).empty(), "No axioms referencing removed individual");
+    BOOST_REQUIRE_EQUAL(ask.allInstancesOf(klass).size(), 1);
+    BOOST_REQUIRE_EQUAL(ontology->applyChanges(changes), CHANGE_NO_OPERATION);
+
+    // Revert the removal, where an axiom which is added and removed again
+    // within the batch has no effect
+    OWLOntologyChange::PtrList additions;
+    for(const OWLOntologyChange::Ptr& change : changes)
+    {
+        additions.push_back(make_shared<AddAxiom>(ontology, change->getAxiom()));
+    }
+    additions.push_back(changes.front());
+    additions.push_back(make_shared<AddAxiom>(ontology, changes.front()->getAxiom()));
+    BOOST_REQUIRE_EQUAL(ontology->applyChanges(additions), CHANGE_SUCCESS);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(instance).size(), 3);
+    BOOST_REQUIRE_EQUAL(ask.allInstancesOf(klass).size(), 2);
+    BOOST_REQUIRE(ask.isRelatedTo(instance, relation, other));
+
+    // Axioms are compared structurally rather than by identity
+    OWLAxiom::Ptr equalAssertion = make_shared<OWLClassAssertionAxiom>(make_shared<OWLNamedIndividual>(other),
+            make_shared<OWLClass>(klass));
+    BOOST_REQUIRE_EQUAL(ontology->applyChange(make_shared<AddAxiom>(ontology, equalAssertion)), CHANGE_NO_OPERATION);
+    BOOST_REQUIRE_EQUAL(ontology->applyChange(make_shared<RemoveAxiom>(ontology, equalAssertion)), CHANGE_SUCCESS);
+    BOOST_REQUIRE_EQUAL(ask.allInstancesOf(klass).size(), 1);
+
+    // Forks are built from the axioms, so that they contain applied changes
+    OWLOntology::Ptr fork = ontology->fork();
+    BOOST_REQUIRE_EQUAL(fork->getAxioms().size(), ontology->getAxioms().size());
+    BOOST_REQUIRE_EQUAL(OWLOntologyAsk(fork).allInstancesOf(klass).size(), 1);
+
+    // A batch with a change of another ontology is rejected as a whole
+    OWLOntology::Ptr otherOntology = make_shared<OWLOntology>();
+    OWLOntologyChange::PtrList invalid = { changes.front(),
+        make_shared<RemoveAxiom>(otherOntology, changes.front()->getAxiom()) };
+    BOOST_REQUIRE_THROW(ontology->applyChanges(invalid), std::invalid_argument);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(instance).size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(batch_assertions)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI sensor("http://my-classes#Sensor");
+    IRI observes("http://my-classes#observes");
+    IRI temperature("http://my-classes#temperature");
+    IRI room("http://my-classes#room-0");
+    tell.klass(sensor);
+    tell.objectProperty(observes);
+    tell.dataProperty(temperature);
+
+    size_t numberOfSensors = 100;
+    ABoxBatch::Ptr batch = make_shared<ABoxBatch>();
+    ABoxBatch::Id sensorId = batch->intern(sensor);
+    ABoxBatch::Id observesId = batch->intern(observes);
+    ABoxBatch::Id temperatureId = batch->intern(temperature);
+    ABoxBatch::Id roomId = batch->intern(room);
+
+    ABoxBatch::IdList sensors;
+    std::vector<double> temperatures;
+    for(size_t i = 0; i < numberOfSensors; ++i)
+    {
+        ABoxBatch::Id id = batch->intern(IRI("http://my-classes#sensor-" + std::to_string(i)));
+        batch->addType(id, sensorId);
+        batch->addRelation(id, observesId, roomId);
+        sensors.push_back(id);
+        temperatures.push_back(20.0 + i);
+    }
+    batch->addValues(sensors, temperatureId, temperatures);
+
+    OWLAxiom::PtrList axioms = tell.assertBatch(batch);
+    BOOST_REQUIRE_EQUAL(axioms.size(), 3*numberOfSensors);
+    ontology->refresh();
+
+    OWLOntologyAsk ask(ontology);
+    BOOST_REQUIRE_EQUAL(ask.allInstancesOf(sensor).size(), numberOfSensors);
+    IRI sensor7("http://my-classes#sensor-7");
+    BOOST_REQUIRE(ask.isRelatedTo(sensor7, observes, room));
+    BOOST_REQUIRE_EQUAL(ask.getDataValue(sensor7, temperature)->getDouble(), 27.0);
+    BOOST_REQUIRE_EQUAL(ontology->getAxiomMap().at(OWLAxiom::ClassAssertion).size(), numberOfSensors);
+
+    // a new batch replaces the value of a known individual, as valueOf
+    ABoxBatch::Ptr update = make_shared<ABoxBatch>();
+    update->addValue(sensor7, temperature, OWLLiteral::doubleValue(30.0));
+    tell.assertBatch(update);
+    OWLOntologyAsk told(ontology, OWLOntologyAsk::TOLD);
+    BOOST_REQUIRE_EQUAL(told.getDataValue(sensor7, temperature)->getDouble(), 30.0);
+
+    ABoxBatch::Ptr invalid = make_shared<ABoxBatch>();
+    invalid->addType(IRI("http://my-classes#sensor-x"), IRI("http://my-classes#Unknown"));
+    BOOST_REQUIRE_THROW(tell.assertBatch(invalid), std::invalid_argument);
+    BOOST_REQUIRE(!ask.isOWLIndividual(IRI("http://my-classes#sensor-x")));
+}
+
+BOOST_AUTO_TEST_CASE(structural_mode)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(OWLOntology::STRUCTURAL);
+    OWLOntologyTell tell(ontology);
+    OWLOntologyAsk ask(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI a("http://my-classes#A");
+    IRI b("http://my-classes#B");
+    IRI x("http://my-classes#x");
+    IRI has("http://my-classes#has");
+    IRI hasB("http://my-classes#hasB");
+
+    tell.subClassOf(a, b);
+    tell.instanceOf(x, a);
+    OWLObjectProperty::Ptr property = tell.objectProperty(has);
+    OWLObjectRestriction::Ptr restriction = make_shared<OWLObjectSomeValuesFrom>(property,
+            make_shared<OWLClass>(b));
+    tell.objectPropertyRestriction(hasB, restriction);
+    tell.subClassOf(a, hasB);
+
+    BOOST_REQUIRE(!ontology->hasKnowledgeBase());
+    BOOST_REQUIRE(ontology->getMode() == OWLOntology::STRUCTURAL);
+    BOOST_REQUIRE(!ontology->getAxiomMap().at(OWLAxiom::SubClassOf).empty());
+    BOOST_REQUIRE(ask.isObjectProperty(has));
+    BOOST_REQUIRE_THROW(ask.isSubClassOf(a, b), std::runtime_error);
+
+    ontology->attachKnowledgeBase();
+    ontology->refresh();
+    BOOST_REQUIRE(ontology->getMode() == OWLOntology::REASONING);
+    BOOST_REQUIRE(ask.isSubClassOf(a, b));
+    BOOST_REQUIRE(ask.isSubClassOf(a, hasB));
+    BOOST_REQUIRE(ask.isInstanceOf(x, b));
+    BOOST_REQUIRE_THROW(ontology->attachKnowledgeBase(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(reasoning_levels)
+{
+    // a structural ontology ensures that the reasoner is not used
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(OWLOntology::STRUCTURAL);
+    OWLOntologyTell tell(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI agent("http://my-classes#Agent");
+    IRI robot("http://my-classes#Robot");
+    IRI mobileRobot("http://my-classes#MobileRobot");
+    IRI machine("http://my-classes#Machine");
+    IRI component("http://my-classes#Component");
+    IRI hasPart("http://my-classes#hasPart");
+    IRI hasGripper("http://my-classes#hasGripper");
+    IRI robot0("http://my-classes#robot-0");
+    IRI gripper0("http://my-classes#gripper-0");
+
+    tell.subClassOf(mobileRobot, robot);
+    tell.subClassOf(robot, agent);
+    tell.klass(machine);
+    tell.equalClasses({robot, machine});
+    tell.klass(component);
+    tell.objectProperty(hasPart);
+    tell.objectProperty(hasGripper);
+    tell.subPropertyOf(hasGripper, hasPart);
+    tell.objectPropertyDomainOf(hasPart, agent);
+    tell.objectPropertyRangeOf(hasPart, component);
+    tell.instanceOf(robot0, mobileRobot);
+    tell.namedIndividual(gripper0);
+    tell.relatedTo(robot0, hasGripper, gripper0);
+
+    OWLOntologyAsk told(ontology, OWLOntologyAsk::TOLD);
+    BOOST_REQUIRE(told.isSubClassOf(mobileRobot, robot));
+    BOOST_REQUIRE(!told.isSubClassOf(mobileRobot, agent));
+    BOOST_REQUIRE(told.allSubClassesOf(agent) == IRIList(1, robot));
+    BOOST_REQUIRE(told.allTypesOf(robot0) == IRIList(1, mobileRobot));
+    BOOST_REQUIRE(!told.isRelatedTo(robot0, hasPart, gripper0));
+
+    OWLOntologyAsk rdfs = told.withQueryMode(OWLOntologyAsk::RDFS);
+    BOOST_REQUIRE(rdfs.getQueryMode() == OWLOntologyAsk::RDFS);
+    BOOST_REQUIRE(rdfs.isSubClassOf(mobileRobot, agent));
+    BOOST_REQUIRE(rdfs.isSubClassOf(mobileRobot, owlapi::vocabulary::OWL::Thing()));
+    BOOST_REQUIRE(rdfs.areEquivalent(robot, machine));
+    BOOST_REQUIRE_EQUAL(rdfs.allSubClassesOf(agent).size(), 3);
+    BOOST_REQUIRE(rdfs.allSubClassesOf(agent, true) == IRIList(1, robot));
+    BOOST_REQUIRE(rdfs.isInstanceOf(robot0, agent));
+    BOOST_REQUIRE(rdfs.isInstanceOf(gripper0, component));
+    BOOST_REQUIRE(rdfs.allTypesOf(robot0, true) == IRIList(1, mobileRobot));
+    BOOST_REQUIRE(rdfs.allInstancesOf(component) == IRIList(1, gripper0));
+    BOOST_REQUIRE(rdfs.isRelatedTo(robot0, hasPart, gripper0));
+    BOOST_REQUIRE(rdfs.allRelatedInstances(robot0, hasPart, component) == IRIList(1, gripper0));
+    BOOST_REQUIRE(rdfs.getRelatedObjectProperties(robot0).count(hasPart));
+    BOOST_REQUIRE(rdfs.getObjectPropertyDomain(hasGripper) == IRIList(1, agent));
+
+    // the closure follows changes of the hierarchy
+    IRI physicalObject("http://my-classes#PhysicalObject");
+    BOOST_REQUIRE(!rdfs.isSubClassOf(mobileRobot, physicalObject));
+    tell.subClassOf(agent, physicalObject);
+    BOOST_REQUIRE(rdfs.isSubClassOf(mobileRobot, physicalObject));
+
+    BOOST_REQUIRE_THROW(told.withQueryMode(OWLOntologyAsk::INFERRED).isSubClassOf(mobileRobot, robot), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(el_classification)
+{
+    // without a knowledge base, inferred queries can only be answered by
+    // the EL classifier
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(OWLOntology::STRUCTURAL);
+    OWLOntologyTell tell(ontology);
+    OWLOntologyAsk ask(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI agent("http://my-classes#Agent");
+    IRI robot("http://my-classes#Robot");
+    IRI machine("http://my-classes#Machine");
+    IRI manipulator("http://my-classes#Manipulator");
+    IRI grippingAgent("http://my-classes#GrippingAgent");
+    IRI physicalObject("http://my-classes#PhysicalObject");
+    IRI component("http://my-classes#Component");
+    IRI arm("http://my-classes#Arm");
+    IRI gripper("http://my-classes#Gripper");
+    IRI broken("http://my-classes#BrokenRobot");
+    IRI hasPart("http://my-classes#hasPart");
+    IRI hasArm("http://my-classes#hasArm");
+
+    OWLObjectProperty::Ptr hasPartProperty = tell.objectProperty(hasPart);
+    OWLObjectProperty::Ptr hasArmProperty = tell.objectProperty(hasArm);
+    tell.subPropertyOf(hasArm, hasPart);
+    tell.transitiveProperty(hasPart);
+    tell.klass(physicalObject);
+    tell.objectPropertyDomainOf(hasPart, physicalObject);
+
+    tell.subClassOf(robot, agent);
+    tell.klass(machine);
+    tell.equalClasses({robot, machine});
+    tell.subClassOf(arm, component);
+    tell.subClassOf(gripper, component);
+    tell.disjointClasses({agent, component});
+
+    // Robot ⊑ ∃hasArm.Arm, Arm ⊑ ∃hasPart.Gripper
+    tell.subClassOf(robot, make_shared<OWLObjectSomeValuesFrom>(hasArmProperty, tell.klass(arm)));
+    tell.subClassOf(arm, make_shared<OWLObjectSomeValuesFrom>(hasPartProperty, tell.klass(gripper)));
+
+    // Manipulator ≡ Agent ⊓ ∃hasPart.Arm, GrippingAgent ≡ ∃hasPart.Gripper
+    OWLClassExpression::Ptr manipulatorDefinition = make_shared<OWLObjectIntersectionOf>(OWLClassExpression::PtrList({
+                tell.klass(agent),
+                make_shared<OWLObjectSomeValuesFrom>(hasPartProperty, tell.klass(arm)) }));
+    tell.subClassOf(tell.klass(manipulator), manipulatorDefinition);
+    tell.subClassOf(manipulatorDefinition, tell.klass(manipulator));
+    OWLClassExpression::Ptr grippingDefinition = make_shared<OWLObjectSomeValuesFrom>(hasPartProperty, tell.klass(gripper));
+    tell.subClassOf(tell.klass(grippingAgent), grippingDefinition);
+    tell.subClassOf(grippingDefinition, tell.klass(grippingAgent));
+
+    OWLClassExpression::Ptr brokenDefinition = make_shared<OWLObjectIntersectionOf>(OWLClassExpression::PtrList({
+                tell.klass(robot), tell.klass(component) }));
+    tell.subClassOf(tell.klass(broken), brokenDefinition);
+
+    BOOST_REQUIRE(OWL2ELProfile::isInProfile(ontology));
+    ELClassifier classifier(ontology, 2);
+    BOOST_REQUIRE(classifier.isSupported());
+    Taxonomy::Ptr taxonomy = classifier.classify();
+    BOOST_REQUIRE(taxonomy->hasNode(manipulator));
+
+    BOOST_REQUIRE(ask.isSubClassOf(robot, manipulator));
+    BOOST_REQUIRE(ask.isSubClassOf(robot, grippingAgent));
+    BOOST_REQUIRE(ask.isSubClassOf(arm, grippingAgent));
+    BOOST_REQUIRE(ask.isSubClassOf(robot, physicalObject));
+    BOOST_REQUIRE(!ask.isSubClassOf(manipulator, robot));
+    BOOST_REQUIRE(!ask.isSubClassOf(arm, agent));
+    BOOST_REQUIRE(ask.areEquivalent(robot, machine));
+    BOOST_REQUIRE_EQUAL(ask.allEquivalentClasses(robot).size(), 2);
+    BOOST_REQUIRE(ask.ancestors(robot, true) == IRIList(1, manipulator));
+    BOOST_REQUIRE(ask.isSubClassOf(broken, gripper));
+
+    IRIList subclasses = ask.allSubClassesOf(grippingAgent);
+    BOOST_REQUIRE(std::find(subclasses.begin(), subclasses.end(), machine) != subclasses.end());
+    BOOST_REQUIRE(std::find(subclasses.begin(), subclasses.end(), arm) != subclasses.end());
+
+    // NumberedComponent ≡ ∃hasId.xsd:decimal, CountedComponent ≡
+    // ∃hasId.xsd:nonNegativeInteger, SeventhComponent ≡ ∃hasId.{"7.0"^^xsd:decimal}
+    IRI hasId("http://my-classes#hasId");
+    IRI numbered("http://my-classes#NumberedComponent");
+    IRI counted("http://my-classes#CountedComponent");
+    IRI seventh("http://my-classes#SeventhComponent");
+    OWLDataProperty::Ptr hasIdProperty = tell.dataProperty(hasId);
+    std::vector<OWLDataRestriction::Ptr> dataDefinitions = {
+        make_shared<OWLDataSomeValuesFrom>(hasIdProperty, make_shared<OWLDataType>(vocabulary::XSD::decimal())),
+        make_shared<OWLDataSomeValuesFrom>(hasIdProperty, make_shared<OWLDataType>(vocabulary::XSD::nonNegativeInteger())),
+        make_shared<OWLDataHasValue>(hasIdProperty, OWLLiteral::create("7.0", vocabulary::XSD::decimal().toString())) };
+    IRIList dataClasses = { numbered, counted, seventh };
+    for(size_t i = 0; i < dataClasses.size(); ++i)
+    {
+        tell.subClassOf(tell.klass(dataClasses[i]), dataDefinitions[i]);
+        tell.subClassOf(dataDefinitions[i], tell.klass(dataClasses[i]));
+    }
+    // Arm ⊑ ∃hasId.xsd:integer, Gripper ⊑ ∃hasId."07"^^xsd:integer
+    OWLDataRestriction::Ptr integerRestriction = make_shared<OWLDataSomeValuesFrom>(hasIdProperty, make_shared<OWLDataType>(vocabulary::XSD::integer()));
+    OWLDataRestriction::Ptr valueRestriction = make_shared<OWLDataHasValue>(hasIdProperty, OWLLiteral::create("07", vocabulary::XSD::integer().toString()));
+    tell.subClassOf(tell.klass(arm), integerRestriction);
+    tell.subClassOf(tell.klass(gripper), valueRestriction);
+
+    BOOST_REQUIRE(classifier.isSupported());
+    BOOST_REQUIRE(ask.isSubClassOf(arm, numbered));
+    BOOST_REQUIRE(!ask.isSubClassOf(arm, counted));
+    BOOST_REQUIRE(ask.isSubClassOf(gripper, counted));
+    BOOST_REQUIRE(ask.isSubClassOf(gripper, seventh));
+    BOOST_REQUIRE(!ask.isSubClassOf(numbered, counted));
+
+    // datatypes outside of the EL datatype map are not within the profile,
+    // literals whose values cannot be compared exactly are not supported
+    OWLDataRestriction::Ptr doubleRestriction = make_shared<OWLDataSomeValuesFrom>(hasIdProperty, make_shared<OWLDataType>(vocabulary::XSD::resolve("double")));
+    OWLAxiom::Ptr doubleAxiom = tell.subClassOf(tell.klass(arm), doubleRestriction);
+    BOOST_REQUIRE_EQUAL(OWL2ELProfile::getViolations(ontology).size(), 1);
+    BOOST_REQUIRE(!classifier.isSupported());
+    ontology->applyChange(make_shared<RemoveAxiom>(ontology, doubleAxiom));
+    OWLDataRestriction::Ptr dateRestriction = make_shared<OWLDataHasValue>(hasIdProperty, OWLLiteral::create("2020-01-01T00:00:00Z", vocabulary::XSD::dateTime().toString()));
+    OWLAxiom::Ptr dateAxiom = tell.subClassOf(tell.klass(arm), dateRestriction);
+    BOOST_REQUIRE(OWL2ELProfile::isInProfile(ontology));
+    BOOST_REQUIRE(!classifier.isSupported());
+    ontology->applyChange(make_shared<RemoveAxiom>(ontology, dateAxiom));
+    BOOST_REQUIRE(classifier.isSupported());
+
+    // outside of EL the reasoner is required again
+    tell.functionalObjectProperty(hasArm);
+    BOOST_REQUIRE_EQUAL(OWL2ELProfile::getViolations(ontology).size(), 1);
+    BOOST_REQUIRE(!classifier.isSupported());
+    BOOST_REQUIRE_THROW(ask.allSubClassesOf(agent), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(rl_materialization)
+{
+    // without a knowledge base, inferred assertions can only be answered
+    // by the RL materializer
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(OWLOntology::STRUCTURAL);
+    OWLOntologyTell tell(ontology);
+    OWLOntologyAsk ask(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI agent("http://my-classes#Agent");
+    IRI robot("http://my-classes#Robot");
+    IRI arm("http://my-classes#Arm");
+    IRI component("http://my-classes#Component");
+    IRI physicalObject("http://my-classes#PhysicalObject");
+    IRI hasPart("http://my-classes#hasPart");
+    IRI hasArm("http://my-classes#hasArm");
+    IRI partOf("http://my-classes#partOf");
+    IRI hasController("http://my-classes#hasController");
+
+    IRI robot0("http://my-instances#Robot0");
+    IRI robot1("http://my-instances#Robot1");
+    IRI arm0("http://my-instances#Arm0");
+    IRI arm1("http://my-instances#Arm1");
+    IRI gripper0("http://my-instances#Gripper0");
+    IRI controller0("http://my-instances#Controller0");
+    IRI controller1("http://my-instances#Controller1");
+
+    tell.objectProperty(hasPart);
+    OWLObjectProperty::Ptr hasArmProperty = tell.objectProperty(hasArm);
+    tell.objectProperty(partOf);
+    tell.objectProperty(hasController);
+    tell.subPropertyOf(hasArm, hasPart);
+    tell.transitiveProperty(hasPart);
+    tell.inverseOf(partOf, hasPart);
+    tell.klass(physicalObject);
+    tell.objectPropertyDomainOf(hasPart, physicalObject);
+
+    tell.subClassOf(robot, agent);
+    tell.subClassOf(arm, component);
+    tell.disjointClasses({agent, component});
+    // Robot ⊑ ∀hasArm.Arm
+    tell.subClassOf(tell.klass(robot), make_shared<OWLObjectAllValuesFrom>(hasArmProperty, tell.klass(arm)));
+
+    for(const IRI& individual : { robot0, robot1, arm0, arm1, gripper0, controller0, controller1 })
+    {
+        tell.namedIndividual(individual);
+    }
+    tell.instanceOf(robot0, robot);
+    tell.relatedTo(robot0, hasArm, arm0);
+    tell.relatedTo(arm0, hasPart, gripper0);
+    tell.relatedTo(robot1, hasArm, arm1);
+
+    RLMaterializer materializer(2);
+    BOOST_REQUIRE(materializer.materialize(ontology));
+    BOOST_REQUIRE(materializer.isConsistent());
+
+    BOOST_REQUIRE(ask.isInstanceOf(robot0, agent));
+    BOOST_REQUIRE(ask.isInstanceOf(arm0, component));
+    BOOST_REQUIRE(!ask.isInstanceOf(arm1, arm));
+    BOOST_REQUIRE(ask.isRelatedTo(robot0, hasPart, gripper0));
+    IRIList wholes = ask.allRelatedInstances(gripper0, partOf);
+    BOOST_REQUIRE(std::find(wholes.begin(), wholes.end(), robot0) != wholes.end());
+    IRIList physicalObjects = ask.allInstancesOf(physicalObject);
+    BOOST_REQUIRE(std::find(physicalObjects.begin(), physicalObjects.end(), robot1) != physicalObjects.end());
+    BOOST_REQUIRE(ask.allInstancesOf(agent) == IRIList(1, robot0));
+    BOOST_REQUIRE_EQUAL(ask.allRelatedInstances(robot0, hasPart, component).size(), 1);
+
+    // assertions are added and removed incrementally
+    OWLAxiom::Ptr assertion = tell.instanceOf(robot1, robot);
+    BOOST_REQUIRE(ask.isInstanceOf(arm1, arm));
+    ontology->applyChanges(OWLOntologyChange::PtrList(1, make_shared<RemoveAxiom>(ontology, assertion)));
+    BOOST_REQUIRE(!ask.isInstanceOf(arm1, component));
+
+    // individuals with the same value of a functional property are merged
+    tell.functionalObjectProperty(hasController);
+    tell.relatedTo(robot0, hasController, controller0);
+    tell.relatedTo(robot0, hasController, controller1);
+    tell.instanceOf(controller0, component);
+    BOOST_REQUIRE(ask.isInstanceOf(controller1, component));
+    BOOST_REQUIRE_EQUAL(ask.allRelatedInstances(robot0, hasController).size(), 2);
+
+    // inconsistent ontologies require the reasoner again
+    tell.instanceOf(controller1, agent);
+    BOOST_REQUIRE_THROW(ask.isInstanceOf(controller1, agent), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(memory_usage)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>(OWLOntology::STRUCTURAL);
+    OWLOntologyTell tell(ontology);
+    tell.initializeDefaultClasses();
+
+    IRI a("http://my-classes#A");
+    IRI b("http://my-classes#B");
+    tell.subClassOf(a, b);
+    tell.namedIndividual(IRI("http://my-individuals#x0"));
+
+    MemoryUsage usage = ontology->getMemoryUsage();
+    BOOST_REQUIRE_EQUAL(usage.getCount("entities.named_individuals"), 1);
+    BOOST_REQUIRE(usage.getBytes("entities") > 0);
+    BOOST_REQUIRE_EQUAL(usage.getBytes("entities"), usage.getBytes("entities.classes")
+            + usage.getBytes("entities.named_individuals") + usage.getBytes("entities.anonymous_class_expressions")
+            + usage.getBytes("entities.anonymous_individuals") + usage.getBytes("entities.rdf_properties")
+            + usage.getBytes("entities.object_properties") + usage.getBytes("entities.data_properties")
+            + usage.getBytes("entities.annotation_properties") + usage.getBytes("entities.anonymous_data_ranges")
+            + usage.getBytes("entities.data_types"));
+    BOOST_REQUIRE_EQUAL(usage.getBytes("kb"), 0);
+
+    for(size_t i = 1; i < 100; ++i)
+    {
+        IRI individual("http://my-individuals#x" + std::to_string(i));
+        tell.namedIndividual(individual);
+        tell.instanceOf(individual, a);
+    }
+
+    MemoryUsage grown = ontology->getMemoryUsage();
+    BOOST_REQUIRE_EQUAL(grown.getCount("entities.named_individuals"), 100);
+    BOOST_REQUIRE(grown.getBytes("entities.named_individuals") > usage.getBytes("entities.named_individuals"));
+    BOOST_REQUIRE(grown.getBytes("index") > usage.getBytes("index"));
+    BOOST_REQUIRE(grown.getTotalBytes() > usage.getTotalBytes());
+
+    std::string json = grown.toJSON();
+    BOOST_REQUIRE(json.find("\"index.class_assertions_by_class\": {\"count\": 1") != std::string::npos);
+    BOOST_REQUIRE(json.find("\"total_bytes\": ") != std::string::npos);
+
+    OWLAxiom::Ptr assertion = tell.instanceOf(IRI("http://my-individuals#x0"), a);
+    BOOST_REQUIRE_EQUAL(assertion->getObjectSize(), sizeof(OWLClassAssertionAxiom));
+}
+
 BOOST_AUTO_TEST_SUITE_END()